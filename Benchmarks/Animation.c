@@ -0,0 +1,301 @@
+/**
+ * @file Animation.c
+ * @authors Israfiel
+ * @brief Benchmarks for evaluating crowds of animated characters.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+#include <math.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @name JOINTS
+ * @brief The number of joints in the skeleton, about a game character's.
+ */
+#define JOINTS 80
+
+/**
+ * @name FRAMES
+ * @brief The number of frames in each clip.
+ */
+#define FRAMES 60
+
+/**
+ * @name CLIPS
+ * @brief The number of clips.
+ */
+#define CLIPS 3
+
+/**
+ * @name CHARACTERS
+ * @brief The number of characters in the crowd.
+ */
+#define CHARACTERS 256
+
+/**
+ * @name LODS
+ * @brief Full detail up close, then fewer joints evaluated less often.
+ */
+static const ir_animation_lod_t LODS[IR_SKELETON_LODS] = {
+    {0.25f, 1},
+    {0.1f, 2},
+    {0.04f, 4},
+    {0.0f, 8},
+};
+
+/**
+ * @name library_t
+ * @brief The skeleton and clips, as baked into the scene's root.
+ */
+typedef struct library
+{
+    ir_skeleton_t *skeleton;
+    ir_clip_t *clips[CLIPS];
+    ir_compressed_clip_t *compressed[CLIPS];
+} library_t;
+
+/**
+ * @name crowd_t
+ * @brief A crowd of characters blending the library's clips.
+ */
+typedef struct crowd
+{
+    ir_scene_t scene;
+    ir_character_t *characters;
+    /**
+     * @name lods
+     * @brief The levels of detail the crowd is animated with, or NULL.
+     */
+    const ir_animation_lod_t *lods;
+    ir_jobs_t *jobs;
+} crowd_t;
+
+/**
+ * @name Update
+ * @authors Israfiel
+ * @brief Advance and evaluate the crowd.
+ *
+ * @param context - The crowd.
+ * @param iterations - The number of frames.
+ */
+static void Update(void *context, uint64_t iterations)
+{
+    crowd_t *crowd = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        Ir_AnimationUpdate(crowd->characters, CHARACTERS, 1.0f / 60.0f,
+                           crowd->lods, crowd->jobs);
+        Ir_BenchmarkKeep(crowd->characters[0].matrices);
+    }
+}
+
+/**
+ * @name Bake
+ * @authors Israfiel
+ * @brief Bake a branching skeleton and a few clips of its joints
+ * swinging at different rates, both raw and compressed, into a
+ * temporary file.
+ *
+ * @param path - The file to bake into.
+ * @returns Whether the library was baked.
+ */
+static bool Bake(const char *path)
+{
+    uint32_t parents[JOINTS];
+    ir_joint_transform_t bind[JOINTS];
+    ir_clip_tolerance_t tolerance = {0.001f, 0.002f, 0.001f};
+    ir_joint_transform_t *keys =
+        malloc(FRAMES * JOINTS * sizeof(ir_joint_transform_t));
+    ir_scene_writer_t writer;
+    if (keys == NULL || Ir_SceneWriterCreate(&writer) != IR_SCENE_OK)
+    {
+        free(keys);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < JOINTS; ++i)
+    {
+        parents[i] = i == 0 ? IR_SKELETON_ROOT : (i - 1) / 2;
+        bind[i] = IR_JOINT_IDENTITY;
+        bind[i].translation = Ir_Vec3(0.0f, 0.1f, 0.02f * (float)(i % 3));
+    }
+    uint64_t library = Ir_SceneWriterAllocate(&writer, sizeof(library_t),
+                                              alignof(library_t));
+    uint64_t skeleton = Ir_SkeletonBake(&writer, parents, bind, JOINTS);
+    Ir_SceneWriterPointer(&writer,
+                          library + offsetof(library_t, skeleton),
+                          skeleton);
+
+    for (uint32_t i = 0; i < CLIPS; ++i)
+    {
+        for (uint32_t j = 0; j < FRAMES; ++j)
+        {
+            for (uint32_t k = 0; k < JOINTS; ++k)
+            {
+                float phase = 6.2831853f * (float)j / (FRAMES - 1);
+                ir_joint_transform_t *key = &keys[j * JOINTS + k];
+                *key = bind[k];
+                key->rotation = Ir_QuatAxisAngle(
+                    Ir_Vec3Normalize(Ir_Vec3(1.0f, (float)k, (float)i),
+                                     Ir_Vec3(1.0f, 0.0f, 0.0f)),
+                    0.5f * sinf(phase * (float)(i + 1) + (float)k));
+            }
+        }
+        uint64_t clip = Ir_ClipBake(&writer, keys, JOINTS, FRAMES, 30.0f);
+        Ir_SceneWriterPointer(&writer,
+                              library + offsetof(library_t, clips) +
+                                  i * sizeof(ir_clip_t *),
+                              clip);
+        clip = Ir_CompressedClipBake(&writer, keys, JOINTS, FRAMES, 30.0f,
+                                     &tolerance);
+        Ir_SceneWriterPointer(&writer,
+                              library + offsetof(library_t, compressed) +
+                                  i * sizeof(ir_compressed_clip_t *),
+                              clip);
+    }
+    Ir_SceneWriterSetRoot(&writer, library);
+
+    bool saved = Ir_SceneWriterSave(&writer, path) == IR_SCENE_OK;
+    Ir_SceneWriterDestroy(&writer);
+    free(keys);
+    return saved;
+}
+
+/**
+ * @name Compress
+ * @authors Israfiel
+ * @brief Switch every layer onto its clip's compressed version.
+ *
+ * @param crowd - The crowd.
+ */
+static void Compress(crowd_t *crowd)
+{
+    const library_t *library = crowd->scene.root;
+    for (uint32_t i = 0; i < CHARACTERS; ++i)
+    {
+        ir_character_t *character = &crowd->characters[i];
+        for (uint32_t j = 0; j < character->layer_count; ++j)
+        {
+            ir_animation_layer_t *layer = &character->layers[j];
+            for (uint32_t k = 0; k < CLIPS; ++k)
+                if (layer->clip == library->clips[k])
+                    layer->compressed = library->compressed[k];
+            layer->clip = NULL;
+        }
+    }
+}
+
+/**
+ * @name Spread
+ * @authors Israfiel
+ * @brief Stand the crowd at distances covering every level of detail,
+ * in a line down a camera's view.
+ *
+ * @param crowd - The crowd.
+ */
+static void Spread(crowd_t *crowd)
+{
+    // A camera at the origin looking down -z, with a 60 degree field of
+    // view: w is the depth, and y is scaled by the focal length.
+    float view[16] = {0};
+    view[0] = view[5] = 1.7320508f;
+    view[10] = view[11] = -1.0f;
+    for (uint32_t i = 0; i < CHARACTERS; ++i)
+    {
+        ir_vec3_t centre = Ir_Vec3(0.0f, 0.0f, -2.0f - 0.5f * (float)i);
+        crowd->characters[i].screen_size =
+            Ir_CharacterScreenSize(view, centre, 1.0f);
+    }
+}
+
+/**
+ * @name Gather
+ * @authors Israfiel
+ * @brief Load the library and give each character two of its clips to
+ * blend, at its own point in them.
+ *
+ * @param crowd - The crowd.
+ * @param path - The baked library.
+ * @returns Whether there was memory for it.
+ */
+static bool Gather(crowd_t *crowd, const char *path)
+{
+    crowd->characters = calloc(CHARACTERS, sizeof(ir_character_t));
+    if (crowd->characters == NULL ||
+        Ir_SceneLoad(path, &crowd->scene) != IR_SCENE_OK)
+        return false;
+
+    const library_t *library = crowd->scene.root;
+    for (uint32_t i = 0; i < CHARACTERS; ++i)
+    {
+        ir_character_t *character = &crowd->characters[i];
+        if (!Ir_CharacterCreate(character, library->skeleton))
+            return false;
+        float blend = (float)(i % 16) / 15.0f;
+        character->layers[0] = (ir_animation_layer_t){
+            library->clips[i % CLIPS], 0.01f * (float)i, 1.0f,
+            1.0f - blend};
+        character->layers[1] = (ir_animation_layer_t){
+            library->clips[(i + 1) % CLIPS], 0.02f * (float)i, 1.2f,
+            blend};
+        character->layer_count = 2;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Animation", argc, argv)) return 1;
+
+    ir_jobs_t *jobs = malloc(sizeof(ir_jobs_t));
+    if (jobs == NULL || !Ir_JobsCreate(jobs, 0)) return 1;
+
+    char path[] = "/tmp/IridiumBenchmarkXXXXXX";
+    int descriptor = mkstemp(path);
+    if (descriptor == -1) return 1;
+    close(descriptor);
+
+    crowd_t crowd = {0};
+    if (Bake(path) && Gather(&crowd, path))
+    {
+        Ir_BenchmarkRun(&suite, "Update/256", Update, &crowd);
+        crowd.jobs = jobs;
+        Ir_BenchmarkRun(&suite, "Update/256/Jobs", Update, &crowd);
+        Compress(&crowd);
+        crowd.jobs = NULL;
+        Ir_BenchmarkRun(&suite, "Update/256/Compressed", Update, &crowd);
+        crowd.jobs = jobs;
+        Ir_BenchmarkRun(&suite, "Update/256/Compressed/Jobs", Update,
+                        &crowd);
+
+        // The crowd stretches from close up off into the distance.
+        Spread(&crowd);
+        crowd.lods = LODS;
+        crowd.jobs = NULL;
+        Ir_BenchmarkRun(&suite, "Update/256/Compressed/LOD", Update,
+                        &crowd);
+        crowd.jobs = jobs;
+        Ir_BenchmarkRun(&suite, "Update/256/Compressed/LOD/Jobs", Update,
+                        &crowd);
+    }
+    if (crowd.characters != NULL)
+        for (uint32_t i = 0; i < CHARACTERS; ++i)
+            Ir_CharacterDestroy(&crowd.characters[i]);
+    free(crowd.characters);
+    Ir_SceneUnload(&crowd.scene);
+    remove(path);
+
+    Ir_JobsDestroy(jobs);
+    free(jobs);
+    return Ir_BenchmarkEnd(&suite);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file Broadphase.c
+ * @authors Israfiel
+ * @brief Benchmarks for the broadphase: boxes jittering in place, the
+ * common case the incremental sort is built for, swept on one thread
+ * and across the job pool.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+#include <stdlib.h>
+
+/**
+ * @name scene_t
+ * @brief A field of boxes and the broadphase holding them.
+ */
+typedef struct scene
+{
+    ir_broadphase_t broadphase;
+    ir_jobs_t *jobs;
+    ir_random_t random;
+    ir_vec3_t *positions;
+    uint32_t count;
+} scene_t;
+
+/**
+ * @name RandomUnit
+ * @authors Israfiel
+ * @brief Draw a float in [0, 1).
+ *
+ * @param random - The generator.
+ * @returns The float.
+ */
+static float RandomUnit(ir_random_t *random)
+{
+    return (float)(Ir_RandomNext(random) >> 8) / 16777216.0f;
+}
+
+/**
+ * @name Fill
+ * @authors Israfiel
+ * @brief Scatter boxes through a volume sized so each overlaps a
+ * couple of others.
+ *
+ * @param scene - The scene.
+ * @param count - The number of boxes.
+ * @returns Whether the boxes were added.
+ */
+static bool Fill(scene_t *scene, uint32_t count)
+{
+    scene->positions = malloc(count * sizeof(ir_vec3_t));
+    if (scene->positions == NULL) return false;
+    scene->count = count;
+
+    float extent = 4.0f * cbrtf((float)count);
+    Ir_BroadphaseCreate(&scene->broadphase);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        ir_vec3_t position =
+            Ir_Vec3(RandomUnit(&scene->random) * extent,
+                    RandomUnit(&scene->random) * extent,
+                    RandomUnit(&scene->random) * extent);
+        scene->positions[i] = position;
+        if (Ir_BroadphaseAdd(&scene->broadphase, position,
+                             Ir_Vec3Add(position, Ir_Vec3(1, 1, 1))) ==
+            IR_BROADPHASE_NONE)
+            return false;
+    }
+    return Ir_BroadphaseUpdate(&scene->broadphase, NULL);
+}
+
+/**
+ * @name Update
+ * @authors Israfiel
+ * @brief Nudge every box and update the broadphase.
+ *
+ * @param context - The scene.
+ * @param iterations - The number of updates.
+ */
+static void Update(void *context, uint64_t iterations)
+{
+    scene_t *scene = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        for (uint32_t j = 0; j < scene->count; ++j)
+        {
+            float nudge = (RandomUnit(&scene->random) - 0.5f) * 0.05f;
+            ir_vec3_t *position = &scene->positions[j];
+            *position =
+                Ir_Vec3Add(*position, Ir_Vec3(nudge, nudge, nudge));
+            Ir_BroadphaseMove(&scene->broadphase, j, *position,
+                              Ir_Vec3Add(*position, Ir_Vec3(1, 1, 1)));
+        }
+        if (!Ir_BroadphaseUpdate(&scene->broadphase, scene->jobs))
+            IR_LOG_FATAL("Ir_BroadphaseUpdate failed.");
+        Ir_BenchmarkKeep(scene->broadphase.pairs);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Broadphase", argc, argv)) return 1;
+
+    ir_jobs_t *jobs = malloc(sizeof(ir_jobs_t));
+    if (jobs == NULL || !Ir_JobsCreate(jobs, 0)) return 1;
+
+    static const struct
+    {
+        const char *name;
+        uint32_t count;
+        bool parallel;
+    } sizes[] = {
+        {"Update/1K", 1000, false},
+        {"Update/16K", 16000, false},
+        {"Update/16K/Jobs", 16000, true},
+        {"Update/128K", 128000, false},
+        {"Update/128K/Jobs", 128000, true},
+    };
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+    {
+        scene_t scene = {.jobs = sizes[i].parallel ? jobs : NULL};
+        Ir_RandomSeed(&scene.random, 0x5EED, i);
+        if (Fill(&scene, sizes[i].count))
+            Ir_BenchmarkRun(&suite, sizes[i].name, Update, &scene);
+        Ir_BroadphaseDestroy(&scene.broadphase);
+        free(scene.positions);
+    }
+
+    Ir_JobsDestroy(jobs);
+    free(jobs);
+    return Ir_BenchmarkEnd(&suite);
+}
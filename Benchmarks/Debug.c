@@ -0,0 +1,119 @@
+/**
+ * @file Debug.c
+ * @authors Israfiel
+ * @brief Benchmarks for the engine's hot-path instrumentation: the
+ * clock, profiler zones, logging, and frame statistics.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+
+/**
+ * @name ClockRead
+ * @authors Israfiel
+ * @brief Read the high-resolution clock.
+ *
+ * @param context - Unused.
+ * @param iterations - The number of reads.
+ */
+static void ClockRead(void *context, uint64_t iterations)
+{
+    (void)context;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i) sum += Ir_ClockTicks();
+    Ir_BenchmarkKeep(&sum);
+}
+
+/**
+ * @name ProfilerZone
+ * @authors Israfiel
+ * @brief Record a zone's begin and end. Calls the recorder directly so
+ * the cost is measured whether or not the macros are compiled in.
+ *
+ * @param context - Unused.
+ * @param iterations - The number of zones.
+ */
+static void ProfilerZone(void *context, uint64_t iterations)
+{
+    (void)context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        Ir_ProfilerRecord(IR_PROFILE_EVENT_BEGIN, "Zone", 0.0);
+        Ir_ProfilerRecord(IR_PROFILE_EVENT_END, "Zone", 0.0);
+    }
+}
+
+/**
+ * @name LogWrite
+ * @authors Israfiel
+ * @brief Push a log record with a few arguments.
+ *
+ * @param context - Unused.
+ * @param iterations - The number of records.
+ */
+static void LogWrite(void *context, uint64_t iterations)
+{
+    (void)context;
+    for (uint64_t i = 0; i < iterations; ++i)
+        IR_LOG_DEBUG("Entity %llu moved to (%f, %f).",
+                     (unsigned long long)i, 1.0, 2.0);
+}
+
+/**
+ * @name FrameStatsSummarize
+ * @authors Israfiel
+ * @brief Record a frame and summarize the window.
+ *
+ * @param context - The frame stats.
+ * @param iterations - The number of frames.
+ */
+static void FrameStatsSummarize(void *context, uint64_t iterations)
+{
+    ir_frame_stats_t *stats = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        ir_frame_timing_t timing = {.cpu = 8.0 + (double)(i % 17) * 0.1,
+                                    .present = 16.6};
+        Ir_FrameStatsRecord(stats, &timing);
+        ir_frame_summary_t summary =
+            Ir_FrameStatsSummarize(stats, IR_FRAME_METRIC_CPU);
+        Ir_BenchmarkKeep(&summary);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Debug", argc, argv)) return 1;
+
+    Ir_BenchmarkRun(&suite, "ClockRead", ClockRead, NULL);
+    Ir_BenchmarkRun(&suite, "ProfilerZone", ProfilerZone, NULL);
+
+    // Only the producer side is measured; the drain writes to nowhere.
+    ir_log_config_t log = {.path = "/dev/null",
+                           .binary = true,
+                           .stderr_level = IR_LOG_LEVEL_FATAL,
+                           .file_level = IR_LOG_LEVEL_DEBUG,
+                           .ring_size = 1u << 22};
+    if (Ir_LogStart(&log))
+    {
+        Ir_BenchmarkRun(&suite, "LogWrite", LogWrite, NULL);
+        Ir_LogStop();
+    }
+
+    ir_frame_stats_t stats;
+    ir_frame_stats_config_t config = {.window = 600};
+    if (Ir_FrameStatsCreate(&stats, &config))
+    {
+        Ir_BenchmarkRun(&suite, "FrameStatsSummarize/600",
+                        FrameStatsSummarize, &stats);
+        Ir_FrameStatsDestroy(&stats);
+    }
+
+    return Ir_BenchmarkEnd(&suite);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file Frame.c
+ * @authors Israfiel
+ * @brief Benchmarks for the frame loop itself, run through a headless
+ * window: servicing the event loop, draining input and window events,
+ * advancing the fixed-timestep loop, and submitting the frame to the
+ * pacer, with the simulation inline or on its own thread. Frames aren't
+ * waited for, so what's measured is the loop's own cost.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+
+/**
+ * @name BODIES
+ * @brief The number of points the simulation moves each tick.
+ */
+#define BODIES 1024
+
+/**
+ * @name STEP
+ * @brief The length of a tick, and of a frame, in nanoseconds: 60 Hz.
+ */
+#define STEP 16666667u
+
+/**
+ * @name state_t
+ * @brief The simulation state: points falling under gravity, SoA.
+ */
+typedef struct state
+{
+    float height[BODIES];
+    float velocity[BODIES];
+} state_t;
+
+/**
+ * @name frame_t
+ * @brief A headless window, its event loop, and the fixed-timestep
+ * loop driven from it.
+ */
+typedef struct frame
+{
+    ir_event_loop_t events;
+    ir_window_t *window;
+    ir_loop_t loop;
+    ir_input_batch_t input;
+    /**
+     * @name now
+     * @brief The simulated time the loop is advanced to, a whole tick
+     * further each frame so every frame runs exactly one.
+     */
+    uint64_t now;
+} frame_t;
+
+/**
+ * @name Tick
+ * @authors Israfiel
+ * @brief Drop the points by a tick, bouncing them off the ground.
+ *
+ * @param user - Unused.
+ * @param previous - The state after the last tick.
+ * @param next - Filled with the state after this tick.
+ * @param tick - Unused.
+ * @param step - The tick's length in nanoseconds.
+ */
+static void Tick(void *user, const void *previous, void *next,
+                 uint64_t tick, uint64_t step)
+{
+    (void)user, (void)tick;
+    const state_t *from = previous;
+    state_t *to = next;
+    float delta = (float)step * 1e-9f;
+    for (uint32_t i = 0; i < BODIES; ++i)
+    {
+        float velocity = from->velocity[i] - 9.81f * delta;
+        float height = from->height[i] + velocity * delta;
+        to->velocity[i] = height < 0.0f ? -velocity : velocity;
+        to->height[i] = height < 0.0f ? -height : height;
+    }
+}
+
+/**
+ * @name Run
+ * @authors Israfiel
+ * @brief Run frames back to back, as SimpleWindow does once a frame is
+ * due.
+ *
+ * @param context - The frame.
+ * @param iterations - The number of frames.
+ */
+static void Run(void *context, uint64_t iterations)
+{
+    frame_t *frame = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        uint64_t begin = Ir_ClockMonotonicNanoseconds();
+        Ir_EventLoopDispatch(&frame->events, 0);
+        Ir_InputDrain(Ir_WindowInput(frame->window), &frame->input, NULL);
+        ir_window_event_t event;
+        while (Ir_WindowNextEvent(frame->window, &event))
+            Ir_BenchmarkKeep(&event);
+
+        frame->now += STEP;
+        ir_loop_frame_t rendered;
+        Ir_LoopAdvance(&frame->loop, frame->now, &rendered);
+        Ir_BenchmarkKeep(rendered.current);
+
+        Ir_WindowSubmitFrame(frame->window, begin);
+        uint64_t next = Ir_WindowNextFrameStart(
+            frame->window, Ir_ClockMonotonicNanoseconds());
+        Ir_BenchmarkKeep(&next);
+    }
+}
+
+/**
+ * @name Open
+ * @authors Israfiel
+ * @brief Open the headless window and create the loop.
+ *
+ * @param frame - The frame.
+ * @param pipelined - Whether to simulate on a thread of its own.
+ * @returns Whether everything was created.
+ */
+static bool Open(frame_t *frame, bool pipelined)
+{
+    static state_t initial;
+    for (uint32_t i = 0; i < BODIES; ++i)
+        initial.height[i] = 1.0f + (float)(i % 64) * 0.25f;
+
+    if (!Ir_EventLoopCreate(&frame->events)) return false;
+    const ir_window_config_t config = {
+        .title = "Frame",
+        .app_id = "iridium.Frame",
+        .width = 1280,
+        .height = 720,
+        .backend = IR_WINDOW_BACKEND_HEADLESS,
+    };
+    frame->window = Ir_WindowCreate(&config, &frame->events);
+    const ir_loop_config_t loop = {
+        .step = STEP,
+        .max_ticks = 4,
+        .state_size = sizeof(state_t),
+        .initial = &initial,
+        .tick = Tick,
+        .pipelined = pipelined,
+    };
+    return frame->window != NULL && Ir_LoopCreate(&frame->loop, &loop);
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Frame", argc, argv)) return 1;
+
+    static const struct
+    {
+        const char *name;
+        bool pipelined;
+    } loops[] = {
+        {"Headless", false},
+        {"Headless/Pipelined", true},
+    };
+    for (size_t i = 0; i < sizeof(loops) / sizeof(*loops); ++i)
+    {
+        frame_t frame = {0};
+        if (!Open(&frame, loops[i].pipelined))
+            IR_LOG_FATAL("Couldn't open a headless frame loop.");
+        Ir_BenchmarkRun(&suite, loops[i].name, Run, &frame);
+        Ir_LoopDestroy(&frame.loop);
+        Ir_WindowDestroy(frame.window);
+        Ir_EventLoopDestroy(&frame.events);
+    }
+    return Ir_BenchmarkEnd(&suite);
+}
@@ -0,0 +1,256 @@
+/**
+ * @file Benchmark.c
+ * @authors Israfiel
+ * @brief The implementation of Iridium's microbenchmark harness.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Benchmark.h"
+
+#include <Core/Clock.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name CompareDoubles
+ * @authors Israfiel
+ * @brief qsort comparator for doubles.
+ *
+ * @param a - The first double.
+ * @param b - The second double.
+ * @returns The ordering of the two doubles.
+ */
+static int CompareDoubles(const void *a, const void *b)
+{
+    double left = *(const double *)a, right = *(const double *)b;
+    return (left > right) - (left < right);
+}
+
+/**
+ * @name Measure
+ * @authors Israfiel
+ * @brief Time a run of a benchmark body.
+ *
+ * @param function - The benchmark body.
+ * @param context - The body's context.
+ * @param iterations - How many iterations to run.
+ * @param ticks - Filled with the clock ticks the run took.
+ * @returns The nanoseconds the run took.
+ */
+static uint64_t Measure(ir_benchmark_function_t function, void *context,
+                        uint64_t iterations, uint64_t *ticks)
+{
+    uint64_t start = Ir_ClockMonotonicNanoseconds();
+    uint64_t start_ticks = Ir_ClockTicks();
+    function(context, iterations);
+    *ticks = Ir_ClockTicks() - start_ticks;
+    return Ir_ClockMonotonicNanoseconds() - start;
+}
+
+/**
+ * @name ParseOption
+ * @authors Israfiel
+ * @brief Match a "--key=value" argument.
+ *
+ * @param argument - The argument to match.
+ * @param key - The option, including its dashes and equals sign.
+ * @returns The option's value, or NULL if it doesn't match.
+ */
+static const char *ParseOption(const char *argument, const char *key)
+{
+    size_t length = strlen(key);
+    return strncmp(argument, key, length) == 0 ? argument + length : NULL;
+}
+
+bool Ir_BenchmarkBegin(ir_benchmark_suite_t *suite, const char *name,
+                       int argc, char **argv)
+{
+    *suite = (ir_benchmark_suite_t){
+        .name = name,
+        .filter = "",
+        .sample_count = 30,
+        .warmup_nanoseconds = 100000000,
+        .sample_nanoseconds = 2000000,
+        .counters = {.leader = -1},
+    };
+
+    const char *json = NULL, *value;
+    bool counting = true;
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((value = ParseOption(argv[i], "--json=")) != NULL) json = value;
+        else if ((value = ParseOption(argv[i], "--filter=")) != NULL)
+            suite->filter = value;
+        else if ((value = ParseOption(argv[i], "--samples=")) != NULL)
+            suite->sample_count = (uint32_t)strtoul(value, NULL, 10);
+        else if ((value = ParseOption(argv[i], "--warmup-ms=")) != NULL)
+            suite->warmup_nanoseconds = strtoull(value, NULL, 10) * 1000000;
+        else if (strcmp(argv[i], "--no-counters") == 0)
+            counting = false;
+        else
+        {
+            fprintf(stderr,
+                    "Usage: %s [--json=path] [--samples=count] "
+                    "[--warmup-ms=ms] [--filter=text] [--no-counters]\n",
+                    argv[0]);
+            return false;
+        }
+    }
+
+    if (suite->sample_count < 2 ||
+        suite->sample_count > IR_BENCHMARK_MAX_SAMPLES)
+    {
+        fprintf(stderr, "Sample count must be within [2, %d].\n",
+                IR_BENCHMARK_MAX_SAMPLES);
+        return false;
+    }
+
+    if (json != NULL)
+    {
+        suite->json = fopen(json, "w");
+        if (suite->json == NULL)
+        {
+            fprintf(stderr, "Failed to open '%s'.\n", json);
+            return false;
+        }
+        fprintf(suite->json, "{\"suite\":\"%s\",\"benchmarks\":[", name);
+    }
+
+    if (!counting || !Ir_CountersOpen(&suite->counters))
+        suite->counters = (ir_counter_group_t){.leader = -1};
+
+    // Calibrating here keeps the first benchmark from paying for it.
+    (void)Ir_ClockFrequency();
+    printf("%-36s %12s %12s %10s %12s %10s\n", name, "median ns",
+           "mean ns", "stddev %", "min ns", "cycles");
+    return true;
+}
+
+void Ir_BenchmarkRun(ir_benchmark_suite_t *suite, const char *name,
+                     ir_benchmark_function_t function, void *context)
+{
+    if (strstr(name, suite->filter) == NULL) return;
+
+    static ir_benchmark_result_t result;
+    result = (ir_benchmark_result_t){.name = name, .iterations = 1};
+
+    // Grow the iteration count until one run fills a sample, warming
+    // caches and branch predictors along the way.
+    uint64_t ticks, elapsed = 0, warmed = 0;
+    while (warmed < suite->warmup_nanoseconds ||
+           elapsed < suite->sample_nanoseconds)
+    {
+        elapsed = Measure(function, context, result.iterations, &ticks);
+        warmed += elapsed;
+        if (elapsed < suite->sample_nanoseconds)
+        {
+            uint64_t scale = elapsed ? suite->sample_nanoseconds / elapsed
+                                     : 10;
+            result.iterations *= scale < 2 ? 2 : scale > 10 ? 10 : scale;
+        }
+    }
+
+    double total = 0.0, cycles = 0.0;
+    ir_counter_values_t before, after;
+    result.sample_count = suite->sample_count;
+    for (uint32_t i = 0; i < result.sample_count; ++i)
+    {
+        Ir_CountersRead(&suite->counters, &before);
+        elapsed = Measure(function, context, result.iterations, &ticks);
+        Ir_CountersRead(&suite->counters, &after);
+
+        result.samples[i] = (double)elapsed / (double)result.iterations;
+        total += result.samples[i];
+        cycles += (double)ticks / (double)result.iterations;
+        for (size_t j = 0; j < IR_COUNTER_COUNT; ++j)
+            result.counters[j] +=
+                (double)(after.values[j] - before.values[j]) /
+                (double)result.iterations;
+    }
+    result.mean = total / result.sample_count;
+    result.cycles = cycles / result.sample_count;
+    for (size_t j = 0; j < IR_COUNTER_COUNT; ++j)
+        result.counters[j] /= result.sample_count;
+
+    double variance = 0.0;
+    for (uint32_t i = 0; i < result.sample_count; ++i)
+        variance += (result.samples[i] - result.mean) *
+                    (result.samples[i] - result.mean);
+    result.deviation = sqrt(variance / (result.sample_count - 1));
+
+    double sorted[IR_BENCHMARK_MAX_SAMPLES];
+    memcpy(sorted, result.samples, result.sample_count * sizeof(double));
+    qsort(sorted, result.sample_count, sizeof(double), CompareDoubles);
+    uint32_t middle = result.sample_count / 2;
+    result.median = result.sample_count % 2
+                        ? sorted[middle]
+                        : (sorted[middle - 1] + sorted[middle]) / 2.0;
+    result.minimum = sorted[0];
+    result.maximum = sorted[result.sample_count - 1];
+
+    printf("  %-34s %12.2f %12.2f %10.2f %12.2f %10.1f\n", name,
+           result.median, result.mean,
+           result.mean > 0.0 ? result.deviation / result.mean * 100.0 : 0.0,
+           result.minimum, result.cycles);
+    if (suite->counters.available != 0)
+    {
+        // Per-iteration counts, with IPC when both halves are present.
+        printf("  %-34s", "");
+        for (ir_counter_t j = 0; j < IR_COUNTER_COUNT; ++j)
+            if (suite->counters.available & (1u << j))
+                printf(" %s %.2f", Ir_CounterName(j), result.counters[j]);
+        if (result.counters[IR_COUNTER_CYCLES] > 0.0 &&
+            result.counters[IR_COUNTER_INSTRUCTIONS] > 0.0)
+            printf(" ipc %.2f",
+                   result.counters[IR_COUNTER_INSTRUCTIONS] /
+                       result.counters[IR_COUNTER_CYCLES]);
+        putchar('\n');
+    }
+    fflush(stdout);
+
+    if (suite->json != NULL)
+    {
+        fprintf(suite->json,
+                "%s\n{\"name\":\"%s\",\"iterations\":%llu,"
+                "\"mean_ns\":%.6g,\"median_ns\":%.6g,\"stddev_ns\":%.6g,"
+                "\"min_ns\":%.6g,\"max_ns\":%.6g,\"cycles\":%.6g,",
+                suite->run_count ? "," : "", name,
+                (unsigned long long)result.iterations, result.mean,
+                result.median, result.deviation, result.minimum,
+                result.maximum, result.cycles);
+        if (suite->counters.available != 0)
+        {
+            const char *separator = "\"counters\":{";
+            for (ir_counter_t j = 0; j < IR_COUNTER_COUNT; ++j)
+            {
+                if ((suite->counters.available & (1u << j)) == 0) continue;
+                fprintf(suite->json, "%s\"%s\":%.6g", separator,
+                        Ir_CounterName(j), result.counters[j]);
+                separator = ",";
+            }
+            fputs("},", suite->json);
+        }
+        fputs("\"samples_ns\":[", suite->json);
+        for (uint32_t i = 0; i < result.sample_count; ++i)
+            fprintf(suite->json, "%s%.6g", i ? "," : "", result.samples[i]);
+        fputs("]}", suite->json);
+    }
+    suite->run_count++;
+}
+
+int Ir_BenchmarkEnd(ir_benchmark_suite_t *suite)
+{
+    int code = 0;
+    Ir_CountersClose(&suite->counters);
+    if (suite->json != NULL)
+    {
+        fputs("\n]}\n", suite->json);
+        if (fclose(suite->json) != 0) code = 1;
+        suite->json = NULL;
+    }
+    return code;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file Benchmark.h
+ * @authors Israfiel
+ * @brief Iridium's microbenchmark harness. Each file in Benchmarks/ is
+ * its own program that registers a suite of benchmarks with this
+ * harness, which warms them up, times repeated samples with both the
+ * cycle counter and the monotonic clock, summarizes the samples, and
+ * optionally writes them out as JSON for regression tracking. Where the
+ * platform allows, hardware counters are read around every sample.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_HARNESS_BENCHMARK_H
+#define IRIDIUM_HARNESS_BENCHMARK_H
+
+#include <Debug/Counters.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @name IR_BENCHMARK_MAX_SAMPLES
+ * @brief The most samples a single benchmark may take.
+ */
+#define IR_BENCHMARK_MAX_SAMPLES 1000
+
+/**
+ * @name ir_benchmark_function_t
+ * @brief A benchmark body. It must run the measured operation exactly
+ * the given number of times.
+ *
+ * @param context - The context handed to Ir_BenchmarkRun.
+ * @param iterations - How many times to run the operation.
+ */
+typedef void (*ir_benchmark_function_t)(void *context,
+                                        uint64_t iterations);
+
+/**
+ * @name ir_benchmark_result_t
+ * @brief The summary of a single benchmark. Times are nanoseconds per
+ * iteration.
+ */
+typedef struct ir_benchmark_result
+{
+    const char *name;
+    uint64_t iterations;
+    uint32_t sample_count;
+    double mean;
+    double median;
+    double deviation;
+    double minimum;
+    double maximum;
+    double cycles;
+    double counters[IR_COUNTER_COUNT];
+    double samples[IR_BENCHMARK_MAX_SAMPLES];
+} ir_benchmark_result_t;
+
+/**
+ * @name ir_benchmark_suite_t
+ * @brief A set of benchmarks run by one program.
+ */
+typedef struct ir_benchmark_suite
+{
+    /**
+     * @name name
+     * @brief The suite's name, written into its JSON.
+     */
+    const char *name;
+    /**
+     * @name filter
+     * @brief Only benchmarks whose names contain this are run.
+     */
+    const char *filter;
+    /**
+     * @name json
+     * @brief The JSON output, or NULL.
+     */
+    FILE *json;
+    /**
+     * @name sample_count
+     * @brief The number of samples taken per benchmark.
+     */
+    uint32_t sample_count;
+    /**
+     * @name warmup_nanoseconds
+     * @brief How long each benchmark runs before it's measured.
+     */
+    uint64_t warmup_nanoseconds;
+    /**
+     * @name sample_nanoseconds
+     * @brief The minimum duration of a sample. Iteration counts are
+     * scaled up until samples last at least this long.
+     */
+    uint64_t sample_nanoseconds;
+    /**
+     * @name run_count
+     * @brief The number of benchmarks run so far.
+     */
+    uint32_t run_count;
+    /**
+     * @name counters
+     * @brief The hardware counters read around each sample. Closed if
+     * unavailable or disabled with --no-counters.
+     */
+    ir_counter_group_t counters;
+} ir_benchmark_suite_t;
+
+/**
+ * @name BenchmarkBegin
+ * @authors Israfiel
+ * @brief Start a suite, parsing the harness' command line options:
+ * --json=[path], --samples=[count], --warmup-ms=[ms], --filter=[text],
+ * --no-counters.
+ *
+ * @param suite - The suite to initialize.
+ * @param name - The suite's name.
+ * @param argc - The program's argument count.
+ * @param argv - The program's arguments.
+ * @returns Whether the options were valid.
+ */
+bool Ir_BenchmarkBegin(ir_benchmark_suite_t *suite, const char *name,
+                       int argc, char **argv);
+
+/**
+ * @name BenchmarkRun
+ * @authors Israfiel
+ * @brief Warm up, measure, and report a single benchmark.
+ *
+ * @param suite - The suite the benchmark belongs to.
+ * @param name - The benchmark's name.
+ * @param function - The benchmark body.
+ * @param context - Passed through to the body.
+ */
+void Ir_BenchmarkRun(ir_benchmark_suite_t *suite, const char *name,
+                     ir_benchmark_function_t function, void *context);
+
+/**
+ * @name BenchmarkEnd
+ * @authors Israfiel
+ * @brief Finish a suite, closing its JSON output and counters.
+ *
+ * @param suite - The suite to finish.
+ * @returns The program's exit code.
+ */
+int Ir_BenchmarkEnd(ir_benchmark_suite_t *suite);
+
+/**
+ * @name BenchmarkKeep
+ * @authors Israfiel
+ * @brief Stop the compiler from optimizing away a computation whose
+ * result is otherwise unused.
+ *
+ * @param value - A pointer to the result.
+ */
+static inline void Ir_BenchmarkKeep(const void *value)
+{
+    __asm__ volatile("" : : "r"(value) : "memory");
+}
+
+#endif // IRIDIUM_HARNESS_BENCHMARK_H
@@ -0,0 +1,221 @@
+/**
+ * @file Narrowphase.c
+ * @authors Israfiel
+ * @brief Benchmarks for the narrowphase: single queries between each
+ * kind of shape, cold and warm-started, and a resting pile of mixed
+ * shapes run through the broadphase and narrowphase together.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+#include <stdlib.h>
+
+/**
+ * @name HULL_POINTS
+ * @brief The number of points in the benchmarks' hulls.
+ */
+#define HULL_POINTS 64
+
+/**
+ * @name query_t
+ * @brief Two placed shapes and the direction their last query ended on.
+ */
+typedef struct query
+{
+    ir_shape_t a;
+    ir_shape_t b;
+    ir_transform_t transform_a;
+    ir_transform_t transform_b;
+    bool warm;
+    ir_vec3_t direction;
+} query_t;
+
+/**
+ * @name pile_t
+ * @brief A grid of shapes and the phases colliding them.
+ */
+typedef struct pile
+{
+    ir_broadphase_t broadphase;
+    ir_narrowphase_t narrowphase;
+    ir_jobs_t *jobs;
+    ir_shape_t *shapes;
+    ir_transform_t *transforms;
+} pile_t;
+
+/**
+ * @name Contact
+ * @authors Israfiel
+ * @brief Query two shapes, from last time's direction when warm.
+ *
+ * @param context - The query.
+ * @param iterations - The number of queries.
+ */
+static void Contact(void *context, uint64_t iterations)
+{
+    query_t *query = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        ir_contact_t contact;
+        Ir_ShapeContact(&query->a, &query->transform_a, &query->b,
+                        &query->transform_b,
+                        query->warm ? query->direction
+                                    : Ir_Vec3(0.0f, 0.0f, 0.0f),
+                        &contact);
+        query->direction = contact.direction;
+        Ir_BenchmarkKeep(&contact);
+    }
+}
+
+/**
+ * @name Collide
+ * @authors Israfiel
+ * @brief Run the pile through both phases.
+ *
+ * @param context - The pile.
+ * @param iterations - The number of updates.
+ */
+static void Collide(void *context, uint64_t iterations)
+{
+    pile_t *pile = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        if (!Ir_BroadphaseUpdate(&pile->broadphase, pile->jobs))
+            IR_LOG_FATAL("Ir_BroadphaseUpdate failed.");
+        if (!Ir_NarrowphaseUpdate(&pile->narrowphase, &pile->broadphase,
+                                  pile->shapes, pile->transforms,
+                                  pile->jobs))
+            IR_LOG_FATAL("Ir_NarrowphaseUpdate failed.");
+        Ir_BenchmarkKeep(pile->narrowphase.contacts);
+    }
+}
+
+/**
+ * @name Stack
+ * @authors Israfiel
+ * @brief Lay shapes out on a grid, each just touching its neighbours
+ * and slightly turned, cycling through every kind of shape.
+ *
+ * @param pile - The pile.
+ * @param hull - The hull to use for hulls.
+ * @param side - The number of shapes along each side of the grid.
+ * @returns Whether the shapes were added.
+ */
+static bool Stack(pile_t *pile, const ir_hull_t *hull, uint32_t side)
+{
+    uint32_t count = side * side * side;
+    pile->shapes = malloc(count * sizeof(ir_shape_t));
+    pile->transforms = malloc(count * sizeof(ir_transform_t));
+    if (pile->shapes == NULL || pile->transforms == NULL) return false;
+
+    Ir_BroadphaseCreate(&pile->broadphase);
+    Ir_NarrowphaseCreate(&pile->narrowphase);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        switch (i % 4)
+        {
+            case 0: pile->shapes[i] = Ir_ShapeSphere(0.5f); break;
+            case 1: pile->shapes[i] = Ir_ShapeCapsule(0.25f, 0.25f); break;
+            case 2:
+                pile->shapes[i] =
+                    Ir_ShapeBox(Ir_Vec3(0.5f, 0.5f, 0.5f), 0.02f);
+                break;
+            default: pile->shapes[i] = Ir_ShapeHull(hull, 0.02f); break;
+        }
+        pile->transforms[i] = (ir_transform_t){
+            Ir_Vec3((float)(i % side), (float)(i / side % side),
+                    (float)(i / side / side)),
+            Ir_QuatAxisAngle(Ir_Vec3(0.0f, 1.0f, 0.0f), 0.1f * i)};
+
+        ir_vec3_t min, max;
+        Ir_ShapeBounds(&pile->shapes[i], &pile->transforms[i], &min,
+                       &max);
+        if (Ir_BroadphaseAdd(&pile->broadphase, min, max) ==
+            IR_BROADPHASE_NONE)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Narrowphase", argc, argv)) return 1;
+
+    ir_jobs_t *jobs = malloc(sizeof(ir_jobs_t));
+    if (jobs == NULL || !Ir_JobsCreate(jobs, 0)) return 1;
+
+    // Points on a sphere, so every one of them is a hull vertex.
+    ir_random_t random;
+    Ir_RandomSeed(&random, 0x5EED, 0);
+    ir_vec3_t points[HULL_POINTS];
+    for (int i = 0; i < HULL_POINTS; ++i)
+        points[i] = Ir_Vec3Scale(
+            Ir_Vec3Normalize(Ir_Vec3(Ir_RandomFloat(&random) - 0.5f,
+                                     Ir_RandomFloat(&random) - 0.5f,
+                                     Ir_RandomFloat(&random) - 0.5f),
+                             Ir_Vec3(1.0f, 0.0f, 0.0f)),
+            0.5f);
+    ir_hull_t hull;
+    if (!Ir_HullCreate(&hull, points, HULL_POINTS)) return 1;
+
+    ir_shape_t box = Ir_ShapeBox(Ir_Vec3(0.5f, 0.5f, 0.5f), 0.02f);
+    ir_shape_t capsule = Ir_ShapeCapsule(0.5f, 0.25f);
+    ir_shape_t rounded = Ir_ShapeHull(&hull, 0.02f);
+    ir_transform_t here = {Ir_Vec3(0.0f, 0.0f, 0.0f), IR_QUAT_IDENTITY};
+    ir_transform_t apart = {
+        Ir_Vec3(1.2f, 0.3f, 0.1f),
+        Ir_QuatAxisAngle(Ir_Vec3(0.0f, 0.0f, 1.0f), 0.4f)};
+    ir_transform_t sunk = {
+        Ir_Vec3(0.8f, 0.2f, 0.1f),
+        Ir_QuatAxisAngle(Ir_Vec3(0.0f, 0.0f, 1.0f), 0.4f)};
+
+    static const char *const names[] = {
+        "Box/Box/Apart",       "Box/Box/Apart/Warm",
+        "Box/Box/Sunk",        "Capsule/Box/Apart/Warm",
+        "Hull/Hull/Apart",     "Hull/Hull/Apart/Warm",
+        "Hull/Hull/Sunk/Warm",
+    };
+    query_t queries[] = {
+        {box, box, here, apart, false, {0}},
+        {box, box, here, apart, true, {0}},
+        {box, box, here, sunk, false, {0}},
+        {capsule, box, here, apart, true, {0}},
+        {rounded, rounded, here, apart, false, {0}},
+        {rounded, rounded, here, apart, true, {0}},
+        {rounded, rounded, here, sunk, true, {0}},
+    };
+    for (size_t i = 0; i < sizeof(queries) / sizeof(*queries); ++i)
+        Ir_BenchmarkRun(&suite, names[i], Contact, &queries[i]);
+
+    static const struct
+    {
+        const char *name;
+        uint32_t side;
+        bool parallel;
+    } sizes[] = {
+        {"Pile/4K", 16, false},
+        {"Pile/4K/Jobs", 16, true},
+        {"Pile/32K/Jobs", 32, true},
+    };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+    {
+        pile_t pile = {.jobs = sizes[i].parallel ? jobs : NULL};
+        if (Stack(&pile, &hull, sizes[i].side))
+            Ir_BenchmarkRun(&suite, sizes[i].name, Collide, &pile);
+        Ir_NarrowphaseDestroy(&pile.narrowphase);
+        Ir_BroadphaseDestroy(&pile.broadphase);
+        free(pile.shapes);
+        free(pile.transforms);
+    }
+
+    Ir_HullDestroy(&hull);
+    Ir_JobsDestroy(jobs);
+    free(jobs);
+    return Ir_BenchmarkEnd(&suite);
+}
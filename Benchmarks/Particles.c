@@ -0,0 +1,157 @@
+/**
+ * @file Particles.c
+ * @authors Israfiel
+ * @brief Benchmarks for simulating particles and writing them out as
+ * instances.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+#include <stdlib.h>
+
+/**
+ * @name EMITTERS
+ * @brief The number of emitters, each a fountain of sparks.
+ */
+#define EMITTERS 16
+
+/**
+ * @name RATE
+ * @brief The particles each emitter gives off a second, which with two
+ * second lifetimes keeps about 100,000 alive.
+ */
+#define RATE 3125.0f
+
+/**
+ * @name BLOCKS
+ * @brief The number of blocks in the pool, enough for every particle.
+ */
+#define BLOCKS 512
+
+/**
+ * @name effects_t
+ * @brief A scene's worth of particle effects over a floor.
+ */
+typedef struct effects
+{
+    ir_particle_system_t system;
+    ir_particle_emitter_t emitters[EMITTERS];
+    ir_particle_instance_t *instances;
+    ir_jobs_t *jobs;
+} effects_t;
+
+/**
+ * @name Update
+ * @authors Israfiel
+ * @brief Step the effects by a frame.
+ *
+ * @param context - The effects.
+ * @param iterations - The number of frames.
+ */
+static void Update(void *context, uint64_t iterations)
+{
+    effects_t *effects = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        uint32_t live =
+            Ir_ParticlesUpdate(&effects->system, effects->emitters,
+                               EMITTERS, 1.0f / 60.0f, effects->jobs);
+        Ir_BenchmarkKeep(&live);
+    }
+}
+
+/**
+ * @name Write
+ * @authors Israfiel
+ * @brief Write the effects' particles out as instances.
+ *
+ * @param context - The effects.
+ * @param iterations - The number of frames.
+ */
+static void Write(void *context, uint64_t iterations)
+{
+    effects_t *effects = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        Ir_ParticlesWrite(&effects->system, effects->emitters, EMITTERS,
+                          effects->instances,
+                          BLOCKS * IR_PARTICLE_BLOCK, effects->jobs);
+        Ir_BenchmarkKeep(effects->instances);
+    }
+}
+
+/**
+ * @name Gather
+ * @authors Israfiel
+ * @brief Set the fountains going in a row over the floor, and run them
+ * until as many particles die as are born each frame.
+ *
+ * @param effects - The effects.
+ * @returns Whether there was memory for them.
+ */
+static bool Gather(effects_t *effects)
+{
+    size_t capacity = BLOCKS * IR_PARTICLE_BLOCK;
+    effects->instances = malloc(capacity * sizeof(ir_particle_instance_t));
+    if (effects->instances == NULL ||
+        !Ir_ParticleSystemCreate(&effects->system, BLOCKS))
+        return false;
+
+    ir_particle_system_t *system = &effects->system;
+    system->gravity = Ir_Vec3(0.0f, -9.8f, 0.0f);
+    system->drag = 0.1f;
+    system->restitution = 0.4f;
+    system->friction = 0.2f;
+    system->planes[0] =
+        (ir_particle_plane_t){Ir_Vec3(0.0f, 1.0f, 0.0f), 0.0f};
+    system->plane_count = 1;
+    for (uint32_t i = 0; i < EMITTERS; ++i)
+    {
+        ir_particle_emitter_t *emitter = &effects->emitters[i];
+        if (!Ir_ParticleEmitterCreate(system, emitter, i + 1))
+            return false;
+        emitter->position = Ir_Vec3(2.0f * (float)i, 1.0f, 0.0f);
+        emitter->velocity = Ir_Vec3(0.0f, 5.0f, 0.0f);
+        emitter->spread = 3.0f;
+        emitter->rate = RATE;
+        emitter->lifetime = 2.0f;
+        emitter->lifetime_spread = 0.5f;
+        emitter->size = 0.05f;
+    }
+    for (uint32_t i = 0; i < 180; ++i)
+        Ir_ParticlesUpdate(system, effects->emitters, EMITTERS,
+                           1.0f / 60.0f, NULL);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Particles", argc, argv)) return 1;
+
+    ir_jobs_t *jobs = malloc(sizeof(ir_jobs_t));
+    if (jobs == NULL || !Ir_JobsCreate(jobs, 0)) return 1;
+
+    effects_t effects = {0};
+    if (Gather(&effects))
+    {
+        Ir_BenchmarkRun(&suite, "Update/100k", Update, &effects);
+        Ir_BenchmarkRun(&suite, "Write/100k", Write, &effects);
+        effects.jobs = jobs;
+        Ir_BenchmarkRun(&suite, "Update/100k/Jobs", Update, &effects);
+        Ir_BenchmarkRun(&suite, "Write/100k/Jobs", Write, &effects);
+    }
+    for (uint32_t i = 0; i < EMITTERS; ++i)
+        Ir_ParticleEmitterDestroy(&effects.system, &effects.emitters[i]);
+    Ir_ParticleSystemDestroy(&effects.system);
+    free(effects.instances);
+
+    Ir_JobsDestroy(jobs);
+    free(jobs);
+    return Ir_BenchmarkEnd(&suite);
+}
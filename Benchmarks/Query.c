@@ -0,0 +1,283 @@
+/**
+ * @file Query.c
+ * @authors Israfiel
+ * @brief Benchmarks for batched scene queries: building the tree over a
+ * field of mixed shapes, and batches of rays and capsule casts through
+ * it, on one thread and across the pool.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * @name SHAPES
+ * @brief The number of shapes in the field.
+ */
+#define SHAPES 10000
+
+/**
+ * @name RAYS
+ * @brief The number of rays, or casts, in a batch.
+ */
+#define RAYS 16384
+
+/**
+ * @name field_t
+ * @brief Shapes scattered over a wide, flat field, the tree over them,
+ * and a batch of queries through it.
+ */
+typedef struct field
+{
+    ir_broadphase_t broadphase;
+    ir_query_t query;
+    ir_jobs_t *jobs;
+    ir_shape_t *shapes;
+    ir_transform_t *transforms;
+    ir_shape_t capsule;
+    ir_ray_t *rays;
+    ir_cast_t *casts;
+    ir_hit_t *hits;
+} field_t;
+
+/**
+ * @name Build
+ * @authors Israfiel
+ * @brief Rebuild the tree over the field.
+ *
+ * @param context - The field.
+ * @param iterations - The number of builds.
+ */
+static void Build(void *context, uint64_t iterations)
+{
+    field_t *field = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        if (!Ir_QueryBuild(&field->query, &field->broadphase, field->jobs))
+            IR_LOG_FATAL("Ir_QueryBuild failed.");
+        Ir_BenchmarkKeep(field->query.nodes);
+    }
+}
+
+/**
+ * @name Rays
+ * @authors Israfiel
+ * @brief Cast the batch of rays.
+ *
+ * @param context - The field.
+ * @param iterations - The number of batches.
+ */
+static void Rays(void *context, uint64_t iterations)
+{
+    field_t *field = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        if (!Ir_QueryRays(&field->query, field->rays, RAYS, field->shapes,
+                          field->transforms, field->hits, field->jobs))
+            IR_LOG_FATAL("Ir_QueryRays failed.");
+        Ir_BenchmarkKeep(field->hits);
+    }
+}
+
+/**
+ * @name Casts
+ * @authors Israfiel
+ * @brief Cast the batch of capsules.
+ *
+ * @param context - The field.
+ * @param iterations - The number of batches.
+ */
+static void Casts(void *context, uint64_t iterations)
+{
+    field_t *field = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        if (!Ir_QueryCasts(&field->query, field->casts, RAYS,
+                           field->shapes, field->transforms, field->hits,
+                           field->jobs))
+            IR_LOG_FATAL("Ir_QueryCasts failed.");
+        Ir_BenchmarkKeep(field->hits);
+    }
+}
+
+/**
+ * @name Check
+ * @authors Israfiel
+ * @brief Make sure rays against a lone sharp box, whose tree has three
+ * unused children, hit it where they should. One reaches forever along
+ * a diagonal past the box, and the rest come in aslant onto each face
+ * and must come back with that face's normal.
+ */
+static void Check(void)
+{
+    ir_broadphase_t broadphase;
+    ir_query_t query;
+    Ir_BroadphaseCreate(&broadphase);
+    Ir_QueryCreate(&query);
+    ir_shape_t box = Ir_ShapeBox(Ir_Vec3(1.0f, 1.0f, 1.0f), 0.0f);
+    ir_transform_t transform = {Ir_Vec3(0.0f, 0.0f, 0.0f),
+                                IR_QUAT_IDENTITY};
+    ir_vec3_t min, max;
+    Ir_ShapeBounds(&box, &transform, &min, &max);
+    if (Ir_BroadphaseAdd(&broadphase, min, max) == IR_BROADPHASE_NONE ||
+        !Ir_QueryBuild(&query, &broadphase, NULL))
+        IR_LOG_FATAL("Couldn't build the checked tree.");
+
+    float diagonal = 1.0f / sqrtf(3.0f);
+    ir_ray_t rays[8] = {
+        {Ir_Vec3(-5.0f, -5.0f, -5.0f),
+         Ir_Vec3(diagonal, diagonal, diagonal), INFINITY,
+         IR_BROADPHASE_NONE},
+        {Ir_Vec3(5.0f, 5.0f, 5.0f), Ir_Vec3(diagonal, diagonal, diagonal),
+         INFINITY, IR_BROADPHASE_NONE},
+    };
+    ir_vec3_t normals[6];
+    for (int face = 0; face < 6; ++face)
+    {
+        float sign = face < 3 ? 1.0f : -1.0f;
+        float n[3] = {0.0f, 0.0f, 0.0f}, target[3] = {0.3f, -0.2f, 0.4f};
+        n[face % 3] = sign;
+        target[face % 3] = sign;
+        normals[face] = Ir_Vec3(n[0], n[1], n[2]);
+        ir_vec3_t aim = Ir_Vec3(target[0], target[1], target[2]);
+        ir_vec3_t origin = Ir_Vec3Add(
+            aim, Ir_Vec3Add(Ir_Vec3Scale(normals[face], 3.0f),
+                            Ir_Vec3(0.7f, 0.5f, -0.6f)));
+        ir_vec3_t direction = Ir_Vec3Normalize(Ir_Vec3Sub(aim, origin),
+                                               Ir_Vec3(1.0f, 0.0f, 0.0f));
+        rays[face + 2] = (ir_ray_t){origin, direction, 10.0f,
+                                    IR_BROADPHASE_NONE};
+    }
+
+    ir_hit_t hits[8];
+    if (!Ir_QueryRays(&query, rays, 8, &box, &transform, hits, NULL))
+        IR_LOG_FATAL("Ir_QueryRays failed.");
+    if (hits[0].proxy != 0 ||
+        fabsf(hits[0].distance - 4.0f / diagonal) > 1e-3f)
+        IR_LOG_FATAL("An endless ray missed the box ahead of it.");
+    if (hits[1].proxy != IR_BROADPHASE_NONE)
+        IR_LOG_FATAL("An endless ray hit the box behind it.");
+    for (int face = 0; face < 6; ++face)
+        if (hits[face + 2].proxy != 0 ||
+            Ir_Vec3Dot(hits[face + 2].normal, normals[face]) < 0.999f)
+            IR_LOG_FATAL("A ray onto face %d got the wrong normal.", face);
+
+    Ir_QueryDestroy(&query);
+    Ir_BroadphaseDestroy(&broadphase);
+}
+
+/**
+ * @name Scatter
+ * @authors Israfiel
+ * @brief Scatter spheres, capsules, and boxes over the field, turned
+ * every which way, and aim queries across it from random points, as
+ * sight lines and bullets would be.
+ *
+ * @param field - The field.
+ * @returns Whether there was memory for it.
+ */
+static bool Scatter(field_t *field)
+{
+    field->shapes = malloc(SHAPES * sizeof(ir_shape_t));
+    field->transforms = malloc(SHAPES * sizeof(ir_transform_t));
+    field->rays = malloc(RAYS * sizeof(ir_ray_t));
+    field->casts = malloc(RAYS * sizeof(ir_cast_t));
+    field->hits = malloc(RAYS * sizeof(ir_hit_t));
+    if (field->shapes == NULL || field->transforms == NULL ||
+        field->rays == NULL || field->casts == NULL || field->hits == NULL)
+        return false;
+
+    Ir_BroadphaseCreate(&field->broadphase);
+    Ir_QueryCreate(&field->query);
+    field->capsule = Ir_ShapeCapsule(0.5f, 0.3f);
+
+    ir_random_t random;
+    Ir_RandomSeed(&random, 69, 0);
+    for (uint32_t i = 0; i < SHAPES; ++i)
+    {
+        float size = 0.25f + Ir_RandomFloat(&random);
+        switch (i % 3)
+        {
+            case 0: field->shapes[i] = Ir_ShapeSphere(size); break;
+            case 1: field->shapes[i] = Ir_ShapeCapsule(size, 0.3f); break;
+            default:
+                field->shapes[i] =
+                    Ir_ShapeBox(Ir_Vec3(size, 0.5f, size), 0.02f);
+                break;
+        }
+        ir_vec3_t axis = Ir_Vec3Normalize(
+            Ir_Vec3(Ir_RandomFloat(&random) - 0.5f,
+                    Ir_RandomFloat(&random) - 0.5f,
+                    Ir_RandomFloat(&random) - 0.5f),
+            Ir_Vec3(0.0f, 1.0f, 0.0f));
+        field->transforms[i] = (ir_transform_t){
+            Ir_Vec3(200.0f * Ir_RandomFloat(&random),
+                    10.0f * Ir_RandomFloat(&random),
+                    200.0f * Ir_RandomFloat(&random)),
+            Ir_QuatAxisAngle(axis, 6.0f * Ir_RandomFloat(&random))};
+
+        ir_vec3_t min, max;
+        Ir_ShapeBounds(&field->shapes[i], &field->transforms[i], &min,
+                       &max);
+        if (Ir_BroadphaseAdd(&field->broadphase, min, max) ==
+            IR_BROADPHASE_NONE)
+            return false;
+    }
+
+    for (uint32_t i = 0; i < RAYS; ++i)
+    {
+        ir_vec3_t origin = Ir_Vec3(200.0f * Ir_RandomFloat(&random),
+                                   1.0f + 8.0f * Ir_RandomFloat(&random),
+                                   200.0f * Ir_RandomFloat(&random));
+        ir_vec3_t direction = Ir_Vec3Normalize(
+            Ir_Vec3(Ir_RandomFloat(&random) - 0.5f,
+                    0.2f * (Ir_RandomFloat(&random) - 0.5f),
+                    Ir_RandomFloat(&random) - 0.5f),
+            Ir_Vec3(1.0f, 0.0f, 0.0f));
+        field->rays[i] = (ir_ray_t){origin, direction, 50.0f,
+                                    IR_BROADPHASE_NONE};
+        field->casts[i] = (ir_cast_t){
+            &field->capsule, {origin, IR_QUAT_IDENTITY}, direction,
+            50.0f, IR_BROADPHASE_NONE};
+    }
+    return Ir_QueryBuild(&field->query, &field->broadphase, NULL);
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Query", argc, argv)) return 1;
+
+    ir_jobs_t *jobs = malloc(sizeof(ir_jobs_t));
+    if (jobs == NULL || !Ir_JobsCreate(jobs, 0)) return 1;
+
+    Check();
+    field_t field = {0};
+    if (Scatter(&field))
+    {
+        Ir_BenchmarkRun(&suite, "Build/10K", Build, &field);
+        Ir_BenchmarkRun(&suite, "Rays/16K", Rays, &field);
+        Ir_BenchmarkRun(&suite, "Casts/16K", Casts, &field);
+        field.jobs = jobs;
+        Ir_BenchmarkRun(&suite, "Build/10K/Jobs", Build, &field);
+        Ir_BenchmarkRun(&suite, "Rays/16K/Jobs", Rays, &field);
+        Ir_BenchmarkRun(&suite, "Casts/16K/Jobs", Casts, &field);
+    }
+    Ir_QueryDestroy(&field.query);
+    Ir_BroadphaseDestroy(&field.broadphase);
+    free(field.shapes);
+    free(field.transforms);
+    free(field.rays);
+    free(field.casts);
+    free(field.hits);
+
+    Ir_JobsDestroy(jobs);
+    free(jobs);
+    return Ir_BenchmarkEnd(&suite);
+}
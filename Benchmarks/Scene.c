@@ -0,0 +1,108 @@
+/**
+ * @file Scene.c
+ * @authors Israfiel
+ * @brief Benchmarks for loading baked scenes.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @name node_t
+ * @brief A stand-in scene node with a parent and a sibling pointer.
+ */
+typedef struct node
+{
+    struct node *parent;
+    struct node *sibling;
+    float transform[12];
+} node_t;
+
+/**
+ * @name Bake
+ * @authors Israfiel
+ * @brief Bake a scene of nodes into a temporary file.
+ *
+ * @param path - The file to bake into.
+ * @param count - The number of nodes.
+ * @returns Whether the scene was baked.
+ */
+static bool Bake(const char *path, uint32_t count)
+{
+    ir_scene_writer_t writer;
+    if (Ir_SceneWriterCreate(&writer) != IR_SCENE_OK) return false;
+
+    uint64_t nodes = Ir_SceneWriterAllocate(&writer, count * sizeof(node_t),
+                                            alignof(node_t));
+    for (uint32_t i = 1; i < count; ++i)
+    {
+        uint64_t node = nodes + i * sizeof(node_t);
+        Ir_SceneWriterPointer(&writer, node + offsetof(node_t, parent),
+                              nodes + (i - 1) / 4 * sizeof(node_t));
+        Ir_SceneWriterPointer(&writer, node + offsetof(node_t, sibling),
+                              nodes + (i - 1) * sizeof(node_t));
+    }
+    Ir_SceneWriterSetRoot(&writer, nodes);
+
+    bool saved = Ir_SceneWriterSave(&writer, path) == IR_SCENE_OK;
+    Ir_SceneWriterDestroy(&writer);
+    return saved;
+}
+
+/**
+ * @name Load
+ * @authors Israfiel
+ * @brief Map, fix up, and unmap a baked scene.
+ *
+ * @param context - The scene's path.
+ * @param iterations - The number of loads.
+ */
+static void Load(void *context, uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        ir_scene_t scene;
+        if (Ir_SceneLoad(context, &scene) != IR_SCENE_OK)
+            IR_LOG_FATAL("Ir_SceneLoad failed.");
+        Ir_BenchmarkKeep(scene.root);
+        Ir_SceneUnload(&scene);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Scene", argc, argv)) return 1;
+
+    static const struct
+    {
+        const char *name;
+        uint32_t count;
+    } sizes[] = {
+        {"Load/1K", 1000},
+        {"Load/64K", 64000},
+        {"Load/1M", 1000000},
+    };
+
+    char path[] = "/tmp/IridiumBenchmarkXXXXXX";
+    int descriptor = mkstemp(path);
+    if (descriptor == -1) return 1;
+    close(descriptor);
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+    {
+        if (!Bake(path, sizes[i].count)) break;
+        Ir_BenchmarkRun(&suite, sizes[i].name, Load, path);
+    }
+
+    remove(path);
+    return Ir_BenchmarkEnd(&suite);
+}
@@ -0,0 +1,190 @@
+/**
+ * @file Skinning.c
+ * @authors Israfiel
+ * @brief Benchmarks for skinning a crowd's meshes into a frame's shared
+ * output.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @name JOINTS
+ * @brief The number of joints in the skeleton, about a game character's.
+ */
+#define JOINTS 80
+
+/**
+ * @name VERTICES
+ * @brief The number of vertices in the mesh.
+ */
+#define VERTICES 8000
+
+/**
+ * @name INSTANCES
+ * @brief The number of characters skinned each frame.
+ */
+#define INSTANCES 64
+
+/**
+ * @name crowd_t
+ * @brief A crowd of characters sharing one skin, each in its own pose.
+ */
+typedef struct crowd
+{
+    ir_scene_t scene;
+    ir_joint_matrix_t *matrices;
+    ir_skinned_instance_t instances[INSTANCES];
+    ir_skinning_t skinning;
+    ir_jobs_t *jobs;
+} crowd_t;
+
+/**
+ * @name Dispatch
+ * @authors Israfiel
+ * @brief Skin the crowd.
+ *
+ * @param context - The crowd.
+ * @param iterations - The number of frames.
+ */
+static void Dispatch(void *context, uint64_t iterations)
+{
+    crowd_t *crowd = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        if (!Ir_SkinningDispatch(&crowd->skinning, crowd->instances,
+                                 INSTANCES, crowd->jobs))
+            IR_LOG_FATAL("Ir_SkinningDispatch failed.");
+        Ir_BenchmarkKeep(crowd->skinning.positions);
+    }
+}
+
+/**
+ * @name Bake
+ * @authors Israfiel
+ * @brief Bake a cylinder of vertices, each following the joints along
+ * its height, into a temporary file.
+ *
+ * @param path - The file to bake into.
+ * @returns Whether the skin was baked.
+ */
+static bool Bake(const char *path)
+{
+    ir_joint_matrix_t binds[JOINTS] = {0};
+    ir_skin_vertex_t *vertices = malloc(VERTICES * sizeof(*vertices));
+    ir_scene_writer_t writer;
+    if (vertices == NULL || Ir_SceneWriterCreate(&writer) != IR_SCENE_OK)
+    {
+        free(vertices);
+        return false;
+    }
+
+    // The joints are stacked up the cylinder, so each one's bind is a
+    // step along y, undone by its inverse.
+    for (uint32_t i = 0; i < JOINTS; ++i)
+    {
+        for (int j = 0; j < 3; ++j) binds[i].rows[j][j] = 1.0f;
+        binds[i].rows[1][3] = -0.1f * (float)i;
+    }
+    for (uint32_t i = 0; i < VERTICES; ++i)
+    {
+        float angle = 0.1f * (float)i;
+        float height = 0.1f * (JOINTS - 1) * (float)i / VERTICES;
+        uint16_t joint = (uint16_t)(height / 0.1f);
+        ir_skin_vertex_t *vertex = &vertices[i];
+        *vertex = (ir_skin_vertex_t){
+            .position = Ir_Vec3(cosf(angle), height, sinf(angle)),
+            .normal = Ir_Vec3(cosf(angle), 0.0f, sinf(angle)),
+        };
+        for (uint16_t j = 0; j < IR_SKIN_INFLUENCES; ++j)
+        {
+            vertex->joints[j] = (uint16_t)((joint + j) % JOINTS);
+            vertex->weights[j] = (float)(IR_SKIN_INFLUENCES - j);
+        }
+    }
+    uint64_t skin =
+        Ir_SkinBake(&writer, vertices, VERTICES, binds, JOINTS);
+    Ir_SceneWriterSetRoot(&writer, skin);
+
+    bool saved =
+        skin != 0 && Ir_SceneWriterSave(&writer, path) == IR_SCENE_OK;
+    Ir_SceneWriterDestroy(&writer);
+    free(vertices);
+    return saved;
+}
+
+/**
+ * @name Gather
+ * @authors Israfiel
+ * @brief Load the skin and give each character a pose of its joints
+ * turned about y by its own amount.
+ *
+ * @param crowd - The crowd.
+ * @param path - The baked skin.
+ * @returns Whether there was memory for it.
+ */
+static bool Gather(crowd_t *crowd, const char *path)
+{
+    crowd->matrices =
+        malloc(INSTANCES * JOINTS * sizeof(ir_joint_matrix_t));
+    if (crowd->matrices == NULL ||
+        Ir_SceneLoad(path, &crowd->scene) != IR_SCENE_OK)
+        return false;
+
+    for (uint32_t i = 0; i < INSTANCES; ++i)
+    {
+        ir_joint_matrix_t *matrices = &crowd->matrices[i * JOINTS];
+        for (uint32_t j = 0; j < JOINTS; ++j)
+        {
+            float angle = 0.01f * (float)(i + 1) * (float)j;
+            matrices[j] = (ir_joint_matrix_t){{
+                {cosf(angle), 0.0f, sinf(angle), 0.0f},
+                {0.0f, 1.0f, 0.0f, 0.1f * (float)j},
+                {-sinf(angle), 0.0f, cosf(angle), 0.0f},
+            }};
+        }
+        crowd->instances[i] =
+            (ir_skinned_instance_t){crowd->scene.root, matrices};
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Skinning", argc, argv)) return 1;
+
+    ir_jobs_t *jobs = malloc(sizeof(ir_jobs_t));
+    if (jobs == NULL || !Ir_JobsCreate(jobs, 0)) return 1;
+
+    char path[] = "/tmp/IridiumBenchmarkXXXXXX";
+    int descriptor = mkstemp(path);
+    if (descriptor == -1) return 1;
+    close(descriptor);
+
+    crowd_t crowd = {0};
+    Ir_SkinningCreate(&crowd.skinning);
+    if (Bake(path) && Gather(&crowd, path))
+    {
+        Ir_BenchmarkRun(&suite, "Dispatch/64x8000", Dispatch, &crowd);
+        crowd.jobs = jobs;
+        Ir_BenchmarkRun(&suite, "Dispatch/64x8000/Jobs", Dispatch,
+                        &crowd);
+    }
+    Ir_SkinningDestroy(&crowd.skinning);
+    free(crowd.matrices);
+    Ir_SceneUnload(&crowd.scene);
+    remove(path);
+
+    Ir_JobsDestroy(jobs);
+    free(jobs);
+    return Ir_BenchmarkEnd(&suite);
+}
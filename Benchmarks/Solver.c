@@ -0,0 +1,200 @@
+/**
+ * @file Solver.c
+ * @authors Israfiel
+ * @brief Benchmarks for the rigid body solver: resting boxes, either in
+ * separate columns, which make many small islands, or packed into one
+ * block, which makes a single island large enough to be coloured; and
+ * fast bullets fired into the columns, which are stopped by continuous
+ * collision.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name STEP
+ * @brief The length of a step, in seconds.
+ */
+#define STEP (1.0f / 60.0f)
+
+/**
+ * @name BULLET_SPEED
+ * @brief How fast bullets fly, in metres a second: five metres a step,
+ * across several columns.
+ */
+#define BULLET_SPEED 300.0f
+
+/**
+ * @name scene_t
+ * @brief Resting bodies, their contacts, and a copy of the bodies to
+ * reset them from before each step.
+ */
+typedef struct scene
+{
+    ir_broadphase_t broadphase;
+    ir_narrowphase_t narrowphase;
+    ir_solver_t solver;
+    ir_jobs_t *jobs;
+    ir_shape_t *shapes;
+    ir_transform_t *transforms;
+    ir_body_t *bodies;
+    ir_body_t *resting;
+    uint32_t count;
+} scene_t;
+
+/**
+ * @name Step
+ * @authors Israfiel
+ * @brief Step the scene's bodies from where they rest, over and over.
+ *
+ * @param context - The scene.
+ * @param iterations - The number of steps.
+ */
+static void Step(void *context, uint64_t iterations)
+{
+    scene_t *scene = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        memcpy(scene->bodies, scene->resting,
+               scene->count * sizeof(ir_body_t));
+        if (!Ir_SolverStep(&scene->solver, scene->bodies, scene->count,
+                           &scene->narrowphase, STEP, scene->jobs))
+            IR_LOG_FATAL("Ir_SolverStep failed.");
+        Ir_BenchmarkKeep(scene->bodies);
+    }
+}
+
+/**
+ * @name Build
+ * @authors Israfiel
+ * @brief Stand boxes on the ground in layers, one column to a grid cell,
+ * fire bullets at the columns' sides along the grid's rows, and find
+ * their contacts. Each bullet would pass through a box in a step, so
+ * its contacts are found over where it flies, solved speculatively, and
+ * swept.
+ *
+ * @param scene - The scene.
+ * @param side - The number of columns along each side of the grid.
+ * @param height - The number of boxes in each column.
+ * @param spacing - The distance between columns; one packs them into
+ * a block.
+ * @param bullets - The number of bullets.
+ * @returns Whether the scene was built.
+ */
+static bool Build(scene_t *scene, uint32_t side, uint32_t height,
+                  float spacing, uint32_t bullets)
+{
+    uint32_t boxes = side * side * height + 1;
+    uint32_t count = boxes + bullets;
+    scene->count = count;
+    scene->shapes = malloc(count * sizeof(ir_shape_t));
+    scene->transforms = malloc(count * sizeof(ir_transform_t));
+    scene->bodies = malloc(count * sizeof(ir_body_t));
+    scene->resting = malloc(count * sizeof(ir_body_t));
+    if (scene->shapes == NULL || scene->transforms == NULL ||
+        scene->bodies == NULL || scene->resting == NULL)
+        return false;
+
+    Ir_BroadphaseCreate(&scene->broadphase);
+    Ir_NarrowphaseCreate(&scene->narrowphase);
+    Ir_SolverCreate(&scene->solver);
+
+    float extent = spacing * (float)side;
+    scene->shapes[0] = Ir_ShapeBox(Ir_Vec3(extent, 0.5f, extent), 0.0f);
+    scene->resting[0] = Ir_BodyStatic((ir_transform_t){
+        Ir_Vec3(0.0f, -0.5f, 0.0f), IR_QUAT_IDENTITY});
+    for (uint32_t i = 1; i < boxes; ++i)
+    {
+        uint32_t cell = (i - 1) % (side * side);
+        uint32_t layer = (i - 1) / (side * side);
+        scene->shapes[i] = Ir_ShapeBox(Ir_Vec3(0.5f, 0.5f, 0.5f), 0.02f);
+        scene->resting[i] = Ir_BodyDynamic(
+            &scene->shapes[i],
+            (ir_transform_t){Ir_Vec3(spacing * (float)(cell % side),
+                                     0.5f + (float)layer,
+                                     spacing * (float)(cell / side)),
+                             IR_QUAT_IDENTITY},
+            1.0f);
+    }
+    for (uint32_t i = 0; i < bullets; ++i)
+    {
+        ir_body_t *bullet = &scene->resting[boxes + i];
+        float layer = (float)(i / side % height);
+        scene->shapes[boxes + i] = Ir_ShapeSphere(0.05f);
+        *bullet = Ir_BodyDynamic(
+            &scene->shapes[boxes + i],
+            (ir_transform_t){Ir_Vec3(-2.0f, 0.5f + layer,
+                                     spacing * (float)(i % side)),
+                             IR_QUAT_IDENTITY},
+            0.01f);
+        bullet->linear_velocity = Ir_Vec3(BULLET_SPEED, 0.0f, 0.0f);
+        bullet->fast = true;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        scene->transforms[i] = scene->resting[i].transform;
+        ir_vec3_t min, max;
+        Ir_BodyBounds(&scene->resting[i], &scene->shapes[i], STEP,
+                      scene->solver.margin, &min, &max);
+        if (Ir_BroadphaseAdd(&scene->broadphase, min, max) ==
+            IR_BROADPHASE_NONE)
+            return false;
+    }
+    return Ir_BroadphaseUpdate(&scene->broadphase, scene->jobs) &&
+           Ir_NarrowphaseUpdate(&scene->narrowphase, &scene->broadphase,
+                                scene->shapes, scene->transforms,
+                                scene->jobs);
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Solver", argc, argv)) return 1;
+
+    ir_jobs_t *jobs = malloc(sizeof(ir_jobs_t));
+    if (jobs == NULL || !Ir_JobsCreate(jobs, 0)) return 1;
+
+    static const struct
+    {
+        const char *name;
+        uint32_t side;
+        uint32_t height;
+        float spacing;
+        uint32_t bullets;
+        bool parallel;
+    } scenes[] = {
+        {"Columns/1K", 10, 10, 1.5f, 0, false},
+        {"Columns/1K/Jobs", 10, 10, 1.5f, 0, true},
+        {"Block/1K", 10, 10, 1.0f, 0, false},
+        {"Block/1K/Jobs", 10, 10, 1.0f, 0, true},
+        {"Block/8K/Jobs", 20, 20, 1.0f, 0, true},
+        {"Bullets/100", 10, 10, 1.5f, 100, false},
+        {"Bullets/100/Jobs", 10, 10, 1.5f, 100, true},
+    };
+    for (size_t i = 0; i < sizeof(scenes) / sizeof(*scenes); ++i)
+    {
+        scene_t scene = {.jobs = scenes[i].parallel ? jobs : NULL};
+        if (Build(&scene, scenes[i].side, scenes[i].height,
+                  scenes[i].spacing, scenes[i].bullets))
+            Ir_BenchmarkRun(&suite, scenes[i].name, Step, &scene);
+        Ir_SolverDestroy(&scene.solver);
+        Ir_NarrowphaseDestroy(&scene.narrowphase);
+        Ir_BroadphaseDestroy(&scene.broadphase);
+        free(scene.shapes);
+        free(scene.transforms);
+        free(scene.bodies);
+        free(scene.resting);
+    }
+
+    Ir_JobsDestroy(jobs);
+    free(jobs);
+    return Ir_BenchmarkEnd(&suite);
+}
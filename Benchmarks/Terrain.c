@@ -0,0 +1,272 @@
+/**
+ * @file Terrain.c
+ * @authors Israfiel
+ * @brief Benchmarks for streaming, clipmapping, and colliding with
+ * terrain.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Harness/Benchmark.h"
+
+#include <Iridium.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @name CHUNKS
+ * @brief The number of chunks along each side of the terrain.
+ */
+#define CHUNKS 16
+
+/**
+ * @name QUERIES
+ * @brief The number of rays, or capsules, in a batch.
+ */
+#define QUERIES 4096
+
+/**
+ * @name land_t
+ * @brief A baked terrain, streamed around a moving focus, and a batch
+ * of queries against it.
+ */
+typedef struct land
+{
+    ir_scene_t scene;
+    ir_terrain_t terrain;
+    ir_terrain_t whole;
+    ir_clipmap_t clipmap;
+    ir_jobs_t *jobs;
+    float angle;
+    ir_shape_t capsule;
+    ir_vec3_t *origins;
+    ir_vec3_t *directions;
+    ir_transform_t *transforms;
+} land_t;
+
+/**
+ * @name Focus
+ * @authors Israfiel
+ * @brief Move the focus a step further around a wide circle, quickly
+ * enough that a chunk's worth of ground passes every few steps.
+ *
+ * @param land - The land.
+ * @returns The focus.
+ */
+static ir_vec3_t Focus(land_t *land)
+{
+    land->angle += 0.01f;
+    return Ir_Vec3(512.0f + 300.0f * cosf(land->angle), 0.0f,
+                   512.0f + 300.0f * sinf(land->angle));
+}
+
+/**
+ * @name Stream
+ * @authors Israfiel
+ * @brief Stream chunks around the moving focus.
+ *
+ * @param context - The land.
+ * @param iterations - The number of frames.
+ */
+static void Stream(void *context, uint64_t iterations)
+{
+    land_t *land = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+        Ir_BenchmarkKeep(&(uint32_t){
+            Ir_TerrainStream(&land->terrain, Focus(land), land->jobs)});
+}
+
+/**
+ * @name Clipmap
+ * @authors Israfiel
+ * @brief Stream chunks around the moving focus and recentre the
+ * clipmap on it.
+ *
+ * @param context - The land.
+ * @param iterations - The number of frames.
+ */
+static void Clipmap(void *context, uint64_t iterations)
+{
+    land_t *land = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        ir_vec3_t focus = Focus(land);
+        Ir_TerrainStream(&land->terrain, focus, land->jobs);
+        Ir_ClipmapUpdate(&land->clipmap, &land->terrain, focus,
+                         land->jobs);
+        Ir_BenchmarkKeep(land->clipmap.levels);
+    }
+}
+
+/**
+ * @name Rays
+ * @authors Israfiel
+ * @brief Cast the batch of rays at the whole terrain.
+ *
+ * @param context - The land.
+ * @param iterations - The number of batches.
+ */
+static void Rays(void *context, uint64_t iterations)
+{
+    land_t *land = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        for (uint32_t j = 0; j < QUERIES; ++j)
+        {
+            float hit;
+            ir_vec3_t normal;
+            Ir_BenchmarkKeep(&(bool){Ir_HeightfieldRay(
+                &land->whole, land->origins[j], land->directions[j],
+                500.0f, &hit, &normal)});
+        }
+    }
+}
+
+/**
+ * @name Contacts
+ * @authors Israfiel
+ * @brief Find the batch of capsules' contacts with the whole terrain.
+ *
+ * @param context - The land.
+ * @param iterations - The number of batches.
+ */
+static void Contacts(void *context, uint64_t iterations)
+{
+    land_t *land = context;
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        for (uint32_t j = 0; j < QUERIES; ++j)
+        {
+            ir_contact_t contact;
+            Ir_BenchmarkKeep(&(bool){Ir_HeightfieldContact(
+                &land->whole, &land->capsule, &land->transforms[j],
+                0.05f, &contact)});
+        }
+    }
+}
+
+/**
+ * @name Bake
+ * @authors Israfiel
+ * @brief Bake rolling hills into a temporary file.
+ *
+ * @param path - The file to bake into.
+ * @returns Whether the terrain was baked.
+ */
+static bool Bake(const char *path)
+{
+    size_t row = CHUNKS * IR_TERRAIN_CHUNK + 1;
+    float *heights = malloc(row * row * sizeof(float));
+    ir_scene_writer_t writer;
+    if (heights == NULL || Ir_SceneWriterCreate(&writer) != IR_SCENE_OK)
+    {
+        free(heights);
+        return false;
+    }
+
+    for (size_t z = 0; z < row; ++z)
+        for (size_t x = 0; x < row; ++x)
+            heights[z * row + x] =
+                20.0f * sinf((float)x * 0.013f) * cosf((float)z * 0.017f) +
+                2.0f * sinf((float)(x + 2 * z) * 0.11f);
+
+    uint64_t archive = Ir_TerrainBake(&writer, heights, CHUNKS, CHUNKS,
+                                      1.0f);
+    Ir_SceneWriterSetRoot(&writer, archive);
+    bool saved = archive != 0 &&
+                 Ir_SceneWriterSave(&writer, path) == IR_SCENE_OK;
+    Ir_SceneWriterDestroy(&writer);
+    free(heights);
+    return saved;
+}
+
+/**
+ * @name Survey
+ * @authors Israfiel
+ * @brief Load the baked terrain, make the whole of it resident for the
+ * queries, and aim rays down at it from the sky and stand capsules on
+ * it, as line-of-sight checks and characters would.
+ *
+ * @param land - The land.
+ * @param path - The baked terrain.
+ * @returns Whether there was memory for it.
+ */
+static bool Survey(land_t *land, const char *path)
+{
+    land->origins = malloc(QUERIES * sizeof(ir_vec3_t));
+    land->directions = malloc(QUERIES * sizeof(ir_vec3_t));
+    land->transforms = malloc(QUERIES * sizeof(ir_transform_t));
+    if (land->origins == NULL || land->directions == NULL ||
+        land->transforms == NULL ||
+        Ir_SceneLoad(path, &land->scene) != IR_SCENE_OK)
+        return false;
+
+    const ir_terrain_archive_t *archive = land->scene.root;
+    if (!Ir_TerrainCreate(&land->terrain, archive, 200.0f) ||
+        !Ir_TerrainCreate(&land->whole, archive, 2000.0f) ||
+        !Ir_ClipmapCreate(&land->clipmap, 6))
+        return false;
+    land->whole.budget = CHUNKS * CHUNKS;
+    Ir_TerrainStream(&land->whole, Ir_Vec3(512.0f, 0.0f, 512.0f), NULL);
+    land->capsule = Ir_ShapeCapsule(0.6f, 0.3f);
+
+    ir_random_t random;
+    Ir_RandomSeed(&random, 69, 0);
+    for (uint32_t i = 0; i < QUERIES; ++i)
+    {
+        float x = 1000.0f * Ir_RandomFloat(&random) + 12.0f;
+        float z = 1000.0f * Ir_RandomFloat(&random) + 12.0f;
+        land->origins[i] = Ir_Vec3(x, 40.0f, z);
+        land->directions[i] = Ir_Vec3Normalize(
+            Ir_Vec3(Ir_RandomFloat(&random) - 0.5f, -0.3f,
+                    Ir_RandomFloat(&random) - 0.5f),
+            Ir_Vec3(0.0f, -1.0f, 0.0f));
+
+        float height;
+        if (!Ir_TerrainHeight(&land->whole, x, z, &height)) return false;
+        land->transforms[i] = (ir_transform_t){
+            Ir_Vec3(x, height + 0.88f, z), IR_QUAT_IDENTITY};
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    ir_benchmark_suite_t suite;
+    if (!Ir_BenchmarkBegin(&suite, "Terrain", argc, argv)) return 1;
+
+    ir_jobs_t *jobs = malloc(sizeof(ir_jobs_t));
+    if (jobs == NULL || !Ir_JobsCreate(jobs, 0)) return 1;
+
+    char path[] = "/tmp/IridiumBenchmarkXXXXXX";
+    int descriptor = mkstemp(path);
+    if (descriptor == -1) return 1;
+    close(descriptor);
+
+    land_t land = {0};
+    if (Bake(path) && Survey(&land, path))
+    {
+        Ir_BenchmarkRun(&suite, "Stream", Stream, &land);
+        Ir_BenchmarkRun(&suite, "Clipmap/6", Clipmap, &land);
+        Ir_BenchmarkRun(&suite, "Rays/4K", Rays, &land);
+        Ir_BenchmarkRun(&suite, "Contacts/4K", Contacts, &land);
+        land.jobs = jobs;
+        Ir_BenchmarkRun(&suite, "Stream/Jobs", Stream, &land);
+        Ir_BenchmarkRun(&suite, "Clipmap/6/Jobs", Clipmap, &land);
+    }
+    Ir_ClipmapDestroy(&land.clipmap);
+    Ir_TerrainDestroy(&land.whole);
+    Ir_TerrainDestroy(&land.terrain);
+    Ir_SceneUnload(&land.scene);
+    free(land.origins);
+    free(land.directions);
+    free(land.transforms);
+    remove(path);
+
+    Ir_JobsDestroy(jobs);
+    free(jobs);
+    return Ir_BenchmarkEnd(&suite);
+}
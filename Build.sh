@@ -13,12 +13,35 @@ if printf '%s\0' "$@" | grep -Fxqz -- '--help'; then
     echo "                          Possible values: Valgrind, GDB"
     echo "      --static:           Build the library statically."
     echo "      --no-demo:          Do not build engine demos."
+    echo "      --no-tools:         Do not build engine tools."
+    echo "      --no-benchmarks:    Do not build engine benchmarks."
     echo "      --no-docs:          Do not build engine documentation."
+    echo "      --profile:          Compile in the instrumentation profiler."
+    echo "      --no-wayland:       Only build the headless window backend."
     echo "      --verbose:          Show CMake output."
     echo "      --no-example:       Do not run the SimpleWindow example."
+    echo "      --benchmark:        Build in Release, run the benchmarks, and"
+    echo "                          compare them against the saved baseline."
+    echo "      --save-baseline:    With --benchmark, save this run as the"
+    echo "                          baseline for later comparisons."
+    echo "      --threshold=[value]: The percentage a benchmark may slow"
+    echo "                          down before it counts as a regression."
+    echo "                          Defaults to 5."
     exit 0
 fi
 
+run_benchmarks=false
+if printf '%s\0' "$@" | grep -Fxqz -- '--benchmark'; then
+    run_benchmarks=true
+fi
+
+regression_threshold=5
+for argument in "$@"; do
+    case $argument in
+        --threshold=*) regression_threshold=${argument#--threshold=} ;;
+    esac
+done
+
 echo Building the Iridium engine.
 # Make sure we're in the Iridium directory.
 script_directory=$( cd -- "$( dirname -- "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )
@@ -29,6 +52,11 @@ build_type=Release
 if printf '%s\0' "$@" | grep -Fxqz -- '--type=Debug'; then
     build_type=Debug
 fi
+# Debug timings are meaningless, and the tools and benchmarks have to
+# exist to be run.
+if [ "$run_benchmarks" == "true" ]; then
+    build_type=Release
+fi
 echo Building in $build_type mode.
 
 # Flag for CMake so we don't add both Valgrind and ASAN to the same
@@ -59,6 +87,24 @@ if printf '%s\0' "$@" | grep -Fxqz -- '--no-demos'; then
 fi
 echo Building demos: $build_demos.
 
+build_tools=true
+if printf '%s\0' "$@" | grep -Fxqz -- '--no-tools'; then
+    build_tools=false
+fi
+if [ "$run_benchmarks" == "true" ]; then
+    build_tools=true
+fi
+echo Building tools: $build_tools.
+
+build_benchmarks=true
+if printf '%s\0' "$@" | grep -Fxqz -- '--no-benchmarks'; then
+    build_benchmarks=false
+fi
+if [ "$run_benchmarks" == "true" ]; then
+    build_benchmarks=true
+fi
+echo Building benchmarks: $build_benchmarks.
+
 build_docs=true
 if printf '%s\0' "$@" | grep -Fxqz -- '--no-docs'; then
     build_docs=false
@@ -71,14 +117,29 @@ if printf '%s\0' "$@" | grep -Fxqz -- '--verbose'; then
     echo Enabling verbose output.
 fi
 
+enable_profiler=false
+if printf '%s\0' "$@" | grep -Fxqz -- '--profile'; then
+    enable_profiler=true
+    echo Enabling the instrumentation profiler.
+fi
+
+build_wayland=true
+if printf '%s\0' "$@" | grep -Fxqz -- '--no-wayland'; then
+    build_wayland=false
+fi
+echo Building the Wayland backend: $build_wayland.
+
+cmake_options="-DCMAKE_BUILD_TYPE=$build_type -DBUILD_SHARED_LIBS=$build_shared \
+    -DIRIDIUM_BUILD_DEMOS=$build_demos -DIRIDIUM_NO_SANITIZE=$no_sanitize       \
+    -DIRIDIUM_BUILD_DOCS=$build_docs -DIRIDIUM_BUILD_TOOLS=$build_tools         \
+    -DIRIDIUM_BUILD_BENCHMARKS=$build_benchmarks                                \
+    -DIRIDIUM_ENABLE_PROFILER=$enable_profiler                                  \
+    -DIRIDIUM_WAYLAND=$build_wayland"
+
 if [ $verbose_output == "false" ]; then
-    cmake -B build -DCMAKE_BUILD_TYPE=$build_type -DBUILD_SHARED_LIBS=$build_shared \
-        -DIRIDIUM_BUILD_DEMOS=$build_demos -DIRIDIUM_NO_SANITIZE=$no_sanitize       \
-        -DIRIDIUM_BUILD_DOCS=$build_docs > /dev/null || exit 255
+    cmake -B build $cmake_options > /dev/null || exit 255
 else
-    cmake -B build -DCMAKE_BUILD_TYPE=$build_type -DBUILD_SHARED_LIBS=$build_shared \
-        -DIRIDIUM_BUILD_DEMOS=$build_demos -DIRIDIUM_NO_SANITIZE=$no_sanitize       \
-        -DIRIDIUM_BUILD_DOCS=$build_docs || exit 255
+    cmake -B build $cmake_options || exit 255
 fi
 
 # Enter the build directory so we can actually build the project.
@@ -90,6 +151,44 @@ else
     make || exit 255
 fi
 
+if [ "$run_benchmarks" == "true" ]; then
+    # Results live outside the build directory so a clean build doesn't
+    # lose them. Uncommitted changes get their own key.
+    results_directory=$script_directory/BenchmarkResults
+    commit=$(git -C $script_directory rev-parse --short HEAD 2> /dev/null || echo unknown)
+    if [ -n "$(git -C $script_directory status --porcelain --untracked-files=no 2> /dev/null)" ]; then
+        commit=$commit-dirty
+    fi
+    run_directory=$results_directory/$commit
+    rm -rf $run_directory
+    mkdir -p $run_directory
+
+    echo Running benchmarks for $commit.
+    cd Iridium/Benchmarks
+    for benchmark in ./*Benchmark; do
+        $benchmark --json=$run_directory/$(basename $benchmark).json || exit 255
+    done
+    cd ../..
+
+    comparison=0
+    if [ -d $results_directory/Baseline ]; then
+        echo Comparing against the baseline from $(cat $results_directory/Baseline/Commit).
+        ./Iridium/Tools/BenchmarkCompare $results_directory/Baseline $run_directory \
+            --threshold=$regression_threshold
+        comparison=$?
+    else
+        echo No baseline saved\; skipping comparison.
+    fi
+
+    if printf '%s\0' "$@" | grep -Fxqz -- '--save-baseline'; then
+        rm -rf $results_directory/Baseline
+        cp -r $run_directory $results_directory/Baseline
+        echo $commit > $results_directory/Baseline/Commit
+        echo Saved $commit as the baseline.
+    fi
+    exit $comparison
+fi
+
 if printf '%s\0' "$@" | grep -Fxqz -- '--no-example'; then
     exit 0
 fi
@@ -1 +1,114 @@
-int main(void) { return 0; }
+/**
+ * @file SimpleWindow.c
+ * @authors Israfiel
+ * @brief Open a window and run an empty frame loop until it's closed.
+ * The loop waits on the event loop until the window's frame pacer says
+ * the next frame is due, so the compositor is serviced between frames
+ * without ever stalling one. Given a frame count, it closes itself after
+ * that many frames, so it can run unattended with the headless backend.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include <Iridium.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @name frames
+ * @brief The number of frames run so far.
+ */
+static uint64_t frames;
+
+/**
+ * @name input
+ * @brief The input drained each frame.
+ */
+static ir_input_batch_t input;
+
+/**
+ * @name ShowFrameRate
+ * @authors Israfiel
+ * @brief Put the last second's frame count in the window's title.
+ *
+ * @param user - The window.
+ * @param expirations - Unused.
+ */
+static void ShowFrameRate(void *user, uint64_t expirations)
+{
+    (void)expirations;
+    static uint64_t last_frames;
+
+    char title[64];
+    snprintf(title, sizeof(title), "SimpleWindow (%llu FPS)",
+             (unsigned long long)(frames - last_frames));
+    Ir_WindowSetTitle(user, title);
+    last_frames = frames;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t frame_limit = argc > 1 ? strtoull(argv[1], NULL, 10) : 0;
+
+    ir_event_loop_t loop;
+    if (!Ir_EventLoopCreate(&loop)) return 1;
+
+    const ir_window_config_t config = {
+        .title = "SimpleWindow",
+        .app_id = "iridium.SimpleWindow",
+        .width = 1280,
+        .height = 720,
+    };
+    ir_window_t *window = Ir_WindowCreate(&config, &loop);
+    if (window == NULL)
+    {
+        Ir_EventLoopDestroy(&loop);
+        return 1;
+    }
+    IR_LOG_INFO("Opened a %s window.", Ir_WindowBackendName(window));
+    Ir_EventLoopAddTimer(&loop, 1000000000, 1000000000, ShowFrameRate,
+                         window);
+
+    uint64_t next_frame =
+        Ir_WindowNextFrameStart(window, Ir_ClockMonotonicNanoseconds());
+    while (!Ir_WindowShouldClose(window))
+    {
+        uint64_t now = Ir_ClockMonotonicNanoseconds();
+        if (now < next_frame)
+        {
+            Ir_EventLoopDispatch(&loop, (int64_t)(next_frame - now));
+            continue;
+        }
+        // Poll once more so the frame sees everything that's arrived.
+        Ir_EventLoopDispatch(&loop, 0);
+        Ir_InputDrain(Ir_WindowInput(window), &input, NULL);
+        for (uint32_t i = 0; i < input.count; ++i)
+        {
+            const ir_input_event_t *key = &input.events[i];
+            if (key->type == IR_INPUT_KEY && key->state)
+                IR_LOG_INFO("Key %u pressed after %llu us in the queue.",
+                            key->code,
+                            (unsigned long long)(input.time - key->time) /
+                                1000);
+        }
+
+        ir_window_event_t event;
+        while (Ir_WindowNextEvent(window, &event))
+            if (event.type == IR_WINDOW_EVENT_RESIZE)
+                IR_LOG_INFO("Resized to %ux%u.", event.width,
+                            event.height);
+
+        // A renderer would present here, right after submitting.
+        Ir_WindowSubmitFrame(window, now);
+        IR_PROFILE_FRAME();
+        if (++frames == frame_limit) Ir_WindowClose(window);
+        next_frame = Ir_WindowNextFrameStart(
+            window, Ir_ClockMonotonicNanoseconds());
+    }
+
+    Ir_WindowDestroy(window);
+    Ir_EventLoopDestroy(&loop);
+    return 0;
+}
@@ -2,6 +2,10 @@
 
 find_path(WAYLAND_CLIENT_INCLUDE_DIR NAMES wayland-client.h)
 find_library(WAYLAND_CLIENT_LIBRARY NAMES wayland-client libwayland-client)
+# Protocol extensions are generated from their XML by the scanner.
+find_program(WAYLAND_SCANNER NAMES wayland-scanner)
+find_path(WAYLAND_PROTOCOLS_DIR NAMES stable/xdg-shell/xdg-shell.xml
+    PATHS /usr/share/wayland-protocols /usr/local/share/wayland-protocols)
 
 if(WAYLAND_CLIENT_INCLUDE_DIR AND WAYLAND_CLIENT_LIBRARY)
     add_library(Wayland::Wayland UNKNOWN IMPORTED)
@@ -13,10 +17,35 @@ if(WAYLAND_CLIENT_INCLUDE_DIR AND WAYLAND_CLIENT_LIBRARY)
     )
 endif()
 
+# Generate the client header and glue code of a protocol extension and
+# compile them into a target. The header is included by its file name,
+# e.g. <xdg-shell-client-protocol.h>.
+function(wayland_add_protocol target xml)
+    cmake_path(GET xml STEM protocol)
+    set(directory "${CMAKE_BINARY_DIR}/Protocols")
+    set(header "${directory}/${protocol}-client-protocol.h")
+    set(source "${directory}/${protocol}-protocol.c")
+
+    add_custom_command(
+        OUTPUT "${header}" "${source}"
+        COMMAND ${CMAKE_COMMAND} -E make_directory "${directory}"
+        COMMAND ${WAYLAND_SCANNER} client-header "${xml}" "${header}"
+        COMMAND ${WAYLAND_SCANNER} private-code "${xml}" "${source}"
+        DEPENDS "${xml}"
+        VERBATIM
+    )
+    # Scanner output isn't written against our warning flags.
+    set_source_files_properties("${source}" PROPERTIES COMPILE_OPTIONS "-Wno-pedantic")
+    target_sources(${target} PRIVATE "${header}" "${source}")
+    target_include_directories(${target} PRIVATE "${directory}")
+endfunction()
+
 include(FindPackageHandleStandardArgs)
 find_package_handle_standard_args(
     Wayland
     REQUIRED_VARS WAYLAND_CLIENT_LIBRARY WAYLAND_CLIENT_INCLUDE_DIR
+        WAYLAND_SCANNER WAYLAND_PROTOCOLS_DIR
 )
 
-mark_as_advanced(WAYLAND_CLIENT_INCLUDE_DIR WAYLAND_CLIENT_LIBRARY)
\ No newline at end of file
+mark_as_advanced(WAYLAND_CLIENT_INCLUDE_DIR WAYLAND_CLIENT_LIBRARY
+    WAYLAND_SCANNER WAYLAND_PROTOCOLS_DIR)
@@ -0,0 +1,377 @@
+/**
+ * @file Animation.c
+ * @authors Israfiel
+ * @brief Implements Iridium's animated characters.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Animation.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+#include "Math/SIMD.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name ir_animation_batch_t
+ * @brief The characters an update is working through.
+ */
+typedef struct ir_animation_batch
+{
+    ir_character_t *characters;
+    float delta;
+    const ir_animation_lod_t *lods;
+} ir_animation_batch_t;
+
+/**
+ * @name Accumulate
+ * @authors Israfiel
+ * @brief Add a weighted pose into a blend. A rotation on the far side
+ * of the blend's so far is added negated, since it's the same rotation
+ * and the sum would otherwise cancel it out.
+ *
+ * @param blend - The blend.
+ * @param pose - The pose to add.
+ * @param count - The number of leading joints to add, a multiple of
+ * IR_SIMD_WIDTH.
+ * @param weight - Its weight.
+ * @param first - Whether the blend is empty, and so is overwritten.
+ */
+static void Accumulate(ir_pose_t *blend, const ir_pose_t *pose,
+                       size_t count, float weight, bool first)
+{
+    size_t stride = blend->stride;
+    float *to = blend->channels;
+    const float *from = pose->channels;
+    ir_simd_t weights = Ir_SimdSplat(weight);
+    ir_simd_t zero = Ir_SimdSplat(0.0f);
+    for (size_t i = 0; i < count; i += IR_SIMD_WIDTH)
+    {
+        ir_simd_t turn = weights;
+        if (!first)
+        {
+            ir_simd_t dot = zero;
+            for (size_t j = IR_POSE_ROTATION_X; j <= IR_POSE_ROTATION_W;
+                 ++j)
+                dot = Ir_SimdMulAdd(Ir_SimdLoad(to + j * stride + i),
+                                    Ir_SimdLoad(from + j * stride + i),
+                                    dot);
+            turn = Ir_SimdSelect(Ir_SimdLess(dot, zero),
+                                 Ir_SimdSub(zero, weights), weights);
+        }
+
+        for (size_t j = 0; j < IR_POSE_CHANNELS; ++j)
+        {
+            bool rotation =
+                j >= IR_POSE_ROTATION_X && j <= IR_POSE_ROTATION_W;
+            ir_simd_t value = Ir_SimdMul(
+                Ir_SimdLoad(from + j * stride + i),
+                rotation ? turn : weights);
+            float *channel = to + j * stride + i;
+            if (!first) value = Ir_SimdAdd(Ir_SimdLoad(channel), value);
+            Ir_SimdStore(channel, value);
+        }
+    }
+}
+
+/**
+ * @name Normalise
+ * @authors Israfiel
+ * @brief Finish a blend: divide its translations and scales by the
+ * total weight and bring its rotations back to unit length.
+ *
+ * @param blend - The blend.
+ * @param count - The number of leading joints blended, a multiple of
+ * IR_SIMD_WIDTH.
+ * @param total - The total weight.
+ */
+static void Normalise(ir_pose_t *blend, size_t count, float total)
+{
+    size_t stride = blend->stride;
+    float *channels = blend->channels;
+    ir_simd_t inverse = Ir_SimdSplat(1.0f / total);
+    ir_simd_t one = Ir_SimdSplat(1.0f);
+    for (size_t i = 0; i < count; i += IR_SIMD_WIDTH)
+    {
+        ir_simd_t length = Ir_SimdSplat(0.0f);
+        for (size_t j = IR_POSE_ROTATION_X; j <= IR_POSE_ROTATION_W; ++j)
+        {
+            ir_simd_t value = Ir_SimdLoad(channels + j * stride + i);
+            length = Ir_SimdMulAdd(value, value, length);
+        }
+        ir_simd_t rotation = Ir_SimdDiv(one, Ir_SimdSqrt(length));
+
+        for (size_t j = 0; j < IR_POSE_CHANNELS; ++j)
+        {
+            bool turn = j >= IR_POSE_ROTATION_X && j <= IR_POSE_ROTATION_W;
+            float *value = channels + j * stride + i;
+            Ir_SimdStore(value, Ir_SimdMul(Ir_SimdLoad(value),
+                                           turn ? rotation : inverse));
+        }
+    }
+}
+
+/**
+ * @name Wrap
+ * @authors Israfiel
+ * @brief Bring a time back within a looping clip.
+ *
+ * @param time - The time, in seconds.
+ * @param duration - The clip's duration.
+ * @returns The time within the clip.
+ */
+static float Wrap(float time, float duration)
+{
+    time = duration > 0.0f ? fmodf(time, duration) : 0.0f;
+    return time < 0.0f ? time + duration : time;
+}
+
+/**
+ * @name Duration
+ * @authors Israfiel
+ * @brief Find how long a layer's clip is.
+ *
+ * @param layer - The layer.
+ * @returns The clip's duration, in seconds.
+ */
+static float Duration(const ir_animation_layer_t *layer)
+{
+    return layer->clip != NULL ? layer->clip->duration
+                               : layer->compressed->duration;
+}
+
+/**
+ * @name Interpolate
+ * @authors Israfiel
+ * @brief Blend a character's matrices between its last evaluation's.
+ * Matrices are blended element by element, which shrinks a rotation a
+ * little partway through, but not visibly over the turns a joint makes
+ * in a few frames.
+ *
+ * @param character - The character.
+ * @param alpha - How far between them, from zero to one.
+ */
+static void Interpolate(ir_character_t *character, float alpha)
+{
+    ir_simd_t weight = Ir_SimdSplat(alpha);
+    for (uint32_t i = 0; i < character->skeleton->joint_count; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            ir_simd_t from = Ir_SimdLoad(character->previous[i].rows[j]);
+            ir_simd_t to = Ir_SimdLoad(character->next[i].rows[j]);
+            Ir_SimdStore(
+                character->matrices[i].rows[j],
+                Ir_SimdMulAdd(Ir_SimdSub(to, from), weight, from));
+        }
+    }
+}
+
+/**
+ * @name Evaluate
+ * @authors Israfiel
+ * @brief Blend a character's layers into its pose and turn that into
+ * its matrices, looking ahead to the end of its interval.
+ *
+ * @param character - The character.
+ * @param ahead - How far past the layers' times to look, in seconds.
+ * @param matrices - Filled with the matrices.
+ */
+static void Evaluate(ir_character_t *character, float ahead,
+                     ir_joint_matrix_t *matrices)
+{
+    const ir_skeleton_t *skeleton = character->skeleton;
+    uint32_t joints = skeleton->lods[character->lod];
+    size_t count = Ir_PoseStride(joints);
+    bool first = true;
+    float total = 0.0f;
+    for (uint32_t i = 0; i < character->layer_count; ++i)
+    {
+        const ir_animation_layer_t *layer = &character->layers[i];
+        if (layer->weight <= 0.0f) continue;
+        float time =
+            Wrap(layer->time + ahead * layer->speed, Duration(layer));
+        if (layer->clip != NULL)
+            Ir_ClipSample(layer->clip, time, joints, &character->sample);
+        else
+            Ir_CompressedClipSample(layer->compressed,
+                                    &character->cursors[i], time, joints,
+                                    &character->sample);
+        Accumulate(&character->pose, &character->sample, count,
+                   layer->weight, first);
+        total += layer->weight;
+        first = false;
+    }
+
+    // The bind pose, already laid out as a pose, makes up any shortfall.
+    if (total < 1.0f)
+    {
+        ir_pose_t bind = {skeleton->bind, skeleton->stride};
+        Accumulate(&character->pose, &bind, count, 1.0f - total, first);
+        total = 1.0f;
+    }
+    Normalise(&character->pose, count, total);
+    Ir_PoseMatrices(skeleton, &character->pose, joints, matrices);
+    Ir_PoseFollow(skeleton, joints, matrices);
+    character->evaluated = joints;
+}
+
+/**
+ * @name Level
+ * @authors Israfiel
+ * @brief Pick a character's level of detail.
+ *
+ * @param lods - The levels.
+ * @param screen_size - How much of the screen's height it covers.
+ * @returns The level.
+ */
+static uint32_t Level(const ir_animation_lod_t *lods, float screen_size)
+{
+    uint32_t level = 0;
+    while (level + 1 < IR_SKELETON_LODS &&
+           screen_size < lods[level].screen_size)
+        ++level;
+    return level;
+}
+
+/**
+ * @name UpdateCharacters
+ * @authors Israfiel
+ * @brief Advance and evaluate a range of characters.
+ *
+ * @param user - The batch.
+ * @param begin - The first character.
+ * @param end - One past the last.
+ */
+static void UpdateCharacters(void *user, size_t begin, size_t end)
+{
+    ir_animation_batch_t *batch = user;
+    for (size_t i = begin; i < end; ++i)
+    {
+        ir_character_t *character = &batch->characters[i];
+        for (uint32_t j = 0; j < character->layer_count; ++j)
+        {
+            ir_animation_layer_t *layer = &character->layers[j];
+            layer->time = Wrap(layer->time + batch->delta * layer->speed,
+                               Duration(layer));
+        }
+
+        character->evaluated = 0;
+        if (++character->elapsed < character->interval)
+        {
+            Interpolate(character, (float)(character->elapsed + 1) /
+                                       (float)character->interval);
+            continue;
+        }
+
+        uint32_t interval = 1;
+        character->lod = 0;
+        if (batch->lods != NULL)
+        {
+            character->lod = Level(batch->lods, character->screen_size);
+            interval = batch->lods[character->lod].interval;
+            interval = interval > 1 ? interval : 1;
+        }
+
+        // A character's first interval is cut short by an amount that
+        // varies along the crowd, so throttled characters spread their
+        // evaluations over the frames rather than all landing on one.
+        if (character->interval == 0)
+            interval = 1 + (uint32_t)(i % interval);
+        character->interval = interval;
+        character->elapsed = 0;
+        if (interval == 1)
+        {
+            Evaluate(character, 0.0f, character->matrices);
+            continue;
+        }
+
+        // The evaluation is for the interval's last frame, and this
+        // frame is the first step towards it from where it was.
+        size_t size =
+            character->skeleton->joint_count * sizeof(ir_joint_matrix_t);
+        memcpy(character->previous, character->matrices, size);
+        Evaluate(character, batch->delta * (float)(interval - 1),
+                 character->next);
+        Interpolate(character, 1.0f / (float)interval);
+    }
+}
+
+bool Ir_CharacterCreate(ir_character_t *character,
+                        const ir_skeleton_t *skeleton)
+{
+    // Until it's first measured, a character is taken to be close up.
+    *character = (ir_character_t){.skeleton = skeleton,
+                                  .screen_size = FLT_MAX};
+    size_t size = skeleton->joint_count * sizeof(ir_joint_matrix_t);
+    character->matrices = malloc(size);
+    character->previous = malloc(size);
+    character->next = malloc(size);
+    bool created = character->matrices != NULL &&
+                   character->previous != NULL &&
+                   character->next != NULL &&
+                   Ir_PoseCreate(&character->pose, skeleton) &&
+                   Ir_PoseCreate(&character->sample, skeleton);
+    for (uint32_t i = 0; created && i < IR_ANIMATION_LAYERS; ++i)
+        created = Ir_ClipCursorCreate(&character->cursors[i],
+                                      skeleton->joint_count);
+    if (!created)
+    {
+        Ir_CharacterDestroy(character);
+        IR_LOG_ERROR("Ran out of memory creating a character.");
+        return false;
+    }
+    Ir_PoseMatrices(skeleton, &character->pose, skeleton->joint_count,
+                    character->matrices);
+    return true;
+}
+
+void Ir_CharacterDestroy(ir_character_t *character)
+{
+    Ir_PoseDestroy(&character->pose);
+    Ir_PoseDestroy(&character->sample);
+    for (uint32_t i = 0; i < IR_ANIMATION_LAYERS; ++i)
+        Ir_ClipCursorDestroy(&character->cursors[i]);
+    free(character->matrices);
+    free(character->previous);
+    free(character->next);
+    *character = (ir_character_t){0};
+}
+
+float Ir_CharacterScreenSize(const float view[16], ir_vec3_t centre,
+                             float radius)
+{
+    // The view-projection's second row is the camera's up axis scaled by
+    // the projection, so its length is the scale at unit depth.
+    float depth = view[3] * centre.x + view[7] * centre.y +
+                  view[11] * centre.z + view[15];
+    if (depth <= 0.0f) return 0.0f;
+    float scale = Ir_Vec3Length(Ir_Vec3(view[1], view[5], view[9]));
+    return radius * scale / depth;
+}
+
+uint64_t Ir_AnimationUpdate(ir_character_t *characters, uint32_t count,
+                            float delta, const ir_animation_lod_t *lods,
+                            ir_jobs_t *jobs)
+{
+    IR_PROFILE_BEGIN("Animation");
+    ir_animation_batch_t batch = {characters, delta, lods};
+    if (jobs != NULL)
+        Ir_JobsParallelFor(jobs, count, IR_ANIMATION_GRAIN,
+                           UpdateCharacters, &batch);
+    else UpdateCharacters(&batch, 0, count);
+
+    uint64_t evaluated = 0;
+    for (uint32_t i = 0; i < count; ++i)
+        evaluated += characters[i].evaluated;
+    IR_PROFILE_COUNTER("Evaluated Joints", evaluated);
+    IR_PROFILE_END("Animation");
+    return evaluated;
+}
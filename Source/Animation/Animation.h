@@ -0,0 +1,228 @@
+/**
+ * @file Animation.h
+ * @authors Israfiel
+ * @brief Iridium's animated characters. Each character plays a few
+ * clips at once as weighted layers. An update samples every layer,
+ * blends them joint by joint, four at a time, renormalising rotations
+ * rather than slerping them, then turns the blended pose into the
+ * model-space matrices skinning reads. Characters don't share anything
+ * they write, so a crowd of them is updated in parallel.
+ *
+ * How much of that a character gets depends on how much of the screen
+ * it covers. Smaller characters drop their skeleton's finer joints,
+ * which then hold still relative to their parents, and are evaluated
+ * only every few frames. Each evaluation looks ahead to the end of its
+ * interval, and the frames up to it blend towards it from wherever the
+ * character was, so throttled characters neither lag nor jump.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_ANIMATION_ANIMATION_H
+#define IRIDIUM_ANIMATION_ANIMATION_H
+
+#include "Animation/Clip.h"
+#include "Animation/Compression.h"
+#include "Animation/Skeleton.h"
+#include "Core/Jobs.h"
+#include "Math/Vector.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_ANIMATION_LAYERS
+ * @brief The most clips a character plays at once.
+ */
+#define IR_ANIMATION_LAYERS 4
+
+/**
+ * @name IR_ANIMATION_GRAIN
+ * @brief The number of characters updated per job.
+ */
+#define IR_ANIMATION_GRAIN 4
+
+/**
+ * @name ir_animation_lod_t
+ * @brief How characters at one of their skeletons' levels of detail are
+ * animated.
+ */
+typedef struct ir_animation_lod
+{
+    /**
+     * @name screen_size
+     * @brief The least of the screen's height a character can cover and
+     * still be given the level.
+     */
+    float screen_size;
+    /**
+     * @name interval
+     * @brief How many frames apart the level's evaluations are, where
+     * one evaluates every frame.
+     */
+    uint32_t interval;
+} ir_animation_lod_t;
+
+/**
+ * @name ir_animation_layer_t
+ * @brief A clip a character is playing.
+ */
+typedef struct ir_animation_layer
+{
+    /**
+     * @name clip
+     * @brief The clip, made for the character's skeleton, or NULL to
+     * play a compressed one.
+     */
+    const ir_clip_t *clip;
+    /**
+     * @name time
+     * @brief How far into the clip it is, in seconds. Clips loop.
+     */
+    float time;
+    /**
+     * @name speed
+     * @brief How fast it plays, where one is the clip's own pace.
+     */
+    float speed;
+    /**
+     * @name weight
+     * @brief How much of the pose it makes up. Weights needn't sum to
+     * one: more is scaled down, and less is made up with the bind pose.
+     */
+    float weight;
+    /**
+     * @name compressed
+     * @brief The compressed clip, played when there's no clip.
+     */
+    const ir_compressed_clip_t *compressed;
+} ir_animation_layer_t;
+
+/**
+ * @name ir_character_t
+ * @brief An animated character.
+ */
+typedef struct ir_character
+{
+    const ir_skeleton_t *skeleton;
+    ir_animation_layer_t layers[IR_ANIMATION_LAYERS];
+    uint32_t layer_count;
+    /**
+     * @name screen_size
+     * @brief How much of the screen's height the character covers, as
+     * the culling step last measured it, or zero if it was culled.
+     */
+    float screen_size;
+    /**
+     * @name lod
+     * @brief The level of detail it was last evaluated at. A skin drawn
+     * for it should follow only the joints the level keeps.
+     */
+    uint32_t lod;
+    /**
+     * @name interval
+     * @brief How many frames its last evaluation is spread over.
+     */
+    uint32_t interval;
+    /**
+     * @name elapsed
+     * @brief How many frames of that have passed.
+     */
+    uint32_t elapsed;
+    /**
+     * @name evaluated
+     * @brief How many joints the last update evaluated, or zero if it
+     * only interpolated.
+     */
+    uint32_t evaluated;
+    /**
+     * @name pose
+     * @brief The blended local pose.
+     */
+    ir_pose_t pose;
+    /**
+     * @name sample
+     * @brief Where each layer is sampled before it's blended in.
+     */
+    ir_pose_t sample;
+    /**
+     * @name cursors
+     * @brief Where each layer is in its compressed clip, if it has one.
+     */
+    ir_clip_cursor_t cursors[IR_ANIMATION_LAYERS];
+    /**
+     * @name matrices
+     * @brief Each joint's model-space matrix.
+     */
+    ir_joint_matrix_t *matrices;
+    /**
+     * @name previous
+     * @brief The matrices a throttled evaluation blends from.
+     */
+    ir_joint_matrix_t *previous;
+    /**
+     * @name next
+     * @brief The matrices it blends to.
+     */
+    ir_joint_matrix_t *next;
+} ir_character_t;
+
+/**
+ * @name CharacterCreate
+ * @authors Israfiel
+ * @brief Create a character standing in its bind pose, playing nothing.
+ *
+ * @param character - The character.
+ * @param skeleton - Its skeleton.
+ * @returns Whether there was memory for it.
+ */
+bool Ir_CharacterCreate(ir_character_t *character,
+                        const ir_skeleton_t *skeleton);
+
+/**
+ * @name CharacterDestroy
+ * @authors Israfiel
+ * @brief Free a character.
+ *
+ * @param character - The character.
+ */
+void Ir_CharacterDestroy(ir_character_t *character);
+
+/**
+ * @name CharacterScreenSize
+ * @authors Israfiel
+ * @brief Measure how much of the screen's height a character covers.
+ *
+ * @param view - The camera's column-major view-projection matrix.
+ * @param centre - The centre of the character's bounding sphere.
+ * @param radius - The sphere's radius.
+ * @returns The share of the screen's height, or zero if the character
+ * is behind the camera.
+ */
+float Ir_CharacterScreenSize(const float view[16], ir_vec3_t centre,
+                             float radius);
+
+/**
+ * @name AnimationUpdate
+ * @authors Israfiel
+ * @brief Advance every character's layers, and evaluate or interpolate
+ * its matrices.
+ *
+ * @param characters - The characters.
+ * @param count - The number of characters.
+ * @param delta - The time passed, in seconds.
+ * @param lods - How each of the skeletons' levels of detail animates,
+ * from the largest screen size down. A character is given the first
+ * level it covers enough of the screen for, or the last. NULL evaluates
+ * every character in full every frame.
+ * @param jobs - The pool to update characters with, or NULL to update
+ * them on the calling thread.
+ * @returns The number of joints evaluated.
+ */
+uint64_t Ir_AnimationUpdate(ir_character_t *characters, uint32_t count,
+                            float delta, const ir_animation_lod_t *lods,
+                            ir_jobs_t *jobs);
+
+#endif // IRIDIUM_ANIMATION_ANIMATION_H
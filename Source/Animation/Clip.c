@@ -0,0 +1,116 @@
+/**
+ * @file Clip.c
+ * @authors Israfiel
+ * @brief Implements Iridium's animation clips.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Clip.h"
+
+#include "Math/SIMD.h"
+
+#include <math.h>
+#include <stdalign.h>
+#include <stddef.h>
+
+void Ir_ClipSample(const ir_clip_t *clip, float time, uint32_t joints,
+                   ir_pose_t *pose)
+{
+    float frame = fmaxf(time, 0.0f) * clip->rate;
+    uint32_t last = clip->frame_count - 1;
+    uint32_t index = frame < (float)last ? (uint32_t)frame : last;
+    uint32_t next = index < last ? index + 1 : last;
+    ir_simd_t alpha = Ir_SimdSplat(fminf(frame - (float)index, 1.0f));
+
+    size_t size = (size_t)IR_POSE_CHANNELS * clip->stride;
+    const float *a = clip->frames + index * size;
+    const float *b = clip->frames + next * size;
+    float *out = pose->channels;
+    size_t stride = clip->stride;
+    size_t count = Ir_PoseStride(joints < clip->joint_count
+                                     ? joints
+                                     : clip->joint_count);
+    for (size_t i = 0; i < count; i += IR_SIMD_WIDTH)
+    {
+        ir_simd_t channels[IR_POSE_CHANNELS];
+        for (size_t j = 0; j < IR_POSE_CHANNELS; ++j)
+        {
+            ir_simd_t from = Ir_SimdLoad(a + j * stride + i);
+            ir_simd_t to = Ir_SimdLoad(b + j * stride + i);
+            channels[j] =
+                Ir_SimdMulAdd(Ir_SimdSub(to, from), alpha, from);
+        }
+
+        ir_simd_t length = Ir_SimdMul(channels[IR_POSE_ROTATION_X],
+                                      channels[IR_POSE_ROTATION_X]);
+        for (size_t j = IR_POSE_ROTATION_Y; j <= IR_POSE_ROTATION_W; ++j)
+            length = Ir_SimdMulAdd(channels[j], channels[j], length);
+        ir_simd_t inverse =
+            Ir_SimdDiv(Ir_SimdSplat(1.0f), Ir_SimdSqrt(length));
+        for (size_t j = IR_POSE_ROTATION_X; j <= IR_POSE_ROTATION_W; ++j)
+            channels[j] = Ir_SimdMul(channels[j], inverse);
+
+        for (size_t j = 0; j < IR_POSE_CHANNELS; ++j)
+            Ir_SimdStore(out + j * stride + i, channels[j]);
+    }
+}
+
+uint64_t Ir_ClipBake(ir_scene_writer_t *writer,
+                     const ir_joint_transform_t *keys, uint32_t joints,
+                     uint32_t frames, float rate)
+{
+    uint32_t stride = Ir_PoseStride(joints);
+    size_t size = (size_t)IR_POSE_CHANNELS * stride;
+    uint64_t clip = Ir_SceneWriterAllocate(writer, sizeof(ir_clip_t),
+                                           alignof(ir_clip_t));
+    uint64_t data = Ir_SceneWriterAllocate(
+        writer, frames * size * sizeof(float), IR_SCENE_ALIGNMENT);
+    if (clip == 0 || data == 0) return 0;
+
+    ir_clip_t *header = Ir_SceneWriterGet(writer, clip);
+    header->duration = (float)(frames - 1) / rate;
+    header->rate = rate;
+    header->frame_count = frames;
+    header->joint_count = joints;
+    header->stride = stride;
+
+    float *channels = Ir_SceneWriterGet(writer, data);
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+        float *frame = channels + i * size;
+        for (uint32_t j = 0; j < stride; ++j)
+        {
+            if (j >= joints)
+            {
+                Ir_PoseWrite(frame, stride, j, &IR_JOINT_IDENTITY);
+                continue;
+            }
+
+            ir_joint_transform_t key = keys[(size_t)i * joints + j];
+            if (i > 0)
+            {
+                const float *before = frame - size + j;
+                float dot = before[IR_POSE_ROTATION_X * stride] *
+                                key.rotation.x +
+                            before[IR_POSE_ROTATION_Y * stride] *
+                                key.rotation.y +
+                            before[IR_POSE_ROTATION_Z * stride] *
+                                key.rotation.z +
+                            before[IR_POSE_ROTATION_W * stride] *
+                                key.rotation.w;
+                if (dot < 0.0f)
+                    key.rotation = (ir_quat_t){
+                        -key.rotation.x, -key.rotation.y,
+                        -key.rotation.z, -key.rotation.w};
+            }
+            Ir_PoseWrite(frame, stride, j, &key);
+        }
+    }
+
+    Ir_SceneWriterPointer(writer, clip + offsetof(ir_clip_t, frames),
+                          data);
+    return writer->failed ? 0 : clip;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file Clip.h
+ * @authors Israfiel
+ * @brief Iridium's animation clips. A clip is baked as evenly spaced
+ * frames, each laid out like a pose, so sampling one reads two frames'
+ * channels straight through and interpolates four joints at a time:
+ * translations and scales linearly, rotations by normalised lerp.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_ANIMATION_CLIP_H
+#define IRIDIUM_ANIMATION_CLIP_H
+
+#include "Animation/Skeleton.h"
+#include "Scene/Scene.h"
+
+#include <stdint.h>
+
+/**
+ * @name ir_clip_t
+ * @brief A baked clip.
+ */
+typedef struct ir_clip
+{
+    /**
+     * @name duration
+     * @brief The clip's length in seconds, from its first frame to its
+     * last.
+     */
+    float duration;
+    /**
+     * @name rate
+     * @brief The number of frames per second.
+     */
+    float rate;
+    uint32_t frame_count;
+    uint32_t joint_count;
+    uint32_t stride;
+    /**
+     * @name frames
+     * @brief The frames, one after another, each laid out as a pose's
+     * channels. A rotation is always in the same hemisphere as the one
+     * in the frame before it, so interpolating takes the short way.
+     */
+    float *frames;
+} ir_clip_t;
+
+/**
+ * @name ClipSample
+ * @authors Israfiel
+ * @brief Sample a clip.
+ *
+ * @param clip - The clip.
+ * @param time - The time, in seconds, clamped to the clip.
+ * @param joints - How many leading joints to sample, rounded up to a
+ * whole IR_SIMD_WIDTH; the rest of the pose is left as it was.
+ * @param pose - Filled with the clip's pose at that time.
+ */
+void Ir_ClipSample(const ir_clip_t *clip, float time, uint32_t joints,
+                   ir_pose_t *pose);
+
+/**
+ * @name ClipBake
+ * @authors Israfiel
+ * @brief Bake a clip into a scene.
+ *
+ * @param writer - The scene being baked.
+ * @param keys - Each frame's joint transforms, one frame after another.
+ * @param joints - The number of joints.
+ * @param frames - The number of frames, at least one.
+ * @param rate - The number of frames per second.
+ * @returns The clip's offset within the scene, or zero if it couldn't
+ * be baked.
+ */
+uint64_t Ir_ClipBake(ir_scene_writer_t *writer,
+                     const ir_joint_transform_t *keys, uint32_t joints,
+                     uint32_t frames, float rate);
+
+#endif // IRIDIUM_ANIMATION_CLIP_H
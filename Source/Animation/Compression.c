@@ -0,0 +1,661 @@
+/**
+ * @file Compression.c
+ * @authors Israfiel
+ * @brief Implements Iridium's compressed animation clips.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Compression.h"
+
+#include "Debug/Logger.h"
+#include "Math/SIMD.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name QUANTA
+ * @brief The largest quantised value.
+ */
+#define QUANTA 65535.0f
+
+/**
+ * @name HALF_SQRT2
+ * @brief The largest a quaternion's three smallest components can be.
+ */
+#define HALF_SQRT2 0.70710678f
+
+/**
+ * @name COMPONENTS
+ * @brief The number of values each stream's keys hold.
+ */
+static const uint32_t COMPONENTS[IR_CLIP_STREAMS] = {3, 4, 3};
+
+/**
+ * @name CHANNELS
+ * @brief Each stream's first channel in a pose.
+ */
+static const ir_pose_channel_t CHANNELS[IR_CLIP_STREAMS] = {
+    IR_POSE_TRANSLATION_X, IR_POSE_ROTATION_X, IR_POSE_SCALE_X};
+
+/**
+ * @name IDENTITY
+ * @brief The values each stream's padding tracks hold, which together
+ * are an identity transform.
+ */
+static const float IDENTITY[IR_CLIP_STREAMS][4] = {
+    {0.0f, 0.0f, 0.0f, 0.0f},
+    {0.0f, 0.0f, 0.0f, 1.0f},
+    {1.0f, 1.0f, 1.0f, 0.0f},
+};
+
+/**
+ * @name TRACK_MASK
+ * @brief Picks a key's joint out of its track.
+ */
+#define TRACK_MASK ((1u << IR_CLIP_TRACK_BITS) - 1)
+
+/**
+ * @name ir_clip_entry_t
+ * @brief A key being baked, and when playback first needs it.
+ */
+typedef struct ir_clip_entry
+{
+    uint32_t needed;
+    ir_clip_key_t key;
+} ir_clip_entry_t;
+
+/**
+ * @name OFFSETS
+ * @brief Where each stream's part of a cursor's cache starts, in
+ * strides: its keys' frames, the later's after the earlier's, then the
+ * earlier keys' values and the later's.
+ */
+static const uint32_t OFFSETS[IR_CLIP_STREAMS] = {0, 8, 18};
+
+/**
+ * @name CACHE_SIZE
+ * @brief The strides a cursor's cache takes up.
+ */
+#define CACHE_SIZE 26
+
+/**
+ * @name KEPT
+ * @brief Where a rotation key's three values go, by which component it
+ * dropped.
+ */
+static const uint8_t KEPT[4][3] = {
+    {1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+
+/**
+ * @name Decode
+ * @authors Israfiel
+ * @brief Turn a key back into values.
+ *
+ * @param clip - The clip.
+ * @param stream - The stream the key is from.
+ * @param key - The key.
+ * @param values - Filled with the key's values.
+ * @returns The key's joint.
+ */
+static uint32_t Decode(const ir_compressed_clip_t *clip, uint32_t stream,
+                       const ir_clip_key_t *key, float values[4])
+{
+    uint32_t track = key->track & TRACK_MASK;
+    if (stream != IR_CLIP_ROTATIONS)
+    {
+        const float *range = &clip->streams[stream].ranges[track * 6];
+        for (int i = 0; i < 3; ++i)
+            values[i] = range[i] + (float)key->values[i] * range[i + 3];
+        return track;
+    }
+
+    // The dropped component is the largest, and made positive, so it's
+    // whatever the other three leave of a unit length.
+    uint32_t largest = key->track >> IR_CLIP_TRACK_BITS;
+    float length = 0.0f;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        float value =
+            (float)key->values[i] * (2.0f * HALF_SQRT2 / QUANTA) -
+            HALF_SQRT2;
+        values[KEPT[largest][i]] = value;
+        length += value * value;
+    }
+    values[largest] = sqrtf(fmaxf(1.0f - length, 0.0f));
+    return track;
+}
+
+/**
+ * @name Push
+ * @authors Israfiel
+ * @brief Read a stream's next key into its track's pair, where it
+ * becomes the later key and the later becomes the earlier.
+ *
+ * @param cursor - The cursor.
+ * @param stream - The stream.
+ */
+static void Push(ir_clip_cursor_t *cursor, uint32_t stream)
+{
+    const ir_clip_stream_t *keys = &cursor->clip->streams[stream];
+    const ir_clip_key_t *key = &keys->keys[cursor->next[stream]++];
+    float values[4];
+    uint32_t track = Decode(cursor->clip, stream, key, values);
+
+    size_t stride = cursor->stride;
+    float *cache = cursor->cache + OFFSETS[stream] * stride;
+    cache[track] = cache[stride + track];
+    cache[stride + track] = (float)key->frame;
+    float *earlier = cache + 2 * stride;
+    float *later = earlier + COMPONENTS[stream] * stride;
+    for (uint32_t i = 0; i < COMPONENTS[stream]; ++i)
+    {
+        earlier[i * stride + track] = later[i * stride + track];
+        later[i * stride + track] = values[i];
+    }
+}
+
+/**
+ * @name Reset
+ * @authors Israfiel
+ * @brief Start a cursor over on a clip, reading every track's first two
+ * keys.
+ *
+ * @param cursor - The cursor.
+ * @param clip - The clip.
+ */
+static void Reset(ir_clip_cursor_t *cursor,
+                  const ir_compressed_clip_t *clip)
+{
+    cursor->clip = clip;
+    cursor->frame = 0.0f;
+    size_t stride = cursor->stride;
+    for (uint32_t i = 0; i < IR_CLIP_STREAMS; ++i)
+    {
+        // The padding holds an identity transform, as in a pose.
+        float *cache = cursor->cache + OFFSETS[i] * stride;
+        for (uint32_t j = clip->joint_count; j < stride; ++j)
+        {
+            cache[j] = cache[stride + j] = 0.0f;
+            for (uint32_t k = 0; k < 2 * COMPONENTS[i]; ++k)
+                cache[(2 + k) * stride + j] =
+                    IDENTITY[i][k % COMPONENTS[i]];
+        }
+
+        cursor->next[i] = 0;
+        for (uint32_t j = 0; j < 2 * clip->joint_count; ++j)
+            Push(cursor, i);
+    }
+}
+
+/**
+ * @name Interpolate
+ * @authors Israfiel
+ * @brief Interpolate every track of a stream between its cached keys.
+ *
+ * @param cache - The stream's part of the cache.
+ * @param stride - The cache's stride.
+ * @param count - The number of tracks to interpolate, a multiple of
+ * IR_SIMD_WIDTH.
+ * @param components - The number of values the stream's keys hold.
+ * @param rotation - Whether they're rotations, and so renormalised.
+ * @param frame - The time, in frames.
+ * @param pose - Filled with the tracks' values.
+ * @param channel - The stream's first channel in the pose.
+ */
+static void Interpolate(const float *cache, size_t stride, size_t count,
+                        uint32_t components, bool rotation, float frame,
+                        ir_pose_t *pose, ir_pose_channel_t channel)
+{
+    float *out = Ir_PoseChannel(pose, channel);
+    size_t pose_stride = pose->stride;
+    const float *earlier = cache + 2 * stride;
+    const float *later = earlier + components * stride;
+    ir_simd_t now = Ir_SimdSplat(frame);
+    ir_simd_t zero = Ir_SimdSplat(0.0f), one = Ir_SimdSplat(1.0f);
+    for (size_t i = 0; i < count; i += IR_SIMD_WIDTH)
+    {
+        ir_simd_t from = Ir_SimdLoad(cache + i);
+        ir_simd_t span = Ir_SimdMax(
+            Ir_SimdSub(Ir_SimdLoad(cache + stride + i), from), one);
+        ir_simd_t alpha = Ir_SimdDiv(Ir_SimdSub(now, from), span);
+        alpha = Ir_SimdMin(Ir_SimdMax(alpha, zero), one);
+
+        ir_simd_t a[4], b[4];
+        for (uint32_t j = 0; j < components; ++j)
+        {
+            a[j] = Ir_SimdLoad(earlier + j * stride + i);
+            b[j] = Ir_SimdLoad(later + j * stride + i);
+        }
+
+        // Rotations are rebuilt with their largest component positive,
+        // so neighbouring keys may be on opposite sides.
+        if (rotation)
+        {
+            ir_simd_t dot = zero;
+            for (uint32_t j = 0; j < 4; ++j)
+                dot = Ir_SimdMulAdd(a[j], b[j], dot);
+            ir_simd_mask_t flip = Ir_SimdLess(dot, zero);
+            for (uint32_t j = 0; j < 4; ++j)
+                b[j] = Ir_SimdSelect(flip, Ir_SimdSub(zero, b[j]), b[j]);
+        }
+
+        ir_simd_t values[4], length = zero;
+        for (uint32_t j = 0; j < components; ++j)
+        {
+            values[j] = Ir_SimdMulAdd(Ir_SimdSub(b[j], a[j]), alpha, a[j]);
+            length = Ir_SimdMulAdd(values[j], values[j], length);
+        }
+        ir_simd_t scale =
+            rotation ? Ir_SimdDiv(one, Ir_SimdSqrt(length)) : one;
+        for (uint32_t j = 0; j < components; ++j)
+            Ir_SimdStore(out + j * pose_stride + i,
+                         Ir_SimdMul(values[j], scale));
+    }
+}
+
+void Ir_CompressedClipSample(const ir_compressed_clip_t *clip,
+                             ir_clip_cursor_t *cursor, float time,
+                             uint32_t joints, ir_pose_t *pose)
+{
+    float last = (float)(clip->frame_count - 1);
+    float frame = fminf(fmaxf(time * clip->rate, 0.0f), last);
+    if (cursor->clip != clip || frame < cursor->frame)
+        Reset(cursor, clip);
+    cursor->frame = frame;
+
+    size_t stride = cursor->stride;
+    size_t count = Ir_PoseStride(joints < clip->joint_count
+                                     ? joints
+                                     : clip->joint_count);
+    for (uint32_t i = 0; i < IR_CLIP_STREAMS; ++i)
+    {
+        // A key is needed once its track's later key has been reached,
+        // and keys are stored in that order, so the first one not yet
+        // needed ends the reading.
+        const ir_clip_stream_t *keys = &clip->streams[i];
+        float *cache = cursor->cache + OFFSETS[i] * stride;
+        while (cursor->next[i] < keys->key_count)
+        {
+            const ir_clip_key_t *key = &keys->keys[cursor->next[i]];
+            if (cache[stride + (key->track & TRACK_MASK)] > frame) break;
+            Push(cursor, i);
+        }
+
+        // Passing each stream's shape as a constant lets the compiler
+        // build a version of the loop for each.
+        if (i == IR_CLIP_ROTATIONS)
+            Interpolate(cache, stride, count, 4, true, frame, pose,
+                        CHANNELS[i]);
+        else
+            Interpolate(cache, stride, count, 3, false, frame, pose,
+                        CHANNELS[i]);
+    }
+}
+
+bool Ir_ClipCursorCreate(ir_clip_cursor_t *cursor, uint32_t joints)
+{
+    *cursor = (ir_clip_cursor_t){.stride = Ir_PoseStride(joints)};
+    cursor->cache = malloc(CACHE_SIZE * cursor->stride * sizeof(float));
+    if (cursor->cache == NULL)
+    {
+        IR_LOG_ERROR("Ran out of memory creating a clip cursor.");
+        return false;
+    }
+    return true;
+}
+
+void Ir_ClipCursorDestroy(ir_clip_cursor_t *cursor)
+{
+    free(cursor->cache);
+    *cursor = (ir_clip_cursor_t){0};
+}
+
+/**
+ * @name Quantise
+ * @authors Israfiel
+ * @brief Quantise a value within a range.
+ *
+ * @param value - The value.
+ * @param min - The range's lowest value.
+ * @param step - The step between quantised values, or zero if the range
+ * is a single value.
+ * @returns The quantised value.
+ */
+static uint16_t Quantise(float value, float min, float step)
+{
+    if (step <= 0.0f) return 0;
+    return (uint16_t)lrintf(fminf(fmaxf((value - min) / step, 0.0f),
+                                  QUANTA));
+}
+
+/**
+ * @name Encode
+ * @authors Israfiel
+ * @brief Quantise a track's value at one frame into a key.
+ *
+ * @param stream - The track's stream.
+ * @param track - The track.
+ * @param value - The value.
+ * @param range - For translations and scales, the track's range.
+ * @param key - Filled with the key, apart from its frame.
+ */
+static void Encode(uint32_t stream, uint32_t track, const float value[4],
+                   const float *range, ir_clip_key_t *key)
+{
+    key->track = (uint16_t)track;
+    if (stream != IR_CLIP_ROTATIONS)
+    {
+        for (int i = 0; i < 3; ++i)
+            key->values[i] = Quantise(value[i], range[i], range[i + 3]);
+        return;
+    }
+
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i)
+        if (fabsf(value[i]) > fabsf(value[largest])) largest = i;
+    float sign = value[largest] < 0.0f ? -1.0f : 1.0f;
+    for (uint32_t i = 0, j = 0; i < 4; ++i)
+        if (i != largest)
+            key->values[j++] =
+                Quantise(sign * value[i], -HALF_SQRT2,
+                         2.0f * HALF_SQRT2 / QUANTA);
+    key->track |= (uint16_t)(largest << IR_CLIP_TRACK_BITS);
+}
+
+/**
+ * @name Error
+ * @authors Israfiel
+ * @brief Measure how far an interpolated value is from the source.
+ *
+ * @param stream - The value's stream.
+ * @param a - The value, interpolated.
+ * @param b - The source value.
+ * @returns The distance in metres for translations, the angle in
+ * radians for rotations, or the largest difference for scales.
+ */
+static float Error(uint32_t stream, const float a[4], const float b[4])
+{
+    switch (stream)
+    {
+        case IR_CLIP_TRANSLATIONS:
+            return sqrtf((a[0] - b[0]) * (a[0] - b[0]) +
+                         (a[1] - b[1]) * (a[1] - b[1]) +
+                         (a[2] - b[2]) * (a[2] - b[2]));
+        case IR_CLIP_ROTATIONS:
+        {
+            // Two unit quaternions a turn of t apart are 2 sin(t / 4)
+            // apart, which unlike acos of their dot product holds its
+            // precision for the small angles tolerances are made of.
+            float dot =
+                a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+            float sign = dot < 0.0f ? -1.0f : 1.0f, distance = 0.0f;
+            for (int i = 0; i < 4; ++i)
+                distance += (a[i] - sign * b[i]) * (a[i] - sign * b[i]);
+            return 4.0f * asinf(fminf(0.5f * sqrtf(distance), 1.0f));
+        }
+        default:
+            return fmaxf(fmaxf(fabsf(a[0] - b[0]), fabsf(a[1] - b[1])),
+                         fabsf(a[2] - b[2]));
+    }
+}
+
+/**
+ * @name Fits
+ * @authors Israfiel
+ * @brief Check whether interpolating between two decoded keys keeps
+ * every frame between them within tolerance.
+ *
+ * @param stream - The track's stream.
+ * @param source - The track's source value at each frame.
+ * @param decoded - Its quantised value at each frame, as played back.
+ * @param a - The earlier key's frame.
+ * @param b - The later key's frame.
+ * @param tolerance - The furthest a frame may stray.
+ * @returns Whether every frame is within tolerance.
+ */
+static bool Fits(uint32_t stream, const float (*source)[4],
+                 const float (*decoded)[4], uint32_t a, uint32_t b,
+                 float tolerance)
+{
+    float from[4], to[4];
+    memcpy(from, decoded[a], sizeof(from));
+    memcpy(to, decoded[b], sizeof(to));
+    if (stream == IR_CLIP_ROTATIONS &&
+        from[0] * to[0] + from[1] * to[1] + from[2] * to[2] +
+                from[3] * to[3] <
+            0.0f)
+        for (int i = 0; i < 4; ++i) to[i] = -to[i];
+
+    for (uint32_t i = a + 1; i < b; ++i)
+    {
+        float alpha = (float)(i - a) / (float)(b - a), value[4];
+        float length = 0.0f;
+        for (int j = 0; j < 4; ++j)
+        {
+            value[j] = from[j] + (to[j] - from[j]) * alpha;
+            length += value[j] * value[j];
+        }
+        if (stream == IR_CLIP_ROTATIONS)
+            for (int j = 0; j < 4; ++j) value[j] /= sqrtf(length);
+        if (Error(stream, value, source[i]) > tolerance) return false;
+    }
+    return true;
+}
+
+/**
+ * @name Compare
+ * @authors Israfiel
+ * @brief Order keys by when playback first needs them, then by frame,
+ * so each track's first key comes before its second.
+ *
+ * @param a - The first entry.
+ * @param b - The second entry.
+ * @returns Less than, equal to, or greater than zero as a comes before,
+ * with, or after b.
+ */
+static int Compare(const void *a, const void *b)
+{
+    const ir_clip_entry_t *x = a, *y = b;
+    if (x->needed != y->needed) return x->needed < y->needed ? -1 : 1;
+    if (x->key.frame != y->key.frame)
+        return x->key.frame < y->key.frame ? -1 : 1;
+    uint32_t u = x->key.track & TRACK_MASK, v = y->key.track & TRACK_MASK;
+    return u < v ? -1 : u > v;
+}
+
+/**
+ * @name Reduce
+ * @authors Israfiel
+ * @brief Quantise and reduce one stream's tracks.
+ *
+ * @param stream - The stream.
+ * @param keys - The source keys.
+ * @param joints - The number of joints.
+ * @param frames - The number of frames.
+ * @param tolerance - The furthest a frame may stray.
+ * @param ranges - For translations and scales, filled with each track's
+ * range.
+ * @param entries - Filled with the kept keys, in the order they're
+ * stored.
+ * @returns The number of keys kept, or zero if there wasn't memory.
+ */
+static uint32_t Reduce(uint32_t stream, const ir_joint_transform_t *keys,
+                       uint32_t joints, uint32_t frames, float tolerance,
+                       float *ranges, ir_clip_entry_t *entries)
+{
+    float (*source)[4] = malloc(frames * sizeof(*source));
+    float (*decoded)[4] = malloc(frames * sizeof(*decoded));
+    ir_clip_key_t *codes = malloc(frames * sizeof(ir_clip_key_t));
+    uint32_t *kept = malloc((frames + 1) * sizeof(uint32_t));
+    if (source == NULL || decoded == NULL || codes == NULL || kept == NULL)
+    {
+        free(source);
+        free(decoded);
+        free(codes);
+        free(kept);
+        return 0;
+    }
+
+    uint32_t count = 0;
+    ir_compressed_clip_t clip = {0};
+    clip.streams[stream].ranges = ranges;
+    for (uint32_t i = 0; i < joints; ++i)
+    {
+        float low[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+        float high[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+        for (uint32_t j = 0; j < frames; ++j)
+        {
+            const ir_joint_transform_t *key =
+                &keys[(size_t)j * joints + i];
+            const ir_vec3_t *vector = stream == IR_CLIP_SCALES
+                                          ? &key->scale
+                                          : &key->translation;
+            if (stream == IR_CLIP_ROTATIONS)
+                memcpy(source[j], &key->rotation, sizeof(source[j]));
+            else
+            {
+                source[j][0] = vector->x;
+                source[j][1] = vector->y;
+                source[j][2] = vector->z;
+                source[j][3] = 0.0f;
+            }
+            for (int k = 0; k < 3; ++k)
+            {
+                low[k] = fminf(low[k], source[j][k]);
+                high[k] = fmaxf(high[k], source[j][k]);
+            }
+        }
+        if (stream != IR_CLIP_ROTATIONS)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                ranges[i * 6 + k] = low[k];
+                ranges[i * 6 + 3 + k] = (high[k] - low[k]) / QUANTA;
+            }
+        }
+
+        // Keys are judged as they'll be played back, quantised, so the
+        // tolerance covers the quantisation too.
+        for (uint32_t j = 0; j < frames; ++j)
+        {
+            Encode(stream, i, source[j], &ranges[i * 6], &codes[j]);
+            Decode(&clip, stream, &codes[j], decoded[j]);
+        }
+
+        uint32_t kept_count = 0;
+        kept[kept_count++] = 0;
+        for (uint32_t j = 2, a = 0; j < frames; ++j)
+        {
+            if (Fits(stream, source, decoded, a, j, tolerance)) continue;
+            a = j - 1;
+            kept[kept_count++] = a;
+        }
+        kept[kept_count++] = frames - 1;
+
+        for (uint32_t j = 0; j < kept_count; ++j)
+        {
+            ir_clip_entry_t *entry = &entries[count++];
+            entry->needed = j < 2 ? 0 : kept[j - 1];
+            entry->key = codes[kept[j]];
+            entry->key.frame = (uint16_t)kept[j];
+        }
+    }
+    qsort(entries, count, sizeof(ir_clip_entry_t), Compare);
+
+    free(source);
+    free(decoded);
+    free(codes);
+    free(kept);
+    return count;
+}
+
+uint64_t Ir_CompressedClipBake(ir_scene_writer_t *writer,
+                               const ir_joint_transform_t *keys,
+                               uint32_t joints, uint32_t frames,
+                               float rate,
+                               const ir_clip_tolerance_t *tolerance)
+{
+    if (joints == 0 || joints > TRACK_MASK || frames == 0 ||
+        frames > UINT16_MAX + 1)
+    {
+        IR_LOG_ERROR("A clip of %u joints and %u frames can't be "
+                     "compressed.",
+                     joints, frames);
+        return 0;
+    }
+
+    uint64_t clip = Ir_SceneWriterAllocate(
+        writer, sizeof(ir_compressed_clip_t),
+        alignof(ir_compressed_clip_t));
+    float *ranges = malloc((size_t)joints * 6 * sizeof(float));
+    ir_clip_entry_t *entries =
+        malloc((size_t)(frames + 1) * joints * sizeof(ir_clip_entry_t));
+    if (clip == 0 || ranges == NULL || entries == NULL)
+    {
+        free(ranges);
+        free(entries);
+        IR_LOG_ERROR("Ran out of memory compressing a clip.");
+        return 0;
+    }
+
+    const float limits[IR_CLIP_STREAMS] = {
+        tolerance->translation, tolerance->rotation, tolerance->scale};
+    uint32_t counts[IR_CLIP_STREAMS];
+    bool baked = true;
+    for (uint32_t i = 0; i < IR_CLIP_STREAMS && baked; ++i)
+    {
+        counts[i] = Reduce(i, keys, joints, frames, limits[i], ranges,
+                           entries);
+        size_t range_size = (size_t)joints * 6 * sizeof(float);
+        uint64_t data = Ir_SceneWriterAllocate(
+            writer, counts[i] * sizeof(ir_clip_key_t),
+            alignof(ir_clip_key_t));
+        uint64_t bounds =
+            i == IR_CLIP_ROTATIONS
+                ? 0
+                : Ir_SceneWriterAllocate(writer, range_size,
+                                         alignof(float));
+        baked = counts[i] != 0 && data != 0 &&
+                (bounds != 0 || i == IR_CLIP_ROTATIONS);
+        if (!baked) break;
+
+        ir_clip_key_t *packed = Ir_SceneWriterGet(writer, data);
+        for (uint32_t j = 0; j < counts[i]; ++j)
+            packed[j] = entries[j].key;
+        uint64_t stream = clip + offsetof(ir_compressed_clip_t, streams) +
+                          i * sizeof(ir_clip_stream_t);
+        Ir_SceneWriterPointer(
+            writer, stream + offsetof(ir_clip_stream_t, keys), data);
+        if (bounds != 0)
+        {
+            memcpy(Ir_SceneWriterGet(writer, bounds), ranges, range_size);
+            Ir_SceneWriterPointer(
+                writer, stream + offsetof(ir_clip_stream_t, ranges),
+                bounds);
+        }
+    }
+    free(ranges);
+    free(entries);
+    if (!baked)
+    {
+        IR_LOG_ERROR("Ran out of memory compressing a clip.");
+        return 0;
+    }
+
+    ir_compressed_clip_t *header = Ir_SceneWriterGet(writer, clip);
+    header->duration = (float)(frames - 1) / rate;
+    header->rate = rate;
+    header->frame_count = frames;
+    header->joint_count = joints;
+    for (uint32_t i = 0; i < IR_CLIP_STREAMS; ++i)
+        header->streams[i].key_count = counts[i];
+    return writer->failed ? 0 : clip;
+}
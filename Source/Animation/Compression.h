@@ -0,0 +1,212 @@
+/**
+ * @file Compression.h
+ * @authors Israfiel
+ * @brief Iridium's compressed animation clips. Baking drops every key a
+ * track can do without, keeping a key only where interpolating past it
+ * would stray further from the source than a tolerance allows, and
+ * quantises what's left to 16 bits a component: translations and scales
+ * over each track's own range, rotations as the three smallest
+ * components of the quaternion, the fourth rebuilt from their length.
+ *
+ * A track's keys no longer line up with anyone else's, so they're
+ * stored in the order playback needs them rather than by track. A
+ * cursor holds each track's pair of keys around the current time and,
+ * as time moves forward, reads on through the keys strictly in order,
+ * so sampling a clip from start to finish touches its keys exactly once
+ * and never seeks.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_ANIMATION_COMPRESSION_H
+#define IRIDIUM_ANIMATION_COMPRESSION_H
+
+#include "Animation/Skeleton.h"
+#include "Scene/Scene.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_CLIP_TRACK_BITS
+ * @brief The bits of a key's track holding its joint. A rotation key's
+ * remaining two hold which component was dropped.
+ */
+#define IR_CLIP_TRACK_BITS 14
+
+/**
+ * @name ir_clip_stream_kind_t
+ * @brief The kinds of track a compressed clip has, one per joint each.
+ */
+typedef enum ir_clip_stream_kind
+{
+    IR_CLIP_TRANSLATIONS,
+    IR_CLIP_ROTATIONS,
+    IR_CLIP_SCALES,
+    IR_CLIP_STREAMS
+} ir_clip_stream_kind_t;
+
+/**
+ * @name ir_clip_tolerance_t
+ * @brief How far a compressed clip may stray from its source.
+ */
+typedef struct ir_clip_tolerance
+{
+    /**
+     * @name translation
+     * @brief The furthest a joint may move, in metres.
+     */
+    float translation;
+    /**
+     * @name rotation
+     * @brief The furthest a joint may turn, in radians.
+     */
+    float rotation;
+    /**
+     * @name scale
+     * @brief The most any axis's scale may change by.
+     */
+    float scale;
+} ir_clip_tolerance_t;
+
+/**
+ * @name ir_clip_key_t
+ * @brief A compressed key.
+ */
+typedef struct ir_clip_key
+{
+    uint16_t frame;
+    uint16_t track;
+    uint16_t values[3];
+} ir_clip_key_t;
+
+/**
+ * @name ir_clip_stream_t
+ * @brief One kind of a compressed clip's tracks.
+ */
+typedef struct ir_clip_stream
+{
+    uint32_t key_count;
+    /**
+     * @name ranges
+     * @brief For translations and scales, each track's lowest value
+     * along each axis, then the step between quantised values along
+     * each, six floats a track. Rotations have none.
+     */
+    float *ranges;
+    /**
+     * @name keys
+     * @brief The keys, each track's first two before any others, then
+     * every later key ordered by the frame of the key before it, which
+     * is when playing forward first needs it.
+     */
+    ir_clip_key_t *keys;
+} ir_clip_stream_t;
+
+/**
+ * @name ir_compressed_clip_t
+ * @brief A baked, compressed clip.
+ */
+typedef struct ir_compressed_clip
+{
+    float duration;
+    float rate;
+    uint32_t frame_count;
+    uint32_t joint_count;
+    ir_clip_stream_t streams[IR_CLIP_STREAMS];
+} ir_compressed_clip_t;
+
+/**
+ * @name ir_clip_cursor_t
+ * @brief Where a compressed clip is being played, and the keys either
+ * side of that for every track.
+ */
+typedef struct ir_clip_cursor
+{
+    /**
+     * @name clip
+     * @brief The clip the keys are from, if any.
+     */
+    const ir_compressed_clip_t *clip;
+    /**
+     * @name frame
+     * @brief The last time sampled, in frames.
+     */
+    float frame;
+    /**
+     * @name next
+     * @brief Each stream's next key to read.
+     */
+    uint32_t next[IR_CLIP_STREAMS];
+    uint32_t stride;
+    /**
+     * @name cache
+     * @brief For each stream, each track's two keys' frames, then their
+     * values, a channel at a time as in a pose.
+     */
+    float *cache;
+} ir_clip_cursor_t;
+
+/**
+ * @name ClipCursorCreate
+ * @authors Israfiel
+ * @brief Create a cursor, not yet on any clip.
+ *
+ * @param cursor - The cursor.
+ * @param joints - The most joints a clip it plays may have.
+ * @returns Whether there was memory for it.
+ */
+bool Ir_ClipCursorCreate(ir_clip_cursor_t *cursor, uint32_t joints);
+
+/**
+ * @name ClipCursorDestroy
+ * @authors Israfiel
+ * @brief Free a cursor.
+ *
+ * @param cursor - The cursor.
+ */
+void Ir_ClipCursorDestroy(ir_clip_cursor_t *cursor);
+
+/**
+ * @name CompressedClipSample
+ * @authors Israfiel
+ * @brief Sample a compressed clip. Moving forward from the cursor's last
+ * sample only reads the keys passed since; moving back, or onto another
+ * clip, starts the cursor over from the clip's first keys.
+ *
+ * @param clip - The clip.
+ * @param cursor - The cursor playing it.
+ * @param time - The time, in seconds, clamped to the clip.
+ * @param joints - How many leading joints to sample, rounded up to a
+ * whole IR_SIMD_WIDTH; the rest of the pose is left as it was. Every
+ * track's keys are still read, to keep the cursor in step.
+ * @param pose - Filled with the clip's pose at that time.
+ */
+void Ir_CompressedClipSample(const ir_compressed_clip_t *clip,
+                             ir_clip_cursor_t *cursor, float time,
+                             uint32_t joints, ir_pose_t *pose);
+
+/**
+ * @name CompressedClipBake
+ * @authors Israfiel
+ * @brief Compress a clip and bake it into a scene.
+ *
+ * @param writer - The scene being baked.
+ * @param keys - Each frame's joint transforms, one frame after another.
+ * @param joints - The number of joints, from one to
+ * 2^IR_CLIP_TRACK_BITS - 1.
+ * @param frames - The number of frames, from one to 65536.
+ * @param rate - The number of frames per second.
+ * @param tolerance - How far the clip may stray from the keys.
+ * @returns The clip's offset within the scene, or zero if it couldn't
+ * be baked.
+ */
+uint64_t Ir_CompressedClipBake(ir_scene_writer_t *writer,
+                               const ir_joint_transform_t *keys,
+                               uint32_t joints, uint32_t frames,
+                               float rate,
+                               const ir_clip_tolerance_t *tolerance);
+
+#endif // IRIDIUM_ANIMATION_COMPRESSION_H
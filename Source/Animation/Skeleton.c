@@ -0,0 +1,252 @@
+/**
+ * @file Skeleton.c
+ * @authors Israfiel
+ * @brief Implements Iridium's skeletons and poses.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Skeleton.h"
+
+#include "Debug/Logger.h"
+
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name Locals
+ * @authors Israfiel
+ * @brief Turn four joints' local transforms into matrices at once.
+ *
+ * @param pose - The pose.
+ * @param first - The first of the joints.
+ * @param rows - Filled with each joint's three matrix rows.
+ */
+static void Locals(const ir_pose_t *pose, uint32_t first,
+                   ir_simd_t rows[IR_SIMD_WIDTH][3])
+{
+    ir_simd_t channels[IR_POSE_CHANNELS];
+    for (int i = 0; i < IR_POSE_CHANNELS; ++i)
+        channels[i] = Ir_SimdLoad(Ir_PoseChannel(pose, i) + first);
+
+    ir_simd_t x = channels[IR_POSE_ROTATION_X];
+    ir_simd_t y = channels[IR_POSE_ROTATION_Y];
+    ir_simd_t z = channels[IR_POSE_ROTATION_Z];
+    ir_simd_t w = channels[IR_POSE_ROTATION_W];
+    ir_simd_t two = Ir_SimdSplat(2.0f), one = Ir_SimdSplat(1.0f);
+    ir_simd_t x2 = Ir_SimdMul(x, two), y2 = Ir_SimdMul(y, two);
+    ir_simd_t z2 = Ir_SimdMul(z, two);
+    ir_simd_t xx = Ir_SimdMul(x, x2), yy = Ir_SimdMul(y, y2);
+    ir_simd_t zz = Ir_SimdMul(z, z2), xy = Ir_SimdMul(x, y2);
+    ir_simd_t xz = Ir_SimdMul(x, z2), yz = Ir_SimdMul(y, z2);
+    ir_simd_t wx = Ir_SimdMul(w, x2), wy = Ir_SimdMul(w, y2);
+    ir_simd_t wz = Ir_SimdMul(w, z2);
+
+    // Each column is a rotated axis, scaled along that axis.
+    ir_simd_t sx = channels[IR_POSE_SCALE_X];
+    ir_simd_t sy = channels[IR_POSE_SCALE_Y];
+    ir_simd_t sz = channels[IR_POSE_SCALE_Z];
+    ir_simd_t matrix[3][4] = {
+        {Ir_SimdMul(Ir_SimdSub(one, Ir_SimdAdd(yy, zz)), sx),
+         Ir_SimdMul(Ir_SimdSub(xy, wz), sy),
+         Ir_SimdMul(Ir_SimdAdd(xz, wy), sz),
+         channels[IR_POSE_TRANSLATION_X]},
+        {Ir_SimdMul(Ir_SimdAdd(xy, wz), sx),
+         Ir_SimdMul(Ir_SimdSub(one, Ir_SimdAdd(xx, zz)), sy),
+         Ir_SimdMul(Ir_SimdSub(yz, wx), sz),
+         channels[IR_POSE_TRANSLATION_Y]},
+        {Ir_SimdMul(Ir_SimdSub(xz, wy), sx),
+         Ir_SimdMul(Ir_SimdAdd(yz, wx), sy),
+         Ir_SimdMul(Ir_SimdSub(one, Ir_SimdAdd(xx, yy)), sz),
+         channels[IR_POSE_TRANSLATION_Z]},
+    };
+
+    // Each row holds an element of four joints; transposed, it holds
+    // four elements of one joint.
+    for (int i = 0; i < 3; ++i)
+    {
+        Ir_SimdTranspose(matrix[i]);
+        for (int j = 0; j < IR_SIMD_WIDTH; ++j) rows[j][i] = matrix[i][j];
+    }
+}
+
+/**
+ * @name Attach
+ * @authors Israfiel
+ * @brief Find a joint's model-space matrix from its parent's and its
+ * own local one.
+ *
+ * @param above - The parent's matrix, or NULL for a root.
+ * @param local - The joint's local matrix's rows.
+ * @param matrix - Filled with the joint's matrix.
+ */
+static void Attach(const ir_joint_matrix_t *above,
+                   const ir_simd_t local[3], ir_joint_matrix_t *matrix)
+{
+    if (above == NULL)
+    {
+        for (int i = 0; i < 3; ++i)
+            Ir_SimdStore(matrix->rows[i], local[i]);
+        return;
+    }
+
+    // Each row of the product is the parent's row weighing the local
+    // matrix's rows, whose implied fourth is (0, 0, 0, 1).
+    ir_simd_t last = Ir_SimdLoad((float[4]){0.0f, 0.0f, 0.0f, 1.0f});
+    for (int i = 0; i < 3; ++i)
+    {
+        const float *row = above->rows[i];
+        ir_simd_t result = Ir_SimdMul(Ir_SimdSplat(row[3]), last);
+        for (int j = 0; j < 3; ++j)
+            result =
+                Ir_SimdMulAdd(Ir_SimdSplat(row[j]), local[j], result);
+        Ir_SimdStore(matrix->rows[i], result);
+    }
+}
+
+void Ir_PoseWrite(float *channels, uint32_t stride, uint32_t joint,
+                  const ir_joint_transform_t *transform)
+{
+    const float values[IR_POSE_CHANNELS] = {
+        transform->translation.x, transform->translation.y,
+        transform->translation.z, transform->rotation.x,
+        transform->rotation.y,    transform->rotation.z,
+        transform->rotation.w,    transform->scale.x,
+        transform->scale.y,       transform->scale.z,
+    };
+    for (int i = 0; i < IR_POSE_CHANNELS; ++i)
+        channels[(size_t)i * stride + joint] = values[i];
+}
+
+bool Ir_PoseCreate(ir_pose_t *pose, const ir_skeleton_t *skeleton)
+{
+    size_t size = (size_t)IR_POSE_CHANNELS * skeleton->stride;
+    *pose = (ir_pose_t){.stride = skeleton->stride};
+    pose->channels = malloc(size * sizeof(float));
+    if (pose->channels == NULL)
+    {
+        IR_LOG_ERROR("Ran out of memory creating a pose.");
+        return false;
+    }
+    memcpy(pose->channels, skeleton->bind, size * sizeof(float));
+    return true;
+}
+
+void Ir_PoseDestroy(ir_pose_t *pose)
+{
+    free(pose->channels);
+    *pose = (ir_pose_t){0};
+}
+
+void Ir_PoseMatrices(const ir_skeleton_t *skeleton, const ir_pose_t *pose,
+                     uint32_t count, ir_joint_matrix_t *matrices)
+{
+    ir_simd_t locals[IR_SIMD_WIDTH][3];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t lane = i % IR_SIMD_WIDTH;
+        if (lane == 0) Locals(pose, i, locals);
+        uint32_t parent = skeleton->parents[i];
+        Attach(parent == IR_SKELETON_ROOT ? NULL : &matrices[parent],
+               locals[lane], &matrices[i]);
+    }
+}
+
+void Ir_PoseFollow(const ir_skeleton_t *skeleton, uint32_t first,
+                   ir_joint_matrix_t *matrices)
+{
+    for (uint32_t i = first; i < skeleton->joint_count; ++i)
+    {
+        const float(*rows)[4] = skeleton->locals[i].rows;
+        ir_simd_t local[3] = {Ir_SimdLoad(rows[0]), Ir_SimdLoad(rows[1]),
+                              Ir_SimdLoad(rows[2])};
+        uint32_t parent = skeleton->parents[i];
+        Attach(parent == IR_SKELETON_ROOT ? NULL : &matrices[parent],
+               local, &matrices[i]);
+    }
+}
+
+uint64_t Ir_SkeletonBake(ir_scene_writer_t *writer,
+                         const uint32_t *parents,
+                         const ir_joint_transform_t *bind, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (parents[i] != IR_SKELETON_ROOT && parents[i] >= i)
+        {
+            IR_LOG_ERROR("Joint %u comes before its parent.", i);
+            return 0;
+        }
+    }
+
+    uint32_t *heights = calloc(count, sizeof(uint32_t));
+    if (heights == NULL)
+    {
+        IR_LOG_ERROR("Ran out of memory baking a skeleton.");
+        return 0;
+    }
+
+    uint32_t stride = Ir_PoseStride(count);
+    uint64_t skeleton = Ir_SceneWriterAllocate(
+        writer, sizeof(ir_skeleton_t), alignof(ir_skeleton_t));
+    uint64_t links = Ir_SceneWriterAllocate(
+        writer, count * sizeof(uint32_t), alignof(uint32_t));
+    uint64_t channels = Ir_SceneWriterAllocate(
+        writer, (size_t)IR_POSE_CHANNELS * stride * sizeof(float),
+        IR_SCENE_ALIGNMENT);
+    uint64_t locals = Ir_SceneWriterAllocate(
+        writer, stride * sizeof(ir_joint_matrix_t), IR_SCENE_ALIGNMENT);
+    if (skeleton == 0 || links == 0 || channels == 0 || locals == 0)
+    {
+        free(heights);
+        return 0;
+    }
+
+    // A joint's height is how many steps its furthest tip is below it,
+    // found from the tips up since children come after their parents.
+    // Each level keeps every root and every joint at least that high.
+    for (uint32_t i = count; i-- > 0;)
+        if (parents[i] != IR_SKELETON_ROOT &&
+            heights[parents[i]] < heights[i] + 1)
+            heights[parents[i]] = heights[i] + 1;
+    ir_skeleton_t *header = Ir_SceneWriterGet(writer, skeleton);
+    header->joint_count = count;
+    header->stride = stride;
+    for (uint32_t i = 0; i < IR_SKELETON_LODS; ++i)
+        for (uint32_t j = 0; j < count; ++j)
+            if (parents[j] == IR_SKELETON_ROOT || heights[j] >= i)
+                header->lods[i] = j + 1;
+    free(heights);
+
+    memcpy(Ir_SceneWriterGet(writer, links), parents,
+           count * sizeof(uint32_t));
+    float *rest = Ir_SceneWriterGet(writer, channels);
+    for (uint32_t i = 0; i < stride; ++i)
+        Ir_PoseWrite(rest, stride, i,
+                     i < count ? &bind[i] : &IR_JOINT_IDENTITY);
+
+    ir_pose_t pose = {rest, stride};
+    ir_joint_matrix_t *matrices = Ir_SceneWriterGet(writer, locals);
+    for (uint32_t i = 0; i < stride; i += IR_SIMD_WIDTH)
+    {
+        ir_simd_t rows[IR_SIMD_WIDTH][3];
+        Locals(&pose, i, rows);
+        for (uint32_t j = 0; j < IR_SIMD_WIDTH; ++j)
+            for (int k = 0; k < 3; ++k)
+                Ir_SimdStore(matrices[i + j].rows[k], rows[j][k]);
+    }
+
+    Ir_SceneWriterPointer(writer,
+                          skeleton + offsetof(ir_skeleton_t, parents),
+                          links);
+    Ir_SceneWriterPointer(writer, skeleton + offsetof(ir_skeleton_t, bind),
+                          channels);
+    Ir_SceneWriterPointer(writer,
+                          skeleton + offsetof(ir_skeleton_t, locals),
+                          locals);
+    return writer->failed ? 0 : skeleton;
+}
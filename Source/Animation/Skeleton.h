@@ -0,0 +1,246 @@
+/**
+ * @file Skeleton.h
+ * @authors Israfiel
+ * @brief Iridium's skeletons and poses. Poses are stored a channel at a
+ * time rather than a joint at a time, so every step of evaluating one,
+ * from sampling to blending, works on four joints at once. Joints are
+ * ordered so each comes after its parent, which lets a single pass from
+ * the first joint to the last turn local transforms into model space.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_ANIMATION_SKELETON_H
+#define IRIDIUM_ANIMATION_SKELETON_H
+
+#include "Math/Quaternion.h"
+#include "Math/SIMD.h"
+#include "Scene/Scene.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_SKELETON_ROOT
+ * @brief The parent of a joint that has none.
+ */
+#define IR_SKELETON_ROOT UINT32_MAX
+
+/**
+ * @name IR_SKELETON_LODS
+ * @brief The number of levels of detail a skeleton has.
+ */
+#define IR_SKELETON_LODS 4
+
+/**
+ * @name ir_pose_channel_t
+ * @brief The channels of a pose, one float per joint each.
+ */
+typedef enum ir_pose_channel
+{
+    IR_POSE_TRANSLATION_X,
+    IR_POSE_TRANSLATION_Y,
+    IR_POSE_TRANSLATION_Z,
+    IR_POSE_ROTATION_X,
+    IR_POSE_ROTATION_Y,
+    IR_POSE_ROTATION_Z,
+    IR_POSE_ROTATION_W,
+    IR_POSE_SCALE_X,
+    IR_POSE_SCALE_Y,
+    IR_POSE_SCALE_Z,
+    IR_POSE_CHANNELS
+} ir_pose_channel_t;
+
+/**
+ * @name ir_joint_transform_t
+ * @brief A joint's transform relative to its parent: scaled, then
+ * rotated, then translated.
+ */
+typedef struct ir_joint_transform
+{
+    ir_vec3_t translation;
+    ir_quat_t rotation;
+    ir_vec3_t scale;
+} ir_joint_transform_t;
+
+/**
+ * @name IR_JOINT_IDENTITY
+ * @brief The transform that doesn't move a joint.
+ */
+#define IR_JOINT_IDENTITY                                                  \
+    ((ir_joint_transform_t){                                               \
+        {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}})
+
+/**
+ * @name ir_joint_matrix_t
+ * @brief A joint's model-space transform, as the top three rows of its
+ * 4x4 matrix.
+ */
+typedef struct ir_joint_matrix
+{
+    float rows[3][4];
+} ir_joint_matrix_t;
+
+/**
+ * @name ir_skeleton_t
+ * @brief A baked skeleton.
+ */
+typedef struct ir_skeleton
+{
+    uint32_t joint_count;
+    /**
+     * @name stride
+     * @brief The joint count rounded up to IR_SIMD_WIDTH, the length of
+     * each of a pose's channels.
+     */
+    uint32_t stride;
+    /**
+     * @name parents
+     * @brief Each joint's parent, always an earlier joint, or
+     * IR_SKELETON_ROOT.
+     */
+    uint32_t *parents;
+    /**
+     * @name bind
+     * @brief The rest pose, laid out as a pose's channels, which fills
+     * in whatever blended clips leave out.
+     */
+    float *bind;
+    /**
+     * @name locals
+     * @brief Each joint's rest transform relative to its parent, as a
+     * matrix, which the joints a level of detail drops follow.
+     */
+    ir_joint_matrix_t *locals;
+    /**
+     * @name lods
+     * @brief How many leading joints each level of detail evaluates.
+     * Level zero evaluates them all, and each level after drops the
+     * joints one step closer to the tips than the level before, as far
+     * as they trail the joints it keeps. Skeletons ordered breadth
+     * first, with their tips last, drop the most.
+     */
+    uint32_t lods[IR_SKELETON_LODS];
+} ir_skeleton_t;
+
+/**
+ * @name ir_pose_t
+ * @brief A local-space pose: channel c of joint j is at
+ * channels[c * stride + j]. The padding past the last joint holds an
+ * identity transform, so it can be worked on like any other joint.
+ */
+typedef struct ir_pose
+{
+    float *channels;
+    uint32_t stride;
+} ir_pose_t;
+
+/**
+ * @name PoseStride
+ * @authors Israfiel
+ * @brief Find the length of a pose's channels.
+ *
+ * @param joints - The number of joints.
+ * @returns The number rounded up to IR_SIMD_WIDTH.
+ */
+static inline uint32_t Ir_PoseStride(uint32_t joints)
+{
+    return (joints + IR_SIMD_WIDTH - 1) & ~(uint32_t)(IR_SIMD_WIDTH - 1);
+}
+
+/**
+ * @name PoseChannel
+ * @authors Israfiel
+ * @brief Find one of a pose's channels.
+ *
+ * @param pose - The pose.
+ * @param channel - The channel.
+ * @returns The channel's first joint.
+ */
+static inline float *Ir_PoseChannel(const ir_pose_t *pose,
+                                    ir_pose_channel_t channel)
+{
+    return pose->channels + (size_t)channel * pose->stride;
+}
+
+/**
+ * @name PoseWrite
+ * @authors Israfiel
+ * @brief Write one joint's transform into channels laid out as a pose.
+ *
+ * @param channels - The channels.
+ * @param stride - Their length.
+ * @param joint - The joint.
+ * @param transform - The transform.
+ */
+void Ir_PoseWrite(float *channels, uint32_t stride, uint32_t joint,
+                  const ir_joint_transform_t *transform);
+
+/**
+ * @name PoseCreate
+ * @authors Israfiel
+ * @brief Create a pose for a skeleton, in its bind pose.
+ *
+ * @param pose - The pose.
+ * @param skeleton - The skeleton.
+ * @returns Whether there was memory for it.
+ */
+bool Ir_PoseCreate(ir_pose_t *pose, const ir_skeleton_t *skeleton);
+
+/**
+ * @name PoseDestroy
+ * @authors Israfiel
+ * @brief Free a pose.
+ *
+ * @param pose - The pose.
+ */
+void Ir_PoseDestroy(ir_pose_t *pose);
+
+/**
+ * @name PoseMatrices
+ * @authors Israfiel
+ * @brief Turn a pose's first joints into model-space matrices. Any
+ * count works, since parents always come first.
+ *
+ * @param skeleton - The skeleton.
+ * @param pose - The pose.
+ * @param count - The number of joints to turn.
+ * @param matrices - Filled with a matrix for each joint.
+ */
+void Ir_PoseMatrices(const ir_skeleton_t *skeleton, const ir_pose_t *pose,
+                     uint32_t count, ir_joint_matrix_t *matrices);
+
+/**
+ * @name PoseFollow
+ * @authors Israfiel
+ * @brief Give joints model-space matrices that hold them at rest
+ * relative to their parents, for the joints a level of detail drops.
+ *
+ * @param skeleton - The skeleton.
+ * @param first - The first joint to hold at rest; the joints before it
+ * already have their matrices.
+ * @param matrices - The joints' matrices, filled in from first on.
+ */
+void Ir_PoseFollow(const ir_skeleton_t *skeleton, uint32_t first,
+                   ir_joint_matrix_t *matrices);
+
+/**
+ * @name SkeletonBake
+ * @authors Israfiel
+ * @brief Bake a skeleton into a scene.
+ *
+ * @param writer - The scene being baked.
+ * @param parents - Each joint's parent, which must come before it, or
+ * IR_SKELETON_ROOT.
+ * @param bind - Each joint's rest transform.
+ * @param count - The number of joints.
+ * @returns The skeleton's offset within the scene, or zero if it
+ * couldn't be baked.
+ */
+uint64_t Ir_SkeletonBake(ir_scene_writer_t *writer,
+                         const uint32_t *parents,
+                         const ir_joint_transform_t *bind, uint32_t count);
+
+#endif // IRIDIUM_ANIMATION_SKELETON_H
@@ -0,0 +1,86 @@
+/**
+ * @file Clock.c
+ * @authors Israfiel
+ * @brief The calibration of Iridium's high-resolution clock.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+// clock_gettime and CLOCK_MONOTONIC are POSIX, not C, so ask for them
+// even under a strict -std.
+#define _POSIX_C_SOURCE 199309L
+
+#include "Clock.h"
+
+#include <threads.h>
+#include <time.h>
+
+/**
+ * @name ir_clock
+ * @brief The clock's calibration, filled once on first use.
+ */
+static struct
+{
+    double frequency;
+    uint64_t reference_ticks;
+    uint64_t reference_nanoseconds;
+} ir_clock;
+
+/**
+ * @name ir_clock_once
+ * @brief Guards the clock's calibration.
+ */
+static once_flag ir_clock_once = ONCE_FLAG_INIT;
+
+/**
+ * @name Calibrate
+ * @authors Israfiel
+ * @brief Measure the clock's frequency and a reference point pairing
+ * ticks with monotonic time.
+ */
+static void Calibrate(void)
+{
+    uint64_t start_nanoseconds = Ir_ClockMonotonicNanoseconds();
+    uint64_t start_ticks = Ir_ClockTicks();
+
+#if defined(__aarch64__)
+    uint64_t frequency;
+    __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    ir_clock.frequency = (double)frequency;
+#elif defined(__x86_64__) || defined(__i386__)
+    struct timespec delay = {.tv_nsec = 10000000};
+    thrd_sleep(&delay, NULL);
+    uint64_t end_nanoseconds = Ir_ClockMonotonicNanoseconds();
+    uint64_t end_ticks = Ir_ClockTicks();
+    ir_clock.frequency = (double)(end_ticks - start_ticks) * 1e9 /
+                         (double)(end_nanoseconds - start_nanoseconds);
+#else
+    ir_clock.frequency = 1e9;
+#endif
+
+    ir_clock.reference_ticks = start_ticks;
+    ir_clock.reference_nanoseconds = start_nanoseconds;
+}
+
+double Ir_ClockFrequency(void)
+{
+    call_once(&ir_clock_once, Calibrate);
+    return ir_clock.frequency;
+}
+
+uint64_t Ir_ClockTicksToMonotonic(uint64_t ticks)
+{
+    call_once(&ir_clock_once, Calibrate);
+    int64_t delta = (int64_t)(ticks - ir_clock.reference_ticks);
+    double offset = (double)delta * 1e9 / ir_clock.frequency;
+    return ir_clock.reference_nanoseconds + (int64_t)offset;
+}
+
+uint64_t Ir_ClockMonotonicNanoseconds(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file Clock.h
+ * @authors Israfiel
+ * @brief Iridium's high-resolution clock. Reading it is a single
+ * instruction on x86 (rdtsc) and AArch64 (cntvct_el0); other targets
+ * fall back to the monotonic system clock.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_CORE_CLOCK_H
+#define IRIDIUM_CORE_CLOCK_H
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+/**
+ * @name ClockMonotonicNanoseconds
+ * @authors Israfiel
+ * @brief Read the system's monotonic clock, the clock the clock ticks
+ * are calibrated against.
+ *
+ * @returns The monotonic time in nanoseconds.
+ */
+uint64_t Ir_ClockMonotonicNanoseconds(void);
+
+/**
+ * @name ClockTicks
+ * @authors Israfiel
+ * @brief Read the clock. Ticks are only comparable within a process,
+ * and must be converted with Ir_ClockFrequency.
+ *
+ * @returns The current tick count.
+ */
+static inline uint64_t Ir_ClockTicks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return Ir_ClockMonotonicNanoseconds();
+#endif
+}
+
+/**
+ * @name ClockFrequency
+ * @authors Israfiel
+ * @brief Get the number of clock ticks per second. The first call on
+ * x86 calibrates the TSC against the monotonic clock, which takes
+ * around ten milliseconds.
+ *
+ * @returns Ticks per second.
+ */
+double Ir_ClockFrequency(void);
+
+/**
+ * @name ClockTicksToNanoseconds
+ * @authors Israfiel
+ * @brief Convert a tick count, or a difference of two, to nanoseconds.
+ *
+ * @param ticks - The ticks to convert.
+ * @returns The equivalent time in nanoseconds.
+ */
+static inline double Ir_ClockTicksToNanoseconds(uint64_t ticks)
+{
+    return (double)ticks * 1e9 / Ir_ClockFrequency();
+}
+
+/**
+ * @name ClockTicksToMonotonic
+ * @authors Israfiel
+ * @brief Convert an absolute tick count to the monotonic clock's time
+ * base, so it can be lined up with timestamps from other sources.
+ *
+ * @param ticks - The tick count to convert.
+ * @returns The equivalent monotonic time in nanoseconds.
+ */
+uint64_t Ir_ClockTicksToMonotonic(uint64_t ticks);
+
+#endif // IRIDIUM_CORE_CLOCK_H
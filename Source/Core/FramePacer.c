@@ -0,0 +1,148 @@
+/**
+ * @file FramePacer.c
+ * @authors Israfiel
+ * @brief The implementation of Iridium's frame pacer.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "FramePacer.h"
+
+#include <string.h>
+
+/**
+ * @name INITIAL_MARGIN
+ * @brief The safety margin before any frame has been missed, 1 ms.
+ */
+#define INITIAL_MARGIN 1000000ull
+
+/**
+ * @name MARGIN_STEP
+ * @brief How much the margin grows per missed frame, 0.5 ms.
+ */
+#define MARGIN_STEP 500000ull
+
+/**
+ * @name PopTarget
+ * @authors Israfiel
+ * @brief Take the oldest submitted frame's target vblank.
+ *
+ * @param pacer - The pacer.
+ * @returns The target, or zero if none was recorded.
+ */
+static uint64_t PopTarget(ir_frame_pacer_t *pacer)
+{
+    if (pacer->target_count == 0) return 0;
+    uint64_t target = pacer->targets[0];
+    memmove(pacer->targets, pacer->targets + 1,
+            --pacer->target_count * sizeof(uint64_t));
+    return target;
+}
+
+/**
+ * @name Budget
+ * @authors Israfiel
+ * @brief The time to allow a frame: the slowest recent frame plus the
+ * safety margin, capped so a pathological frame can't push the start
+ * more than a refresh early.
+ *
+ * @param pacer - The pacer.
+ * @returns The budget.
+ */
+static uint64_t Budget(const ir_frame_pacer_t *pacer)
+{
+    uint64_t slowest = 0;
+    for (uint32_t i = 0; i < pacer->cost_count; ++i)
+        if (pacer->costs[i] > slowest) slowest = pacer->costs[i];
+
+    uint64_t budget = slowest + pacer->margin;
+    return budget < pacer->refresh ? budget : pacer->refresh;
+}
+
+void Ir_FramePacerReset(ir_frame_pacer_t *pacer, uint64_t refresh)
+{
+    *pacer = (ir_frame_pacer_t){
+        .refresh = refresh,
+        .margin = INITIAL_MARGIN,
+    };
+}
+
+uint64_t Ir_FramePacerPredictVblank(const ir_frame_pacer_t *pacer,
+                                    uint64_t time)
+{
+    if (pacer->vblank == 0 || pacer->refresh == 0) return time;
+    if (time <= pacer->vblank) return pacer->vblank;
+
+    uint64_t periods =
+        (time - pacer->vblank + pacer->refresh - 1) / pacer->refresh;
+    return pacer->vblank + periods * pacer->refresh;
+}
+
+uint64_t Ir_FramePacerNextStart(ir_frame_pacer_t *pacer, uint64_t now)
+{
+    // Until the first present, pretend a vblank just happened, so that
+    // frames run at the assumed refresh rather than as fast as they can.
+    if (pacer->vblank == 0) pacer->vblank = now;
+
+    uint64_t budget = Budget(pacer);
+    pacer->target = Ir_FramePacerPredictVblank(pacer, now + budget);
+    // A known vblank already flipped a frame, even if it's yet to come.
+    if (pacer->target <= pacer->vblank)
+        pacer->target = pacer->vblank + pacer->refresh;
+    // Never aim for a vblank an in-flight frame already holds.
+    if (pacer->target_count != 0 &&
+        pacer->target <= pacer->targets[pacer->target_count - 1])
+        pacer->target =
+            pacer->targets[pacer->target_count - 1] + pacer->refresh;
+
+    uint64_t start = pacer->target - budget;
+    return start > now ? start : now;
+}
+
+void Ir_FramePacerSubmitted(ir_frame_pacer_t *pacer, uint64_t begin,
+                            uint64_t end)
+{
+    pacer->costs[pacer->cost_head] = end > begin ? end - begin : 0;
+    pacer->cost_head = (pacer->cost_head + 1) % IR_FRAME_PACER_HISTORY;
+    if (pacer->cost_count < IR_FRAME_PACER_HISTORY) pacer->cost_count++;
+
+    // If the compositor stopped giving feedback, forget the oldest.
+    if (pacer->target_count == IR_FRAME_PACER_IN_FLIGHT) PopTarget(pacer);
+    pacer->targets[pacer->target_count++] = pacer->target;
+}
+
+void Ir_FramePacerPresented(ir_frame_pacer_t *pacer, uint64_t time,
+                            uint64_t refresh)
+{
+    if (refresh != 0) pacer->refresh = refresh;
+    else if (pacer->vblank != 0 && time > pacer->vblank)
+    {
+        // Estimate the period from the gap, which may span several
+        // refreshes if frames were skipped.
+        uint64_t gap = time - pacer->vblank;
+        uint64_t periods = (gap + pacer->refresh / 2) / pacer->refresh;
+        if (periods != 0)
+            pacer->refresh = (pacer->refresh * 7 + gap / periods) / 8;
+    }
+    pacer->vblank = time;
+    pacer->presented++;
+
+    uint64_t target = PopTarget(pacer);
+    if (target == 0) return;
+    if (time > target + pacer->refresh / 2)
+    {
+        pacer->missed++;
+        pacer->margin += MARGIN_STEP;
+        if (pacer->margin > pacer->refresh / 2)
+            pacer->margin = pacer->refresh / 2;
+    }
+    else if (pacer->margin > INITIAL_MARGIN)
+        pacer->margin -= pacer->margin / 64;
+}
+
+void Ir_FramePacerDiscarded(ir_frame_pacer_t *pacer)
+{
+    PopTarget(pacer);
+}
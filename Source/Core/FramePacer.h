@@ -0,0 +1,158 @@
+/**
+ * @file FramePacer.h
+ * @authors Israfiel
+ * @brief Just-in-time frame scheduling. The pacer learns the display's
+ * refresh period and phase from real present timestamps, and how long
+ * frames take from their submissions, then starts each frame as late
+ * as it can while still making the next vblank. Starting late keeps the
+ * input a frame samples fresh; the safety margin grows whenever a frame
+ * misses its vblank and slowly shrinks while frames land on time.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_CORE_FRAMEPACER_H
+#define IRIDIUM_CORE_FRAMEPACER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_FRAME_PACER_HISTORY
+ * @brief The number of recent frame costs the budget is taken from.
+ */
+#define IR_FRAME_PACER_HISTORY 32
+
+/**
+ * @name IR_FRAME_PACER_IN_FLIGHT
+ * @brief The most submitted frames awaiting presentation.
+ */
+#define IR_FRAME_PACER_IN_FLIGHT 8
+
+/**
+ * @name ir_frame_pacer_t
+ * @brief A pacer's state. Every time is in monotonic nanoseconds.
+ */
+typedef struct ir_frame_pacer
+{
+    /**
+     * @name refresh
+     * @brief The display's refresh period.
+     */
+    uint64_t refresh;
+    /**
+     * @name vblank
+     * @brief The most recent known vblank, or zero before the first
+     * present.
+     */
+    uint64_t vblank;
+    /**
+     * @name margin
+     * @brief Slack added to the frame budget to absorb jitter and the
+     * compositor's own deadline.
+     */
+    uint64_t margin;
+    /**
+     * @name costs
+     * @brief How long recent frames took from start to submission.
+     */
+    uint64_t costs[IR_FRAME_PACER_HISTORY];
+    uint32_t cost_count;
+    uint32_t cost_head;
+    /**
+     * @name target
+     * @brief The vblank the frame being built is aiming for.
+     */
+    uint64_t target;
+    /**
+     * @name targets
+     * @brief The vblanks submitted frames aimed for, oldest first.
+     */
+    uint64_t targets[IR_FRAME_PACER_IN_FLIGHT];
+    uint32_t target_count;
+    /**
+     * @name presented
+     * @brief The number of frames presented.
+     */
+    uint64_t presented;
+    /**
+     * @name missed
+     * @brief The number of frames presented after their target vblank.
+     */
+    uint64_t missed;
+} ir_frame_pacer_t;
+
+/**
+ * @name FramePacerReset
+ * @authors Israfiel
+ * @brief Reset a pacer, forgetting everything it learned.
+ *
+ * @param pacer - The pacer.
+ * @param refresh - The refresh period to assume until presents arrive,
+ * in nanoseconds.
+ */
+void Ir_FramePacerReset(ir_frame_pacer_t *pacer, uint64_t refresh);
+
+/**
+ * @name FramePacerNextStart
+ * @authors Israfiel
+ * @brief Decide when the next frame should start, and which vblank it
+ * will aim for. Before any present has been fed in, frames are paced
+ * at the assumed refresh period.
+ *
+ * @param pacer - The pacer.
+ * @param now - The current time.
+ * @returns When to start the frame; never earlier than now.
+ */
+uint64_t Ir_FramePacerNextStart(ir_frame_pacer_t *pacer, uint64_t now);
+
+/**
+ * @name FramePacerPredictVblank
+ * @authors Israfiel
+ * @brief Predict the first vblank at or after a time.
+ *
+ * @param pacer - The pacer.
+ * @param time - The time.
+ * @returns The predicted vblank.
+ */
+uint64_t Ir_FramePacerPredictVblank(const ir_frame_pacer_t *pacer,
+                                    uint64_t time);
+
+/**
+ * @name FramePacerSubmitted
+ * @authors Israfiel
+ * @brief Note that a frame was submitted for presentation.
+ *
+ * @param pacer - The pacer.
+ * @param begin - When the frame started.
+ * @param end - When the frame was submitted.
+ */
+void Ir_FramePacerSubmitted(ir_frame_pacer_t *pacer, uint64_t begin,
+                            uint64_t end);
+
+/**
+ * @name FramePacerPresented
+ * @authors Israfiel
+ * @brief Feed in the oldest submitted frame's presentation.
+ *
+ * @param pacer - The pacer.
+ * @param time - When the frame became visible, ideally the vblank it
+ * was flipped at.
+ * @param refresh - The refresh period the display reported, or zero if
+ * unknown.
+ */
+void Ir_FramePacerPresented(ir_frame_pacer_t *pacer, uint64_t time,
+                            uint64_t refresh);
+
+/**
+ * @name FramePacerDiscarded
+ * @authors Israfiel
+ * @brief Note that the oldest submitted frame was never shown.
+ *
+ * @param pacer - The pacer.
+ */
+void Ir_FramePacerDiscarded(ir_frame_pacer_t *pacer);
+
+#endif // IRIDIUM_CORE_FRAMEPACER_H
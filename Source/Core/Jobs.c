@@ -0,0 +1,230 @@
+/**
+ * @file Jobs.c
+ * @authors Israfiel
+ * @brief Implements Iridium's job system.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Jobs.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+
+#include <assert.h>
+#include <unistd.h>
+
+static_assert((IR_JOBS_QUEUE & (IR_JOBS_QUEUE - 1)) == 0,
+              "The job queue's size must be a power of two.");
+
+/**
+ * @name QUEUE_MASK
+ * @brief Wraps a queue index to a slot.
+ */
+#define QUEUE_MASK (IR_JOBS_QUEUE - 1)
+
+/**
+ * @name ir_job_loop_t
+ * @brief A parallel for in progress, shared by everyone running it.
+ */
+typedef struct ir_job_loop
+{
+    ir_job_range_t range;
+    void *user;
+    size_t count;
+    size_t grain;
+    /**
+     * @name next
+     * @brief The start of the next chunk to hand out.
+     */
+    _Atomic size_t next;
+} ir_job_loop_t;
+
+/**
+ * @name RunEntry
+ * @authors Israfiel
+ * @brief Run a dequeued job and count it finished.
+ *
+ * @param entry - The job.
+ */
+static void RunEntry(const ir_job_entry_t *entry)
+{
+    entry->job(entry->user);
+    if (entry->counter != NULL)
+        atomic_fetch_sub_explicit(&entry->counter->pending, 1,
+                                  memory_order_release);
+}
+
+/**
+ * @name TryPop
+ * @authors Israfiel
+ * @brief Take the oldest queued job. The pool's mutex must be held.
+ *
+ * @param jobs - The pool.
+ * @param entry - Filled with the job.
+ * @returns Whether there was one.
+ */
+static bool TryPop(ir_jobs_t *jobs, ir_job_entry_t *entry)
+{
+    if (jobs->head == jobs->tail) return false;
+    *entry = jobs->queue[jobs->head++ & QUEUE_MASK];
+    return true;
+}
+
+/**
+ * @name Worker
+ * @authors Israfiel
+ * @brief Run jobs until the pool stops and its queue is empty.
+ *
+ * @param user - The pool.
+ * @returns Zero.
+ */
+static int Worker(void *user)
+{
+    ir_jobs_t *jobs = user;
+    IR_PROFILE_THREAD_NAME("Worker");
+
+    mtx_lock(&jobs->mutex);
+    while (true)
+    {
+        ir_job_entry_t entry;
+        if (TryPop(jobs, &entry))
+        {
+            mtx_unlock(&jobs->mutex);
+            RunEntry(&entry);
+            mtx_lock(&jobs->mutex);
+            continue;
+        }
+        if (jobs->stopping) break;
+        cnd_wait(&jobs->wake, &jobs->mutex);
+    }
+    mtx_unlock(&jobs->mutex);
+    return 0;
+}
+
+/**
+ * @name RunLoop
+ * @authors Israfiel
+ * @brief Take chunks of a parallel for until there are none left.
+ *
+ * @param user - The parallel for.
+ */
+static void RunLoop(void *user)
+{
+    ir_job_loop_t *loop = user;
+    while (true)
+    {
+        size_t begin = atomic_fetch_add_explicit(
+            &loop->next, loop->grain, memory_order_relaxed);
+        if (begin >= loop->count) return;
+        size_t end = begin + loop->grain;
+        loop->range(loop->user, begin, end < loop->count ? end
+                                                          : loop->count);
+    }
+}
+
+bool Ir_JobsCreate(ir_jobs_t *jobs, uint32_t workers)
+{
+    if (workers == 0)
+    {
+        long threads = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = threads > 1 ? (uint32_t)threads - 1 : 1;
+    }
+    if (workers > IR_JOBS_MAX_WORKERS) workers = IR_JOBS_MAX_WORKERS;
+
+    jobs->worker_count = 0;
+    jobs->head = jobs->tail = 0;
+    jobs->stopping = false;
+    mtx_init(&jobs->mutex, mtx_plain);
+    cnd_init(&jobs->wake);
+    for (uint32_t i = 0; i < workers; ++i)
+    {
+        if (thrd_create(&jobs->workers[i], Worker, jobs) != thrd_success)
+        {
+            IR_LOG_ERROR("Failed to start job worker %u.", i);
+            Ir_JobsDestroy(jobs);
+            return false;
+        }
+        jobs->worker_count++;
+    }
+    return true;
+}
+
+void Ir_JobsDestroy(ir_jobs_t *jobs)
+{
+    mtx_lock(&jobs->mutex);
+    jobs->stopping = true;
+    cnd_broadcast(&jobs->wake);
+    mtx_unlock(&jobs->mutex);
+    for (uint32_t i = 0; i < jobs->worker_count; ++i)
+        thrd_join(jobs->workers[i], NULL);
+
+    // Without workers, jobs still queued would never run.
+    ir_job_entry_t entry;
+    while (TryPop(jobs, &entry)) RunEntry(&entry);
+    cnd_destroy(&jobs->wake);
+    mtx_destroy(&jobs->mutex);
+}
+
+void Ir_JobsSubmit(ir_jobs_t *jobs, ir_job_t job, void *user,
+                   ir_job_counter_t *counter)
+{
+    ir_job_entry_t entry = {job, user, counter};
+    if (counter != NULL)
+        atomic_fetch_add_explicit(&counter->pending, 1,
+                                  memory_order_relaxed);
+
+    mtx_lock(&jobs->mutex);
+    if (jobs->tail - jobs->head == IR_JOBS_QUEUE)
+    {
+        mtx_unlock(&jobs->mutex);
+        RunEntry(&entry);
+        return;
+    }
+    jobs->queue[jobs->tail++ & QUEUE_MASK] = entry;
+    cnd_signal(&jobs->wake);
+    mtx_unlock(&jobs->mutex);
+}
+
+void Ir_JobsWait(ir_jobs_t *jobs, ir_job_counter_t *counter)
+{
+    while (atomic_load_explicit(&counter->pending, memory_order_acquire))
+    {
+        mtx_lock(&jobs->mutex);
+        ir_job_entry_t entry;
+        bool popped = TryPop(jobs, &entry);
+        mtx_unlock(&jobs->mutex);
+
+        // Nothing left to help with; the last jobs are running
+        // elsewhere and will finish shortly.
+        if (popped) RunEntry(&entry);
+        else thrd_yield();
+    }
+}
+
+void Ir_JobsParallelFor(ir_jobs_t *jobs, size_t count, size_t grain,
+                        ir_job_range_t range, void *user)
+{
+    if (count == 0) return;
+    size_t runners = jobs->worker_count + 1;
+    // Four chunks a runner leaves room to balance uneven chunks.
+    if (grain == 0) grain = (count + runners * 4 - 1) / (runners * 4);
+
+    ir_job_loop_t loop = {
+        .range = range,
+        .user = user,
+        .count = count,
+        .grain = grain,
+    };
+    atomic_init(&loop.next, 0);
+
+    size_t chunks = (count + grain - 1) / grain;
+    if (runners > chunks) runners = chunks;
+    ir_job_counter_t counter = {0};
+    for (size_t i = 1; i < runners; ++i)
+        Ir_JobsSubmit(jobs, RunLoop, &loop, &counter);
+    RunLoop(&loop);
+    Ir_JobsWait(jobs, &counter);
+}
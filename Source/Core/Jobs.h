@@ -0,0 +1,156 @@
+/**
+ * @file Jobs.h
+ * @authors Israfiel
+ * @brief Iridium's job system: a pool of worker threads running small
+ * jobs from a shared queue. Threads waiting on jobs run queued jobs
+ * themselves instead of sleeping, so waiting from inside a job never
+ * deadlocks the pool.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_CORE_JOBS_H
+#define IRIDIUM_CORE_JOBS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <threads.h>
+
+/**
+ * @name IR_JOBS_QUEUE
+ * @brief The most jobs queued at once. Jobs submitted to a full queue
+ * are run right away by the submitter. Must be a power of two.
+ */
+#define IR_JOBS_QUEUE 4096
+
+/**
+ * @name IR_JOBS_MAX_WORKERS
+ * @brief The most worker threads a pool will start.
+ */
+#define IR_JOBS_MAX_WORKERS 64
+
+/**
+ * @name ir_job_t
+ * @brief A job.
+ *
+ * @param user - The job's user data.
+ */
+typedef void (*ir_job_t)(void *user);
+
+/**
+ * @name ir_job_range_t
+ * @brief One chunk of a parallel for.
+ *
+ * @param user - The loop's user data.
+ * @param begin - The chunk's first index.
+ * @param end - One past the chunk's last index.
+ */
+typedef void (*ir_job_range_t)(void *user, size_t begin, size_t end);
+
+/**
+ * @name ir_job_counter_t
+ * @brief Counts a group of jobs still to finish. Zero it before the
+ * first submission.
+ */
+typedef struct ir_job_counter
+{
+    _Atomic uint32_t pending;
+} ir_job_counter_t;
+
+/**
+ * @name ir_job_entry_t
+ * @brief A queued job.
+ */
+typedef struct ir_job_entry
+{
+    ir_job_t job;
+    void *user;
+    ir_job_counter_t *counter;
+} ir_job_entry_t;
+
+/**
+ * @name ir_jobs_t
+ * @brief A pool of worker threads.
+ */
+typedef struct ir_jobs
+{
+    thrd_t workers[IR_JOBS_MAX_WORKERS];
+    uint32_t worker_count;
+    /**
+     * @name queue
+     * @brief The queued jobs, a ring from head to tail.
+     */
+    ir_job_entry_t queue[IR_JOBS_QUEUE];
+    uint32_t head;
+    uint32_t tail;
+    bool stopping;
+    mtx_t mutex;
+    cnd_t wake;
+} ir_jobs_t;
+
+/**
+ * @name JobsCreate
+ * @authors Israfiel
+ * @brief Start a pool of worker threads.
+ *
+ * @param jobs - The pool to start.
+ * @param workers - The number of workers, or zero for one fewer than
+ * the machine has hardware threads, leaving one for the caller.
+ * @returns Whether the pool was started.
+ */
+bool Ir_JobsCreate(ir_jobs_t *jobs, uint32_t workers);
+
+/**
+ * @name JobsDestroy
+ * @authors Israfiel
+ * @brief Finish every queued job and stop the workers.
+ *
+ * @param jobs - The pool to stop.
+ */
+void Ir_JobsDestroy(ir_jobs_t *jobs);
+
+/**
+ * @name JobsSubmit
+ * @authors Israfiel
+ * @brief Queue a job.
+ *
+ * @param jobs - The pool.
+ * @param job - The job.
+ * @param user - The job's user data.
+ * @param counter - Counts the job until it finishes, or NULL.
+ */
+void Ir_JobsSubmit(ir_jobs_t *jobs, ir_job_t job, void *user,
+                   ir_job_counter_t *counter);
+
+/**
+ * @name JobsWait
+ * @authors Israfiel
+ * @brief Wait for every job counted by a counter to finish, running
+ * queued jobs in the meantime.
+ *
+ * @param jobs - The pool.
+ * @param counter - The counter.
+ */
+void Ir_JobsWait(ir_jobs_t *jobs, ir_job_counter_t *counter);
+
+/**
+ * @name JobsParallelFor
+ * @authors Israfiel
+ * @brief Run a function over a range in chunks spread across the pool
+ * and the caller, returning once every chunk is done. Chunks are handed
+ * out one at a time, so uneven chunks balance themselves.
+ *
+ * @param jobs - The pool.
+ * @param count - The size of the range.
+ * @param grain - The size of a chunk; zero picks one.
+ * @param range - The function.
+ * @param user - The function's user data.
+ */
+void Ir_JobsParallelFor(ir_jobs_t *jobs, size_t count, size_t grain,
+                        ir_job_range_t range, void *user);
+
+#endif // IRIDIUM_CORE_JOBS_H
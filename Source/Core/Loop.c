@@ -0,0 +1,232 @@
+/**
+ * @file Loop.c
+ * @authors Israfiel
+ * @brief Implements Iridium's fixed-timestep simulation loop.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Loop.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name State
+ * @authors Israfiel
+ * @brief Get one of a loop's state buffers.
+ *
+ * @param loop - The loop.
+ * @param index - The buffer's index.
+ * @returns The buffer.
+ */
+static uint8_t *State(const ir_loop_t *loop, uint32_t index)
+{
+    return loop->states + (size_t)index * loop->config.state_size;
+}
+
+/**
+ * @name NextState
+ * @authors Israfiel
+ * @brief Pick the buffer a tick writes into: whichever neither of the
+ * two being rendered, nor the one just written, occupies. With four
+ * buffers there's always one.
+ *
+ * @param rendered - The buffers being rendered.
+ * @param current - The buffer just written.
+ * @returns The buffer to write.
+ */
+static uint32_t NextState(const uint32_t rendered[2], uint32_t current)
+{
+    uint32_t next = 0;
+    while (next == rendered[0] || next == rendered[1] || next == current)
+        next++;
+    return next;
+}
+
+/**
+ * @name RunTicks
+ * @authors Israfiel
+ * @brief Run ticks, leaving the states being rendered untouched.
+ *
+ * @param loop - The loop.
+ * @param count - The number of ticks.
+ */
+static void RunTicks(ir_loop_t *loop, uint32_t count)
+{
+    uint32_t rendered[2] = {loop->previous, loop->current};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t next = NextState(rendered, loop->current);
+        IR_PROFILE_BEGIN("Tick");
+        loop->config.tick(loop->config.user, State(loop, loop->current),
+                          State(loop, next), ++loop->tick,
+                          loop->config.step);
+        IR_PROFILE_END("Tick");
+        loop->previous = loop->current;
+        loop->current = next;
+    }
+}
+
+/**
+ * @name SimulationThread
+ * @authors Israfiel
+ * @brief Run each batch of ticks a pipelined loop hands over.
+ *
+ * @param user - The loop.
+ * @returns Zero.
+ */
+static int SimulationThread(void *user)
+{
+    ir_loop_t *loop = user;
+    IR_PROFILE_THREAD_NAME("Simulation");
+
+    mtx_lock(&loop->mutex);
+    while (true)
+    {
+        while (loop->batch == 0 && !loop->stopping)
+            cnd_wait(&loop->wake, &loop->mutex);
+        if (loop->batch == 0) break;
+
+        // The frame only reads the loop's indices once the batch is
+        // done, so the lock needn't be held while ticking.
+        uint32_t batch = loop->batch;
+        mtx_unlock(&loop->mutex);
+        RunTicks(loop, batch);
+        mtx_lock(&loop->mutex);
+        loop->batch = 0;
+        cnd_signal(&loop->done);
+    }
+    mtx_unlock(&loop->mutex);
+    return 0;
+}
+
+/**
+ * @name WaitForBatch
+ * @authors Israfiel
+ * @brief Wait for the simulation thread to finish its batch.
+ *
+ * @param loop - The loop.
+ */
+static void WaitForBatch(ir_loop_t *loop)
+{
+    mtx_lock(&loop->mutex);
+    while (loop->batch != 0) cnd_wait(&loop->done, &loop->mutex);
+    mtx_unlock(&loop->mutex);
+}
+
+bool Ir_LoopCreate(ir_loop_t *loop, const ir_loop_config_t *config)
+{
+    *loop = (ir_loop_t){.config = *config};
+    if (loop->config.max_ticks == 0) loop->config.max_ticks = 1;
+
+    loop->states = malloc(IR_LOOP_STATES * config->state_size);
+    if (loop->states == NULL) return false;
+    memcpy(State(loop, 0), config->initial, config->state_size);
+    memcpy(State(loop, 1), config->initial, config->state_size);
+    loop->previous = 0;
+    loop->current = 1;
+    loop->pending = (ir_loop_frame_t){
+        .previous = State(loop, 0),
+        .current = State(loop, 1),
+    };
+    if (!config->pipelined) return true;
+
+    mtx_init(&loop->mutex, mtx_plain);
+    cnd_init(&loop->wake);
+    cnd_init(&loop->done);
+    if (thrd_create(&loop->thread, SimulationThread, loop) != thrd_success)
+    {
+        IR_LOG_ERROR("Failed to start the simulation thread.");
+        cnd_destroy(&loop->done);
+        cnd_destroy(&loop->wake);
+        mtx_destroy(&loop->mutex);
+        free(loop->states);
+        return false;
+    }
+    return true;
+}
+
+void Ir_LoopDestroy(ir_loop_t *loop)
+{
+    if (loop->config.pipelined)
+    {
+        mtx_lock(&loop->mutex);
+        loop->stopping = true;
+        cnd_signal(&loop->wake);
+        mtx_unlock(&loop->mutex);
+        thrd_join(loop->thread, NULL);
+        cnd_destroy(&loop->done);
+        cnd_destroy(&loop->wake);
+        mtx_destroy(&loop->mutex);
+    }
+    free(loop->states);
+}
+
+void Ir_LoopAdvance(ir_loop_t *loop, uint64_t now, ir_loop_frame_t *frame)
+{
+    uint64_t step = loop->config.step;
+    if (loop->last != 0 && now > loop->last)
+        loop->accumulator += now - loop->last;
+    loop->last = now;
+
+    uint64_t limit = (uint64_t)loop->config.max_ticks * step;
+    if (loop->accumulator > limit)
+    {
+        loop->dropped += loop->accumulator - limit;
+        loop->accumulator = limit;
+    }
+    uint32_t ticks = (uint32_t)(loop->accumulator / step);
+    loop->accumulator -= ticks * step;
+    float alpha = (float)loop->accumulator / (float)step;
+
+    if (!loop->config.pipelined)
+    {
+        RunTicks(loop, ticks);
+        *frame = (ir_loop_frame_t){
+            .previous = State(loop, loop->previous),
+            .current = State(loop, loop->current),
+            .alpha = alpha,
+            .tick = loop->tick,
+            .ticks = ticks,
+        };
+        return;
+    }
+
+    // Render what the last batch produced while this one runs.
+    WaitForBatch(loop);
+    *frame = loop->pending;
+    loop->pending = (ir_loop_frame_t){
+        .alpha = alpha,
+        .tick = loop->tick + ticks,
+        .ticks = ticks,
+    };
+    if (ticks == 0)
+    {
+        loop->pending.previous = State(loop, loop->previous);
+        loop->pending.current = State(loop, loop->current);
+        return;
+    }
+
+    // Where the batch will leave its last two states is known ahead of
+    // time, since the buffers are chosen deterministically.
+    uint32_t previous = loop->previous, current = loop->current;
+    uint32_t rendered[2] = {previous, current};
+    for (uint32_t i = 0; i < ticks; ++i)
+    {
+        previous = current;
+        current = NextState(rendered, current);
+    }
+    loop->pending.previous = State(loop, previous);
+    loop->pending.current = State(loop, current);
+
+    mtx_lock(&loop->mutex);
+    loop->batch = ticks;
+    cnd_signal(&loop->wake);
+    mtx_unlock(&loop->mutex);
+}
@@ -0,0 +1,216 @@
+/**
+ * @file Loop.h
+ * @authors Israfiel
+ * @brief Iridium's fixed-timestep simulation loop. The simulation only
+ * ever advances in whole ticks of a fixed length, so it behaves the same
+ * however fast frames come; rendering interpolates between the last two
+ * ticks to stay smooth. Simulation state lives in buffers the loop owns:
+ * each tick reads the state before it and writes a fresh one, which is
+ * what lets a pipelined loop simulate the next ticks on its own thread
+ * while the frame renders the last ones.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_CORE_LOOP_H
+#define IRIDIUM_CORE_LOOP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <threads.h>
+
+/**
+ * @name IR_LOOP_STATES
+ * @brief The number of state buffers a loop keeps: two being rendered,
+ * and two the simulation alternates between.
+ */
+#define IR_LOOP_STATES 4
+
+/**
+ * @name ir_loop_tick_t
+ * @brief Simulate one tick. On a pipelined loop this runs on the
+ * simulation thread, concurrently with the frame.
+ *
+ * @param user - The loop's user data.
+ * @param previous - The state after the last tick.
+ * @param next - Filled with the state after this tick. Starts out
+ * holding a stale state, never the previous one.
+ * @param tick - The tick's number, starting from 1.
+ * @param step - The tick's length in nanoseconds.
+ */
+typedef void (*ir_loop_tick_t)(void *user, const void *previous,
+                               void *next, uint64_t tick, uint64_t step);
+
+/**
+ * @name ir_loop_config_t
+ * @brief How to create a loop.
+ */
+typedef struct ir_loop_config
+{
+    /**
+     * @name step
+     * @brief The length of a tick, in nanoseconds.
+     */
+    uint64_t step;
+    /**
+     * @name max_ticks
+     * @brief The most ticks a frame may run. Time beyond that is
+     * dropped, so a frame that runs long slows the simulation down
+     * instead of making every later frame run longer still.
+     */
+    uint32_t max_ticks;
+    /**
+     * @name state_size
+     * @brief The size of the simulation state, in bytes.
+     */
+    size_t state_size;
+    /**
+     * @name initial
+     * @brief The state before the first tick.
+     */
+    const void *initial;
+    ir_loop_tick_t tick;
+    void *user;
+    /**
+     * @name pipelined
+     * @brief Whether to simulate on a thread of its own. A pipelined
+     * frame renders the ticks the previous frame ran, adding a frame of
+     * latency in exchange for overlapping simulation with rendering.
+     */
+    bool pipelined;
+} ir_loop_config_t;
+
+/**
+ * @name ir_loop_frame_t
+ * @brief What a frame should render.
+ */
+typedef struct ir_loop_frame
+{
+    /**
+     * @name previous
+     * @brief The state one tick before current. Read-only, and valid
+     * until the next advance.
+     */
+    const void *previous;
+    /**
+     * @name current
+     * @brief The latest state to render. Read-only, and valid until the
+     * next advance.
+     */
+    const void *current;
+    /**
+     * @name alpha
+     * @brief How far from previous to current to interpolate, in [0, 1).
+     */
+    float alpha;
+    /**
+     * @name tick
+     * @brief The number of the tick that produced current.
+     */
+    uint64_t tick;
+    /**
+     * @name ticks
+     * @brief The number of ticks run for this frame.
+     */
+    uint32_t ticks;
+} ir_loop_frame_t;
+
+/**
+ * @name ir_loop_t
+ * @brief A fixed-timestep loop.
+ */
+typedef struct ir_loop
+{
+    ir_loop_config_t config;
+    /**
+     * @name states
+     * @brief The state buffers, IR_LOOP_STATES of them back to back.
+     */
+    uint8_t *states;
+    /**
+     * @name previous
+     * @brief The index of the state one tick before current.
+     */
+    uint32_t previous;
+    /**
+     * @name current
+     * @brief The index of the latest state.
+     */
+    uint32_t current;
+    /**
+     * @name tick
+     * @brief The number of ticks run.
+     */
+    uint64_t tick;
+    /**
+     * @name accumulator
+     * @brief Time owed to the simulation, less than a tick once a frame
+     * has caught up.
+     */
+    uint64_t accumulator;
+    /**
+     * @name last
+     * @brief When the loop was last advanced, or zero before the first.
+     */
+    uint64_t last;
+    /**
+     * @name dropped
+     * @brief The total time dropped by the tick cap, in nanoseconds.
+     */
+    uint64_t dropped;
+    /**
+     * @name pending
+     * @brief The frame handed to the simulation thread, rendered once it
+     * has finished.
+     */
+    ir_loop_frame_t pending;
+    /**
+     * @name batch
+     * @brief The ticks the simulation thread has left to run; it's idle
+     * at zero.
+     */
+    uint32_t batch;
+    bool stopping;
+    thrd_t thread;
+    mtx_t mutex;
+    cnd_t wake;
+    cnd_t done;
+} ir_loop_t;
+
+/**
+ * @name LoopCreate
+ * @authors Israfiel
+ * @brief Create a loop, starting its simulation thread if pipelined.
+ *
+ * @param loop - The loop to create.
+ * @param config - How to create it.
+ * @returns Whether the loop was created.
+ */
+bool Ir_LoopCreate(ir_loop_t *loop, const ir_loop_config_t *config);
+
+/**
+ * @name LoopDestroy
+ * @authors Israfiel
+ * @brief Destroy a loop, waiting for any ticks in flight.
+ *
+ * @param loop - The loop to destroy.
+ */
+void Ir_LoopDestroy(ir_loop_t *loop);
+
+/**
+ * @name LoopAdvance
+ * @authors Israfiel
+ * @brief Run the ticks due by now and say what the frame should render.
+ * Called once at the start of every frame. The first call runs no
+ * ticks.
+ *
+ * @param loop - The loop.
+ * @param now - The current monotonic time in nanoseconds.
+ * @param frame - Filled with what to render.
+ */
+void Ir_LoopAdvance(ir_loop_t *loop, uint64_t now, ir_loop_frame_t *frame);
+
+#endif // IRIDIUM_CORE_LOOP_H
@@ -0,0 +1,101 @@
+/**
+ * @file Random.h
+ * @authors Israfiel
+ * @brief Iridium's deterministic random number generator, a PCG32. Its
+ * output depends only on its seed and stream, so a replayed seed
+ * reproduces a session's randomness exactly on any platform.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_CORE_RANDOM_H
+#define IRIDIUM_CORE_RANDOM_H
+
+#include <stdint.h>
+
+/**
+ * @name ir_random_t
+ * @brief A random number generator's state.
+ */
+typedef struct ir_random
+{
+    uint64_t state;
+    uint64_t increment;
+} ir_random_t;
+
+/**
+ * @name RandomNext
+ * @authors Israfiel
+ * @brief Draw a uniformly distributed 32-bit number.
+ *
+ * @param random - The generator.
+ * @returns The number.
+ */
+static inline uint32_t Ir_RandomNext(ir_random_t *random)
+{
+    uint64_t state = random->state;
+    random->state = state * 6364136223846793005ull + random->increment;
+
+    uint32_t shifted = (uint32_t)(((state >> 18) ^ state) >> 27);
+    uint32_t rotation = (uint32_t)(state >> 59);
+    return (shifted >> rotation) | (shifted << ((32 - rotation) & 31));
+}
+
+/**
+ * @name RandomSeed
+ * @authors Israfiel
+ * @brief Seed a generator. Generators with the same seed but different
+ * streams produce independent sequences.
+ *
+ * @param random - The generator.
+ * @param seed - The seed.
+ * @param stream - The stream.
+ */
+static inline void Ir_RandomSeed(ir_random_t *random, uint64_t seed,
+                                 uint64_t stream)
+{
+    random->state = 0;
+    random->increment = (stream << 1) | 1;
+    (void)Ir_RandomNext(random);
+    random->state += seed;
+    (void)Ir_RandomNext(random);
+}
+
+/**
+ * @name RandomBelow
+ * @authors Israfiel
+ * @brief Draw a uniformly distributed number below a bound, without
+ * modulo bias.
+ *
+ * @param random - The generator.
+ * @param bound - The exclusive upper bound, nonzero.
+ * @returns The number.
+ */
+static inline uint32_t Ir_RandomBelow(ir_random_t *random, uint32_t bound)
+{
+    uint64_t product = (uint64_t)Ir_RandomNext(random) * bound;
+    if ((uint32_t)product < bound)
+    {
+        uint32_t threshold = (0u - bound) % bound;
+        while ((uint32_t)product < threshold)
+            product = (uint64_t)Ir_RandomNext(random) * bound;
+    }
+    return (uint32_t)(product >> 32);
+}
+
+/**
+ * @name RandomFloat
+ * @authors Israfiel
+ * @brief Draw a uniformly distributed float within [0, 1).
+ *
+ * @param random - The generator.
+ * @returns The number.
+ */
+static inline float Ir_RandomFloat(ir_random_t *random)
+{
+    return (float)(Ir_RandomNext(random) >> 8) * 0x1.0p-24f;
+}
+
+#endif // IRIDIUM_CORE_RANDOM_H
@@ -0,0 +1,149 @@
+/**
+ * @file Counters.c
+ * @authors Israfiel
+ * @brief The implementation of Iridium's hardware performance counters.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Counters.h"
+
+#include <string.h>
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#ifdef __linux__
+/**
+ * @name L1D_READ_MISSES
+ * @brief The cache event config for L1 data cache read misses.
+ */
+    #define L1D_READ_MISSES                                                 \
+        (PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |    \
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+/**
+ * @name ir_counter_events
+ * @brief The perf event type and config of each counter.
+ */
+static const struct
+{
+    uint32_t type;
+    uint64_t config;
+} ir_counter_events[IR_COUNTER_COUNT] = {
+    [IR_COUNTER_CYCLES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    [IR_COUNTER_INSTRUCTIONS] = {PERF_TYPE_HARDWARE,
+                                 PERF_COUNT_HW_INSTRUCTIONS},
+    [IR_COUNTER_L1D_MISSES] = {PERF_TYPE_HW_CACHE, L1D_READ_MISSES},
+    [IR_COUNTER_LLC_MISSES] = {PERF_TYPE_HARDWARE,
+                               PERF_COUNT_HW_CACHE_MISSES},
+    [IR_COUNTER_BRANCH_MISSES] = {PERF_TYPE_HARDWARE,
+                                  PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+/**
+ * @name OpenEvent
+ * @authors Israfiel
+ * @brief Open one counter on the calling thread.
+ *
+ * @param counter - The counter to open.
+ * @param leader - The group leader, or -1 to open a new group.
+ * @returns The counter's file descriptor, or -1.
+ */
+static int OpenEvent(ir_counter_t counter, int leader)
+{
+    struct perf_event_attr attributes = {
+        .type = ir_counter_events[counter].type,
+        .size = sizeof(struct perf_event_attr),
+        .config = ir_counter_events[counter].config,
+        .read_format = PERF_FORMAT_GROUP |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING,
+        .disabled = leader == -1,
+        .exclude_kernel = 1,
+        .exclude_hv = 1,
+    };
+    return (int)syscall(SYS_perf_event_open, &attributes, 0, -1, leader,
+                        0);
+}
+#endif
+
+bool Ir_CountersOpen(ir_counter_group_t *group)
+{
+    *group = (ir_counter_group_t){.leader = -1};
+#ifdef __linux__
+    for (ir_counter_t counter = 0; counter < IR_COUNTER_COUNT; ++counter)
+    {
+        int descriptor = OpenEvent(counter, group->leader);
+        if (descriptor == -1) continue;
+
+        if (group->leader == -1) group->leader = descriptor;
+        group->descriptors[group->count] = descriptor;
+        group->order[group->count++] = counter;
+        group->available |= 1u << counter;
+    }
+    if (group->leader == -1) return false;
+
+    ioctl(group->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Ir_CountersClose(ir_counter_group_t *group)
+{
+#ifdef __linux__
+    // Members go first; the leader owns the group.
+    for (uint32_t i = group->count; i > 0; --i)
+        close(group->descriptors[i - 1]);
+#endif
+    *group = (ir_counter_group_t){.leader = -1};
+}
+
+bool Ir_CountersRead(const ir_counter_group_t *group,
+                     ir_counter_values_t *values)
+{
+    memset(values, 0, sizeof(ir_counter_values_t));
+#ifdef __linux__
+    if (group->leader == -1) return false;
+
+    // nr, time_enabled, time_running, then one value per counter.
+    uint64_t buffer[3 + IR_COUNTER_COUNT];
+    ssize_t size = read(group->leader, buffer, sizeof(buffer));
+    if (size < (ssize_t)(3 * sizeof(uint64_t)) || buffer[0] > group->count)
+        return false;
+
+    double scale = 1.0;
+    if (buffer[2] != 0 && buffer[2] < buffer[1])
+        scale = (double)buffer[1] / (double)buffer[2];
+
+    for (uint64_t i = 0; i < buffer[0]; ++i)
+        values->values[group->order[i]] =
+            scale == 1.0 ? buffer[3 + i]
+                         : (uint64_t)((double)buffer[3 + i] * scale);
+    return true;
+#else
+    (void)group;
+    return false;
+#endif
+}
+
+const char *Ir_CounterName(ir_counter_t counter)
+{
+    static const char *names[IR_COUNTER_COUNT] = {
+        [IR_COUNTER_CYCLES] = "cycles",
+        [IR_COUNTER_INSTRUCTIONS] = "instructions",
+        [IR_COUNTER_L1D_MISSES] = "l1d_misses",
+        [IR_COUNTER_LLC_MISSES] = "llc_misses",
+        [IR_COUNTER_BRANCH_MISSES] = "branch_misses",
+    };
+    return counter < IR_COUNTER_COUNT ? names[counter] : "unknown";
+}
@@ -0,0 +1,122 @@
+/**
+ * @file Counters.h
+ * @authors Israfiel
+ * @brief Hardware performance counters. On Linux, a group of counters
+ * is opened per thread with perf_event_open and read together, so
+ * cycles, instructions and misses are always from the same interval.
+ * Elsewhere, or where the kernel refuses, no counters are available.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_DEBUG_COUNTERS_H
+#define IRIDIUM_DEBUG_COUNTERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name ir_counter_t
+ * @brief A hardware event that can be counted.
+ */
+typedef enum ir_counter
+{
+    IR_COUNTER_CYCLES,
+    IR_COUNTER_INSTRUCTIONS,
+    IR_COUNTER_L1D_MISSES,
+    IR_COUNTER_LLC_MISSES,
+    IR_COUNTER_BRANCH_MISSES,
+    IR_COUNTER_COUNT
+} ir_counter_t;
+
+/**
+ * @name ir_counter_values_t
+ * @brief A reading of every counter, indexed by ir_counter_t. Counters
+ * that are unavailable read as zero.
+ */
+typedef struct ir_counter_values
+{
+    uint64_t values[IR_COUNTER_COUNT];
+} ir_counter_values_t;
+
+/**
+ * @name ir_counter_group_t
+ * @brief A set of counters opened on one thread.
+ */
+typedef struct ir_counter_group
+{
+    /**
+     * @name leader
+     * @brief The group leader's file descriptor, or -1 if closed.
+     */
+    int leader;
+    /**
+     * @name descriptors
+     * @brief Every open counter's file descriptor, in group order.
+     */
+    int descriptors[IR_COUNTER_COUNT];
+    /**
+     * @name order
+     * @brief The counter read at each position of the group.
+     */
+    ir_counter_t order[IR_COUNTER_COUNT];
+    /**
+     * @name count
+     * @brief The number of open counters.
+     */
+    uint32_t count;
+    /**
+     * @name available
+     * @brief A mask of the open counters, one bit per ir_counter_t.
+     */
+    uint32_t available;
+} ir_counter_group_t;
+
+/**
+ * @name CountersOpen
+ * @authors Israfiel
+ * @brief Open and start every supported counter for the calling
+ * thread. Only user-space events are counted. Counters the hardware
+ * lacks are left out of the group.
+ *
+ * @param group - The group to open.
+ * @returns Whether any counters could be opened.
+ */
+bool Ir_CountersOpen(ir_counter_group_t *group);
+
+/**
+ * @name CountersClose
+ * @authors Israfiel
+ * @brief Close a group's counters. Closing a closed group does nothing.
+ *
+ * @param group - The group to close.
+ */
+void Ir_CountersClose(ir_counter_group_t *group);
+
+/**
+ * @name CountersRead
+ * @authors Israfiel
+ * @brief Read a group's running totals. If the kernel had to multiplex
+ * the counters, the totals are scaled to estimate the full interval.
+ * Must be called on the thread that opened the group.
+ *
+ * @param group - The group to read.
+ * @param values - Filled with the totals.
+ * @returns Whether the group could be read.
+ */
+bool Ir_CountersRead(const ir_counter_group_t *group,
+                     ir_counter_values_t *values);
+
+/**
+ * @name CounterName
+ * @authors Israfiel
+ * @brief Get a counter's name, as used in traces and benchmark output.
+ *
+ * @param counter - The counter.
+ * @returns The counter's name.
+ */
+const char *Ir_CounterName(ir_counter_t counter);
+
+#endif // IRIDIUM_DEBUG_COUNTERS_H
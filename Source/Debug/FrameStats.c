@@ -0,0 +1,272 @@
+/**
+ * @file FrameStats.c
+ * @authors Israfiel
+ * @brief The implementation of Iridium's frame-time statistics.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "FrameStats.h"
+#include "Logger.h"
+#include "Profiler.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @name DEFAULT_WINDOW
+ * @brief The window size used when the config leaves it zero.
+ */
+#define DEFAULT_WINDOW 600
+
+/**
+ * @name MEDIAN_REFRESH
+ * @brief How many frames pass between refreshes of the cached median.
+ */
+#define MEDIAN_REFRESH 32
+
+/**
+ * @name Select
+ * @authors Israfiel
+ * @brief Partially order an array so the k-th smallest value sits at
+ * index k (Hoare's quickselect).
+ *
+ * @param values - The values to order.
+ * @param count - The number of values.
+ * @param k - The rank to select.
+ * @returns The k-th smallest value.
+ */
+static double Select(double *values, uint32_t count, uint32_t k)
+{
+    int64_t low = 0, high = (int64_t)count - 1;
+    while (low < high)
+    {
+        double pivot = values[k];
+        int64_t i = low, j = high;
+        do {
+            while (values[i] < pivot) i++;
+            while (pivot < values[j]) j--;
+            if (i <= j)
+            {
+                double swap = values[i];
+                values[i++] = values[j];
+                values[j--] = swap;
+            }
+        } while (i <= j);
+
+        if (j < (int64_t)k) low = i;
+        if ((int64_t)k < i) high = j;
+    }
+    return values[k];
+}
+
+/**
+ * @name Percentile
+ * @authors Israfiel
+ * @brief Select a nearest-rank percentile.
+ *
+ * @param values - The values, reordered in place.
+ * @param count - The number of values, at least one.
+ * @param fraction - The percentile as a fraction of one.
+ * @returns The percentile's value.
+ */
+static double Percentile(double *values, uint32_t count, double fraction)
+{
+    uint32_t rank = (uint32_t)ceil(fraction * count);
+    return Select(values, count, rank > 0 ? rank - 1 : 0);
+}
+
+/**
+ * @name FrameTime
+ * @authors Israfiel
+ * @brief The time a frame is judged by: its present interval where
+ * measured, otherwise its CPU time.
+ *
+ * @param timing - The frame's timings.
+ * @returns The frame's time in milliseconds.
+ */
+static double FrameTime(const ir_frame_timing_t *timing)
+{
+    return timing->present > 0.0 ? timing->present : timing->cpu;
+}
+
+/**
+ * @name Metric
+ * @authors Israfiel
+ * @brief Pull one timing out of a frame.
+ *
+ * @param timing - The frame's timings.
+ * @param metric - The timing to pull.
+ * @returns The timing in milliseconds.
+ */
+static double Metric(const ir_frame_timing_t *timing,
+                     ir_frame_metric_t metric)
+{
+    switch (metric)
+    {
+        case IR_FRAME_METRIC_CPU: return timing->cpu;
+        case IR_FRAME_METRIC_GPU: return timing->gpu;
+        default:                  return timing->present;
+    }
+}
+
+#ifdef IRIDIUM_PROFILE
+/**
+ * @name hitch_capture_t
+ * @brief A hitching frame handed to the thread that captures it.
+ */
+typedef struct hitch_capture
+{
+    uint64_t begin_ticks;
+    uint64_t end_ticks;
+    char path[512];
+} hitch_capture_t;
+
+/**
+ * @name WriteCapture
+ * @authors Israfiel
+ * @brief Copy a hitching frame's profiler events and write them to disk.
+ * Runs on its own detached thread, so neither the copy nor the write
+ * lands on a frame. The rings hold far more than a frame's events, so
+ * the hitch is copied long before later frames overwrite it.
+ *
+ * @param argument - The hitch capture.
+ * @returns Always zero.
+ */
+static int WriteCapture(void *argument)
+{
+    hitch_capture_t *hitch = argument;
+    ir_profile_capture_t capture;
+    if (!Ir_ProfilerCapture(&capture, hitch->begin_ticks,
+                            hitch->end_ticks))
+        IR_LOG_ERROR("Ran out of memory capturing hitch '%s'.",
+                     hitch->path);
+    else
+    {
+        if (!Ir_ProfilerWriteChromeTrace(&capture, hitch->path))
+            IR_LOG_ERROR("Failed to write hitch capture '%s'.",
+                         hitch->path);
+        Ir_ProfilerCaptureDestroy(&capture);
+    }
+    free(hitch);
+    return 0;
+}
+
+/**
+ * @name CaptureHitch
+ * @authors Israfiel
+ * @brief Start copying a hitching frame's profiler events to disk.
+ *
+ * @param stats - The window the hitch was recorded in.
+ * @param timing - The hitching frame.
+ */
+static void CaptureHitch(ir_frame_stats_t *stats,
+                         const ir_frame_timing_t *timing)
+{
+    hitch_capture_t *hitch = malloc(sizeof(hitch_capture_t));
+    if (hitch == NULL) return;
+
+    hitch->begin_ticks = timing->begin_ticks;
+    hitch->end_ticks = timing->end_ticks;
+    snprintf(hitch->path, sizeof(hitch->path), "%s/Hitch%06llu.json",
+             stats->config.capture_directory,
+             (unsigned long long)stats->frame_count);
+
+    thrd_t thread;
+    if (thrd_create(&thread, WriteCapture, hitch) != thrd_success)
+    {
+        free(hitch);
+        return;
+    }
+    thrd_detach(thread);
+    stats->capture_count++;
+}
+#endif
+
+bool Ir_FrameStatsCreate(ir_frame_stats_t *stats,
+                         const ir_frame_stats_config_t *config)
+{
+    *stats = (ir_frame_stats_t){.config = *config};
+    if (stats->config.window == 0) stats->config.window = DEFAULT_WINDOW;
+
+    stats->frames =
+        calloc(stats->config.window, sizeof(ir_frame_timing_t));
+    stats->scratch = malloc(stats->config.window * sizeof(double));
+    if (stats->frames == NULL || stats->scratch == NULL)
+    {
+        Ir_FrameStatsDestroy(stats);
+        return false;
+    }
+    return true;
+}
+
+void Ir_FrameStatsDestroy(ir_frame_stats_t *stats)
+{
+    free(stats->frames);
+    free(stats->scratch);
+    *stats = (ir_frame_stats_t){0};
+}
+
+bool Ir_FrameStatsRecord(ir_frame_stats_t *stats,
+                         const ir_frame_timing_t *timing)
+{
+    double time = FrameTime(timing);
+    bool hitch =
+        (stats->config.hitch_milliseconds > 0.0 &&
+         time > stats->config.hitch_milliseconds) ||
+        (stats->config.hitch_ratio > 0.0 && stats->median > 0.0 &&
+         time > stats->config.hitch_ratio * stats->median);
+
+    stats->frames[stats->next] = *timing;
+    stats->next = (stats->next + 1) % stats->config.window;
+    if (stats->count < stats->config.window) stats->count++;
+    stats->frame_count++;
+
+    // The median moves slowly; there's no need to select it per frame.
+    if (stats->frame_count % MEDIAN_REFRESH == 0)
+    {
+        for (uint32_t i = 0; i < stats->count; ++i)
+            stats->scratch[i] = FrameTime(&stats->frames[i]);
+        stats->median = Percentile(stats->scratch, stats->count, 0.5);
+    }
+
+    if (!hitch) return false;
+    stats->hitch_count++;
+    IR_LOG_WARNING("Frame %llu hitched: %.2f ms against a %.2f ms median.",
+                   (unsigned long long)stats->frame_count, time,
+                   stats->median);
+
+#ifdef IRIDIUM_PROFILE
+    if (stats->config.capture_directory != NULL &&
+        stats->capture_count < stats->config.max_captures)
+        CaptureHitch(stats, timing);
+#endif
+    return true;
+}
+
+ir_frame_summary_t Ir_FrameStatsSummarize(ir_frame_stats_t *stats,
+                                          ir_frame_metric_t metric)
+{
+    ir_frame_summary_t summary = {0};
+    uint32_t count = 0;
+    double total = 0.0;
+    for (uint32_t i = 0; i < stats->count; ++i)
+    {
+        double value = Metric(&stats->frames[i], metric);
+        if (value <= 0.0) continue;
+
+        stats->scratch[count++] = value;
+        total += value;
+        if (value > summary.max) summary.max = value;
+    }
+    if (count == 0) return summary;
+
+    summary.mean = total / count;
+    summary.p50 = Percentile(stats->scratch, count, 0.50);
+    summary.p95 = Percentile(stats->scratch, count, 0.95);
+    summary.p99 = Percentile(stats->scratch, count, 0.99);
+    return summary;
+}
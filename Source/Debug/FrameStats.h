@@ -0,0 +1,217 @@
+/**
+ * @file FrameStats.h
+ * @authors Israfiel
+ * @brief Rolling frame-time statistics. Per-frame CPU, GPU and present
+ * timings are kept over a window of recent frames, from which
+ * percentiles are computed; frames far slower than their neighbours are
+ * flagged as hitches, and the profiler zones recorded during them are
+ * written to disk for later inspection.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_DEBUG_FRAMESTATS_H
+#define IRIDIUM_DEBUG_FRAMESTATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name ir_frame_timing_t
+ * @brief The timings of a single frame. Times are in milliseconds; a
+ * time of zero means it wasn't measured.
+ */
+typedef struct ir_frame_timing
+{
+    /**
+     * @name cpu
+     * @brief Time from the start of the frame to its submission.
+     */
+    double cpu;
+    /**
+     * @name gpu
+     * @brief Time the GPU spent on the frame's work.
+     */
+    double gpu;
+    /**
+     * @name present
+     * @brief Time since the previous frame was presented; this is the
+     * frame time the player actually sees.
+     */
+    double present;
+    /**
+     * @name begin_ticks
+     * @brief The clock tick the frame started at.
+     */
+    uint64_t begin_ticks;
+    /**
+     * @name end_ticks
+     * @brief The clock tick the frame ended at.
+     */
+    uint64_t end_ticks;
+} ir_frame_timing_t;
+
+/**
+ * @name ir_frame_metric_t
+ * @brief Which of a frame's timings to summarize.
+ */
+typedef enum ir_frame_metric
+{
+    IR_FRAME_METRIC_CPU,
+    IR_FRAME_METRIC_GPU,
+    IR_FRAME_METRIC_PRESENT
+} ir_frame_metric_t;
+
+/**
+ * @name ir_frame_summary_t
+ * @brief The distribution of a timing over the window, in milliseconds.
+ */
+typedef struct ir_frame_summary
+{
+    double mean;
+    double p50;
+    double p95;
+    double p99;
+    double max;
+} ir_frame_summary_t;
+
+/**
+ * @name ir_frame_stats_config_t
+ * @brief How frame statistics are gathered.
+ */
+typedef struct ir_frame_stats_config
+{
+    /**
+     * @name window
+     * @brief The number of recent frames kept. Zero selects 600.
+     */
+    uint32_t window;
+    /**
+     * @name hitch_milliseconds
+     * @brief The frame time above which a frame is always a hitch.
+     */
+    double hitch_milliseconds;
+    /**
+     * @name hitch_ratio
+     * @brief A frame is also a hitch when it takes this many times the
+     * window's median. Zero disables the relative check.
+     */
+    double hitch_ratio;
+    /**
+     * @name capture_directory
+     * @brief Where hitch captures are written, or NULL to not capture.
+     */
+    const char *capture_directory;
+    /**
+     * @name max_captures
+     * @brief The most captures written over the stats' lifetime.
+     */
+    uint32_t max_captures;
+} ir_frame_stats_config_t;
+
+/**
+ * @name ir_frame_stats_t
+ * @brief A window of recent frame timings.
+ */
+typedef struct ir_frame_stats
+{
+    /**
+     * @name config
+     * @brief How statistics are gathered.
+     */
+    ir_frame_stats_config_t config;
+    /**
+     * @name frames
+     * @brief A ring of the most recent frames.
+     */
+    ir_frame_timing_t *frames;
+    /**
+     * @name scratch
+     * @brief Working space for percentile selection.
+     */
+    double *scratch;
+    /**
+     * @name count
+     * @brief The number of frames in the ring.
+     */
+    uint32_t count;
+    /**
+     * @name next
+     * @brief The ring slot the next frame is written to.
+     */
+    uint32_t next;
+    /**
+     * @name frame_count
+     * @brief The number of frames ever recorded.
+     */
+    uint64_t frame_count;
+    /**
+     * @name hitch_count
+     * @brief The number of frames ever flagged as hitches.
+     */
+    uint64_t hitch_count;
+    /**
+     * @name capture_count
+     * @brief The number of hitch captures written.
+     */
+    uint32_t capture_count;
+    /**
+     * @name median
+     * @brief The cached median frame time the relative hitch check runs
+     * against, refreshed periodically.
+     */
+    double median;
+} ir_frame_stats_t;
+
+/**
+ * @name FrameStatsCreate
+ * @authors Israfiel
+ * @brief Prepare a frame-time window.
+ *
+ * @param stats - The stats to initialize.
+ * @param config - How statistics are gathered.
+ * @returns Whether the window could be allocated.
+ */
+bool Ir_FrameStatsCreate(ir_frame_stats_t *stats,
+                         const ir_frame_stats_config_t *config);
+
+/**
+ * @name FrameStatsDestroy
+ * @authors Israfiel
+ * @brief Free a frame-time window.
+ *
+ * @param stats - The stats to free.
+ */
+void Ir_FrameStatsDestroy(ir_frame_stats_t *stats);
+
+/**
+ * @name FrameStatsRecord
+ * @authors Israfiel
+ * @brief Add a finished frame to the window. If the frame is a hitch
+ * and captures are enabled, the profiler events within it are copied
+ * and written to disk on a background thread.
+ *
+ * @param stats - The window to add to.
+ * @param timing - The frame's timings.
+ * @returns Whether the frame was a hitch.
+ */
+bool Ir_FrameStatsRecord(ir_frame_stats_t *stats,
+                         const ir_frame_timing_t *timing);
+
+/**
+ * @name FrameStatsSummarize
+ * @authors Israfiel
+ * @brief Compute the distribution of one timing over the window.
+ * Frames where the timing wasn't measured are ignored.
+ *
+ * @param stats - The window to summarize.
+ * @param metric - The timing to summarize.
+ * @returns The timing's distribution; all zero if it was never
+ * measured.
+ */
+ir_frame_summary_t Ir_FrameStatsSummarize(ir_frame_stats_t *stats,
+                                          ir_frame_metric_t metric);
+
+#endif // IRIDIUM_DEBUG_FRAMESTATS_H
@@ -0,0 +1,1159 @@
+/**
+ * @file Logger.c
+ * @authors Israfiel
+ * @brief The implementation of Iridium's asynchronous logger.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Logger.h"
+
+#include <stdalign.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+/**
+ * @name DEFAULT_RING_SIZE
+ * @brief The size of a thread's ring when the config doesn't pick one.
+ */
+#define DEFAULT_RING_SIZE (64u * 1024u)
+
+/**
+ * @name MAX_SITES
+ * @brief The most call sites the logger can track. Sites beyond this
+ * are formatted synchronously.
+ */
+#define MAX_SITES 8192u
+
+/**
+ * @name SITE_ENTRY_FLAG
+ * @brief Set in the site field of a binary log entry that defines a
+ * call site rather than recording a message.
+ */
+#define SITE_ENTRY_FLAG 0x80000000u
+
+/**
+ * @name INVALID_FORMAT
+ * @brief The argument count of a site whose format string could not be
+ * parsed. Its format is printed verbatim.
+ */
+#define INVALID_FORMAT 0xFFu
+
+/**
+ * @name MAX_RECORD
+ * @brief The largest record a single call can produce.
+ */
+#define MAX_RECORD                                                          \
+    (sizeof(record_header_t) +                                             \
+     IR_LOG_MAX_ARGUMENTS * (sizeof(uint64_t) + IR_LOG_MAX_STRING + 8))
+
+/**
+ * @name MAX_LINE
+ * @brief The longest formatted line, prefix included.
+ */
+#define MAX_LINE 4096
+
+/**
+ * @name argument_kind_t
+ * @brief How an argument is stored in a record. Stored in the low bits
+ * of a site's argument bytes, with its length modifier in the high.
+ */
+typedef enum argument_kind
+{
+    ARGUMENT_SIGNED,
+    ARGUMENT_UNSIGNED,
+    ARGUMENT_DOUBLE,
+    ARGUMENT_STRING,
+    ARGUMENT_POINTER
+} argument_kind_t;
+
+/**
+ * @name argument_length_t
+ * @brief The C type an integer or floating argument was passed as.
+ */
+typedef enum argument_length
+{
+    LENGTH_NONE,
+    LENGTH_LONG,
+    LENGTH_LONG_LONG,
+    LENGTH_SIZE,
+    LENGTH_MAX,
+    LENGTH_PTRDIFF,
+    LENGTH_LONG_DOUBLE
+} argument_length_t;
+
+/**
+ * @name record_header_t
+ * @brief The start of every record, both in the rings and in binary
+ * log files. Arguments follow in 8-byte slots; strings are a length
+ * slot followed by their bytes, padded to 8.
+ */
+typedef struct record_header
+{
+    /**
+     * @name site
+     * @brief The ID of the call site, or zero for ring padding.
+     */
+    uint32_t site;
+    /**
+     * @name size
+     * @brief The size of the record in bytes, a multiple of 8.
+     */
+    uint32_t size;
+    /**
+     * @name timestamp
+     * @brief Wall-clock nanoseconds since the epoch.
+     */
+    uint64_t timestamp;
+    /**
+     * @name thread
+     * @brief The logger-assigned index of the producing thread.
+     */
+    uint32_t thread;
+    /**
+     * @name reserved
+     * @brief Padding, always zero.
+     */
+    uint32_t reserved;
+} record_header_t;
+
+/**
+ * @name ring_t
+ * @brief A single-producer, single-consumer byte ring owned by one
+ * logging thread and drained by the background thread.
+ */
+typedef struct ring
+{
+    /**
+     * @name head
+     * @brief Bytes ever written, advanced only by the producer.
+     */
+    alignas(64) _Atomic uint64_t head;
+    /**
+     * @name tail
+     * @brief Bytes ever consumed, advanced only by the consumer.
+     */
+    alignas(64) _Atomic uint64_t tail;
+    /**
+     * @name dropped
+     * @brief Records the producer discarded because the ring was full.
+     */
+    _Atomic uint64_t dropped;
+    /**
+     * @name owned
+     * @brief Whether a live thread currently produces into the ring.
+     */
+    _Atomic bool owned;
+    /**
+     * @name index
+     * @brief The thread index stamped into each record.
+     */
+    uint32_t index;
+    /**
+     * @name mask
+     * @brief The ring's size minus one.
+     */
+    uint64_t mask;
+    /**
+     * @name next
+     * @brief The next ring in the logger's list.
+     */
+    struct ring *next;
+    /**
+     * @name data
+     * @brief The ring's storage.
+     */
+    uint8_t *data;
+} ring_t;
+
+/**
+ * @name site_info_t
+ * @brief Everything needed to format a record, whether it came from a
+ * live site or from a binary log file.
+ */
+typedef struct site_info
+{
+    ir_log_level_t level;
+    uint32_t line;
+    const char *file;
+    const char *format;
+    uint8_t argument_count;
+    const uint8_t *arguments;
+} site_info_t;
+
+/**
+ * @name ir_logger
+ * @brief The logger's global state.
+ */
+static struct
+{
+    _Atomic bool running;
+    ir_log_config_t config;
+    FILE *file;
+    thrd_t thread;
+    mtx_t mutex;
+    cnd_t wake;
+    cnd_t flushed;
+    bool stop;
+    _Atomic bool wake_pending;
+    uint64_t flush_requested;
+    uint64_t flush_completed;
+    _Atomic(ring_t *) rings;
+    _Atomic uint32_t ring_count;
+    uint32_t site_count;
+    ir_log_site_t *_Atomic sites[MAX_SITES];
+    bool site_written[MAX_SITES];
+    tss_t ring_key;
+} ir_logger;
+
+/**
+ * @name ir_logger_once
+ * @brief Guards the creation of the logger's mutexes and TSS key.
+ */
+static once_flag ir_logger_once = ONCE_FLAG_INIT;
+
+/**
+ * @name ir_thread_ring
+ * @brief The ring owned by the calling thread, if any.
+ */
+static thread_local ring_t *ir_thread_ring;
+
+/**
+ * @name ir_level_names
+ * @brief The printed name of each log level.
+ */
+static const char *const ir_level_names[] = {"DEBUG", "INFO", "WARNING",
+                                             "ERROR", "FATAL"};
+
+/**
+ * @name ReleaseRing
+ * @authors Israfiel
+ * @brief TSS destructor handing a dead thread's ring back for reuse.
+ *
+ * @param ring - The thread's ring.
+ */
+static void ReleaseRing(void *ring)
+{
+    atomic_store_explicit(&((ring_t *)ring)->owned, false,
+                          memory_order_release);
+}
+
+/**
+ * @name InitializeOnce
+ * @authors Israfiel
+ * @brief Create the logger's synchronization primitives.
+ */
+static void InitializeOnce(void)
+{
+    mtx_init(&ir_logger.mutex, mtx_plain);
+    cnd_init(&ir_logger.wake);
+    cnd_init(&ir_logger.flushed);
+    tss_create(&ir_logger.ring_key, ReleaseRing);
+}
+
+/**
+ * @name Now
+ * @authors Israfiel
+ * @brief Get the wall-clock time in nanoseconds.
+ *
+ * @returns Nanoseconds since the epoch.
+ */
+static uint64_t Now(void)
+{
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+    return (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec;
+}
+
+/**
+ * @name ParseFormat
+ * @authors Israfiel
+ * @brief Work out how each argument of a format string is passed.
+ *
+ * @param format - The printf-style format string.
+ * @param arguments - Filled with one byte per argument.
+ * @returns The number of arguments, or INVALID_FORMAT.
+ */
+static uint8_t ParseFormat(const char *format, uint8_t *arguments)
+{
+    uint8_t count = 0;
+    for (const char *c = format; *c != '\0'; ++c)
+    {
+        if (*c != '%') continue;
+        if (*++c == '%') continue;
+
+        while (*c != '\0' && strchr("-+ #0'", *c) != NULL) c++;
+        for (int field = 0; field < 2; ++field)
+        {
+            if (*c == '*')
+            {
+                if (count == IR_LOG_MAX_ARGUMENTS) return INVALID_FORMAT;
+                arguments[count++] = ARGUMENT_SIGNED;
+                c++;
+            }
+            else while (*c >= '0' && *c <= '9') c++;
+            if (field == 0 && *c == '.') c++;
+            else break;
+        }
+
+        argument_length_t length = LENGTH_NONE;
+        switch (*c)
+        {
+            case 'h': c += c[1] == 'h' ? 2 : 1; break;
+            case 'l':
+                length = c[1] == 'l' ? LENGTH_LONG_LONG : LENGTH_LONG;
+                c += c[1] == 'l' ? 2 : 1;
+                break;
+            case 'z': length = LENGTH_SIZE, c++; break;
+            case 'j': length = LENGTH_MAX, c++; break;
+            case 't': length = LENGTH_PTRDIFF, c++; break;
+            case 'L': length = LENGTH_LONG_DOUBLE, c++; break;
+            default:  break;
+        }
+
+        argument_kind_t kind;
+        switch (*c)
+        {
+            case 'd':
+            case 'i':
+            case 'c': kind = ARGUMENT_SIGNED; break;
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X': kind = ARGUMENT_UNSIGNED; break;
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': kind = ARGUMENT_DOUBLE; break;
+            case 's': kind = ARGUMENT_STRING; break;
+            case 'p': kind = ARGUMENT_POINTER; break;
+            // %n, and anything unknown, is never safe to defer.
+            default: return INVALID_FORMAT;
+        }
+
+        if (count == IR_LOG_MAX_ARGUMENTS) return INVALID_FORMAT;
+        arguments[count++] = (uint8_t)(kind | (length << 4));
+    }
+    return count;
+}
+
+/**
+ * @name RegisterSite
+ * @authors Israfiel
+ * @brief Parse a call site's format string and hand it an ID, if that
+ * hasn't been done already.
+ *
+ * @param site - The call site.
+ * @returns The site's ID, or zero if the site table is full.
+ */
+static uint32_t RegisterSite(ir_log_site_t *site)
+{
+    uint32_t id = atomic_load_explicit(&site->id, memory_order_acquire);
+    if (id != 0) return id < MAX_SITES ? id : 0;
+
+    call_once(&ir_logger_once, InitializeOnce);
+    mtx_lock(&ir_logger.mutex);
+    id = atomic_load_explicit(&site->id, memory_order_relaxed);
+    if (id == 0)
+    {
+        site->argument_count = ParseFormat(site->format, site->arguments);
+        id = ++ir_logger.site_count;
+        if (id < MAX_SITES)
+            atomic_store_explicit(&ir_logger.sites[id], site,
+                                  memory_order_release);
+        atomic_store_explicit(&site->id, id, memory_order_release);
+    }
+    mtx_unlock(&ir_logger.mutex);
+    return id < MAX_SITES ? id : 0;
+}
+
+/**
+ * @name BuildRecord
+ * @authors Israfiel
+ * @brief Copy a call's arguments into a record.
+ *
+ * @param site - The call site, already registered.
+ * @param id - The site's ID.
+ * @param thread - The producing thread's index.
+ * @param list - The call's arguments.
+ * @param record - The buffer to fill, at least MAX_RECORD bytes.
+ * @returns The size of the record.
+ */
+static uint32_t BuildRecord(const ir_log_site_t *site, uint32_t id,
+                            uint32_t thread, va_list list, uint8_t *record)
+{
+    uint8_t *cursor = record + sizeof(record_header_t);
+    uint8_t count =
+        site->argument_count == INVALID_FORMAT ? 0 : site->argument_count;
+
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        argument_kind_t kind = site->arguments[i] & 0xF;
+        argument_length_t length = site->arguments[i] >> 4;
+        uint64_t value = 0;
+
+        if (kind == ARGUMENT_SIGNED || kind == ARGUMENT_UNSIGNED)
+        {
+            bool is_signed = kind == ARGUMENT_SIGNED;
+            switch (length)
+            {
+                case LENGTH_LONG:
+                    value = is_signed ? (uint64_t)va_arg(list, long)
+                                      : va_arg(list, unsigned long);
+                    break;
+                case LENGTH_LONG_LONG:
+                    value = is_signed ? (uint64_t)va_arg(list, long long)
+                                      : va_arg(list, unsigned long long);
+                    break;
+                case LENGTH_SIZE: value = va_arg(list, size_t); break;
+                case LENGTH_MAX:
+                    value = is_signed ? (uint64_t)va_arg(list, intmax_t)
+                                      : va_arg(list, uintmax_t);
+                    break;
+                case LENGTH_PTRDIFF:
+                    value = (uint64_t)va_arg(list, ptrdiff_t);
+                    break;
+                default:
+                    value = is_signed ? (uint64_t)va_arg(list, int)
+                                      : va_arg(list, unsigned int);
+                    break;
+            }
+        }
+        else if (kind == ARGUMENT_DOUBLE)
+        {
+            double real = length == LENGTH_LONG_DOUBLE
+                              ? (double)va_arg(list, long double)
+                              : va_arg(list, double);
+            memcpy(&value, &real, sizeof(double));
+        }
+        else if (kind == ARGUMENT_POINTER)
+            value = (uintptr_t)va_arg(list, void *);
+        else
+        {
+            const char *string = va_arg(list, const char *);
+            if (string == NULL) string = "(null)";
+            size_t size = strnlen(string, IR_LOG_MAX_STRING);
+
+            value = size;
+            memcpy(cursor, &value, sizeof(uint64_t));
+            memcpy(cursor + sizeof(uint64_t), string, size);
+            cursor += sizeof(uint64_t) + ((size + 7) & ~(size_t)7);
+            continue;
+        }
+
+        memcpy(cursor, &value, sizeof(uint64_t));
+        cursor += sizeof(uint64_t);
+    }
+
+    record_header_t header = {
+        .site = id,
+        .size = (uint32_t)(cursor - record),
+        .timestamp = Now(),
+        .thread = thread,
+    };
+    memcpy(record, &header, sizeof(header));
+    return header.size;
+}
+
+/**
+ * @name FormatMessage
+ * @authors Israfiel
+ * @brief Format a record's arguments against its site's format string.
+ *
+ * @param site - The record's site.
+ * @param arguments - The record's argument slots.
+ * @param end - The end of the record.
+ * @param output - The buffer to format into.
+ * @param capacity - The size of the output buffer.
+ * @returns The number of characters written.
+ */
+static size_t FormatMessage(const site_info_t *site,
+                            const uint8_t *arguments, const uint8_t *end,
+                            char *output, size_t capacity)
+{
+    if (site->argument_count == INVALID_FORMAT)
+        return (size_t)snprintf(output, capacity, "%s", site->format);
+
+    size_t written = 0;
+    uint8_t argument = 0;
+    for (const char *c = site->format; *c != '\0' && written < capacity;)
+    {
+        if (*c != '%' || c[1] == '%')
+        {
+            output[written++] = *c;
+            c += *c == '%' ? 2 : 1;
+            continue;
+        }
+
+        // Rebuild the specifier with '*' fields resolved and any length
+        // modifier replaced by the type the value was stored as.
+        char specifier[64] = "%";
+        size_t length = 1;
+        for (c++; *c != '\0' && strchr("diouxXcsfFeEgGaAp", *c) == NULL;
+             ++c)
+        {
+            if (strchr("hlzjtL", *c) != NULL) continue;
+            if (*c == '*' && arguments + sizeof(uint64_t) <= end)
+            {
+                int64_t field;
+                memcpy(&field, arguments, sizeof(int64_t));
+                arguments += sizeof(uint64_t), argument++;
+                length += (size_t)snprintf(specifier + length,
+                                           sizeof(specifier) - length,
+                                           "%d", (int)field);
+            }
+            else if (length < sizeof(specifier) - 4)
+                specifier[length++] = *c;
+        }
+        if (*c == '\0' || arguments + sizeof(uint64_t) > end) break;
+
+        argument_kind_t kind = site->arguments[argument++] & 0xF;
+        if (kind == ARGUMENT_SIGNED || kind == ARGUMENT_UNSIGNED)
+        {
+            if (*c != 'c') specifier[length++] = 'l', specifier[length++] = 'l';
+        }
+        specifier[length++] = *c++;
+        specifier[length] = '\0';
+
+        uint64_t value;
+        memcpy(&value, arguments, sizeof(uint64_t));
+        arguments += sizeof(uint64_t);
+
+        size_t remaining = capacity - written;
+        int result;
+        switch (kind)
+        {
+            case ARGUMENT_SIGNED:
+                result = specifier[length - 1] == 'c'
+                             ? snprintf(output + written, remaining,
+                                        specifier, (int)value)
+                             : snprintf(output + written, remaining,
+                                        specifier, (long long)value);
+                break;
+            case ARGUMENT_UNSIGNED:
+                result = snprintf(output + written, remaining, specifier,
+                                  (unsigned long long)value);
+                break;
+            case ARGUMENT_DOUBLE:
+            {
+                double real;
+                memcpy(&real, &value, sizeof(double));
+                result = snprintf(output + written, remaining, specifier,
+                                  real);
+                break;
+            }
+            case ARGUMENT_POINTER:
+                result = snprintf(output + written, remaining, specifier,
+                                  (void *)(uintptr_t)value);
+                break;
+            default:
+            {
+                char string[IR_LOG_MAX_STRING + 1];
+                if (value > IR_LOG_MAX_STRING) value = IR_LOG_MAX_STRING;
+                if (value > (uint64_t)(end - arguments))
+                    value = (uint64_t)(end - arguments);
+                memcpy(string, arguments, value);
+                string[value] = '\0';
+                arguments += (value + 7) & ~(uint64_t)7;
+                result = snprintf(output + written, remaining, specifier,
+                                  string);
+                break;
+            }
+        }
+        if (result > 0) written += (size_t)result;
+    }
+
+    if (written >= capacity) written = capacity - 1;
+    output[written] = '\0';
+    return written;
+}
+
+/**
+ * @name FormatLine
+ * @authors Israfiel
+ * @brief Format a full log line, prefix and trailing newline included.
+ *
+ * @param site - The record's site.
+ * @param record - The record.
+ * @param output - The buffer to format into, MAX_LINE bytes.
+ * @returns The length of the line.
+ */
+static size_t FormatLine(const site_info_t *site, const uint8_t *record,
+                         char *output)
+{
+    record_header_t header;
+    memcpy(&header, record, sizeof(header));
+
+    time_t seconds = (time_t)(header.timestamp / 1000000000u);
+    struct tm calendar;
+    localtime_r(&seconds, &calendar);
+
+    const char *file = strrchr(site->file, '/');
+    file = file != NULL ? file + 1 : site->file;
+
+    size_t length = strftime(output, MAX_LINE, "[%F %T", &calendar);
+    length += (size_t)snprintf(
+        output + length, MAX_LINE - length, ".%06u] [%s] [T%u] %s:%u: ",
+        (unsigned)(header.timestamp % 1000000000u / 1000u),
+        ir_level_names[site->level], header.thread, file, site->line);
+    if (length > MAX_LINE - 2) length = MAX_LINE - 2;
+
+    length += FormatMessage(site, record + sizeof(record_header_t),
+                            record + header.size, output + length,
+                            MAX_LINE - length - 1);
+    output[length++] = '\n';
+    return length;
+}
+
+/**
+ * @name SiteInfo
+ * @authors Israfiel
+ * @brief Describe a live call site for formatting.
+ *
+ * @param site - The call site.
+ * @returns The site's formatting information.
+ */
+static site_info_t SiteInfo(const ir_log_site_t *site)
+{
+    return (site_info_t){site->level,          site->line,
+                         site->file,           site->format,
+                         site->argument_count, site->arguments};
+}
+
+/**
+ * @name WriteSiteEntry
+ * @authors Israfiel
+ * @brief Define a call site within the binary log file.
+ *
+ * @param id - The site's ID.
+ * @param site - The call site.
+ */
+static void WriteSiteEntry(uint32_t id, const ir_log_site_t *site)
+{
+    uint32_t file_length = (uint32_t)strlen(site->file);
+    uint32_t format_length = (uint32_t)strlen(site->format);
+    uint32_t size = 6 * sizeof(uint32_t) + file_length + format_length;
+    uint32_t padded = (size + 7) & ~7u;
+
+    uint32_t fields[6] = {id | SITE_ENTRY_FLAG, padded,
+                          (uint32_t)site->level, site->line,
+                          file_length, format_length};
+    static const uint8_t padding[8] = {0};
+
+    fwrite(fields, sizeof(fields), 1, ir_logger.file);
+    fwrite(site->file, 1, file_length, ir_logger.file);
+    fwrite(site->format, 1, format_length, ir_logger.file);
+    fwrite(padding, 1, padded - size, ir_logger.file);
+}
+
+/**
+ * @name EmitRecord
+ * @authors Israfiel
+ * @brief Write a record to every sink that wants it.
+ *
+ * @param record - The record, as stored in a ring.
+ */
+static void EmitRecord(const uint8_t *record)
+{
+    record_header_t header;
+    memcpy(&header, record, sizeof(header));
+
+    const ir_log_site_t *site = atomic_load_explicit(
+        &ir_logger.sites[header.site], memory_order_acquire);
+    site_info_t info = SiteInfo(site);
+
+    bool to_stderr = site->level >= ir_logger.config.stderr_level;
+    bool to_file =
+        ir_logger.file != NULL && site->level >= ir_logger.config.file_level;
+
+    if (to_file && ir_logger.config.binary)
+    {
+        if (!ir_logger.site_written[header.site])
+        {
+            WriteSiteEntry(header.site, site);
+            ir_logger.site_written[header.site] = true;
+        }
+        fwrite(record, 1, header.size, ir_logger.file);
+        to_file = false;
+    }
+    if (!to_stderr && !to_file) return;
+
+    char line[MAX_LINE];
+    size_t length = FormatLine(&info, record, line);
+    if (to_stderr) fwrite(line, 1, length, stderr);
+    if (to_file) fwrite(line, 1, length, ir_logger.file);
+}
+
+/**
+ * @name NextRecord
+ * @authors Israfiel
+ * @brief Skip any padding at a ring's read position.
+ *
+ * @param ring - The ring to read.
+ * @param tail - The read position, advanced past padding.
+ * @param head - The producer's position when the drain began.
+ * @returns The next record, or NULL if the ring is empty.
+ */
+static const uint8_t *NextRecord(ring_t *ring, uint64_t *tail,
+                                 uint64_t head)
+{
+    while (*tail != head)
+    {
+        const uint8_t *record = ring->data + (*tail & ring->mask);
+        record_header_t header;
+        memcpy(&header, record, 2 * sizeof(uint32_t));
+        if (header.site != 0) return record;
+        *tail += header.size;
+    }
+    return NULL;
+}
+
+/**
+ * @name DrainRings
+ * @authors Israfiel
+ * @brief Emit every record pushed before the call, merged across all
+ * threads in timestamp order.
+ */
+static void DrainRings(void)
+{
+    enum { MAX_MERGE = 64 };
+    ring_t *rings[MAX_MERGE];
+    uint64_t heads[MAX_MERGE], tails[MAX_MERGE];
+
+    ring_t *ring = atomic_load_explicit(&ir_logger.rings,
+                                        memory_order_acquire);
+    while (ring != NULL)
+    {
+        // Merge in batches of MAX_MERGE threads; any engine with more
+        // logging threads than that loses strict cross-batch ordering.
+        size_t count = 0;
+        for (; ring != NULL && count < MAX_MERGE; ring = ring->next)
+        {
+            rings[count] = ring;
+            heads[count] =
+                atomic_load_explicit(&ring->head, memory_order_acquire);
+            tails[count] =
+                atomic_load_explicit(&ring->tail, memory_order_relaxed);
+            count++;
+        }
+
+        for (;;)
+        {
+            const uint8_t *oldest = NULL;
+            size_t oldest_index = 0;
+            uint64_t oldest_time = UINT64_MAX;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const uint8_t *record =
+                    NextRecord(rings[i], &tails[i], heads[i]);
+                if (record == NULL) continue;
+
+                uint64_t timestamp;
+                memcpy(&timestamp,
+                       record + offsetof(record_header_t, timestamp),
+                       sizeof(uint64_t));
+                if (timestamp < oldest_time)
+                    oldest = record, oldest_index = i,
+                    oldest_time = timestamp;
+            }
+            if (oldest == NULL) break;
+
+            EmitRecord(oldest);
+            uint32_t size;
+            memcpy(&size, oldest + offsetof(record_header_t, size),
+                   sizeof(uint32_t));
+            tails[oldest_index] += size;
+            atomic_store_explicit(&rings[oldest_index]->tail,
+                                  tails[oldest_index],
+                                  memory_order_release);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            atomic_store_explicit(&rings[i]->tail, tails[i],
+                                  memory_order_release);
+            uint64_t dropped = atomic_exchange_explicit(
+                &rings[i]->dropped, 0, memory_order_relaxed);
+            if (dropped != 0)
+                fprintf(stderr, "[Logger] Thread %u dropped %llu records.\n",
+                        rings[i]->index, (unsigned long long)dropped);
+        }
+    }
+
+    if (ir_logger.file != NULL) fflush(ir_logger.file);
+}
+
+/**
+ * @name DrainThread
+ * @authors Israfiel
+ * @brief The logger's background thread.
+ *
+ * @param argument - Unused.
+ * @returns Always zero.
+ */
+static int DrainThread(void *argument)
+{
+    (void)argument;
+
+    mtx_lock(&ir_logger.mutex);
+    for (;;)
+    {
+        uint64_t requested = ir_logger.flush_requested;
+        bool stop = ir_logger.stop;
+        mtx_unlock(&ir_logger.mutex);
+
+        atomic_store_explicit(&ir_logger.wake_pending, false,
+                              memory_order_relaxed);
+        DrainRings();
+
+        mtx_lock(&ir_logger.mutex);
+        ir_logger.flush_completed = requested;
+        cnd_broadcast(&ir_logger.flushed);
+        if (stop) break;
+
+        if (ir_logger.flush_requested == requested && !ir_logger.stop)
+        {
+            struct timespec deadline;
+            timespec_get(&deadline, TIME_UTC);
+            deadline.tv_nsec += 2000000;
+            if (deadline.tv_nsec >= 1000000000)
+                deadline.tv_sec++, deadline.tv_nsec -= 1000000000;
+            cnd_timedwait(&ir_logger.wake, &ir_logger.mutex, &deadline);
+        }
+    }
+    mtx_unlock(&ir_logger.mutex);
+    return 0;
+}
+
+/**
+ * @name AcquireRing
+ * @authors Israfiel
+ * @brief Get the calling thread's ring, claiming an abandoned ring or
+ * creating a new one on the thread's first log.
+ *
+ * @returns The thread's ring, or NULL if one could not be allocated.
+ */
+static ring_t *AcquireRing(void)
+{
+    if (ir_thread_ring != NULL) return ir_thread_ring;
+
+    ring_t *ring =
+        atomic_load_explicit(&ir_logger.rings, memory_order_acquire);
+    for (; ring != NULL; ring = ring->next)
+    {
+        bool expected = false;
+        if (atomic_compare_exchange_strong_explicit(
+                &ring->owned, &expected, true, memory_order_acq_rel,
+                memory_order_relaxed))
+            break;
+    }
+
+    if (ring == NULL)
+    {
+        uint32_t size = ir_logger.config.ring_size;
+        ring = aligned_alloc(alignof(ring_t), sizeof(ring_t));
+        uint8_t *data = malloc(size);
+        if (ring == NULL || data == NULL)
+        {
+            free(ring);
+            free(data);
+            return NULL;
+        }
+
+        *ring = (ring_t){.mask = size - 1, .data = data};
+        atomic_init(&ring->owned, true);
+        ring->index = atomic_fetch_add_explicit(&ir_logger.ring_count, 1,
+                                                memory_order_relaxed);
+        ring->next =
+            atomic_load_explicit(&ir_logger.rings, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(
+            &ir_logger.rings, &ring->next, ring, memory_order_release,
+            memory_order_relaxed));
+    }
+
+    tss_set(ir_logger.ring_key, ring);
+    ir_thread_ring = ring;
+    return ring;
+}
+
+/**
+ * @name PushRecord
+ * @authors Israfiel
+ * @brief Copy a record into a ring.
+ *
+ * @param ring - The calling thread's ring.
+ * @param record - The record.
+ * @param size - The record's size.
+ * @returns Whether there was room for the record.
+ */
+static bool PushRecord(ring_t *ring, const uint8_t *record, uint32_t size)
+{
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    uint64_t capacity = ring->mask + 1;
+    uint64_t offset = head & ring->mask;
+    uint64_t contiguous = capacity - offset;
+    uint64_t needed = size + (contiguous < size ? contiguous : 0);
+    if (capacity - (head - tail) < needed) return false;
+
+    if (contiguous < size)
+    {
+        // Records never wrap; pad out the end of the ring instead.
+        uint32_t padding[2] = {0, (uint32_t)contiguous};
+        memcpy(ring->data + offset, padding, sizeof(padding));
+        head += contiguous;
+        offset = 0;
+    }
+
+    memcpy(ring->data + offset, record, size);
+    atomic_store_explicit(&ring->head, head + size, memory_order_release);
+
+    // Past half full, don't wait out the drain's sleep; a burst would
+    // otherwise overrun the ring before it next wakes.
+    if ((head + size - tail) * 2 > capacity &&
+        !atomic_exchange_explicit(&ir_logger.wake_pending, true,
+                                  memory_order_relaxed))
+        cnd_signal(&ir_logger.wake);
+    return true;
+}
+
+bool Ir_LogStart(const ir_log_config_t *config)
+{
+    call_once(&ir_logger_once, InitializeOnce);
+    if (atomic_load(&ir_logger.running)) return false;
+
+    ir_logger.config = *config;
+    uint32_t size = config->ring_size ? config->ring_size : DEFAULT_RING_SIZE;
+    if ((size & (size - 1)) != 0 || size < 2 * MAX_RECORD) return false;
+    ir_logger.config.ring_size = size;
+
+    ir_logger.file = NULL;
+    if (config->path != NULL)
+    {
+        ir_logger.file = fopen(config->path, config->binary ? "wb" : "w");
+        if (ir_logger.file == NULL) return false;
+        if (config->binary)
+        {
+            uint32_t header[2] = {IR_LOG_FILE_MAGIC, IR_LOG_FILE_VERSION};
+            fwrite(header, sizeof(header), 1, ir_logger.file);
+        }
+    }
+    memset(ir_logger.site_written, 0, sizeof(ir_logger.site_written));
+
+    // Rings left over from a previous run may be sized differently.
+    for (ring_t *ring = atomic_load(&ir_logger.rings); ring != NULL;
+         ring = ring->next)
+    {
+        if (ring->mask + 1 == size) continue;
+        uint8_t *data = realloc(ring->data, size);
+        if (data == NULL)
+        {
+            if (ir_logger.file != NULL) fclose(ir_logger.file);
+            ir_logger.file = NULL;
+            return false;
+        }
+        ring->data = data;
+        ring->mask = size - 1;
+        atomic_store(&ring->head, 0);
+        atomic_store(&ring->tail, 0);
+    }
+
+    ir_logger.stop = false;
+    if (thrd_create(&ir_logger.thread, DrainThread, NULL) != thrd_success)
+    {
+        if (ir_logger.file != NULL) fclose(ir_logger.file);
+        ir_logger.file = NULL;
+        return false;
+    }
+    atomic_store(&ir_logger.running, true);
+    return true;
+}
+
+void Ir_LogStop(void)
+{
+    if (!atomic_exchange(&ir_logger.running, false)) return;
+
+    mtx_lock(&ir_logger.mutex);
+    ir_logger.stop = true;
+    cnd_signal(&ir_logger.wake);
+    mtx_unlock(&ir_logger.mutex);
+    thrd_join(ir_logger.thread, NULL);
+
+    if (ir_logger.file != NULL) fclose(ir_logger.file);
+    ir_logger.file = NULL;
+}
+
+void Ir_LogFlush(void)
+{
+    if (!atomic_load(&ir_logger.running)) return;
+
+    mtx_lock(&ir_logger.mutex);
+    uint64_t request = ++ir_logger.flush_requested;
+    cnd_signal(&ir_logger.wake);
+    while (ir_logger.flush_completed < request && !ir_logger.stop)
+        cnd_wait(&ir_logger.flushed, &ir_logger.mutex);
+    mtx_unlock(&ir_logger.mutex);
+}
+
+void Ir_LogWrite(ir_log_site_t *site, ...)
+{
+    uint32_t id = RegisterSite(site);
+    ring_t *ring = NULL;
+    if (id != 0 && atomic_load_explicit(&ir_logger.running,
+                                        memory_order_acquire))
+        ring = AcquireRing();
+
+    uint8_t record[MAX_RECORD];
+    va_list list;
+    va_start(list, site);
+    uint32_t size =
+        BuildRecord(site, id, ring != NULL ? ring->index : 0, list, record);
+    va_end(list);
+
+    if (ring != NULL)
+    {
+        if (PushRecord(ring, record, size)) return;
+        if (site->level < IR_LOG_LEVEL_ERROR)
+        {
+            atomic_fetch_add_explicit(&ring->dropped, 1,
+                                      memory_order_relaxed);
+            return;
+        }
+
+        // Errors are worth a stall; wait for the drain to make room.
+        Ir_LogFlush();
+        if (PushRecord(ring, record, size)) return;
+    }
+
+    site_info_t info = SiteInfo(site);
+    char line[MAX_LINE];
+    size_t length = FormatLine(&info, record, line);
+    fwrite(line, 1, length, stderr);
+}
+
+void Ir_LogAbort(void)
+{
+    Ir_LogFlush();
+    fflush(stderr);
+    abort();
+}
+
+bool Ir_LogDecode(const char *path, FILE *output)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return false;
+
+    uint32_t header[2];
+    if (fread(header, sizeof(header), 1, file) != 1 ||
+        header[0] != IR_LOG_FILE_MAGIC || header[1] != IR_LOG_FILE_VERSION)
+    {
+        fclose(file);
+        return false;
+    }
+
+    typedef struct decoded_site
+    {
+        site_info_t info;
+        char *strings;
+        uint8_t arguments[IR_LOG_MAX_ARGUMENTS];
+    } decoded_site_t;
+    decoded_site_t *sites = calloc(MAX_SITES, sizeof(decoded_site_t));
+    uint8_t *entry = malloc(MAX_RECORD);
+    bool success = sites != NULL && entry != NULL;
+
+    while (success)
+    {
+        uint32_t fields[2];
+        if (fread(fields, sizeof(fields), 1, file) != 1) break;
+        uint32_t id = fields[0] & ~SITE_ENTRY_FLAG, size = fields[1];
+        if (id == 0 || id >= MAX_SITES || size < sizeof(fields) ||
+            size > MAX_RECORD + 2 * MAX_LINE || size % 8 != 0)
+        {
+            success = false;
+            break;
+        }
+
+        uint8_t *body = size <= MAX_RECORD ? entry : malloc(size);
+        if (body == NULL)
+        {
+            success = false;
+            break;
+        }
+
+        memcpy(body, fields, sizeof(fields));
+        if (fread(body + sizeof(fields), 1, size - sizeof(fields), file) !=
+                size - sizeof(fields))
+        {
+            if (body != entry) free(body);
+            success = false;
+            break;
+        }
+
+        if (fields[0] & SITE_ENTRY_FLAG)
+        {
+            uint32_t site_fields[6];
+            memcpy(site_fields, body, sizeof(site_fields));
+            decoded_site_t *site = &sites[id];
+            uint32_t file_length = site_fields[4];
+            uint32_t format_length = site_fields[5];
+            if (site_fields[2] > IR_LOG_LEVEL_FATAL ||
+                sizeof(site_fields) + file_length + format_length > size)
+                success = false;
+            else
+            {
+                free(site->strings);
+                site->strings = malloc(file_length + format_length + 2);
+                if (site->strings == NULL) success = false;
+            }
+
+            if (success)
+            {
+                char *strings = site->strings;
+                memcpy(strings, body + sizeof(site_fields), file_length);
+                strings[file_length] = '\0';
+                memcpy(strings + file_length + 1,
+                       body + sizeof(site_fields) + file_length,
+                       format_length);
+                strings[file_length + 1 + format_length] = '\0';
+
+                site->info = (site_info_t){
+                    .level = site_fields[2],
+                    .line = site_fields[3],
+                    .file = strings,
+                    .format = strings + file_length + 1,
+                    .arguments = site->arguments,
+                };
+                site->info.argument_count =
+                    ParseFormat(site->info.format, site->arguments);
+            }
+        }
+        else if (sites[id].strings == NULL ||
+                 size < sizeof(record_header_t))
+            success = false;
+        else
+        {
+            char line[MAX_LINE];
+            size_t length = FormatLine(&sites[id].info, body, line);
+            fwrite(line, 1, length, output);
+        }
+
+        if (body != entry) free(body);
+    }
+
+    if (sites != NULL)
+        for (size_t i = 0; i < MAX_SITES; ++i) free(sites[i].strings);
+    free(sites);
+    free(entry);
+    fclose(file);
+    return success;
+}
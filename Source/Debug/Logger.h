@@ -0,0 +1,255 @@
+/**
+ * @file Logger.h
+ * @authors Israfiel
+ * @brief Iridium's asynchronous logger. Logging threads never format
+ * anything; they copy the format string's ID and its raw arguments into
+ * a per-thread lock-free ring buffer, and a background thread drains
+ * every ring, formats the records, and writes them out. This is also
+ * the engine's fatal error mechanism--see IR_LOG_FATAL.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_DEBUG_LOGGER_H
+#define IRIDIUM_DEBUG_LOGGER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @name IR_LOG_MAX_ARGUMENTS
+ * @brief The most arguments a single log format string may consume.
+ */
+#define IR_LOG_MAX_ARGUMENTS 16
+
+/**
+ * @name IR_LOG_MAX_STRING
+ * @brief The longest string argument copied into a record. Longer
+ * strings are truncated.
+ */
+#define IR_LOG_MAX_STRING 255
+
+/**
+ * @name IR_LOG_FILE_MAGIC
+ * @brief The four bytes ("IRLG") that open every binary log file.
+ */
+#define IR_LOG_FILE_MAGIC 0x474c5249u
+
+/**
+ * @name IR_LOG_FILE_VERSION
+ * @brief The version of the binary log layout.
+ */
+#define IR_LOG_FILE_VERSION 1u
+
+/**
+ * @name ir_log_level_t
+ * @brief The severity of a log message.
+ */
+typedef enum ir_log_level
+{
+    IR_LOG_LEVEL_DEBUG,
+    IR_LOG_LEVEL_INFO,
+    IR_LOG_LEVEL_WARNING,
+    IR_LOG_LEVEL_ERROR,
+    IR_LOG_LEVEL_FATAL
+} ir_log_level_t;
+
+/**
+ * @name ir_log_site_t
+ * @brief A single logging call site. One of these is created statically
+ * by each logging macro and registered on first use, at which point its
+ * format string is parsed and given an ID.
+ */
+typedef struct ir_log_site
+{
+    /**
+     * @name format
+     * @brief The printf-style format string.
+     */
+    const char *format;
+    /**
+     * @name file
+     * @brief The source file of the call site.
+     */
+    const char *file;
+    /**
+     * @name line
+     * @brief The source line of the call site.
+     */
+    uint32_t line;
+    /**
+     * @name level
+     * @brief The severity of the call site.
+     */
+    ir_log_level_t level;
+    /**
+     * @name id
+     * @brief The site's ID, zero until registered.
+     */
+    _Atomic uint32_t id;
+    /**
+     * @name argument_count
+     * @brief The number of arguments the format string consumes.
+     */
+    uint8_t argument_count;
+    /**
+     * @name arguments
+     * @brief How each argument is fetched and stored.
+     */
+    uint8_t arguments[IR_LOG_MAX_ARGUMENTS];
+} ir_log_site_t;
+
+/**
+ * @name ir_log_config_t
+ * @brief How the logger's background thread emits records.
+ */
+typedef struct ir_log_config
+{
+    /**
+     * @name path
+     * @brief The file to log to, or NULL to log only to stderr.
+     */
+    const char *path;
+    /**
+     * @name binary
+     * @brief Write the file as undecoded binary records, to be read back
+     * with the LogDecoder tool, rather than as text.
+     */
+    bool binary;
+    /**
+     * @name stderr_level
+     * @brief The lowest level echoed to stderr.
+     */
+    ir_log_level_t stderr_level;
+    /**
+     * @name file_level
+     * @brief The lowest level written to the log file.
+     */
+    ir_log_level_t file_level;
+    /**
+     * @name ring_size
+     * @brief The size in bytes of each thread's ring, a power of two. Zero
+     * selects the default of 64 KiB.
+     */
+    uint32_t ring_size;
+} ir_log_config_t;
+
+/**
+ * @name LogStart
+ * @authors Israfiel
+ * @brief Start the logger's background thread. Until this is called,
+ * and after Ir_LogStop, messages are formatted synchronously to stderr.
+ *
+ * @param config - How records should be emitted.
+ * @returns Whether the logger was started.
+ */
+bool Ir_LogStart(const ir_log_config_t *config);
+
+/**
+ * @name LogStop
+ * @authors Israfiel
+ * @brief Drain every pending record and stop the background thread.
+ * Thread rings are kept for reuse should the logger be restarted. Other
+ * threads should have stopped logging before this is called.
+ */
+void Ir_LogStop(void);
+
+/**
+ * @name LogFlush
+ * @authors Israfiel
+ * @brief Block until every record logged before the call has been
+ * written out.
+ */
+void Ir_LogFlush(void);
+
+/**
+ * @name LogWrite
+ * @authors Israfiel
+ * @brief Push a record for a call site. Use the IR_LOG_* macros instead
+ * of calling this directly.
+ *
+ * @param site - The static call site.
+ * @param ... - The format string's arguments.
+ */
+void Ir_LogWrite(ir_log_site_t *site, ...);
+
+/**
+ * @name LogAbort
+ * @authors Israfiel
+ * @brief Flush every pending record and abort the process. Called by
+ * IR_LOG_FATAL after its message has been pushed.
+ */
+[[gnu::noreturn]] void Ir_LogAbort(void);
+
+/**
+ * @name LogDecode
+ * @authors Israfiel
+ * @brief Decode a binary log file into text.
+ *
+ * @param path - The binary log to read.
+ * @param output - The stream to write text to.
+ * @returns Whether the whole file was decoded.
+ */
+bool Ir_LogDecode(const char *path, FILE *output);
+
+/**
+ * @name IR_LOG
+ * @brief Log a message at the given level. Arguments are copied, never
+ * formatted, on the calling thread.
+ */
+#define IR_LOG(level_, format_, ...)                                        \
+    do {                                                                    \
+        static ir_log_site_t ir_log_site_ = {.format = (format_),          \
+                                             .file = __FILE__,             \
+                                             .line = __LINE__,             \
+                                             .level = (level_)};           \
+        Ir_LogWrite(&ir_log_site_ __VA_OPT__(, ) __VA_ARGS__);             \
+    } while (0)
+
+/**
+ * @name IR_LOG_DEBUG
+ * @brief Log a debug message, for tracing the engine's workings
+ * while developing.
+ */
+#define IR_LOG_DEBUG(format_, ...)                                          \
+    IR_LOG(IR_LOG_LEVEL_DEBUG, format_ __VA_OPT__(, ) __VA_ARGS__)
+
+/**
+ * @name IR_LOG_INFO
+ * @brief Log an informational message.
+ */
+#define IR_LOG_INFO(format_, ...)                                           \
+    IR_LOG(IR_LOG_LEVEL_INFO, format_ __VA_OPT__(, ) __VA_ARGS__)
+
+/**
+ * @name IR_LOG_WARNING
+ * @brief Log a warning, for something unexpected the engine carries
+ * on through.
+ */
+#define IR_LOG_WARNING(format_, ...)                                        \
+    IR_LOG(IR_LOG_LEVEL_WARNING, format_ __VA_OPT__(, ) __VA_ARGS__)
+
+/**
+ * @name IR_LOG_ERROR
+ * @brief Log an error, for something that failed but the engine can
+ * recover from.
+ */
+#define IR_LOG_ERROR(format_, ...)                                          \
+    IR_LOG(IR_LOG_LEVEL_ERROR, format_ __VA_OPT__(, ) __VA_ARGS__)
+
+/**
+ * @name IR_LOG_FATAL
+ * @brief Log a message, flush every pending record, and abort. This is
+ * the engine's handler for unrecoverable errors.
+ */
+#define IR_LOG_FATAL(format_, ...)                                          \
+    do {                                                                    \
+        IR_LOG(IR_LOG_LEVEL_FATAL, format_ __VA_OPT__(, ) __VA_ARGS__);    \
+        Ir_LogAbort();                                                      \
+    } while (0)
+
+#endif // IRIDIUM_DEBUG_LOGGER_H
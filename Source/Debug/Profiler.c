@@ -0,0 +1,826 @@
+/**
+ * @file Profiler.c
+ * @authors Israfiel
+ * @brief The implementation of Iridium's instrumentation profiler and
+ * its trace exporters.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Profiler.h"
+
+#include <stdalign.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+    #include <sys/syscall.h>
+#endif
+
+/**
+ * @name MAX_COUNTER_TRACKS
+ * @brief The most distinct counters exported to a Perfetto trace.
+ */
+#define MAX_COUNTER_TRACKS 1024
+
+/**
+ * @name PERFETTO_CLOCK_MONOTONIC
+ * @brief Perfetto's builtin ID for CLOCK_MONOTONIC.
+ */
+#define PERFETTO_CLOCK_MONOTONIC 3
+
+/**
+ * @name MAX_COUNTER_DEPTH
+ * @brief The deepest zone nesting that carries hardware counters.
+ */
+#define MAX_COUNTER_DEPTH 64
+
+/**
+ * @name ir_profile_counters_t
+ * @brief A thread's hardware counters, the readings of its open zones,
+ * and the deltas of its zone ends, parallel to its event ring.
+ */
+typedef struct ir_profile_counters
+{
+    ir_counter_group_t group;
+    uint32_t depth;
+    ir_counter_values_t stack[MAX_COUNTER_DEPTH];
+    ir_counter_values_t deltas[IR_PROFILER_RING_EVENTS];
+} ir_profile_counters_t;
+
+thread_local ir_profile_thread_t *ir_profiler_thread;
+
+/**
+ * @name ir_profiler
+ * @brief The profiler's global state.
+ */
+static struct
+{
+    _Atomic(ir_profile_thread_t *) threads;
+    _Atomic uint32_t thread_count;
+    _Atomic uint64_t frame;
+    _Atomic bool counters;
+    tss_t thread_key;
+} ir_profiler;
+
+/**
+ * @name ir_profiler_once
+ * @brief Guards the creation of the profiler's TSS key.
+ */
+static once_flag ir_profiler_once = ONCE_FLAG_INIT;
+
+/**
+ * @name ReleaseThread
+ * @authors Israfiel
+ * @brief TSS destructor handing a dead thread's ring back for reuse.
+ *
+ * @param thread - The thread's ring.
+ */
+static void ReleaseThread(void *thread)
+{
+    // The counters stay allocated, since a capture may be reading them;
+    // the next owner reopens the group on its own thread.
+    ir_profile_counters_t *counters = atomic_load_explicit(
+        &((ir_profile_thread_t *)thread)->counters, memory_order_relaxed);
+    if (counters != NULL) Ir_CountersClose(&counters->group);
+
+    atomic_store_explicit(&((ir_profile_thread_t *)thread)->owned, false,
+                          memory_order_release);
+}
+
+/**
+ * @name OpenCounters
+ * @authors Israfiel
+ * @brief Open the calling thread's hardware counters into its ring.
+ *
+ * @param thread - The calling thread's ring.
+ * @returns Whether the counters could be opened.
+ */
+static bool OpenCounters(ir_profile_thread_t *thread)
+{
+    ir_profile_counters_t *counters =
+        atomic_load_explicit(&thread->counters, memory_order_relaxed);
+    if (counters != NULL)
+    {
+        Ir_CountersClose(&counters->group);
+        counters->depth = 0;
+        return Ir_CountersOpen(&counters->group);
+    }
+
+    counters = calloc(1, sizeof(ir_profile_counters_t));
+    if (counters == NULL) return false;
+    if (!Ir_CountersOpen(&counters->group))
+    {
+        free(counters);
+        return false;
+    }
+    atomic_store_explicit(&thread->counters, counters,
+                          memory_order_release);
+    return true;
+}
+
+/**
+ * @name InitializeOnce
+ * @authors Israfiel
+ * @brief Create the profiler's TSS key.
+ */
+static void InitializeOnce(void)
+{
+    tss_create(&ir_profiler.thread_key, ReleaseThread);
+}
+
+/**
+ * @name SystemThreadID
+ * @authors Israfiel
+ * @brief Get the operating system's ID for the calling thread.
+ *
+ * @param fallback - The ID to use where there is no such thing.
+ * @returns The thread's ID.
+ */
+static uint32_t SystemThreadID(uint32_t fallback)
+{
+#ifdef __linux__
+    (void)fallback;
+    return (uint32_t)syscall(SYS_gettid);
+#else
+    return fallback;
+#endif
+}
+
+ir_profile_thread_t *Ir_ProfilerAcquireThread(void)
+{
+    call_once(&ir_profiler_once, InitializeOnce);
+
+    ir_profile_thread_t *thread =
+        atomic_load_explicit(&ir_profiler.threads, memory_order_acquire);
+    for (; thread != NULL; thread = thread->next)
+    {
+        bool expected = false;
+        if (atomic_compare_exchange_strong_explicit(
+                &thread->owned, &expected, true, memory_order_acq_rel,
+                memory_order_relaxed))
+            break;
+    }
+
+    if (thread == NULL)
+    {
+        thread = aligned_alloc(alignof(ir_profile_thread_t),
+                               sizeof(ir_profile_thread_t));
+        if (thread == NULL) return NULL;
+
+        atomic_init(&thread->head, 0);
+        atomic_init(&thread->owned, true);
+        atomic_init(&thread->counters, NULL);
+        thread->index = atomic_fetch_add_explicit(
+            &ir_profiler.thread_count, 1, memory_order_relaxed);
+        thread->next =
+            atomic_load_explicit(&ir_profiler.threads, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(
+            &ir_profiler.threads, &thread->next, thread,
+            memory_order_release, memory_order_relaxed));
+    }
+
+    thread->system_id = SystemThreadID(thread->index);
+    atomic_store_explicit(&thread->name, NULL, memory_order_relaxed);
+    if (atomic_load_explicit(&ir_profiler.counters, memory_order_relaxed))
+        OpenCounters(thread);
+    tss_set(ir_profiler.thread_key, thread);
+    ir_profiler_thread = thread;
+    return thread;
+}
+
+void Ir_ProfilerSampleCounters(ir_profile_thread_t *thread,
+                               ir_profile_event_type_t type,
+                               uint64_t head)
+{
+    ir_profile_counters_t *counters =
+        atomic_load_explicit(&thread->counters, memory_order_relaxed);
+    ir_counter_values_t now;
+    Ir_CountersRead(&counters->group, &now);
+
+    if (type == IR_PROFILE_EVENT_BEGIN)
+    {
+        if (counters->depth < MAX_COUNTER_DEPTH)
+            counters->stack[counters->depth] = now;
+        counters->depth++;
+        return;
+    }
+
+    ir_counter_values_t *delta =
+        &counters->deltas[head & (IR_PROFILER_RING_EVENTS - 1)];
+    *delta = (ir_counter_values_t){0};
+    if (counters->depth == 0) return;
+    if (--counters->depth >= MAX_COUNTER_DEPTH) return;
+
+    const ir_counter_values_t *begin = &counters->stack[counters->depth];
+    for (size_t i = 0; i < IR_COUNTER_COUNT; ++i)
+        if (now.values[i] >= begin->values[i])
+            delta->values[i] = now.values[i] - begin->values[i];
+}
+
+uint64_t Ir_ProfilerFrame(void)
+{
+    uint64_t frame =
+        atomic_fetch_add_explicit(&ir_profiler.frame, 1, memory_order_relaxed);
+    Ir_ProfilerRecord(IR_PROFILE_EVENT_FRAME, "Frame", (double)frame);
+    return frame;
+}
+
+void Ir_ProfilerSetThreadName(const char *name)
+{
+    ir_profile_thread_t *thread = ir_profiler_thread;
+    if (thread == NULL && (thread = Ir_ProfilerAcquireThread()) == NULL)
+        return;
+    atomic_store_explicit(&thread->name, name, memory_order_relaxed);
+}
+
+bool Ir_ProfilerEnableCounters(void)
+{
+    atomic_store_explicit(&ir_profiler.counters, true,
+                          memory_order_relaxed);
+
+    // Acquiring a ring opens its counters too, but reopening them is
+    // the simplest way to learn whether that worked.
+    ir_profile_thread_t *thread = ir_profiler_thread;
+    if (thread == NULL && (thread = Ir_ProfilerAcquireThread()) == NULL)
+        return false;
+    return OpenCounters(thread);
+}
+
+/**
+ * @name GrowCapture
+ * @authors Israfiel
+ * @brief Make room for more events in a capture.
+ *
+ * @param capture - The capture to grow.
+ * @param capacity - The capture's capacity, updated on success.
+ * @returns Whether the capture could be grown.
+ */
+static bool GrowCapture(ir_profile_capture_t *capture, size_t *capacity)
+{
+    size_t grown = *capacity ? *capacity * 2 : 4096;
+    ir_profile_event_t *events =
+        realloc(capture->events, grown * sizeof(ir_profile_event_t));
+    if (events == NULL) return false;
+    capture->events = events;
+
+    if (capture->counters != NULL)
+    {
+        ir_counter_values_t *counters = realloc(
+            capture->counters, grown * sizeof(ir_counter_values_t));
+        if (counters == NULL) return false;
+        capture->counters = counters;
+    }
+    *capacity = grown;
+    return true;
+}
+
+bool Ir_ProfilerCapture(ir_profile_capture_t *capture, uint64_t begin,
+                        uint64_t end)
+{
+    *capture = (ir_profile_capture_t){0};
+
+    size_t thread_count = atomic_load_explicit(&ir_profiler.thread_count,
+                                               memory_order_acquire);
+    ir_profile_thread_t *threads =
+        atomic_load_explicit(&ir_profiler.threads, memory_order_acquire);
+
+    // Counter deltas are only copied if some thread has them.
+    bool counting = false;
+    for (ir_profile_thread_t *thread = threads; thread != NULL;
+         thread = thread->next)
+        if (atomic_load_explicit(&thread->counters, memory_order_acquire))
+            counting = true;
+
+    ir_profile_event_t *scratch =
+        malloc(IR_PROFILER_RING_EVENTS * sizeof(ir_profile_event_t));
+    ir_counter_values_t *scratch_counters =
+        counting ? malloc(IR_PROFILER_RING_EVENTS *
+                          sizeof(ir_counter_values_t))
+                 : NULL;
+    capture->threads =
+        malloc((thread_count ? thread_count : 1) *
+               sizeof(ir_profile_thread_info_t));
+    if (counting && scratch_counters != NULL)
+        capture->counters = malloc(sizeof(ir_counter_values_t));
+    if (scratch == NULL || capture->threads == NULL ||
+        (counting && capture->counters == NULL))
+    {
+        free(scratch);
+        free(scratch_counters);
+        Ir_ProfilerCaptureDestroy(capture);
+        return false;
+    }
+
+    size_t capacity = 0;
+    ir_profile_thread_t *thread = threads;
+    for (; thread != NULL && capture->thread_count < thread_count;
+         thread = thread->next)
+    {
+        capture->threads[capture->thread_count++] =
+            (ir_profile_thread_info_t){
+                .index = thread->index,
+                .system_id = thread->system_id,
+                .name = atomic_load_explicit(&thread->name,
+                                             memory_order_relaxed),
+            };
+        ir_profile_counters_t *counters =
+            atomic_load_explicit(&thread->counters, memory_order_acquire);
+        if (counters != NULL)
+            capture->counter_mask |= counters->group.available;
+
+        uint64_t head =
+            atomic_load_explicit(&thread->head, memory_order_acquire);
+        uint64_t first = head > IR_PROFILER_RING_EVENTS
+                             ? head - IR_PROFILER_RING_EVENTS
+                             : 0;
+        for (uint64_t i = first; i < head; ++i)
+        {
+            size_t slot = i & (IR_PROFILER_RING_EVENTS - 1);
+            scratch[i - first] = thread->events[slot];
+            if (counters != NULL)
+                scratch_counters[i - first] = counters->deltas[slot];
+        }
+
+        // Anything the thread lapped while we were copying is garbage,
+        // and so is the slot it may be writing now, one past its head.
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t lapped =
+            atomic_load_explicit(&thread->head, memory_order_relaxed);
+        uint64_t valid = lapped + 1 > IR_PROFILER_RING_EVENTS
+                             ? lapped + 1 - IR_PROFILER_RING_EVENTS
+                             : 0;
+        if (valid < first) valid = first;
+
+        for (uint64_t i = valid; i < head; ++i)
+        {
+            ir_profile_event_t *event = &scratch[i - first];
+            if (event->ticks < begin || event->ticks > end) continue;
+
+            if (capture->event_count == capacity &&
+                !GrowCapture(capture, &capacity))
+            {
+                free(scratch);
+                free(scratch_counters);
+                Ir_ProfilerCaptureDestroy(capture);
+                return false;
+            }
+
+            if (capture->counters != NULL)
+                capture->counters[capture->event_count] =
+                    counters != NULL && event->type == IR_PROFILE_EVENT_END
+                        ? scratch_counters[i - first]
+                        : (ir_counter_values_t){0};
+            event->thread = thread->index;
+            capture->events[capture->event_count++] = *event;
+        }
+    }
+
+    free(scratch);
+    free(scratch_counters);
+    return true;
+}
+
+void Ir_ProfilerCaptureDestroy(ir_profile_capture_t *capture)
+{
+    free(capture->events);
+    free(capture->threads);
+    free(capture->counters);
+    *capture = (ir_profile_capture_t){0};
+}
+
+/**
+ * @name WriteJSONString
+ * @authors Israfiel
+ * @brief Write a string as a quoted, escaped JSON string.
+ *
+ * @param file - The file to write to.
+ * @param string - The string to write.
+ */
+static void WriteJSONString(FILE *file, const char *string)
+{
+    fputc('"', file);
+    for (const char *c = string; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\') fprintf(file, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20) fprintf(file, "\\u%04x", *c);
+        else fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+/**
+ * @name SkipUnmatchedEnd
+ * @authors Israfiel
+ * @brief Track zone depth across a capture, so that zones whose begin
+ * was cut off by the capture range are left out.
+ *
+ * @param event - The event being exported.
+ * @param thread - The thread of the previous event.
+ * @param depth - The zone depth of the current thread.
+ * @returns Whether the event should be skipped.
+ */
+static bool SkipUnmatchedEnd(const ir_profile_event_t *event,
+                             uint32_t *thread, uint32_t *depth)
+{
+    if (event->thread != *thread) *thread = event->thread, *depth = 0;
+
+    if (event->type == IR_PROFILE_EVENT_BEGIN) (*depth)++;
+    else if (event->type == IR_PROFILE_EVENT_END)
+    {
+        if (*depth == 0) return true;
+        (*depth)--;
+    }
+    return false;
+}
+
+/**
+ * @name WriteCounterArgs
+ * @authors Israfiel
+ * @brief Write a zone's hardware counter deltas as Chrome trace args.
+ *
+ * @param file - The file to write to.
+ * @param mask - The counters to write.
+ * @param values - The zone's deltas.
+ */
+static void WriteCounterArgs(FILE *file, uint32_t mask,
+                             const ir_counter_values_t *values)
+{
+    const char *separator = ",\"args\":{";
+    for (ir_counter_t counter = 0; counter < IR_COUNTER_COUNT; ++counter)
+    {
+        if ((mask & (1u << counter)) == 0) continue;
+        fprintf(file, "%s\"%s\":%llu", separator, Ir_CounterName(counter),
+                (unsigned long long)values->values[counter]);
+        separator = ",";
+    }
+    fputc('}', file);
+}
+
+bool Ir_ProfilerWriteChromeTrace(const ir_profile_capture_t *capture,
+                                 const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL) return false;
+
+    int process = (int)getpid();
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+
+    bool first = true;
+    for (size_t i = 0; i < capture->thread_count; ++i)
+    {
+        const ir_profile_thread_info_t *thread = &capture->threads[i];
+        if (thread->name == NULL) continue;
+
+        fprintf(file,
+                "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,"
+                "\"tid\":%u,\"args\":{\"name\":",
+                first ? "" : ",\n", process, thread->system_id);
+        WriteJSONString(file, thread->name);
+        fputs("}}", file);
+        first = false;
+    }
+
+    uint32_t thread = UINT32_MAX, depth = 0, system_id = 0;
+    for (size_t i = 0; i < capture->event_count; ++i)
+    {
+        const ir_profile_event_t *event = &capture->events[i];
+        if (event->thread != thread)
+            for (size_t j = 0; j < capture->thread_count; ++j)
+                if (capture->threads[j].index == event->thread)
+                    system_id = capture->threads[j].system_id;
+        if (SkipUnmatchedEnd(event, &thread, &depth)) continue;
+
+        static const char phases[] = {'B', 'E', 'C', 'i'};
+        double timestamp =
+            (double)Ir_ClockTicksToMonotonic(event->ticks) / 1000.0;
+        fprintf(file, "%s{\"ph\":\"%c\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,"
+                      "\"name\":",
+                first ? "" : ",\n", phases[event->type], process,
+                system_id, timestamp);
+        WriteJSONString(file, event->name);
+
+        if (event->type == IR_PROFILE_EVENT_COUNTER)
+            fprintf(file, ",\"args\":{\"value\":%.17g}", event->value);
+        else if (event->type == IR_PROFILE_EVENT_FRAME)
+            fprintf(file, ",\"s\":\"g\",\"args\":{\"frame\":%.0f}",
+                    event->value);
+        else if (event->type == IR_PROFILE_EVENT_END &&
+                 capture->counters != NULL && capture->counter_mask != 0)
+            WriteCounterArgs(file, capture->counter_mask,
+                             &capture->counters[i]);
+        fputc('}', file);
+        first = false;
+    }
+
+    fputs("\n]}\n", file);
+    return fclose(file) == 0;
+}
+
+/**
+ * @name proto_buffer_t
+ * @brief A growable buffer a protobuf message is encoded into.
+ */
+typedef struct proto_buffer
+{
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} proto_buffer_t;
+
+/**
+ * @name ProtoBytes
+ * @authors Israfiel
+ * @brief Append raw bytes to a protobuf buffer.
+ *
+ * @param buffer - The buffer to append to.
+ * @param bytes - The bytes to append.
+ * @param size - The number of bytes.
+ */
+static void ProtoBytes(proto_buffer_t *buffer, const void *bytes,
+                       size_t size)
+{
+    if (buffer->failed) return;
+    if (buffer->size + size > buffer->capacity)
+    {
+        size_t capacity = buffer->capacity ? buffer->capacity * 2 : 256;
+        while (capacity < buffer->size + size) capacity *= 2;
+        uint8_t *data = realloc(buffer->data, capacity);
+        if (data == NULL)
+        {
+            buffer->failed = true;
+            return;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->size, bytes, size);
+    buffer->size += size;
+}
+
+/**
+ * @name ProtoVarint
+ * @authors Israfiel
+ * @brief Append a base-128 varint.
+ *
+ * @param buffer - The buffer to append to.
+ * @param value - The value to encode.
+ */
+static void ProtoVarint(proto_buffer_t *buffer, uint64_t value)
+{
+    uint8_t bytes[10];
+    size_t size = 0;
+    do {
+        bytes[size] = (uint8_t)(value & 0x7F);
+        value >>= 7;
+        if (value != 0) bytes[size] |= 0x80;
+        size++;
+    } while (value != 0);
+    ProtoBytes(buffer, bytes, size);
+}
+
+/**
+ * @name ProtoUnsigned
+ * @authors Israfiel
+ * @brief Append a varint field.
+ *
+ * @param buffer - The buffer to append to.
+ * @param field - The field number.
+ * @param value - The field's value.
+ */
+static void ProtoUnsigned(proto_buffer_t *buffer, uint32_t field,
+                          uint64_t value)
+{
+    ProtoVarint(buffer, (uint64_t)field << 3);
+    ProtoVarint(buffer, value);
+}
+
+/**
+ * @name ProtoDouble
+ * @authors Israfiel
+ * @brief Append a double field.
+ *
+ * @param buffer - The buffer to append to.
+ * @param field - The field number.
+ * @param value - The field's value.
+ */
+static void ProtoDouble(proto_buffer_t *buffer, uint32_t field,
+                        double value)
+{
+    // Protobuf is little-endian, as is every platform Iridium targets.
+    ProtoVarint(buffer, ((uint64_t)field << 3) | 1);
+    ProtoBytes(buffer, &value, sizeof(double));
+}
+
+/**
+ * @name ProtoLength
+ * @authors Israfiel
+ * @brief Append a length-delimited field.
+ *
+ * @param buffer - The buffer to append to.
+ * @param field - The field number.
+ * @param bytes - The field's contents.
+ * @param size - The size of the contents.
+ */
+static void ProtoLength(proto_buffer_t *buffer, uint32_t field,
+                        const void *bytes, size_t size)
+{
+    ProtoVarint(buffer, ((uint64_t)field << 3) | 2);
+    ProtoVarint(buffer, size);
+    ProtoBytes(buffer, bytes, size);
+}
+
+/**
+ * @name ProtoString
+ * @authors Israfiel
+ * @brief Append a string field.
+ *
+ * @param buffer - The buffer to append to.
+ * @param field - The field number.
+ * @param string - The field's value.
+ */
+static void ProtoString(proto_buffer_t *buffer, uint32_t field,
+                        const char *string)
+{
+    ProtoLength(buffer, field, string, strlen(string));
+}
+
+/**
+ * @name ProtoMessage
+ * @authors Israfiel
+ * @brief Append a nested message field, then empty the nested buffer
+ * for reuse.
+ *
+ * @param buffer - The buffer to append to.
+ * @param field - The field number.
+ * @param message - The encoded nested message.
+ */
+static void ProtoMessage(proto_buffer_t *buffer, uint32_t field,
+                         proto_buffer_t *message)
+{
+    if (message->failed) buffer->failed = true;
+    ProtoLength(buffer, field, message->data, message->size);
+    message->size = 0;
+}
+
+// Field numbers from perfetto/trace/trace_packet.proto and friends.
+enum
+{
+    TRACE_PACKET = 1,
+    PACKET_TIMESTAMP = 8,
+    PACKET_SEQUENCE_ID = 10,
+    PACKET_TRACK_EVENT = 11,
+    PACKET_CLOCK_ID = 58,
+    PACKET_TRACK_DESCRIPTOR = 60,
+    DESCRIPTOR_UUID = 1,
+    DESCRIPTOR_NAME = 2,
+    DESCRIPTOR_PROCESS = 3,
+    DESCRIPTOR_THREAD = 4,
+    DESCRIPTOR_PARENT = 5,
+    DESCRIPTOR_COUNTER = 8,
+    PROCESS_PID = 1,
+    THREAD_PID = 1,
+    THREAD_TID = 2,
+    THREAD_NAME = 5,
+    EVENT_DEBUG_ANNOTATIONS = 4,
+    EVENT_TYPE = 9,
+    EVENT_TRACK = 11,
+    EVENT_NAME = 23,
+    EVENT_DOUBLE_VALUE = 44,
+    ANNOTATION_UINT_VALUE = 3,
+    ANNOTATION_NAME = 10,
+    EVENT_SLICE_BEGIN = 1,
+    EVENT_SLICE_END = 2,
+    EVENT_INSTANT = 3,
+    EVENT_COUNTER = 4,
+    PROCESS_TRACK = 1,
+    THREAD_TRACK_BASE = 0x100,
+    COUNTER_TRACK_BASE = 0x100000
+};
+
+/**
+ * @name EmitPacket
+ * @authors Israfiel
+ * @brief Wrap a packet's fields into a TracePacket and write it out.
+ *
+ * @param file - The trace file.
+ * @param packet - The packet's fields.
+ * @param trace - Scratch space for the wrapped packet.
+ */
+static void EmitPacket(FILE *file, proto_buffer_t *packet,
+                       proto_buffer_t *trace)
+{
+    ProtoUnsigned(packet, PACKET_SEQUENCE_ID, 1);
+    ProtoMessage(trace, TRACE_PACKET, packet);
+    if (!trace->failed) fwrite(trace->data, 1, trace->size, file);
+    trace->size = 0;
+}
+
+bool Ir_ProfilerWritePerfetto(const ir_profile_capture_t *capture,
+                              const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return false;
+
+    proto_buffer_t trace = {0}, packet = {0}, message = {0}, inner = {0};
+    uint32_t process = (uint32_t)getpid();
+
+    ProtoUnsigned(&inner, PROCESS_PID, process);
+    ProtoUnsigned(&message, DESCRIPTOR_UUID, PROCESS_TRACK);
+    ProtoMessage(&message, DESCRIPTOR_PROCESS, &inner);
+    ProtoMessage(&packet, PACKET_TRACK_DESCRIPTOR, &message);
+    EmitPacket(file, &packet, &trace);
+
+    for (size_t i = 0; i < capture->thread_count; ++i)
+    {
+        const ir_profile_thread_info_t *thread = &capture->threads[i];
+        ProtoUnsigned(&inner, THREAD_PID, process);
+        ProtoUnsigned(&inner, THREAD_TID, thread->system_id);
+        if (thread->name != NULL)
+            ProtoString(&inner, THREAD_NAME, thread->name);
+
+        ProtoUnsigned(&message, DESCRIPTOR_UUID,
+                      THREAD_TRACK_BASE + thread->index);
+        ProtoUnsigned(&message, DESCRIPTOR_PARENT, PROCESS_TRACK);
+        ProtoMessage(&message, DESCRIPTOR_THREAD, &inner);
+        ProtoMessage(&packet, PACKET_TRACK_DESCRIPTOR, &message);
+        EmitPacket(file, &packet, &trace);
+    }
+
+    const char **counters = malloc(MAX_COUNTER_TRACKS * sizeof(char *));
+    size_t counter_count = 0;
+    bool success = counters != NULL;
+
+    uint32_t thread = UINT32_MAX, depth = 0;
+    for (size_t i = 0; success && i < capture->event_count; ++i)
+    {
+        const ir_profile_event_t *event = &capture->events[i];
+        if (SkipUnmatchedEnd(event, &thread, &depth)) continue;
+
+        uint64_t track = THREAD_TRACK_BASE + event->thread;
+        if (event->type == IR_PROFILE_EVENT_COUNTER)
+        {
+            // Counters are identified by their name's address.
+            size_t counter = 0;
+            while (counter < counter_count &&
+                   counters[counter] != event->name)
+                counter++;
+            if (counter == MAX_COUNTER_TRACKS) continue;
+
+            track = COUNTER_TRACK_BASE + counter;
+            if (counter == counter_count)
+            {
+                counters[counter_count++] = event->name;
+                ProtoUnsigned(&message, DESCRIPTOR_UUID, track);
+                ProtoUnsigned(&message, DESCRIPTOR_PARENT, PROCESS_TRACK);
+                ProtoString(&message, DESCRIPTOR_NAME, event->name);
+                ProtoMessage(&message, DESCRIPTOR_COUNTER, &inner);
+                ProtoMessage(&packet, PACKET_TRACK_DESCRIPTOR, &message);
+                EmitPacket(file, &packet, &trace);
+            }
+        }
+
+        static const uint64_t types[] = {EVENT_SLICE_BEGIN, EVENT_SLICE_END,
+                                         EVENT_COUNTER, EVENT_INSTANT};
+        ProtoUnsigned(&message, EVENT_TYPE, types[event->type]);
+        ProtoUnsigned(&message, EVENT_TRACK, track);
+        if (event->type != IR_PROFILE_EVENT_END)
+            ProtoString(&message, EVENT_NAME, event->name);
+        if (event->type == IR_PROFILE_EVENT_COUNTER)
+            ProtoDouble(&message, EVENT_DOUBLE_VALUE, event->value);
+
+        // Perfetto merges a slice end's annotations into the slice.
+        for (ir_counter_t counter = 0;
+             event->type == IR_PROFILE_EVENT_END &&
+             capture->counters != NULL && counter < IR_COUNTER_COUNT;
+             ++counter)
+        {
+            if ((capture->counter_mask & (1u << counter)) == 0) continue;
+            ProtoString(&inner, ANNOTATION_NAME, Ir_CounterName(counter));
+            ProtoUnsigned(&inner, ANNOTATION_UINT_VALUE,
+                          capture->counters[i].values[counter]);
+            ProtoMessage(&message, EVENT_DEBUG_ANNOTATIONS, &inner);
+        }
+
+        ProtoUnsigned(&packet, PACKET_TIMESTAMP,
+                      Ir_ClockTicksToMonotonic(event->ticks));
+        ProtoUnsigned(&packet, PACKET_CLOCK_ID, PERFETTO_CLOCK_MONOTONIC);
+        ProtoMessage(&packet, PACKET_TRACK_EVENT, &message);
+        EmitPacket(file, &packet, &trace);
+        success = !trace.failed;
+    }
+
+    success = success && !trace.failed && !packet.failed &&
+              !message.failed && !inner.failed;
+    free(counters);
+    free(trace.data);
+    free(packet.data);
+    free(message.data);
+    free(inner.data);
+    return fclose(file) == 0 && success;
+}
@@ -0,0 +1,378 @@
+/**
+ * @file Profiler.h
+ * @authors Israfiel
+ * @brief Iridium's instrumentation profiler. Zones, counters and frame
+ * markers are written into a per-thread ring of recent events stamped
+ * with the high-resolution clock; a capture copies a time range out of
+ * every ring, which can then be exported as a Chrome trace or Perfetto
+ * trace. The macros compile to nothing unless the engine is configured
+ * with IRIDIUM_ENABLE_PROFILER. On Linux, zones can also carry hardware
+ * counter deltas; see Ir_ProfilerEnableCounters.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_DEBUG_PROFILER_H
+#define IRIDIUM_DEBUG_PROFILER_H
+
+#include "Core/Clock.h"
+#include "Debug/Counters.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <threads.h>
+
+/**
+ * @name IR_PROFILER_RING_EVENTS
+ * @brief The number of events each thread keeps, a power of two. Older
+ * events are overwritten.
+ */
+#define IR_PROFILER_RING_EVENTS 65536u
+
+/**
+ * @name ir_profile_event_type_t
+ * @brief The kind of a profiler event.
+ */
+typedef enum ir_profile_event_type
+{
+    IR_PROFILE_EVENT_BEGIN,
+    IR_PROFILE_EVENT_END,
+    IR_PROFILE_EVENT_COUNTER,
+    IR_PROFILE_EVENT_FRAME
+} ir_profile_event_type_t;
+
+/**
+ * @name ir_profile_event_t
+ * @brief A single profiler event.
+ */
+typedef struct ir_profile_event
+{
+    /**
+     * @name ticks
+     * @brief When the event happened, in clock ticks.
+     */
+    uint64_t ticks;
+    /**
+     * @name name
+     * @brief The zone or counter name. Must be a string with static
+     * storage duration; only the pointer is recorded.
+     */
+    const char *name;
+    /**
+     * @name type
+     * @brief The kind of event.
+     */
+    ir_profile_event_type_t type;
+    /**
+     * @name thread
+     * @brief The index of the recording thread. Only filled in captures.
+     */
+    uint32_t thread;
+    /**
+     * @name value
+     * @brief A counter's value, or a frame marker's frame index.
+     */
+    double value;
+} ir_profile_event_t;
+
+/**
+ * @name ir_profile_thread_t
+ * @brief A thread's ring of recent events.
+ */
+typedef struct ir_profile_thread
+{
+    /**
+     * @name head
+     * @brief The number of events ever written by the thread.
+     */
+    _Atomic uint64_t head;
+    /**
+     * @name index
+     * @brief The profiler's index for the thread.
+     */
+    uint32_t index;
+    /**
+     * @name system_id
+     * @brief The operating system's ID for the thread.
+     */
+    uint32_t system_id;
+    /**
+     * @name owned
+     * @brief Whether a live thread is recording into the ring.
+     */
+    _Atomic bool owned;
+    /**
+     * @name name
+     * @brief The thread's display name, or NULL.
+     */
+    const char *_Atomic name;
+    /**
+     * @name counters
+     * @brief The thread's hardware counters and the zone deltas read
+     * from them, or NULL if counters are off for the thread.
+     */
+    struct ir_profile_counters *_Atomic counters;
+    /**
+     * @name next
+     * @brief The next ring in the profiler's list.
+     */
+    struct ir_profile_thread *next;
+    /**
+     * @name events
+     * @brief The ring's storage.
+     */
+    ir_profile_event_t events[IR_PROFILER_RING_EVENTS];
+} ir_profile_thread_t;
+
+/**
+ * @name ir_profile_thread_info_t
+ * @brief A thread described within a capture.
+ */
+typedef struct ir_profile_thread_info
+{
+    uint32_t index;
+    uint32_t system_id;
+    const char *name;
+} ir_profile_thread_info_t;
+
+/**
+ * @name ir_profile_capture_t
+ * @brief A copy of every thread's events within a time range, sorted by
+ * thread and then by time.
+ */
+typedef struct ir_profile_capture
+{
+    /**
+     * @name events
+     * @brief The captured events.
+     */
+    ir_profile_event_t *events;
+    /**
+     * @name event_count
+     * @brief The number of captured events.
+     */
+    size_t event_count;
+    /**
+     * @name threads
+     * @brief Every thread that has recorded events.
+     */
+    ir_profile_thread_info_t *threads;
+    /**
+     * @name thread_count
+     * @brief The number of threads.
+     */
+    size_t thread_count;
+    /**
+     * @name counters
+     * @brief Parallel to events; the hardware counter deltas of each
+     * zone end. NULL if no captured thread had counters.
+     */
+    ir_counter_values_t *counters;
+    /**
+     * @name counter_mask
+     * @brief The counters available on any captured thread, one bit per
+     * ir_counter_t.
+     */
+    uint32_t counter_mask;
+} ir_profile_capture_t;
+
+/**
+ * @name ir_profiler_thread
+ * @brief The calling thread's ring, NULL until its first event.
+ */
+extern thread_local ir_profile_thread_t *ir_profiler_thread;
+
+/**
+ * @name ProfilerAcquireThread
+ * @authors Israfiel
+ * @brief Give the calling thread a ring. Called by Ir_ProfilerRecord on
+ * a thread's first event.
+ *
+ * @returns The thread's ring, or NULL if one could not be allocated.
+ */
+ir_profile_thread_t *Ir_ProfilerAcquireThread(void);
+
+/**
+ * @name ProfilerSampleCounters
+ * @authors Israfiel
+ * @brief Read the calling thread's hardware counters for a zone's begin
+ * or end. Called by Ir_ProfilerRecord when counters are on.
+ *
+ * @param thread - The calling thread's ring.
+ * @param type - The zone event being recorded.
+ * @param head - The ring index of the event.
+ */
+void Ir_ProfilerSampleCounters(ir_profile_thread_t *thread,
+                               ir_profile_event_type_t type,
+                               uint64_t head);
+
+/**
+ * @name ProfilerRecord
+ * @authors Israfiel
+ * @brief Record an event on the calling thread. Use the IR_PROFILE_*
+ * macros rather than calling this directly.
+ *
+ * @param type - The kind of event.
+ * @param name - The static name of the zone or counter.
+ * @param value - The counter value or frame index.
+ */
+static inline void Ir_ProfilerRecord(ir_profile_event_type_t type,
+                                     const char *name, double value)
+{
+    ir_profile_thread_t *thread = ir_profiler_thread;
+    if (thread == NULL && (thread = Ir_ProfilerAcquireThread()) == NULL)
+        return;
+
+    uint64_t head =
+        atomic_load_explicit(&thread->head, memory_order_relaxed);
+    ir_profile_event_t *event =
+        &thread->events[head & (IR_PROFILER_RING_EVENTS - 1)];
+    event->ticks = Ir_ClockTicks();
+    event->name = name;
+    event->type = type;
+    event->value = value;
+    if (type <= IR_PROFILE_EVENT_END &&
+        atomic_load_explicit(&thread->counters, memory_order_relaxed))
+        Ir_ProfilerSampleCounters(thread, type, head);
+    atomic_store_explicit(&thread->head, head + 1, memory_order_release);
+}
+
+/**
+ * @name ProfilerFrame
+ * @authors Israfiel
+ * @brief Mark the start of a new frame.
+ *
+ * @returns The index of the frame just started.
+ */
+uint64_t Ir_ProfilerFrame(void);
+
+/**
+ * @name ProfilerSetThreadName
+ * @authors Israfiel
+ * @brief Name the calling thread in exported traces.
+ *
+ * @param name - The thread's static name.
+ */
+void Ir_ProfilerSetThreadName(const char *name);
+
+/**
+ * @name ProfilerEnableCounters
+ * @authors Israfiel
+ * @brief Attribute hardware counters to zones. The calling thread opens
+ * its counters immediately, and every thread that starts recording
+ * afterwards opens its own, so call this before spawning workers. Each
+ * zone end then carries the counter deltas since its begin.
+ *
+ * @returns Whether the calling thread's counters could be opened.
+ */
+bool Ir_ProfilerEnableCounters(void);
+
+/**
+ * @name ProfilerCapture
+ * @authors Israfiel
+ * @brief Copy every thread's events within a time range. Events that
+ * are overwritten while being copied are left out.
+ *
+ * @param capture - The capture to fill.
+ * @param begin - The first tick of the range.
+ * @param end - The last tick of the range.
+ * @returns Whether the capture could be allocated.
+ */
+bool Ir_ProfilerCapture(ir_profile_capture_t *capture, uint64_t begin,
+                        uint64_t end);
+
+/**
+ * @name ProfilerCaptureDestroy
+ * @authors Israfiel
+ * @brief Free a capture.
+ *
+ * @param capture - The capture to free.
+ */
+void Ir_ProfilerCaptureDestroy(ir_profile_capture_t *capture);
+
+/**
+ * @name ProfilerWriteChromeTrace
+ * @authors Israfiel
+ * @brief Export a capture in the Chrome trace event JSON format, as
+ * loaded by chrome://tracing and ui.perfetto.dev.
+ *
+ * @param capture - The capture to export.
+ * @param path - The file to write.
+ * @returns Whether the file was written.
+ */
+bool Ir_ProfilerWriteChromeTrace(const ir_profile_capture_t *capture,
+                                 const char *path);
+
+/**
+ * @name ProfilerWritePerfetto
+ * @authors Israfiel
+ * @brief Export a capture as a Perfetto protobuf trace.
+ *
+ * @param capture - The capture to export.
+ * @param path - The file to write.
+ * @returns Whether the file was written.
+ */
+bool Ir_ProfilerWritePerfetto(const ir_profile_capture_t *capture,
+                              const char *path);
+
+#ifdef IRIDIUM_PROFILE
+    /**
+     * @name IR_PROFILE_BEGIN
+     * @brief Open a zone on the calling thread, closed by the matching
+     * IR_PROFILE_END.
+     *
+     * @param name_ - The zone's static name.
+     */
+    #define IR_PROFILE_BEGIN(name_)                                     \
+        Ir_ProfilerRecord(IR_PROFILE_EVENT_BEGIN, (name_), 0.0)
+
+    /**
+     * @name IR_PROFILE_END
+     * @brief Close the zone the calling thread opened last.
+     *
+     * @param name_ - The zone's name, as it was opened with.
+     */
+    #define IR_PROFILE_END(name_)                                       \
+        Ir_ProfilerRecord(IR_PROFILE_EVENT_END, (name_), 0.0)
+
+    /**
+     * @name IR_PROFILE_COUNTER
+     * @brief Record a counter's value at this moment, plotted as a
+     * track of its own.
+     *
+     * @param name_ - The counter's static name.
+     * @param value_ - The value, converted to a double.
+     */
+    #define IR_PROFILE_COUNTER(name_, value_)                           \
+        Ir_ProfilerRecord(IR_PROFILE_EVENT_COUNTER, (name_),           \
+                          (double)(value_))
+
+    /**
+     * @name IR_PROFILE_FRAME
+     * @brief Mark the start of a new frame, once a frame on the main
+     * thread.
+     */
+    #define IR_PROFILE_FRAME() Ir_ProfilerFrame()
+
+    /**
+     * @name IR_PROFILE_THREAD_NAME
+     * @brief Name the calling thread in captures.
+     *
+     * @param name_ - The thread's static name.
+     */
+    #define IR_PROFILE_THREAD_NAME(name_) Ir_ProfilerSetThreadName(name_)
+#else
+    // Without IRIDIUM_PROFILE every marker compiles to nothing, and its
+    // arguments are never evaluated.
+    #define IR_PROFILE_BEGIN(name_) ((void)0)
+    #define IR_PROFILE_END(name_) ((void)0)
+    #define IR_PROFILE_COUNTER(name_, value_) ((void)0)
+    #define IR_PROFILE_FRAME() ((void)0)
+    #define IR_PROFILE_THREAD_NAME(name_) ((void)0)
+#endif
+
+#endif // IRIDIUM_DEBUG_PROFILER_H
@@ -0,0 +1,346 @@
+/**
+ * @file Replay.c
+ * @authors Israfiel
+ * @brief The implementation of Iridium's input capture and replay.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Replay.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name HEADER_SIZE
+ * @brief The size of a replay's header: its magic and version.
+ */
+#define HEADER_SIZE (2 * sizeof(uint32_t))
+
+/**
+ * @name EncodeVarint
+ * @authors Israfiel
+ * @brief Encode a base-128 varint.
+ *
+ * @param bytes - Where to encode; needs room for ten bytes.
+ * @param value - The value to encode.
+ * @returns The number of bytes written.
+ */
+static size_t EncodeVarint(uint8_t *bytes, uint64_t value)
+{
+    size_t size = 0;
+    do {
+        bytes[size] = (uint8_t)(value & 0x7F);
+        value >>= 7;
+        if (value != 0) bytes[size] |= 0x80;
+        size++;
+    } while (value != 0);
+    return size;
+}
+
+/**
+ * @name DecodeVarint
+ * @authors Israfiel
+ * @brief Decode a base-128 varint from a played stream.
+ *
+ * @param replay - The replay being played.
+ * @param cursor - The offset to decode at, advanced past the varint.
+ * @param value - Filled with the value.
+ * @returns Whether a whole varint was decoded.
+ */
+static bool DecodeVarint(const ir_replay_t *replay, size_t *cursor,
+                         uint64_t *value)
+{
+    *value = 0;
+    for (uint32_t shift = 0; shift < 64 && *cursor < replay->size;
+         shift += 7)
+    {
+        uint8_t byte = replay->data[(*cursor)++];
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+/**
+ * @name WriteRecord
+ * @authors Israfiel
+ * @brief Append a record to a recording.
+ *
+ * @param replay - The replay being recorded.
+ * @param kind - The record's kind.
+ * @param value - The record's varint field.
+ * @param data - Bytes following the field, or NULL.
+ * @param size - The number of bytes.
+ */
+static void WriteRecord(ir_replay_t *replay, ir_replay_record_t kind,
+                        uint64_t value, const void *data, size_t size)
+{
+    if (replay->status != IR_REPLAY_OK) return;
+
+    uint8_t bytes[11] = {(uint8_t)kind};
+    size_t length = 1 + EncodeVarint(bytes + 1, value);
+    if (fwrite(bytes, 1, length, replay->file) != length ||
+        (size != 0 && fwrite(data, 1, size, replay->file) != size))
+        replay->status = IR_REPLAY_WRITE_FAILED;
+}
+
+/**
+ * @name ReadRecord
+ * @authors Israfiel
+ * @brief Decode a played record.
+ *
+ * @param replay - The replay being played.
+ * @param cursor - The record's offset, advanced past it.
+ * @param kind - Filled with the record's kind.
+ * @param value - Filled with the record's varint field.
+ * @param data - Pointed at an event's bytes.
+ * @returns The status of the operation.
+ */
+static ir_replay_status_t ReadRecord(const ir_replay_t *replay,
+                                     size_t *cursor,
+                                     ir_replay_record_t *kind,
+                                     uint64_t *value, const void **data)
+{
+    if (*cursor == replay->size) return IR_REPLAY_FINISHED;
+
+    *kind = replay->data[(*cursor)++];
+    if (*kind < IR_REPLAY_RECORD_FRAME ||
+        *kind > IR_REPLAY_RECORD_WINDOW)
+        return IR_REPLAY_BAD_RECORD;
+    if (!DecodeVarint(replay, cursor, value)) return IR_REPLAY_TRUNCATED;
+
+    *data = NULL;
+    if (*kind == IR_REPLAY_RECORD_INPUT ||
+        *kind == IR_REPLAY_RECORD_WINDOW)
+    {
+        if (*value > UINT32_MAX || *value > replay->size - *cursor)
+            return IR_REPLAY_TRUNCATED;
+        *data = replay->data + *cursor;
+        *cursor += *value;
+    }
+    return IR_REPLAY_OK;
+}
+
+ir_replay_status_t Ir_ReplayRecord(ir_replay_t *replay, const char *path)
+{
+    *replay = (ir_replay_t){0};
+    replay->file = fopen(path, "wb");
+    if (replay->file == NULL) return IR_REPLAY_OPEN_FAILED;
+
+    const uint32_t header[2] = {IR_REPLAY_MAGIC, IR_REPLAY_VERSION};
+    if (fwrite(header, 1, HEADER_SIZE, replay->file) != HEADER_SIZE)
+    {
+        fclose(replay->file);
+        replay->file = NULL;
+        return IR_REPLAY_WRITE_FAILED;
+    }
+
+    replay->mode = IR_REPLAY_RECORDING;
+    return IR_REPLAY_OK;
+}
+
+ir_replay_status_t Ir_ReplayPlay(ir_replay_t *replay, const char *path)
+{
+    *replay = (ir_replay_t){0};
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return IR_REPLAY_OPEN_FAILED;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < (long)HEADER_SIZE)
+    {
+        fclose(file);
+        return IR_REPLAY_BAD_HEADER;
+    }
+
+    replay->data = malloc((size_t)size);
+    if (replay->data == NULL)
+    {
+        fclose(file);
+        return IR_REPLAY_OUT_OF_MEMORY;
+    }
+    replay->size = fread(replay->data, 1, (size_t)size, file);
+    fclose(file);
+
+    uint32_t header[2];
+    memcpy(header, replay->data, HEADER_SIZE);
+    ir_replay_status_t status = IR_REPLAY_OK;
+    if (replay->size != (size_t)size) status = IR_REPLAY_TRUNCATED;
+    else if (header[0] != IR_REPLAY_MAGIC) status = IR_REPLAY_BAD_HEADER;
+    else if (header[1] != IR_REPLAY_VERSION)
+        status = IR_REPLAY_BAD_VERSION;
+    if (status != IR_REPLAY_OK)
+    {
+        free(replay->data);
+        *replay = (ir_replay_t){0};
+        return status;
+    }
+
+    replay->mode = IR_REPLAY_PLAYING;
+    replay->cursor = HEADER_SIZE;
+    replay->seed_cursor = HEADER_SIZE;
+    return IR_REPLAY_OK;
+}
+
+bool Ir_ReplayStop(ir_replay_t *replay)
+{
+    bool written = true;
+    if (replay->mode == IR_REPLAY_RECORDING)
+        written = fclose(replay->file) == 0 &&
+                  replay->status == IR_REPLAY_OK;
+    free(replay->data);
+    *replay = (ir_replay_t){0};
+    return written;
+}
+
+bool Ir_ReplayFrame(ir_replay_t *replay, uint64_t *delta)
+{
+    if (replay->mode == IR_REPLAY_RECORDING)
+    {
+        WriteRecord(replay, IR_REPLAY_RECORD_FRAME, *delta, NULL, 0);
+        replay->frame++;
+        return true;
+    }
+    if (replay->mode != IR_REPLAY_PLAYING) return true;
+
+    while (replay->status == IR_REPLAY_OK)
+    {
+        ir_replay_record_t kind;
+        uint64_t value;
+        const void *data;
+        replay->status =
+            ReadRecord(replay, &replay->cursor, &kind, &value, &data);
+        if (replay->status == IR_REPLAY_OK &&
+            kind == IR_REPLAY_RECORD_FRAME)
+        {
+            *delta = value;
+            replay->frame++;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t Ir_ReplaySeed(ir_replay_t *replay, uint64_t seed)
+{
+    if (replay->mode == IR_REPLAY_RECORDING)
+        WriteRecord(replay, IR_REPLAY_RECORD_SEED, seed, NULL, 0);
+    if (replay->mode != IR_REPLAY_PLAYING) return seed;
+
+    // A missing seed leaves the engine's own, which at worst diverges.
+    ir_replay_record_t kind;
+    uint64_t value;
+    const void *data;
+    while (ReadRecord(replay, &replay->seed_cursor, &kind, &value,
+                      &data) == IR_REPLAY_OK)
+        if (kind == IR_REPLAY_RECORD_SEED) return value;
+    return seed;
+}
+
+void Ir_ReplayEvent(ir_replay_t *replay, ir_replay_record_t kind,
+                    const void *data, uint32_t size)
+{
+    if (replay->mode != IR_REPLAY_RECORDING) return;
+    WriteRecord(replay, kind, size, data, size);
+}
+
+bool Ir_ReplayNextEvent(ir_replay_t *replay, ir_replay_record_t *kind,
+                        const void **data, uint32_t *size)
+{
+    if (replay->mode != IR_REPLAY_PLAYING) return false;
+
+    while (replay->status == IR_REPLAY_OK)
+    {
+        size_t cursor = replay->cursor;
+        uint64_t value;
+        ir_replay_status_t status =
+            ReadRecord(replay, &cursor, kind, &value, data);
+        // The end of the stream is only reached through Ir_ReplayFrame.
+        if (status == IR_REPLAY_FINISHED) return false;
+        if (status != IR_REPLAY_OK)
+        {
+            replay->status = status;
+            return false;
+        }
+        if (*kind == IR_REPLAY_RECORD_FRAME) return false;
+
+        replay->cursor = cursor;
+        if (*kind != IR_REPLAY_RECORD_SEED)
+        {
+            *size = (uint32_t)value;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *Ir_ReplayStatusString(ir_replay_status_t status)
+{
+    switch (status)
+    {
+        case IR_REPLAY_OK:            return "success";
+        case IR_REPLAY_OUT_OF_MEMORY: return "out of memory";
+        case IR_REPLAY_OPEN_FAILED:   return "failed to open file";
+        case IR_REPLAY_WRITE_FAILED:  return "failed to write file";
+        case IR_REPLAY_BAD_HEADER:    return "malformed header";
+        case IR_REPLAY_BAD_VERSION:   return "incompatible version";
+        case IR_REPLAY_BAD_RECORD:    return "malformed record";
+        case IR_REPLAY_TRUNCATED:     return "truncated record";
+        case IR_REPLAY_FINISHED:      return "playback finished";
+    }
+    return "unknown";
+}
+
+bool Ir_ReplayDecode(const char *path, FILE *output)
+{
+    ir_replay_t replay;
+    ir_replay_status_t status = Ir_ReplayPlay(&replay, path);
+    if (status != IR_REPLAY_OK)
+    {
+        fprintf(output, "Failed to open replay: %s.\n",
+                Ir_ReplayStatusString(status));
+        return false;
+    }
+
+    static const char *names[] = {
+        [IR_REPLAY_RECORD_INPUT] = "input",
+        [IR_REPLAY_RECORD_WINDOW] = "window",
+    };
+
+    uint64_t frame = 0, elapsed = 0;
+    ir_replay_record_t kind;
+    uint64_t value;
+    const void *data;
+    while ((status = ReadRecord(&replay, &replay.cursor, &kind, &value,
+                                &data)) == IR_REPLAY_OK)
+    {
+        if (kind == IR_REPLAY_RECORD_FRAME)
+        {
+            elapsed += value;
+            fprintf(output, "frame %llu: delta %.3f ms, at %.3f s\n",
+                    (unsigned long long)frame++, (double)value / 1e6,
+                    (double)elapsed / 1e9);
+        }
+        else if (kind == IR_REPLAY_RECORD_SEED)
+            fprintf(output, "  seed 0x%016llx\n",
+                    (unsigned long long)value);
+        else
+        {
+            fprintf(output, "  %s event, %llu bytes:", names[kind],
+                    (unsigned long long)value);
+            for (uint64_t i = 0; i < value; ++i)
+                fprintf(output, " %02x", ((const uint8_t *)data)[i]);
+            fputc('\n', output);
+        }
+    }
+
+    if (status != IR_REPLAY_FINISHED)
+        fprintf(output, "Stopped early: %s.\n",
+                Ir_ReplayStatusString(status));
+    Ir_ReplayStop(&replay);
+    return status == IR_REPLAY_FINISHED;
+}
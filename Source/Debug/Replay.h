@@ -0,0 +1,238 @@
+/**
+ * @file Replay.h
+ * @authors Israfiel
+ * @brief Deterministic capture and replay of a session's external
+ * inputs. While recording, every frame's time delta, every input and
+ * window event, and every random seed is appended to a compact binary
+ * stream; playing the stream back hands the same values to the engine
+ * in the same order, so a session can be reproduced headlessly and its
+ * hitches bisected offline. A zeroed replay is off, and passes every
+ * value through untouched.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_DEBUG_REPLAY_H
+#define IRIDIUM_DEBUG_REPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @name IR_REPLAY_MAGIC
+ * @brief The first four bytes of a replay, "IRRP" in little-endian.
+ */
+#define IR_REPLAY_MAGIC 0x50525249u
+
+/**
+ * @name IR_REPLAY_VERSION
+ * @brief The replay format version. Bumped on any incompatible change.
+ */
+#define IR_REPLAY_VERSION 1u
+
+/**
+ * @name ir_replay_mode_t
+ * @brief What a replay is doing.
+ */
+typedef enum ir_replay_mode
+{
+    IR_REPLAY_OFF,
+    IR_REPLAY_RECORDING,
+    IR_REPLAY_PLAYING
+} ir_replay_mode_t;
+
+/**
+ * @name ir_replay_record_t
+ * @brief The kind of a record within a replay. Each record is its kind
+ * as one byte, followed by varint-encoded fields: a frame's delta in
+ * nanoseconds, a seed, or an event's size and then its bytes.
+ */
+typedef enum ir_replay_record
+{
+    IR_REPLAY_RECORD_FRAME = 1,
+    IR_REPLAY_RECORD_SEED,
+    IR_REPLAY_RECORD_INPUT,
+    IR_REPLAY_RECORD_WINDOW
+} ir_replay_record_t;
+
+/**
+ * @name ir_replay_status_t
+ * @brief The result of a replay operation.
+ */
+typedef enum ir_replay_status
+{
+    IR_REPLAY_OK,
+    IR_REPLAY_OUT_OF_MEMORY,
+    IR_REPLAY_OPEN_FAILED,
+    IR_REPLAY_WRITE_FAILED,
+    IR_REPLAY_BAD_HEADER,
+    IR_REPLAY_BAD_VERSION,
+    IR_REPLAY_BAD_RECORD,
+    IR_REPLAY_TRUNCATED,
+    IR_REPLAY_FINISHED
+} ir_replay_status_t;
+
+/**
+ * @name ir_replay_t
+ * @brief A replay being recorded or played.
+ */
+typedef struct ir_replay
+{
+    /**
+     * @name mode
+     * @brief What the replay is doing.
+     */
+    ir_replay_mode_t mode;
+    /**
+     * @name status
+     * @brief The first error hit, or IR_REPLAY_FINISHED once playback
+     * has run out of frames.
+     */
+    ir_replay_status_t status;
+    /**
+     * @name file
+     * @brief The stream being recorded into.
+     */
+    FILE *file;
+    /**
+     * @name data
+     * @brief The whole stream being played.
+     */
+    uint8_t *data;
+    /**
+     * @name size
+     * @brief The size of the stream being played.
+     */
+    size_t size;
+    /**
+     * @name cursor
+     * @brief The offset of the next frame or event to play.
+     */
+    size_t cursor;
+    /**
+     * @name seed_cursor
+     * @brief The offset to search for the next seed from. Seeds are
+     * consumed independently of frames and events.
+     */
+    size_t seed_cursor;
+    /**
+     * @name frame
+     * @brief The number of frames recorded or played.
+     */
+    uint64_t frame;
+} ir_replay_t;
+
+/**
+ * @name ReplayRecord
+ * @authors Israfiel
+ * @brief Start recording into a file, replacing it.
+ *
+ * @param replay - The replay to start.
+ * @param path - The file to record into.
+ * @returns The status of the operation.
+ */
+ir_replay_status_t Ir_ReplayRecord(ir_replay_t *replay, const char *path);
+
+/**
+ * @name ReplayPlay
+ * @authors Israfiel
+ * @brief Load a recorded replay and start playing it.
+ *
+ * @param replay - The replay to start.
+ * @param path - The file to play.
+ * @returns The status of the operation.
+ */
+ir_replay_status_t Ir_ReplayPlay(ir_replay_t *replay, const char *path);
+
+/**
+ * @name ReplayStop
+ * @authors Israfiel
+ * @brief Stop a replay, finishing its file, and turn it off.
+ *
+ * @param replay - The replay to stop.
+ * @returns Whether a recording was written out completely.
+ */
+bool Ir_ReplayStop(ir_replay_t *replay);
+
+/**
+ * @name ReplayFrame
+ * @authors Israfiel
+ * @brief Begin a frame. A recording stores the frame's delta; playback
+ * replaces it with the recorded one, skipping any of the previous
+ * frame's events that were never read.
+ *
+ * @param replay - The replay.
+ * @param delta - The frame's time delta in nanoseconds.
+ * @returns Whether the frame should run; false once playback finishes.
+ */
+bool Ir_ReplayFrame(ir_replay_t *replay, uint64_t *delta);
+
+/**
+ * @name ReplaySeed
+ * @authors Israfiel
+ * @brief Pass a random seed through the replay. A recording stores it;
+ * playback replaces it with the next recorded seed.
+ *
+ * @param replay - The replay.
+ * @param seed - The seed the engine would have used.
+ * @returns The seed to use.
+ */
+uint64_t Ir_ReplaySeed(ir_replay_t *replay, uint64_t seed);
+
+/**
+ * @name ReplayEvent
+ * @authors Israfiel
+ * @brief Record an input or window event into the current frame. The
+ * event's bytes are stored verbatim, so it should hold no pointers.
+ * Does nothing unless recording.
+ *
+ * @param replay - The replay.
+ * @param kind - IR_REPLAY_RECORD_INPUT or IR_REPLAY_RECORD_WINDOW.
+ * @param data - The event.
+ * @param size - The event's size in bytes.
+ */
+void Ir_ReplayEvent(ir_replay_t *replay, ir_replay_record_t kind,
+                    const void *data, uint32_t size);
+
+/**
+ * @name ReplayNextEvent
+ * @authors Israfiel
+ * @brief Play back the current frame's next event.
+ *
+ * @param replay - The replay.
+ * @param kind - Filled with the event's kind.
+ * @param data - Pointed at the event's bytes, valid until the replay is
+ * stopped.
+ * @param size - Filled with the event's size.
+ * @returns Whether an event was played; false at the end of the frame
+ * or when not playing.
+ */
+bool Ir_ReplayNextEvent(ir_replay_t *replay, ir_replay_record_t *kind,
+                        const void **data, uint32_t *size);
+
+/**
+ * @name ReplayStatusString
+ * @authors Israfiel
+ * @brief Describe a replay status for logging.
+ *
+ * @param status - The status to describe.
+ * @returns A static description of the status.
+ */
+const char *Ir_ReplayStatusString(ir_replay_status_t status);
+
+/**
+ * @name ReplayDecode
+ * @authors Israfiel
+ * @brief Describe every record of a replay as text.
+ *
+ * @param path - The replay to decode.
+ * @param output - Where to write the text.
+ * @returns Whether the whole replay could be decoded.
+ */
+bool Ir_ReplayDecode(const char *path, FILE *output);
+
+#endif // IRIDIUM_DEBUG_REPLAY_H
@@ -0,0 +1,103 @@
+/**
+ * @file Input.c
+ * @authors Israfiel
+ * @brief Implements Iridium's input queue.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Input.h"
+
+#include "Core/Clock.h"
+
+#include <assert.h>
+#include <string.h>
+
+static_assert((IR_INPUT_QUEUE & (IR_INPUT_QUEUE - 1)) == 0,
+              "The input queue's size must be a power of two.");
+
+/**
+ * @name QUEUE_MASK
+ * @brief Wraps a queue index to a slot.
+ */
+#define QUEUE_MASK (IR_INPUT_QUEUE - 1)
+
+void Ir_InputQueueInit(ir_input_queue_t *queue)
+{
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->dropped, 0);
+    queue->cached_head = 0;
+}
+
+bool Ir_InputPush(ir_input_queue_t *queue, const ir_input_event_t *event)
+{
+    uint32_t tail =
+        atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    if (tail - queue->cached_head == IR_INPUT_QUEUE)
+    {
+        queue->cached_head =
+            atomic_load_explicit(&queue->head, memory_order_acquire);
+        if (tail - queue->cached_head == IR_INPUT_QUEUE)
+        {
+            atomic_fetch_add_explicit(&queue->dropped, 1,
+                                      memory_order_relaxed);
+            return false;
+        }
+    }
+
+    ir_input_event_t *slot = &queue->events[tail & QUEUE_MASK];
+    *slot = *event;
+    slot->time = Ir_ClockMonotonicNanoseconds();
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+void Ir_InputDrain(ir_input_queue_t *queue, ir_input_batch_t *batch,
+                   ir_replay_t *replay)
+{
+    uint32_t head =
+        atomic_load_explicit(&queue->head, memory_order_relaxed);
+    uint32_t tail =
+        atomic_load_explicit(&queue->tail, memory_order_acquire);
+    batch->time = Ir_ClockMonotonicNanoseconds();
+    batch->count = 0;
+
+    // Playback replaces live input wholesale, or it would diverge.
+    bool playing = replay != NULL && replay->mode == IR_REPLAY_PLAYING;
+    if (!playing)
+    {
+        // At most two copies, split where the ring wraps.
+        uint32_t count = tail - head;
+        uint32_t first = IR_INPUT_QUEUE - (head & QUEUE_MASK);
+        if (first > count) first = count;
+        memcpy(batch->events, &queue->events[head & QUEUE_MASK],
+               first * sizeof(ir_input_event_t));
+        memcpy(batch->events + first, queue->events,
+               (count - first) * sizeof(ir_input_event_t));
+        batch->count = count;
+    }
+    atomic_store_explicit(&queue->head, tail, memory_order_release);
+
+    if (replay == NULL || replay->mode != IR_REPLAY_RECORDING) return;
+    for (uint32_t i = 0; i < batch->count; ++i)
+        Ir_ReplayEvent(replay, IR_REPLAY_RECORD_INPUT, &batch->events[i],
+                       sizeof(ir_input_event_t));
+}
+
+bool Ir_InputReplay(ir_input_batch_t *batch, const void *data,
+                    uint32_t size)
+{
+    if (size != sizeof(ir_input_event_t) ||
+        batch->count == IR_INPUT_QUEUE)
+        return false;
+    memcpy(&batch->events[batch->count++], data, size);
+    return true;
+}
+
+uint64_t Ir_InputDropped(ir_input_queue_t *queue)
+{
+    return atomic_load_explicit(&queue->dropped, memory_order_relaxed);
+}
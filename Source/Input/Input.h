@@ -0,0 +1,251 @@
+/**
+ * @file Input.h
+ * @authors Israfiel
+ * @brief Iridium's input queue. The window backend pushes timestamped
+ * keyboard, pointer, and touch events into a single-producer,
+ * single-consumer ring as they arrive, and the game drains everything
+ * queued in one batch at the start of each frame. Neither side ever
+ * waits on the other.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_INPUT_INPUT_H
+#define IRIDIUM_INPUT_INPUT_H
+
+#include "Debug/Replay.h"
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_INPUT_QUEUE
+ * @brief The most events a queue holds between drains. Must be a power
+ * of two.
+ */
+#define IR_INPUT_QUEUE 1024
+
+/**
+ * @name IR_INPUT_CACHE_LINE
+ * @brief The alignment that keeps the producer's and consumer's
+ * indices from sharing a cache line.
+ */
+#define IR_INPUT_CACHE_LINE 64
+
+/**
+ * @name ir_input_type_t
+ * @brief The kind of an input event.
+ */
+typedef enum ir_input_type
+{
+    /**
+     * @name IR_INPUT_KEY
+     * @brief A key changed state. The code is the evdev keycode, and
+     * the state is nonzero when pressed.
+     */
+    IR_INPUT_KEY,
+    /**
+     * @name IR_INPUT_MODIFIERS
+     * @brief The keyboard modifiers changed. The code is the mask of
+     * held or latched modifiers, and the state is the locked mask.
+     */
+    IR_INPUT_MODIFIERS,
+    /**
+     * @name IR_INPUT_FOCUS
+     * @brief The keyboard (code 0) or pointer (code 1) entered the
+     * window when the state is nonzero, or left it otherwise.
+     */
+    IR_INPUT_FOCUS,
+    /**
+     * @name IR_INPUT_POINTER_MOTION
+     * @brief The pointer moved to x, y in surface coordinates.
+     */
+    IR_INPUT_POINTER_MOTION,
+    /**
+     * @name IR_INPUT_POINTER_RELATIVE
+     * @brief The pointer's device moved by dx, dy, or raw_dx, raw_dy
+     * before acceleration. Reported even when the pointer is stopped
+     * by the edge of the screen.
+     */
+    IR_INPUT_POINTER_RELATIVE,
+    /**
+     * @name IR_INPUT_POINTER_BUTTON
+     * @brief A button changed state. The code is the evdev button code,
+     * and the state is nonzero when pressed.
+     */
+    IR_INPUT_POINTER_BUTTON,
+    /**
+     * @name IR_INPUT_POINTER_AXIS
+     * @brief The pointer scrolled. The code is 0 for the vertical axis
+     * or 1 for the horizontal, and x is the distance.
+     */
+    IR_INPUT_POINTER_AXIS,
+    /**
+     * @name IR_INPUT_TOUCH_DOWN
+     * @brief A touch point with ID code went down at x, y.
+     */
+    IR_INPUT_TOUCH_DOWN,
+    /**
+     * @name IR_INPUT_TOUCH_UP
+     * @brief The touch point with ID code lifted.
+     */
+    IR_INPUT_TOUCH_UP,
+    /**
+     * @name IR_INPUT_TOUCH_MOTION
+     * @brief The touch point with ID code moved to x, y.
+     */
+    IR_INPUT_TOUCH_MOTION,
+    /**
+     * @name IR_INPUT_TOUCH_CANCEL
+     * @brief The compositor took over every active touch point.
+     */
+    IR_INPUT_TOUCH_CANCEL
+} ir_input_type_t;
+
+/**
+ * @name ir_input_event_t
+ * @brief A single input event. Holds no pointers, so it can be copied
+ * into a replay as-is.
+ */
+typedef struct ir_input_event
+{
+    /**
+     * @name type
+     * @brief The kind of event; decides what the other fields mean.
+     */
+    ir_input_type_t type;
+    uint32_t code;
+    uint32_t state;
+    float x;
+    float y;
+    float dx;
+    float dy;
+    float raw_dx;
+    float raw_dy;
+    /**
+     * @name device_time
+     * @brief When the compositor says the event happened, in
+     * nanoseconds on its clock. Only as precise as the protocol: whole
+     * milliseconds for most events, microseconds for relative motion.
+     */
+    uint64_t device_time;
+    /**
+     * @name time
+     * @brief When the event was queued, in monotonic nanoseconds. The
+     * gap to the draining batch's time is the queueing latency.
+     */
+    uint64_t time;
+} ir_input_event_t;
+
+/**
+ * @name ir_input_queue_t
+ * @brief A single-producer, single-consumer queue of input events.
+ */
+typedef struct ir_input_queue
+{
+    /**
+     * @name tail
+     * @brief The index of the next event to write. Only the producer
+     * writes it.
+     */
+    alignas(IR_INPUT_CACHE_LINE) _Atomic uint32_t tail;
+    /**
+     * @name cached_head
+     * @brief The producer's last look at the head, so it only touches
+     * the consumer's cache line when the queue seems full.
+     */
+    uint32_t cached_head;
+    /**
+     * @name head
+     * @brief The index of the next event to read. Only the consumer
+     * writes it.
+     */
+    alignas(IR_INPUT_CACHE_LINE) _Atomic uint32_t head;
+    /**
+     * @name dropped
+     * @brief The number of events lost to a full queue.
+     */
+    alignas(IR_INPUT_CACHE_LINE) _Atomic uint64_t dropped;
+    ir_input_event_t events[IR_INPUT_QUEUE];
+} ir_input_queue_t;
+
+/**
+ * @name ir_input_batch_t
+ * @brief The events handed to one frame, oldest first.
+ */
+typedef struct ir_input_batch
+{
+    ir_input_event_t events[IR_INPUT_QUEUE];
+    uint32_t count;
+    /**
+     * @name time
+     * @brief When the batch was drained, in monotonic nanoseconds.
+     */
+    uint64_t time;
+} ir_input_batch_t;
+
+/**
+ * @name InputQueueInit
+ * @authors Israfiel
+ * @brief Empty a queue before first use.
+ *
+ * @param queue - The queue.
+ */
+void Ir_InputQueueInit(ir_input_queue_t *queue);
+
+/**
+ * @name InputPush
+ * @authors Israfiel
+ * @brief Queue an event, stamping its queue time. Only ever called from
+ * the producing thread.
+ *
+ * @param queue - The queue.
+ * @param event - The event.
+ * @returns Whether the event fit; a full queue drops it.
+ */
+bool Ir_InputPush(ir_input_queue_t *queue, const ir_input_event_t *event);
+
+/**
+ * @name InputDrain
+ * @authors Israfiel
+ * @brief Take every queued event into a batch at the start of a frame.
+ * Only ever called from the consuming thread. While recording, the
+ * batch is written into the replay; while playing, live events are
+ * thrown away and the batch is left for Ir_InputReplay to fill.
+ *
+ * @param queue - The queue.
+ * @param batch - Filled with the events.
+ * @param replay - The replay, or NULL if there is none.
+ */
+void Ir_InputDrain(ir_input_queue_t *queue, ir_input_batch_t *batch,
+                   ir_replay_t *replay);
+
+/**
+ * @name InputReplay
+ * @authors Israfiel
+ * @brief Add an event played back from a replay's input record to a
+ * batch.
+ *
+ * @param batch - The batch.
+ * @param data - The record's bytes.
+ * @param size - The record's size.
+ * @returns Whether the record held an event and the batch had room.
+ */
+bool Ir_InputReplay(ir_input_batch_t *batch, const void *data,
+                    uint32_t size);
+
+/**
+ * @name InputDropped
+ * @authors Israfiel
+ * @brief Get how many events a queue has dropped for lack of room.
+ *
+ * @param queue - The queue.
+ * @returns The number of dropped events.
+ */
+uint64_t Ir_InputDropped(ir_input_queue_t *queue);
+
+#endif // IRIDIUM_INPUT_INPUT_H
@@ -0,0 +1,53 @@
+/**
+ * @file Iridium.h
+ * @authors Israfiel
+ * @brief The public interface of the Iridium engine. Including this
+ * header pulls in every engine subsystem.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_SOURCE_IRIDIUM_H
+#define IRIDIUM_SOURCE_IRIDIUM_H
+
+#include "Animation/Animation.h"
+#include "Animation/Clip.h"
+#include "Animation/Compression.h"
+#include "Animation/Skeleton.h"
+#include "Core/Clock.h"
+#include "Core/FramePacer.h"
+#include "Core/Jobs.h"
+#include "Core/Loop.h"
+#include "Core/Random.h"
+#include "Debug/Counters.h"
+#include "Debug/FrameStats.h"
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+#include "Debug/Replay.h"
+#include "Input/Input.h"
+#include "Math/Quaternion.h"
+#include "Math/SIMD.h"
+#include "Math/Vector.h"
+#include "Particles/Particles.h"
+#include "Physics/Broadphase.h"
+#include "Physics/GJK.h"
+#include "Physics/Heightfield.h"
+#include "Physics/Manifold.h"
+#include "Physics/Narrowphase.h"
+#include "Physics/Query.h"
+#include "Physics/Shape.h"
+#include "Physics/Solver.h"
+#include "Physics/Sweep.h"
+#ifdef __linux__
+    #include "Platform/EventLoop.h"
+    #include "Platform/Window.h"
+#endif
+#include "Render/RenderThread.h"
+#include "Render/Skinning.h"
+#include "Scene/Scene.h"
+#include "Terrain/Clipmap.h"
+#include "Terrain/Terrain.h"
+
+#endif // IRIDIUM_SOURCE_IRIDIUM_H
@@ -0,0 +1,159 @@
+/**
+ * @file Quaternion.h
+ * @authors Israfiel
+ * @brief Iridium's rotation quaternions and rigid transforms.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_MATH_QUATERNION_H
+#define IRIDIUM_MATH_QUATERNION_H
+
+#include "Vector.h"
+
+/**
+ * @name ir_quat_t
+ * @brief A unit quaternion, the vector part first.
+ */
+typedef struct ir_quat
+{
+    float x;
+    float y;
+    float z;
+    float w;
+} ir_quat_t;
+
+/**
+ * @name ir_transform_t
+ * @brief A rotation followed by a translation.
+ */
+typedef struct ir_transform
+{
+    ir_vec3_t position;
+    ir_quat_t rotation;
+} ir_transform_t;
+
+/**
+ * @name IR_QUAT_IDENTITY
+ * @brief The quaternion that doesn't rotate.
+ */
+#define IR_QUAT_IDENTITY ((ir_quat_t){0.0f, 0.0f, 0.0f, 1.0f})
+
+/**
+ * @name QuatMul
+ * @authors Israfiel
+ * @brief Compose two rotations, b applied first.
+ *
+ * @param a - The second rotation.
+ * @param b - The first rotation.
+ * @returns The composed rotation.
+ */
+static inline ir_quat_t Ir_QuatMul(ir_quat_t a, ir_quat_t b)
+{
+    return (ir_quat_t){
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+    };
+}
+
+/**
+ * @name QuatConjugate
+ * @authors Israfiel
+ * @brief Invert a unit quaternion.
+ *
+ * @param a - The quaternion.
+ * @returns The inverse rotation.
+ */
+static inline ir_quat_t Ir_QuatConjugate(ir_quat_t a)
+{
+    return (ir_quat_t){-a.x, -a.y, -a.z, a.w};
+}
+
+/**
+ * @name QuatNormalize
+ * @authors Israfiel
+ * @brief Scale a quaternion back to unit length.
+ *
+ * @param a - The quaternion.
+ * @returns The unit quaternion, or the identity if it was nearly zero.
+ */
+static inline ir_quat_t Ir_QuatNormalize(ir_quat_t a)
+{
+    float length = sqrtf(a.x * a.x + a.y * a.y + a.z * a.z + a.w * a.w);
+    if (length < 1e-12f) return IR_QUAT_IDENTITY;
+    float scale = 1.0f / length;
+    return (ir_quat_t){a.x * scale, a.y * scale, a.z * scale,
+                       a.w * scale};
+}
+
+/**
+ * @name QuatRotate
+ * @authors Israfiel
+ * @brief Rotate a vector.
+ *
+ * @param q - The rotation.
+ * @param v - The vector.
+ * @returns The rotated vector.
+ */
+static inline ir_vec3_t Ir_QuatRotate(ir_quat_t q, ir_vec3_t v)
+{
+    // v + 2w(u x v) + 2u x (u x v), with u the vector part.
+    ir_vec3_t u = {q.x, q.y, q.z};
+    ir_vec3_t t = Ir_Vec3Scale(Ir_Vec3Cross(u, v), 2.0f);
+    return Ir_Vec3Add(Ir_Vec3Add(v, Ir_Vec3Scale(t, q.w)),
+                      Ir_Vec3Cross(u, t));
+}
+
+/**
+ * @name QuatAxisAngle
+ * @authors Israfiel
+ * @brief Make a rotation about an axis.
+ *
+ * @param axis - The unit axis.
+ * @param angle - The angle in radians.
+ * @returns The rotation.
+ */
+static inline ir_quat_t Ir_QuatAxisAngle(ir_vec3_t axis, float angle)
+{
+    float s = sinf(angle * 0.5f);
+    return (ir_quat_t){axis.x * s, axis.y * s, axis.z * s,
+                       cosf(angle * 0.5f)};
+}
+
+/**
+ * @name TransformPoint
+ * @authors Israfiel
+ * @brief Move a point from a transform's local space into world space.
+ *
+ * @param transform - The transform.
+ * @param point - The local point.
+ * @returns The world point.
+ */
+static inline ir_vec3_t Ir_TransformPoint(const ir_transform_t *transform,
+                                          ir_vec3_t point)
+{
+    return Ir_Vec3Add(Ir_QuatRotate(transform->rotation, point),
+                      transform->position);
+}
+
+/**
+ * @name TransformInversePoint
+ * @authors Israfiel
+ * @brief Move a world point into a transform's local space.
+ *
+ * @param transform - The transform.
+ * @param point - The world point.
+ * @returns The local point.
+ */
+static inline ir_vec3_t Ir_TransformInversePoint(
+    const ir_transform_t *transform, ir_vec3_t point)
+{
+    return Ir_QuatRotate(Ir_QuatConjugate(transform->rotation),
+                         Ir_Vec3Sub(point, transform->position));
+}
+
+#endif // IRIDIUM_MATH_QUATERNION_H
@@ -0,0 +1,468 @@
+/**
+ * @file SIMD.h
+ * @authors Israfiel
+ * @brief Iridium's four-wide float vectors. Each function is a single
+ * instruction or close to it on SSE2 and AArch64 NEON; other targets
+ * fall back to plain loops the compiler can usually vectorize itself.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_MATH_SIMD_H
+#define IRIDIUM_MATH_SIMD_H
+
+#include <stdint.h>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+    #define IR_SIMD_SSE 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define IR_SIMD_NEON 1
+#else
+    #include <math.h>
+    #define IR_SIMD_SCALAR 1
+#endif
+
+/**
+ * @name IR_SIMD_WIDTH
+ * @brief The number of lanes in a vector. Arrays read a vector at a time
+ * should be padded to a multiple of it.
+ */
+#define IR_SIMD_WIDTH 4
+
+#if IR_SIMD_SSE
+typedef __m128 ir_simd_t;
+typedef __m128 ir_simd_mask_t;
+#elif IR_SIMD_NEON
+typedef float32x4_t ir_simd_t;
+typedef uint32x4_t ir_simd_mask_t;
+#else
+/**
+ * @name ir_simd_t
+ * @brief Four floats.
+ */
+typedef struct ir_simd
+{
+    float lanes[4];
+} ir_simd_t;
+
+/**
+ * @name ir_simd_mask_t
+ * @brief Four lanes, each all ones or all zeroes.
+ */
+typedef struct ir_simd_mask
+{
+    uint32_t lanes[4];
+} ir_simd_mask_t;
+
+/**
+ * @name IR_SIMD_MAP
+ * @brief Apply an expression of the lanes a[i] and b[i] to every lane.
+ */
+    #define IR_SIMD_MAP(type, expression)                             \
+        type result;                                                  \
+        for (int i = 0; i < 4; ++i) result.lanes[i] = (expression);   \
+        return result
+#endif
+
+/**
+ * @name SimdLoad
+ * @authors Israfiel
+ * @brief Load four floats, which needn't be aligned.
+ *
+ * @param values - The floats.
+ * @returns The vector.
+ */
+static inline ir_simd_t Ir_SimdLoad(const float *values)
+{
+#if IR_SIMD_SSE
+    return _mm_loadu_ps(values);
+#elif IR_SIMD_NEON
+    return vld1q_f32(values);
+#else
+    IR_SIMD_MAP(ir_simd_t, values[i]);
+#endif
+}
+
+/**
+ * @name SimdStore
+ * @authors Israfiel
+ * @brief Store four floats, which needn't be aligned.
+ *
+ * @param values - Where to store the floats.
+ * @param a - The vector.
+ */
+static inline void Ir_SimdStore(float *values, ir_simd_t a)
+{
+#if IR_SIMD_SSE
+    _mm_storeu_ps(values, a);
+#elif IR_SIMD_NEON
+    vst1q_f32(values, a);
+#else
+    for (int i = 0; i < 4; ++i) values[i] = a.lanes[i];
+#endif
+}
+
+/**
+ * @name SimdSplat
+ * @authors Israfiel
+ * @brief Fill every lane with the same float.
+ *
+ * @param value - The float.
+ * @returns The vector.
+ */
+static inline ir_simd_t Ir_SimdSplat(float value)
+{
+#if IR_SIMD_SSE
+    return _mm_set1_ps(value);
+#elif IR_SIMD_NEON
+    return vdupq_n_f32(value);
+#else
+    IR_SIMD_MAP(ir_simd_t, value);
+#endif
+}
+
+/**
+ * @name SimdGet
+ * @authors Israfiel
+ * @brief Read one lane. Slow; meant for the tail end of a loop.
+ *
+ * @param a - The vector.
+ * @param lane - The lane.
+ * @returns The lane's value.
+ */
+static inline float Ir_SimdGet(ir_simd_t a, int lane)
+{
+    float values[4];
+    Ir_SimdStore(values, a);
+    return values[lane];
+}
+
+/**
+ * @name SimdAdd
+ * @authors Israfiel
+ * @brief Add two vectors lane by lane.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns The sum.
+ */
+static inline ir_simd_t Ir_SimdAdd(ir_simd_t a, ir_simd_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_add_ps(a, b);
+#elif IR_SIMD_NEON
+    return vaddq_f32(a, b);
+#else
+    IR_SIMD_MAP(ir_simd_t, a.lanes[i] + b.lanes[i]);
+#endif
+}
+
+/**
+ * @name SimdSub
+ * @authors Israfiel
+ * @brief Subtract two vectors lane by lane.
+ *
+ * @param a - The first vector.
+ * @param b - The vector to subtract.
+ * @returns The difference.
+ */
+static inline ir_simd_t Ir_SimdSub(ir_simd_t a, ir_simd_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_sub_ps(a, b);
+#elif IR_SIMD_NEON
+    return vsubq_f32(a, b);
+#else
+    IR_SIMD_MAP(ir_simd_t, a.lanes[i] - b.lanes[i]);
+#endif
+}
+
+/**
+ * @name SimdMul
+ * @authors Israfiel
+ * @brief Multiply two vectors lane by lane.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns The product.
+ */
+static inline ir_simd_t Ir_SimdMul(ir_simd_t a, ir_simd_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_mul_ps(a, b);
+#elif IR_SIMD_NEON
+    return vmulq_f32(a, b);
+#else
+    IR_SIMD_MAP(ir_simd_t, a.lanes[i] * b.lanes[i]);
+#endif
+}
+
+/**
+ * @name SimdDiv
+ * @authors Israfiel
+ * @brief Divide two vectors lane by lane.
+ *
+ * @param a - The dividend.
+ * @param b - The divisor.
+ * @returns The quotient.
+ */
+static inline ir_simd_t Ir_SimdDiv(ir_simd_t a, ir_simd_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_div_ps(a, b);
+#elif IR_SIMD_NEON
+    return vdivq_f32(a, b);
+#else
+    IR_SIMD_MAP(ir_simd_t, a.lanes[i] / b.lanes[i]);
+#endif
+}
+
+/**
+ * @name SimdMulAdd
+ * @authors Israfiel
+ * @brief Compute a * b + c, fused where the target has it.
+ *
+ * @param a - The first factor.
+ * @param b - The second factor.
+ * @param c - The addend.
+ * @returns The result.
+ */
+static inline ir_simd_t Ir_SimdMulAdd(ir_simd_t a, ir_simd_t b,
+                                      ir_simd_t c)
+{
+#if IR_SIMD_SSE
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#elif IR_SIMD_NEON
+    return vfmaq_f32(c, a, b);
+#else
+    IR_SIMD_MAP(ir_simd_t, a.lanes[i] * b.lanes[i] + c.lanes[i]);
+#endif
+}
+
+/**
+ * @name SimdMin
+ * @authors Israfiel
+ * @brief Take the lesser of each pair of lanes.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns The minimum.
+ */
+static inline ir_simd_t Ir_SimdMin(ir_simd_t a, ir_simd_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_min_ps(a, b);
+#elif IR_SIMD_NEON
+    return vminq_f32(a, b);
+#else
+    IR_SIMD_MAP(ir_simd_t, a.lanes[i] < b.lanes[i] ? a.lanes[i]
+                                                    : b.lanes[i]);
+#endif
+}
+
+/**
+ * @name SimdMax
+ * @authors Israfiel
+ * @brief Take the greater of each pair of lanes.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns The maximum.
+ */
+static inline ir_simd_t Ir_SimdMax(ir_simd_t a, ir_simd_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_max_ps(a, b);
+#elif IR_SIMD_NEON
+    return vmaxq_f32(a, b);
+#else
+    IR_SIMD_MAP(ir_simd_t, a.lanes[i] > b.lanes[i] ? a.lanes[i]
+                                                    : b.lanes[i]);
+#endif
+}
+
+/**
+ * @name SimdSqrt
+ * @authors Israfiel
+ * @brief Take the square root of each lane.
+ *
+ * @param a - The vector.
+ * @returns The square roots.
+ */
+static inline ir_simd_t Ir_SimdSqrt(ir_simd_t a)
+{
+#if IR_SIMD_SSE
+    return _mm_sqrt_ps(a);
+#elif IR_SIMD_NEON
+    return vsqrtq_f32(a);
+#else
+    IR_SIMD_MAP(ir_simd_t, sqrtf(a.lanes[i]));
+#endif
+}
+
+/**
+ * @name SimdLess
+ * @authors Israfiel
+ * @brief Compare two vectors lane by lane.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns Where a is less than b.
+ */
+static inline ir_simd_mask_t Ir_SimdLess(ir_simd_t a, ir_simd_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_cmplt_ps(a, b);
+#elif IR_SIMD_NEON
+    return vcltq_f32(a, b);
+#else
+    IR_SIMD_MAP(ir_simd_mask_t, a.lanes[i] < b.lanes[i] ? ~0u : 0);
+#endif
+}
+
+/**
+ * @name SimdLessEqual
+ * @authors Israfiel
+ * @brief Compare two vectors lane by lane.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns Where a is at most b.
+ */
+static inline ir_simd_mask_t Ir_SimdLessEqual(ir_simd_t a, ir_simd_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_cmple_ps(a, b);
+#elif IR_SIMD_NEON
+    return vcleq_f32(a, b);
+#else
+    IR_SIMD_MAP(ir_simd_mask_t, a.lanes[i] <= b.lanes[i] ? ~0u : 0);
+#endif
+}
+
+/**
+ * @name SimdMaskAnd
+ * @authors Israfiel
+ * @brief Intersect two masks.
+ *
+ * @param a - The first mask.
+ * @param b - The second mask.
+ * @returns The lanes set in both.
+ */
+static inline ir_simd_mask_t Ir_SimdMaskAnd(ir_simd_mask_t a,
+                                            ir_simd_mask_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_and_ps(a, b);
+#elif IR_SIMD_NEON
+    return vandq_u32(a, b);
+#else
+    IR_SIMD_MAP(ir_simd_mask_t, a.lanes[i] & b.lanes[i]);
+#endif
+}
+
+/**
+ * @name SimdMaskOr
+ * @authors Israfiel
+ * @brief Unite two masks.
+ *
+ * @param a - The first mask.
+ * @param b - The second mask.
+ * @returns The lanes set in either.
+ */
+static inline ir_simd_mask_t Ir_SimdMaskOr(ir_simd_mask_t a,
+                                           ir_simd_mask_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_or_ps(a, b);
+#elif IR_SIMD_NEON
+    return vorrq_u32(a, b);
+#else
+    IR_SIMD_MAP(ir_simd_mask_t, a.lanes[i] | b.lanes[i]);
+#endif
+}
+
+/**
+ * @name SimdMaskBits
+ * @authors Israfiel
+ * @brief Gather a mask into an integer, lane i in bit i.
+ *
+ * @param mask - The mask.
+ * @returns The bits.
+ */
+static inline uint32_t Ir_SimdMaskBits(ir_simd_mask_t mask)
+{
+#if IR_SIMD_SSE
+    return (uint32_t)_mm_movemask_ps(mask);
+#elif IR_SIMD_NEON
+    static const uint32_t weights[4] = {1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(mask, vld1q_u32(weights)));
+#else
+    return (mask.lanes[0] & 1) | (mask.lanes[1] & 2) |
+           (mask.lanes[2] & 4) | (mask.lanes[3] & 8);
+#endif
+}
+
+/**
+ * @name SimdSelect
+ * @authors Israfiel
+ * @brief Pick each lane from one of two vectors.
+ *
+ * @param mask - Where set, the lane comes from a; elsewhere from b.
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns The result.
+ */
+static inline ir_simd_t Ir_SimdSelect(ir_simd_mask_t mask, ir_simd_t a,
+                                      ir_simd_t b)
+{
+#if IR_SIMD_SSE
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#elif IR_SIMD_NEON
+    return vbslq_f32(mask, a, b);
+#else
+    IR_SIMD_MAP(ir_simd_t, mask.lanes[i] ? a.lanes[i] : b.lanes[i]);
+#endif
+}
+
+/**
+ * @name SimdTranspose
+ * @authors Israfiel
+ * @brief Transpose four vectors as the rows of a 4x4 matrix, turning
+ * four lanes of four values into four values of four lanes.
+ *
+ * @param rows - The vectors, transposed in place.
+ */
+static inline void Ir_SimdTranspose(ir_simd_t rows[4])
+{
+#if IR_SIMD_SSE
+    _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+#elif IR_SIMD_NEON
+    float32x4x2_t low = vtrnq_f32(rows[0], rows[1]);
+    float32x4x2_t high = vtrnq_f32(rows[2], rows[3]);
+    rows[0] = vcombine_f32(vget_low_f32(low.val[0]),
+                           vget_low_f32(high.val[0]));
+    rows[1] = vcombine_f32(vget_low_f32(low.val[1]),
+                           vget_low_f32(high.val[1]));
+    rows[2] = vcombine_f32(vget_high_f32(low.val[0]),
+                           vget_high_f32(high.val[0]));
+    rows[3] = vcombine_f32(vget_high_f32(low.val[1]),
+                           vget_high_f32(high.val[1]));
+#else
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = i + 1; j < 4; ++j)
+        {
+            float swap = rows[i].lanes[j];
+            rows[i].lanes[j] = rows[j].lanes[i];
+            rows[j].lanes[i] = swap;
+        }
+    }
+#endif
+}
+
+#endif // IRIDIUM_MATH_SIMD_H
@@ -0,0 +1,241 @@
+/**
+ * @file Vector.h
+ * @authors Israfiel
+ * @brief Iridium's three-component vectors. These are for single
+ * vectors; code working on many at once should keep them SoA and use
+ * the four-wide vectors in SIMD.h instead.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_MATH_VECTOR_H
+#define IRIDIUM_MATH_VECTOR_H
+
+#include <math.h>
+
+/**
+ * @name ir_vec3_t
+ * @brief A three-component vector.
+ */
+typedef struct ir_vec3
+{
+    float x;
+    float y;
+    float z;
+} ir_vec3_t;
+
+/**
+ * @name Vec3
+ * @authors Israfiel
+ * @brief Make a vector.
+ *
+ * @param x - The x component.
+ * @param y - The y component.
+ * @param z - The z component.
+ * @returns The vector.
+ */
+static inline ir_vec3_t Ir_Vec3(float x, float y, float z)
+{
+    return (ir_vec3_t){x, y, z};
+}
+
+/**
+ * @name Vec3Add
+ * @authors Israfiel
+ * @brief Add two vectors.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns The sum.
+ */
+static inline ir_vec3_t Ir_Vec3Add(ir_vec3_t a, ir_vec3_t b)
+{
+    return (ir_vec3_t){a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+/**
+ * @name Vec3Sub
+ * @authors Israfiel
+ * @brief Subtract one vector from another.
+ *
+ * @param a - The vector.
+ * @param b - The vector to subtract.
+ * @returns The difference.
+ */
+static inline ir_vec3_t Ir_Vec3Sub(ir_vec3_t a, ir_vec3_t b)
+{
+    return (ir_vec3_t){a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+/**
+ * @name Vec3Scale
+ * @authors Israfiel
+ * @brief Scale a vector.
+ *
+ * @param a - The vector.
+ * @param scale - The scale.
+ * @returns The scaled vector.
+ */
+static inline ir_vec3_t Ir_Vec3Scale(ir_vec3_t a, float scale)
+{
+    return (ir_vec3_t){a.x * scale, a.y * scale, a.z * scale};
+}
+
+/**
+ * @name Vec3Negate
+ * @authors Israfiel
+ * @brief Flip a vector.
+ *
+ * @param a - The vector.
+ * @returns The flipped vector.
+ */
+static inline ir_vec3_t Ir_Vec3Negate(ir_vec3_t a)
+{
+    return (ir_vec3_t){-a.x, -a.y, -a.z};
+}
+
+/**
+ * @name Vec3Min
+ * @authors Israfiel
+ * @brief Take the lesser of each pair of components.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns The minimum.
+ */
+static inline ir_vec3_t Ir_Vec3Min(ir_vec3_t a, ir_vec3_t b)
+{
+    return (ir_vec3_t){a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y,
+                       a.z < b.z ? a.z : b.z};
+}
+
+/**
+ * @name Vec3Max
+ * @authors Israfiel
+ * @brief Take the greater of each pair of components.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns The maximum.
+ */
+static inline ir_vec3_t Ir_Vec3Max(ir_vec3_t a, ir_vec3_t b)
+{
+    return (ir_vec3_t){a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y,
+                       a.z > b.z ? a.z : b.z};
+}
+
+/**
+ * @name Vec3Dot
+ * @authors Israfiel
+ * @brief Take the dot product of two vectors.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns The dot product.
+ */
+static inline float Ir_Vec3Dot(ir_vec3_t a, ir_vec3_t b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+/**
+ * @name Vec3Cross
+ * @authors Israfiel
+ * @brief Take the cross product of two vectors.
+ *
+ * @param a - The first vector.
+ * @param b - The second vector.
+ * @returns The cross product.
+ */
+static inline ir_vec3_t Ir_Vec3Cross(ir_vec3_t a, ir_vec3_t b)
+{
+    return (ir_vec3_t){a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+                       a.x * b.y - a.y * b.x};
+}
+
+/**
+ * @name Vec3LengthSquared
+ * @authors Israfiel
+ * @brief Get a vector's squared length.
+ *
+ * @param a - The vector.
+ * @returns The squared length.
+ */
+static inline float Ir_Vec3LengthSquared(ir_vec3_t a)
+{
+    return Ir_Vec3Dot(a, a);
+}
+
+/**
+ * @name Vec3Length
+ * @authors Israfiel
+ * @brief Get a vector's length.
+ *
+ * @param a - The vector.
+ * @returns The length.
+ */
+static inline float Ir_Vec3Length(ir_vec3_t a)
+{
+    return sqrtf(Ir_Vec3Dot(a, a));
+}
+
+/**
+ * @name Vec3Normalize
+ * @authors Israfiel
+ * @brief Scale a vector to unit length.
+ *
+ * @param a - The vector.
+ * @param fallback - What to return if the vector is nearly zero.
+ * @returns The unit vector.
+ */
+static inline ir_vec3_t Ir_Vec3Normalize(ir_vec3_t a, ir_vec3_t fallback)
+{
+    float length = Ir_Vec3Length(a);
+    if (length < 1e-12f) return fallback;
+    return Ir_Vec3Scale(a, 1.0f / length);
+}
+
+/**
+ * @name Vec3Tangents
+ * @authors Israfiel
+ * @brief Build two unit tangents to a unit normal, such that the first
+ * crossed with the second is the normal. They depend only on the
+ * normal, and change smoothly with it everywhere but one boundary well
+ * away from the y axis, so a wobbling upright normal, which is most
+ * resting contacts, keeps nearly the same tangents.
+ *
+ * @param n - The unit normal.
+ * @param t1 - Filled with the first tangent.
+ * @param t2 - Filled with the second tangent.
+ */
+static inline void Ir_Vec3Tangents(ir_vec3_t n, ir_vec3_t *t1,
+                                   ir_vec3_t *t2)
+{
+    // The boundary is where |x| is 1 / sqrt(3), where neither
+    // construction is close to degenerate.
+    if (fabsf(n.x) >= 0.57735f)
+        *t1 = Ir_Vec3Scale((ir_vec3_t){n.y, -n.x, 0.0f},
+                           1.0f / sqrtf(n.x * n.x + n.y * n.y));
+    else
+        *t1 = Ir_Vec3Scale((ir_vec3_t){0.0f, n.z, -n.y},
+                           1.0f / sqrtf(n.y * n.y + n.z * n.z));
+    *t2 = Ir_Vec3Cross(n, *t1);
+}
+
+/**
+ * @name Vec3Component
+ * @authors Israfiel
+ * @brief Read a component by index, zero through two.
+ *
+ * @param a - The vector.
+ * @param axis - The component's index.
+ * @returns The component.
+ */
+static inline float Ir_Vec3Component(ir_vec3_t a, int axis)
+{
+    return axis == 0 ? a.x : axis == 1 ? a.y : a.z;
+}
+
+#endif // IRIDIUM_MATH_VECTOR_H
@@ -0,0 +1,556 @@
+/**
+ * @file Particles.c
+ * @authors Israfiel
+ * @brief Implements Iridium's particles.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Particles.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+#include "Math/SIMD.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name ir_particle_batch_t
+ * @brief The blocks an update or write is working through.
+ */
+typedef struct ir_particle_batch
+{
+    ir_particle_system_t *system;
+    float delta;
+    ir_particle_instance_t *instances;
+    uint32_t capacity;
+} ir_particle_batch_t;
+
+/**
+ * @name Acquire
+ * @authors Israfiel
+ * @brief Give an emitter an empty block from the pool.
+ *
+ * @param system - The system.
+ * @param emitter - The emitter.
+ * @returns The block, or NULL if the pool is empty.
+ */
+static ir_particle_block_t *Acquire(ir_particle_system_t *system,
+                                    ir_particle_emitter_t *emitter)
+{
+    if (system->free_count == 0) return NULL;
+    uint32_t index = system->free[--system->free_count];
+    emitter->blocks[emitter->block_count++] = index;
+    system->blocks[index].count = 0;
+    return &system->blocks[index];
+}
+
+/**
+ * @name Release
+ * @authors Israfiel
+ * @brief Return an emitter's last block to the pool.
+ *
+ * @param system - The system.
+ * @param emitter - The emitter.
+ */
+static void Release(ir_particle_system_t *system,
+                    ir_particle_emitter_t *emitter)
+{
+    uint32_t index = emitter->blocks[--emitter->block_count];
+    system->blocks[index].count = 0;
+    system->free[system->free_count++] = index;
+}
+
+/**
+ * @name Spawn
+ * @authors Israfiel
+ * @brief Give off a particle into a block.
+ *
+ * @param emitter - The emitter.
+ * @param block - The block.
+ * @param slot - Where in the block to put it.
+ */
+static void Spawn(ir_particle_emitter_t *emitter,
+                  ir_particle_block_t *block, uint32_t slot)
+{
+    // Rejecting points outside the unit ball leaves every direction and
+    // speed up to the spread as likely as the next, where normalising
+    // would bunch them towards the cube's corners.
+    ir_random_t *random = &emitter->random;
+    ir_vec3_t direction;
+    do
+    {
+        direction = Ir_Vec3(2.0f * Ir_RandomFloat(random) - 1.0f,
+                            2.0f * Ir_RandomFloat(random) - 1.0f,
+                            2.0f * Ir_RandomFloat(random) - 1.0f);
+    } while (Ir_Vec3LengthSquared(direction) > 1.0f);
+    ir_vec3_t velocity = Ir_Vec3Add(
+        emitter->velocity, Ir_Vec3Scale(direction, emitter->spread));
+    float lifetime =
+        emitter->lifetime + emitter->lifetime_spread *
+                                (2.0f * Ir_RandomFloat(random) - 1.0f);
+
+    float (*channels)[IR_PARTICLE_BLOCK] = block->channels;
+    channels[IR_PARTICLE_POSITION_X][slot] = emitter->position.x;
+    channels[IR_PARTICLE_POSITION_Y][slot] = emitter->position.y;
+    channels[IR_PARTICLE_POSITION_Z][slot] = emitter->position.z;
+    channels[IR_PARTICLE_VELOCITY_X][slot] = velocity.x;
+    channels[IR_PARTICLE_VELOCITY_Y][slot] = velocity.y;
+    channels[IR_PARTICLE_VELOCITY_Z][slot] = velocity.z;
+    channels[IR_PARTICLE_AGE][slot] = 0.0f;
+    channels[IR_PARTICLE_LIFETIME][slot] = fmaxf(lifetime, 0.0f);
+    channels[IR_PARTICLE_SIZE][slot] = emitter->size;
+}
+
+/**
+ * @name Emit
+ * @authors Israfiel
+ * @brief Give off an emitter's particles for a step, filling its last
+ * block before taking another.
+ *
+ * @param system - The system.
+ * @param emitter - The emitter.
+ * @param delta - The time stepped, in seconds.
+ */
+static void Emit(ir_particle_system_t *system,
+                 ir_particle_emitter_t *emitter, float delta)
+{
+    emitter->pending += fmaxf(emitter->rate, 0.0f) * delta;
+    uint32_t spawn = (uint32_t)emitter->pending;
+    emitter->pending -= (float)spawn;
+
+    while (spawn > 0)
+    {
+        uint32_t last = emitter->block_count - 1;
+        ir_particle_block_t *block =
+            emitter->block_count == 0
+                ? NULL
+                : &system->blocks[emitter->blocks[last]];
+        if (block == NULL || block->count == IR_PARTICLE_BLOCK)
+            block = Acquire(system, emitter);
+        if (block == NULL)
+        {
+            emitter->pending = 0.0f;
+            return;
+        }
+
+        uint32_t room = IR_PARTICLE_BLOCK - block->count;
+        uint32_t count = spawn < room ? spawn : room;
+        for (uint32_t i = 0; i < count; ++i)
+            Spawn(emitter, block, block->count + i);
+        block->count += count;
+        spawn -= count;
+    }
+}
+
+/**
+ * @name Dot
+ * @authors Israfiel
+ * @brief Take the dot products of four vectors with a vector.
+ *
+ * @param a - The vector, each axis splatted.
+ * @param b - The four vectors, an axis at a time.
+ * @returns The dot products.
+ */
+static ir_simd_t Dot(const ir_simd_t a[3], const ir_simd_t b[3])
+{
+    ir_simd_t dot = Ir_SimdMul(a[0], b[0]);
+    dot = Ir_SimdMulAdd(a[1], b[1], dot);
+    return Ir_SimdMulAdd(a[2], b[2], dot);
+}
+
+/**
+ * @name Simulate
+ * @authors Israfiel
+ * @brief Move a block's particles on a step, then swap each that died
+ * with the block's last.
+ *
+ * @param system - The system.
+ * @param block - The block.
+ * @param delta - The time stepped, in seconds.
+ */
+static void Simulate(const ir_particle_system_t *system,
+                     ir_particle_block_t *block, float delta)
+{
+    float (*channels)[IR_PARTICLE_BLOCK] = block->channels;
+    ir_simd_t step = Ir_SimdSplat(delta);
+    ir_simd_t zero = Ir_SimdSplat(0.0f);
+    ir_simd_t damping = Ir_SimdSplat(fmaxf(1.0f - system->drag * delta,
+                                           0.0f));
+    ir_simd_t gravity[3] = {Ir_SimdSplat(system->gravity.x * delta),
+                            Ir_SimdSplat(system->gravity.y * delta),
+                            Ir_SimdSplat(system->gravity.z * delta)};
+
+    // A particle hitting a plane keeps 1 - friction of its velocity
+    // along the plane and turns restitution of it into the plane back
+    // out, so the velocity becomes v * keep - n * vn * (keep + bounce).
+    ir_simd_t planes[IR_PARTICLE_PLANES][4];
+    for (uint32_t i = 0; i < system->plane_count; ++i)
+    {
+        const ir_particle_plane_t *plane = &system->planes[i];
+        planes[i][0] = Ir_SimdSplat(plane->normal.x);
+        planes[i][1] = Ir_SimdSplat(plane->normal.y);
+        planes[i][2] = Ir_SimdSplat(plane->normal.z);
+        planes[i][3] = Ir_SimdSplat(plane->distance);
+    }
+    float keep = 1.0f - system->friction;
+    ir_simd_t kept = Ir_SimdSplat(keep);
+    ir_simd_t reflected = Ir_SimdSplat(keep + system->restitution);
+
+    // Lanes past the block's count are moved along with the rest; they
+    // hold nothing anyone reads, and aren't counted as dying.
+    uint32_t count = block->count;
+    uint32_t dead = 0;
+    for (uint32_t i = 0; i < count; i += IR_SIMD_WIDTH)
+    {
+        ir_simd_t position[3], velocity[3];
+        for (int j = 0; j < 3; ++j)
+        {
+            velocity[j] = Ir_SimdMulAdd(
+                Ir_SimdLoad(&channels[IR_PARTICLE_VELOCITY_X + j][i]),
+                damping, gravity[j]);
+            position[j] = Ir_SimdMulAdd(
+                velocity[j], step,
+                Ir_SimdLoad(&channels[IR_PARTICLE_POSITION_X + j][i]));
+        }
+
+        for (uint32_t p = 0; p < system->plane_count; ++p)
+        {
+            const ir_simd_t *n = planes[p];
+            ir_simd_t depth = Ir_SimdSub(Dot(n, position), n[3]);
+            ir_simd_t speed = Dot(n, velocity);
+            ir_simd_mask_t hit = Ir_SimdMaskAnd(Ir_SimdLess(depth, zero),
+                                                Ir_SimdLess(speed, zero));
+            ir_simd_t inside = Ir_SimdMin(depth, zero);
+            ir_simd_t bounce = Ir_SimdMul(speed, reflected);
+            for (int j = 0; j < 3; ++j)
+            {
+                position[j] = Ir_SimdSub(position[j],
+                                         Ir_SimdMul(n[j], inside));
+                ir_simd_t response =
+                    Ir_SimdSub(Ir_SimdMul(velocity[j], kept),
+                               Ir_SimdMul(n[j], bounce));
+                velocity[j] = Ir_SimdSelect(hit, response, velocity[j]);
+            }
+        }
+
+        ir_simd_t age = Ir_SimdAdd(
+            Ir_SimdLoad(&channels[IR_PARTICLE_AGE][i]), step);
+        ir_simd_mask_t died = Ir_SimdLessEqual(
+            Ir_SimdLoad(&channels[IR_PARTICLE_LIFETIME][i]), age);
+        uint32_t lanes = count - i < IR_SIMD_WIDTH ? count - i
+                                                   : IR_SIMD_WIDTH;
+        dead |= Ir_SimdMaskBits(died) & ((1u << lanes) - 1);
+
+        for (int j = 0; j < 3; ++j)
+        {
+            Ir_SimdStore(&channels[IR_PARTICLE_POSITION_X + j][i],
+                         position[j]);
+            Ir_SimdStore(&channels[IR_PARTICLE_VELOCITY_X + j][i],
+                         velocity[j]);
+        }
+        Ir_SimdStore(&channels[IR_PARTICLE_AGE][i], age);
+    }
+    if (dead == 0) return;
+
+    for (uint32_t i = 0; i < count;)
+    {
+        if (channels[IR_PARTICLE_AGE][i] <
+            channels[IR_PARTICLE_LIFETIME][i])
+        {
+            ++i;
+            continue;
+        }
+        --count;
+        for (int j = 0; j < IR_PARTICLE_CHANNELS; ++j)
+            channels[j][i] = channels[j][count];
+    }
+    block->count = count;
+}
+
+/**
+ * @name SimulateBlocks
+ * @authors Israfiel
+ * @brief Move a range of the work's blocks on a step.
+ *
+ * @param user - The batch.
+ * @param begin - The first block in the work.
+ * @param end - One past the last.
+ */
+static void SimulateBlocks(void *user, size_t begin, size_t end)
+{
+    ir_particle_batch_t *batch = user;
+    ir_particle_system_t *system = batch->system;
+    for (size_t i = begin; i < end; ++i)
+        Simulate(system, &system->blocks[system->work[i]], batch->delta);
+}
+
+/**
+ * @name Pack
+ * @authors Israfiel
+ * @brief Move particles from an emitter's last block into the room its
+ * earlier blocks have, returning each block emptied to the pool, so all
+ * but its last block are full again.
+ *
+ * @param system - The system.
+ * @param emitter - The emitter.
+ * @returns The number of particles it has.
+ */
+static uint32_t Pack(ir_particle_system_t *system,
+                     ir_particle_emitter_t *emitter)
+{
+    uint32_t first = 0;
+    while (emitter->block_count > 0)
+    {
+        uint32_t last = emitter->block_count - 1;
+        ir_particle_block_t *source =
+            &system->blocks[emitter->blocks[last]];
+        if (source->count == 0)
+        {
+            Release(system, emitter);
+            continue;
+        }
+        while (first < last &&
+               system->blocks[emitter->blocks[first]].count ==
+                   IR_PARTICLE_BLOCK)
+            ++first;
+        if (first == last) break;
+
+        ir_particle_block_t *target =
+            &system->blocks[emitter->blocks[first]];
+        uint32_t room = IR_PARTICLE_BLOCK - target->count;
+        uint32_t moved = source->count < room ? source->count : room;
+        source->count -= moved;
+        for (int j = 0; j < IR_PARTICLE_CHANNELS; ++j)
+            memcpy(&target->channels[j][target->count],
+                   &source->channels[j][source->count],
+                   moved * sizeof(float));
+        target->count += moved;
+    }
+
+    if (emitter->block_count == 0) return 0;
+    uint32_t last = emitter->blocks[emitter->block_count - 1];
+    return (emitter->block_count - 1) * IR_PARTICLE_BLOCK +
+           system->blocks[last].count;
+}
+
+/**
+ * @name Gather
+ * @authors Israfiel
+ * @brief List every emitter's blocks as the work, each with where its
+ * particles start among all of them.
+ *
+ * @param system - The system.
+ * @param emitters - The emitters.
+ * @param count - The number of emitters.
+ * @returns The number of particles.
+ */
+static uint32_t Gather(ir_particle_system_t *system,
+                       const ir_particle_emitter_t *emitters,
+                       uint32_t count)
+{
+    uint32_t blocks = 0, particles = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const ir_particle_emitter_t *emitter = &emitters[i];
+        for (uint32_t j = 0; j < emitter->block_count; ++j)
+        {
+            uint32_t index = emitter->blocks[j];
+            system->work[blocks] = index;
+            system->offsets[blocks++] = particles;
+            particles += system->blocks[index].count;
+        }
+    }
+    system->work_count = blocks;
+    return particles;
+}
+
+/**
+ * @name Write
+ * @authors Israfiel
+ * @brief Write a block's leading particles out as instances, four at a
+ * time, transposed from the block's arrays into whole instances.
+ *
+ * @param block - The block.
+ * @param instances - Where its first instance goes.
+ * @param count - The number of particles to write.
+ */
+static void Write(const ir_particle_block_t *block,
+                  ir_particle_instance_t *instances, uint32_t count)
+{
+    const float (*channels)[IR_PARTICLE_BLOCK] = block->channels;
+    uint32_t i = 0;
+    for (; i + IR_SIMD_WIDTH <= count; i += IR_SIMD_WIDTH)
+    {
+        ir_simd_t shape[4] = {
+            Ir_SimdLoad(&channels[IR_PARTICLE_POSITION_X][i]),
+            Ir_SimdLoad(&channels[IR_PARTICLE_POSITION_Y][i]),
+            Ir_SimdLoad(&channels[IR_PARTICLE_POSITION_Z][i]),
+            Ir_SimdLoad(&channels[IR_PARTICLE_SIZE][i]),
+        };
+        ir_simd_t motion[4] = {
+            Ir_SimdLoad(&channels[IR_PARTICLE_VELOCITY_X][i]),
+            Ir_SimdLoad(&channels[IR_PARTICLE_VELOCITY_Y][i]),
+            Ir_SimdLoad(&channels[IR_PARTICLE_VELOCITY_Z][i]),
+            Ir_SimdDiv(Ir_SimdLoad(&channels[IR_PARTICLE_AGE][i]),
+                       Ir_SimdLoad(&channels[IR_PARTICLE_LIFETIME][i])),
+        };
+        Ir_SimdTranspose(shape);
+        Ir_SimdTranspose(motion);
+        for (int j = 0; j < IR_SIMD_WIDTH; ++j)
+        {
+            float *instance = (float *)&instances[i + j];
+            Ir_SimdStore(instance, shape[j]);
+            Ir_SimdStore(instance + 4, motion[j]);
+        }
+    }
+    for (; i < count; ++i)
+    {
+        instances[i] = (ir_particle_instance_t){
+            {channels[IR_PARTICLE_POSITION_X][i],
+             channels[IR_PARTICLE_POSITION_Y][i],
+             channels[IR_PARTICLE_POSITION_Z][i]},
+            channels[IR_PARTICLE_SIZE][i],
+            {channels[IR_PARTICLE_VELOCITY_X][i],
+             channels[IR_PARTICLE_VELOCITY_Y][i],
+             channels[IR_PARTICLE_VELOCITY_Z][i]},
+            channels[IR_PARTICLE_AGE][i] /
+                channels[IR_PARTICLE_LIFETIME][i],
+        };
+    }
+}
+
+/**
+ * @name WriteBlocks
+ * @authors Israfiel
+ * @brief Write a range of the work's blocks out as instances.
+ *
+ * @param user - The batch.
+ * @param begin - The first block in the work.
+ * @param end - One past the last.
+ */
+static void WriteBlocks(void *user, size_t begin, size_t end)
+{
+    ir_particle_batch_t *batch = user;
+    const ir_particle_system_t *system = batch->system;
+    for (size_t i = begin; i < end; ++i)
+    {
+        uint32_t offset = system->offsets[i];
+        if (offset >= batch->capacity) break;
+        const ir_particle_block_t *block =
+            &system->blocks[system->work[i]];
+        uint32_t room = batch->capacity - offset;
+        Write(block, &batch->instances[offset],
+              block->count < room ? block->count : room);
+    }
+}
+
+bool Ir_ParticleSystemCreate(ir_particle_system_t *system,
+                             uint32_t blocks)
+{
+    *system = (ir_particle_system_t){
+        .blocks = calloc(blocks, sizeof(ir_particle_block_t)),
+        .block_count = blocks,
+        .free = malloc(blocks * sizeof(uint32_t)),
+        .work = malloc(blocks * sizeof(uint32_t)),
+        .offsets = malloc(blocks * sizeof(uint32_t)),
+    };
+    if (system->blocks == NULL || system->free == NULL ||
+        system->work == NULL || system->offsets == NULL)
+    {
+        IR_LOG_ERROR("Ran out of memory pooling %u particle blocks.",
+                     blocks);
+        Ir_ParticleSystemDestroy(system);
+        return false;
+    }
+
+    // Blocks are handed out from the end of the free list, so listing
+    // them backwards hands out the pool's first blocks first.
+    for (uint32_t i = 0; i < blocks; ++i)
+        system->free[i] = blocks - 1 - i;
+    system->free_count = blocks;
+    return true;
+}
+
+void Ir_ParticleSystemDestroy(ir_particle_system_t *system)
+{
+    free(system->blocks);
+    free(system->free);
+    free(system->work);
+    free(system->offsets);
+    *system = (ir_particle_system_t){0};
+}
+
+bool Ir_ParticleEmitterCreate(const ir_particle_system_t *system,
+                              ir_particle_emitter_t *emitter,
+                              uint64_t seed)
+{
+    // An emitter can hold at most every block in the pool, so its list
+    // is sized for that once rather than grown while emitting.
+    *emitter = (ir_particle_emitter_t){
+        .lifetime = 1.0f,
+        .size = 1.0f,
+        .blocks = malloc(system->block_count * sizeof(uint32_t)),
+    };
+    if (emitter->blocks == NULL)
+    {
+        IR_LOG_ERROR("Ran out of memory holding %u particle blocks.",
+                     system->block_count);
+        return false;
+    }
+    Ir_RandomSeed(&emitter->random, seed, 0);
+    return true;
+}
+
+void Ir_ParticleEmitterDestroy(ir_particle_system_t *system,
+                               ir_particle_emitter_t *emitter)
+{
+    while (emitter->block_count > 0) Release(system, emitter);
+    free(emitter->blocks);
+    *emitter = (ir_particle_emitter_t){0};
+}
+
+uint32_t Ir_ParticlesUpdate(ir_particle_system_t *system,
+                            ir_particle_emitter_t *emitters,
+                            uint32_t count, float delta, ir_jobs_t *jobs)
+{
+    IR_PROFILE_BEGIN("Particles");
+    for (uint32_t i = 0; i < count; ++i)
+        Emit(system, &emitters[i], delta);
+
+    Gather(system, emitters, count);
+    ir_particle_batch_t batch = {system, delta};
+    if (jobs != NULL)
+        Ir_JobsParallelFor(jobs, system->work_count, IR_PARTICLE_GRAIN,
+                           SimulateBlocks, &batch);
+    else SimulateBlocks(&batch, 0, system->work_count);
+
+    uint32_t live = 0;
+    for (uint32_t i = 0; i < count; ++i)
+        live += Pack(system, &emitters[i]);
+    IR_PROFILE_COUNTER("Live Particles", live);
+    IR_PROFILE_END("Particles");
+    return live;
+}
+
+uint32_t Ir_ParticlesWrite(ir_particle_system_t *system,
+                           const ir_particle_emitter_t *emitters,
+                           uint32_t count,
+                           ir_particle_instance_t *instances,
+                           uint32_t capacity, ir_jobs_t *jobs)
+{
+    IR_PROFILE_BEGIN("Particle Instances");
+    uint32_t particles = Gather(system, emitters, count);
+    ir_particle_batch_t batch = {system, 0.0f, instances, capacity};
+    if (jobs != NULL)
+        Ir_JobsParallelFor(jobs, system->work_count, IR_PARTICLE_GRAIN,
+                           WriteBlocks, &batch);
+    else WriteBlocks(&batch, 0, system->work_count);
+    IR_PROFILE_END("Particle Instances");
+    return particles < capacity ? particles : capacity;
+}
@@ -0,0 +1,310 @@
+/**
+ * @file Particles.h
+ * @authors Israfiel
+ * @brief Iridium's particles. Every particle lives in a block of
+ * IR_PARTICLE_BLOCK, each of its values in its own array, and every
+ * block comes from one pool shared by all a system's emitters, so a
+ * burst of smoke never allocates. An emitter's particles are kept packed
+ * into as few of its blocks as will hold them: a particle that dies has
+ * the block's last particle moved into its place, and when a block has
+ * room, particles are moved into it from the emitter's last block, which
+ * goes back to the pool once it's empty.
+ *
+ * Forces and collisions run four particles at a time over every block,
+ * and the work is spread over jobs by blocks rather than by emitter, so
+ * one large effect doesn't hold up the frame. The live particles are
+ * then written straight into the renderer's mapped instance buffer,
+ * which is only ever written, in order, a whole instance at a time, as
+ * memory the GPU reads should be.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PARTICLES_PARTICLES_H
+#define IRIDIUM_PARTICLES_PARTICLES_H
+
+#include "Core/Jobs.h"
+#include "Core/Random.h"
+#include "Math/Vector.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_PARTICLE_BLOCK
+ * @brief The number of particles in a block, a whole number of
+ * IR_SIMD_WIDTH.
+ */
+#define IR_PARTICLE_BLOCK 256
+
+/**
+ * @name IR_PARTICLE_PLANES
+ * @brief The most planes particles collide with.
+ */
+#define IR_PARTICLE_PLANES 4
+
+/**
+ * @name IR_PARTICLE_GRAIN
+ * @brief The number of blocks each job simulates or writes.
+ */
+#define IR_PARTICLE_GRAIN 8
+
+/**
+ * @name ir_particle_channel_t
+ * @brief The values each particle has, one array of them a block.
+ */
+typedef enum ir_particle_channel
+{
+    IR_PARTICLE_POSITION_X,
+    IR_PARTICLE_POSITION_Y,
+    IR_PARTICLE_POSITION_Z,
+    IR_PARTICLE_VELOCITY_X,
+    IR_PARTICLE_VELOCITY_Y,
+    IR_PARTICLE_VELOCITY_Z,
+    /**
+     * @name IR_PARTICLE_AGE
+     * @brief How long the particle has lived, in seconds.
+     */
+    IR_PARTICLE_AGE,
+    /**
+     * @name IR_PARTICLE_LIFETIME
+     * @brief How long the particle lives, in seconds.
+     */
+    IR_PARTICLE_LIFETIME,
+    IR_PARTICLE_SIZE,
+    IR_PARTICLE_CHANNELS
+} ir_particle_channel_t;
+
+/**
+ * @name ir_particle_block_t
+ * @brief A block of particles, the live ones first.
+ */
+typedef struct ir_particle_block
+{
+    float channels[IR_PARTICLE_CHANNELS][IR_PARTICLE_BLOCK];
+    uint32_t count;
+} ir_particle_block_t;
+
+/**
+ * @name ir_particle_plane_t
+ * @brief A plane particles can't pass through, keeping them on the side
+ * its normal faces.
+ */
+typedef struct ir_particle_plane
+{
+    /**
+     * @name normal
+     * @brief The plane's unit normal.
+     */
+    ir_vec3_t normal;
+    /**
+     * @name distance
+     * @brief How far the plane is from the origin along its normal.
+     */
+    float distance;
+} ir_particle_plane_t;
+
+/**
+ * @name ir_particle_instance_t
+ * @brief A live particle as the renderer draws it, two vectors of four
+ * floats as a vertex shader would read them.
+ */
+typedef struct ir_particle_instance
+{
+    float position[3];
+    float size;
+    float velocity[3];
+    /**
+     * @name life
+     * @brief How far through its lifetime the particle is, from zero at
+     * birth to one at death.
+     */
+    float life;
+} ir_particle_instance_t;
+
+/**
+ * @name ir_particle_emitter_t
+ * @brief Something giving off particles. Set its fields freely between
+ * updates.
+ */
+typedef struct ir_particle_emitter
+{
+    ir_vec3_t position;
+    /**
+     * @name velocity
+     * @brief The velocity particles leave with, before spread.
+     */
+    ir_vec3_t velocity;
+    /**
+     * @name spread
+     * @brief The fastest a particle leaves in a random direction on top
+     * of its velocity.
+     */
+    float spread;
+    /**
+     * @name rate
+     * @brief How many particles it gives off a second.
+     */
+    float rate;
+    float lifetime;
+    /**
+     * @name lifetime_spread
+     * @brief The most a particle's lifetime differs from the lifetime,
+     * either way.
+     */
+    float lifetime_spread;
+    float size;
+    /**
+     * @name pending
+     * @brief The part of a particle owed from the last update.
+     */
+    float pending;
+    ir_random_t random;
+    /**
+     * @name blocks
+     * @brief Its blocks' indices within the pool, all but the last full,
+     * with room for every block in the pool.
+     */
+    uint32_t *blocks;
+    uint32_t block_count;
+} ir_particle_emitter_t;
+
+/**
+ * @name ir_particle_system_t
+ * @brief A pool of blocks and the forces and planes acting on every
+ * particle in them. Set the forces and planes freely between updates.
+ */
+typedef struct ir_particle_system
+{
+    ir_vec3_t gravity;
+    /**
+     * @name drag
+     * @brief How much of its velocity a particle loses a second.
+     */
+    float drag;
+    ir_particle_plane_t planes[IR_PARTICLE_PLANES];
+    uint32_t plane_count;
+    /**
+     * @name restitution
+     * @brief How much of its speed into a plane a particle bounces back
+     * with.
+     */
+    float restitution;
+    /**
+     * @name friction
+     * @brief How much of its speed along a plane a particle loses each
+     * time it hits one.
+     */
+    float friction;
+    ir_particle_block_t *blocks;
+    uint32_t block_count;
+    /**
+     * @name free
+     * @brief The indices of the blocks no emitter holds.
+     */
+    uint32_t *free;
+    uint32_t free_count;
+    /**
+     * @name work
+     * @brief Every block being updated or written, emitter by emitter.
+     */
+    uint32_t *work;
+    /**
+     * @name offsets
+     * @brief Where each block in the work starts in the instance buffer.
+     */
+    uint32_t *offsets;
+    uint32_t work_count;
+} ir_particle_system_t;
+
+/**
+ * @name ParticleSystemCreate
+ * @authors Israfiel
+ * @brief Create a particle system with no forces and no planes.
+ *
+ * @param system - The system.
+ * @param blocks - The number of blocks in its pool, bounding how many
+ * particles it can hold.
+ * @returns Whether there was memory for it.
+ */
+bool Ir_ParticleSystemCreate(ir_particle_system_t *system,
+                             uint32_t blocks);
+
+/**
+ * @name ParticleSystemDestroy
+ * @authors Israfiel
+ * @brief Free a particle system. Destroy its emitters first.
+ *
+ * @param system - The system.
+ */
+void Ir_ParticleSystemDestroy(ir_particle_system_t *system);
+
+/**
+ * @name ParticleEmitterCreate
+ * @authors Israfiel
+ * @brief Create an emitter giving off nothing, with no particles.
+ *
+ * @param system - The system it emits into.
+ * @param emitter - The emitter.
+ * @param seed - The seed of its particles' randomness.
+ * @returns Whether there was memory for it.
+ */
+bool Ir_ParticleEmitterCreate(const ir_particle_system_t *system,
+                              ir_particle_emitter_t *emitter,
+                              uint64_t seed);
+
+/**
+ * @name ParticleEmitterDestroy
+ * @authors Israfiel
+ * @brief Free an emitter, returning its blocks to the pool.
+ *
+ * @param system - The system it emits into.
+ * @param emitter - The emitter.
+ */
+void Ir_ParticleEmitterDestroy(ir_particle_system_t *system,
+                               ir_particle_emitter_t *emitter);
+
+/**
+ * @name ParticlesUpdate
+ * @authors Israfiel
+ * @brief Give off each emitter's particles, then move every particle
+ * and remove those that have died. When the pool runs dry, emitters
+ * give off nothing until blocks come back to it.
+ *
+ * @param system - The system.
+ * @param emitters - The emitters.
+ * @param count - The number of emitters.
+ * @param delta - The time to step, in seconds.
+ * @param jobs - The pool to update with, or NULL to update on the
+ * calling thread.
+ * @returns The number of live particles.
+ */
+uint32_t Ir_ParticlesUpdate(ir_particle_system_t *system,
+                            ir_particle_emitter_t *emitters,
+                            uint32_t count, float delta, ir_jobs_t *jobs);
+
+/**
+ * @name ParticlesWrite
+ * @authors Israfiel
+ * @brief Write every live particle into an instance buffer, emitter by
+ * emitter, such as one mapped for the renderer.
+ *
+ * @param system - The system.
+ * @param emitters - The emitters.
+ * @param count - The number of emitters.
+ * @param instances - The buffer, which is only written.
+ * @param capacity - The most instances it holds. Particles past it
+ * aren't written.
+ * @param jobs - The pool to write with, or NULL to write on the calling
+ * thread.
+ * @returns The number of instances written.
+ */
+uint32_t Ir_ParticlesWrite(ir_particle_system_t *system,
+                           const ir_particle_emitter_t *emitters,
+                           uint32_t count,
+                           ir_particle_instance_t *instances,
+                           uint32_t capacity, ir_jobs_t *jobs);
+
+#endif // IRIDIUM_PARTICLES_PARTICLES_H
@@ -0,0 +1,514 @@
+/**
+ * @file Broadphase.c
+ * @authors Israfiel
+ * @brief Implements Iridium's broadphase.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Broadphase.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+#include "Math/SIMD.h"
+#include "Physics/Sort.h"
+
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name REPAIR_BUDGET
+ * @brief The most swaps per proxy repairing the order may take before
+ * it's cheaper to radix-sort from scratch.
+ */
+#define REPAIR_BUDGET 4
+
+/**
+ * @name AXIS_HYSTERESIS
+ * @brief How much more spread out another axis must be before sweeping
+ * along it, so the axis doesn't flip back and forth between updates.
+ */
+#define AXIS_HYSTERESIS 1.25
+
+/**
+ * @name SortableKey
+ * @authors Israfiel
+ * @brief Map a float to an integer with the same order.
+ *
+ * @param value - The float.
+ * @returns The integer.
+ */
+static uint32_t SortableKey(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+}
+
+/**
+ * @name KeyShift
+ * @authors Israfiel
+ * @brief Get the bits needed to hold any proxy's number.
+ *
+ * @param count - The number of proxies.
+ * @returns The bits.
+ */
+static uint32_t KeyShift(uint32_t count)
+{
+    return count < 2 ? 1 : 32 - (uint32_t)__builtin_clz(count - 1);
+}
+
+/**
+ * @name Reserve
+ * @authors Israfiel
+ * @brief Grow a broadphase's per-proxy arrays.
+ *
+ * @param broadphase - The broadphase.
+ * @param capacity - The number of proxies to make room for.
+ * @returns Whether the arrays were grown.
+ */
+static bool Reserve(ir_broadphase_t *broadphase, uint32_t capacity)
+{
+    size_t padded = (size_t)capacity + IR_SIMD_WIDTH;
+    float *bounds = malloc(6 * capacity * sizeof(float));
+    float *sorted = malloc(6 * padded * sizeof(float));
+    uint32_t *order = malloc(capacity * sizeof(uint32_t));
+    uint32_t *free_list = malloc(capacity * sizeof(uint32_t));
+    uint64_t *scratch = malloc(2 * capacity * sizeof(uint64_t));
+    if (bounds == NULL || sorted == NULL || order == NULL ||
+        free_list == NULL || scratch == NULL)
+    {
+        free(bounds);
+        free(sorted);
+        free(order);
+        free(free_list);
+        free(scratch);
+        return false;
+    }
+
+    for (int i = 0; i < 6; ++i)
+    {
+        if (broadphase->count != 0)
+            memcpy(bounds + i * capacity, broadphase->bounds[i],
+                   broadphase->count * sizeof(float));
+    }
+    free(broadphase->bounds[0]);
+    free(broadphase->sorted[0]);
+    for (int i = 0; i < 6; ++i)
+    {
+        broadphase->bounds[i] = bounds + i * capacity;
+        broadphase->sorted[i] = sorted + i * padded;
+    }
+    if (broadphase->sorted_count != 0)
+        memcpy(order, broadphase->order,
+               broadphase->sorted_count * sizeof(uint32_t));
+    if (broadphase->free_count != 0)
+        memcpy(free_list, broadphase->free,
+               broadphase->free_count * sizeof(uint32_t));
+    free(broadphase->order);
+    free(broadphase->free);
+    free(broadphase->scratch[0]);
+    broadphase->order = order;
+    broadphase->free = free_list;
+    broadphase->scratch[0] = scratch;
+    broadphase->scratch[1] = scratch + capacity;
+    broadphase->capacity = capacity;
+    return true;
+}
+
+/**
+ * @name ChooseAxis
+ * @authors Israfiel
+ * @brief Pick the axis along which the proxies' centres vary most,
+ * which leaves the fewest proxies overlapping along it.
+ *
+ * @param broadphase - The broadphase.
+ * @returns The axis.
+ */
+static uint32_t ChooseAxis(const ir_broadphase_t *broadphase)
+{
+    double variance[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const float *lower = broadphase->bounds[axis];
+        const float *upper = broadphase->bounds[axis + 3];
+        double sum = 0.0, squares = 0.0;
+        uint32_t live = 0;
+        for (uint32_t i = 0; i < broadphase->count; ++i)
+        {
+            if (lower[i] > upper[i]) continue;
+            double centre = 0.5 * ((double)lower[i] + upper[i]);
+            sum += centre;
+            squares += centre * centre;
+            live++;
+        }
+        double mean = live == 0 ? 0.0 : sum / live;
+        variance[axis] = live == 0 ? 0.0 : squares / live - mean * mean;
+    }
+
+    uint32_t best = broadphase->axis;
+    for (uint32_t axis = 0; axis < 3; ++axis)
+        if (variance[axis] > variance[best] * AXIS_HYSTERESIS)
+            best = axis;
+    return best;
+}
+
+/**
+ * @name Sort
+ * @authors Israfiel
+ * @brief Radix-sort the proxies along the axis from scratch.
+ *
+ * @param broadphase - The broadphase.
+ */
+static void Sort(ir_broadphase_t *broadphase)
+{
+    const float *lower = broadphase->bounds[broadphase->axis];
+    uint64_t *values = broadphase->scratch[0];
+    for (uint32_t i = 0; i < broadphase->count; ++i)
+        values[i] = (uint64_t)SortableKey(lower[i]) << 32 | i;
+
+    values = Ir_RadixSort(broadphase->scratch, broadphase->count, 32, 64);
+    for (uint32_t i = 0; i < broadphase->count; ++i)
+        broadphase->order[i] = (uint32_t)values[i];
+    broadphase->sorted_count = broadphase->count;
+    broadphase->resorted = true;
+}
+
+/**
+ * @name Repair
+ * @authors Israfiel
+ * @brief Insertion-sort last update's order, which is close to sorted
+ * when proxies have barely moved. Proxies added since are appended
+ * first.
+ *
+ * @param broadphase - The broadphase.
+ * @returns Whether the order was repaired within budget.
+ */
+static bool Repair(ir_broadphase_t *broadphase)
+{
+    uint32_t *order = broadphase->order;
+    for (uint32_t i = broadphase->sorted_count; i < broadphase->count; ++i)
+        order[i] = i;
+    broadphase->sorted_count = broadphase->count;
+
+    const float *lower = broadphase->bounds[broadphase->axis];
+    float *keys = broadphase->sorted[0];
+    for (uint32_t i = 0; i < broadphase->count; ++i)
+        keys[i] = lower[order[i]];
+
+    size_t budget = (size_t)broadphase->count * REPAIR_BUDGET, swaps = 0;
+    for (uint32_t i = 1; i < broadphase->count; ++i)
+    {
+        float key = keys[i];
+        uint32_t proxy = order[i];
+        uint32_t j = i;
+        for (; j > 0 && keys[j - 1] > key; --j)
+        {
+            keys[j] = keys[j - 1];
+            order[j] = order[j - 1];
+        }
+        keys[j] = key;
+        order[j] = proxy;
+
+        swaps += i - j;
+        if (swaps > budget) return false;
+    }
+    return true;
+}
+
+/**
+ * @name Gather
+ * @authors Israfiel
+ * @brief Copy the bounds into sorted order, the sweep axis first, and
+ * pad them so a vector read past the end overlaps nothing.
+ *
+ * @param broadphase - The broadphase.
+ */
+static void Gather(ir_broadphase_t *broadphase)
+{
+    uint32_t axis = broadphase->axis;
+    uint32_t second = (axis + 1) % 3, third = (axis + 2) % 3;
+    const uint32_t sources[6] = {axis,       axis + 3, second,
+                                 second + 3, third,    third + 3};
+    for (int i = 0; i < 6; ++i)
+    {
+        const float *source = broadphase->bounds[sources[i]];
+        float *sorted = broadphase->sorted[i];
+        for (uint32_t j = 0; j < broadphase->count; ++j)
+            sorted[j] = source[broadphase->order[j]];
+        for (uint32_t j = 0; j < IR_SIMD_WIDTH; ++j)
+            sorted[broadphase->count + j] = i & 1 ? -FLT_MAX : FLT_MAX;
+    }
+}
+
+/**
+ * @name Emit
+ * @authors Israfiel
+ * @brief Record a pair in a job's chunk.
+ *
+ * @param chunk - The chunk.
+ * @param key - The pair's key.
+ * @returns Whether there was room.
+ */
+static bool Emit(ir_broadphase_chunk_t *chunk, uint64_t key)
+{
+    if (chunk->count == chunk->capacity)
+    {
+        uint32_t capacity = chunk->capacity ? chunk->capacity * 2 : 64;
+        uint64_t *keys = realloc(chunk->keys, capacity * sizeof(uint64_t));
+        if (keys == NULL) return false;
+        chunk->keys = keys;
+        chunk->capacity = capacity;
+    }
+    chunk->keys[chunk->count++] = key;
+    return true;
+}
+
+/**
+ * @name Sweep
+ * @authors Israfiel
+ * @brief Find the pairs for a range of sorted proxies. Each sweeps
+ * forward until a proxy starts past its upper bound along the axis, so
+ * every pair is found exactly once.
+ *
+ * @param user - The broadphase.
+ * @param begin - The range's first sorted index.
+ * @param end - One past the range's last sorted index.
+ */
+static void Sweep(void *user, size_t begin, size_t end)
+{
+    ir_broadphase_t *broadphase = user;
+    ir_broadphase_chunk_t *chunk =
+        &broadphase->chunks[begin / IR_BROADPHASE_GRAIN];
+    chunk->count = 0;
+
+    float *const *sorted = broadphase->sorted;
+    const uint32_t *order = broadphase->order;
+    uint32_t count = broadphase->count;
+    uint32_t shift = KeyShift(count);
+    for (size_t i = begin; i < end; ++i)
+    {
+        float upper = sorted[1][i];
+        ir_simd_t a_max = Ir_SimdSplat(upper);
+        ir_simd_t b_min = Ir_SimdSplat(sorted[2][i]);
+        ir_simd_t b_max = Ir_SimdSplat(sorted[3][i]);
+        ir_simd_t c_min = Ir_SimdSplat(sorted[4][i]);
+        ir_simd_t c_max = Ir_SimdSplat(sorted[5][i]);
+        uint64_t self = order[i];
+
+        for (size_t j = i + 1; j < count && sorted[0][j] <= upper;
+             j += IR_SIMD_WIDTH)
+        {
+            ir_simd_mask_t hit =
+                Ir_SimdLessEqual(Ir_SimdLoad(sorted[0] + j), a_max);
+            hit = Ir_SimdMaskAnd(
+                hit, Ir_SimdLessEqual(Ir_SimdLoad(sorted[2] + j), b_max));
+            hit = Ir_SimdMaskAnd(
+                hit, Ir_SimdLessEqual(b_min, Ir_SimdLoad(sorted[3] + j)));
+            hit = Ir_SimdMaskAnd(
+                hit, Ir_SimdLessEqual(Ir_SimdLoad(sorted[4] + j), c_max));
+            hit = Ir_SimdMaskAnd(
+                hit, Ir_SimdLessEqual(c_min, Ir_SimdLoad(sorted[5] + j)));
+
+            uint32_t bits = Ir_SimdMaskBits(hit);
+            if (count - j < IR_SIMD_WIDTH)
+                bits &= (1u << (count - j)) - 1;
+            for (; bits != 0; bits &= bits - 1)
+            {
+                uint64_t other = order[j + (uint32_t)__builtin_ctz(bits)];
+                uint64_t key = self < other ? self << shift | other
+                                            : other << shift | self;
+                if (!Emit(chunk, key))
+                {
+                    atomic_store_explicit(&broadphase->failed, true,
+                                          memory_order_relaxed);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @name Merge
+ * @authors Israfiel
+ * @brief Gather every job's pairs into one list, sorted so the result
+ * doesn't depend on how the jobs were scheduled, with any duplicates
+ * dropped.
+ *
+ * @param broadphase - The broadphase.
+ * @param chunks - The number of chunks.
+ * @returns Whether there was memory for the list.
+ */
+static bool Merge(ir_broadphase_t *broadphase, uint32_t chunks)
+{
+    size_t total = 0;
+    for (uint32_t i = 0; i < chunks; ++i)
+        total += broadphase->chunks[i].count;
+    if (total > UINT32_MAX) return false;
+    if (total == 0) return true;
+
+    if (broadphase->pair_capacity < total)
+    {
+        uint64_t *keys = malloc(2 * total * sizeof(uint64_t));
+        ir_broadphase_pair_t *pairs =
+            malloc(total * sizeof(ir_broadphase_pair_t));
+        if (keys == NULL || pairs == NULL)
+        {
+            free(keys);
+            free(pairs);
+            return false;
+        }
+        free(broadphase->pair_keys[0]);
+        free(broadphase->pairs);
+        broadphase->pair_keys[0] = keys;
+        broadphase->pair_keys[1] = keys + total;
+        broadphase->pairs = pairs;
+        broadphase->pair_capacity = (uint32_t)total;
+    }
+
+    uint64_t *keys = broadphase->pair_keys[0];
+    for (uint32_t i = 0; i < chunks; ++i)
+    {
+        const ir_broadphase_chunk_t *chunk = &broadphase->chunks[i];
+        if (chunk->count == 0) continue;
+        memcpy(keys, chunk->keys, chunk->count * sizeof(uint64_t));
+        keys += chunk->count;
+    }
+
+    uint32_t shift = KeyShift(broadphase->count);
+    keys = Ir_RadixSort(broadphase->pair_keys, total, 0, 2 * shift);
+    uint64_t mask = ((uint64_t)1 << shift) - 1;
+    for (size_t i = 0; i < total; ++i)
+    {
+        if (i != 0 && keys[i] == keys[i - 1]) continue;
+        broadphase->pairs[broadphase->pair_count++] =
+            (ir_broadphase_pair_t){(uint32_t)(keys[i] >> shift),
+                                   (uint32_t)(keys[i] & mask)};
+    }
+    return true;
+}
+
+void Ir_BroadphaseCreate(ir_broadphase_t *broadphase)
+{
+    *broadphase = (ir_broadphase_t){0};
+}
+
+void Ir_BroadphaseDestroy(ir_broadphase_t *broadphase)
+{
+    for (uint32_t i = 0; i < broadphase->chunk_count; ++i)
+        free(broadphase->chunks[i].keys);
+    free(broadphase->chunks);
+    free(broadphase->bounds[0]);
+    free(broadphase->sorted[0]);
+    free(broadphase->order);
+    free(broadphase->free);
+    free(broadphase->scratch[0]);
+    free(broadphase->pair_keys[0]);
+    free(broadphase->pairs);
+    *broadphase = (ir_broadphase_t){0};
+}
+
+uint32_t Ir_BroadphaseAdd(ir_broadphase_t *broadphase, ir_vec3_t min,
+                          ir_vec3_t max)
+{
+    uint32_t proxy;
+    if (broadphase->free_count != 0)
+        proxy = broadphase->free[--broadphase->free_count];
+    else
+    {
+        if (broadphase->count == broadphase->capacity &&
+            !Reserve(broadphase, broadphase->capacity
+                                     ? broadphase->capacity * 2
+                                     : 64))
+        {
+            IR_LOG_ERROR("Failed to grow the broadphase.");
+            return IR_BROADPHASE_NONE;
+        }
+        proxy = broadphase->count++;
+    }
+    Ir_BroadphaseMove(broadphase, proxy, min, max);
+    return proxy;
+}
+
+void Ir_BroadphaseMove(ir_broadphase_t *broadphase, uint32_t proxy,
+                       ir_vec3_t min, ir_vec3_t max)
+{
+    broadphase->bounds[0][proxy] = min.x;
+    broadphase->bounds[1][proxy] = min.y;
+    broadphase->bounds[2][proxy] = min.z;
+    broadphase->bounds[3][proxy] = max.x;
+    broadphase->bounds[4][proxy] = max.y;
+    broadphase->bounds[5][proxy] = max.z;
+}
+
+void Ir_BroadphaseRemove(ir_broadphase_t *broadphase, uint32_t proxy)
+{
+    // Inverted bounds sort to the end of every sweep and overlap
+    // nothing, so removed proxies needn't leave the order.
+    Ir_BroadphaseMove(broadphase, proxy,
+                      Ir_Vec3(FLT_MAX, FLT_MAX, FLT_MAX),
+                      Ir_Vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+    broadphase->free[broadphase->free_count++] = proxy;
+}
+
+bool Ir_BroadphaseUpdate(ir_broadphase_t *broadphase, ir_jobs_t *jobs)
+{
+    broadphase->pair_count = 0;
+    broadphase->resorted = false;
+    if (broadphase->count < 2) return true;
+
+    IR_PROFILE_BEGIN("Broadphase");
+    uint32_t axis = ChooseAxis(broadphase);
+    if (axis != broadphase->axis || broadphase->sorted_count == 0)
+    {
+        broadphase->axis = axis;
+        Sort(broadphase);
+    }
+    else if (!Repair(broadphase)) Sort(broadphase);
+    Gather(broadphase);
+
+    uint32_t chunks = (broadphase->count + IR_BROADPHASE_GRAIN - 1) /
+                      IR_BROADPHASE_GRAIN;
+    if (broadphase->chunk_count < chunks)
+    {
+        ir_broadphase_chunk_t *grown = realloc(
+            broadphase->chunks, chunks * sizeof(ir_broadphase_chunk_t));
+        if (grown == NULL)
+        {
+            IR_PROFILE_END("Broadphase");
+            return false;
+        }
+        memset(grown + broadphase->chunk_count, 0,
+               (chunks - broadphase->chunk_count) *
+                   sizeof(ir_broadphase_chunk_t));
+        broadphase->chunks = grown;
+        broadphase->chunk_count = chunks;
+    }
+
+    atomic_store_explicit(&broadphase->failed, false,
+                          memory_order_relaxed);
+    if (jobs != NULL)
+        Ir_JobsParallelFor(jobs, broadphase->count, IR_BROADPHASE_GRAIN,
+                           Sweep, broadphase);
+    else
+    {
+        for (uint32_t i = 0; i < broadphase->count;
+             i += IR_BROADPHASE_GRAIN)
+        {
+            uint32_t end = i + IR_BROADPHASE_GRAIN;
+            Sweep(broadphase, i,
+                  end < broadphase->count ? end : broadphase->count);
+        }
+    }
+
+    bool merged =
+        !atomic_load_explicit(&broadphase->failed, memory_order_relaxed) &&
+        Merge(broadphase, chunks);
+    IR_PROFILE_END("Broadphase");
+    if (!merged) IR_LOG_ERROR("Ran out of memory finding pairs.");
+    return merged;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file Broadphase.h
+ * @authors Israfiel
+ * @brief Iridium's broadphase, which finds every pair of proxies whose
+ * bounding boxes overlap. It's a sweep-and-prune: proxies are kept
+ * sorted by their lower bound along whichever axis spreads them out
+ * most, and each sweeps forward through its neighbours testing the other
+ * two axes four at a time. Since proxies barely move between updates
+ * the order is repaired in place; it's only radix-sorted from scratch
+ * when the sweep axis changes or the order is too scrambled to repair
+ * cheaply.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PHYSICS_BROADPHASE_H
+#define IRIDIUM_PHYSICS_BROADPHASE_H
+
+#include "Core/Jobs.h"
+#include "Math/Vector.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_BROADPHASE_NONE
+ * @brief An invalid proxy.
+ */
+#define IR_BROADPHASE_NONE UINT32_MAX
+
+/**
+ * @name IR_BROADPHASE_GRAIN
+ * @brief The number of sorted proxies each pair-finding job sweeps.
+ */
+#define IR_BROADPHASE_GRAIN 256
+
+/**
+ * @name ir_broadphase_pair_t
+ * @brief Two overlapping proxies, the lesser first.
+ */
+typedef struct ir_broadphase_pair
+{
+    uint32_t a;
+    uint32_t b;
+} ir_broadphase_pair_t;
+
+/**
+ * @name ir_broadphase_chunk_t
+ * @brief The pairs one job found, packed into sortable keys.
+ */
+typedef struct ir_broadphase_chunk
+{
+    uint64_t *keys;
+    uint32_t count;
+    uint32_t capacity;
+} ir_broadphase_chunk_t;
+
+/**
+ * @name ir_broadphase_t
+ * @brief A broadphase.
+ */
+typedef struct ir_broadphase
+{
+    /**
+     * @name bounds
+     * @brief Each proxy's bounds, SoA: the lower x, y, and z, then the
+     * upper. Removed proxies are inverted so they overlap nothing.
+     */
+    float *bounds[6];
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t *free;
+    uint32_t free_count;
+    /**
+     * @name axis
+     * @brief The axis proxies are sorted along.
+     */
+    uint32_t axis;
+    /**
+     * @name order
+     * @brief The proxies sorted by their lower bound along the axis.
+     */
+    uint32_t *order;
+    uint32_t sorted_count;
+    /**
+     * @name sorted
+     * @brief The bounds gathered into sorted order: the axis' lower and
+     * upper, then the other two axes'. Padded by a SIMD vector.
+     */
+    float *sorted[6];
+    uint64_t *scratch[2];
+    ir_broadphase_chunk_t *chunks;
+    uint32_t chunk_count;
+    /**
+     * @name pairs
+     * @brief The overlapping pairs found by the last update, each once,
+     * sorted.
+     */
+    ir_broadphase_pair_t *pairs;
+    uint32_t pair_count;
+    uint32_t pair_capacity;
+    uint64_t *pair_keys[2];
+    /**
+     * @name resorted
+     * @brief Whether the last update had to sort from scratch.
+     */
+    bool resorted;
+    _Atomic bool failed;
+} ir_broadphase_t;
+
+/**
+ * @name BroadphaseCreate
+ * @authors Israfiel
+ * @brief Create an empty broadphase.
+ *
+ * @param broadphase - The broadphase.
+ */
+void Ir_BroadphaseCreate(ir_broadphase_t *broadphase);
+
+/**
+ * @name BroadphaseDestroy
+ * @authors Israfiel
+ * @brief Free a broadphase.
+ *
+ * @param broadphase - The broadphase.
+ */
+void Ir_BroadphaseDestroy(ir_broadphase_t *broadphase);
+
+/**
+ * @name BroadphaseAdd
+ * @authors Israfiel
+ * @brief Add a proxy. Its bounds must be finite.
+ *
+ * @param broadphase - The broadphase.
+ * @param min - The proxy's lower bounds.
+ * @param max - The proxy's upper bounds.
+ * @returns The proxy, or IR_BROADPHASE_NONE if it couldn't be allocated.
+ */
+uint32_t Ir_BroadphaseAdd(ir_broadphase_t *broadphase, ir_vec3_t min,
+                          ir_vec3_t max);
+
+/**
+ * @name BroadphaseMove
+ * @authors Israfiel
+ * @brief Change a proxy's bounds. Takes effect on the next update.
+ *
+ * @param broadphase - The broadphase.
+ * @param proxy - The proxy.
+ * @param min - The proxy's lower bounds.
+ * @param max - The proxy's upper bounds.
+ */
+void Ir_BroadphaseMove(ir_broadphase_t *broadphase, uint32_t proxy,
+                       ir_vec3_t min, ir_vec3_t max);
+
+/**
+ * @name BroadphaseRemove
+ * @authors Israfiel
+ * @brief Remove a proxy. Its number may be reused by the next add.
+ *
+ * @param broadphase - The broadphase.
+ * @param proxy - The proxy.
+ */
+void Ir_BroadphaseRemove(ir_broadphase_t *broadphase, uint32_t proxy);
+
+/**
+ * @name BroadphaseUpdate
+ * @authors Israfiel
+ * @brief Re-sort the proxies and find every overlapping pair.
+ *
+ * @param broadphase - The broadphase.
+ * @param jobs - The pool to find pairs with, or NULL to find them on
+ * the calling thread.
+ * @returns Whether the pairs were found; false if memory ran out.
+ */
+bool Ir_BroadphaseUpdate(ir_broadphase_t *broadphase, ir_jobs_t *jobs);
+
+#endif // IRIDIUM_PHYSICS_BROADPHASE_H
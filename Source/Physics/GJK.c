@@ -0,0 +1,886 @@
+/**
+ * @file GJK.c
+ * @authors Israfiel
+ * @brief Implements Iridium's convex collision queries.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "GJK.h"
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+
+/**
+ * @name GJK_ITERATIONS
+ * @brief The most GJK iterations. Cores are polytopes, so GJK ends
+ * exactly in a handful; the cap only guards against rounding loops.
+ */
+#define GJK_ITERATIONS 32
+
+/**
+ * @name GJK_TOLERANCE
+ * @brief The relative progress below which GJK has converged.
+ */
+#define GJK_TOLERANCE 1e-5f
+
+/**
+ * @name GJK_TOUCHING
+ * @brief The distance, in metres, below which cores count as touching.
+ * Any closer and the direction between them is mostly rounding, so
+ * they're handed to EPA for a normal it can be sure of.
+ */
+#define GJK_TOUCHING 1e-3f
+
+/**
+ * @name CAST_TOLERANCE
+ * @brief How close, in metres, a cast brings shapes before they count
+ * as touching.
+ */
+#define CAST_TOLERANCE 1e-4f
+
+/**
+ * @name EPA_VERTICES
+ * @brief The most vertices an EPA polytope grows to.
+ */
+#define EPA_VERTICES 64
+
+/**
+ * @name EPA_FACES
+ * @brief The most faces an EPA polytope grows to.
+ */
+#define EPA_FACES 128
+
+/**
+ * @name EPA_TOLERANCE
+ * @brief How close, in metres, EPA's face must be to the true surface.
+ */
+#define EPA_TOLERANCE 1e-4f
+
+/**
+ * @name ir_epa_face_t
+ * @brief A face of an EPA polytope, wound to face outwards.
+ */
+typedef struct ir_epa_face
+{
+    uint32_t vertices[3];
+    ir_vec3_t normal;
+    float distance;
+    bool removed;
+} ir_epa_face_t;
+
+/**
+ * @name Support
+ * @authors Israfiel
+ * @brief Find the Minkowski difference's furthest vertex.
+ *
+ * @param a - The first shape.
+ * @param transform_a - Where the first shape is.
+ * @param b - The second shape.
+ * @param transform_b - Where the second shape is.
+ * @param direction - The world direction.
+ * @returns The vertex.
+ */
+static ir_gjk_vertex_t Support(const ir_shape_t *a,
+                               const ir_transform_t *transform_a,
+                               const ir_shape_t *b,
+                               const ir_transform_t *transform_b,
+                               ir_vec3_t direction)
+{
+    ir_vec3_t local_a = Ir_QuatRotate(
+        Ir_QuatConjugate(transform_a->rotation), direction);
+    ir_vec3_t local_b = Ir_QuatRotate(
+        Ir_QuatConjugate(transform_b->rotation), Ir_Vec3Negate(direction));
+
+    ir_gjk_vertex_t vertex;
+    vertex.a = Ir_TransformPoint(transform_a, Ir_ShapeSupport(a, local_a));
+    vertex.b = Ir_TransformPoint(transform_b, Ir_ShapeSupport(b, local_b));
+    vertex.w = Ir_Vec3Sub(vertex.a, vertex.b);
+    return vertex;
+}
+
+/**
+ * @name SolveSegment
+ * @authors Israfiel
+ * @brief Weigh a segment's ends to get its point closest to the origin.
+ *
+ * @param a - The first end.
+ * @param b - The second end.
+ * @param weights - Filled with the ends' weights.
+ */
+static void SolveSegment(ir_vec3_t a, ir_vec3_t b, float weights[2])
+{
+    ir_vec3_t ab = Ir_Vec3Sub(b, a);
+    float length = Ir_Vec3Dot(ab, ab);
+    float t = length > 0.0f ? -Ir_Vec3Dot(a, ab) / length : 0.0f;
+    if (t <= 0.0f) t = 0.0f;
+    if (t >= 1.0f) t = 1.0f;
+    weights[0] = 1.0f - t;
+    weights[1] = t;
+}
+
+/**
+ * @name SolveTriangle
+ * @authors Israfiel
+ * @brief Weigh a triangle's corners to get its point closest to the
+ * origin, walking its Voronoi regions. Corners outside the closest
+ * feature get a weight of exactly zero.
+ *
+ * @param a - The first corner.
+ * @param b - The second corner.
+ * @param c - The third corner.
+ * @param weights - Filled with the corners' weights.
+ */
+static void SolveTriangle(ir_vec3_t a, ir_vec3_t b, ir_vec3_t c,
+                          float weights[3])
+{
+    ir_vec3_t ab = Ir_Vec3Sub(b, a), ac = Ir_Vec3Sub(c, a);
+    weights[0] = weights[1] = weights[2] = 0.0f;
+
+    float d1 = -Ir_Vec3Dot(ab, a), d2 = -Ir_Vec3Dot(ac, a);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+    {
+        weights[0] = 1.0f;
+        return;
+    }
+
+    float d3 = -Ir_Vec3Dot(ab, b), d4 = -Ir_Vec3Dot(ac, b);
+    if (d3 >= 0.0f && d4 <= d3)
+    {
+        weights[1] = 1.0f;
+        return;
+    }
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+    {
+        float t = d1 / (d1 - d3);
+        weights[0] = 1.0f - t;
+        weights[1] = t;
+        return;
+    }
+
+    float d5 = -Ir_Vec3Dot(ab, c), d6 = -Ir_Vec3Dot(ac, c);
+    if (d6 >= 0.0f && d5 <= d6)
+    {
+        weights[2] = 1.0f;
+        return;
+    }
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+    {
+        float t = d2 / (d2 - d6);
+        weights[0] = 1.0f - t;
+        weights[2] = t;
+        return;
+    }
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+    {
+        float t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        weights[1] = 1.0f - t;
+        weights[2] = t;
+        return;
+    }
+
+    // Inside the face. The region tests' products of dot products lose
+    // too much to cancellation on thin triangles to weigh with, so the
+    // weights come from the sub-triangles' areas instead.
+    ir_vec3_t normal = Ir_Vec3Cross(ab, ac);
+    float area = Ir_Vec3Dot(normal, normal);
+    if (area <= 0.0f)
+    {
+        weights[0] = 1.0f;
+        return;
+    }
+    ir_vec3_t origin = Ir_Vec3Negate(a);
+    weights[1] = Ir_Vec3Dot(normal, Ir_Vec3Cross(origin, ac)) / area;
+    weights[2] = Ir_Vec3Dot(normal, Ir_Vec3Cross(ab, origin)) / area;
+    weights[0] = 1.0f - weights[1] - weights[2];
+}
+
+/**
+ * @name SolveTetrahedron
+ * @authors Israfiel
+ * @brief Weigh a tetrahedron's corners to get its point closest to the
+ * origin, checking each face the origin lies outside of. A flat
+ * tetrahedron checks every face.
+ *
+ * @param points - The corners.
+ * @param weights - Filled with the corners' weights.
+ * @returns Whether the origin is inside the tetrahedron.
+ */
+static bool SolveTetrahedron(const ir_vec3_t points[4], float weights[4])
+{
+    static const uint32_t faces[4][4] = {
+        {0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}};
+
+    bool inside = true;
+    float best = FLT_MAX;
+    for (int i = 0; i < 4; ++i)
+    {
+        ir_vec3_t a = points[faces[i][0]], b = points[faces[i][1]];
+        ir_vec3_t c = points[faces[i][2]], d = points[faces[i][3]];
+        ir_vec3_t normal =
+            Ir_Vec3Cross(Ir_Vec3Sub(b, a), Ir_Vec3Sub(c, a));
+        ir_vec3_t ad = Ir_Vec3Sub(d, a);
+        float origin = -Ir_Vec3Dot(a, normal);
+        float opposite = Ir_Vec3Dot(ad, normal);
+        bool flat = opposite * opposite <=
+                    1e-10f * Ir_Vec3Dot(normal, normal) *
+                        Ir_Vec3Dot(ad, ad);
+        if (!flat && origin * opposite >= 0.0f) continue;
+        inside = false;
+
+        float face[3];
+        SolveTriangle(a, b, c, face);
+        ir_vec3_t closest = Ir_Vec3Add(
+            Ir_Vec3Add(Ir_Vec3Scale(a, face[0]), Ir_Vec3Scale(b, face[1])),
+            Ir_Vec3Scale(c, face[2]));
+        float distance = Ir_Vec3Dot(closest, closest);
+        if (distance >= best) continue;
+        best = distance;
+        weights[faces[i][0]] = face[0];
+        weights[faces[i][1]] = face[1];
+        weights[faces[i][2]] = face[2];
+        weights[faces[i][3]] = 0.0f;
+    }
+    return inside;
+}
+
+/**
+ * @name Solve
+ * @authors Israfiel
+ * @brief Find the simplex' point closest to the origin and drop the
+ * vertices that don't contribute to it.
+ *
+ * @param simplex - The simplex.
+ * @returns Whether the origin is inside the simplex.
+ */
+static bool Solve(ir_gjk_simplex_t *simplex)
+{
+    ir_vec3_t points[4];
+    for (uint32_t i = 0; i < simplex->count; ++i)
+        points[i] = simplex->vertices[i].w;
+
+    switch (simplex->count)
+    {
+        case 1: simplex->weights[0] = 1.0f; return false;
+        case 2:
+            SolveSegment(points[0], points[1], simplex->weights);
+            break;
+        case 3:
+            SolveTriangle(points[0], points[1], points[2],
+                          simplex->weights);
+            break;
+        case 4:
+            if (SolveTetrahedron(points, simplex->weights)) return true;
+            break;
+    }
+
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < simplex->count; ++i)
+    {
+        if (simplex->weights[i] <= 0.0f) continue;
+        simplex->vertices[kept] = simplex->vertices[i];
+        simplex->weights[kept++] = simplex->weights[i];
+    }
+    simplex->count = kept;
+    return false;
+}
+
+/**
+ * @name Flatten
+ * @authors Israfiel
+ * @brief Drop a tetrahedron holding a point on its surface to the face
+ * the point lies on, weighed to the face's point closest to it.
+ *
+ * @param simplex - The tetrahedron, made a triangle.
+ * @param point - The point.
+ * @returns The offset from the face's closest point to the point.
+ */
+static ir_vec3_t Flatten(ir_gjk_simplex_t *simplex, ir_vec3_t point)
+{
+    static const uint32_t faces[4][3] = {
+        {0, 1, 2}, {0, 2, 3}, {0, 3, 1}, {1, 3, 2}};
+
+    uint32_t nearest = 0;
+    float best = FLT_MAX;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        ir_vec3_t a = simplex->vertices[faces[i][0]].w;
+        ir_vec3_t b = simplex->vertices[faces[i][1]].w;
+        ir_vec3_t c = simplex->vertices[faces[i][2]].w;
+        ir_vec3_t normal = Ir_Vec3Normalize(
+            Ir_Vec3Cross(Ir_Vec3Sub(b, a), Ir_Vec3Sub(c, a)),
+            Ir_Vec3(0.0f, 0.0f, 0.0f));
+        float distance = fabsf(Ir_Vec3Dot(Ir_Vec3Sub(point, a), normal));
+        if (Ir_Vec3LengthSquared(normal) == 0.0f || distance >= best)
+            continue;
+        best = distance;
+        nearest = i;
+    }
+
+    ir_gjk_vertex_t kept[3];
+    ir_vec3_t points[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        kept[i] = simplex->vertices[faces[nearest][i]];
+        points[i] = Ir_Vec3Sub(kept[i].w, point);
+    }
+    SolveTriangle(points[0], points[1], points[2], simplex->weights);
+    ir_vec3_t closest = Ir_Vec3(0.0f, 0.0f, 0.0f);
+    for (int i = 0; i < 3; ++i)
+    {
+        simplex->vertices[i] = kept[i];
+        closest = Ir_Vec3Add(closest, Ir_Vec3Scale(points[i],
+                                                   simplex->weights[i]));
+    }
+    simplex->count = 3;
+    return Ir_Vec3Negate(closest);
+}
+
+/**
+ * @name Combine
+ * @authors Israfiel
+ * @brief Weigh a simplex' vertices together.
+ *
+ * @param simplex - The simplex.
+ * @param a - Filled with the weighted point on a.
+ * @param b - Filled with the weighted point on b.
+ */
+static void Combine(const ir_gjk_simplex_t *simplex, ir_vec3_t *a,
+                    ir_vec3_t *b)
+{
+    *a = *b = Ir_Vec3(0.0f, 0.0f, 0.0f);
+    for (uint32_t i = 0; i < simplex->count; ++i)
+    {
+        *a = Ir_Vec3Add(*a, Ir_Vec3Scale(simplex->vertices[i].a,
+                                         simplex->weights[i]));
+        *b = Ir_Vec3Add(*b, Ir_Vec3Scale(simplex->vertices[i].b,
+                                         simplex->weights[i]));
+    }
+}
+
+void Ir_Gjk(const ir_shape_t *a, const ir_transform_t *transform_a,
+            const ir_shape_t *b, const ir_transform_t *transform_b,
+            ir_vec3_t direction, ir_gjk_result_t *result)
+{
+    if (Ir_Vec3LengthSquared(direction) < 1e-12f)
+        direction = Ir_Vec3Sub(transform_a->position,
+                               transform_b->position);
+    if (Ir_Vec3LengthSquared(direction) < 1e-12f)
+        direction = Ir_Vec3(1.0f, 0.0f, 0.0f);
+
+    ir_gjk_simplex_t *simplex = &result->simplex;
+    simplex->vertices[0] = Support(a, transform_a, b, transform_b,
+                                   Ir_Vec3Negate(direction));
+    simplex->count = 1;
+    result->overlap = false;
+
+    float previous = FLT_MAX;
+    uint32_t iteration = 0;
+    while (iteration++ < GJK_ITERATIONS)
+    {
+        if (Solve(simplex))
+        {
+            result->overlap = true;
+            break;
+        }
+
+        ir_vec3_t closest = Ir_Vec3(0.0f, 0.0f, 0.0f);
+        for (uint32_t i = 0; i < simplex->count; ++i)
+            closest = Ir_Vec3Add(closest,
+                                 Ir_Vec3Scale(simplex->vertices[i].w,
+                                              simplex->weights[i]));
+        float distance = Ir_Vec3Dot(closest, closest);
+        if (distance < GJK_TOUCHING * GJK_TOUCHING)
+        {
+            result->overlap = true;
+            break;
+        }
+        // Exact arithmetic always gets closer; not getting closer means
+        // rounding has taken over.
+        if (distance >= previous) break;
+        previous = distance;
+
+        ir_gjk_vertex_t vertex = Support(a, transform_a, b, transform_b,
+                                         Ir_Vec3Negate(closest));
+        if (distance - Ir_Vec3Dot(closest, vertex.w) <=
+            GJK_TOLERANCE * distance)
+            break;
+
+        bool repeated = false;
+        for (uint32_t i = 0; i < simplex->count; ++i)
+        {
+            ir_vec3_t offset =
+                Ir_Vec3Sub(simplex->vertices[i].w, vertex.w);
+            if (Ir_Vec3Dot(offset, offset) < 1e-12f) repeated = true;
+        }
+        if (repeated) break;
+        simplex->vertices[simplex->count++] = vertex;
+    }
+
+    result->iterations = iteration;
+    Combine(simplex, &result->point_a, &result->point_b);
+    result->distance =
+        result->overlap
+            ? 0.0f
+            : Ir_Vec3Length(Ir_Vec3Sub(result->point_b, result->point_a));
+}
+
+/**
+ * @name AddVertex
+ * @authors Israfiel
+ * @brief Add a support vertex to a starting simplex if it's far enough
+ * from the simplex' span to make it bigger.
+ *
+ * @param vertices - The simplex' vertices.
+ * @param count - The number of vertices.
+ * @param vertex - The candidate.
+ * @returns Whether it was added.
+ */
+static bool AddVertex(ir_gjk_vertex_t *vertices, uint32_t *count,
+                      ir_gjk_vertex_t vertex)
+{
+    // The squared distance from the span, so the threshold is a length
+    // and a vertex that's merely rounded away from one it repeats can't
+    // slip through on a big simplex.
+    ir_vec3_t offset = Ir_Vec3Sub(vertex.w, vertices[0].w);
+    float distance;
+    switch (*count)
+    {
+        case 1: distance = Ir_Vec3LengthSquared(offset); break;
+        case 2:
+        {
+            ir_vec3_t line = Ir_Vec3Sub(vertices[1].w, vertices[0].w);
+            distance =
+                Ir_Vec3LengthSquared(Ir_Vec3Cross(line, offset)) /
+                Ir_Vec3LengthSquared(line);
+            break;
+        }
+        default:
+        {
+            ir_vec3_t normal =
+                Ir_Vec3Cross(Ir_Vec3Sub(vertices[1].w, vertices[0].w),
+                             Ir_Vec3Sub(vertices[2].w, vertices[0].w));
+            float height = Ir_Vec3Dot(normal, offset);
+            distance = height * height / Ir_Vec3LengthSquared(normal);
+            break;
+        }
+    }
+    if (distance < GJK_TOUCHING * GJK_TOUCHING) return false;
+    vertices[(*count)++] = vertex;
+    return true;
+}
+
+/**
+ * @name MakeFace
+ * @authors Israfiel
+ * @brief Build an EPA face.
+ *
+ * @param vertices - The polytope's vertices.
+ * @param a - The first corner.
+ * @param b - The second corner.
+ * @param c - The third corner.
+ * @returns The face.
+ */
+static ir_epa_face_t MakeFace(const ir_gjk_vertex_t *vertices, uint32_t a,
+                              uint32_t b, uint32_t c)
+{
+    ir_vec3_t normal = Ir_Vec3Cross(
+        Ir_Vec3Sub(vertices[b].w, vertices[a].w),
+        Ir_Vec3Sub(vertices[c].w, vertices[a].w));
+    float length = Ir_Vec3Length(normal);
+    ir_epa_face_t face = {.vertices = {a, b, c}};
+    if (length < 1e-12f)
+    {
+        // A sliver can't be the closest face, but its unnormalized
+        // normal still says which side of it a vertex is on, so it's
+        // torn down like any other.
+        face.normal = normal;
+        face.distance = FLT_MAX;
+        return face;
+    }
+    face.normal = Ir_Vec3Scale(normal, 1.0f / length);
+    face.distance = Ir_Vec3Dot(face.normal, vertices[a].w);
+    return face;
+}
+
+/**
+ * @name Seed
+ * @authors Israfiel
+ * @brief Grow GJK's final simplex into a tetrahedron. It's already one
+ * unless the cores only touch.
+ *
+ * @param a - The first shape.
+ * @param transform_a - Where the first shape is.
+ * @param b - The second shape.
+ * @param transform_b - Where the second shape is.
+ * @param vertices - Filled with the tetrahedron.
+ * @param count - The number of vertices to start with, then filled.
+ * @returns Whether a tetrahedron was found.
+ */
+static bool Seed(const ir_shape_t *a, const ir_transform_t *transform_a,
+                 const ir_shape_t *b, const ir_transform_t *transform_b,
+                 ir_gjk_vertex_t *vertices, uint32_t *count)
+{
+    static const ir_vec3_t axes[6] = {{1, 0, 0},  {-1, 0, 0}, {0, 1, 0},
+                                      {0, -1, 0}, {0, 0, 1},  {0, 0, -1}};
+    if (*count == 0) return false;
+    for (int i = 0; i < 6 && *count == 1; ++i)
+        AddVertex(vertices, count,
+                  Support(a, transform_a, b, transform_b, axes[i]));
+
+    if (*count == 2)
+    {
+        ir_vec3_t line = Ir_Vec3Sub(vertices[1].w, vertices[0].w);
+        for (int i = 0; i < 6 && *count == 2; ++i)
+        {
+            ir_vec3_t side = Ir_Vec3Cross(line, axes[i]);
+            if (Ir_Vec3LengthSquared(side) < 1e-12f) continue;
+            AddVertex(vertices, count,
+                      Support(a, transform_a, b, transform_b, side));
+        }
+    }
+
+    if (*count == 3)
+    {
+        ir_vec3_t normal =
+            Ir_Vec3Cross(Ir_Vec3Sub(vertices[1].w, vertices[0].w),
+                         Ir_Vec3Sub(vertices[2].w, vertices[0].w));
+        if (!AddVertex(vertices, count,
+                       Support(a, transform_a, b, transform_b, normal)))
+            AddVertex(vertices, count,
+                      Support(a, transform_a, b, transform_b,
+                              Ir_Vec3Negate(normal)));
+    }
+    return *count == 4;
+}
+
+bool Ir_Epa(const ir_shape_t *a, const ir_transform_t *transform_a,
+            const ir_shape_t *b, const ir_transform_t *transform_b,
+            const ir_gjk_simplex_t *simplex, ir_epa_result_t *result)
+{
+    ir_gjk_vertex_t vertices[EPA_VERTICES];
+    uint32_t vertex_count = simplex->count;
+    for (uint32_t i = 0; i < vertex_count; ++i)
+        vertices[i] = simplex->vertices[i];
+    if (!Seed(a, transform_a, b, transform_b, vertices, &vertex_count))
+    {
+        if (vertex_count != 3) return false;
+        // Flat cores, such as crossing segments, only touch. The plane
+        // they span is the one direction that parts them.
+        ir_vec3_t normal = Ir_Vec3Normalize(
+            Ir_Vec3Cross(Ir_Vec3Sub(vertices[1].w, vertices[0].w),
+                         Ir_Vec3Sub(vertices[2].w, vertices[0].w)),
+            Ir_Vec3(0.0f, 1.0f, 0.0f));
+        if (Ir_Vec3Dot(normal, Ir_Vec3Sub(transform_b->position,
+                                          transform_a->position)) < 0.0f)
+            normal = Ir_Vec3Negate(normal);
+        result->normal = normal;
+        result->depth = 0.0f;
+        Combine(simplex, &result->point_a, &result->point_b);
+        return true;
+    }
+
+    ir_epa_face_t faces[EPA_FACES];
+    uint32_t face_count = 0;
+    static const uint32_t tetrahedron[4][4] = {
+        {0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0}};
+    for (int i = 0; i < 4; ++i)
+    {
+        uint32_t v0 = tetrahedron[i][0], v1 = tetrahedron[i][1];
+        uint32_t v2 = tetrahedron[i][2], v3 = tetrahedron[i][3];
+        ir_vec3_t normal = Ir_Vec3Cross(
+            Ir_Vec3Sub(vertices[v1].w, vertices[v0].w),
+            Ir_Vec3Sub(vertices[v2].w, vertices[v0].w));
+        if (Ir_Vec3Dot(normal, Ir_Vec3Sub(vertices[v3].w,
+                                          vertices[v0].w)) > 0.0f)
+        {
+            uint32_t swap = v1;
+            v1 = v2;
+            v2 = swap;
+        }
+        faces[face_count++] = MakeFace(vertices, v0, v1, v2);
+    }
+
+    ir_epa_face_t *closest = NULL;
+    while (true)
+    {
+        closest = NULL;
+        for (uint32_t i = 0; i < face_count; ++i)
+            if (!faces[i].removed &&
+                (closest == NULL || faces[i].distance < closest->distance))
+                closest = &faces[i];
+        if (closest == NULL || closest->distance == FLT_MAX) return false;
+
+        ir_gjk_vertex_t vertex = Support(a, transform_a, b, transform_b,
+                                         closest->normal);
+        float gap = Ir_Vec3Dot(closest->normal, vertex.w) -
+                    closest->distance;
+        if (gap < EPA_TOLERANCE || vertex_count == EPA_VERTICES) break;
+
+        // Tear down every face the new vertex can see, keeping the
+        // horizon: the edges belonging to only one torn-down face.
+        uint32_t edges[EPA_FACES][2];
+        uint32_t edge_count = 0;
+        for (uint32_t i = 0; i < face_count; ++i)
+        {
+            ir_epa_face_t *face = &faces[i];
+            if (face->removed) continue;
+            ir_vec3_t offset =
+                Ir_Vec3Sub(vertex.w, vertices[face->vertices[0]].w);
+            if (Ir_Vec3Dot(face->normal, offset) <= 0.0f) continue;
+            face->removed = true;
+
+            for (int j = 0; j < 3; ++j)
+            {
+                uint32_t from = face->vertices[j];
+                uint32_t to = face->vertices[(j + 1) % 3];
+                bool shared = false;
+                for (uint32_t k = 0; k < edge_count; ++k)
+                {
+                    if (edges[k][0] != to || edges[k][1] != from) continue;
+                    edges[k][0] = edges[--edge_count][0];
+                    edges[k][1] = edges[edge_count][1];
+                    shared = true;
+                    break;
+                }
+                if (shared) continue;
+                if (edge_count == EPA_FACES) return false;
+                edges[edge_count][0] = from;
+                edges[edge_count++][1] = to;
+            }
+        }
+
+        uint32_t added = vertex_count;
+        vertices[vertex_count++] = vertex;
+        uint32_t live = 0;
+        for (uint32_t i = 0; i < face_count; ++i)
+            if (!faces[i].removed) faces[live++] = faces[i];
+        face_count = live;
+        if (face_count + edge_count > EPA_FACES) break;
+        for (uint32_t i = 0; i < edge_count; ++i)
+            faces[face_count++] =
+                MakeFace(vertices, edges[i][0], edges[i][1], added);
+    }
+
+    // Faces were compacted after the search, so find the closest again.
+    closest = NULL;
+    for (uint32_t i = 0; i < face_count; ++i)
+        if (closest == NULL || faces[i].distance < closest->distance)
+            closest = &faces[i];
+    if (closest == NULL || closest->distance == FLT_MAX) return false;
+
+    const ir_gjk_vertex_t *v0 = &vertices[closest->vertices[0]];
+    const ir_gjk_vertex_t *v1 = &vertices[closest->vertices[1]];
+    const ir_gjk_vertex_t *v2 = &vertices[closest->vertices[2]];
+    ir_vec3_t projection =
+        Ir_Vec3Scale(closest->normal, closest->distance);
+    float weights[3];
+    SolveTriangle(Ir_Vec3Sub(v0->w, projection),
+                  Ir_Vec3Sub(v1->w, projection),
+                  Ir_Vec3Sub(v2->w, projection), weights);
+
+    result->normal = closest->normal;
+    result->depth = closest->distance > 0.0f ? closest->distance : 0.0f;
+    result->point_a = Ir_Vec3Add(
+        Ir_Vec3Add(Ir_Vec3Scale(v0->a, weights[0]),
+                   Ir_Vec3Scale(v1->a, weights[1])),
+        Ir_Vec3Scale(v2->a, weights[2]));
+    result->point_b = Ir_Vec3Add(
+        Ir_Vec3Add(Ir_Vec3Scale(v0->b, weights[0]),
+                   Ir_Vec3Scale(v1->b, weights[1])),
+        Ir_Vec3Scale(v2->b, weights[2]));
+    return true;
+}
+
+void Ir_ShapeContact(const ir_shape_t *a,
+                     const ir_transform_t *transform_a,
+                     const ir_shape_t *b,
+                     const ir_transform_t *transform_b,
+                     ir_vec3_t direction, ir_contact_t *contact)
+{
+    ir_gjk_result_t gjk;
+    Ir_Gjk(a, transform_a, b, transform_b, direction, &gjk);
+
+    ir_vec3_t point_a = gjk.point_a, point_b = gjk.point_b;
+    float depth;
+    if (!gjk.overlap)
+    {
+        contact->direction = Ir_Vec3Sub(point_a, point_b);
+        contact->normal = Ir_Vec3Scale(Ir_Vec3Sub(point_b, point_a),
+                                       1.0f / gjk.distance);
+        depth = -gjk.distance;
+    }
+    else
+    {
+        ir_epa_result_t epa;
+        if (Ir_Epa(a, transform_a, b, transform_b, &gjk.simplex, &epa))
+        {
+            contact->normal = epa.normal;
+            point_a = epa.point_a;
+            point_b = epa.point_b;
+            depth = epa.depth;
+        }
+        else
+        {
+            // Coincident points or segments; any normal is as right as
+            // any other, so push along the line between the centres.
+            contact->normal = Ir_Vec3Normalize(
+                Ir_Vec3Sub(transform_b->position, transform_a->position),
+                Ir_Vec3(0.0f, 1.0f, 0.0f));
+            depth = 0.0f;
+        }
+        contact->direction = Ir_Vec3Negate(contact->normal);
+    }
+
+    contact->separation = -depth - a->radius - b->radius;
+    contact->point_a =
+        Ir_Vec3Add(point_a, Ir_Vec3Scale(contact->normal, a->radius));
+    contact->point_b =
+        Ir_Vec3Sub(point_b, Ir_Vec3Scale(contact->normal, b->radius));
+}
+
+bool Ir_ShapeCast(const ir_shape_t *a, const ir_transform_t *transform_a,
+                  ir_vec3_t motion, const ir_shape_t *b,
+                  const ir_transform_t *transform_b, float *fraction,
+                  ir_contact_t *contact)
+{
+    // Moved by t * motion, a touches b when -t * motion is within the
+    // radii of the cores' Minkowski difference, so this casts a ray from
+    // the origin along -motion against it. v runs from the simplex'
+    // closest point to the ray's point; any support plane the point is
+    // outside of either pulls it up to the plane or, if the ray leads
+    // away from it, proves a miss.
+    float radius = a->radius + b->radius;
+    ir_vec3_t ray = Ir_Vec3Negate(motion);
+    ir_vec3_t point = Ir_Vec3(0.0f, 0.0f, 0.0f);
+    ir_vec3_t v = Ir_Vec3Sub(transform_b->position, transform_a->position);
+    if (Ir_Vec3LengthSquared(v) < 1e-12f) v = motion;
+    if (Ir_Vec3LengthSquared(v) < 1e-12f) v = Ir_Vec3(1.0f, 0.0f, 0.0f);
+
+    // Shapes without radii end the cast with v shrunk to nothing, so
+    // its direction is noise; the last v whose plane moved the ray's
+    // point faces the way the normal must, and stands in for it.
+    ir_gjk_simplex_t simplex = {.count = 0};
+    ir_vec3_t axis = v;
+    bool inside = false;
+    float t = 0.0f;
+    for (int i = 0; i < GJK_ITERATIONS; ++i)
+    {
+        float length = Ir_Vec3Length(v);
+        if (length <= radius + CAST_TOLERANCE && simplex.count != 0)
+            break;
+
+        ir_gjk_vertex_t vertex =
+            Support(a, transform_a, b, transform_b, v);
+        float plane =
+            Ir_Vec3Dot(v, Ir_Vec3Sub(point, vertex.w)) / length - radius;
+        bool moved = plane > CAST_TOLERANCE;
+        if (moved)
+        {
+            float approach = Ir_Vec3Dot(v, ray) / length;
+            if (approach >= 0.0f) return false;
+            t -= plane / approach;
+            if (t > 1.0f) return false;
+            point = Ir_Vec3Scale(ray, t);
+            axis = v;
+        }
+
+        bool repeated = false;
+        for (uint32_t j = 0; j < simplex.count; ++j)
+        {
+            ir_vec3_t offset = Ir_Vec3Sub(simplex.vertices[j].w, vertex.w);
+            if (Ir_Vec3Dot(offset, offset) < 1e-12f) repeated = true;
+        }
+        // A support point already in the simplex with nothing to move
+        // the ray's point means the simplex is as close as the shapes.
+        if (repeated && !moved) break;
+        if (!repeated) simplex.vertices[simplex.count++] = vertex;
+
+        // The simplex is solved about the ray's point, since that's
+        // what it has to get close to.
+        for (uint32_t j = 0; j < simplex.count; ++j)
+            simplex.vertices[j].w = Ir_Vec3Sub(simplex.vertices[j].w,
+                                               point);
+        inside = Solve(&simplex);
+        ir_vec3_t closest = Ir_Vec3(0.0f, 0.0f, 0.0f);
+        for (uint32_t j = 0; j < simplex.count; ++j)
+        {
+            closest = Ir_Vec3Add(closest,
+                                 Ir_Vec3Scale(simplex.vertices[j].w,
+                                              simplex.weights[j]));
+            simplex.vertices[j].w = Ir_Vec3Add(simplex.vertices[j].w,
+                                               point);
+        }
+        if (inside) break;
+        v = Ir_Vec3Negate(closest);
+        if (i == GJK_ITERATIONS - 1 &&
+            Ir_Vec3Length(v) > radius + CAST_TOLERANCE)
+            return false;
+    }
+
+    // A point that has moved only ends up inside the difference by
+    // landing on its surface, which is touching rather than overlapping.
+    if (inside && t > 0.0f)
+    {
+        v = Flatten(&simplex, point);
+        inside = false;
+    }
+
+    ir_vec3_t offset = Ir_Vec3Scale(motion, t);
+    ir_vec3_t point_a, point_b;
+    if (inside)
+    {
+        // The cores overlap, which only happens when they start that
+        // way; there's no closest point to go by, so push along the
+        // motion.
+        contact->normal = Ir_Vec3Normalize(motion, Ir_Vec3(0.0f, 1.0f,
+                                                           0.0f));
+        point_a = transform_a->position;
+        point_b = point_a;
+        contact->separation = -radius;
+    }
+    else
+    {
+        Combine(&simplex, &point_a, &point_b);
+        float length = Ir_Vec3Length(v);
+        ir_vec3_t normal = v;
+        if (length <= CAST_TOLERANCE)
+        {
+            // A triangle of the difference's vertices holding a point on
+            // its surface lies in the face the point is on, so its
+            // normal beats the plane that last moved the point, which
+            // may have run through a corner instead.
+            normal = axis;
+            const ir_gjk_vertex_t *w = simplex.vertices;
+            if (simplex.count == 3)
+            {
+                ir_vec3_t face = Ir_Vec3Cross(Ir_Vec3Sub(w[1].w, w[0].w),
+                                              Ir_Vec3Sub(w[2].w, w[0].w));
+                if (Ir_Vec3Dot(face, axis) < 0.0f)
+                    face = Ir_Vec3Negate(face);
+                if (Ir_Vec3LengthSquared(face) > 1e-12f) normal = face;
+            }
+        }
+        contact->normal =
+            Ir_Vec3Normalize(normal, Ir_Vec3(0.0f, 1.0f, 0.0f));
+        contact->separation = length - radius;
+    }
+
+    *fraction = t;
+    contact->direction = Ir_Vec3Negate(contact->normal);
+    contact->point_a =
+        Ir_Vec3Add(Ir_Vec3Add(point_a, offset),
+                   Ir_Vec3Scale(contact->normal, a->radius));
+    contact->point_b =
+        Ir_Vec3Sub(point_b, Ir_Vec3Scale(contact->normal, b->radius));
+    return true;
+}
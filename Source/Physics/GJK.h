@@ -0,0 +1,192 @@
+/**
+ * @file GJK.h
+ * @authors Israfiel
+ * @brief Iridium's convex collision queries. GJK finds the distance
+ * between two shapes' cores, or that they overlap; EPA then finds how
+ * deeply overlapping cores penetrate. Both only ever ask a shape for
+ * its support point, so every pair of shape types shares one path.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PHYSICS_GJK_H
+#define IRIDIUM_PHYSICS_GJK_H
+
+#include "Math/Quaternion.h"
+#include "Physics/Shape.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name ir_gjk_vertex_t
+ * @brief A vertex of the Minkowski difference of two shapes, with the
+ * support points it came from.
+ */
+typedef struct ir_gjk_vertex
+{
+    ir_vec3_t a;
+    ir_vec3_t b;
+    /**
+     * @name w
+     * @brief The vertex, a - b.
+     */
+    ir_vec3_t w;
+} ir_gjk_vertex_t;
+
+/**
+ * @name ir_gjk_simplex_t
+ * @brief The simplex GJK ended on, with each vertex's weight in the
+ * point closest to the origin.
+ */
+typedef struct ir_gjk_simplex
+{
+    ir_gjk_vertex_t vertices[4];
+    float weights[4];
+    uint32_t count;
+} ir_gjk_simplex_t;
+
+/**
+ * @name ir_gjk_result_t
+ * @brief The closest points between two shapes' cores.
+ */
+typedef struct ir_gjk_result
+{
+    ir_vec3_t point_a;
+    ir_vec3_t point_b;
+    float distance;
+    bool overlap;
+    uint32_t iterations;
+    ir_gjk_simplex_t simplex;
+} ir_gjk_result_t;
+
+/**
+ * @name ir_epa_result_t
+ * @brief How deeply two shapes' cores penetrate.
+ */
+typedef struct ir_epa_result
+{
+    /**
+     * @name normal
+     * @brief The direction to push b to separate the cores.
+     */
+    ir_vec3_t normal;
+    float depth;
+    ir_vec3_t point_a;
+    ir_vec3_t point_b;
+} ir_epa_result_t;
+
+/**
+ * @name ir_contact_t
+ * @brief Where two shapes touch, radii included.
+ */
+typedef struct ir_contact
+{
+    /**
+     * @name normal
+     * @brief The unit normal, from a towards b.
+     */
+    ir_vec3_t normal;
+    /**
+     * @name point_a
+     * @brief The deepest point of a's surface along the normal.
+     */
+    ir_vec3_t point_a;
+    /**
+     * @name point_b
+     * @brief The deepest point of b's surface against the normal.
+     */
+    ir_vec3_t point_b;
+    /**
+     * @name separation
+     * @brief The gap between the surfaces; negative when they overlap.
+     */
+    float separation;
+    /**
+     * @name direction
+     * @brief Where to start the next query between the same pair.
+     */
+    ir_vec3_t direction;
+} ir_contact_t;
+
+/**
+ * @name Gjk
+ * @authors Israfiel
+ * @brief Find the closest points between two shapes' cores.
+ *
+ * @param a - The first shape.
+ * @param transform_a - Where the first shape is.
+ * @param b - The second shape.
+ * @param transform_b - Where the second shape is.
+ * @param direction - A guess at a - b's closest point, such as last
+ * frame's; zero to guess from the transforms.
+ * @param result - Filled with the closest points.
+ */
+void Ir_Gjk(const ir_shape_t *a, const ir_transform_t *transform_a,
+            const ir_shape_t *b, const ir_transform_t *transform_b,
+            ir_vec3_t direction, ir_gjk_result_t *result);
+
+/**
+ * @name Epa
+ * @authors Israfiel
+ * @brief Find how deeply two overlapping cores penetrate, starting
+ * from the simplex GJK found overlapping.
+ *
+ * @param a - The first shape.
+ * @param transform_a - Where the first shape is.
+ * @param b - The second shape.
+ * @param transform_b - Where the second shape is.
+ * @param simplex - The simplex GJK ended on.
+ * @param result - Filled with the penetration.
+ * @returns Whether the penetration was found; false for degenerate
+ * cores such as two points.
+ */
+bool Ir_Epa(const ir_shape_t *a, const ir_transform_t *transform_a,
+            const ir_shape_t *b, const ir_transform_t *transform_b,
+            const ir_gjk_simplex_t *simplex, ir_epa_result_t *result);
+
+/**
+ * @name ShapeContact
+ * @authors Israfiel
+ * @brief Find where two shapes touch, or how far apart they are.
+ *
+ * @param a - The first shape.
+ * @param transform_a - Where the first shape is.
+ * @param b - The second shape.
+ * @param transform_b - Where the second shape is.
+ * @param direction - The last query's direction, or zero.
+ * @param contact - Filled with the contact.
+ */
+void Ir_ShapeContact(const ir_shape_t *a,
+                     const ir_transform_t *transform_a,
+                     const ir_shape_t *b,
+                     const ir_transform_t *transform_b,
+                     ir_vec3_t direction, ir_contact_t *contact);
+
+/**
+ * @name ShapeCast
+ * @authors Israfiel
+ * @brief Move a shape in a straight line, without turning, and find
+ * where it first touches another. This is GJK's ray cast: rather than
+ * stepping forward by a bound on how fast the gap closes, it jumps
+ * straight to each support plane in the way, so it ends in as few
+ * steps as GJK itself. A ray is a cast of a point.
+ *
+ * @param a - The moving shape.
+ * @param transform_a - Where the moving shape starts.
+ * @param motion - How far it moves.
+ * @param b - The other shape.
+ * @param transform_b - Where the other shape is.
+ * @param fraction - Filled with how far along the motion they touch,
+ * zero to one; zero if they start touching.
+ * @param contact - Filled with the contact once a has moved there.
+ * @returns Whether they touch during the motion.
+ */
+bool Ir_ShapeCast(const ir_shape_t *a, const ir_transform_t *transform_a,
+                  ir_vec3_t motion, const ir_shape_t *b,
+                  const ir_transform_t *transform_b, float *fraction,
+                  ir_contact_t *contact);
+
+#endif // IRIDIUM_PHYSICS_GJK_H
@@ -0,0 +1,431 @@
+/**
+ * @file Heightfield.c
+ * @authors Israfiel
+ * @brief Implements Iridium's terrain collision.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Heightfield.h"
+
+#include "Math/SIMD.h"
+
+#include <float.h>
+#include <math.h>
+
+/**
+ * @name ir_heightfield_ray_t
+ * @brief A ray being walked through the terrain.
+ */
+typedef struct ir_heightfield_ray
+{
+    const ir_terrain_t *terrain;
+    ir_vec3_t origin;
+    ir_vec3_t direction;
+    float distance;
+    float hit;
+    ir_vec3_t normal;
+} ir_heightfield_ray_t;
+
+/**
+ * @name ir_heightfield_visit_t
+ * @brief Look at one square of a grid a ray is walking through.
+ *
+ * @param ray - The ray.
+ * @param x - The square's column.
+ * @param z - The square's row.
+ * @param begin - How far along the ray it enters the square.
+ * @param end - How far along the ray it leaves.
+ * @returns Whether to stop walking.
+ */
+typedef bool (*ir_heightfield_visit_t)(ir_heightfield_ray_t *ray,
+                                       int64_t x, int64_t z, float begin,
+                                       float end);
+
+/**
+ * @name ir_heightfield_triangle_t
+ * @brief A cell's triangle, as a hull GJK can take.
+ */
+typedef struct ir_heightfield_triangle
+{
+    float x[IR_SIMD_WIDTH];
+    float y[IR_SIMD_WIDTH];
+    float z[IR_SIMD_WIDTH];
+    ir_hull_t hull;
+    ir_shape_t shape;
+} ir_heightfield_triangle_t;
+
+/**
+ * @name Corners
+ * @authors Israfiel
+ * @brief Find a cell's corners: its lower corner, then along x, along
+ * z, and the upper corner.
+ *
+ * @param terrain - The terrain.
+ * @param x - The cell's column.
+ * @param z - The cell's row.
+ * @param corners - Filled with the corners.
+ * @returns Whether the cell is resident.
+ */
+static bool Corners(const ir_terrain_t *terrain, int64_t x, int64_t z,
+                    ir_vec3_t corners[4])
+{
+    float spacing = terrain->archive->spacing;
+    for (int i = 0; i < 4; ++i)
+    {
+        int64_t u = x + (i & 1), v = z + (i >> 1);
+        float height;
+        if (!Ir_TerrainSample(terrain, u, v, &height)) return false;
+        corners[i] =
+            Ir_Vec3((float)u * spacing, height, (float)v * spacing);
+    }
+    return true;
+}
+
+/**
+ * @name MakeTriangle
+ * @authors Israfiel
+ * @brief Make one of a cell's triangles into a hull, padded like any
+ * other by repeating its first point.
+ *
+ * @param triangle - Filled with the triangle.
+ * @param corners - The cell's corners.
+ * @param upper - Whether to make the triangle on z's side of the split
+ * rather than x's.
+ */
+static void MakeTriangle(ir_heightfield_triangle_t *triangle,
+                         const ir_vec3_t corners[4], bool upper)
+{
+    const uint32_t points[2][IR_SIMD_WIDTH] = {{0, 1, 3, 0}, {0, 3, 2, 0}};
+    for (int i = 0; i < IR_SIMD_WIDTH; ++i)
+    {
+        ir_vec3_t point = corners[points[upper][i]];
+        triangle->x[i] = point.x;
+        triangle->y[i] = point.y;
+        triangle->z[i] = point.z;
+    }
+    triangle->hull = (ir_hull_t){triangle->x, triangle->y, triangle->z, 3};
+    triangle->shape = Ir_ShapeHull(&triangle->hull, 0.0f);
+}
+
+/**
+ * @name Intersect
+ * @authors Israfiel
+ * @brief Cast a ray against a triangle, from either side.
+ *
+ * @param ray - The ray.
+ * @param a - The first corner.
+ * @param b - The second corner.
+ * @param c - The third corner.
+ * @param hit - Filled with how far along the ray it hits.
+ * @returns Whether it hits within the ray's distance.
+ */
+static bool Intersect(const ir_heightfield_ray_t *ray, ir_vec3_t a,
+                      ir_vec3_t b, ir_vec3_t c, float *hit)
+{
+    ir_vec3_t ab = Ir_Vec3Sub(b, a), ac = Ir_Vec3Sub(c, a);
+    ir_vec3_t p = Ir_Vec3Cross(ray->direction, ac);
+    float determinant = Ir_Vec3Dot(ab, p);
+    if (fabsf(determinant) < 1e-12f) return false;
+
+    float inverse = 1.0f / determinant;
+    ir_vec3_t s = Ir_Vec3Sub(ray->origin, a);
+    float u = Ir_Vec3Dot(s, p) * inverse;
+    if (u < 0.0f || u > 1.0f) return false;
+    ir_vec3_t q = Ir_Vec3Cross(s, ab);
+    float v = Ir_Vec3Dot(ray->direction, q) * inverse;
+    if (v < 0.0f || u + v > 1.0f) return false;
+    float t = Ir_Vec3Dot(ac, q) * inverse;
+    if (t < 0.0f || t > ray->distance) return false;
+    *hit = t;
+    return true;
+}
+
+/**
+ * @name Walk
+ * @authors Israfiel
+ * @brief Step a ray through a grid's squares in order, over part of its
+ * length.
+ *
+ * @param ray - The ray.
+ * @param size - The squares' size, in metres.
+ * @param begin - How far along the ray to start.
+ * @param end - How far along the ray to stop.
+ * @param visit - Looks at each square.
+ * @returns Whether a visit stopped the walk.
+ */
+static bool Walk(ir_heightfield_ray_t *ray, float size, float begin,
+                 float end, ir_heightfield_visit_t visit)
+{
+    int64_t cell[2], step[2];
+    float next[2], delta[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        // x and z are the vector's first and third components.
+        float origin = Ir_Vec3Component(ray->origin, i * 2);
+        float direction = Ir_Vec3Component(ray->direction, i * 2);
+        float start = origin + direction * begin;
+        cell[i] = (int64_t)floorf(start / size);
+        if (direction < 0.0f && (float)cell[i] * size == start)
+            cell[i]--;
+        step[i] = direction < 0.0f ? -1 : 1;
+        if (direction == 0.0f)
+        {
+            next[i] = delta[i] = FLT_MAX;
+            continue;
+        }
+        float boundary = (float)(cell[i] + (step[i] > 0)) * size;
+        next[i] = (boundary - origin) / direction;
+        delta[i] = size / fabsf(direction);
+    }
+
+    for (float t = begin;;)
+    {
+        float exit = fminf(fminf(next[0], next[1]), end);
+        if (visit(ray, cell[0], cell[1], t, exit)) return true;
+        if (exit >= end) return false;
+        int i = next[0] <= next[1] ? 0 : 1;
+        cell[i] += step[i];
+        next[i] += delta[i];
+        t = exit;
+    }
+}
+
+/**
+ * @name VisitCell
+ * @authors Israfiel
+ * @brief Test a ray against a cell's two triangles.
+ *
+ * @param ray - The ray.
+ * @param x - The cell's column.
+ * @param z - The cell's row.
+ * @param begin - Unused.
+ * @param end - Unused.
+ * @returns Whether the ray hit, which ends the walk, since cells are
+ * visited nearest first.
+ */
+static bool VisitCell(ir_heightfield_ray_t *ray, int64_t x, int64_t z,
+                      float begin, float end)
+{
+    (void)begin;
+    (void)end;
+    ir_vec3_t corners[4];
+    if (!Corners(ray->terrain, x, z, corners)) return false;
+
+    bool found = false;
+    const int triangles[2][3] = {{0, 1, 3}, {0, 3, 2}};
+    for (int i = 0; i < 2; ++i)
+    {
+        ir_vec3_t a = corners[triangles[i][0]];
+        ir_vec3_t b = corners[triangles[i][1]];
+        ir_vec3_t c = corners[triangles[i][2]];
+        float t;
+        if (!Intersect(ray, a, b, c, &t)) continue;
+
+        ray->distance = t;
+        ray->hit = t;
+        ir_vec3_t normal =
+            Ir_Vec3Cross(Ir_Vec3Sub(c, a), Ir_Vec3Sub(b, a));
+        if (normal.y < 0.0f) normal = Ir_Vec3Negate(normal);
+        ray->normal = Ir_Vec3Normalize(normal, Ir_Vec3(0.0f, 1.0f, 0.0f));
+        found = true;
+    }
+    return found;
+}
+
+/**
+ * @name VisitBlock
+ * @authors Israfiel
+ * @brief Walk a ray through a block's cells, unless the block is not
+ * resident or the ray passes wholly over or under its heights.
+ *
+ * @param ray - The ray.
+ * @param x - The block's column.
+ * @param z - The block's row.
+ * @param begin - How far along the ray it enters the block.
+ * @param end - How far along the ray it leaves.
+ * @returns Whether the ray hit.
+ */
+static bool VisitBlock(ir_heightfield_ray_t *ray, int64_t x, int64_t z,
+                       float begin, float end)
+{
+    const ir_terrain_t *terrain = ray->terrain;
+    const ir_terrain_archive_t *archive = terrain->archive;
+    if (x < 0 || z < 0) return false;
+    int64_t chunk_x = x / IR_TERRAIN_BLOCKS;
+    int64_t chunk_z = z / IR_TERRAIN_BLOCKS;
+    if (chunk_x >= archive->width || chunk_z >= archive->depth)
+        return false;
+    uint32_t slot = terrain->resident[chunk_z * archive->width + chunk_x];
+    if (slot == IR_TERRAIN_NONE) return false;
+
+    uint32_t block = (uint32_t)((z - chunk_z * IR_TERRAIN_BLOCKS) *
+                                    IR_TERRAIN_BLOCKS +
+                                x - chunk_x * IR_TERRAIN_BLOCKS);
+    float y0 = ray->origin.y + ray->direction.y * begin;
+    float y1 = ray->origin.y + ray->direction.y * end;
+    if (fminf(y0, y1) > terrain->slots[slot].block_max[block] ||
+        fmaxf(y0, y1) < terrain->slots[slot].block_min[block])
+        return false;
+    return Walk(ray, archive->spacing, begin, end, VisitCell);
+}
+
+/**
+ * @name Cells
+ * @authors Israfiel
+ * @brief Find the range of cells under some bounds, clamped to the
+ * terrain.
+ *
+ * @param terrain - The terrain.
+ * @param min - The lower bounds.
+ * @param max - The upper bounds.
+ * @param first - Filled with the first cell's column and row.
+ * @param last - Filled with the last cell's column and row.
+ * @returns Whether any cells are under the bounds.
+ */
+static bool Cells(const ir_terrain_t *terrain, ir_vec3_t min,
+                  ir_vec3_t max, int64_t first[2], int64_t last[2])
+{
+    float spacing = terrain->archive->spacing;
+    int64_t limits[2] = {
+        (int64_t)terrain->archive->width * IR_TERRAIN_CHUNK - 1,
+        (int64_t)terrain->archive->depth * IR_TERRAIN_CHUNK - 1};
+    float lower[2] = {min.x, min.z}, upper[2] = {max.x, max.z};
+    for (int i = 0; i < 2; ++i)
+    {
+        first[i] = (int64_t)floorf(lower[i] / spacing);
+        last[i] = (int64_t)floorf(upper[i] / spacing);
+        if (first[i] < 0) first[i] = 0;
+        if (last[i] > limits[i]) last[i] = limits[i];
+        if (first[i] > last[i]) return false;
+    }
+    return true;
+}
+
+bool Ir_HeightfieldRay(const ir_terrain_t *terrain, ir_vec3_t origin,
+                       ir_vec3_t direction, float distance, float *hit,
+                       ir_vec3_t *normal)
+{
+    // Clip the ray to the terrain's footprint before walking it.
+    const ir_terrain_archive_t *archive = terrain->archive;
+    float extents[2] = {
+        (float)archive->width * IR_TERRAIN_CHUNK * archive->spacing,
+        (float)archive->depth * IR_TERRAIN_CHUNK * archive->spacing};
+    float start[2] = {origin.x, origin.z};
+    float heading[2] = {direction.x, direction.z};
+    float begin = 0.0f, end = distance;
+    for (int i = 0; i < 2; ++i)
+    {
+        if (heading[i] == 0.0f)
+        {
+            if (start[i] < 0.0f || start[i] > extents[i]) return false;
+            continue;
+        }
+        float t0 = -start[i] / heading[i];
+        float t1 = (extents[i] - start[i]) / heading[i];
+        begin = fmaxf(begin, fminf(t0, t1));
+        end = fminf(end, fmaxf(t0, t1));
+    }
+    if (begin > end) return false;
+
+    ir_heightfield_ray_t ray = {terrain, origin, direction, distance};
+    if (!Walk(&ray, archive->spacing * IR_TERRAIN_BLOCK, begin, end,
+              VisitBlock))
+        return false;
+    *hit = ray.hit;
+    *normal = ray.normal;
+    return true;
+}
+
+bool Ir_HeightfieldContact(const ir_terrain_t *terrain,
+                           const ir_shape_t *shape,
+                           const ir_transform_t *transform, float margin,
+                           ir_contact_t *contact)
+{
+    ir_vec3_t min, max;
+    Ir_ShapeBounds(shape, transform, &min, &max);
+    min = Ir_Vec3Sub(min, Ir_Vec3(margin, margin, margin));
+    max = Ir_Vec3Add(max, Ir_Vec3(margin, margin, margin));
+    int64_t first[2], last[2];
+    if (!Cells(terrain, min, max, first, last)) return false;
+
+    ir_transform_t identity = {Ir_Vec3(0.0f, 0.0f, 0.0f),
+                               IR_QUAT_IDENTITY};
+    bool found = false;
+    float deepest = margin;
+    for (int64_t z = first[1]; z <= last[1]; ++z)
+    {
+        for (int64_t x = first[0]; x <= last[0]; ++x)
+        {
+            ir_vec3_t corners[4];
+            if (!Corners(terrain, x, z, corners)) continue;
+            float top = fmaxf(fmaxf(corners[0].y, corners[1].y),
+                              fmaxf(corners[2].y, corners[3].y));
+            if (top < min.y) continue;
+
+            for (int i = 0; i < 2; ++i)
+            {
+                ir_heightfield_triangle_t triangle;
+                MakeTriangle(&triangle, corners, i == 1);
+                ir_contact_t found_contact;
+                Ir_ShapeContact(shape, transform, &triangle.shape,
+                                &identity, Ir_Vec3(0.0f, 0.0f, 0.0f),
+                                &found_contact);
+                if (found_contact.separation > deepest) continue;
+                deepest = found_contact.separation;
+                *contact = found_contact;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+bool Ir_HeightfieldCast(const ir_terrain_t *terrain,
+                        const ir_shape_t *shape,
+                        const ir_transform_t *transform, ir_vec3_t motion,
+                        float *fraction, ir_contact_t *contact)
+{
+    ir_vec3_t min, max;
+    Ir_ShapeBounds(shape, transform, &min, &max);
+    min = Ir_Vec3Min(min, Ir_Vec3Add(min, motion));
+    max = Ir_Vec3Max(max, Ir_Vec3Add(max, motion));
+    int64_t first[2], last[2];
+    if (!Cells(terrain, min, max, first, last)) return false;
+
+    ir_transform_t identity = {Ir_Vec3(0.0f, 0.0f, 0.0f),
+                               IR_QUAT_IDENTITY};
+    bool found = false;
+    float earliest = FLT_MAX;
+    for (int64_t z = first[1]; z <= last[1]; ++z)
+    {
+        for (int64_t x = first[0]; x <= last[0]; ++x)
+        {
+            ir_vec3_t corners[4];
+            if (!Corners(terrain, x, z, corners)) continue;
+            float top = fmaxf(fmaxf(corners[0].y, corners[1].y),
+                              fmaxf(corners[2].y, corners[3].y));
+            if (top < min.y) continue;
+
+            for (int i = 0; i < 2; ++i)
+            {
+                ir_heightfield_triangle_t triangle;
+                MakeTriangle(&triangle, corners, i == 1);
+                float t;
+                ir_contact_t found_contact;
+                if (!Ir_ShapeCast(shape, transform, motion,
+                                  &triangle.shape, &identity, &t,
+                                  &found_contact) ||
+                    t >= earliest)
+                    continue;
+                earliest = t;
+                *contact = found_contact;
+                found = true;
+            }
+        }
+    }
+    if (found) *fraction = earliest;
+    return found;
+}
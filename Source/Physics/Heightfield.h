@@ -0,0 +1,84 @@
+/**
+ * @file Heightfield.h
+ * @authors Israfiel
+ * @brief Iridium's terrain collision. Nothing is triangulated ahead of
+ * time: each cell of the resident terrain is two triangles, split from
+ * its lower corner to its upper, made on the spot when a query reaches
+ * it. Rays step through blocks first, skipping any whose height range
+ * they pass over or under, and only then through the blocks' cells.
+ * Shapes, capsules above all, are tested against the few cells under
+ * their bounds, each triangle as a flat hull through GJK.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PHYSICS_HEIGHTFIELD_H
+#define IRIDIUM_PHYSICS_HEIGHTFIELD_H
+
+#include "Math/Quaternion.h"
+#include "Physics/GJK.h"
+#include "Physics/Shape.h"
+#include "Terrain/Terrain.h"
+
+#include <stdbool.h>
+
+/**
+ * @name HeightfieldRay
+ * @authors Israfiel
+ * @brief Cast a ray against the resident terrain.
+ *
+ * @param terrain - The terrain.
+ * @param origin - Where the ray starts.
+ * @param direction - The ray's unit direction.
+ * @param distance - How far the ray reaches, in metres.
+ * @param hit - Filled with how far along the ray it hits.
+ * @param normal - Filled with the surface's upward unit normal there.
+ * @returns Whether the ray hits.
+ */
+bool Ir_HeightfieldRay(const ir_terrain_t *terrain, ir_vec3_t origin,
+                       ir_vec3_t direction, float distance, float *hit,
+                       ir_vec3_t *normal);
+
+/**
+ * @name HeightfieldContact
+ * @authors Israfiel
+ * @brief Find the deepest contact between a shape and the resident
+ * terrain, such as a character's capsule standing on it.
+ *
+ * @param terrain - The terrain.
+ * @param shape - The shape.
+ * @param transform - Where the shape is.
+ * @param margin - The gap, in metres, still counted as a contact.
+ * @param contact - Filled with the contact, from the shape towards the
+ * terrain.
+ * @returns Whether the shape is within the margin of the terrain.
+ */
+bool Ir_HeightfieldContact(const ir_terrain_t *terrain,
+                           const ir_shape_t *shape,
+                           const ir_transform_t *transform, float margin,
+                           ir_contact_t *contact);
+
+/**
+ * @name HeightfieldCast
+ * @authors Israfiel
+ * @brief Move a shape in a straight line, without turning, and find
+ * where it first touches the resident terrain. Every cell under the
+ * whole motion is tested, so it's meant for a frame's movement rather
+ * than a long throw.
+ *
+ * @param terrain - The terrain.
+ * @param shape - The shape.
+ * @param transform - Where the shape starts.
+ * @param motion - How far it moves.
+ * @param fraction - Filled with how far along the motion it touches.
+ * @param contact - Filled with the contact once it has moved there.
+ * @returns Whether it touches during the motion.
+ */
+bool Ir_HeightfieldCast(const ir_terrain_t *terrain,
+                        const ir_shape_t *shape,
+                        const ir_transform_t *transform, ir_vec3_t motion,
+                        float *fraction, ir_contact_t *contact);
+
+#endif // IRIDIUM_PHYSICS_HEIGHTFIELD_H
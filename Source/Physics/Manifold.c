@@ -0,0 +1,357 @@
+/**
+ * @file Manifold.c
+ * @authors Israfiel
+ * @brief Implements Iridium's contact manifolds.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Manifold.h"
+
+#include <float.h>
+#include <math.h>
+
+/**
+ * @name CLIPPED
+ * @brief The most points clipping can leave: a convex polygon cut by
+ * another gains at most one vertex per cut.
+ */
+#define CLIPPED (2 * IR_SHAPE_FEATURE)
+
+/**
+ * @name MIN_SQUARE
+ * @brief How square to the normal, as a cosine, a reference face must
+ * be; past that, gaps measured from it along the normal grow wild.
+ */
+#define MIN_SQUARE 0.5f
+
+/**
+ * @name Feature
+ * @authors Israfiel
+ * @brief Find a placed shape's feature facing a world direction.
+ *
+ * @param shape - The shape.
+ * @param transform - Where the shape is.
+ * @param direction - The world direction.
+ * @param points - Filled with the feature's world vertices.
+ * @returns The number of vertices.
+ */
+static uint32_t Feature(const ir_shape_t *shape,
+                        const ir_transform_t *transform,
+                        ir_vec3_t direction,
+                        ir_vec3_t points[IR_SHAPE_FEATURE])
+{
+    ir_vec3_t local = Ir_QuatRotate(Ir_QuatConjugate(transform->rotation),
+                                    direction);
+    uint32_t count = Ir_ShapeFeature(shape, local, points);
+    for (uint32_t i = 0; i < count; ++i)
+        points[i] = Ir_TransformPoint(transform, points[i]);
+    return count;
+}
+
+/**
+ * @name Order
+ * @authors Israfiel
+ * @brief Sort a feature's vertices anticlockwise about the normal.
+ *
+ * @param points - The vertices.
+ * @param count - The number of vertices.
+ * @param t1 - The normal's first tangent.
+ * @param t2 - The normal's second tangent.
+ */
+static void Order(ir_vec3_t *points, uint32_t count, ir_vec3_t t1,
+                  ir_vec3_t t2)
+{
+    ir_vec3_t centre = Ir_Vec3(0.0f, 0.0f, 0.0f);
+    for (uint32_t i = 0; i < count; ++i)
+        centre = Ir_Vec3Add(centre, points[i]);
+    centre = Ir_Vec3Scale(centre, 1.0f / (float)count);
+
+    float angles[IR_SHAPE_FEATURE];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        ir_vec3_t offset = Ir_Vec3Sub(points[i], centre);
+        angles[i] = atan2f(Ir_Vec3Dot(offset, t2), Ir_Vec3Dot(offset, t1));
+    }
+    for (uint32_t i = 1; i < count; ++i)
+    {
+        float angle = angles[i];
+        ir_vec3_t point = points[i];
+        uint32_t j = i;
+        for (; j > 0 && angles[j - 1] > angle; --j)
+        {
+            angles[j] = angles[j - 1];
+            points[j] = points[j - 1];
+        }
+        angles[j] = angle;
+        points[j] = point;
+    }
+}
+
+/**
+ * @name Normal
+ * @authors Israfiel
+ * @brief Find the unit normal of an ordered polygon by Newell's method,
+ * which stays steady however many vertices it has.
+ *
+ * @param points - The polygon's vertices, anticlockwise.
+ * @param count - The number of vertices, at least three.
+ * @param fallback - What to return if the polygon has no area.
+ * @returns The normal.
+ */
+static ir_vec3_t Normal(const ir_vec3_t *points, uint32_t count,
+                        ir_vec3_t fallback)
+{
+    ir_vec3_t normal = Ir_Vec3(0.0f, 0.0f, 0.0f);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        ir_vec3_t p = points[i], q = points[(i + 1) % count];
+        normal = Ir_Vec3Add(
+            normal, Ir_Vec3((p.y - q.y) * (p.z + q.z),
+                            (p.z - q.z) * (p.x + q.x),
+                            (p.x - q.x) * (p.y + q.y)));
+    }
+    return Ir_Vec3Normalize(normal, fallback);
+}
+
+/**
+ * @name Clip
+ * @authors Israfiel
+ * @brief Cut away the part of a polygon, or a segment, behind a plane.
+ *
+ * @param in - The polygon's vertices, in order.
+ * @param count - The number of vertices.
+ * @param origin - A point on the plane.
+ * @param inward - The plane's normal, pointing at the part to keep.
+ * @param out - Filled with what's kept.
+ * @returns The number of vertices kept.
+ */
+static uint32_t Clip(const ir_vec3_t *in, uint32_t count, ir_vec3_t origin,
+                     ir_vec3_t inward, ir_vec3_t *out)
+{
+    // A segment is a polygon that doesn't close; clipping it as one
+    // would add its far end twice.
+    uint32_t edges = count == 2 ? 1 : count, kept = 0;
+    for (uint32_t i = 0; i < edges; ++i)
+    {
+        ir_vec3_t p = in[i], q = in[(i + 1) % count];
+        float dp = Ir_Vec3Dot(Ir_Vec3Sub(p, origin), inward);
+        float dq = Ir_Vec3Dot(Ir_Vec3Sub(q, origin), inward);
+        if (dp >= 0.0f) out[kept++] = p;
+        if ((dp >= 0.0f) != (dq >= 0.0f))
+        {
+            float t = dp / (dp - dq);
+            out[kept++] = Ir_Vec3Add(p, Ir_Vec3Scale(Ir_Vec3Sub(q, p), t));
+        }
+        if (count == 2 && dq >= 0.0f) out[kept++] = q;
+    }
+    return kept;
+}
+
+/**
+ * @name Single
+ * @authors Israfiel
+ * @brief Make a manifold of just the deepest point.
+ *
+ * @param contact - The deepest point.
+ * @param transform_a - Where the first shape is.
+ * @param manifold - Filled with the manifold.
+ */
+static void Single(const ir_contact_t *contact,
+                   const ir_transform_t *transform_a,
+                   ir_manifold_t *manifold)
+{
+    manifold->count = 1;
+    manifold->points[0] = (ir_manifold_point_t){
+        contact->point_a, contact->point_b, contact->separation,
+        Ir_TransformInversePoint(transform_a, contact->point_a)};
+}
+
+/**
+ * @name Reduce
+ * @authors Israfiel
+ * @brief Pick the four points spanning the most area: the deepest, the
+ * one furthest from it, and the furthest to either side of the line
+ * between them.
+ *
+ * @param points - The points.
+ * @param count - The number of points, more than four.
+ * @param normal - The manifold's normal.
+ * @param kept - Filled with the indices kept.
+ * @returns The number of points kept.
+ */
+static uint32_t Reduce(const ir_manifold_point_t *points, uint32_t count,
+                       ir_vec3_t normal, uint32_t kept[4])
+{
+    uint32_t first = 0;
+    for (uint32_t i = 1; i < count; ++i)
+        if (points[i].separation < points[first].separation) first = i;
+
+    uint32_t second = first;
+    float furthest = 0.0f;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float distance = Ir_Vec3LengthSquared(
+            Ir_Vec3Sub(points[i].point_b, points[first].point_b));
+        if (distance <= furthest) continue;
+        furthest = distance;
+        second = i;
+    }
+    kept[0] = first;
+    if (second == first) return 1;
+    kept[1] = second;
+
+    ir_vec3_t line = Ir_Vec3Sub(points[second].point_b,
+                                points[first].point_b);
+    uint32_t left = first, right = first;
+    float most = 0.0f, least = 0.0f;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        ir_vec3_t offset =
+            Ir_Vec3Sub(points[i].point_b, points[first].point_b);
+        float area = Ir_Vec3Dot(Ir_Vec3Cross(line, offset), normal);
+        if (area > most)
+        {
+            most = area;
+            left = i;
+        }
+        if (area < least)
+        {
+            least = area;
+            right = i;
+        }
+    }
+
+    uint32_t total = 2;
+    if (left != first) kept[total++] = left;
+    if (right != first) kept[total++] = right;
+    return total;
+}
+
+void Ir_ShapeManifold(const ir_shape_t *a,
+                      const ir_transform_t *transform_a,
+                      const ir_shape_t *b,
+                      const ir_transform_t *transform_b,
+                      ir_vec3_t direction, ir_manifold_t *manifold)
+{
+    ir_contact_t contact;
+    Ir_ShapeContact(a, transform_a, b, transform_b, direction, &contact);
+    ir_vec3_t n = contact.normal;
+    manifold->normal = n;
+    manifold->direction = contact.direction;
+
+    ir_vec3_t features_a[IR_SHAPE_FEATURE], features_b[IR_SHAPE_FEATURE];
+    uint32_t count_a = Feature(a, transform_a, n, features_a);
+    uint32_t count_b =
+        Feature(b, transform_b, Ir_Vec3Negate(n), features_b);
+    if (count_a < 2 || count_b < 2)
+    {
+        Single(&contact, transform_a, manifold);
+        return;
+    }
+
+    ir_vec3_t t1, t2;
+    Ir_Vec3Tangents(n, &t1, &t2);
+    if (count_a > 2) Order(features_a, count_a, t1, t2);
+    if (count_b > 2) Order(features_b, count_b, t1, t2);
+
+    // The face squarer to the normal is the reference the other feature
+    // is clipped against; a segment has no face and is never preferred.
+    // Ordered about n, either face's normal points along it.
+    ir_vec3_t normal_a = n, normal_b = n;
+    float square_a = 0.0f, square_b = 0.0f;
+    if (count_a > 2)
+    {
+        normal_a = Normal(features_a, count_a, n);
+        square_a = Ir_Vec3Dot(normal_a, n);
+    }
+    if (count_b > 2)
+    {
+        normal_b = Normal(features_b, count_b, n);
+        square_b = Ir_Vec3Dot(normal_b, n);
+    }
+    bool flip = square_b > square_a;
+    float square = flip ? square_b : square_a;
+    if (square < MIN_SQUARE && (count_a > 2 || count_b > 2))
+    {
+        Single(&contact, transform_a, manifold);
+        return;
+    }
+    ir_vec3_t *reference = flip ? features_b : features_a;
+    ir_vec3_t *incident = flip ? features_a : features_b;
+    uint32_t reference_count = flip ? count_b : count_a;
+    uint32_t incident_count = flip ? count_a : count_b;
+
+    // EPA's normal wobbles a little between flat faces, and measuring
+    // heights along it across a wide face multiplies the wobble, so gaps
+    // are measured from the face's own plane instead.
+    ir_vec3_t face = flip ? normal_b : normal_a;
+
+    ir_vec3_t buffers[2][CLIPPED];
+    ir_vec3_t *clipped = buffers[0];
+    uint32_t count = incident_count;
+    for (uint32_t i = 0; i < count; ++i) clipped[i] = incident[i];
+    uint32_t planes = reference_count == 2 ? 2 : reference_count;
+    for (uint32_t i = 0; i < planes && count != 0; ++i)
+    {
+        ir_vec3_t from = reference[i];
+        ir_vec3_t to = reference[(i + 1) % reference_count];
+        ir_vec3_t inward =
+            reference_count == 2
+                ? Ir_Vec3Sub(to, from)
+                : Ir_Vec3Cross(face, Ir_Vec3Sub(to, from));
+        ir_vec3_t *out = clipped == buffers[0] ? buffers[1] : buffers[0];
+        count = Clip(clipped, count, from, inward, out);
+        clipped = out;
+    }
+    if (count == 0)
+    {
+        Single(&contact, transform_a, manifold);
+        return;
+    }
+
+    // A segment has no plane of its own, but is short enough that its
+    // furthest end along the normal does.
+    float plane = Ir_Vec3Dot(reference[0], face);
+    if (reference_count == 2)
+        plane = flip ? fminf(plane, Ir_Vec3Dot(reference[1], n))
+                     : fmaxf(plane, Ir_Vec3Dot(reference[1], n));
+    float scale = 1.0f / (flip ? -square : square);
+    if (reference_count == 2) scale = flip ? -1.0f : 1.0f;
+
+    ir_manifold_point_t points[CLIPPED];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        ir_vec3_t q = clipped[i];
+        float gap = (Ir_Vec3Dot(q, face) - plane) * scale;
+        ir_manifold_point_t *point = &points[i];
+        if (flip)
+        {
+            point->point_a = Ir_Vec3Add(q, Ir_Vec3Scale(n, a->radius));
+            point->point_b =
+                Ir_Vec3Add(q, Ir_Vec3Scale(n, gap - b->radius));
+        }
+        else
+        {
+            point->point_a =
+                Ir_Vec3Sub(q, Ir_Vec3Scale(n, gap - a->radius));
+            point->point_b = Ir_Vec3Sub(q, Ir_Vec3Scale(n, b->radius));
+        }
+        point->separation = gap - a->radius - b->radius;
+        point->anchor =
+            Ir_TransformInversePoint(transform_a, point->point_a);
+    }
+
+    uint32_t kept[IR_MANIFOLD_POINTS];
+    if (count > IR_MANIFOLD_POINTS)
+    {
+        manifold->count = Reduce(points, count, n, kept);
+        for (uint32_t i = 0; i < manifold->count; ++i)
+            manifold->points[i] = points[kept[i]];
+        return;
+    }
+    manifold->count = count;
+    for (uint32_t i = 0; i < count; ++i) manifold->points[i] = points[i];
+}
@@ -0,0 +1,90 @@
+/**
+ * @file Manifold.h
+ * @authors Israfiel
+ * @brief Iridium's contact manifolds. GJK and EPA find the single
+ * deepest point between two shapes, which can't hold a box flat on the
+ * ground; the manifold widens it to up to four points by clipping the
+ * features the two shapes present to each other.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PHYSICS_MANIFOLD_H
+#define IRIDIUM_PHYSICS_MANIFOLD_H
+
+#include "Math/Quaternion.h"
+#include "Physics/GJK.h"
+#include "Physics/Shape.h"
+
+#include <stdint.h>
+
+/**
+ * @name IR_MANIFOLD_POINTS
+ * @brief The most points in a manifold.
+ */
+#define IR_MANIFOLD_POINTS 4
+
+/**
+ * @name ir_manifold_point_t
+ * @brief One point of a manifold, radii included.
+ */
+typedef struct ir_manifold_point
+{
+    ir_vec3_t point_a;
+    ir_vec3_t point_b;
+    /**
+     * @name separation
+     * @brief The gap between the surfaces along the manifold's normal;
+     * negative when they overlap.
+     */
+    float separation;
+    /**
+     * @name anchor
+     * @brief The point on a in a's space, which tells the same point
+     * apart from the others between updates.
+     */
+    ir_vec3_t anchor;
+} ir_manifold_point_t;
+
+/**
+ * @name ir_manifold_t
+ * @brief Where two shapes touch.
+ */
+typedef struct ir_manifold
+{
+    /**
+     * @name normal
+     * @brief The unit normal, from a towards b.
+     */
+    ir_vec3_t normal;
+    ir_manifold_point_t points[IR_MANIFOLD_POINTS];
+    uint32_t count;
+    /**
+     * @name direction
+     * @brief Where to start the next query between the same pair.
+     */
+    ir_vec3_t direction;
+} ir_manifold_t;
+
+/**
+ * @name ShapeManifold
+ * @authors Israfiel
+ * @brief Find where two shapes touch, or how far apart they are, as
+ * up to four points sharing a normal.
+ *
+ * @param a - The first shape.
+ * @param transform_a - Where the first shape is.
+ * @param b - The second shape.
+ * @param transform_b - Where the second shape is.
+ * @param direction - The last query's direction, or zero.
+ * @param manifold - Filled with the manifold.
+ */
+void Ir_ShapeManifold(const ir_shape_t *a,
+                      const ir_transform_t *transform_a,
+                      const ir_shape_t *b,
+                      const ir_transform_t *transform_b,
+                      ir_vec3_t direction, ir_manifold_t *manifold);
+
+#endif // IRIDIUM_PHYSICS_MANIFOLD_H
@@ -0,0 +1,196 @@
+/**
+ * @file Narrowphase.c
+ * @authors Israfiel
+ * @brief Implements Iridium's narrowphase.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Narrowphase.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+
+#include <stdlib.h>
+
+/**
+ * @name PairKey
+ * @authors Israfiel
+ * @brief Pack a pair into a key ordered like the broadphase's pairs.
+ *
+ * @param a - The lesser proxy.
+ * @param b - The greater proxy.
+ * @returns The key.
+ */
+static uint64_t PairKey(uint32_t a, uint32_t b)
+{
+    return (uint64_t)a << 32 | b;
+}
+
+/**
+ * @name LowerBound
+ * @authors Israfiel
+ * @brief Find the first of last update's contacts not ordered before a
+ * pair.
+ *
+ * @param narrowphase - The narrowphase.
+ * @param key - The pair's key.
+ * @returns The contact's index.
+ */
+static uint32_t LowerBound(const ir_narrowphase_t *narrowphase,
+                           uint64_t key)
+{
+    uint32_t low = 0, high = narrowphase->previous_count;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        const ir_narrowphase_contact_t *contact =
+            &narrowphase->previous[middle];
+        if (PairKey(contact->a, contact->b) < key) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+/**
+ * @name Match
+ * @authors Israfiel
+ * @brief Give each point of a manifold the impulses of last update's
+ * nearest point, if it's near enough to be the same one.
+ *
+ * @param contact - The contact.
+ * @param previous - The same pair's contact last update, or NULL.
+ */
+static void Match(ir_narrowphase_contact_t *contact,
+                  const ir_narrowphase_contact_t *previous)
+{
+    for (uint32_t i = 0; i < contact->manifold.count; ++i)
+    {
+        float *impulses = contact->impulses[i];
+        impulses[0] = impulses[1] = impulses[2] = 0.0f;
+        if (previous == NULL) continue;
+
+        float nearest = IR_NARROWPHASE_MATCH * IR_NARROWPHASE_MATCH;
+        for (uint32_t j = 0; j < previous->manifold.count; ++j)
+        {
+            float distance = Ir_Vec3LengthSquared(
+                Ir_Vec3Sub(contact->manifold.points[i].anchor,
+                           previous->manifold.points[j].anchor));
+            if (distance >= nearest) continue;
+            nearest = distance;
+            for (int k = 0; k < 3; ++k)
+                impulses[k] = previous->impulses[j][k];
+        }
+    }
+}
+
+/**
+ * @name Query
+ * @authors Israfiel
+ * @brief Find the contacts for a range of pairs. The range's first pair
+ * is searched for in last update's contacts, and the rest are found by
+ * walking forward from it alongside the range.
+ *
+ * @param user - The narrowphase.
+ * @param begin - The range's first pair.
+ * @param end - One past the range's last pair.
+ */
+static void Query(void *user, size_t begin, size_t end)
+{
+    ir_narrowphase_t *narrowphase = user;
+    const ir_broadphase_pair_t *pairs = narrowphase->broadphase->pairs;
+    const ir_narrowphase_contact_t *previous = narrowphase->previous;
+    const ir_shape_t *shapes = narrowphase->shapes;
+    const ir_transform_t *transforms = narrowphase->transforms;
+
+    uint32_t cursor =
+        LowerBound(narrowphase, PairKey(pairs[begin].a, pairs[begin].b));
+    uint32_t cached = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        uint32_t a = pairs[i].a, b = pairs[i].b;
+        uint64_t key = PairKey(a, b);
+        while (cursor < narrowphase->previous_count &&
+               PairKey(previous[cursor].a, previous[cursor].b) < key)
+            cursor++;
+
+        ir_narrowphase_contact_t *contact = &narrowphase->contacts[i];
+        contact->a = a;
+        contact->b = b;
+        contact->cached =
+            cursor < narrowphase->previous_count &&
+            PairKey(previous[cursor].a, previous[cursor].b) == key;
+        Ir_ShapeManifold(&shapes[a], &transforms[a], &shapes[b],
+                         &transforms[b],
+                         contact->cached
+                             ? previous[cursor].manifold.direction
+                             : Ir_Vec3(0.0f, 0.0f, 0.0f),
+                         &contact->manifold);
+        Match(contact, contact->cached ? &previous[cursor] : NULL);
+        cached += contact->cached;
+    }
+    atomic_fetch_add_explicit(&narrowphase->cached_count, cached,
+                              memory_order_relaxed);
+}
+
+void Ir_NarrowphaseCreate(ir_narrowphase_t *narrowphase)
+{
+    *narrowphase = (ir_narrowphase_t){0};
+}
+
+void Ir_NarrowphaseDestroy(ir_narrowphase_t *narrowphase)
+{
+    free(narrowphase->contacts);
+    free(narrowphase->previous);
+    *narrowphase = (ir_narrowphase_t){0};
+}
+
+bool Ir_NarrowphaseUpdate(ir_narrowphase_t *narrowphase,
+                          const ir_broadphase_t *broadphase,
+                          const ir_shape_t *shapes,
+                          const ir_transform_t *transforms,
+                          ir_jobs_t *jobs)
+{
+    // This update's contacts go where the update before's were, which
+    // are no longer needed.
+    ir_narrowphase_contact_t *swap = narrowphase->previous;
+    narrowphase->previous = narrowphase->contacts;
+    narrowphase->contacts = swap;
+    uint32_t capacity = narrowphase->previous_capacity;
+    narrowphase->previous_capacity = narrowphase->capacity;
+    narrowphase->capacity = capacity;
+    narrowphase->previous_count = narrowphase->contact_count;
+    narrowphase->contact_count = 0;
+    atomic_store_explicit(&narrowphase->cached_count, 0,
+                          memory_order_relaxed);
+
+    uint32_t count = broadphase->pair_count;
+    if (count == 0) return true;
+    if (narrowphase->capacity < count)
+    {
+        ir_narrowphase_contact_t *grown =
+            malloc(count * sizeof(ir_narrowphase_contact_t));
+        if (grown == NULL)
+        {
+            IR_LOG_ERROR("Ran out of memory finding contacts.");
+            return false;
+        }
+        free(narrowphase->contacts);
+        narrowphase->contacts = grown;
+        narrowphase->capacity = count;
+    }
+
+    IR_PROFILE_BEGIN("Narrowphase");
+    narrowphase->broadphase = broadphase;
+    narrowphase->shapes = shapes;
+    narrowphase->transforms = transforms;
+    if (jobs != NULL)
+        Ir_JobsParallelFor(jobs, count, IR_NARROWPHASE_GRAIN, Query,
+                           narrowphase);
+    else Query(narrowphase, 0, count);
+    narrowphase->contact_count = count;
+    IR_PROFILE_END("Narrowphase");
+    return true;
+}
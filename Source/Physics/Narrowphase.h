@@ -0,0 +1,133 @@
+/**
+ * @file Narrowphase.h
+ * @authors Israfiel
+ * @brief Iridium's narrowphase, which builds a manifold for every pair
+ * the broadphase found. Each pair's query starts from the direction it
+ * ended on last update, so resting pairs converge in one or two GJK
+ * iterations, and each point carries over the impulses the solver gave
+ * the same point last update. Both updates' contacts are sorted like
+ * the broadphase's pairs, so finding last update's contact is a merge
+ * rather than a lookup.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PHYSICS_NARROWPHASE_H
+#define IRIDIUM_PHYSICS_NARROWPHASE_H
+
+#include "Core/Jobs.h"
+#include "Math/Quaternion.h"
+#include "Physics/Broadphase.h"
+#include "Physics/Manifold.h"
+#include "Physics/Shape.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_NARROWPHASE_GRAIN
+ * @brief The number of pairs each narrowphase job queries.
+ */
+#define IR_NARROWPHASE_GRAIN 128
+
+/**
+ * @name IR_NARROWPHASE_MATCH
+ * @brief How far, in metres, a manifold point may drift across a's
+ * surface between updates and still count as the same point.
+ */
+#define IR_NARROWPHASE_MATCH 0.05f
+
+/**
+ * @name ir_narrowphase_contact_t
+ * @brief The contact between two proxies, the lesser first.
+ */
+typedef struct ir_narrowphase_contact
+{
+    uint32_t a;
+    uint32_t b;
+    ir_manifold_t manifold;
+    /**
+     * @name cached
+     * @brief Whether the pair was also found last update.
+     */
+    bool cached;
+    /**
+     * @name impulses
+     * @brief The impulses the solver last applied to each point along
+     * the normal and both tangents, carried over to warm-start the next
+     * solve.
+     */
+    float impulses[IR_MANIFOLD_POINTS][3];
+} ir_narrowphase_contact_t;
+
+/**
+ * @name ir_narrowphase_t
+ * @brief A narrowphase.
+ */
+typedef struct ir_narrowphase
+{
+    /**
+     * @name contacts
+     * @brief The last update's contacts, one for each broadphase pair
+     * and in the same order, touching or not.
+     */
+    ir_narrowphase_contact_t *contacts;
+    uint32_t contact_count;
+    uint32_t capacity;
+    /**
+     * @name previous
+     * @brief The update before's contacts, which seed this one's.
+     */
+    ir_narrowphase_contact_t *previous;
+    uint32_t previous_count;
+    uint32_t previous_capacity;
+    /**
+     * @name cached_count
+     * @brief How many of the last update's pairs were warm-started.
+     */
+    _Atomic uint32_t cached_count;
+    const ir_broadphase_t *broadphase;
+    const ir_shape_t *shapes;
+    const ir_transform_t *transforms;
+} ir_narrowphase_t;
+
+/**
+ * @name NarrowphaseCreate
+ * @authors Israfiel
+ * @brief Create an empty narrowphase.
+ *
+ * @param narrowphase - The narrowphase.
+ */
+void Ir_NarrowphaseCreate(ir_narrowphase_t *narrowphase);
+
+/**
+ * @name NarrowphaseDestroy
+ * @authors Israfiel
+ * @brief Free a narrowphase.
+ *
+ * @param narrowphase - The narrowphase.
+ */
+void Ir_NarrowphaseDestroy(ir_narrowphase_t *narrowphase);
+
+/**
+ * @name NarrowphaseUpdate
+ * @authors Israfiel
+ * @brief Find the manifold for every pair the broadphase last found.
+ *
+ * @param narrowphase - The narrowphase.
+ * @param broadphase - The broadphase, already updated.
+ * @param shapes - Each proxy's shape.
+ * @param transforms - Where each proxy is.
+ * @param jobs - The pool to query with, or NULL to query on the calling
+ * thread.
+ * @returns Whether the contacts were found; false if memory ran out.
+ */
+bool Ir_NarrowphaseUpdate(ir_narrowphase_t *narrowphase,
+                          const ir_broadphase_t *broadphase,
+                          const ir_shape_t *shapes,
+                          const ir_transform_t *transforms,
+                          ir_jobs_t *jobs);
+
+#endif // IRIDIUM_PHYSICS_NARROWPHASE_H
@@ -0,0 +1,567 @@
+/**
+ * @file Query.c
+ * @authors Israfiel
+ * @brief Implements Iridium's batched scene queries.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Query.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+#include "Physics/GJK.h"
+#include "Physics/Sort.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * @name STACK_SIZE
+ * @brief The deepest a traversal's stack gets. Each level pushes at
+ * most three more entries than it pops, and a tree over every proxy a
+ * broadphase can hold is sixteen levels deep.
+ */
+#define STACK_SIZE 64
+
+/**
+ * @name ir_query_entry_t
+ * @brief A child waiting to be visited, and how far along the query it
+ * enters and leaves the child's box.
+ */
+typedef struct ir_query_entry
+{
+    uint32_t child;
+    float near;
+    float far;
+} ir_query_entry_t;
+
+/**
+ * @name Spread
+ * @authors Israfiel
+ * @brief Space ten bits out to every third bit.
+ *
+ * @param bits - The bits.
+ * @returns The spread bits.
+ */
+static uint32_t Spread(uint32_t bits)
+{
+    bits &= 0x3ff;
+    bits = (bits | bits << 16) & 0x030000ff;
+    bits = (bits | bits << 8) & 0x0300f00f;
+    bits = (bits | bits << 4) & 0x030c30c3;
+    return (bits | bits << 2) & 0x09249249;
+}
+
+/**
+ * @name Morton
+ * @authors Israfiel
+ * @brief Find a point's Morton code within the proxies' centres.
+ *
+ * @param query - The tree.
+ * @param point - The point.
+ * @param scale - The largest value each axis is quantised to, below
+ * 1024.
+ * @returns The code.
+ */
+static uint32_t Morton(const ir_query_t *query, ir_vec3_t point,
+                       float scale)
+{
+    const float *p = &point.x, *min = &query->min.x, *max = &query->max.x;
+    uint32_t code = 0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        float extent = max[axis] - min[axis];
+        float t = extent > 0.0f ? (p[axis] - min[axis]) / extent : 0.0f;
+        t = fminf(fmaxf(t, 0.0f), 1.0f);
+        code |= Spread((uint32_t)(t * scale)) << axis;
+    }
+    return code;
+}
+
+/**
+ * @name ReserveKeys
+ * @authors Israfiel
+ * @brief Make sure there are sort keys, and scratch, for a number of
+ * proxies or queries. Keys don't outlive a sort, so they're
+ * reallocated rather than grown.
+ *
+ * @param query - The tree.
+ * @param count - The number of keys.
+ * @returns Whether there was memory for them.
+ */
+static bool ReserveKeys(ir_query_t *query, uint32_t count)
+{
+    if (query->key_capacity >= count) return true;
+    uint64_t *keys = malloc(2 * (size_t)count * sizeof(uint64_t));
+    if (keys == NULL) return false;
+    free(query->keys[0]);
+    query->keys[0] = keys;
+    query->keys[1] = keys + count;
+    query->key_capacity = count;
+    return true;
+}
+
+/**
+ * @name Reserve
+ * @authors Israfiel
+ * @brief Make sure there's room for a tree over a number of proxies.
+ *
+ * @param query - The tree.
+ * @param proxies - The number of proxies.
+ * @param nodes - The number of nodes.
+ * @returns Whether there was memory for it.
+ */
+static bool Reserve(ir_query_t *query, uint32_t proxies, uint32_t nodes)
+{
+    if (!ReserveKeys(query, proxies)) return false;
+    if (query->proxy_capacity < proxies)
+    {
+        uint32_t *grown = malloc(proxies * sizeof(uint32_t));
+        if (grown == NULL) return false;
+        free(query->proxies);
+        query->proxies = grown;
+        query->proxy_capacity = proxies;
+    }
+    if (query->node_capacity < nodes)
+    {
+        ir_query_node_t *grown = malloc(nodes * sizeof(ir_query_node_t));
+        if (grown == NULL) return false;
+        free(query->nodes);
+        query->nodes = grown;
+        query->node_capacity = nodes;
+    }
+    return true;
+}
+
+/**
+ * @name BuildNodes
+ * @authors Israfiel
+ * @brief Build a range of one level's nodes, each from the next four
+ * of the level below.
+ *
+ * @param user - The tree.
+ * @param begin - The first node, counted from the level's start.
+ * @param end - One past the last node.
+ */
+static void BuildNodes(void *user, size_t begin, size_t end)
+{
+    ir_query_t *query = user;
+    float *const *bounds = query->broadphase->bounds;
+    for (size_t i = begin; i < end; ++i)
+    {
+        ir_query_node_t *node = &query->nodes[query->level + i];
+        for (uint32_t k = 0; k < IR_SIMD_WIDTH; ++k)
+        {
+            size_t child = i * IR_SIMD_WIDTH + k;
+            if (child >= query->child_count)
+            {
+                // An empty box, lower above upper, which no query enters
+                // and which stretches no parent's bounds.
+                for (int j = 0; j < 3; ++j)
+                {
+                    node->bounds[j][k] = FLT_MAX;
+                    node->bounds[j + 3][k] = -FLT_MAX;
+                }
+                node->children[k] = IR_BROADPHASE_NONE;
+            }
+            else if (query->children == IR_QUERY_LEAF)
+            {
+                uint32_t proxy = query->proxies[child];
+                for (int j = 0; j < 6; ++j)
+                    node->bounds[j][k] = bounds[j][proxy];
+                node->children[k] = proxy | IR_QUERY_LEAF;
+            }
+            else
+            {
+                uint32_t index = query->children + (uint32_t)child;
+                const ir_query_node_t *below = &query->nodes[index];
+                ir_simd_t lower[3], upper[3];
+                for (int j = 0; j < 3; ++j)
+                {
+                    lower[j] = Ir_SimdLoad(below->bounds[j]);
+                    upper[j] = Ir_SimdLoad(below->bounds[j + 3]);
+                }
+                for (int j = 0; j < 3; ++j)
+                {
+                    float low = FLT_MAX, high = -FLT_MAX;
+                    for (int lane = 0; lane < IR_SIMD_WIDTH; ++lane)
+                    {
+                        low = fminf(low, Ir_SimdGet(lower[j], lane));
+                        high = fmaxf(high, Ir_SimdGet(upper[j], lane));
+                    }
+                    node->bounds[j][k] = low;
+                    node->bounds[j + 3][k] = high;
+                }
+                node->children[k] = index;
+            }
+        }
+    }
+}
+
+/**
+ * @name Trace
+ * @authors Israfiel
+ * @brief Move a shape through the tree, nearest boxes first, and find
+ * the first proxy it hits.
+ *
+ * @param query - The tree.
+ * @param shape - The shape; a point for a ray.
+ * @param transform - Where the shape starts.
+ * @param direction - The unit direction it moves in.
+ * @param distance - How far it moves.
+ * @param ignore - A proxy to pass through, or IR_BROADPHASE_NONE.
+ * @returns The hit.
+ */
+static ir_hit_t Trace(const ir_query_t *query, const ir_shape_t *shape,
+                      const ir_transform_t *transform, ir_vec3_t direction,
+                      float distance, uint32_t ignore)
+{
+    ir_hit_t hit = {
+        IR_BROADPHASE_NONE, distance,
+        Ir_Vec3Add(transform->position,
+                   Ir_Vec3Scale(direction, distance)),
+        Ir_Vec3(0.0f, 0.0f, 0.0f)};
+    if (query->node_count == 0) return hit;
+
+    // A shape that doesn't turn sweeps its bounds along with it, so it
+    // can only reach a box that its position's ray reaches once the box
+    // is grown by those bounds: the box's lower bound less the shape's
+    // upper, and its upper less the shape's lower.
+    //
+    // Along each axis the query enters through the side facing it and
+    // leaves through the other, picked once by the direction's sign
+    // rather than by sorting each box's two times, so an empty box,
+    // whose lower bound is above its upper, is always left before it's
+    // entered and never hit.
+    ir_vec3_t min, max;
+    Ir_ShapeBounds(shape, transform, &min, &max);
+    const float *lower_offset = &max.x, *upper_offset = &min.x;
+    const float *d = &direction.x;
+    ir_simd_t entry_offset[3], exit_offset[3], inverse[3];
+    int entry_row[3], exit_row[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        bool backwards = d[axis] < 0.0f;
+        entry_row[axis] = backwards ? axis + 3 : axis;
+        exit_row[axis] = backwards ? axis : axis + 3;
+        entry_offset[axis] = Ir_SimdSplat(
+            backwards ? upper_offset[axis] : lower_offset[axis]);
+        exit_offset[axis] = Ir_SimdSplat(
+            backwards ? lower_offset[axis] : upper_offset[axis]);
+        // A huge inverse rather than an infinite one keeps the slabs
+        // free of zero times infinity.
+        inverse[axis] = Ir_SimdSplat(
+            fabsf(d[axis]) > 1e-30f ? 1.0f / d[axis] : 1e30f);
+    }
+
+    ir_query_entry_t stack[STACK_SIZE];
+    uint32_t size = 0;
+    stack[size++] =
+        (ir_query_entry_t){query->node_count - 1, 0.0f, hit.distance};
+    while (size != 0)
+    {
+        ir_query_entry_t entry = stack[--size];
+        if (entry.near > hit.distance) continue;
+
+        if (entry.child & IR_QUERY_LEAF)
+        {
+            uint32_t proxy = entry.child & ~IR_QUERY_LEAF;
+            if (proxy == ignore) continue;
+
+            // The shape can only be hit inside its box, so the cast
+            // stops where the query leaves it, which keeps it finite
+            // however far the query reaches.
+            float reach = fminf(hit.distance, entry.far);
+            float fraction;
+            ir_contact_t contact;
+            if (!Ir_ShapeCast(shape, transform,
+                              Ir_Vec3Scale(direction, reach),
+                              &query->shapes[proxy],
+                              &query->transforms[proxy], &fraction,
+                              &contact))
+                continue;
+            hit.proxy = proxy;
+            hit.distance = reach * fraction;
+            hit.point = contact.point_b;
+            hit.normal = Ir_Vec3Negate(contact.normal);
+            continue;
+        }
+
+        // The slab test, against all four children at once.
+        const ir_query_node_t *node = &query->nodes[entry.child];
+        ir_simd_t near = Ir_SimdSplat(0.0f);
+        ir_simd_t far = Ir_SimdSplat(hit.distance);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            ir_simd_t enter = Ir_SimdMul(
+                Ir_SimdSub(Ir_SimdLoad(node->bounds[entry_row[axis]]),
+                           entry_offset[axis]),
+                inverse[axis]);
+            ir_simd_t leave = Ir_SimdMul(
+                Ir_SimdSub(Ir_SimdLoad(node->bounds[exit_row[axis]]),
+                           exit_offset[axis]),
+                inverse[axis]);
+            near = Ir_SimdMax(near, enter);
+            far = Ir_SimdMin(far, leave);
+        }
+        uint32_t bits = Ir_SimdMaskBits(Ir_SimdLessEqual(near, far));
+        if (bits == 0) continue;
+
+        // Push the furthest first, so the nearest is visited first and
+        // shortens the query before the others are looked at.
+        float nears[IR_SIMD_WIDTH], fars[IR_SIMD_WIDTH];
+        Ir_SimdStore(nears, near);
+        Ir_SimdStore(fars, far);
+        ir_query_entry_t found[IR_SIMD_WIDTH];
+        uint32_t count = 0;
+        for (; bits != 0; bits &= bits - 1)
+        {
+            uint32_t lane = (uint32_t)__builtin_ctz(bits);
+            // An unused child has the leaf bit set like any other
+            // IR_BROADPHASE_NONE, so it must never be taken for a proxy.
+            if (node->children[lane] == IR_BROADPHASE_NONE) continue;
+            ir_query_entry_t child = {node->children[lane], nears[lane],
+                                      fars[lane]};
+            uint32_t j = count++;
+            for (; j > 0 && found[j - 1].near < child.near; --j)
+                found[j] = found[j - 1];
+            found[j] = child;
+        }
+        for (uint32_t j = 0; j < count; ++j) stack[size++] = found[j];
+    }
+    return hit;
+}
+
+/**
+ * @name TraceRays
+ * @authors Israfiel
+ * @brief Cast a range of the batch's sorted rays.
+ *
+ * @param user - The tree.
+ * @param begin - The first sorted ray.
+ * @param end - One past the last.
+ */
+static void TraceRays(void *user, size_t begin, size_t end)
+{
+    const ir_query_t *query = user;
+    const ir_shape_t point = Ir_ShapeSphere(0.0f);
+    for (size_t i = begin; i < end; ++i)
+    {
+        uint32_t index = (uint32_t)query->order[i];
+        const ir_ray_t *ray = &query->rays[index];
+        ir_transform_t transform = {ray->origin, IR_QUAT_IDENTITY};
+        query->hits[index] = Trace(query, &point, &transform,
+                                   ray->direction, ray->distance,
+                                   ray->ignore);
+    }
+}
+
+/**
+ * @name TraceCasts
+ * @authors Israfiel
+ * @brief Cast a range of the batch's sorted shapes.
+ *
+ * @param user - The tree.
+ * @param begin - The first sorted cast.
+ * @param end - One past the last.
+ */
+static void TraceCasts(void *user, size_t begin, size_t end)
+{
+    const ir_query_t *query = user;
+    for (size_t i = begin; i < end; ++i)
+    {
+        uint32_t index = (uint32_t)query->order[i];
+        const ir_cast_t *cast = &query->casts[index];
+        query->hits[index] = Trace(query, cast->shape, &cast->transform,
+                                   cast->direction, cast->distance,
+                                   cast->ignore);
+    }
+}
+
+/**
+ * @name Key
+ * @authors Israfiel
+ * @brief Make a query's sort key: which octant it points into, then
+ * where it starts, then the query itself.
+ *
+ * @param query - The tree.
+ * @param origin - Where the query starts.
+ * @param direction - Which way it points.
+ * @param index - The query.
+ * @returns The key, whose interesting bits are 32 to 62.
+ */
+static uint64_t Key(const ir_query_t *query, ir_vec3_t origin,
+                    ir_vec3_t direction, uint32_t index)
+{
+    uint32_t octant = (direction.x < 0.0f) | (direction.y < 0.0f) << 1 |
+                      (direction.z < 0.0f) << 2;
+    uint32_t code = octant << 27 | Morton(query, origin, 511.0f);
+    return (uint64_t)code << 32 | index;
+}
+
+/**
+ * @name Run
+ * @authors Israfiel
+ * @brief Sort a batch's keys and cast its queries.
+ *
+ * @param query - The tree, with the batch's keys made.
+ * @param count - The number of queries.
+ * @param range - The function casting a range of sorted queries.
+ * @param jobs - The pool, or NULL.
+ */
+static void Run(ir_query_t *query, uint32_t count, ir_job_range_t range,
+                ir_jobs_t *jobs)
+{
+    query->order = Ir_RadixSort(query->keys, count, 32, 62);
+    if (jobs != NULL)
+        Ir_JobsParallelFor(jobs, count, IR_QUERY_GRAIN, range, query);
+    else range(query, 0, count);
+}
+
+void Ir_QueryCreate(ir_query_t *query)
+{
+    *query = (ir_query_t){0};
+}
+
+void Ir_QueryDestroy(ir_query_t *query)
+{
+    free(query->nodes);
+    free(query->proxies);
+    free(query->keys[0]);
+    *query = (ir_query_t){0};
+}
+
+bool Ir_QueryBuild(ir_query_t *query, const ir_broadphase_t *broadphase,
+                   ir_jobs_t *jobs)
+{
+    query->node_count = 0;
+    query->proxy_count = 0;
+    query->broadphase = broadphase;
+
+    uint32_t count = 0;
+    float *const *bounds = broadphase->bounds;
+    for (uint32_t i = 0; i < broadphase->count; ++i)
+        if (bounds[0][i] <= bounds[3][i]) count++;
+    if (count == 0) return true;
+
+    uint32_t nodes = 0;
+    for (uint32_t level = count; level > 1;)
+    {
+        level = (level + IR_SIMD_WIDTH - 1) / IR_SIMD_WIDTH;
+        nodes += level;
+    }
+    if (nodes == 0) nodes = 1;
+    if (!Reserve(query, count, nodes))
+    {
+        IR_LOG_ERROR("Ran out of memory building the query tree.");
+        return false;
+    }
+
+    IR_PROFILE_BEGIN("Query Build");
+    ir_vec3_t min = Ir_Vec3(FLT_MAX, FLT_MAX, FLT_MAX);
+    ir_vec3_t max = Ir_Vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (uint32_t i = 0; i < broadphase->count; ++i)
+    {
+        if (bounds[0][i] > bounds[3][i]) continue;
+        ir_vec3_t centre = Ir_Vec3(0.5f * (bounds[0][i] + bounds[3][i]),
+                                   0.5f * (bounds[1][i] + bounds[4][i]),
+                                   0.5f * (bounds[2][i] + bounds[5][i]));
+        min = Ir_Vec3Min(min, centre);
+        max = Ir_Vec3Max(max, centre);
+        query->proxies[query->proxy_count++] = i;
+    }
+    query->min = min;
+    query->max = max;
+
+    // Proxies close in Morton order are close in space, so grouping
+    // them four at a time, then their nodes four at a time, makes a
+    // tree whose boxes are mostly tight without any splitting.
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t proxy = query->proxies[i];
+        ir_vec3_t centre = Ir_Vec3(
+            0.5f * (bounds[0][proxy] + bounds[3][proxy]),
+            0.5f * (bounds[1][proxy] + bounds[4][proxy]),
+            0.5f * (bounds[2][proxy] + bounds[5][proxy]));
+        query->keys[0][i] =
+            (uint64_t)Morton(query, centre, 1023.0f) << 32 | proxy;
+    }
+    const uint64_t *sorted = Ir_RadixSort(query->keys, count, 32, 62);
+    for (uint32_t i = 0; i < count; ++i)
+        query->proxies[i] = (uint32_t)sorted[i];
+
+    query->children = IR_QUERY_LEAF;
+    query->child_count = count;
+    query->level = 0;
+    for (;;)
+    {
+        uint32_t level_count =
+            (query->child_count + IR_SIMD_WIDTH - 1) / IR_SIMD_WIDTH;
+        if (jobs != NULL && level_count > IR_QUERY_GRAIN)
+            Ir_JobsParallelFor(jobs, level_count, IR_QUERY_GRAIN,
+                               BuildNodes, query);
+        else BuildNodes(query, 0, level_count);
+        if (level_count == 1) break;
+
+        query->children = query->level;
+        query->child_count = level_count;
+        query->level += level_count;
+    }
+    query->node_count = query->level + 1;
+    IR_PROFILE_END("Query Build");
+    return true;
+}
+
+bool Ir_QueryRays(ir_query_t *query, const ir_ray_t *rays,
+                  uint32_t count, const ir_shape_t *shapes,
+                  const ir_transform_t *transforms, ir_hit_t *hits,
+                  ir_jobs_t *jobs)
+{
+    if (count == 0) return true;
+    if (!ReserveKeys(query, count))
+    {
+        IR_LOG_ERROR("Ran out of memory sorting rays.");
+        return false;
+    }
+
+    IR_PROFILE_BEGIN("Query Rays");
+    for (uint32_t i = 0; i < count; ++i)
+        query->keys[0][i] = Key(query, rays[i].origin, rays[i].direction,
+                                i);
+    query->rays = rays;
+    query->shapes = shapes;
+    query->transforms = transforms;
+    query->hits = hits;
+    Run(query, count, TraceRays, jobs);
+    IR_PROFILE_END("Query Rays");
+    return true;
+}
+
+bool Ir_QueryCasts(ir_query_t *query, const ir_cast_t *casts,
+                   uint32_t count, const ir_shape_t *shapes,
+                   const ir_transform_t *transforms, ir_hit_t *hits,
+                   ir_jobs_t *jobs)
+{
+    if (count == 0) return true;
+    if (!ReserveKeys(query, count))
+    {
+        IR_LOG_ERROR("Ran out of memory sorting casts.");
+        return false;
+    }
+
+    IR_PROFILE_BEGIN("Query Casts");
+    for (uint32_t i = 0; i < count; ++i)
+        query->keys[0][i] = Key(query, casts[i].transform.position,
+                                casts[i].direction, i);
+    query->casts = casts;
+    query->shapes = shapes;
+    query->transforms = transforms;
+    query->hits = hits;
+    Run(query, count, TraceCasts, jobs);
+    IR_PROFILE_END("Query Casts");
+    return true;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file Query.h
+ * @authors Israfiel
+ * @brief Iridium's batched scene queries: rays and shape casts, run by
+ * the thousand. The broadphase's proxies are gathered into a tree four
+ * children wide, built bottom up from the proxies in Morton order, so
+ * each step down tests a query against four boxes at once. Each batch
+ * is sorted by where its queries start and which way they point before
+ * being handed out to jobs, so neighbouring queries walk the same nodes
+ * while they're still in cache.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PHYSICS_QUERY_H
+#define IRIDIUM_PHYSICS_QUERY_H
+
+#include "Core/Jobs.h"
+#include "Math/Quaternion.h"
+#include "Math/SIMD.h"
+#include "Physics/Broadphase.h"
+#include "Physics/Shape.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_QUERY_LEAF
+ * @brief Marks a node's child as a proxy rather than another node.
+ */
+#define IR_QUERY_LEAF 0x80000000u
+
+/**
+ * @name IR_QUERY_GRAIN
+ * @brief The number of sorted queries each job runs.
+ */
+#define IR_QUERY_GRAIN 64
+
+/**
+ * @name ir_ray_t
+ * @brief A ray to cast.
+ */
+typedef struct ir_ray
+{
+    ir_vec3_t origin;
+    /**
+     * @name direction
+     * @brief The unit direction.
+     */
+    ir_vec3_t direction;
+    /**
+     * @name distance
+     * @brief How far the ray reaches, in metres.
+     */
+    float distance;
+    /**
+     * @name ignore
+     * @brief A proxy the ray passes through, such as the body casting
+     * it, or IR_BROADPHASE_NONE.
+     */
+    uint32_t ignore;
+} ir_ray_t;
+
+/**
+ * @name ir_cast_t
+ * @brief A shape to move in a straight line, without turning.
+ */
+typedef struct ir_cast
+{
+    /**
+     * @name shape
+     * @brief The shape, which the cast doesn't own.
+     */
+    const ir_shape_t *shape;
+    ir_transform_t transform;
+    ir_vec3_t direction;
+    float distance;
+    uint32_t ignore;
+} ir_cast_t;
+
+/**
+ * @name ir_hit_t
+ * @brief What a ray or cast hit first.
+ */
+typedef struct ir_hit
+{
+    /**
+     * @name proxy
+     * @brief The proxy hit, or IR_BROADPHASE_NONE for a miss.
+     */
+    uint32_t proxy;
+    /**
+     * @name distance
+     * @brief How far the query got; its whole distance on a miss.
+     */
+    float distance;
+    /**
+     * @name point
+     * @brief Where on the proxy's surface it was hit.
+     */
+    ir_vec3_t point;
+    /**
+     * @name normal
+     * @brief The surface's unit normal there, facing back along the
+     * query.
+     */
+    ir_vec3_t normal;
+} ir_hit_t;
+
+/**
+ * @name ir_query_node_t
+ * @brief A node of the tree: its four children's bounds, SoA, the lower
+ * x, y, and z then the upper, and what they are. Unused children are
+ * a point out at FLT_MAX, which no query reaches.
+ */
+typedef struct ir_query_node
+{
+    float bounds[6][IR_SIMD_WIDTH];
+    uint32_t children[IR_SIMD_WIDTH];
+} ir_query_node_t;
+
+/**
+ * @name ir_query_t
+ * @brief A tree over a broadphase's proxies, and the batch being run
+ * against it.
+ */
+typedef struct ir_query
+{
+    /**
+     * @name nodes
+     * @brief The nodes, level by level from the leaves up; the root is
+     * the last.
+     */
+    ir_query_node_t *nodes;
+    uint32_t node_count;
+    uint32_t node_capacity;
+    /**
+     * @name min
+     * @brief The lower bounds of the proxies' centres, which Morton
+     * codes are taken relative to.
+     */
+    ir_vec3_t min;
+    ir_vec3_t max;
+    /**
+     * @name proxies
+     * @brief The live proxies, in Morton order once built.
+     */
+    uint32_t *proxies;
+    uint32_t proxy_count;
+    uint32_t proxy_capacity;
+    uint64_t *keys[2];
+    uint32_t key_capacity;
+    /**
+     * @name level
+     * @brief The first node of the level being built.
+     */
+    uint32_t level;
+    /**
+     * @name children
+     * @brief The first node of the level below, or IR_QUERY_LEAF when
+     * the level's children are proxies.
+     */
+    uint32_t children;
+    uint32_t child_count;
+    const ir_broadphase_t *broadphase;
+    /**
+     * @name order
+     * @brief The batch's queries, sorted for coherence.
+     */
+    const uint64_t *order;
+    const ir_ray_t *rays;
+    const ir_cast_t *casts;
+    const ir_shape_t *shapes;
+    const ir_transform_t *transforms;
+    ir_hit_t *hits;
+} ir_query_t;
+
+/**
+ * @name QueryCreate
+ * @authors Israfiel
+ * @brief Create an empty query tree.
+ *
+ * @param query - The tree.
+ */
+void Ir_QueryCreate(ir_query_t *query);
+
+/**
+ * @name QueryDestroy
+ * @authors Israfiel
+ * @brief Free a query tree.
+ *
+ * @param query - The tree.
+ */
+void Ir_QueryDestroy(ir_query_t *query);
+
+/**
+ * @name QueryBuild
+ * @authors Israfiel
+ * @brief Rebuild the tree over the broadphase's proxies as they are
+ * now. Call it once a frame, after the bodies have moved and before
+ * any batch.
+ *
+ * @param query - The tree.
+ * @param broadphase - The broadphase.
+ * @param jobs - The pool to build with, or NULL to build on the
+ * calling thread.
+ * @returns Whether it was built; false if memory ran out.
+ */
+bool Ir_QueryBuild(ir_query_t *query, const ir_broadphase_t *broadphase,
+                   ir_jobs_t *jobs);
+
+/**
+ * @name QueryRays
+ * @authors Israfiel
+ * @brief Cast a batch of rays against the proxies' shapes. A tree runs
+ * one batch at a time.
+ *
+ * @param query - The tree.
+ * @param rays - The rays.
+ * @param count - The number of rays.
+ * @param shapes - Each proxy's shape.
+ * @param transforms - Where each proxy's shape is.
+ * @param hits - Filled with each ray's hit, in the rays' order.
+ * @param jobs - The pool to cast with, or NULL to cast on the calling
+ * thread.
+ * @returns Whether the rays were cast; false if memory ran out.
+ */
+bool Ir_QueryRays(ir_query_t *query, const ir_ray_t *rays,
+                  uint32_t count, const ir_shape_t *shapes,
+                  const ir_transform_t *transforms, ir_hit_t *hits,
+                  ir_jobs_t *jobs);
+
+/**
+ * @name QueryCasts
+ * @authors Israfiel
+ * @brief Cast a batch of shapes against the proxies' shapes. A tree
+ * runs one batch at a time.
+ *
+ * @param query - The tree.
+ * @param casts - The casts.
+ * @param count - The number of casts.
+ * @param shapes - Each proxy's shape.
+ * @param transforms - Where each proxy's shape is.
+ * @param hits - Filled with each cast's hit, in the casts' order.
+ * @param jobs - The pool to cast with, or NULL to cast on the calling
+ * thread.
+ * @returns Whether the shapes were cast; false if memory ran out.
+ */
+bool Ir_QueryCasts(ir_query_t *query, const ir_cast_t *casts,
+                   uint32_t count, const ir_shape_t *shapes,
+                   const ir_transform_t *transforms, ir_hit_t *hits,
+                   ir_jobs_t *jobs);
+
+#endif // IRIDIUM_PHYSICS_QUERY_H
@@ -0,0 +1,251 @@
+/**
+ * @file Shape.c
+ * @authors Israfiel
+ * @brief Implements Iridium's collision shapes.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Shape.h"
+
+#include "Math/SIMD.h"
+
+#include <float.h>
+#include <stdlib.h>
+
+/**
+ * @name FEATURE_TOLERANCE
+ * @brief How far a vertex may fall short of the furthest one and still
+ * be part of the feature facing a direction, as a fraction of the
+ * shape's depth along it. About three degrees for a cube.
+ */
+#define FEATURE_TOLERANCE 0.05f
+
+/**
+ * @name HullSupport
+ * @authors Israfiel
+ * @brief Find a hull's furthest vertex, four vertices at a time.
+ *
+ * @param hull - The hull.
+ * @param direction - The direction.
+ * @returns The vertex.
+ */
+static ir_vec3_t HullSupport(const ir_hull_t *hull, ir_vec3_t direction)
+{
+    static const float lanes[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    ir_simd_t dx = Ir_SimdSplat(direction.x);
+    ir_simd_t dy = Ir_SimdSplat(direction.y);
+    ir_simd_t dz = Ir_SimdSplat(direction.z);
+    ir_simd_t index = Ir_SimdLoad(lanes);
+    ir_simd_t step = Ir_SimdSplat(IR_SIMD_WIDTH);
+    ir_simd_t best = Ir_SimdSplat(-FLT_MAX);
+    ir_simd_t best_index = index;
+
+    // Indices are tracked as floats so one select moves them with the
+    // best dot products; they're exact up to 2^24 vertices.
+    for (uint32_t i = 0; i < hull->count; i += IR_SIMD_WIDTH)
+    {
+        ir_simd_t dot = Ir_SimdMul(Ir_SimdLoad(hull->x + i), dx);
+        dot = Ir_SimdMulAdd(Ir_SimdLoad(hull->y + i), dy, dot);
+        dot = Ir_SimdMulAdd(Ir_SimdLoad(hull->z + i), dz, dot);
+        ir_simd_mask_t better = Ir_SimdLess(best, dot);
+        best = Ir_SimdSelect(better, dot, best);
+        best_index = Ir_SimdSelect(better, index, best_index);
+        index = Ir_SimdAdd(index, step);
+    }
+
+    float dots[4], indices[4];
+    Ir_SimdStore(dots, best);
+    Ir_SimdStore(indices, best_index);
+    int lane = 0;
+    for (int i = 1; i < 4; ++i)
+        if (dots[i] > dots[lane]) lane = i;
+    uint32_t vertex = (uint32_t)indices[lane];
+    return Ir_Vec3(hull->x[vertex], hull->y[vertex], hull->z[vertex]);
+}
+
+ir_shape_t Ir_ShapeSphere(float radius)
+{
+    return (ir_shape_t){.type = IR_SHAPE_SPHERE, .radius = radius};
+}
+
+ir_shape_t Ir_ShapeCapsule(float half_height, float radius)
+{
+    return (ir_shape_t){
+        .type = IR_SHAPE_CAPSULE,
+        .radius = radius,
+        .half_height = half_height,
+    };
+}
+
+ir_shape_t Ir_ShapeBox(ir_vec3_t half_extents, float radius)
+{
+    float smallest = fminf(half_extents.x,
+                           fminf(half_extents.y, half_extents.z));
+    if (radius > smallest) radius = smallest;
+    return (ir_shape_t){
+        .type = IR_SHAPE_BOX,
+        .radius = radius,
+        .half_extents = Ir_Vec3Sub(half_extents,
+                                   Ir_Vec3(radius, radius, radius)),
+    };
+}
+
+ir_shape_t Ir_ShapeHull(const ir_hull_t *hull, float radius)
+{
+    return (ir_shape_t){
+        .type = IR_SHAPE_HULL,
+        .radius = radius,
+        .hull = hull,
+    };
+}
+
+bool Ir_HullCreate(ir_hull_t *hull, const ir_vec3_t *points,
+                   uint32_t count)
+{
+    uint32_t padded = (count + IR_SIMD_WIDTH - 1) & ~(IR_SIMD_WIDTH - 1);
+    float *block = malloc(3 * padded * sizeof(float));
+    if (block == NULL) return false;
+
+    hull->x = block;
+    hull->y = block + padded;
+    hull->z = block + 2 * padded;
+    hull->count = count;
+    for (uint32_t i = 0; i < padded; ++i)
+    {
+        ir_vec3_t point = points[i < count ? i : 0];
+        hull->x[i] = point.x;
+        hull->y[i] = point.y;
+        hull->z[i] = point.z;
+    }
+    return true;
+}
+
+void Ir_HullDestroy(ir_hull_t *hull)
+{
+    free(hull->x);
+    *hull = (ir_hull_t){0};
+}
+
+ir_vec3_t Ir_ShapeSupport(const ir_shape_t *shape, ir_vec3_t direction)
+{
+    switch (shape->type)
+    {
+        case IR_SHAPE_SPHERE: return Ir_Vec3(0.0f, 0.0f, 0.0f);
+        case IR_SHAPE_CAPSULE:
+            return Ir_Vec3(0.0f,
+                           direction.y >= 0.0f ? shape->half_height
+                                               : -shape->half_height,
+                           0.0f);
+        case IR_SHAPE_BOX:
+        {
+            ir_vec3_t extents = shape->half_extents;
+            return Ir_Vec3(direction.x >= 0.0f ? extents.x : -extents.x,
+                           direction.y >= 0.0f ? extents.y : -extents.y,
+                           direction.z >= 0.0f ? extents.z : -extents.z);
+        }
+        case IR_SHAPE_HULL: return HullSupport(shape->hull, direction);
+    }
+    return Ir_Vec3(0.0f, 0.0f, 0.0f);
+}
+
+uint32_t Ir_ShapeFeature(const ir_shape_t *shape, ir_vec3_t direction,
+                         ir_vec3_t points[IR_SHAPE_FEATURE])
+{
+    float length = Ir_Vec3Length(direction);
+    float tolerance = FEATURE_TOLERANCE * length;
+    switch (shape->type)
+    {
+        case IR_SHAPE_SPHERE: break;
+        case IR_SHAPE_CAPSULE:
+            if (fabsf(direction.y) > tolerance) break;
+            points[0] = Ir_Vec3(0.0f, -shape->half_height, 0.0f);
+            points[1] = Ir_Vec3(0.0f, shape->half_height, 0.0f);
+            return 2;
+        case IR_SHAPE_BOX:
+        {
+            // A box always offers its face most square to the direction,
+            // even to an edge or corner: a face clips into a manifold
+            // however it's tilted, where a long edge picked for a small
+            // tilt can lie far from the contact. The corners are listed
+            // in order around it.
+            int axis = 0;
+            for (int i = 1; i < 3; ++i)
+                if (fabsf(Ir_Vec3Component(direction, i)) >
+                    fabsf(Ir_Vec3Component(direction, axis)))
+                    axis = i;
+            int u = (axis + 1) % 3, v = (axis + 2) % 3;
+            ir_vec3_t extents = shape->half_extents;
+            float side = Ir_Vec3Component(direction, axis) >= 0.0f
+                             ? Ir_Vec3Component(extents, axis)
+                             : -Ir_Vec3Component(extents, axis);
+
+            static const float signs[4][2] = {
+                {-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                float values[3];
+                values[axis] = side;
+                values[u] = signs[i][0] * Ir_Vec3Component(extents, u);
+                values[v] = signs[i][1] * Ir_Vec3Component(extents, v);
+                points[i] = Ir_Vec3(values[0], values[1], values[2]);
+            }
+            return 4;
+        }
+        case IR_SHAPE_HULL:
+        {
+            const ir_hull_t *hull = shape->hull;
+            float highest = -FLT_MAX, lowest = FLT_MAX;
+            for (uint32_t i = 0; i < hull->count; ++i)
+            {
+                float dot = hull->x[i] * direction.x +
+                            hull->y[i] * direction.y +
+                            hull->z[i] * direction.z;
+                highest = fmaxf(highest, dot);
+                lowest = fminf(lowest, dot);
+            }
+
+            float threshold =
+                highest - FEATURE_TOLERANCE * (highest - lowest);
+            uint32_t count = 0;
+            for (uint32_t i = 0;
+                 i < hull->count && count < IR_SHAPE_FEATURE; ++i)
+            {
+                float dot = hull->x[i] * direction.x +
+                            hull->y[i] * direction.y +
+                            hull->z[i] * direction.z;
+                if (dot >= threshold)
+                    points[count++] =
+                        Ir_Vec3(hull->x[i], hull->y[i], hull->z[i]);
+            }
+            return count;
+        }
+    }
+    points[0] = Ir_ShapeSupport(shape, direction);
+    return 1;
+}
+
+void Ir_ShapeBounds(const ir_shape_t *shape,
+                    const ir_transform_t *transform, ir_vec3_t *min,
+                    ir_vec3_t *max)
+{
+    // The support along each world axis is exactly the bounds, which
+    // holds for every shape without special cases.
+    static const ir_vec3_t axes[3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    ir_quat_t inverse = Ir_QuatConjugate(transform->rotation);
+    float lower[3] = {0}, upper[3] = {0};
+    for (int i = 0; i < 3; ++i)
+    {
+        ir_vec3_t axis = Ir_QuatRotate(inverse, axes[i]);
+        ir_vec3_t high = Ir_TransformPoint(
+            transform, Ir_ShapeSupport(shape, axis));
+        ir_vec3_t low = Ir_TransformPoint(
+            transform, Ir_ShapeSupport(shape, Ir_Vec3Negate(axis)));
+        upper[i] = Ir_Vec3Component(high, i) + shape->radius;
+        lower[i] = Ir_Vec3Component(low, i) - shape->radius;
+    }
+    *min = Ir_Vec3(lower[0], lower[1], lower[2]);
+    *max = Ir_Vec3(upper[0], upper[1], upper[2]);
+}
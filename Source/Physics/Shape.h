@@ -0,0 +1,193 @@
+/**
+ * @file Shape.h
+ * @authors Israfiel
+ * @brief Iridium's collision shapes. Every shape is a convex core
+ * swept by a sphere: a point for spheres, a segment for capsules, and a
+ * box or hull shrunk by a rounding radius. Collision works on the cores,
+ * where GJK is fast and exact, and adds the radii back afterwards.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PHYSICS_SHAPE_H
+#define IRIDIUM_PHYSICS_SHAPE_H
+
+#include "Math/Quaternion.h"
+#include "Math/Vector.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_SHAPE_FEATURE
+ * @brief The most vertices a shape's feature has.
+ */
+#define IR_SHAPE_FEATURE 8
+
+/**
+ * @name ir_shape_type_t
+ * @brief The kinds of shape.
+ */
+typedef enum ir_shape_type
+{
+    IR_SHAPE_SPHERE,
+    IR_SHAPE_CAPSULE,
+    IR_SHAPE_BOX,
+    IR_SHAPE_HULL,
+} ir_shape_type_t;
+
+/**
+ * @name ir_hull_t
+ * @brief A convex hull's vertices, SoA and padded to a whole number of
+ * SIMD vectors by repeating the first.
+ */
+typedef struct ir_hull
+{
+    float *x;
+    float *y;
+    float *z;
+    uint32_t count;
+} ir_hull_t;
+
+/**
+ * @name ir_shape_t
+ * @brief A shape, in its body's local space.
+ */
+typedef struct ir_shape
+{
+    ir_shape_type_t type;
+    /**
+     * @name radius
+     * @brief The sphere swept over the core.
+     */
+    float radius;
+    union
+    {
+        /**
+         * @name half_height
+         * @brief A capsule's core, a segment along y.
+         */
+        float half_height;
+        /**
+         * @name half_extents
+         * @brief A box's core.
+         */
+        ir_vec3_t half_extents;
+        /**
+         * @name hull
+         * @brief A hull's core, which the shape doesn't own.
+         */
+        const ir_hull_t *hull;
+    };
+} ir_shape_t;
+
+/**
+ * @name ShapeSphere
+ * @authors Israfiel
+ * @brief Make a sphere.
+ *
+ * @param radius - The sphere's radius.
+ * @returns The shape.
+ */
+ir_shape_t Ir_ShapeSphere(float radius);
+
+/**
+ * @name ShapeCapsule
+ * @authors Israfiel
+ * @brief Make a capsule along y.
+ *
+ * @param half_height - Half the length of the capsule's segment.
+ * @param radius - The capsule's radius.
+ * @returns The shape.
+ */
+ir_shape_t Ir_ShapeCapsule(float half_height, float radius);
+
+/**
+ * @name ShapeBox
+ * @authors Israfiel
+ * @brief Make a box with slightly rounded edges.
+ *
+ * @param half_extents - Half the box's size.
+ * @param radius - The rounding, taken out of the box's size rather than
+ * added to it.
+ * @returns The shape.
+ */
+ir_shape_t Ir_ShapeBox(ir_vec3_t half_extents, float radius);
+
+/**
+ * @name ShapeHull
+ * @authors Israfiel
+ * @brief Make a convex hull with slightly rounded edges.
+ *
+ * @param hull - The hull, which must outlive the shape.
+ * @param radius - The rounding, added to the hull's size.
+ * @returns The shape.
+ */
+ir_shape_t Ir_ShapeHull(const ir_hull_t *hull, float radius);
+
+/**
+ * @name HullCreate
+ * @authors Israfiel
+ * @brief Copy a point cloud into a hull. Points inside the hull are
+ * kept; they cost a little time but never change the result.
+ *
+ * @param hull - The hull.
+ * @param points - The points.
+ * @param count - The number of points, at least one.
+ * @returns Whether there was memory for the hull.
+ */
+bool Ir_HullCreate(ir_hull_t *hull, const ir_vec3_t *points,
+                   uint32_t count);
+
+/**
+ * @name HullDestroy
+ * @authors Israfiel
+ * @brief Free a hull.
+ *
+ * @param hull - The hull.
+ */
+void Ir_HullDestroy(ir_hull_t *hull);
+
+/**
+ * @name ShapeSupport
+ * @authors Israfiel
+ * @brief Find the point of a shape's core furthest along a direction.
+ *
+ * @param shape - The shape.
+ * @param direction - The direction, in the shape's space.
+ * @returns The point, in the shape's space.
+ */
+ir_vec3_t Ir_ShapeSupport(const ir_shape_t *shape, ir_vec3_t direction);
+
+/**
+ * @name ShapeFeature
+ * @authors Israfiel
+ * @brief Find the face, edge, or vertex of a shape's core that faces a
+ * direction: a box's face most square to it, or otherwise every vertex
+ * within a few degrees of the furthest one.
+ *
+ * @param shape - The shape.
+ * @param direction - The direction, in the shape's space.
+ * @param points - Filled with the vertices, in the shape's space.
+ * @returns The number of vertices.
+ */
+uint32_t Ir_ShapeFeature(const ir_shape_t *shape, ir_vec3_t direction,
+                         ir_vec3_t points[IR_SHAPE_FEATURE]);
+
+/**
+ * @name ShapeBounds
+ * @authors Israfiel
+ * @brief Get a placed shape's world bounding box.
+ *
+ * @param shape - The shape.
+ * @param transform - Where the shape is.
+ * @param min - Filled with the lower bounds.
+ * @param max - Filled with the upper bounds.
+ */
+void Ir_ShapeBounds(const ir_shape_t *shape,
+                    const ir_transform_t *transform, ir_vec3_t *min,
+                    ir_vec3_t *max);
+
+#endif // IRIDIUM_PHYSICS_SHAPE_H
@@ -0,0 +1,1335 @@
+/**
+ * @file Solver.c
+ * @authors Israfiel
+ * @brief Implements Iridium's rigid body solver.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Solver.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+#include "Physics/Sweep.h"
+
+#include <float.h>
+#include <stdlib.h>
+
+/**
+ * @name NO_ISLAND
+ * @brief The island of a static body, which joins none.
+ */
+#define NO_ISLAND UINT32_MAX
+
+/**
+ * @name ir_solver_group_t
+ * @brief A run of batches solved one after another: a colour, solved
+ * a batch at a time, or the leftovers, solved a contact at a time.
+ */
+typedef struct ir_solver_group
+{
+    uint32_t begin;
+    uint32_t count;
+    bool wide;
+} ir_solver_group_t;
+
+/**
+ * @name ir_solver_range_t
+ * @brief A colour being split across the pool.
+ */
+typedef struct ir_solver_range
+{
+    ir_solver_t *solver;
+    ir_solver_batch_t *batches;
+    bool relax;
+} ir_solver_range_t;
+
+/**
+ * @name Find
+ * @authors Israfiel
+ * @brief Find a body's island's root, halving the path as it goes.
+ * Roots are always their island's lowest-numbered body.
+ *
+ * @param parents - Each body's parent.
+ * @param body - The body.
+ * @returns The root.
+ */
+static uint32_t Find(uint32_t *parents, uint32_t body)
+{
+    while (parents[body] != body)
+    {
+        parents[body] = parents[parents[body]];
+        body = parents[body];
+    }
+    return body;
+}
+
+/**
+ * @name Turn
+ * @authors Israfiel
+ * @brief Multiply a vector by a body's world inverse inertia.
+ *
+ * @param solver - The solver.
+ * @param body - The body.
+ * @param v - The vector.
+ * @returns The product.
+ */
+static ir_vec3_t Turn(const ir_solver_t *solver, uint32_t body,
+                      ir_vec3_t v)
+{
+    float *const *m = solver->inertia;
+    return Ir_Vec3(m[0][body] * v.x + m[3][body] * v.y + m[4][body] * v.z,
+                   m[3][body] * v.x + m[1][body] * v.y + m[5][body] * v.z,
+                   m[4][body] * v.x + m[5][body] * v.y + m[2][body] * v.z);
+}
+
+/**
+ * @name Load
+ * @authors Israfiel
+ * @brief Copy a dynamic body into the solver's arrays, with gravity
+ * applied and its inverse inertia turned into world space.
+ *
+ * @param solver - The solver.
+ * @param index - The body.
+ */
+static void Load(ir_solver_t *solver, uint32_t index)
+{
+    ir_body_t *body = &solver->bodies[index];
+    body->asleep = false;
+    body->linear_velocity =
+        Ir_Vec3Add(body->linear_velocity,
+                   Ir_Vec3Scale(solver->gravity, solver->step));
+
+    float values[6] = {
+        body->linear_velocity.x,  body->linear_velocity.y,
+        body->linear_velocity.z,  body->angular_velocity.x,
+        body->angular_velocity.y, body->angular_velocity.z,
+    };
+    for (int i = 0; i < 6; ++i) solver->velocities[i][index] = values[i];
+
+    // R diag(I) R^T, summed a rotated axis at a time.
+    static const ir_vec3_t axes[3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    float m[6] = {0};
+    for (int i = 0; i < 3; ++i)
+    {
+        ir_vec3_t c = Ir_QuatRotate(body->transform.rotation, axes[i]);
+        float k = Ir_Vec3Component(body->inverse_inertia, i);
+        m[0] += k * c.x * c.x;
+        m[1] += k * c.y * c.y;
+        m[2] += k * c.z * c.z;
+        m[3] += k * c.x * c.y;
+        m[4] += k * c.x * c.z;
+        m[5] += k * c.y * c.z;
+    }
+    for (int i = 0; i < 6; ++i) solver->inertia[i][index] = m[i];
+}
+
+/**
+ * @name Pad
+ * @authors Israfiel
+ * @brief Fill a batch lane with a contact that does nothing.
+ *
+ * @param solver - The solver.
+ * @param batch - The batch.
+ * @param lane - The lane.
+ */
+static void Pad(const ir_solver_t *solver, ir_solver_batch_t *batch,
+                int lane)
+{
+    batch->a[lane] = batch->b[lane] = solver->body_count;
+    batch->contact[lane] = UINT32_MAX;
+    batch->mass_a[lane] = batch->mass_b[lane] = 0.0f;
+    batch->friction[lane] = batch->bias[lane] = batch->relax[lane] = 0.0f;
+    for (int r = 0; r < 3; ++r)
+    {
+        ir_solver_row_t *row = &batch->rows[r];
+        for (int i = 0; i < 3; ++i)
+            row->direction[i][lane] = row->arm_a[i][lane] =
+                row->arm_b[i][lane] = row->turn_a[i][lane] =
+                    row->turn_b[i][lane] = 0.0f;
+        row->mass[lane] = row->impulse[lane] = 0.0f;
+    }
+}
+
+/**
+ * @name Prepare
+ * @authors Israfiel
+ * @brief Fill a batch lane with a manifold point's rows.
+ *
+ * @param solver - The solver.
+ * @param batch - The batch.
+ * @param lane - The lane.
+ * @param index - The point: its pair times IR_MANIFOLD_POINTS, plus
+ * its place in the pair's manifold.
+ */
+static void Prepare(const ir_solver_t *solver, ir_solver_batch_t *batch,
+                    int lane, uint32_t index)
+{
+    const ir_narrowphase_contact_t *contact =
+        &solver->narrowphase->contacts[index / IR_MANIFOLD_POINTS];
+    uint32_t slot = index % IR_MANIFOLD_POINTS;
+    const ir_manifold_point_t *point = &contact->manifold.points[slot];
+    const ir_body_t *body_a = &solver->bodies[contact->a];
+    const ir_body_t *body_b = &solver->bodies[contact->b];
+    bool dynamic_a = body_a->inverse_mass > 0.0f;
+    bool dynamic_b = body_b->inverse_mass > 0.0f;
+    uint32_t a = dynamic_a ? contact->a : solver->body_count;
+    uint32_t b = dynamic_b ? contact->b : solver->body_count;
+
+    batch->a[lane] = a;
+    batch->b[lane] = b;
+    batch->contact[lane] = index;
+    batch->mass_a[lane] = body_a->inverse_mass;
+    batch->mass_b[lane] = body_b->inverse_mass;
+    batch->friction[lane] = sqrtf(body_a->friction * body_b->friction);
+
+    float separation = point->separation;
+    batch->relax[lane] = -fmaxf(separation, 0.0f) / solver->step;
+    batch->bias[lane] =
+        separation > 0.0f
+            ? batch->relax[lane]
+            : solver->baumgarte / solver->step *
+                  fmaxf(-separation - solver->slop, 0.0f);
+
+    ir_vec3_t middle = Ir_Vec3Scale(
+        Ir_Vec3Add(point->point_a, point->point_b), 0.5f);
+    ir_vec3_t ra = Ir_Vec3Sub(middle, body_a->transform.position);
+    ir_vec3_t rb = Ir_Vec3Sub(middle, body_b->transform.position);
+    ir_vec3_t directions[3] = {contact->manifold.normal};
+    Ir_Vec3Tangents(directions[0], &directions[1], &directions[2]);
+
+    for (int r = 0; r < 3; ++r)
+    {
+        ir_solver_row_t *row = &batch->rows[r];
+        ir_vec3_t d = directions[r];
+        ir_vec3_t arm_a = Ir_Vec3Cross(ra, d), arm_b = Ir_Vec3Cross(rb, d);
+        ir_vec3_t turn_a = dynamic_a ? Turn(solver, a, arm_a)
+                                     : Ir_Vec3(0.0f, 0.0f, 0.0f);
+        ir_vec3_t turn_b = dynamic_b ? Turn(solver, b, arm_b)
+                                     : Ir_Vec3(0.0f, 0.0f, 0.0f);
+        for (int i = 0; i < 3; ++i)
+        {
+            row->direction[i][lane] = Ir_Vec3Component(d, i);
+            row->arm_a[i][lane] = Ir_Vec3Component(arm_a, i);
+            row->arm_b[i][lane] = Ir_Vec3Component(arm_b, i);
+            row->turn_a[i][lane] = Ir_Vec3Component(turn_a, i);
+            row->turn_b[i][lane] = Ir_Vec3Component(turn_b, i);
+        }
+        float k = body_a->inverse_mass + body_b->inverse_mass +
+                  Ir_Vec3Dot(arm_a, turn_a) + Ir_Vec3Dot(arm_b, turn_b);
+        row->mass[lane] = k > 0.0f ? 1.0f / k : 0.0f;
+        row->impulse[lane] = contact->impulses[slot][r];
+    }
+}
+
+/**
+ * @name Apply
+ * @authors Israfiel
+ * @brief Apply an impulse along one of a lane's rows to its bodies'
+ * loaded velocities.
+ *
+ * @param batch - The batch.
+ * @param lane - The lane.
+ * @param r - The row.
+ * @param impulse - The impulse.
+ * @param va - Body a's velocity, linear then angular.
+ * @param vb - Body b's velocity, linear then angular.
+ */
+static void Apply(const ir_solver_batch_t *batch, int lane, int r,
+                  float impulse, float va[6], float vb[6])
+{
+    const ir_solver_row_t *row = &batch->rows[r];
+    float ia = batch->mass_a[lane] * impulse;
+    float ib = batch->mass_b[lane] * impulse;
+    for (int i = 0; i < 3; ++i)
+    {
+        va[i] -= ia * row->direction[i][lane];
+        vb[i] += ib * row->direction[i][lane];
+        va[i + 3] -= impulse * row->turn_a[i][lane];
+        vb[i + 3] += impulse * row->turn_b[i][lane];
+    }
+}
+
+/**
+ * @name Speed
+ * @authors Israfiel
+ * @brief Find how fast a lane's bodies separate along one of its rows.
+ *
+ * @param batch - The batch.
+ * @param lane - The lane.
+ * @param r - The row.
+ * @param va - Body a's velocity, linear then angular.
+ * @param vb - Body b's velocity, linear then angular.
+ * @returns The speed.
+ */
+static float Speed(const ir_solver_batch_t *batch, int lane, int r,
+                   const float va[6], const float vb[6])
+{
+    const ir_solver_row_t *row = &batch->rows[r];
+    float speed = 0.0f;
+    for (int i = 0; i < 3; ++i)
+        speed += row->direction[i][lane] * (vb[i] - va[i]) +
+                 row->arm_b[i][lane] * vb[i + 3] -
+                 row->arm_a[i][lane] * va[i + 3];
+    return speed;
+}
+
+/**
+ * @name WarmLane
+ * @authors Israfiel
+ * @brief Reapply one contact's impulses from the step before.
+ *
+ * @param solver - The solver.
+ * @param batch - The batch.
+ * @param lane - The lane.
+ */
+static void WarmLane(ir_solver_t *solver, const ir_solver_batch_t *batch,
+                     int lane)
+{
+    uint32_t a = batch->a[lane], b = batch->b[lane];
+    float va[6], vb[6];
+    for (int i = 0; i < 6; ++i)
+    {
+        va[i] = solver->velocities[i][a];
+        vb[i] = solver->velocities[i][b];
+    }
+    for (int r = 0; r < 3; ++r)
+        Apply(batch, lane, r, batch->rows[r].impulse[lane], va, vb);
+
+    // Static bodies all share the sentinel, which never moves.
+    for (int i = 0; i < 6; ++i)
+    {
+        if (a != solver->body_count) solver->velocities[i][a] = va[i];
+        if (b != solver->body_count) solver->velocities[i][b] = vb[i];
+    }
+}
+
+/**
+ * @name SolveLane
+ * @authors Israfiel
+ * @brief Solve one contact, friction first so the normal gets the last
+ * word on penetration.
+ *
+ * @param solver - The solver.
+ * @param batch - The batch.
+ * @param lane - The lane.
+ * @param relax - Whether to aim for the relaxed normal velocity rather
+ * than the biased one.
+ */
+static void SolveLane(ir_solver_t *solver, ir_solver_batch_t *batch,
+                      int lane, bool relax)
+{
+    uint32_t a = batch->a[lane], b = batch->b[lane];
+    float va[6], vb[6];
+    for (int i = 0; i < 6; ++i)
+    {
+        va[i] = solver->velocities[i][a];
+        vb[i] = solver->velocities[i][b];
+    }
+
+    static const int order[3] = {1, 2, 0};
+    for (int j = 0; j < 3; ++j)
+    {
+        int r = order[j];
+        ir_solver_row_t *row = &batch->rows[r];
+        float target = r != 0 ? 0.0f
+                       : relax ? batch->relax[lane]
+                               : batch->bias[lane];
+        float old = row->impulse[lane];
+        float impulse =
+            old + row->mass[lane] *
+                      (target - Speed(batch, lane, r, va, vb));
+        if (r == 0) impulse = fmaxf(impulse, 0.0f);
+        else
+        {
+            float limit =
+                batch->friction[lane] * batch->rows[0].impulse[lane];
+            impulse = fminf(fmaxf(impulse, -limit), limit);
+        }
+        row->impulse[lane] = impulse;
+        Apply(batch, lane, r, impulse - old, va, vb);
+    }
+
+    for (int i = 0; i < 6; ++i)
+    {
+        if (a != solver->body_count) solver->velocities[i][a] = va[i];
+        if (b != solver->body_count) solver->velocities[i][b] = vb[i];
+    }
+}
+
+/**
+ * @name Gather
+ * @authors Israfiel
+ * @brief Load one velocity component of a batch's bodies.
+ *
+ * @param values - The component, for every body.
+ * @param bodies - The batch's bodies.
+ * @returns The components.
+ */
+static ir_simd_t Gather(const float *values, const uint32_t *bodies)
+{
+    float lanes[IR_SIMD_WIDTH];
+    for (int i = 0; i < IR_SIMD_WIDTH; ++i) lanes[i] = values[bodies[i]];
+    return Ir_SimdLoad(lanes);
+}
+
+/**
+ * @name Scatter
+ * @authors Israfiel
+ * @brief Store one velocity component of a batch's bodies, skipping the
+ * static sentinel.
+ *
+ * @param values - The component, for every body.
+ * @param bodies - The batch's bodies.
+ * @param sentinel - The static sentinel.
+ * @param a - The components.
+ */
+static void Scatter(float *values, const uint32_t *bodies,
+                    uint32_t sentinel, ir_simd_t a)
+{
+    float lanes[IR_SIMD_WIDTH];
+    Ir_SimdStore(lanes, a);
+    for (int i = 0; i < IR_SIMD_WIDTH; ++i)
+        if (bodies[i] != sentinel) values[bodies[i]] = lanes[i];
+}
+
+/**
+ * @name SolveBatch
+ * @authors Israfiel
+ * @brief Solve four contacts that share no dynamic body at once, the
+ * same way SolveLane solves one.
+ *
+ * @param solver - The solver.
+ * @param batch - The batch.
+ * @param relax - Whether to aim for the relaxed normal velocity.
+ */
+static void SolveBatch(ir_solver_t *solver, ir_solver_batch_t *batch,
+                       bool relax)
+{
+    ir_simd_t va[6], vb[6];
+    for (int i = 0; i < 6; ++i)
+    {
+        va[i] = Gather(solver->velocities[i], batch->a);
+        vb[i] = Gather(solver->velocities[i], batch->b);
+    }
+    ir_simd_t mass_a = Ir_SimdLoad(batch->mass_a);
+    ir_simd_t mass_b = Ir_SimdLoad(batch->mass_b);
+    ir_simd_t zero = Ir_SimdSplat(0.0f);
+
+    static const int order[3] = {1, 2, 0};
+    for (int j = 0; j < 3; ++j)
+    {
+        int r = order[j];
+        ir_solver_row_t *row = &batch->rows[r];
+        ir_simd_t d[3], arm_a[3], arm_b[3];
+        ir_simd_t speed = zero;
+        for (int i = 0; i < 3; ++i)
+        {
+            d[i] = Ir_SimdLoad(row->direction[i]);
+            arm_a[i] = Ir_SimdLoad(row->arm_a[i]);
+            arm_b[i] = Ir_SimdLoad(row->arm_b[i]);
+            speed = Ir_SimdMulAdd(d[i], Ir_SimdSub(vb[i], va[i]), speed);
+            speed = Ir_SimdMulAdd(arm_b[i], vb[i + 3], speed);
+            speed = Ir_SimdSub(speed, Ir_SimdMul(arm_a[i], va[i + 3]));
+        }
+
+        ir_simd_t target =
+            r != 0  ? zero
+            : relax ? Ir_SimdLoad(batch->relax)
+                    : Ir_SimdLoad(batch->bias);
+        ir_simd_t old = Ir_SimdLoad(row->impulse);
+        ir_simd_t impulse = Ir_SimdMulAdd(Ir_SimdLoad(row->mass),
+                                          Ir_SimdSub(target, speed), old);
+        if (r == 0) impulse = Ir_SimdMax(impulse, zero);
+        else
+        {
+            ir_simd_t limit =
+                Ir_SimdMul(Ir_SimdLoad(batch->friction),
+                           Ir_SimdLoad(batch->rows[0].impulse));
+            impulse = Ir_SimdMin(
+                Ir_SimdMax(impulse, Ir_SimdSub(zero, limit)), limit);
+        }
+        Ir_SimdStore(row->impulse, impulse);
+
+        ir_simd_t delta = Ir_SimdSub(impulse, old);
+        ir_simd_t ia = Ir_SimdMul(mass_a, delta);
+        ir_simd_t ib = Ir_SimdMul(mass_b, delta);
+        for (int i = 0; i < 3; ++i)
+        {
+            va[i] = Ir_SimdSub(va[i], Ir_SimdMul(ia, d[i]));
+            vb[i] = Ir_SimdMulAdd(ib, d[i], vb[i]);
+            va[i + 3] = Ir_SimdSub(
+                va[i + 3], Ir_SimdMul(delta, Ir_SimdLoad(row->turn_a[i])));
+            vb[i + 3] = Ir_SimdMulAdd(delta, Ir_SimdLoad(row->turn_b[i]),
+                                      vb[i + 3]);
+        }
+    }
+
+    for (int i = 0; i < 6; ++i)
+    {
+        Scatter(solver->velocities[i], batch->a, solver->body_count,
+                va[i]);
+        Scatter(solver->velocities[i], batch->b, solver->body_count,
+                vb[i]);
+    }
+}
+
+/**
+ * @name SolveBatches
+ * @authors Israfiel
+ * @brief Solve a range of one colour's batches.
+ *
+ * @param user - The colour.
+ * @param begin - The range's first batch.
+ * @param end - One past the range's last batch.
+ */
+static void SolveBatches(void *user, size_t begin, size_t end)
+{
+    ir_solver_range_t *range = user;
+    for (size_t i = begin; i < end; ++i)
+        SolveBatch(range->solver, &range->batches[i], range->relax);
+}
+
+/**
+ * @name Colour
+ * @authors Israfiel
+ * @brief Split an island's contacts into colours, greedily giving each
+ * the first colour neither of its dynamic bodies has yet, and fill the
+ * island's batches colour by colour.
+ *
+ * @param solver - The solver.
+ * @param island - The island.
+ * @param groups - Filled with a group per colour, then the leftovers.
+ * @returns The number of groups.
+ */
+static uint32_t Colour(ir_solver_t *solver,
+                       const ir_solver_island_t *island,
+                       ir_solver_group_t *groups)
+{
+    const uint32_t *contacts =
+        solver->island_contacts + island->contact_offset;
+    const uint32_t *bodies = solver->island_bodies + island->body_offset;
+    uint8_t *colours = solver->contact_colours + island->contact_offset;
+    for (uint32_t i = 0; i < island->body_count; ++i)
+        solver->colours[bodies[i]] = 0;
+
+    uint32_t counts[IR_SOLVER_COLOURS + 1] = {0};
+    for (uint32_t i = 0; i < island->contact_count; ++i)
+    {
+        const ir_narrowphase_contact_t *contact =
+            &solver->narrowphase->contacts[contacts[i] /
+                                           IR_MANIFOLD_POINTS];
+        bool dynamic_a = solver->bodies[contact->a].inverse_mass > 0.0f;
+        bool dynamic_b = solver->bodies[contact->b].inverse_mass > 0.0f;
+        uint64_t used = (dynamic_a ? solver->colours[contact->a] : 0) |
+                        (dynamic_b ? solver->colours[contact->b] : 0);
+        uint32_t colour = ~used == 0 ? IR_SOLVER_COLOURS
+                                     : (uint32_t)__builtin_ctzll(~used);
+        if (colour < IR_SOLVER_COLOURS)
+        {
+            uint64_t bit = (uint64_t)1 << colour;
+            if (dynamic_a) solver->colours[contact->a] |= bit;
+            if (dynamic_b) solver->colours[contact->b] |= bit;
+        }
+        colours[i] = (uint8_t)colour;
+        counts[colour]++;
+    }
+
+    uint32_t group_count = 0, begin = 0;
+    uint32_t starts[IR_SOLVER_COLOURS + 1];
+    for (uint32_t c = 0; c <= IR_SOLVER_COLOURS; ++c)
+    {
+        starts[c] = begin;
+        if (counts[c] == 0) continue;
+        uint32_t batches = (counts[c] + IR_SIMD_WIDTH - 1) / IR_SIMD_WIDTH;
+        groups[group_count++] = (ir_solver_group_t){
+            island->batch_offset + begin, batches,
+            c < IR_SOLVER_COLOURS};
+        begin += batches;
+    }
+
+    ir_solver_batch_t *batches = solver->batches + island->batch_offset;
+    uint32_t filled[IR_SOLVER_COLOURS + 1] = {0};
+    for (uint32_t i = 0; i < island->contact_count; ++i)
+    {
+        uint32_t c = colours[i], lane = filled[c]++;
+        Prepare(solver, &batches[starts[c] + lane / IR_SIMD_WIDTH],
+                (int)(lane % IR_SIMD_WIDTH), contacts[i]);
+    }
+    for (uint32_t c = 0; c <= IR_SOLVER_COLOURS; ++c)
+        for (uint32_t lane = filled[c]; lane % IR_SIMD_WIDTH != 0; ++lane)
+            Pad(solver, &batches[starts[c] + lane / IR_SIMD_WIDTH],
+                (int)(lane % IR_SIMD_WIDTH));
+    return group_count;
+}
+
+/**
+ * @name Pack
+ * @authors Israfiel
+ * @brief Fill a small island's batches in order, to be solved a contact
+ * at a time.
+ *
+ * @param solver - The solver.
+ * @param island - The island.
+ * @param groups - Filled with the one group.
+ * @returns The number of groups.
+ */
+static uint32_t Pack(ir_solver_t *solver,
+                     const ir_solver_island_t *island,
+                     ir_solver_group_t *groups)
+{
+    if (island->contact_count == 0) return 0;
+    const uint32_t *contacts =
+        solver->island_contacts + island->contact_offset;
+    ir_solver_batch_t *batches = solver->batches + island->batch_offset;
+    uint32_t count = (island->contact_count + IR_SIMD_WIDTH - 1) /
+                     IR_SIMD_WIDTH;
+    for (uint32_t i = 0; i < count * IR_SIMD_WIDTH; ++i)
+    {
+        if (i < island->contact_count)
+            Prepare(solver, &batches[i / IR_SIMD_WIDTH],
+                    (int)(i % IR_SIMD_WIDTH), contacts[i]);
+        else
+            Pad(solver, &batches[i / IR_SIMD_WIDTH],
+                (int)(i % IR_SIMD_WIDTH));
+    }
+    groups[0] = (ir_solver_group_t){island->batch_offset, count, false};
+    return 1;
+}
+
+/**
+ * @name Move
+ * @authors Israfiel
+ * @brief Move a dynamic body by its solved velocity.
+ *
+ * @param solver - The solver.
+ * @param index - The body.
+ */
+static void Move(ir_solver_t *solver, uint32_t index)
+{
+    float *const *v = solver->velocities;
+    ir_vec3_t linear = Ir_Vec3(v[0][index], v[1][index], v[2][index]);
+    ir_vec3_t angular = Ir_Vec3(v[3][index], v[4][index], v[5][index]);
+
+    float step = solver->step;
+    ir_transform_t *transform = &solver->bodies[index].transform;
+    transform->position =
+        Ir_Vec3Add(transform->position, Ir_Vec3Scale(linear, step));
+    ir_vec3_t w = Ir_Vec3Scale(angular, 0.5f * step);
+    ir_quat_t spin = Ir_QuatMul((ir_quat_t){w.x, w.y, w.z, 0.0f},
+                                transform->rotation);
+    transform->rotation = Ir_QuatNormalize((ir_quat_t){
+        transform->rotation.x + spin.x, transform->rotation.y + spin.y,
+        transform->rotation.z + spin.z, transform->rotation.w + spin.w});
+}
+
+/**
+ * @name Store
+ * @authors Israfiel
+ * @brief Copy a dynamic body's relaxed velocity back, and track how
+ * long it has been still.
+ *
+ * @param solver - The solver.
+ * @param index - The body.
+ */
+static void Store(ir_solver_t *solver, uint32_t index)
+{
+    ir_body_t *body = &solver->bodies[index];
+    float *const *v = solver->velocities;
+    body->linear_velocity = Ir_Vec3(v[0][index], v[1][index], v[2][index]);
+    body->angular_velocity =
+        Ir_Vec3(v[3][index], v[4][index], v[5][index]);
+
+    bool still = Ir_Vec3LengthSquared(body->linear_velocity) <
+                     solver->sleep_linear * solver->sleep_linear &&
+                 Ir_Vec3LengthSquared(body->angular_velocity) <
+                     solver->sleep_angular * solver->sleep_angular;
+    body->sleep_time = still ? body->sleep_time + solver->step : 0.0f;
+}
+
+/**
+ * @name SolveGroups
+ * @authors Israfiel
+ * @brief Run one iteration over an island's groups, splitting colours
+ * large enough to be worth it across the pool.
+ *
+ * @param solver - The solver.
+ * @param groups - The island's groups.
+ * @param group_count - The number of groups.
+ * @param relax - Whether to aim for the relaxed normal velocity.
+ */
+static void SolveGroups(ir_solver_t *solver,
+                        const ir_solver_group_t *groups,
+                        uint32_t group_count, bool relax)
+{
+    for (uint32_t g = 0; g < group_count; ++g)
+    {
+        ir_solver_batch_t *batches = solver->batches + groups[g].begin;
+        uint32_t count = groups[g].count;
+        if (!groups[g].wide)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+                for (int lane = 0; lane < IR_SIMD_WIDTH; ++lane)
+                    SolveLane(solver, &batches[i], lane, relax);
+        }
+        else if (solver->jobs != NULL && count >= 2 * IR_SOLVER_GRAIN)
+        {
+            ir_solver_range_t range = {solver, batches, relax};
+            Ir_JobsParallelFor(solver->jobs, count, IR_SOLVER_GRAIN,
+                               SolveBatches, &range);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < count; ++i)
+                SolveBatch(solver, &batches[i], relax);
+        }
+    }
+}
+
+/**
+ * @name SolveIsland
+ * @authors Israfiel
+ * @brief Solve one island, unless every body in it is asleep; a single
+ * awake body wakes the rest.
+ *
+ * @param user - The solver.
+ * @param begin - The first island to solve, by size.
+ * @param end - One past the last island to solve.
+ */
+static void SolveIsland(void *user, size_t begin, size_t end)
+{
+    ir_solver_t *solver = user;
+    for (size_t n = begin; n < end; ++n)
+    {
+        const ir_solver_island_t *island =
+            &solver->islands[solver->island_order[n]];
+        const uint32_t *bodies =
+            solver->island_bodies + island->body_offset;
+
+        bool awake = false;
+        for (uint32_t i = 0; i < island->body_count && !awake; ++i)
+            awake = !solver->bodies[bodies[i]].asleep;
+        if (!awake) continue;
+        atomic_fetch_add_explicit(&solver->awake_count, 1,
+                                  memory_order_relaxed);
+
+        for (uint32_t i = 0; i < island->body_count; ++i)
+            Load(solver, bodies[i]);
+
+        ir_solver_group_t groups[IR_SOLVER_COLOURS + 1];
+        uint32_t group_count =
+            island->contact_count >= IR_SOLVER_COLOUR_THRESHOLD
+                ? Colour(solver, island, groups)
+                : Pack(solver, island, groups);
+
+        for (uint32_t g = 0; g < group_count; ++g)
+            for (uint32_t i = 0; i < groups[g].count; ++i)
+                for (int lane = 0; lane < IR_SIMD_WIDTH; ++lane)
+                    WarmLane(solver,
+                             &solver->batches[groups[g].begin + i], lane);
+
+        // Bodies move with the velocity that pushes them apart, which is
+        // then relaxed away so it doesn't carry into the next step as
+        // bounce.
+        for (uint32_t i = 0; i < solver->iterations; ++i)
+            SolveGroups(solver, groups, group_count, false);
+        for (uint32_t i = 0; i < island->body_count; ++i)
+        {
+            if (solver->bodies[bodies[i]].fast)
+                solver->starts[bodies[i]] =
+                    solver->bodies[bodies[i]].transform;
+            Move(solver, bodies[i]);
+        }
+        for (uint32_t i = 0; i < solver->relax_iterations; ++i)
+            SolveGroups(solver, groups, group_count, true);
+
+        for (uint32_t g = 0; g < group_count; ++g)
+        {
+            for (uint32_t i = 0; i < groups[g].count; ++i)
+            {
+                const ir_solver_batch_t *batch =
+                    &solver->batches[groups[g].begin + i];
+                for (int lane = 0; lane < IR_SIMD_WIDTH; ++lane)
+                {
+                    uint32_t index = batch->contact[lane];
+                    if (index == UINT32_MAX) continue;
+                    float *impulses =
+                        solver->narrowphase
+                            ->contacts[index / IR_MANIFOLD_POINTS]
+                            .impulses[index % IR_MANIFOLD_POINTS];
+                    for (int r = 0; r < 3; ++r)
+                        impulses[r] = batch->rows[r].impulse[lane];
+                }
+            }
+        }
+
+        float still = FLT_MAX;
+        for (uint32_t i = 0; i < island->body_count; ++i)
+        {
+            Store(solver, bodies[i]);
+            still = fminf(still, solver->bodies[bodies[i]].sleep_time);
+        }
+        if (still < solver->sleep_delay) continue;
+        for (uint32_t i = 0; i < island->body_count; ++i)
+        {
+            ir_body_t *body = &solver->bodies[bodies[i]];
+            body->asleep = true;
+            body->linear_velocity = body->angular_velocity =
+                Ir_Vec3(0.0f, 0.0f, 0.0f);
+        }
+    }
+}
+
+/**
+ * @name FreeBodies
+ * @authors Israfiel
+ * @brief Free a solver's per-body arrays.
+ *
+ * @param solver - The solver.
+ */
+static void FreeBodies(ir_solver_t *solver)
+{
+    free(solver->parents);
+    free(solver->velocities[0]);
+    free(solver->inertia[0]);
+    free(solver->colours);
+    free(solver->body_islands);
+    free(solver->island_bodies);
+    free(solver->islands);
+    free(solver->island_order);
+    free(solver->starts);
+    free(solver->impacts);
+    solver->parents = NULL;
+    solver->velocities[0] = solver->inertia[0] = NULL;
+    solver->colours = NULL;
+    solver->body_islands = solver->island_bodies = NULL;
+    solver->islands = NULL;
+    solver->island_order = NULL;
+    solver->starts = NULL;
+    solver->impacts = NULL;
+    solver->body_capacity = 0;
+}
+
+/**
+ * @name ReserveBodies
+ * @authors Israfiel
+ * @brief Make room for a number of bodies. The arrays' contents don't
+ * outlive a step, so they're reallocated rather than grown.
+ *
+ * @param solver - The solver.
+ * @param count - The number of bodies.
+ * @returns Whether there was memory for them.
+ */
+static bool ReserveBodies(ir_solver_t *solver, uint32_t count)
+{
+    if (solver->body_capacity > count) return true;
+    FreeBodies(solver);
+
+    // One more than asked for, for the static sentinel.
+    size_t entries = (size_t)count + 1;
+    solver->parents = malloc(entries * sizeof(uint32_t));
+    float *velocities = malloc(6 * entries * sizeof(float));
+    float *inertia = malloc(6 * entries * sizeof(float));
+    solver->velocities[0] = velocities;
+    solver->inertia[0] = inertia;
+    solver->colours = malloc(entries * sizeof(uint64_t));
+    solver->body_islands = malloc(entries * sizeof(uint32_t));
+    solver->island_bodies = malloc(entries * sizeof(uint32_t));
+    solver->islands = malloc(entries * sizeof(ir_solver_island_t));
+    solver->island_order = malloc(entries * sizeof(uint32_t));
+    solver->starts = malloc(entries * sizeof(ir_transform_t));
+    solver->impacts = malloc(entries * sizeof(float));
+    if (solver->parents == NULL || velocities == NULL || inertia == NULL ||
+        solver->colours == NULL || solver->body_islands == NULL ||
+        solver->island_bodies == NULL || solver->islands == NULL ||
+        solver->island_order == NULL || solver->starts == NULL ||
+        solver->impacts == NULL)
+    {
+        FreeBodies(solver);
+        return false;
+    }
+    for (int i = 0; i < 6; ++i)
+    {
+        solver->velocities[i] = velocities + i * entries;
+        solver->inertia[i] = inertia + i * entries;
+    }
+    solver->body_capacity = (uint32_t)entries;
+    return true;
+}
+
+/**
+ * @name FreeContacts
+ * @authors Israfiel
+ * @brief Free a solver's per-contact arrays.
+ *
+ * @param solver - The solver.
+ */
+static void FreeContacts(ir_solver_t *solver)
+{
+    free(solver->island_contacts);
+    free(solver->contact_colours);
+    free(solver->sweeps);
+    free(solver->sweep_times);
+    solver->island_contacts = solver->sweeps = NULL;
+    solver->contact_colours = NULL;
+    solver->sweep_times = NULL;
+    solver->contact_capacity = 0;
+}
+
+/**
+ * @name ReserveContacts
+ * @authors Israfiel
+ * @brief Make room for a number of contacts, and their manifolds'
+ * points.
+ *
+ * @param solver - The solver.
+ * @param count - The number of contacts.
+ * @returns Whether there was memory for them.
+ */
+static bool ReserveContacts(ir_solver_t *solver, uint32_t count)
+{
+    if (solver->contact_capacity >= count) return true;
+    FreeContacts(solver);
+    size_t points = (size_t)count * IR_MANIFOLD_POINTS;
+    solver->island_contacts = malloc(points * sizeof(uint32_t));
+    solver->contact_colours = malloc(points * sizeof(uint8_t));
+    solver->sweeps = malloc(count * sizeof(uint32_t));
+    solver->sweep_times = malloc(count * sizeof(float));
+    if (solver->island_contacts == NULL ||
+        solver->contact_colours == NULL || solver->sweeps == NULL ||
+        solver->sweep_times == NULL)
+    {
+        FreeContacts(solver);
+        return false;
+    }
+    solver->contact_capacity = count;
+    return true;
+}
+
+/**
+ * @name ReserveBatches
+ * @authors Israfiel
+ * @brief Make room for a number of batches.
+ *
+ * @param solver - The solver.
+ * @param count - The number of batches.
+ * @returns Whether there was memory for them.
+ */
+static bool ReserveBatches(ir_solver_t *solver, uint32_t count)
+{
+    if (solver->batch_capacity >= count) return true;
+    free(solver->batches);
+    solver->batches = malloc(count * sizeof(ir_solver_batch_t));
+    solver->batch_capacity = solver->batches != NULL ? count : 0;
+    return solver->batches != NULL;
+}
+
+/**
+ * @name CompareWork
+ * @authors Israfiel
+ * @brief Order packed island keys for qsort.
+ *
+ * @param a - The first key.
+ * @param b - The second key.
+ * @returns Their order.
+ */
+static int CompareWork(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @name Reach
+ * @authors Israfiel
+ * @brief Find the widest gap a contact's points are solved across: the
+ * margin, plus, when either body is fast, as far as the two close on
+ * each other in a step. Those speculative points stop a fast body where
+ * it would have hit without ever letting it pass through.
+ *
+ * @param solver - The solver.
+ * @param contact - The contact.
+ * @returns The gap, in metres.
+ */
+static float Reach(const ir_solver_t *solver,
+                   const ir_narrowphase_contact_t *contact)
+{
+    const ir_body_t *a = &solver->bodies[contact->a];
+    const ir_body_t *b = &solver->bodies[contact->b];
+    if (!a->fast && !b->fast) return solver->margin;
+    ir_vec3_t closing = Ir_Vec3Sub(a->linear_velocity, b->linear_velocity);
+    return solver->margin +
+           fmaxf(Ir_Vec3Dot(closing, contact->manifold.normal), 0.0f) *
+               solver->step;
+}
+
+/**
+ * @name Touching
+ * @authors Israfiel
+ * @brief Check whether any of a contact's points is close enough to
+ * solve.
+ *
+ * @param contact - The contact.
+ * @param reach - The contact's reach.
+ * @returns Whether it is.
+ */
+static bool Touching(const ir_narrowphase_contact_t *contact, float reach)
+{
+    for (uint32_t i = 0; i < contact->manifold.count; ++i)
+        if (contact->manifold.points[i].separation <= reach) return true;
+    return false;
+}
+
+/**
+ * @name Build
+ * @authors Israfiel
+ * @brief Join bodies touching through contacts into islands, and lay
+ * out each island's bodies, manifold points and batches. Static bodies
+ * join no island; their contacts go to the other body's.
+ *
+ * @param solver - The solver.
+ * @returns Whether there was memory for the islands' batches.
+ */
+static bool Build(ir_solver_t *solver)
+{
+    ir_body_t *bodies = solver->bodies;
+    ir_narrowphase_contact_t *contacts = solver->narrowphase->contacts;
+    uint32_t contact_count = solver->narrowphase->contact_count;
+    uint32_t *parents = solver->parents;
+    for (uint32_t i = 0; i < solver->body_count; ++i) parents[i] = i;
+
+    for (uint32_t i = 0; i < contact_count; ++i)
+    {
+        ir_narrowphase_contact_t *contact = &contacts[i];
+        if (!Touching(contact, Reach(solver, contact))) continue;
+        if (bodies[contact->a].inverse_mass <= 0.0f ||
+            bodies[contact->b].inverse_mass <= 0.0f)
+            continue;
+        uint32_t a = Find(parents, contact->a);
+        uint32_t b = Find(parents, contact->b);
+        if (a < b) parents[b] = a;
+        else parents[a] = b;
+    }
+
+    // Roots are their island's lowest body, so numbering islands as
+    // their roots come up numbers them the same every step.
+    ir_solver_island_t *islands = solver->islands;
+    uint32_t island_count = 0;
+    for (uint32_t i = 0; i < solver->body_count; ++i)
+    {
+        if (bodies[i].inverse_mass <= 0.0f)
+        {
+            solver->body_islands[i] = NO_ISLAND;
+            continue;
+        }
+        uint32_t root = Find(parents, i);
+        if (root == i)
+        {
+            islands[island_count] = (ir_solver_island_t){0};
+            solver->body_islands[i] = island_count++;
+        }
+        else solver->body_islands[i] = solver->body_islands[root];
+        islands[solver->body_islands[i]].body_count++;
+    }
+
+    for (uint32_t i = 0; i < contact_count; ++i)
+    {
+        ir_narrowphase_contact_t *contact = &contacts[i];
+        uint32_t island = solver->body_islands[contact->a];
+        if (island == NO_ISLAND) island = solver->body_islands[contact->b];
+        float reach = Reach(solver, contact);
+        for (uint32_t j = 0; j < contact->manifold.count; ++j)
+        {
+            if (contact->manifold.points[j].separation <= reach &&
+                island != NO_ISLAND)
+                islands[island].contact_count++;
+            else
+                contact->impulses[j][0] = contact->impulses[j][1] =
+                    contact->impulses[j][2] = 0.0f;
+        }
+    }
+
+    uint32_t bodies_before = 0, contacts_before = 0, batches_before = 0;
+    for (uint32_t i = 0; i < island_count; ++i)
+    {
+        ir_solver_island_t *island = &islands[i];
+        island->body_offset = bodies_before;
+        island->contact_offset = contacts_before;
+        island->batch_offset = batches_before;
+        bodies_before += island->body_count;
+        contacts_before += island->contact_count;
+
+        // Colouring pads out every colour's last batch, and the
+        // leftovers'.
+        uint32_t contacts = island->contact_count;
+        batches_before += (contacts + IR_SIMD_WIDTH - 1) / IR_SIMD_WIDTH;
+        if (contacts >= IR_SOLVER_COLOUR_THRESHOLD)
+            batches_before += IR_SOLVER_COLOURS + 1;
+        island->body_count = island->contact_count = 0;
+    }
+    if (!ReserveBatches(solver, batches_before)) return false;
+
+    for (uint32_t i = 0; i < solver->body_count; ++i)
+    {
+        uint32_t island = solver->body_islands[i];
+        if (island == NO_ISLAND) continue;
+        solver->island_bodies[islands[island].body_offset +
+                              islands[island].body_count++] = i;
+    }
+    for (uint32_t i = 0; i < contact_count; ++i)
+    {
+        ir_narrowphase_contact_t *contact = &contacts[i];
+        uint32_t island = solver->body_islands[contact->a];
+        if (island == NO_ISLAND) island = solver->body_islands[contact->b];
+        if (island == NO_ISLAND) continue;
+        float reach = Reach(solver, contact);
+        for (uint32_t j = 0; j < contact->manifold.count; ++j)
+        {
+            if (contact->manifold.points[j].separation > reach) continue;
+            solver->island_contacts[islands[island].contact_offset +
+                                    islands[island].contact_count++] =
+                i * IR_MANIFOLD_POINTS + j;
+        }
+    }
+
+    // Largest islands first, so the stragglers at the end are small.
+    uint64_t *keys = (uint64_t *)solver->colours;
+    for (uint32_t i = 0; i < island_count; ++i)
+    {
+        uint64_t work = islands[i].contact_count + islands[i].body_count;
+        keys[i] = (uint64_t)(UINT32_MAX - work) << 32 | i;
+    }
+    qsort(keys, island_count, sizeof(uint64_t), CompareWork);
+    for (uint32_t i = 0; i < island_count; ++i)
+        solver->island_order[i] = (uint32_t)keys[i];
+    solver->island_count = island_count;
+    return true;
+}
+
+/**
+ * @name Swept
+ * @authors Israfiel
+ * @brief Find a body's motion over the step just taken. Only fast
+ * bodies had where they started kept; the rest are taken not to have
+ * moved, as they moved too little to matter.
+ *
+ * @param solver - The solver.
+ * @param index - The body.
+ * @returns The motion.
+ */
+static ir_sweep_t Swept(const ir_solver_t *solver, uint32_t index)
+{
+    const ir_body_t *body = &solver->bodies[index];
+    bool moved = body->fast && body->inverse_mass > 0.0f && !body->asleep;
+    return (ir_sweep_t){moved ? solver->starts[index] : body->transform,
+                        body->transform};
+}
+
+/**
+ * @name SweepContacts
+ * @authors Israfiel
+ * @brief Find when each of a range of fast bodies' contacts first came
+ * within the slop over the step.
+ *
+ * @param user - The solver.
+ * @param begin - The range's first swept contact.
+ * @param end - One past the range's last swept contact.
+ */
+static void SweepContacts(void *user, size_t begin, size_t end)
+{
+    ir_solver_t *solver = user;
+    const ir_narrowphase_t *narrowphase = solver->narrowphase;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const ir_narrowphase_contact_t *contact =
+            &narrowphase->contacts[solver->sweeps[i]];
+        ir_sweep_t a = Swept(solver, contact->a);
+        ir_sweep_t b = Swept(solver, contact->b);
+        float time;
+        solver->sweep_times[i] =
+            Ir_ShapeSweep(&narrowphase->shapes[contact->a], &a,
+                          &narrowphase->shapes[contact->b], &b,
+                          solver->slop, &time, NULL)
+                ? time
+                : 1.0f;
+    }
+}
+
+/**
+ * @name Advance
+ * @authors Israfiel
+ * @brief Catch what speculative contacts missed: sweep every moved fast
+ * body against what it was near at the start of the step, and pull it
+ * back to its first impact. Its velocity is kept, and next step's
+ * contacts deal with the hit. Contacts already being solved are left
+ * to the solver.
+ *
+ * @param solver - The solver.
+ */
+static void Advance(ir_solver_t *solver)
+{
+    const ir_narrowphase_t *narrowphase = solver->narrowphase;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < narrowphase->contact_count; ++i)
+    {
+        const ir_narrowphase_contact_t *contact =
+            &narrowphase->contacts[i];
+        const ir_body_t *a = &solver->bodies[contact->a];
+        const ir_body_t *b = &solver->bodies[contact->b];
+        bool swept_a = a->fast && a->inverse_mass > 0.0f && !a->asleep;
+        bool swept_b = b->fast && b->inverse_mass > 0.0f && !b->asleep;
+        if ((swept_a || swept_b) && !Touching(contact, solver->margin))
+            solver->sweeps[count++] = i;
+    }
+    if (count == 0) return;
+
+    if (solver->jobs != NULL)
+        Ir_JobsParallelFor(solver->jobs, count, 1, SweepContacts, solver);
+    else SweepContacts(solver, 0, count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const ir_narrowphase_contact_t *contact =
+            &narrowphase->contacts[solver->sweeps[i]];
+        solver->impacts[contact->a] = solver->impacts[contact->b] = 1.0f;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const ir_narrowphase_contact_t *contact =
+            &narrowphase->contacts[solver->sweeps[i]];
+        float time = solver->sweep_times[i];
+        solver->impacts[contact->a] =
+            fminf(solver->impacts[contact->a], time);
+        solver->impacts[contact->b] =
+            fminf(solver->impacts[contact->b], time);
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const ir_narrowphase_contact_t *contact =
+            &narrowphase->contacts[solver->sweeps[i]];
+        uint32_t pair[2] = {contact->a, contact->b};
+        for (int j = 0; j < 2; ++j)
+        {
+            ir_body_t *body = &solver->bodies[pair[j]];
+            float time = solver->impacts[pair[j]];
+            if (time >= 1.0f) continue;
+            ir_sweep_t sweep = Swept(solver, pair[j]);
+            body->transform = Ir_SweepAt(&sweep, time);
+            solver->impacts[pair[j]] = 1.0f;
+        }
+    }
+}
+
+ir_body_t Ir_BodyDynamic(const ir_shape_t *shape, ir_transform_t transform,
+                         float mass)
+{
+    ir_body_t body = Ir_BodyStatic(transform);
+    body.inverse_mass = 1.0f / mass;
+    if (shape->type == IR_SHAPE_SPHERE)
+    {
+        float inertia = 0.4f * mass * shape->radius * shape->radius;
+        body.inverse_inertia = Ir_Vec3(1.0f / inertia, 1.0f / inertia,
+                                       1.0f / inertia);
+        return body;
+    }
+
+    ir_vec3_t min, max;
+    ir_transform_t local = {Ir_Vec3(0.0f, 0.0f, 0.0f), IR_QUAT_IDENTITY};
+    Ir_ShapeBounds(shape, &local, &min, &max);
+    ir_vec3_t size = Ir_Vec3Sub(max, min);
+    ir_vec3_t squared = Ir_Vec3(size.x * size.x, size.y * size.y,
+                                size.z * size.z);
+    float scale = 12.0f / mass;
+    body.inverse_inertia = Ir_Vec3(scale / (squared.y + squared.z),
+                                   scale / (squared.x + squared.z),
+                                   scale / (squared.x + squared.y));
+    return body;
+}
+
+void Ir_BodyBounds(const ir_body_t *body, const ir_shape_t *shape,
+                   float step, float margin, ir_vec3_t *min,
+                   ir_vec3_t *max)
+{
+    Ir_ShapeBounds(shape, &body->transform, min, max);
+    ir_vec3_t grow = Ir_Vec3(margin, margin, margin);
+    *min = Ir_Vec3Sub(*min, grow);
+    *max = Ir_Vec3Add(*max, grow);
+    if (!body->fast) return;
+
+    // Turning is left out: what tunnels is what moves far, and turning
+    // moves a body no further than its own size.
+    ir_vec3_t moved = Ir_Vec3Scale(body->linear_velocity, step);
+    *min = Ir_Vec3Add(*min, Ir_Vec3Min(moved, Ir_Vec3(0.0f, 0.0f, 0.0f)));
+    *max = Ir_Vec3Add(*max, Ir_Vec3Max(moved, Ir_Vec3(0.0f, 0.0f, 0.0f)));
+}
+
+ir_body_t Ir_BodyStatic(ir_transform_t transform)
+{
+    return (ir_body_t){.transform = transform, .friction = 0.6f};
+}
+
+void Ir_SolverCreate(ir_solver_t *solver)
+{
+    *solver = (ir_solver_t){
+        .gravity = Ir_Vec3(0.0f, -9.81f, 0.0f),
+        .iterations = 8,
+        .relax_iterations = 2,
+        .baumgarte = 0.2f,
+        .slop = 0.005f,
+        .margin = 0.05f,
+        .sleep_linear = 0.05f,
+        .sleep_angular = 0.05f,
+        .sleep_delay = 0.5f,
+    };
+}
+
+void Ir_SolverDestroy(ir_solver_t *solver)
+{
+    FreeBodies(solver);
+    FreeContacts(solver);
+    free(solver->batches);
+    *solver = (ir_solver_t){0};
+}
+
+bool Ir_SolverStep(ir_solver_t *solver, ir_body_t *bodies,
+                   uint32_t body_count, ir_narrowphase_t *narrowphase,
+                   float step, ir_jobs_t *jobs)
+{
+    solver->bodies = bodies;
+    solver->body_count = body_count;
+    solver->narrowphase = narrowphase;
+    solver->jobs = jobs;
+    solver->step = step;
+    atomic_store_explicit(&solver->awake_count, 0, memory_order_relaxed);
+    if (!ReserveBodies(solver, body_count) ||
+        !ReserveContacts(solver, narrowphase->contact_count))
+    {
+        IR_LOG_ERROR("Ran out of memory solving contacts.");
+        return false;
+    }
+
+    IR_PROFILE_BEGIN("Solver");
+    for (int i = 0; i < 6; ++i)
+    {
+        solver->velocities[i][body_count] = 0.0f;
+        solver->inertia[i][body_count] = 0.0f;
+    }
+    if (!Build(solver))
+    {
+        IR_PROFILE_END("Solver");
+        IR_LOG_ERROR("Ran out of memory solving contacts.");
+        return false;
+    }
+
+    // Islands are handed out one at a time, since one large island can
+    // outweigh thousands of small ones.
+    if (jobs != NULL)
+        Ir_JobsParallelFor(jobs, solver->island_count, 1, SolveIsland,
+                           solver);
+    else SolveIsland(solver, 0, solver->island_count);
+    Advance(solver);
+    IR_PROFILE_END("Solver");
+    return true;
+}
@@ -0,0 +1,345 @@
+/**
+ * @file Solver.h
+ * @authors Israfiel
+ * @brief Iridium's rigid body solver, a sequential-impulse solver over
+ * the points of the narrowphase's manifolds. Bodies joined by contacts
+ * are gathered into islands, which share nothing and so are solved in
+ * parallel. Large islands are coloured so no body appears twice in a
+ * colour, and each colour is then solved four points at a time with
+ * SIMD. Islands that have stayed still long enough fall asleep and cost
+ * nothing until something touches them. Bodies flagged as fast are kept
+ * from tunnelling without substeps: their contacts are solved across
+ * the whole gap they could close in a step, and whatever that misses is
+ * caught by sweeping them over the step.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PHYSICS_SOLVER_H
+#define IRIDIUM_PHYSICS_SOLVER_H
+
+#include "Core/Jobs.h"
+#include "Math/Quaternion.h"
+#include "Math/SIMD.h"
+#include "Physics/Narrowphase.h"
+#include "Physics/Shape.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_SOLVER_COLOURS
+ * @brief The most colours a large island is split into. Contacts that
+ * fit none are solved one at a time after the rest.
+ */
+#define IR_SOLVER_COLOURS 64
+
+/**
+ * @name IR_SOLVER_COLOUR_THRESHOLD
+ * @brief The fewest contacts an island needs before it's worth
+ * colouring.
+ */
+#define IR_SOLVER_COLOUR_THRESHOLD 64
+
+/**
+ * @name IR_SOLVER_GRAIN
+ * @brief The number of batches of one colour each job solves, when a
+ * colour is large enough to split across the pool.
+ */
+#define IR_SOLVER_GRAIN 64
+
+/**
+ * @name ir_body_t
+ * @brief A rigid body. Bodies share their numbers with their broadphase
+ * proxies, and a body with no inverse mass never moves.
+ */
+typedef struct ir_body
+{
+    ir_transform_t transform;
+    ir_vec3_t linear_velocity;
+    ir_vec3_t angular_velocity;
+    float inverse_mass;
+    /**
+     * @name inverse_inertia
+     * @brief The inverse of the inertia about each local axis.
+     */
+    ir_vec3_t inverse_inertia;
+    float friction;
+    /**
+     * @name sleep_time
+     * @brief How long, in seconds, the body has been still.
+     */
+    float sleep_time;
+    /**
+     * @name asleep
+     * @brief Whether the body's island is asleep. Clear it to wake the
+     * island on the next step.
+     */
+    bool asleep;
+    /**
+     * @name fast
+     * @brief Whether the body moves far enough in a step to pass through
+     * things, and so needs continuous collision. Its broadphase bounds
+     * should come from Ir_BodyBounds.
+     */
+    bool fast;
+} ir_body_t;
+
+/**
+ * @name ir_solver_row_t
+ * @brief One direction of four contacts, SoA.
+ */
+typedef struct ir_solver_row
+{
+    float direction[3][IR_SIMD_WIDTH];
+    /**
+     * @name arm_a
+     * @brief The lever arm on a crossed with the direction.
+     */
+    float arm_a[3][IR_SIMD_WIDTH];
+    float arm_b[3][IR_SIMD_WIDTH];
+    /**
+     * @name turn_a
+     * @brief How a unit impulse turns a: its world inverse inertia times
+     * the crossed lever arm.
+     */
+    float turn_a[3][IR_SIMD_WIDTH];
+    float turn_b[3][IR_SIMD_WIDTH];
+    /**
+     * @name mass
+     * @brief The inverse of the row's effective mass.
+     */
+    float mass[IR_SIMD_WIDTH];
+    float impulse[IR_SIMD_WIDTH];
+} ir_solver_row_t;
+
+/**
+ * @name ir_solver_batch_t
+ * @brief Four contacts solved together. Unused lanes point both bodies
+ * at the solver's static sentinel and have no mass.
+ */
+typedef struct ir_solver_batch
+{
+    uint32_t a[IR_SIMD_WIDTH];
+    uint32_t b[IR_SIMD_WIDTH];
+    uint32_t contact[IR_SIMD_WIDTH];
+    float mass_a[IR_SIMD_WIDTH];
+    float mass_b[IR_SIMD_WIDTH];
+    float friction[IR_SIMD_WIDTH];
+    /**
+     * @name bias
+     * @brief The normal velocity each contact aims for: positive to push
+     * out of penetration, negative to allow closing a gap.
+     */
+    float bias[IR_SIMD_WIDTH];
+    /**
+     * @name relax
+     * @brief The normal velocity each contact aims for once bodies have
+     * moved: only ever closing a gap, so pushing out isn't kept.
+     */
+    float relax[IR_SIMD_WIDTH];
+    /**
+     * @name rows
+     * @brief The normal, then both tangents.
+     */
+    ir_solver_row_t rows[3];
+} ir_solver_batch_t;
+
+/**
+ * @name ir_solver_island_t
+ * @brief A group of bodies joined by contacts.
+ */
+typedef struct ir_solver_island
+{
+    uint32_t body_offset;
+    uint32_t body_count;
+    uint32_t contact_offset;
+    uint32_t contact_count;
+    uint32_t batch_offset;
+} ir_solver_island_t;
+
+/**
+ * @name ir_solver_t
+ * @brief A solver, with its settings and the scratch it reuses between
+ * steps.
+ */
+typedef struct ir_solver
+{
+    ir_vec3_t gravity;
+    uint32_t iterations;
+    /**
+     * @name relax_iterations
+     * @brief The iterations run after bodies move, to take out the
+     * velocity used to push them out of each other.
+     */
+    uint32_t relax_iterations;
+    /**
+     * @name baumgarte
+     * @brief The fraction of penetration pushed out each step.
+     */
+    float baumgarte;
+    /**
+     * @name slop
+     * @brief The penetration, in metres, left alone so resting contacts
+     * don't jitter.
+     */
+    float slop;
+    /**
+     * @name margin
+     * @brief The widest gap, in metres, a contact is solved across.
+     */
+    float margin;
+    float sleep_linear;
+    float sleep_angular;
+    /**
+     * @name sleep_delay
+     * @brief How long, in seconds, an island must stay still to sleep.
+     */
+    float sleep_delay;
+
+    uint32_t *parents;
+    /**
+     * @name velocities
+     * @brief Every body's velocity while solving, SoA: linear then
+     * angular. The entry past the last body is the static sentinel.
+     */
+    float *velocities[6];
+    /**
+     * @name inertia
+     * @brief Every body's world inverse inertia: xx, yy, zz, xy, xz, yz.
+     */
+    float *inertia[6];
+    uint64_t *colours;
+    uint32_t *body_islands;
+    uint32_t *island_bodies;
+    /**
+     * @name starts
+     * @brief Where each fast body started the step.
+     */
+    ir_transform_t *starts;
+    /**
+     * @name impacts
+     * @brief Each swept body's earliest time of impact.
+     */
+    float *impacts;
+    uint32_t body_capacity;
+
+    /**
+     * @name island_contacts
+     * @brief Each island's manifold points, numbered by their pair times
+     * IR_MANIFOLD_POINTS plus their place in its manifold.
+     */
+    uint32_t *island_contacts;
+    uint8_t *contact_colours;
+    /**
+     * @name sweeps
+     * @brief The contacts of fast bodies swept after the step, and when
+     * each first hit.
+     */
+    uint32_t *sweeps;
+    float *sweep_times;
+    uint32_t contact_capacity;
+
+    ir_solver_island_t *islands;
+    uint32_t *island_order;
+    uint32_t island_count;
+
+    ir_solver_batch_t *batches;
+    uint32_t batch_capacity;
+
+    ir_body_t *bodies;
+    uint32_t body_count;
+    ir_narrowphase_t *narrowphase;
+    ir_jobs_t *jobs;
+    float step;
+    /**
+     * @name awake_count
+     * @brief How many islands the last step solved.
+     */
+    _Atomic uint32_t awake_count;
+} ir_solver_t;
+
+/**
+ * @name BodyDynamic
+ * @authors Israfiel
+ * @brief Make a moving body, approximating the inertia of anything but
+ * a sphere by that of its bounding box.
+ *
+ * @param shape - The body's shape.
+ * @param transform - Where the body starts.
+ * @param mass - The body's mass.
+ * @returns The body.
+ */
+ir_body_t Ir_BodyDynamic(const ir_shape_t *shape, ir_transform_t transform,
+                         float mass);
+
+/**
+ * @name BodyStatic
+ * @authors Israfiel
+ * @brief Make a body that never moves.
+ *
+ * @param transform - Where the body is.
+ * @returns The body.
+ */
+ir_body_t Ir_BodyStatic(ir_transform_t transform);
+
+/**
+ * @name BodyBounds
+ * @authors Israfiel
+ * @brief Find the bounds to give a body's broadphase proxy: its shape's
+ * bounds grown by a margin and, for a fast body, stretched over where
+ * its velocity takes it next step, so the narrowphase finds what it's
+ * about to hit.
+ *
+ * @param body - The body.
+ * @param shape - The body's shape.
+ * @param step - The length of the next step, in seconds.
+ * @param margin - The margin, in metres; usually the solver's.
+ * @param min - Filled with the bounds' least corner.
+ * @param max - Filled with the bounds' greatest corner.
+ */
+void Ir_BodyBounds(const ir_body_t *body, const ir_shape_t *shape,
+                   float step, float margin, ir_vec3_t *min,
+                   ir_vec3_t *max);
+
+/**
+ * @name SolverCreate
+ * @authors Israfiel
+ * @brief Create a solver with the default settings.
+ *
+ * @param solver - The solver.
+ */
+void Ir_SolverCreate(ir_solver_t *solver);
+
+/**
+ * @name SolverDestroy
+ * @authors Israfiel
+ * @brief Free a solver.
+ *
+ * @param solver - The solver.
+ */
+void Ir_SolverDestroy(ir_solver_t *solver);
+
+/**
+ * @name SolverStep
+ * @authors Israfiel
+ * @brief Solve the narrowphase's contacts and move every awake body
+ * forward a step. The impulses applied are written back into the
+ * contacts to warm-start the next step.
+ *
+ * @param solver - The solver.
+ * @param bodies - The bodies, numbered like the broadphase's proxies.
+ * @param body_count - The number of bodies.
+ * @param narrowphase - The narrowphase, already updated.
+ * @param step - The length of the step, in seconds.
+ * @param jobs - The pool to solve with, or NULL to solve on the calling
+ * thread.
+ * @returns Whether the step was taken; false if memory ran out.
+ */
+bool Ir_SolverStep(ir_solver_t *solver, ir_body_t *bodies,
+                   uint32_t body_count, ir_narrowphase_t *narrowphase,
+                   float step, ir_jobs_t *jobs);
+
+#endif // IRIDIUM_PHYSICS_SOLVER_H
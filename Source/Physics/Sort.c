@@ -0,0 +1,48 @@
+/**
+ * @file Sort.c
+ * @authors Israfiel
+ * @brief Implements the physics' radix sort.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Sort.h"
+
+/**
+ * @name RADIX_SIZE
+ * @brief The number of buckets per radix pass.
+ */
+#define RADIX_SIZE (1u << IR_RADIX_BITS)
+
+uint64_t *Ir_RadixSort(uint64_t *buffers[2], size_t count, uint32_t low,
+                       uint32_t high)
+{
+    uint64_t *values = buffers[0], *scratch = buffers[1];
+    if (count == 0) return values;
+    for (uint32_t shift = low; shift < high; shift += IR_RADIX_BITS)
+    {
+        size_t histogram[RADIX_SIZE] = {0};
+        for (size_t i = 0; i < count; ++i)
+            histogram[(values[i] >> shift) & (RADIX_SIZE - 1)]++;
+        if (histogram[(values[0] >> shift) & (RADIX_SIZE - 1)] == count)
+            continue;
+
+        size_t offset = 0;
+        for (size_t i = 0; i < RADIX_SIZE; ++i)
+        {
+            size_t bucket = histogram[i];
+            histogram[i] = offset;
+            offset += bucket;
+        }
+        for (size_t i = 0; i < count; ++i)
+            scratch[histogram[(values[i] >> shift) & (RADIX_SIZE - 1)]++] =
+                values[i];
+
+        uint64_t *swap = values;
+        values = scratch;
+        scratch = swap;
+    }
+    return values;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file Sort.h
+ * @authors Israfiel
+ * @brief The radix sort the broadphase and scene queries share, for
+ * keys packed into the high bits of a value with an index below them.
+ * It's internal to the physics, and not part of Iridium.h.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PHYSICS_SORT_H
+#define IRIDIUM_PHYSICS_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @name IR_RADIX_BITS
+ * @brief The bits sorted per radix pass. Eleven keeps the histogram in
+ * L1 and sorts a 32-bit key in three passes.
+ */
+#define IR_RADIX_BITS 11
+
+/**
+ * @name RadixSort
+ * @authors Israfiel
+ * @brief Sort values by a range of their bits, least significant digit
+ * first. Passes whose digit is the same for every value are skipped.
+ *
+ * @param buffers - The values, and scratch space as large.
+ * @param count - The number of values.
+ * @param low - The lowest bit to sort by.
+ * @param high - One past the highest bit to sort by.
+ * @returns Whichever buffer holds the sorted values.
+ */
+uint64_t *Ir_RadixSort(uint64_t *buffers[2], size_t count, uint32_t low,
+                       uint32_t high);
+
+#endif // IRIDIUM_PHYSICS_SORT_H
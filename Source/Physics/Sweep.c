@@ -0,0 +1,109 @@
+/**
+ * @file Sweep.c
+ * @authors Israfiel
+ * @brief Implements Iridium's swept shape queries.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Sweep.h"
+
+#include <math.h>
+#include <stddef.h>
+
+/**
+ * @name Turn
+ * @authors Israfiel
+ * @brief Find the rotation a motion makes, the short way round.
+ *
+ * @param sweep - The motion.
+ * @param axis - Filled with the unit axis.
+ * @returns The angle, in radians.
+ */
+static float Turn(const ir_sweep_t *sweep, ir_vec3_t *axis)
+{
+    ir_quat_t delta = Ir_QuatMul(sweep->to.rotation,
+                                 Ir_QuatConjugate(sweep->from.rotation));
+    if (delta.w < 0.0f)
+        delta = (ir_quat_t){-delta.x, -delta.y, -delta.z, -delta.w};
+    ir_vec3_t v = Ir_Vec3(delta.x, delta.y, delta.z);
+    float sine = Ir_Vec3Length(v);
+    *axis = Ir_Vec3Normalize(v, Ir_Vec3(1.0f, 0.0f, 0.0f));
+    return 2.0f * atan2f(sine, delta.w);
+}
+
+/**
+ * @name Reach
+ * @authors Israfiel
+ * @brief Find how far a shape's surface reaches from its origin, which
+ * bounds how fast any of it moves when it turns.
+ *
+ * @param shape - The shape.
+ * @returns The distance.
+ */
+static float Reach(const ir_shape_t *shape)
+{
+    ir_transform_t here = {Ir_Vec3(0.0f, 0.0f, 0.0f), IR_QUAT_IDENTITY};
+    ir_vec3_t min, max;
+    Ir_ShapeBounds(shape, &here, &min, &max);
+    return Ir_Vec3Length(Ir_Vec3(fmaxf(-min.x, max.x),
+                                 fmaxf(-min.y, max.y),
+                                 fmaxf(-min.z, max.z)));
+}
+
+ir_transform_t Ir_SweepAt(const ir_sweep_t *sweep, float t)
+{
+    ir_vec3_t axis;
+    float angle = Turn(sweep, &axis);
+    ir_vec3_t position = Ir_Vec3Add(
+        sweep->from.position,
+        Ir_Vec3Scale(Ir_Vec3Sub(sweep->to.position, sweep->from.position),
+                     t));
+    return (ir_transform_t){
+        position, Ir_QuatNormalize(Ir_QuatMul(Ir_QuatAxisAngle(axis,
+                                                               angle * t),
+                                              sweep->from.rotation))};
+}
+
+bool Ir_ShapeSweep(const ir_shape_t *a, const ir_sweep_t *sweep_a,
+                   const ir_shape_t *b, const ir_sweep_t *sweep_b,
+                   float target, float *time, ir_contact_t *contact)
+{
+    // Over the whole motion, no point of a shape moves further than its
+    // origin does plus its reach times the angle it turns.
+    ir_vec3_t axis;
+    float turning = Turn(sweep_a, &axis) * Reach(a) +
+                    Turn(sweep_b, &axis) * Reach(b);
+    ir_vec3_t moved_a = Ir_Vec3Sub(sweep_a->to.position,
+                                   sweep_a->from.position);
+    ir_vec3_t moved_b = Ir_Vec3Sub(sweep_b->to.position,
+                                   sweep_b->from.position);
+    ir_vec3_t moved = Ir_Vec3Sub(moved_a, moved_b);
+
+    ir_contact_t found;
+    ir_vec3_t direction = Ir_Vec3(0.0f, 0.0f, 0.0f);
+    float t = 0.0f;
+    for (int i = 0; i < IR_SWEEP_ITERATIONS; ++i)
+    {
+        ir_transform_t transform_a = Ir_SweepAt(sweep_a, t);
+        ir_transform_t transform_b = Ir_SweepAt(sweep_b, t);
+        Ir_ShapeContact(a, &transform_a, b, &transform_b, direction,
+                        &found);
+        direction = found.direction;
+        if (found.separation <= target || i == IR_SWEEP_ITERATIONS - 1)
+            break;
+
+        // The gap along the normal can't close faster than this, so
+        // advancing by the gap over it never steps past the impact.
+        float closing = Ir_Vec3Dot(moved, found.normal) + turning;
+        if (closing <= 0.0f) return false;
+        t += (found.separation - target) / closing;
+        if (t >= 1.0f) return false;
+    }
+
+    *time = t;
+    if (contact != NULL) *contact = found;
+    return true;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file Sweep.h
+ * @authors Israfiel
+ * @brief Iridium's swept shape queries. Conservative advancement steps
+ * two moving shapes forward by as much as their distance and a bound on
+ * how fast they can close it allow, so it never steps past the first
+ * time they touch however thin the shapes or fast the motion.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PHYSICS_SWEEP_H
+#define IRIDIUM_PHYSICS_SWEEP_H
+
+#include "Math/Quaternion.h"
+#include "Physics/GJK.h"
+#include "Physics/Shape.h"
+
+#include <stdbool.h>
+
+/**
+ * @name IR_SWEEP_ITERATIONS
+ * @brief The most steps a sweep takes before settling for the time it
+ * has reached, which is still never past the impact.
+ */
+#define IR_SWEEP_ITERATIONS 32
+
+/**
+ * @name ir_sweep_t
+ * @brief A shape's motion over a sweep: moving in a straight line and
+ * turning at a steady rate from one transform to the other.
+ */
+typedef struct ir_sweep
+{
+    ir_transform_t from;
+    ir_transform_t to;
+} ir_sweep_t;
+
+/**
+ * @name SweepAt
+ * @authors Israfiel
+ * @brief Find where a shape is partway through its motion.
+ *
+ * @param sweep - The motion.
+ * @param t - How far through it, zero to one.
+ * @returns The transform.
+ */
+ir_transform_t Ir_SweepAt(const ir_sweep_t *sweep, float t);
+
+/**
+ * @name ShapeSweep
+ * @authors Israfiel
+ * @brief Find the first time two moving shapes come within a distance
+ * of each other.
+ *
+ * @param a - The first shape.
+ * @param sweep_a - The first shape's motion.
+ * @param b - The second shape.
+ * @param sweep_b - The second shape's motion.
+ * @param target - The gap, in metres, that counts as an impact; a
+ * little above zero, so the shapes stop just short of touching.
+ * @param time - Filled with the time of impact, zero to one.
+ * @param contact - Filled with the shapes' contact at that time, or
+ * NULL.
+ * @returns Whether they come that close during the motion.
+ */
+bool Ir_ShapeSweep(const ir_shape_t *a, const ir_sweep_t *sweep_a,
+                   const ir_shape_t *b, const ir_sweep_t *sweep_b,
+                   float target, float *time, ir_contact_t *contact);
+
+#endif // IRIDIUM_PHYSICS_SWEEP_H
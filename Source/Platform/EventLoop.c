@@ -0,0 +1,428 @@
+/**
+ * @file EventLoop.c
+ * @authors Israfiel
+ * @brief The implementation of Iridium's epoll event loop.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "EventLoop.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+static_assert(IR_EVENT_READABLE == EPOLLIN, "Event flags must match.");
+static_assert(IR_EVENT_WRITABLE == EPOLLOUT, "Event flags must match.");
+static_assert(IR_EVENT_ERROR == (EPOLLERR | EPOLLHUP),
+              "Event flags must match.");
+
+/**
+ * @name MAX_READY
+ * @brief The most ready descriptors handled per wait.
+ */
+#define MAX_READY 64
+
+/**
+ * @name source_kind_t
+ * @brief What an event source is.
+ */
+typedef enum source_kind
+{
+    SOURCE_DESCRIPTOR,
+    SOURCE_TIMER,
+    SOURCE_WATCH,
+    SOURCE_WAKER,
+    SOURCE_WATCHES
+} source_kind_t;
+
+struct ir_event_source
+{
+    source_kind_t kind;
+    /**
+     * @name descriptor
+     * @brief The watched descriptor, or a watch's inotify descriptor.
+     */
+    int descriptor;
+    /**
+     * @name events
+     * @brief The events currently registered with epoll.
+     */
+    uint32_t events;
+    /**
+     * @name ready
+     * @brief The events reported by the last wait.
+     */
+    uint32_t ready;
+    bool removed;
+    ir_event_prepare_t prepare;
+    union
+    {
+        ir_event_dispatch_t dispatch;
+        ir_event_timer_t timer;
+        ir_event_watch_t watch;
+        ir_event_wake_t wake;
+    } callback;
+    void *user;
+    struct ir_event_source *next;
+};
+
+/**
+ * @name AddSource
+ * @authors Israfiel
+ * @brief Allocate a source and register its descriptor with epoll.
+ *
+ * @param loop - The loop.
+ * @param kind - The kind of source.
+ * @param descriptor - The descriptor to register, or -1 for a watch.
+ * @param events - The events to wait for.
+ * @returns The new source, or NULL.
+ */
+static ir_event_source_t *AddSource(ir_event_loop_t *loop,
+                                    source_kind_t kind, int descriptor,
+                                    uint32_t events)
+{
+    ir_event_source_t *source = calloc(1, sizeof(ir_event_source_t));
+    if (source == NULL) return NULL;
+    *source = (ir_event_source_t){
+        .kind = kind,
+        .descriptor = descriptor,
+        .events = events,
+        .next = loop->sources,
+    };
+
+    if (kind != SOURCE_WATCH)
+    {
+        struct epoll_event event = {.events = events, .data.ptr = source};
+        if (epoll_ctl(loop->epoll, EPOLL_CTL_ADD, descriptor, &event) != 0)
+        {
+            free(source);
+            return NULL;
+        }
+    }
+    loop->sources = source;
+    return source;
+}
+
+/**
+ * @name FreeSource
+ * @authors Israfiel
+ * @brief Unlink and free a removed source, closing any descriptor the
+ * loop made for it.
+ *
+ * @param loop - The loop.
+ * @param link - The link pointing at the source.
+ */
+static void FreeSource(ir_event_loop_t *loop, ir_event_source_t **link)
+{
+    ir_event_source_t *source = *link;
+    *link = source->next;
+
+    if (source->kind == SOURCE_TIMER || source->kind == SOURCE_WAKER ||
+        source->kind == SOURCE_WATCHES)
+        close(source->descriptor);
+    if (source->kind == SOURCE_WATCHES)
+    {
+        loop->inotify = -1;
+        loop->watches = NULL;
+    }
+    free(source);
+}
+
+/**
+ * @name PurgeSources
+ * @authors Israfiel
+ * @brief Free every removed source.
+ *
+ * @param loop - The loop.
+ */
+static void PurgeSources(ir_event_loop_t *loop)
+{
+    ir_event_source_t **link = &loop->sources;
+    while (*link != NULL)
+    {
+        if ((*link)->removed) FreeSource(loop, link);
+        else link = &(*link)->next;
+    }
+}
+
+/**
+ * @name ToTimespec
+ * @authors Israfiel
+ * @brief Convert nanoseconds into a timespec.
+ *
+ * @param nanoseconds - The nanoseconds.
+ * @returns The timespec.
+ */
+static struct timespec ToTimespec(uint64_t nanoseconds)
+{
+    return (struct timespec){
+        .tv_sec = (time_t)(nanoseconds / 1000000000),
+        .tv_nsec = (long)(nanoseconds % 1000000000),
+    };
+}
+
+bool Ir_EventLoopCreate(ir_event_loop_t *loop)
+{
+    *loop = (ir_event_loop_t){.inotify = -1};
+    loop->epoll = epoll_create1(EPOLL_CLOEXEC);
+    return loop->epoll != -1;
+}
+
+void Ir_EventLoopDestroy(ir_event_loop_t *loop)
+{
+    for (ir_event_source_t *source = loop->sources; source != NULL;
+         source = source->next)
+        source->removed = true;
+    PurgeSources(loop);
+    close(loop->epoll);
+    *loop = (ir_event_loop_t){.epoll = -1, .inotify = -1};
+}
+
+ir_event_source_t *Ir_EventLoopAddDescriptor(ir_event_loop_t *loop,
+                                             int descriptor,
+                                             uint32_t events,
+                                             ir_event_prepare_t prepare,
+                                             ir_event_dispatch_t dispatch,
+                                             void *user)
+{
+    ir_event_source_t *source =
+        AddSource(loop, SOURCE_DESCRIPTOR, descriptor, events);
+    if (source == NULL) return NULL;
+    source->prepare = prepare;
+    source->callback.dispatch = dispatch;
+    source->user = user;
+    return source;
+}
+
+ir_event_source_t *Ir_EventLoopAddTimer(ir_event_loop_t *loop,
+                                        uint64_t delay, uint64_t interval,
+                                        ir_event_timer_t callback,
+                                        void *user)
+{
+    int timer =
+        timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer == -1) return NULL;
+
+    ir_event_source_t *source =
+        AddSource(loop, SOURCE_TIMER, timer, EPOLLIN);
+    if (source == NULL)
+    {
+        close(timer);
+        return NULL;
+    }
+    source->callback.timer = callback;
+    source->user = user;
+
+    if (!Ir_EventLoopSetTimer(source, delay, interval))
+    {
+        epoll_ctl(loop->epoll, EPOLL_CTL_DEL, timer, NULL);
+        source->removed = true;
+        PurgeSources(loop);
+        return NULL;
+    }
+    return source;
+}
+
+bool Ir_EventLoopSetTimer(ir_event_source_t *source, uint64_t delay,
+                          uint64_t interval)
+{
+    struct itimerspec time = {
+        .it_value = ToTimespec(delay),
+        .it_interval = ToTimespec(interval),
+    };
+    return timerfd_settime(source->descriptor, 0, &time, NULL) == 0;
+}
+
+ir_event_source_t *Ir_EventLoopAddWatch(ir_event_loop_t *loop,
+                                        const char *path, uint32_t mask,
+                                        ir_event_watch_t callback,
+                                        void *user)
+{
+    if (loop->watches == NULL)
+    {
+        int inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify == -1) return NULL;
+
+        loop->watches = AddSource(loop, SOURCE_WATCHES, inotify, EPOLLIN);
+        if (loop->watches == NULL)
+        {
+            close(inotify);
+            return NULL;
+        }
+        loop->inotify = inotify;
+    }
+
+    int watch = inotify_add_watch(loop->inotify, path, mask);
+    if (watch == -1) return NULL;
+
+    ir_event_source_t *source = AddSource(loop, SOURCE_WATCH, watch, 0);
+    if (source == NULL)
+    {
+        inotify_rm_watch(loop->inotify, watch);
+        return NULL;
+    }
+    source->callback.watch = callback;
+    source->user = user;
+    return source;
+}
+
+ir_event_source_t *Ir_EventLoopAddWaker(ir_event_loop_t *loop,
+                                        ir_event_wake_t callback,
+                                        void *user)
+{
+    int waker = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (waker == -1) return NULL;
+
+    ir_event_source_t *source =
+        AddSource(loop, SOURCE_WAKER, waker, EPOLLIN);
+    if (source == NULL)
+    {
+        close(waker);
+        return NULL;
+    }
+    source->callback.wake = callback;
+    source->user = user;
+    return source;
+}
+
+void Ir_EventLoopWake(ir_event_source_t *source)
+{
+    // Only fails if the counter would overflow, which still wakes.
+    uint64_t one = 1;
+    ssize_t written = write(source->descriptor, &one, sizeof(one));
+    (void)written;
+}
+
+void Ir_EventLoopRemove(ir_event_loop_t *loop, ir_event_source_t *source)
+{
+    if (source->removed) return;
+    source->removed = true;
+
+    if (source->kind == SOURCE_WATCH)
+        inotify_rm_watch(loop->inotify, source->descriptor);
+    else epoll_ctl(loop->epoll, EPOLL_CTL_DEL, source->descriptor, NULL);
+
+    if (!loop->dispatching) PurgeSources(loop);
+}
+
+/**
+ * @name DispatchWatches
+ * @authors Israfiel
+ * @brief Read the inotify instance and route its events to watches.
+ *
+ * @param loop - The loop.
+ */
+static void DispatchWatches(ir_event_loop_t *loop)
+{
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t size;
+    while ((size = read(loop->inotify, buffer, sizeof(buffer))) > 0)
+    {
+        for (char *cursor = buffer; cursor < buffer + size;)
+        {
+            const struct inotify_event *event = (void *)cursor;
+            cursor += sizeof(struct inotify_event) + event->len;
+
+            const char *name = event->len ? event->name : NULL;
+            for (ir_event_source_t *source = loop->sources; source != NULL;
+                 source = source->next)
+                if (source->kind == SOURCE_WATCH && !source->removed &&
+                    source->descriptor == event->wd)
+                    source->callback.watch(source->user, event->mask,
+                                           name);
+        }
+    }
+}
+
+/**
+ * @name DispatchSource
+ * @authors Israfiel
+ * @brief Run a ready source's callback.
+ *
+ * @param loop - The loop.
+ * @param source - The source.
+ */
+static void DispatchSource(ir_event_loop_t *loop,
+                           ir_event_source_t *source)
+{
+    uint64_t count = 0;
+    switch (source->kind)
+    {
+        case SOURCE_DESCRIPTOR:
+            source->callback.dispatch(source->user, source->ready);
+            break;
+        case SOURCE_TIMER:
+            if (read(source->descriptor, &count, sizeof(count)) ==
+                sizeof(count))
+                source->callback.timer(source->user, count);
+            break;
+        case SOURCE_WAKER:
+            if (read(source->descriptor, &count, sizeof(count)) ==
+                sizeof(count))
+                source->callback.wake(source->user, count);
+            break;
+        case SOURCE_WATCHES: DispatchWatches(loop); break;
+        case SOURCE_WATCH:   break;
+    }
+}
+
+int Ir_EventLoopDispatch(ir_event_loop_t *loop, int64_t timeout)
+{
+    loop->dispatching = true;
+
+    int milliseconds = timeout < 0 ? -1
+                       : timeout > INT32_MAX * 1000000ll
+                           ? INT32_MAX
+                           : (int)((timeout + 999999) / 1000000);
+    for (ir_event_source_t *source = loop->sources; source != NULL;
+         source = source->next)
+    {
+        if (source->prepare == NULL || source->removed) continue;
+
+        uint32_t events = source->prepare(source->user);
+        if (events == 0) milliseconds = 0;
+        else if (events != source->events)
+        {
+            struct epoll_event event = {.events = events,
+                                        .data.ptr = source};
+            epoll_ctl(loop->epoll, EPOLL_CTL_MOD, source->descriptor,
+                      &event);
+            source->events = events;
+        }
+    }
+
+    // Prepared sources are dispatched even if the wait fails, so that
+    // they can cancel whatever they prepared.
+    struct epoll_event ready[MAX_READY];
+    int count = epoll_wait(loop->epoll, ready, MAX_READY, milliseconds);
+    bool failed = count == -1 && errno != EINTR;
+    for (int i = 0; i < count; ++i)
+        ((ir_event_source_t *)ready[i].data.ptr)->ready |= ready[i].events;
+
+    // Sources added by callbacks are prepended, so they're skipped
+    // until the next dispatch.
+    int dispatched = 0;
+    for (ir_event_source_t *source = loop->sources; source != NULL;
+         source = source->next)
+    {
+        if (source->removed ||
+            (source->ready == 0 && source->prepare == NULL))
+            continue;
+        DispatchSource(loop, source);
+        source->ready = 0;
+        dispatched++;
+    }
+
+    loop->dispatching = false;
+    PurgeSources(loop);
+    return failed ? -1 : dispatched;
+}
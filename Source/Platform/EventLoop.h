@@ -0,0 +1,270 @@
+/**
+ * @file EventLoop.h
+ * @authors Israfiel
+ * @brief Iridium's event loop, a thin layer over epoll. Display
+ * connections, timers, file watches and cross-thread wakeups are all
+ * file descriptors, so the main thread can wait on every one of them at
+ * once, or poll them without blocking at all. Sources with a prepare
+ * callback are told before every wait and dispatched after it even if
+ * nothing happened, which is what Wayland's prepare_read protocol needs.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PLATFORM_EVENTLOOP_H
+#define IRIDIUM_PLATFORM_EVENTLOOP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_EVENT_READABLE
+ * @brief A descriptor has data to read.
+ */
+#define IR_EVENT_READABLE 0x1u
+
+/**
+ * @name IR_EVENT_WRITABLE
+ * @brief A descriptor can be written without blocking.
+ */
+#define IR_EVENT_WRITABLE 0x4u
+
+/**
+ * @name IR_EVENT_ERROR
+ * @brief A descriptor hung up or failed.
+ */
+#define IR_EVENT_ERROR 0x18u
+
+/**
+ * @name ir_event_prepare_t
+ * @brief Called before the loop waits.
+ *
+ * @param user - The source's user data.
+ * @returns The events to wait for this time, or zero to skip the wait
+ * because the source already has work.
+ */
+typedef uint32_t (*ir_event_prepare_t)(void *user);
+
+/**
+ * @name ir_event_dispatch_t
+ * @brief Called when a descriptor is ready, or after every wait if the
+ * source has a prepare callback.
+ *
+ * @param user - The source's user data.
+ * @param events - The ready IR_EVENT_* flags, possibly none.
+ */
+typedef void (*ir_event_dispatch_t)(void *user, uint32_t events);
+
+/**
+ * @name ir_event_timer_t
+ * @brief Called when a timer expires.
+ *
+ * @param user - The timer's user data.
+ * @param expirations - How many times the timer expired since the last
+ * call, more than one if the loop fell behind.
+ */
+typedef void (*ir_event_timer_t)(void *user, uint64_t expirations);
+
+/**
+ * @name ir_event_watch_t
+ * @brief Called when a watched file changes.
+ *
+ * @param user - The watch's user data.
+ * @param mask - The inotify event mask.
+ * @param name - The changed file's name within a watched directory, or
+ * NULL when the watched path itself changed.
+ */
+typedef void (*ir_event_watch_t)(void *user, uint32_t mask,
+                                 const char *name);
+
+/**
+ * @name ir_event_wake_t
+ * @brief Called on the loop's thread after another thread woke it.
+ *
+ * @param user - The waker's user data.
+ * @param count - The number of wakes since the last call.
+ */
+typedef void (*ir_event_wake_t)(void *user, uint64_t count);
+
+/**
+ * @name ir_event_source_t
+ * @brief A registered descriptor, timer, watch or waker.
+ */
+typedef struct ir_event_source ir_event_source_t;
+
+/**
+ * @name ir_event_loop_t
+ * @brief An event loop. Must only be used from one thread, except for
+ * Ir_EventLoopWake.
+ */
+typedef struct ir_event_loop
+{
+    /**
+     * @name epoll
+     * @brief The epoll instance.
+     */
+    int epoll;
+    /**
+     * @name inotify
+     * @brief The inotify instance shared by every watch, or -1 until
+     * the first watch is added.
+     */
+    int inotify;
+    /**
+     * @name watches
+     * @brief The inotify instance's own source.
+     */
+    ir_event_source_t *watches;
+    /**
+     * @name sources
+     * @brief Every live source.
+     */
+    ir_event_source_t *sources;
+    /**
+     * @name dispatching
+     * @brief Whether callbacks are running; removals are deferred
+     * until they finish.
+     */
+    bool dispatching;
+} ir_event_loop_t;
+
+/**
+ * @name EventLoopCreate
+ * @authors Israfiel
+ * @brief Create an event loop.
+ *
+ * @param loop - The loop to create.
+ * @returns Whether the loop could be created.
+ */
+bool Ir_EventLoopCreate(ir_event_loop_t *loop);
+
+/**
+ * @name EventLoopDestroy
+ * @authors Israfiel
+ * @brief Destroy an event loop and every source still registered.
+ *
+ * @param loop - The loop to destroy.
+ */
+void Ir_EventLoopDestroy(ir_event_loop_t *loop);
+
+/**
+ * @name EventLoopAddDescriptor
+ * @authors Israfiel
+ * @brief Watch a descriptor the caller owns.
+ *
+ * @param loop - The loop.
+ * @param descriptor - The descriptor; not closed by the loop.
+ * @param events - The IR_EVENT_* flags to wait for. Ignored if the
+ * source has a prepare callback, which chooses them before each wait.
+ * @param prepare - Called before each wait, or NULL.
+ * @param dispatch - Called with the ready events.
+ * @param user - Passed to the callbacks.
+ * @returns The new source, or NULL.
+ */
+ir_event_source_t *Ir_EventLoopAddDescriptor(ir_event_loop_t *loop,
+                                             int descriptor,
+                                             uint32_t events,
+                                             ir_event_prepare_t prepare,
+                                             ir_event_dispatch_t dispatch,
+                                             void *user);
+
+/**
+ * @name EventLoopAddTimer
+ * @authors Israfiel
+ * @brief Add a monotonic timer.
+ *
+ * @param loop - The loop.
+ * @param delay - Nanoseconds until the first expiration, nonzero.
+ * @param interval - Nanoseconds between later expirations, or zero for
+ * a one-shot timer.
+ * @param callback - Called on expiration.
+ * @param user - Passed to the callback.
+ * @returns The new source, or NULL.
+ */
+ir_event_source_t *Ir_EventLoopAddTimer(ir_event_loop_t *loop,
+                                        uint64_t delay, uint64_t interval,
+                                        ir_event_timer_t callback,
+                                        void *user);
+
+/**
+ * @name EventLoopSetTimer
+ * @authors Israfiel
+ * @brief Rearm a timer.
+ *
+ * @param source - The timer.
+ * @param delay - Nanoseconds until the next expiration, or zero to
+ * disarm the timer.
+ * @param interval - Nanoseconds between later expirations, or zero.
+ * @returns Whether the timer could be rearmed.
+ */
+bool Ir_EventLoopSetTimer(ir_event_source_t *source, uint64_t delay,
+                          uint64_t interval);
+
+/**
+ * @name EventLoopAddWatch
+ * @authors Israfiel
+ * @brief Watch a file or directory for changes.
+ *
+ * @param loop - The loop.
+ * @param path - The path to watch.
+ * @param mask - The inotify IN_* events to watch for.
+ * @param callback - Called on each change.
+ * @param user - Passed to the callback.
+ * @returns The new source, or NULL.
+ */
+ir_event_source_t *Ir_EventLoopAddWatch(ir_event_loop_t *loop,
+                                        const char *path, uint32_t mask,
+                                        ir_event_watch_t callback,
+                                        void *user);
+
+/**
+ * @name EventLoopAddWaker
+ * @authors Israfiel
+ * @brief Add a source that other threads can wake the loop through.
+ *
+ * @param loop - The loop.
+ * @param callback - Called on the loop's thread after a wake.
+ * @param user - Passed to the callback.
+ * @returns The new source, or NULL.
+ */
+ir_event_source_t *Ir_EventLoopAddWaker(ir_event_loop_t *loop,
+                                        ir_event_wake_t callback,
+                                        void *user);
+
+/**
+ * @name EventLoopWake
+ * @authors Israfiel
+ * @brief Wake the loop through a waker. Safe to call from any thread
+ * while the waker is registered.
+ *
+ * @param source - The waker.
+ */
+void Ir_EventLoopWake(ir_event_source_t *source);
+
+/**
+ * @name EventLoopRemove
+ * @authors Israfiel
+ * @brief Unregister a source, closing any descriptor the loop made for
+ * it. Safe to call from within a callback.
+ *
+ * @param loop - The loop.
+ * @param source - The source to remove.
+ */
+void Ir_EventLoopRemove(ir_event_loop_t *loop, ir_event_source_t *source);
+
+/**
+ * @name EventLoopDispatch
+ * @authors Israfiel
+ * @brief Wait for events and dispatch them. A timeout of zero polls
+ * without blocking, which is what the frame loop should use.
+ *
+ * @param loop - The loop.
+ * @param timeout - Nanoseconds to wait at most, or a negative number to
+ * wait indefinitely.
+ * @returns The number of sources dispatched, or -1 on error.
+ */
+int Ir_EventLoopDispatch(ir_event_loop_t *loop, int64_t timeout);
+
+#endif // IRIDIUM_PLATFORM_EVENTLOOP_H
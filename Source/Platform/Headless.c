@@ -0,0 +1,98 @@
+/**
+ * @file Headless.c
+ * @authors Israfiel
+ * @brief Iridium's headless window backend, for machines with no
+ * compositor. There's no display and no surface, so frames are rendered
+ * offscreen, but the window is otherwise a real one: it has a size and
+ * an input queue, and its frames are paced to a simulated display that
+ * flips on a fixed grid at the configured refresh.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "WindowBackend.h"
+
+#include "Core/Clock.h"
+
+/**
+ * @name CreateHeadless
+ * @authors Israfiel
+ * @brief Open a headless window, which is focused from the start.
+ *
+ * @param window - The window.
+ * @param config - How to create the window.
+ * @returns Always true.
+ */
+static bool CreateHeadless(ir_window_t *window,
+                           const ir_window_config_t *config)
+{
+    (void)config;
+    window->focused = true;
+    return true;
+}
+
+/**
+ * @name DestroyHeadless
+ * @authors Israfiel
+ * @brief There's nothing of the backend's own to free.
+ *
+ * @param window - The window.
+ */
+static void DestroyHeadless(ir_window_t *window)
+{
+    (void)window;
+}
+
+/**
+ * @name SetHeadlessTitle
+ * @authors Israfiel
+ * @brief There's nowhere to show a title.
+ *
+ * @param window - The window.
+ * @param title - The new title.
+ */
+static void SetHeadlessTitle(ir_window_t *window, const char *title)
+{
+    (void)window, (void)title;
+}
+
+/**
+ * @name SubmitHeadlessFrame
+ * @authors Israfiel
+ * @brief Present the frame at the simulated display's next flip, which
+ * is known the moment the frame is submitted.
+ *
+ * @param window - The window.
+ */
+static void SubmitHeadlessFrame(ir_window_t *window)
+{
+    uint64_t flip = Ir_FramePacerPredictVblank(
+        &window->pacer, Ir_ClockMonotonicNanoseconds());
+    Ir_FramePacerPresented(&window->pacer, flip, window->pacer.refresh);
+}
+
+/**
+ * @name HeadlessNative
+ * @authors Israfiel
+ * @brief A headless window has no native objects.
+ *
+ * @param window - The window.
+ * @returns NULL.
+ */
+static void *HeadlessNative(const ir_window_t *window)
+{
+    (void)window;
+    return NULL;
+}
+
+const ir_window_backend_t ir_headless_backend = {
+    .name = "headless",
+    .create = CreateHeadless,
+    .destroy = DestroyHeadless,
+    .set_title = SetHeadlessTitle,
+    .submit_frame = SubmitHeadlessFrame,
+    .native_display = HeadlessNative,
+    .native_surface = HeadlessNative,
+};
@@ -0,0 +1,1357 @@
+/**
+ * @file Wayland.c
+ * @authors Israfiel
+ * @brief Iridium's Wayland window backend. The display connection is
+ * read through wl_display_prepare_read and wl_display_read_events from
+ * the event loop, never wl_display_dispatch, so the frame only ever
+ * handles events that have already arrived. Frames are paced from
+ * wp_presentation feedback when the compositor offers it on the
+ * monotonic clock, and from frame callbacks otherwise. Input from the
+ * first seat is pushed into the window's input queue as it's read.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "WindowBackend.h"
+
+#include "Core/Clock.h"
+#include "Debug/Logger.h"
+
+#include <errno.h>
+#include <presentation-time-client-protocol.h>
+#include <relative-pointer-unstable-v1-client-protocol.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <wayland-client.h>
+#include <xdg-shell-client-protocol.h>
+
+/**
+ * @name ir_wayland_t
+ * @brief The Wayland backend's own state for a window.
+ */
+typedef struct ir_wayland
+{
+    struct wl_display *display;
+    struct wl_registry *registry;
+    struct wl_compositor *compositor;
+    struct xdg_wm_base *shell;
+    struct wl_surface *surface;
+    struct xdg_surface *shell_surface;
+    struct xdg_toplevel *toplevel;
+    struct wp_presentation *presentation;
+    /**
+     * @name presentation_clock
+     * @brief The clock presentation feedback is timed with. Feedback is
+     * only used on the monotonic clock, which the pacer runs on.
+     */
+    uint32_t presentation_clock;
+    struct wl_seat *seat;
+    uint32_t seat_version;
+    struct wl_pointer *pointer;
+    struct wl_keyboard *keyboard;
+    struct wl_touch *touch;
+    struct zwp_relative_pointer_manager_v1 *relative_manager;
+    struct zwp_relative_pointer_v1 *relative_pointer;
+    ir_event_source_t *source;
+    /**
+     * @name pending_width
+     * @brief The width of the configure being negotiated, or zero to
+     * keep the current width.
+     */
+    uint32_t pending_width;
+    /**
+     * @name pending_height
+     * @brief The height of the configure being negotiated, or zero to
+     * keep the current height.
+     */
+    uint32_t pending_height;
+    bool pending_focused;
+    bool configured;
+    /**
+     * @name feedback
+     * @brief The presentation feedback or frame callbacks awaiting the
+     * compositor, oldest first.
+     */
+    void *feedback[IR_FRAME_PACER_IN_FLIGHT];
+    uint32_t feedback_count;
+} ir_wayland_t;
+
+/**
+ * @name UseFeedback
+ * @authors Israfiel
+ * @brief Whether frames get presentation feedback rather than frame
+ * callbacks.
+ *
+ * @param window - The window.
+ * @returns Whether presentation feedback is used.
+ */
+static bool UseFeedback(const ir_window_t *window)
+{
+    ir_wayland_t *wayland = window->data;
+    return wayland->presentation != NULL &&
+           wayland->presentation_clock == CLOCK_MONOTONIC;
+}
+
+/**
+ * @name ForgetFeedback
+ * @authors Israfiel
+ * @brief Stop tracking feedback the compositor has answered.
+ *
+ * @param window - The window.
+ * @param feedback - The answered feedback or frame callback.
+ */
+static void ForgetFeedback(ir_window_t *window, void *feedback)
+{
+    ir_wayland_t *wayland = window->data;
+    for (uint32_t i = 0; i < wayland->feedback_count; ++i)
+    {
+        if (wayland->feedback[i] != feedback) continue;
+        memmove(wayland->feedback + i, wayland->feedback + i + 1,
+                (--wayland->feedback_count - i) * sizeof(void *));
+        return;
+    }
+}
+
+/**
+ * @name HandleSyncOutput
+ * @authors Israfiel
+ * @brief The output a frame was synchronized to; the refresh it
+ * reports alongside the present is all the pacer needs.
+ *
+ * @param data - The window.
+ * @param feedback - The feedback.
+ * @param output - The output.
+ */
+static void HandleSyncOutput(void *data,
+                             struct wp_presentation_feedback *feedback,
+                             struct wl_output *output)
+{
+    (void)data, (void)feedback, (void)output;
+}
+
+/**
+ * @name HandlePresented
+ * @authors Israfiel
+ * @brief Feed a frame's presentation to the pacer.
+ *
+ * @param data - The window.
+ * @param feedback - The feedback.
+ * @param tv_sec_hi - The high half of the presentation's seconds.
+ * @param tv_sec_lo - The low half of the presentation's seconds.
+ * @param tv_nsec - The presentation's nanoseconds.
+ * @param refresh - The output's refresh period, or zero if unknown.
+ * @param seq_hi - The high half of the output's vblank counter.
+ * @param seq_lo - The low half of the output's vblank counter.
+ * @param flags - How the frame was presented.
+ */
+static void HandlePresented(void *data,
+                            struct wp_presentation_feedback *feedback,
+                            uint32_t tv_sec_hi, uint32_t tv_sec_lo,
+                            uint32_t tv_nsec, uint32_t refresh,
+                            uint32_t seq_hi, uint32_t seq_lo,
+                            uint32_t flags)
+{
+    (void)seq_hi, (void)seq_lo, (void)flags;
+    ir_window_t *window = data;
+    uint64_t seconds = ((uint64_t)tv_sec_hi << 32) | tv_sec_lo;
+    Ir_FramePacerPresented(&window->pacer,
+                           seconds * 1000000000ull + tv_nsec, refresh);
+    ForgetFeedback(window, feedback);
+    wp_presentation_feedback_destroy(feedback);
+}
+
+/**
+ * @name HandleDiscarded
+ * @authors Israfiel
+ * @brief Note that a frame was replaced before it was ever shown.
+ *
+ * @param data - The window.
+ * @param feedback - The feedback.
+ */
+static void HandleDiscarded(void *data,
+                            struct wp_presentation_feedback *feedback)
+{
+    ir_window_t *window = data;
+    Ir_FramePacerDiscarded(&window->pacer);
+    ForgetFeedback(window, feedback);
+    wp_presentation_feedback_destroy(feedback);
+}
+
+/**
+ * @name ir_feedback_listener
+ * @brief Listens to a frame's presentation feedback.
+ */
+static const struct wp_presentation_feedback_listener
+    ir_feedback_listener = {
+        .sync_output = HandleSyncOutput,
+        .presented = HandlePresented,
+        .discarded = HandleDiscarded,
+};
+
+/**
+ * @name HandleFrameDone
+ * @authors Israfiel
+ * @brief Without presentation feedback, the frame callback firing is
+ * the best guess at when the frame was shown.
+ *
+ * @param data - The window.
+ * @param callback - The frame callback.
+ * @param time - The callback's timestamp, in milliseconds.
+ */
+static void HandleFrameDone(void *data, struct wl_callback *callback,
+                            uint32_t time)
+{
+    (void)time;
+    ir_window_t *window = data;
+    Ir_FramePacerPresented(&window->pacer, Ir_ClockMonotonicNanoseconds(),
+                           0);
+    ForgetFeedback(window, callback);
+    wl_callback_destroy(callback);
+}
+
+/**
+ * @name ir_frame_listener
+ * @brief Listens to a frame callback.
+ */
+static const struct wl_callback_listener ir_frame_listener = {
+    .done = HandleFrameDone,
+};
+
+/**
+ * @name HandleClockId
+ * @authors Israfiel
+ * @brief Record the clock presentation feedback is timed with.
+ *
+ * @param data - The window.
+ * @param presentation - The presentation global.
+ * @param clock - The clock's ID.
+ */
+static void HandleClockId(void *data, struct wp_presentation *presentation,
+                          uint32_t clock)
+{
+    (void)presentation;
+    ir_window_t *window = data;
+    ir_wayland_t *wayland = window->data;
+    wayland->presentation_clock = clock;
+}
+
+/**
+ * @name ir_presentation_listener
+ * @brief Listens to the presentation global.
+ */
+static const struct wp_presentation_listener ir_presentation_listener = {
+    .clock_id = HandleClockId,
+};
+
+/**
+ * @name MILLISECONDS
+ * @brief Converts a protocol timestamp in milliseconds to nanoseconds.
+ */
+#define MILLISECONDS(time) ((uint64_t)(time) * 1000000ull)
+
+/**
+ * @name HandlePointerEnter
+ * @authors Israfiel
+ * @brief Note that the pointer entered the window.
+ *
+ * @param data - The window.
+ * @param pointer - The pointer.
+ * @param serial - The enter's serial.
+ * @param surface - The surface entered.
+ * @param x - Where the pointer entered, horizontally.
+ * @param y - Where the pointer entered, vertically.
+ */
+static void HandlePointerEnter(void *data, struct wl_pointer *pointer,
+                               uint32_t serial, struct wl_surface *surface,
+                               wl_fixed_t x, wl_fixed_t y)
+{
+    (void)pointer, (void)serial, (void)surface;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input,
+                 &(ir_input_event_t){
+                     .type = IR_INPUT_FOCUS,
+                     .code = 1,
+                     .state = 1,
+                     .x = (float)wl_fixed_to_double(x),
+                     .y = (float)wl_fixed_to_double(y),
+                 });
+}
+
+/**
+ * @name HandlePointerLeave
+ * @authors Israfiel
+ * @brief Note that the pointer left the window.
+ *
+ * @param data - The window.
+ * @param pointer - The pointer.
+ * @param serial - The leave's serial.
+ * @param surface - The surface left.
+ */
+static void HandlePointerLeave(void *data, struct wl_pointer *pointer,
+                               uint32_t serial, struct wl_surface *surface)
+{
+    (void)pointer, (void)serial, (void)surface;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input, &(ir_input_event_t){
+                                     .type = IR_INPUT_FOCUS,
+                                     .code = 1,
+                                 });
+}
+
+/**
+ * @name HandlePointerMotion
+ * @authors Israfiel
+ * @brief Queue the pointer's new position.
+ *
+ * @param data - The window.
+ * @param pointer - The pointer.
+ * @param time - The motion's timestamp, in milliseconds.
+ * @param x - The new horizontal position.
+ * @param y - The new vertical position.
+ */
+static void HandlePointerMotion(void *data, struct wl_pointer *pointer,
+                                uint32_t time, wl_fixed_t x, wl_fixed_t y)
+{
+    (void)pointer;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input,
+                 &(ir_input_event_t){
+                     .type = IR_INPUT_POINTER_MOTION,
+                     .x = (float)wl_fixed_to_double(x),
+                     .y = (float)wl_fixed_to_double(y),
+                     .device_time = MILLISECONDS(time),
+                 });
+}
+
+/**
+ * @name HandlePointerButton
+ * @authors Israfiel
+ * @brief Queue a button press or release.
+ *
+ * @param data - The window.
+ * @param pointer - The pointer.
+ * @param serial - The button's serial.
+ * @param time - The button's timestamp, in milliseconds.
+ * @param button - The evdev button code.
+ * @param state - Whether the button was pressed or released.
+ */
+static void HandlePointerButton(void *data, struct wl_pointer *pointer,
+                                uint32_t serial, uint32_t time,
+                                uint32_t button, uint32_t state)
+{
+    (void)pointer, (void)serial;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input,
+                 &(ir_input_event_t){
+                     .type = IR_INPUT_POINTER_BUTTON,
+                     .code = button,
+                     .state = state == WL_POINTER_BUTTON_STATE_PRESSED,
+                     .device_time = MILLISECONDS(time),
+                 });
+}
+
+/**
+ * @name HandlePointerAxis
+ * @authors Israfiel
+ * @brief Queue a scroll.
+ *
+ * @param data - The window.
+ * @param pointer - The pointer.
+ * @param time - The scroll's timestamp, in milliseconds.
+ * @param axis - The axis scrolled.
+ * @param value - The distance scrolled.
+ */
+static void HandlePointerAxis(void *data, struct wl_pointer *pointer,
+                              uint32_t time, uint32_t axis,
+                              wl_fixed_t value)
+{
+    (void)pointer;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input,
+                 &(ir_input_event_t){
+                     .type = IR_INPUT_POINTER_AXIS,
+                     .code = axis,
+                     .x = (float)wl_fixed_to_double(value),
+                     .device_time = MILLISECONDS(time),
+                 });
+}
+
+/**
+ * @name HandlePointerFrame
+ * @authors Israfiel
+ * @brief Pointer events are queued individually, so the frames that
+ * group them carry nothing we need.
+ *
+ * @param data - The window.
+ * @param pointer - The pointer.
+ */
+static void HandlePointerFrame(void *data, struct wl_pointer *pointer)
+{
+    (void)data, (void)pointer;
+}
+
+/**
+ * @name HandlePointerAxisSource
+ * @authors Israfiel
+ * @brief Scroll sources are ignored.
+ *
+ * @param data - The window.
+ * @param pointer - The pointer.
+ * @param source - The scroll's source.
+ */
+static void HandlePointerAxisSource(void *data, struct wl_pointer *pointer,
+                                    uint32_t source)
+{
+    (void)data, (void)pointer, (void)source;
+}
+
+/**
+ * @name HandlePointerAxisStop
+ * @authors Israfiel
+ * @brief Kinetic scroll stops are ignored.
+ *
+ * @param data - The window.
+ * @param pointer - The pointer.
+ * @param time - The stop's timestamp, in milliseconds.
+ * @param axis - The axis that stopped.
+ */
+static void HandlePointerAxisStop(void *data, struct wl_pointer *pointer,
+                                  uint32_t time, uint32_t axis)
+{
+    (void)data, (void)pointer, (void)time, (void)axis;
+}
+
+/**
+ * @name HandlePointerAxisDiscrete
+ * @authors Israfiel
+ * @brief Wheel clicks are ignored; the continuous distance that follows
+ * is queued instead.
+ *
+ * @param data - The window.
+ * @param pointer - The pointer.
+ * @param axis - The axis scrolled.
+ * @param discrete - The number of wheel clicks.
+ */
+static void HandlePointerAxisDiscrete(void *data,
+                                      struct wl_pointer *pointer,
+                                      uint32_t axis, int32_t discrete)
+{
+    (void)data, (void)pointer, (void)axis, (void)discrete;
+}
+
+/**
+ * @name ir_pointer_listener
+ * @brief Listens to the seat's pointer, up to version 5.
+ */
+static const struct wl_pointer_listener ir_pointer_listener = {
+    .enter = HandlePointerEnter,
+    .leave = HandlePointerLeave,
+    .motion = HandlePointerMotion,
+    .button = HandlePointerButton,
+    .axis = HandlePointerAxis,
+    .frame = HandlePointerFrame,
+    .axis_source = HandlePointerAxisSource,
+    .axis_stop = HandlePointerAxisStop,
+    .axis_discrete = HandlePointerAxisDiscrete,
+};
+
+/**
+ * @name HandleRelativeMotion
+ * @authors Israfiel
+ * @brief Queue the pointer device's raw movement, which keeps coming
+ * when the pointer is stuck against the edge of the screen.
+ *
+ * @param data - The window.
+ * @param pointer - The relative pointer.
+ * @param utime_hi - The high half of the timestamp, in microseconds.
+ * @param utime_lo - The low half of the timestamp, in microseconds.
+ * @param dx - The accelerated horizontal movement.
+ * @param dy - The accelerated vertical movement.
+ * @param dx_raw - The unaccelerated horizontal movement.
+ * @param dy_raw - The unaccelerated vertical movement.
+ */
+static void HandleRelativeMotion(void *data,
+                                 struct zwp_relative_pointer_v1 *pointer,
+                                 uint32_t utime_hi, uint32_t utime_lo,
+                                 wl_fixed_t dx, wl_fixed_t dy,
+                                 wl_fixed_t dx_raw, wl_fixed_t dy_raw)
+{
+    (void)pointer;
+    ir_window_t *window = data;
+    uint64_t microseconds = ((uint64_t)utime_hi << 32) | utime_lo;
+    Ir_InputPush(&window->input,
+                 &(ir_input_event_t){
+                     .type = IR_INPUT_POINTER_RELATIVE,
+                     .dx = (float)wl_fixed_to_double(dx),
+                     .dy = (float)wl_fixed_to_double(dy),
+                     .raw_dx = (float)wl_fixed_to_double(dx_raw),
+                     .raw_dy = (float)wl_fixed_to_double(dy_raw),
+                     .device_time = microseconds * 1000,
+                 });
+}
+
+/**
+ * @name ir_relative_pointer_listener
+ * @brief Listens to the relative pointer.
+ */
+static const struct zwp_relative_pointer_v1_listener
+    ir_relative_pointer_listener = {
+        .relative_motion = HandleRelativeMotion,
+};
+
+/**
+ * @name HandleKeymap
+ * @authors Israfiel
+ * @brief Keys are queued as raw keycodes, so the keymap is unneeded.
+ *
+ * @param data - The window.
+ * @param keyboard - The keyboard.
+ * @param format - The keymap's format.
+ * @param fd - The keymap's file, which we own.
+ * @param size - The keymap's size.
+ */
+static void HandleKeymap(void *data, struct wl_keyboard *keyboard,
+                         uint32_t format, int32_t fd, uint32_t size)
+{
+    (void)data, (void)keyboard, (void)format, (void)size;
+    close(fd);
+}
+
+/**
+ * @name HandleKeyboardEnter
+ * @authors Israfiel
+ * @brief Note that the window gained keyboard focus.
+ *
+ * @param data - The window.
+ * @param keyboard - The keyboard.
+ * @param serial - The enter's serial.
+ * @param surface - The surface focused.
+ * @param keys - The keys already held.
+ */
+static void HandleKeyboardEnter(void *data, struct wl_keyboard *keyboard,
+                                uint32_t serial,
+                                struct wl_surface *surface,
+                                struct wl_array *keys)
+{
+    (void)keyboard, (void)serial, (void)surface, (void)keys;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input, &(ir_input_event_t){
+                                     .type = IR_INPUT_FOCUS,
+                                     .state = 1,
+                                 });
+}
+
+/**
+ * @name HandleKeyboardLeave
+ * @authors Israfiel
+ * @brief Note that the window lost keyboard focus.
+ *
+ * @param data - The window.
+ * @param keyboard - The keyboard.
+ * @param serial - The leave's serial.
+ * @param surface - The surface unfocused.
+ */
+static void HandleKeyboardLeave(void *data, struct wl_keyboard *keyboard,
+                                uint32_t serial,
+                                struct wl_surface *surface)
+{
+    (void)keyboard, (void)serial, (void)surface;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input,
+                 &(ir_input_event_t){.type = IR_INPUT_FOCUS});
+}
+
+/**
+ * @name HandleKey
+ * @authors Israfiel
+ * @brief Queue a key press or release.
+ *
+ * @param data - The window.
+ * @param keyboard - The keyboard.
+ * @param serial - The key's serial.
+ * @param time - The key's timestamp, in milliseconds.
+ * @param key - The evdev keycode.
+ * @param state - Whether the key was pressed or released.
+ */
+static void HandleKey(void *data, struct wl_keyboard *keyboard,
+                      uint32_t serial, uint32_t time, uint32_t key,
+                      uint32_t state)
+{
+    (void)keyboard, (void)serial;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input,
+                 &(ir_input_event_t){
+                     .type = IR_INPUT_KEY,
+                     .code = key,
+                     .state = state == WL_KEYBOARD_KEY_STATE_PRESSED,
+                     .device_time = MILLISECONDS(time),
+                 });
+}
+
+/**
+ * @name HandleModifiers
+ * @authors Israfiel
+ * @brief Queue the keyboard's new modifier state.
+ *
+ * @param data - The window.
+ * @param keyboard - The keyboard.
+ * @param serial - The change's serial.
+ * @param depressed - The held modifiers.
+ * @param latched - The latched modifiers.
+ * @param locked - The locked modifiers.
+ * @param group - The keyboard layout.
+ */
+static void HandleModifiers(void *data, struct wl_keyboard *keyboard,
+                            uint32_t serial, uint32_t depressed,
+                            uint32_t latched, uint32_t locked,
+                            uint32_t group)
+{
+    (void)keyboard, (void)serial, (void)group;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input, &(ir_input_event_t){
+                                     .type = IR_INPUT_MODIFIERS,
+                                     .code = depressed | latched,
+                                     .state = locked,
+                                 });
+}
+
+/**
+ * @name HandleRepeatInfo
+ * @authors Israfiel
+ * @brief Key repeat is left to the game.
+ *
+ * @param data - The window.
+ * @param keyboard - The keyboard.
+ * @param rate - Repeats per second.
+ * @param delay - The delay before repeating, in milliseconds.
+ */
+static void HandleRepeatInfo(void *data, struct wl_keyboard *keyboard,
+                             int32_t rate, int32_t delay)
+{
+    (void)data, (void)keyboard, (void)rate, (void)delay;
+}
+
+/**
+ * @name ir_keyboard_listener
+ * @brief Listens to the seat's keyboard.
+ */
+static const struct wl_keyboard_listener ir_keyboard_listener = {
+    .keymap = HandleKeymap,
+    .enter = HandleKeyboardEnter,
+    .leave = HandleKeyboardLeave,
+    .key = HandleKey,
+    .modifiers = HandleModifiers,
+    .repeat_info = HandleRepeatInfo,
+};
+
+/**
+ * @name HandleTouchDown
+ * @authors Israfiel
+ * @brief Queue a new touch point.
+ *
+ * @param data - The window.
+ * @param touch - The touch device.
+ * @param serial - The touch's serial.
+ * @param time - The touch's timestamp, in milliseconds.
+ * @param surface - The surface touched.
+ * @param id - The touch point's ID.
+ * @param x - Where the point went down, horizontally.
+ * @param y - Where the point went down, vertically.
+ */
+static void HandleTouchDown(void *data, struct wl_touch *touch,
+                            uint32_t serial, uint32_t time,
+                            struct wl_surface *surface, int32_t id,
+                            wl_fixed_t x, wl_fixed_t y)
+{
+    (void)touch, (void)serial, (void)surface;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input,
+                 &(ir_input_event_t){
+                     .type = IR_INPUT_TOUCH_DOWN,
+                     .code = (uint32_t)id,
+                     .x = (float)wl_fixed_to_double(x),
+                     .y = (float)wl_fixed_to_double(y),
+                     .device_time = MILLISECONDS(time),
+                 });
+}
+
+/**
+ * @name HandleTouchUp
+ * @authors Israfiel
+ * @brief Queue a lifted touch point.
+ *
+ * @param data - The window.
+ * @param touch - The touch device.
+ * @param serial - The lift's serial.
+ * @param time - The lift's timestamp, in milliseconds.
+ * @param id - The touch point's ID.
+ */
+static void HandleTouchUp(void *data, struct wl_touch *touch,
+                          uint32_t serial, uint32_t time, int32_t id)
+{
+    (void)touch, (void)serial;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input, &(ir_input_event_t){
+                                     .type = IR_INPUT_TOUCH_UP,
+                                     .code = (uint32_t)id,
+                                     .device_time = MILLISECONDS(time),
+                                 });
+}
+
+/**
+ * @name HandleTouchMotion
+ * @authors Israfiel
+ * @brief Queue a touch point's movement.
+ *
+ * @param data - The window.
+ * @param touch - The touch device.
+ * @param time - The movement's timestamp, in milliseconds.
+ * @param id - The touch point's ID.
+ * @param x - The point's new horizontal position.
+ * @param y - The point's new vertical position.
+ */
+static void HandleTouchMotion(void *data, struct wl_touch *touch,
+                              uint32_t time, int32_t id, wl_fixed_t x,
+                              wl_fixed_t y)
+{
+    (void)touch;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input,
+                 &(ir_input_event_t){
+                     .type = IR_INPUT_TOUCH_MOTION,
+                     .code = (uint32_t)id,
+                     .x = (float)wl_fixed_to_double(x),
+                     .y = (float)wl_fixed_to_double(y),
+                     .device_time = MILLISECONDS(time),
+                 });
+}
+
+/**
+ * @name HandleTouchFrame
+ * @authors Israfiel
+ * @brief Touch events are queued individually, so the frames that
+ * group them carry nothing we need.
+ *
+ * @param data - The window.
+ * @param touch - The touch device.
+ */
+static void HandleTouchFrame(void *data, struct wl_touch *touch)
+{
+    (void)data, (void)touch;
+}
+
+/**
+ * @name HandleTouchCancel
+ * @authors Israfiel
+ * @brief Queue the compositor taking over every touch point.
+ *
+ * @param data - The window.
+ * @param touch - The touch device.
+ */
+static void HandleTouchCancel(void *data, struct wl_touch *touch)
+{
+    (void)touch;
+    ir_window_t *window = data;
+    Ir_InputPush(&window->input,
+                 &(ir_input_event_t){.type = IR_INPUT_TOUCH_CANCEL});
+}
+
+/**
+ * @name ir_touch_listener
+ * @brief Listens to the seat's touch device, up to version 5.
+ */
+static const struct wl_touch_listener ir_touch_listener = {
+    .down = HandleTouchDown,
+    .up = HandleTouchUp,
+    .motion = HandleTouchMotion,
+    .frame = HandleTouchFrame,
+    .cancel = HandleTouchCancel,
+};
+
+/**
+ * @name ReleasePointer
+ * @authors Israfiel
+ * @brief Let go of the seat's pointer.
+ *
+ * @param window - The window.
+ */
+static void ReleasePointer(ir_window_t *window)
+{
+    ir_wayland_t *wayland = window->data;
+    if (wayland->relative_pointer != NULL)
+        zwp_relative_pointer_v1_destroy(wayland->relative_pointer);
+    wayland->relative_pointer = NULL;
+    if (wayland->seat_version >= 3) wl_pointer_release(wayland->pointer);
+    else wl_pointer_destroy(wayland->pointer);
+    wayland->pointer = NULL;
+}
+
+/**
+ * @name ReleaseKeyboard
+ * @authors Israfiel
+ * @brief Let go of the seat's keyboard.
+ *
+ * @param window - The window.
+ */
+static void ReleaseKeyboard(ir_window_t *window)
+{
+    ir_wayland_t *wayland = window->data;
+    if (wayland->seat_version >= 3) wl_keyboard_release(wayland->keyboard);
+    else wl_keyboard_destroy(wayland->keyboard);
+    wayland->keyboard = NULL;
+}
+
+/**
+ * @name ReleaseTouch
+ * @authors Israfiel
+ * @brief Let go of the seat's touch device.
+ *
+ * @param window - The window.
+ */
+static void ReleaseTouch(ir_window_t *window)
+{
+    ir_wayland_t *wayland = window->data;
+    if (wayland->seat_version >= 3) wl_touch_release(wayland->touch);
+    else wl_touch_destroy(wayland->touch);
+    wayland->touch = NULL;
+}
+
+/**
+ * @name HandleCapabilities
+ * @authors Israfiel
+ * @brief Pick up or let go of input devices as the seat gains or loses
+ * them.
+ *
+ * @param data - The window.
+ * @param seat - The seat.
+ * @param capabilities - The devices the seat now has.
+ */
+static void HandleCapabilities(void *data, struct wl_seat *seat,
+                               uint32_t capabilities)
+{
+    ir_window_t *window = data;
+    ir_wayland_t *wayland = window->data;
+    bool pointer = capabilities & WL_SEAT_CAPABILITY_POINTER;
+    if (pointer && wayland->pointer == NULL)
+    {
+        wayland->pointer = wl_seat_get_pointer(seat);
+        wl_pointer_add_listener(wayland->pointer, &ir_pointer_listener,
+                                window);
+        if (wayland->relative_manager != NULL)
+        {
+            wayland->relative_pointer =
+                zwp_relative_pointer_manager_v1_get_relative_pointer(
+                    wayland->relative_manager, wayland->pointer);
+            zwp_relative_pointer_v1_add_listener(
+                wayland->relative_pointer, &ir_relative_pointer_listener,
+                window);
+        }
+    }
+    else if (!pointer && wayland->pointer != NULL) ReleasePointer(window);
+
+    bool keyboard = capabilities & WL_SEAT_CAPABILITY_KEYBOARD;
+    if (keyboard && wayland->keyboard == NULL)
+    {
+        wayland->keyboard = wl_seat_get_keyboard(seat);
+        wl_keyboard_add_listener(wayland->keyboard, &ir_keyboard_listener,
+                                 window);
+    }
+    else if (!keyboard && wayland->keyboard != NULL)
+        ReleaseKeyboard(window);
+
+    bool touch = capabilities & WL_SEAT_CAPABILITY_TOUCH;
+    if (touch && wayland->touch == NULL)
+    {
+        wayland->touch = wl_seat_get_touch(seat);
+        wl_touch_add_listener(wayland->touch, &ir_touch_listener, window);
+    }
+    else if (!touch && wayland->touch != NULL) ReleaseTouch(window);
+}
+
+/**
+ * @name HandleSeatName
+ * @authors Israfiel
+ * @brief Only one seat is used, so its name doesn't matter.
+ *
+ * @param data - The window.
+ * @param seat - The seat.
+ * @param name - The seat's name.
+ */
+static void HandleSeatName(void *data, struct wl_seat *seat,
+                           const char *name)
+{
+    (void)data, (void)seat, (void)name;
+}
+
+/**
+ * @name ir_seat_listener
+ * @brief Listens to the seat.
+ */
+static const struct wl_seat_listener ir_seat_listener = {
+    .capabilities = HandleCapabilities,
+    .name = HandleSeatName,
+};
+
+/**
+ * @name HandlePing
+ * @authors Israfiel
+ * @brief Answer the compositor's liveness check.
+ *
+ * @param data - The window.
+ * @param shell - The shell.
+ * @param serial - The ping's serial.
+ */
+static void HandlePing(void *data, struct xdg_wm_base *shell,
+                       uint32_t serial)
+{
+    (void)data;
+    xdg_wm_base_pong(shell, serial);
+}
+
+/**
+ * @name ir_shell_listener
+ * @brief Listens to the xdg shell.
+ */
+static const struct xdg_wm_base_listener ir_shell_listener = {
+    .ping = HandlePing,
+};
+
+/**
+ * @name HandleSurfaceConfigure
+ * @authors Israfiel
+ * @brief Apply the configure the toplevel negotiated.
+ *
+ * @param data - The window.
+ * @param shell_surface - The xdg surface.
+ * @param serial - The configure's serial.
+ */
+static void HandleSurfaceConfigure(void *data,
+                                   struct xdg_surface *shell_surface,
+                                   uint32_t serial)
+{
+    ir_window_t *window = data;
+    ir_wayland_t *wayland = window->data;
+    xdg_surface_ack_configure(shell_surface, serial);
+    wayland->configured = true;
+
+    uint32_t width = wayland->pending_width ? wayland->pending_width
+                                            : window->width;
+    uint32_t height = wayland->pending_height ? wayland->pending_height
+                                              : window->height;
+    if (width != window->width || height != window->height)
+    {
+        window->width = width;
+        window->height = height;
+        Ir_WindowPushEvent(window, (ir_window_event_t){
+                                       .type = IR_WINDOW_EVENT_RESIZE,
+                                       .width = width,
+                                       .height = height,
+                                   });
+    }
+
+    if (wayland->pending_focused != window->focused)
+    {
+        window->focused = wayland->pending_focused;
+        Ir_WindowPushEvent(window, (ir_window_event_t){
+                                       .type = IR_WINDOW_EVENT_FOCUS,
+                                       .focused = window->focused,
+                                   });
+    }
+}
+
+/**
+ * @name ir_shell_surface_listener
+ * @brief Listens to the window's xdg surface.
+ */
+static const struct xdg_surface_listener ir_shell_surface_listener = {
+    .configure = HandleSurfaceConfigure,
+};
+
+/**
+ * @name HandleToplevelConfigure
+ * @authors Israfiel
+ * @brief Record the size and state the compositor proposes. Applied
+ * when the surface configure that follows arrives.
+ *
+ * @param data - The window.
+ * @param toplevel - The toplevel.
+ * @param width - The proposed width, or zero to let us choose.
+ * @param height - The proposed height, or zero to let us choose.
+ * @param states - The toplevel's states.
+ */
+static void HandleToplevelConfigure(void *data,
+                                    struct xdg_toplevel *toplevel,
+                                    int32_t width, int32_t height,
+                                    struct wl_array *states)
+{
+    (void)toplevel;
+    ir_window_t *window = data;
+    ir_wayland_t *wayland = window->data;
+    wayland->pending_width = width > 0 ? (uint32_t)width : 0;
+    wayland->pending_height = height > 0 ? (uint32_t)height : 0;
+
+    wayland->pending_focused = false;
+    const uint32_t *state = states->data;
+    for (size_t i = 0; i < states->size / sizeof(uint32_t); ++i)
+        if (state[i] == XDG_TOPLEVEL_STATE_ACTIVATED)
+            wayland->pending_focused = true;
+}
+
+/**
+ * @name HandleToplevelClose
+ * @authors Israfiel
+ * @brief Note that the user asked to close the window.
+ *
+ * @param data - The window.
+ * @param toplevel - The toplevel.
+ */
+static void HandleToplevelClose(void *data, struct xdg_toplevel *toplevel)
+{
+    (void)toplevel;
+    Ir_WindowClose(data);
+}
+
+/**
+ * @name ir_toplevel_listener
+ * @brief Listens to the window's toplevel. Only version 1 is bound, so
+ * the later events never arrive.
+ */
+static const struct xdg_toplevel_listener ir_toplevel_listener = {
+    .configure = HandleToplevelConfigure,
+    .close = HandleToplevelClose,
+};
+
+/**
+ * @name HandleGlobal
+ * @authors Israfiel
+ * @brief Bind the globals the window needs as they're announced.
+ *
+ * @param data - The window.
+ * @param registry - The registry.
+ * @param name - The global's name.
+ * @param interface - The global's interface.
+ * @param version - The global's version.
+ */
+static void HandleGlobal(void *data, struct wl_registry *registry,
+                         uint32_t name, const char *interface,
+                         uint32_t version)
+{
+    ir_window_t *window = data;
+    ir_wayland_t *wayland = window->data;
+    if (strcmp(interface, wl_compositor_interface.name) == 0)
+        wayland->compositor = wl_registry_bind(
+            registry, name, &wl_compositor_interface,
+            version < 4 ? version : 4);
+    else if (strcmp(interface, xdg_wm_base_interface.name) == 0)
+    {
+        wayland->shell =
+            wl_registry_bind(registry, name, &xdg_wm_base_interface, 1);
+        xdg_wm_base_add_listener(wayland->shell, &ir_shell_listener,
+                                 window);
+    }
+    else if (strcmp(interface, wp_presentation_interface.name) == 0)
+    {
+        wayland->presentation = wl_registry_bind(
+            registry, name, &wp_presentation_interface, 1);
+        wp_presentation_add_listener(wayland->presentation,
+                                     &ir_presentation_listener, window);
+    }
+    else if (strcmp(interface, wl_seat_interface.name) == 0 &&
+             wayland->seat == NULL)
+    {
+        wayland->seat_version = version < 5 ? version : 5;
+        wayland->seat = wl_registry_bind(
+            registry, name, &wl_seat_interface, wayland->seat_version);
+        wl_seat_add_listener(wayland->seat, &ir_seat_listener, window);
+    }
+    else if (strcmp(interface,
+                    zwp_relative_pointer_manager_v1_interface.name) == 0)
+        wayland->relative_manager = wl_registry_bind(
+            registry, name, &zwp_relative_pointer_manager_v1_interface, 1);
+}
+
+/**
+ * @name HandleGlobalRemove
+ * @authors Israfiel
+ * @brief Globals the window relies on are never removed in practice.
+ *
+ * @param data - The window.
+ * @param registry - The registry.
+ * @param name - The removed global's name.
+ */
+static void HandleGlobalRemove(void *data, struct wl_registry *registry,
+                               uint32_t name)
+{
+    (void)data, (void)registry, (void)name;
+}
+
+/**
+ * @name ir_registry_listener
+ * @brief Listens to the display's registry.
+ */
+static const struct wl_registry_listener ir_registry_listener = {
+    .global = HandleGlobal,
+    .global_remove = HandleGlobalRemove,
+};
+
+/**
+ * @name PrepareDisplay
+ * @authors Israfiel
+ * @brief Announce our intent to read the display and flush our
+ * requests before the loop waits.
+ *
+ * @param user - The window.
+ * @returns The events to wait for.
+ */
+static uint32_t PrepareDisplay(void *user)
+{
+    ir_window_t *window = user;
+    ir_wayland_t *wayland = window->data;
+    while (wl_display_prepare_read(wayland->display) != 0)
+        wl_display_dispatch_pending(wayland->display);
+
+    // A full socket has to drain before the rest can go out.
+    if (wl_display_flush(wayland->display) == -1 && errno == EAGAIN)
+        return IR_EVENT_READABLE | IR_EVENT_WRITABLE;
+    return IR_EVENT_READABLE;
+}
+
+/**
+ * @name DispatchDisplay
+ * @authors Israfiel
+ * @brief Read whatever arrived, or cancel the prepared read, then run
+ * the handlers of every queued event.
+ *
+ * @param user - The window.
+ * @param events - The display's ready events.
+ */
+static void DispatchDisplay(void *user, uint32_t events)
+{
+    ir_window_t *window = user;
+    ir_wayland_t *wayland = window->data;
+    if (events & IR_EVENT_READABLE)
+    {
+        if (wl_display_read_events(wayland->display) == -1)
+            events |= IR_EVENT_ERROR;
+    }
+    else wl_display_cancel_read(wayland->display);
+
+    if (wl_display_dispatch_pending(wayland->display) == -1)
+        events |= IR_EVENT_ERROR;
+
+    if ((events & IR_EVENT_ERROR) && !window->closed)
+    {
+        IR_LOG_ERROR("Lost the Wayland display: %s.",
+                     strerror(wl_display_get_error(wayland->display)));
+        Ir_WindowClose(window);
+    }
+}
+
+/**
+ * @name DestroyWayland
+ * @authors Israfiel
+ * @brief Let go of everything the window took from the compositor and
+ * disconnect. Copes with a window only partly created.
+ *
+ * @param window - The window.
+ */
+static void DestroyWayland(ir_window_t *window)
+{
+    ir_wayland_t *wayland = window->data;
+    if (wayland->source != NULL)
+        Ir_EventLoopRemove(window->loop, wayland->source);
+    for (uint32_t i = 0; i < wayland->feedback_count; ++i)
+    {
+        if (UseFeedback(window))
+            wp_presentation_feedback_destroy(wayland->feedback[i]);
+        else wl_callback_destroy(wayland->feedback[i]);
+    }
+    if (wayland->presentation != NULL)
+        wp_presentation_destroy(wayland->presentation);
+    if (wayland->pointer != NULL) ReleasePointer(window);
+    if (wayland->keyboard != NULL) ReleaseKeyboard(window);
+    if (wayland->touch != NULL) ReleaseTouch(window);
+    if (wayland->relative_manager != NULL)
+        zwp_relative_pointer_manager_v1_destroy(wayland->relative_manager);
+    if (wayland->seat != NULL)
+    {
+        if (wayland->seat_version >= 5) wl_seat_release(wayland->seat);
+        else wl_seat_destroy(wayland->seat);
+    }
+    if (wayland->toplevel != NULL) xdg_toplevel_destroy(wayland->toplevel);
+    if (wayland->shell_surface != NULL)
+        xdg_surface_destroy(wayland->shell_surface);
+    if (wayland->surface != NULL) wl_surface_destroy(wayland->surface);
+    if (wayland->shell != NULL) xdg_wm_base_destroy(wayland->shell);
+    if (wayland->compositor != NULL)
+        wl_compositor_destroy(wayland->compositor);
+    if (wayland->registry != NULL) wl_registry_destroy(wayland->registry);
+    wl_display_disconnect(wayland->display);
+    free(wayland);
+}
+
+/**
+ * @name CreateWayland
+ * @authors Israfiel
+ * @brief Connect to the compositor and open a window. Blocks until the
+ * compositor has configured it.
+ *
+ * @param window - The window.
+ * @param config - How to create the window.
+ * @returns Whether the window was opened.
+ */
+static bool CreateWayland(ir_window_t *window,
+                          const ir_window_config_t *config)
+{
+    ir_wayland_t *wayland = calloc(1, sizeof(ir_wayland_t));
+    if (wayland == NULL) return false;
+    window->data = wayland;
+    // The clock ID is sent right after binding; this can't be mistaken
+    // for it, since CLOCK_REALTIME is zero.
+    wayland->presentation_clock = UINT32_MAX;
+
+    wayland->display = wl_display_connect(NULL);
+    if (wayland->display == NULL)
+    {
+        IR_LOG_ERROR("Failed to connect to the Wayland display.");
+        free(wayland);
+        return false;
+    }
+
+    wayland->registry = wl_display_get_registry(wayland->display);
+    wl_registry_add_listener(wayland->registry, &ir_registry_listener,
+                             window);
+    wl_display_roundtrip(wayland->display);
+    if (wayland->compositor == NULL || wayland->shell == NULL)
+    {
+        IR_LOG_ERROR("The compositor lacks wl_compositor or xdg_wm_base.");
+        DestroyWayland(window);
+        return false;
+    }
+    // The presentation clock has to be known before the first frame,
+    // since it decides what kind of feedback every frame asks for. The
+    // same trip picks up the seat's devices.
+    if (wayland->presentation != NULL || wayland->seat != NULL)
+        wl_display_roundtrip(wayland->display);
+
+    wayland->surface = wl_compositor_create_surface(wayland->compositor);
+    wayland->shell_surface =
+        xdg_wm_base_get_xdg_surface(wayland->shell, wayland->surface);
+    xdg_surface_add_listener(wayland->shell_surface,
+                             &ir_shell_surface_listener, window);
+    wayland->toplevel = xdg_surface_get_toplevel(wayland->shell_surface);
+    xdg_toplevel_add_listener(wayland->toplevel, &ir_toplevel_listener,
+                              window);
+    xdg_toplevel_set_title(wayland->toplevel, config->title);
+    xdg_toplevel_set_app_id(wayland->toplevel, config->app_id);
+    wl_surface_commit(wayland->surface);
+
+    // The surface can't be drawn to until its first configure.
+    while (!wayland->configured)
+    {
+        if (wl_display_dispatch(wayland->display) == -1)
+        {
+            IR_LOG_ERROR("Lost the Wayland display while configuring.");
+            DestroyWayland(window);
+            return false;
+        }
+    }
+
+    wayland->source = Ir_EventLoopAddDescriptor(
+        window->loop, wl_display_get_fd(wayland->display),
+        IR_EVENT_READABLE, PrepareDisplay, DispatchDisplay, window);
+    if (wayland->source == NULL)
+    {
+        IR_LOG_ERROR("Failed to add the Wayland display to the loop.");
+        DestroyWayland(window);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @name SetWaylandTitle
+ * @authors Israfiel
+ * @brief Change the toplevel's title.
+ *
+ * @param window - The window.
+ * @param title - The new title.
+ */
+static void SetWaylandTitle(ir_window_t *window, const char *title)
+{
+    ir_wayland_t *wayland = window->data;
+    xdg_toplevel_set_title(wayland->toplevel, title);
+}
+
+/**
+ * @name SubmitWaylandFrame
+ * @authors Israfiel
+ * @brief Ask for presentation feedback on the surface's next commit,
+ * or a frame callback without it.
+ *
+ * @param window - The window.
+ */
+static void SubmitWaylandFrame(ir_window_t *window)
+{
+    ir_wayland_t *wayland = window->data;
+    // Past the in-flight limit the compositor has stopped answering,
+    // likely because the window is hidden; the pacer copes on its own.
+    if (wayland->feedback_count == IR_FRAME_PACER_IN_FLIGHT) return;
+
+    void *feedback;
+    if (UseFeedback(window))
+    {
+        feedback = wp_presentation_feedback(wayland->presentation,
+                                            wayland->surface);
+        wp_presentation_feedback_add_listener(
+            feedback, &ir_feedback_listener, window);
+    }
+    else
+    {
+        feedback = wl_surface_frame(wayland->surface);
+        wl_callback_add_listener(feedback, &ir_frame_listener, window);
+    }
+    wayland->feedback[wayland->feedback_count++] = feedback;
+}
+
+/**
+ * @name WaylandDisplay
+ * @authors Israfiel
+ * @brief Get the window's wl_display.
+ *
+ * @param window - The window.
+ * @returns The display.
+ */
+static void *WaylandDisplay(const ir_window_t *window)
+{
+    ir_wayland_t *wayland = window->data;
+    return wayland->display;
+}
+
+/**
+ * @name WaylandSurface
+ * @authors Israfiel
+ * @brief Get the window's wl_surface.
+ *
+ * @param window - The window.
+ * @returns The surface.
+ */
+static void *WaylandSurface(const ir_window_t *window)
+{
+    ir_wayland_t *wayland = window->data;
+    return wayland->surface;
+}
+
+const ir_window_backend_t ir_wayland_backend = {
+    .name = "wayland",
+    .create = CreateWayland,
+    .destroy = DestroyWayland,
+    .set_title = SetWaylandTitle,
+    .submit_frame = SubmitWaylandFrame,
+    .native_display = WaylandDisplay,
+    .native_surface = WaylandSurface,
+};
@@ -0,0 +1,189 @@
+/**
+ * @file Window.c
+ * @authors Israfiel
+ * @brief Implements the backend-independent half of Iridium's windows:
+ * picking a backend, the event queue, pacing, and input.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "WindowBackend.h"
+
+#include "Core/Clock.h"
+#include "Debug/Logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name DEFAULT_REFRESH
+ * @brief The refresh period assumed when the config gives none, 60 Hz.
+ */
+#define DEFAULT_REFRESH 16666667ull
+
+/**
+ * @name ir_window_backends
+ * @brief Every backend built in, indexed by ir_window_backend_type_t.
+ */
+static const ir_window_backend_t *const ir_window_backends[] = {
+#ifdef IRIDIUM_WAYLAND
+    [IR_WINDOW_BACKEND_WAYLAND] = &ir_wayland_backend,
+#endif
+    [IR_WINDOW_BACKEND_HEADLESS] = &ir_headless_backend,
+};
+
+/**
+ * @name ChooseBackend
+ * @authors Israfiel
+ * @brief Resolve the backend a window asked for. IRIDIUM_WINDOW_BACKEND
+ * overrides the default; otherwise Wayland is used if there's a
+ * compositor to talk to, and the headless backend if not.
+ *
+ * @param type - The backend the config asked for.
+ * @returns The backend, or NULL if it wasn't built in.
+ */
+static const ir_window_backend_t *ChooseBackend(
+    ir_window_backend_type_t type)
+{
+    if (type == IR_WINDOW_BACKEND_DEFAULT)
+    {
+        const char *name = getenv("IRIDIUM_WINDOW_BACKEND");
+        if (name != NULL)
+        {
+            for (size_t i = 0; i < IR_WINDOW_BACKEND_COUNT; ++i)
+                if (ir_window_backends[i] != NULL &&
+                    strcmp(ir_window_backends[i]->name, name) == 0)
+                    return ir_window_backends[i];
+            IR_LOG_ERROR("Unknown window backend '%s'.", name);
+            return NULL;
+        }
+
+        type = IR_WINDOW_BACKEND_HEADLESS;
+        if (getenv("WAYLAND_DISPLAY") != NULL ||
+            getenv("WAYLAND_SOCKET") != NULL)
+            type = IR_WINDOW_BACKEND_WAYLAND;
+    }
+
+    if (ir_window_backends[type] == NULL)
+        IR_LOG_ERROR("Window backend %u isn't built in.", (unsigned)type);
+    return ir_window_backends[type];
+}
+
+ir_window_t *Ir_WindowCreate(const ir_window_config_t *config,
+                             ir_event_loop_t *loop)
+{
+    const ir_window_backend_t *backend = ChooseBackend(config->backend);
+    if (backend == NULL) return NULL;
+
+    // The input queue's indices are cache-line aligned.
+    ir_window_t *window =
+        aligned_alloc(alignof(ir_window_t), sizeof(ir_window_t));
+    if (window == NULL) return NULL;
+    memset(window, 0, sizeof(ir_window_t));
+    window->backend = backend;
+    window->loop = loop;
+    window->width = config->width;
+    window->height = config->height;
+    Ir_FramePacerReset(&window->pacer, config->refresh ? config->refresh
+                                                       : DEFAULT_REFRESH);
+    Ir_InputQueueInit(&window->input);
+
+    if (!backend->create(window, config))
+    {
+        free(window);
+        return NULL;
+    }
+    return window;
+}
+
+void Ir_WindowDestroy(ir_window_t *window)
+{
+    window->backend->destroy(window);
+    free(window);
+}
+
+void Ir_WindowPushEvent(ir_window_t *window, ir_window_event_t event)
+{
+    event.time = Ir_ClockMonotonicNanoseconds();
+    if (window->event_count == IR_WINDOW_EVENT_QUEUE)
+    {
+        window->event_head =
+            (window->event_head + 1) % IR_WINDOW_EVENT_QUEUE;
+        window->event_count--;
+    }
+    window->events[(window->event_head + window->event_count++) %
+                   IR_WINDOW_EVENT_QUEUE] = event;
+}
+
+bool Ir_WindowNextEvent(ir_window_t *window, ir_window_event_t *event)
+{
+    if (window->event_count == 0) return false;
+    *event = window->events[window->event_head];
+    window->event_head = (window->event_head + 1) % IR_WINDOW_EVENT_QUEUE;
+    window->event_count--;
+    return true;
+}
+
+bool Ir_WindowShouldClose(const ir_window_t *window)
+{
+    return window->closed;
+}
+
+void Ir_WindowClose(ir_window_t *window)
+{
+    if (window->closed) return;
+    window->closed = true;
+    Ir_WindowPushEvent(window,
+                       (ir_window_event_t){.type = IR_WINDOW_EVENT_CLOSE});
+}
+
+void Ir_WindowGetSize(const ir_window_t *window, uint32_t *width,
+                      uint32_t *height)
+{
+    *width = window->width;
+    *height = window->height;
+}
+
+void Ir_WindowSetTitle(ir_window_t *window, const char *title)
+{
+    window->backend->set_title(window, title);
+}
+
+uint64_t Ir_WindowNextFrameStart(ir_window_t *window, uint64_t now)
+{
+    return Ir_FramePacerNextStart(&window->pacer, now);
+}
+
+void Ir_WindowSubmitFrame(ir_window_t *window, uint64_t begin)
+{
+    Ir_FramePacerSubmitted(&window->pacer, begin,
+                           Ir_ClockMonotonicNanoseconds());
+    window->backend->submit_frame(window);
+}
+
+ir_input_queue_t *Ir_WindowInput(ir_window_t *window)
+{
+    return &window->input;
+}
+
+const ir_frame_pacer_t *Ir_WindowFramePacer(const ir_window_t *window)
+{
+    return &window->pacer;
+}
+
+const char *Ir_WindowBackendName(const ir_window_t *window)
+{
+    return window->backend->name;
+}
+
+void *Ir_WindowNativeDisplay(const ir_window_t *window)
+{
+    return window->backend->native_display(window);
+}
+
+void *Ir_WindowNativeSurface(const ir_window_t *window)
+{
+    return window->backend->native_surface(window);
+}
@@ -0,0 +1,303 @@
+/**
+ * @file Window.h
+ * @authors Israfiel
+ * @brief Iridium's window interface. A window is driven entirely by the
+ * event loop it's created on: its display connection is one of the
+ * loop's sources, so dispatching the loop without a timeout services
+ * the compositor without ever blocking the frame. Windows are opened
+ * through a backend chosen at runtime: Wayland, or a headless one that
+ * needs no display at all. Window events are
+ * queued and drained at frame start. Each window paces its frames from
+ * the compositor's presentation feedback; see Core/FramePacer.h. Input
+ * is pushed into the window's queue; see Input/Input.h.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PLATFORM_WINDOW_H
+#define IRIDIUM_PLATFORM_WINDOW_H
+
+#include "Core/FramePacer.h"
+#include "Input/Input.h"
+#include "Platform/EventLoop.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_WINDOW_EVENT_QUEUE
+ * @brief The most window events queued between drains. Older events
+ * are dropped first.
+ */
+#define IR_WINDOW_EVENT_QUEUE 64
+
+/**
+ * @name ir_window_t
+ * @brief An open window.
+ */
+typedef struct ir_window ir_window_t;
+
+/**
+ * @name ir_window_backend_type_t
+ * @brief Which backend a window is opened through.
+ */
+typedef enum ir_window_backend_type
+{
+    /**
+     * @name IR_WINDOW_BACKEND_DEFAULT
+     * @brief The backend IRIDIUM_WINDOW_BACKEND names ("wayland" or
+     * "headless"), or failing that Wayland when a compositor is
+     * advertised and headless when not.
+     */
+    IR_WINDOW_BACKEND_DEFAULT,
+    IR_WINDOW_BACKEND_WAYLAND,
+    /**
+     * @name IR_WINDOW_BACKEND_HEADLESS
+     * @brief No display; frames are rendered offscreen and paced to a
+     * simulated display at the configured refresh.
+     */
+    IR_WINDOW_BACKEND_HEADLESS,
+    IR_WINDOW_BACKEND_COUNT
+} ir_window_backend_type_t;
+
+/**
+ * @name ir_window_config_t
+ * @brief How to create a window.
+ */
+typedef struct ir_window_config
+{
+    /**
+     * @name title
+     * @brief The window's title.
+     */
+    const char *title;
+    /**
+     * @name app_id
+     * @brief The application ID the compositor groups windows by.
+     */
+    const char *app_id;
+    /**
+     * @name width
+     * @brief The width to use if the compositor leaves it to us.
+     */
+    uint32_t width;
+    /**
+     * @name height
+     * @brief The height to use if the compositor leaves it to us.
+     */
+    uint32_t height;
+    /**
+     * @name refresh
+     * @brief The refresh period to assume until the compositor reports
+     * one, in nanoseconds. Zero assumes 60 Hz.
+     */
+    uint64_t refresh;
+    /**
+     * @name backend
+     * @brief The backend to open the window through.
+     */
+    ir_window_backend_type_t backend;
+} ir_window_config_t;
+
+/**
+ * @name ir_window_event_type_t
+ * @brief The kind of a window event.
+ */
+typedef enum ir_window_event_type
+{
+    IR_WINDOW_EVENT_RESIZE,
+    IR_WINDOW_EVENT_FOCUS,
+    IR_WINDOW_EVENT_CLOSE
+} ir_window_event_type_t;
+
+/**
+ * @name ir_window_event_t
+ * @brief A change to a window. Holds no pointers, so it can be recorded
+ * into a replay as-is.
+ */
+typedef struct ir_window_event
+{
+    /**
+     * @name type
+     * @brief The kind of event.
+     */
+    ir_window_event_type_t type;
+    /**
+     * @name width
+     * @brief The window's new width, for resizes.
+     */
+    uint32_t width;
+    /**
+     * @name height
+     * @brief The window's new height, for resizes.
+     */
+    uint32_t height;
+    /**
+     * @name focused
+     * @brief Whether the window gained focus, for focus changes.
+     */
+    bool focused;
+    /**
+     * @name time
+     * @brief When the event arrived, in monotonic nanoseconds.
+     */
+    uint64_t time;
+} ir_window_event_t;
+
+/**
+ * @name WindowCreate
+ * @authors Israfiel
+ * @brief Open a window through the backend the config asks for. On
+ * Wayland, blocks until the compositor has configured the window, so
+ * this belongs in startup and never in the frame.
+ *
+ * @param config - How to create the window.
+ * @param loop - The loop the window's connection is serviced by.
+ * @returns The window, or NULL.
+ */
+ir_window_t *Ir_WindowCreate(const ir_window_config_t *config,
+                             ir_event_loop_t *loop);
+
+/**
+ * @name WindowDestroy
+ * @authors Israfiel
+ * @brief Close a window and disconnect from the display.
+ *
+ * @param window - The window to close.
+ */
+void Ir_WindowDestroy(ir_window_t *window);
+
+/**
+ * @name WindowNextEvent
+ * @authors Israfiel
+ * @brief Take the oldest queued window event.
+ *
+ * @param window - The window.
+ * @param event - Filled with the event.
+ * @returns Whether there was an event.
+ */
+bool Ir_WindowNextEvent(ir_window_t *window, ir_window_event_t *event);
+
+/**
+ * @name WindowShouldClose
+ * @authors Israfiel
+ * @brief Check whether the user asked to close the window, or the
+ * display connection was lost.
+ *
+ * @param window - The window.
+ * @returns Whether the window should close.
+ */
+bool Ir_WindowShouldClose(const ir_window_t *window);
+
+/**
+ * @name WindowClose
+ * @authors Israfiel
+ * @brief Ask for the window to close, as if the user had.
+ *
+ * @param window - The window.
+ */
+void Ir_WindowClose(ir_window_t *window);
+
+/**
+ * @name WindowGetSize
+ * @authors Israfiel
+ * @brief Get the window's current size.
+ *
+ * @param window - The window.
+ * @param width - Filled with the width.
+ * @param height - Filled with the height.
+ */
+void Ir_WindowGetSize(const ir_window_t *window, uint32_t *width,
+                      uint32_t *height);
+
+/**
+ * @name WindowSetTitle
+ * @authors Israfiel
+ * @brief Change the window's title.
+ *
+ * @param window - The window.
+ * @param title - The new title.
+ */
+void Ir_WindowSetTitle(ir_window_t *window, const char *title);
+
+/**
+ * @name WindowNextFrameStart
+ * @authors Israfiel
+ * @brief Decide when the next frame should start so that it's ready
+ * just in time for the vblank after it.
+ *
+ * @param window - The window.
+ * @param now - The current monotonic time in nanoseconds.
+ * @returns When to start the frame; never earlier than now.
+ */
+uint64_t Ir_WindowNextFrameStart(ir_window_t *window, uint64_t now);
+
+/**
+ * @name WindowSubmitFrame
+ * @authors Israfiel
+ * @brief Ask for feedback on the frame about to be presented. Must be
+ * called right before the renderer presents, since the feedback binds
+ * to the surface's next commit.
+ *
+ * @param window - The window.
+ * @param begin - When the frame started, in monotonic nanoseconds.
+ */
+void Ir_WindowSubmitFrame(ir_window_t *window, uint64_t begin);
+
+/**
+ * @name WindowInput
+ * @authors Israfiel
+ * @brief Get the queue the window pushes input into. The thread that
+ * dispatches the window's event loop is its only producer.
+ *
+ * @param window - The window.
+ * @returns The queue.
+ */
+ir_input_queue_t *Ir_WindowInput(ir_window_t *window);
+
+/**
+ * @name WindowFramePacer
+ * @authors Israfiel
+ * @brief Get the window's frame pacer, for its statistics.
+ *
+ * @param window - The window.
+ * @returns The pacer.
+ */
+const ir_frame_pacer_t *Ir_WindowFramePacer(const ir_window_t *window);
+
+/**
+ * @name WindowBackendName
+ * @authors Israfiel
+ * @brief Get the name of the backend driving a window.
+ *
+ * @param window - The window.
+ * @returns The backend's name.
+ */
+const char *Ir_WindowBackendName(const ir_window_t *window);
+
+/**
+ * @name WindowNativeDisplay
+ * @authors Israfiel
+ * @brief Get the native display connection, for creating a Vulkan
+ * surface. A wl_display on Wayland, and NULL when headless.
+ *
+ * @param window - The window.
+ * @returns The display.
+ */
+void *Ir_WindowNativeDisplay(const ir_window_t *window);
+
+/**
+ * @name WindowNativeSurface
+ * @authors Israfiel
+ * @brief Get the native surface, for creating a Vulkan surface. A
+ * wl_surface on Wayland, and NULL when headless, in which case frames
+ * should be rendered offscreen.
+ *
+ * @param window - The window.
+ * @returns The surface.
+ */
+void *Ir_WindowNativeSurface(const ir_window_t *window);
+
+#endif // IRIDIUM_PLATFORM_WINDOW_H
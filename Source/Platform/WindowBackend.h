@@ -0,0 +1,157 @@
+/**
+ * @file WindowBackend.h
+ * @authors Israfiel
+ * @brief The interface each window backend implements, and the state
+ * every window shares regardless of backend. Private to the platform
+ * layer; the engine only ever sees Window.h.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_PLATFORM_WINDOWBACKEND_H
+#define IRIDIUM_PLATFORM_WINDOWBACKEND_H
+
+#include "Platform/Window.h"
+
+/**
+ * @name ir_window_backend_t
+ * @brief A window backend's entry points. Every one is required.
+ */
+typedef struct ir_window_backend
+{
+    /**
+     * @name name
+     * @brief The backend's name, as IRIDIUM_WINDOW_BACKEND spells it.
+     */
+    const char *name;
+    /**
+     * @name create
+     * @brief Open the window, storing the backend's own state in the
+     * window's data. The shared state is already set up; on failure the
+     * backend must have released everything it took.
+     */
+    bool (*create)(ir_window_t *window, const ir_window_config_t *config);
+    /**
+     * @name destroy
+     * @brief Close the window and free the backend's state.
+     */
+    void (*destroy)(ir_window_t *window);
+    /**
+     * @name set_title
+     * @brief Change the window's title.
+     */
+    void (*set_title)(ir_window_t *window, const char *title);
+    /**
+     * @name submit_frame
+     * @brief Arrange to hear when the frame about to be presented is
+     * shown, and feed that to the window's pacer.
+     */
+    void (*submit_frame)(ir_window_t *window);
+    /**
+     * @name native_display
+     * @brief Get the native display connection, or NULL if there is
+     * none.
+     */
+    void *(*native_display)(const ir_window_t *window);
+    /**
+     * @name native_surface
+     * @brief Get the native surface, or NULL if frames should be
+     * rendered offscreen.
+     */
+    void *(*native_surface)(const ir_window_t *window);
+} ir_window_backend_t;
+
+struct ir_window
+{
+    /**
+     * @name backend
+     * @brief The backend driving the window.
+     */
+    const ir_window_backend_t *backend;
+    /**
+     * @name data
+     * @brief The backend's own state.
+     */
+    void *data;
+    /**
+     * @name loop
+     * @brief The event loop the backend registers its sources with.
+     */
+    ir_event_loop_t *loop;
+    /**
+     * @name width
+     * @brief The window's current width.
+     */
+    uint32_t width;
+    /**
+     * @name height
+     * @brief The window's current height.
+     */
+    uint32_t height;
+    /**
+     * @name focused
+     * @brief Whether the window has keyboard focus.
+     */
+    bool focused;
+    /**
+     * @name closed
+     * @brief Whether the user, or Ir_WindowClose, asked for the window
+     * to close.
+     */
+    bool closed;
+    /**
+     * @name events
+     * @brief The queue of window events not yet drained.
+     */
+    ir_window_event_t events[IR_WINDOW_EVENT_QUEUE];
+    /**
+     * @name event_head
+     * @brief The index in events of the oldest queued event.
+     */
+    uint32_t event_head;
+    /**
+     * @name event_count
+     * @brief The number of events queued, wrapping around from the
+     * head.
+     */
+    uint32_t event_count;
+    /**
+     * @name pacer
+     * @brief Paces the window's frames to the display.
+     */
+    ir_frame_pacer_t pacer;
+    /**
+     * @name input
+     * @brief The queue input events are pushed into.
+     */
+    ir_input_queue_t input;
+};
+
+/**
+ * @name ir_wayland_backend
+ * @brief Windows on a Wayland compositor. Only built with
+ * IRIDIUM_WAYLAND.
+ */
+extern const ir_window_backend_t ir_wayland_backend;
+
+/**
+ * @name ir_headless_backend
+ * @brief Windows with no display at all, for machines without a
+ * compositor. Frames are paced to a simulated display.
+ */
+extern const ir_window_backend_t ir_headless_backend;
+
+/**
+ * @name WindowPushEvent
+ * @authors Israfiel
+ * @brief Queue a window event, stamping its time and dropping the
+ * oldest if the queue is full.
+ *
+ * @param window - The window.
+ * @param event - The event to queue.
+ */
+void Ir_WindowPushEvent(ir_window_t *window, ir_window_event_t event);
+
+#endif // IRIDIUM_PLATFORM_WINDOWBACKEND_H
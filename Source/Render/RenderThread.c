@@ -0,0 +1,181 @@
+/**
+ * @file RenderThread.c
+ * @authors Israfiel
+ * @brief Implements Iridium's render thread.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "RenderThread.h"
+
+#include "Core/Clock.h"
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name ir_render_extraction_t
+ * @brief An extraction in progress, shared by the jobs running it.
+ */
+typedef struct ir_render_extraction
+{
+    ir_render_extract_t extract;
+    void *user;
+    ir_render_proxy_t *proxies;
+} ir_render_extraction_t;
+
+/**
+ * @name RenderLoop
+ * @authors Israfiel
+ * @brief Render each snapshot as it's published.
+ *
+ * @param user - The render thread.
+ * @returns Zero.
+ */
+static int RenderLoop(void *user)
+{
+    ir_render_thread_t *thread = user;
+    IR_PROFILE_THREAD_NAME("Render");
+
+    mtx_lock(&thread->mutex);
+    while (true)
+    {
+        while (thread->published == -1 && !thread->stopping)
+            cnd_wait(&thread->changed, &thread->mutex);
+        if (thread->published == -1) break;
+
+        thread->rendering = thread->published;
+        thread->published = -1;
+        cnd_broadcast(&thread->changed);
+        mtx_unlock(&thread->mutex);
+
+        IR_PROFILE_BEGIN("Render");
+        thread->render(thread->user,
+                       &thread->snapshots[thread->rendering]);
+        IR_PROFILE_END("Render");
+
+        mtx_lock(&thread->mutex);
+        thread->rendering = -1;
+        cnd_broadcast(&thread->changed);
+    }
+    mtx_unlock(&thread->mutex);
+    return 0;
+}
+
+/**
+ * @name ExtractRange
+ * @authors Israfiel
+ * @brief Fill one chunk of a snapshot's proxies.
+ *
+ * @param user - The extraction.
+ * @param begin - The chunk's first index.
+ * @param end - One past the chunk's last index.
+ */
+static void ExtractRange(void *user, size_t begin, size_t end)
+{
+    ir_render_extraction_t *extraction = user;
+    extraction->extract(extraction->user, extraction->proxies, begin,
+                        end);
+}
+
+bool Ir_RenderThreadCreate(ir_render_thread_t *thread,
+                           ir_render_frame_t render, void *user)
+{
+    *thread = (ir_render_thread_t){
+        .writing = -1,
+        .published = -1,
+        .rendering = -1,
+        .render = render,
+        .user = user,
+    };
+    mtx_init(&thread->mutex, mtx_plain);
+    cnd_init(&thread->changed);
+    if (thrd_create(&thread->thread, RenderLoop, thread) != thrd_success)
+    {
+        IR_LOG_ERROR("Failed to start the render thread.");
+        cnd_destroy(&thread->changed);
+        mtx_destroy(&thread->mutex);
+        return false;
+    }
+    return true;
+}
+
+void Ir_RenderThreadDestroy(ir_render_thread_t *thread)
+{
+    mtx_lock(&thread->mutex);
+    thread->stopping = true;
+    cnd_broadcast(&thread->changed);
+    mtx_unlock(&thread->mutex);
+    thrd_join(thread->thread, NULL);
+
+    cnd_destroy(&thread->changed);
+    mtx_destroy(&thread->mutex);
+    free(thread->snapshots[0].proxies);
+    free(thread->snapshots[1].proxies);
+}
+
+ir_render_snapshot_t *Ir_RenderThreadBegin(ir_render_thread_t *thread,
+                                           uint32_t proxies)
+{
+    IR_PROFILE_BEGIN("Wait for Render");
+    mtx_lock(&thread->mutex);
+    // A snapshot still waiting to be picked up means the game is a full
+    // frame ahead; every snapshot gets rendered, so it waits its turn.
+    while (thread->published != -1)
+        cnd_wait(&thread->changed, &thread->mutex);
+    int32_t index = thread->rendering == 0 ? 1 : 0;
+    thread->writing = index;
+    mtx_unlock(&thread->mutex);
+    IR_PROFILE_END("Wait for Render");
+
+    ir_render_snapshot_t *snapshot = &thread->snapshots[index];
+    if (snapshot->proxy_capacity < proxies)
+    {
+        ir_render_proxy_t *grown = realloc(
+            snapshot->proxies, proxies * sizeof(ir_render_proxy_t));
+        if (grown == NULL)
+        {
+            thread->writing = -1;
+            return NULL;
+        }
+        snapshot->proxies = grown;
+        snapshot->proxy_capacity = proxies;
+    }
+    snapshot->proxy_count = proxies;
+    return snapshot;
+}
+
+void Ir_RenderThreadPublish(ir_render_thread_t *thread)
+{
+    mtx_lock(&thread->mutex);
+    thread->snapshots[thread->writing].time =
+        Ir_ClockMonotonicNanoseconds();
+    thread->published = thread->writing;
+    thread->writing = -1;
+    cnd_broadcast(&thread->changed);
+    mtx_unlock(&thread->mutex);
+}
+
+bool Ir_RenderThreadExtract(ir_render_thread_t *thread, ir_jobs_t *jobs,
+                            uint32_t count, const float view[16],
+                            uint64_t frame, ir_render_extract_t extract,
+                            void *user)
+{
+    ir_render_snapshot_t *snapshot = Ir_RenderThreadBegin(thread, count);
+    if (snapshot == NULL) return false;
+    memcpy(snapshot->view, view, sizeof(snapshot->view));
+    snapshot->frame = frame;
+
+    IR_PROFILE_BEGIN("Extract");
+    ir_render_extraction_t extraction = {extract, user,
+                                         snapshot->proxies};
+    Ir_JobsParallelFor(jobs, count, 0, ExtractRange, &extraction);
+    IR_PROFILE_END("Extract");
+
+    Ir_RenderThreadPublish(thread);
+    return true;
+}
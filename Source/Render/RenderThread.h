@@ -0,0 +1,187 @@
+/**
+ * @file RenderThread.h
+ * @authors Israfiel
+ * @brief Iridium's render thread. The game thread never touches the
+ * renderer directly: each frame it extracts everything there is to draw
+ * into an immutable snapshot and hands that over, then moves straight on
+ * to the next frame while the render thread records the one before.
+ * Snapshots are double-buffered, so the game runs at most one frame
+ * ahead of rendering.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_RENDER_RENDERTHREAD_H
+#define IRIDIUM_RENDER_RENDERTHREAD_H
+
+#include "Core/Jobs.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <threads.h>
+
+/**
+ * @name ir_render_proxy_t
+ * @brief Everything the renderer needs to draw one object, copied out
+ * of the game's own state so the two never share memory.
+ */
+typedef struct ir_render_proxy
+{
+    /**
+     * @name transform
+     * @brief The object's column-major model matrix.
+     */
+    float transform[16];
+    uint32_t mesh;
+    uint32_t material;
+    uint32_t flags;
+} ir_render_proxy_t;
+
+/**
+ * @name ir_render_snapshot_t
+ * @brief Everything to draw for one frame.
+ */
+typedef struct ir_render_snapshot
+{
+    /**
+     * @name view
+     * @brief The camera's column-major view-projection matrix.
+     */
+    float view[16];
+    ir_render_proxy_t *proxies;
+    uint32_t proxy_count;
+    uint32_t proxy_capacity;
+    /**
+     * @name frame
+     * @brief The number of the game frame the snapshot was taken in.
+     */
+    uint64_t frame;
+    /**
+     * @name time
+     * @brief When the snapshot was published, in monotonic nanoseconds.
+     */
+    uint64_t time;
+} ir_render_snapshot_t;
+
+/**
+ * @name ir_render_extract_t
+ * @brief Fill a range of a snapshot's proxies from the game's state.
+ * Called from job workers, so ranges run concurrently.
+ *
+ * @param user - The extraction's user data.
+ * @param proxies - The snapshot's proxies; fill [begin, end).
+ * @param begin - The range's first index.
+ * @param end - One past the range's last index.
+ */
+typedef void (*ir_render_extract_t)(void *user, ir_render_proxy_t *proxies,
+                                    size_t begin, size_t end);
+
+/**
+ * @name ir_render_frame_t
+ * @brief Render a snapshot. Called on the render thread.
+ *
+ * @param user - The render thread's user data.
+ * @param snapshot - The snapshot, which mustn't be modified.
+ */
+typedef void (*ir_render_frame_t)(void *user,
+                                  const ir_render_snapshot_t *snapshot);
+
+/**
+ * @name ir_render_thread_t
+ * @brief A render thread and the snapshots it exchanges with the game.
+ */
+typedef struct ir_render_thread
+{
+    ir_render_snapshot_t snapshots[2];
+    /**
+     * @name writing
+     * @brief The snapshot the game is filling, or -1.
+     */
+    int32_t writing;
+    /**
+     * @name published
+     * @brief The snapshot waiting to be rendered, or -1.
+     */
+    int32_t published;
+    /**
+     * @name rendering
+     * @brief The snapshot being rendered, or -1.
+     */
+    int32_t rendering;
+    ir_render_frame_t render;
+    void *user;
+    bool stopping;
+    thrd_t thread;
+    mtx_t mutex;
+    cnd_t changed;
+} ir_render_thread_t;
+
+/**
+ * @name RenderThreadCreate
+ * @authors Israfiel
+ * @brief Start a render thread.
+ *
+ * @param thread - The render thread to start.
+ * @param render - Renders each published snapshot.
+ * @param user - The render function's user data.
+ * @returns Whether the thread was started.
+ */
+bool Ir_RenderThreadCreate(ir_render_thread_t *thread,
+                           ir_render_frame_t render, void *user);
+
+/**
+ * @name RenderThreadDestroy
+ * @authors Israfiel
+ * @brief Render whatever was published, then stop the thread.
+ *
+ * @param thread - The render thread to stop.
+ */
+void Ir_RenderThreadDestroy(ir_render_thread_t *thread);
+
+/**
+ * @name RenderThreadBegin
+ * @authors Israfiel
+ * @brief Take a snapshot to fill, waiting if the last one published
+ * hasn't been picked up yet, which only happens when the game is a full
+ * frame ahead of rendering.
+ *
+ * @param thread - The render thread.
+ * @param proxies - How many proxies the snapshot must have room for.
+ * @returns The snapshot, or NULL if its proxies couldn't be allocated.
+ */
+ir_render_snapshot_t *Ir_RenderThreadBegin(ir_render_thread_t *thread,
+                                           uint32_t proxies);
+
+/**
+ * @name RenderThreadPublish
+ * @authors Israfiel
+ * @brief Hand the snapshot being filled to the render thread.
+ *
+ * @param thread - The render thread.
+ */
+void Ir_RenderThreadPublish(ir_render_thread_t *thread);
+
+/**
+ * @name RenderThreadExtract
+ * @authors Israfiel
+ * @brief Take a snapshot, fill its proxies in parallel across a job
+ * pool, and publish it.
+ *
+ * @param thread - The render thread.
+ * @param jobs - The pool to extract with.
+ * @param count - The number of proxies.
+ * @param view - The camera's view-projection matrix.
+ * @param frame - The game frame's number.
+ * @param extract - Fills the proxies.
+ * @param user - The extraction's user data.
+ * @returns Whether the snapshot was published.
+ */
+bool Ir_RenderThreadExtract(ir_render_thread_t *thread, ir_jobs_t *jobs,
+                            uint32_t count, const float view[16],
+                            uint64_t frame, ir_render_extract_t extract,
+                            void *user);
+
+#endif // IRIDIUM_RENDER_RENDERTHREAD_H
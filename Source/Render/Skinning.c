@@ -0,0 +1,385 @@
+/**
+ * @file Skinning.c
+ * @authors Israfiel
+ * @brief Implements Iridium's skinning.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Skinning.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+#include "Math/SIMD.h"
+
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name ir_skinning_batch_t
+ * @brief The instances a dispatch is working through.
+ */
+typedef struct ir_skinning_batch
+{
+    ir_skinning_t *skinning;
+    const ir_skinned_instance_t *instances;
+    uint32_t count;
+} ir_skinning_batch_t;
+
+/**
+ * @name Multiply
+ * @authors Israfiel
+ * @brief Multiply two joint matrices, whose implied fourth rows are
+ * (0, 0, 0, 1).
+ *
+ * @param a - The left matrix.
+ * @param b - The right matrix.
+ * @param out - Filled with the product.
+ */
+static void Multiply(const ir_joint_matrix_t *a,
+                     const ir_joint_matrix_t *b, ir_joint_matrix_t *out)
+{
+    ir_simd_t right[3] = {Ir_SimdLoad(b->rows[0]), Ir_SimdLoad(b->rows[1]),
+                          Ir_SimdLoad(b->rows[2])};
+    ir_simd_t last = Ir_SimdLoad((float[4]){0.0f, 0.0f, 0.0f, 1.0f});
+    for (int i = 0; i < 3; ++i)
+    {
+        const float *row = a->rows[i];
+        ir_simd_t result = Ir_SimdMul(Ir_SimdSplat(row[3]), last);
+        for (int j = 0; j < 3; ++j)
+            result = Ir_SimdMulAdd(Ir_SimdSplat(row[j]), right[j], result);
+        Ir_SimdStore(out->rows[i], result);
+    }
+}
+
+/**
+ * @name WritePalettes
+ * @authors Israfiel
+ * @brief Write a range of instances' palettes.
+ *
+ * @param user - The batch.
+ * @param begin - The first instance.
+ * @param end - One past the last.
+ */
+static void WritePalettes(void *user, size_t begin, size_t end)
+{
+    ir_skinning_batch_t *batch = user;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const ir_skinned_instance_t *instance = &batch->instances[i];
+        const ir_skin_t *skin = instance->skin;
+        ir_joint_matrix_t *palette =
+            &batch->skinning->palettes[instance->palette];
+        for (uint32_t j = 0; j < skin->joint_count; ++j)
+            Multiply(&instance->matrices[j], &skin->inverse_binds[j],
+                     &palette[j]);
+    }
+}
+
+/**
+ * @name SkinBlock
+ * @authors Israfiel
+ * @brief Skin four of a skin's vertices.
+ *
+ * @param skin - The skin.
+ * @param palette - Its palette.
+ * @param first - The block's first vertex.
+ * @param positions - Filled with the four's skinned positions.
+ * @param normals - Filled with the four's skinned normals.
+ */
+static void SkinBlock(const ir_skin_t *skin,
+                      const ir_joint_matrix_t *palette, uint32_t first,
+                      float (*positions)[4], float (*normals)[4])
+{
+    // Each vertex's joints blended into one matrix, a row at a time.
+    ir_simd_t zero = Ir_SimdSplat(0.0f), one = Ir_SimdSplat(1.0f);
+    ir_simd_t rows[3][IR_SIMD_WIDTH];
+    for (uint32_t i = 0; i < IR_SIMD_WIDTH; ++i)
+    {
+        size_t vertex = (size_t)(first + i) * IR_SKIN_INFLUENCES;
+        const uint16_t *joints = &skin->joints[vertex];
+        const float *weights = &skin->weights[vertex];
+        for (int j = 0; j < 3; ++j) rows[j][i] = zero;
+        for (int j = 0; j < IR_SKIN_INFLUENCES; ++j)
+        {
+            ir_simd_t weight = Ir_SimdSplat(weights[j]);
+            const ir_joint_matrix_t *matrix = &palette[joints[j]];
+            for (int k = 0; k < 3; ++k)
+                rows[k][i] = Ir_SimdMulAdd(Ir_SimdLoad(matrix->rows[k]),
+                                           weight, rows[k][i]);
+        }
+    }
+
+    // Transposed, each row holds one of its elements for all four
+    // vertices, so the rest runs across them. Normals are carried by the
+    // same matrices, which holds for the rotations and uniform scales
+    // skeletons are made of.
+    size_t stride = skin->stride;
+    ir_simd_t x = Ir_SimdLoad(skin->positions + first);
+    ir_simd_t y = Ir_SimdLoad(skin->positions + stride + first);
+    ir_simd_t z = Ir_SimdLoad(skin->positions + 2 * stride + first);
+    ir_simd_t nx = Ir_SimdLoad(skin->normals + first);
+    ir_simd_t ny = Ir_SimdLoad(skin->normals + stride + first);
+    ir_simd_t nz = Ir_SimdLoad(skin->normals + 2 * stride + first);
+    ir_simd_t position[4], normal[4], length = zero;
+    for (int i = 0; i < 3; ++i)
+    {
+        ir_simd_t *row = rows[i];
+        Ir_SimdTranspose(row);
+        position[i] = Ir_SimdMulAdd(
+            row[0], x,
+            Ir_SimdMulAdd(row[1], y, Ir_SimdMulAdd(row[2], z, row[3])));
+        normal[i] = Ir_SimdMulAdd(
+            row[0], nx, Ir_SimdMulAdd(row[1], ny, Ir_SimdMul(row[2], nz)));
+        length = Ir_SimdMulAdd(normal[i], normal[i], length);
+    }
+
+    // Padding vertices come out as zero, with no normal to scale.
+    ir_simd_t scale = Ir_SimdDiv(
+        one, Ir_SimdSqrt(Ir_SimdMax(length, Ir_SimdSplat(1e-24f))));
+    for (int i = 0; i < 3; ++i) normal[i] = Ir_SimdMul(normal[i], scale);
+    position[3] = one;
+    normal[3] = zero;
+    Ir_SimdTranspose(position);
+    Ir_SimdTranspose(normal);
+    for (uint32_t i = 0; i < IR_SIMD_WIDTH; ++i)
+    {
+        Ir_SimdStore(positions[i], position[i]);
+        Ir_SimdStore(normals[i], normal[i]);
+    }
+}
+
+/**
+ * @name SkinBlocks
+ * @authors Israfiel
+ * @brief Skin a range of the frame's blocks of four vertices, which may
+ * span several instances.
+ *
+ * @param user - The batch.
+ * @param begin - The first block.
+ * @param end - One past the last.
+ */
+static void SkinBlocks(void *user, size_t begin, size_t end)
+{
+    ir_skinning_batch_t *batch = user;
+    ir_skinning_t *skinning = batch->skinning;
+
+    // Instances' outputs are in order, so the one holding the first
+    // block is found by bisection and the rest follow on.
+    uint32_t low = 0, high = batch->count;
+    while (high - low > 1)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        if (batch->instances[middle].first / IR_SIMD_WIDTH <= begin)
+            low = middle;
+        else high = middle;
+    }
+
+    for (uint32_t i = low; i < batch->count && begin < end; ++i)
+    {
+        const ir_skinned_instance_t *instance = &batch->instances[i];
+        const ir_skin_t *skin = instance->skin;
+        size_t first = instance->first / IR_SIMD_WIDTH;
+        size_t last = first + skin->stride / IR_SIMD_WIDTH;
+        for (; begin < end && begin < last; ++begin)
+        {
+            size_t vertex = begin * IR_SIMD_WIDTH;
+            SkinBlock(skin, &skinning->palettes[instance->palette],
+                      (uint32_t)(vertex - instance->first),
+                      &skinning->positions[vertex],
+                      &skinning->normals[vertex]);
+        }
+    }
+}
+
+/**
+ * @name Reserve
+ * @authors Israfiel
+ * @brief Make room in a frame's buffers. They're only ever grown, and
+ * what's in them needn't survive it.
+ *
+ * @param skinning - The skinning.
+ * @param palettes - The number of palette matrices.
+ * @param vertices - The number of vertices.
+ * @returns Whether there was memory for them.
+ */
+static bool Reserve(ir_skinning_t *skinning, uint32_t palettes,
+                    uint32_t vertices)
+{
+    if (skinning->palette_capacity < palettes)
+    {
+        free(skinning->palettes);
+        skinning->palettes = malloc(palettes * sizeof(ir_joint_matrix_t));
+        skinning->palette_capacity =
+            skinning->palettes == NULL ? 0 : palettes;
+    }
+    if (skinning->vertex_capacity < vertices)
+    {
+        free(skinning->positions);
+        free(skinning->normals);
+        skinning->positions = malloc(vertices * sizeof(float[4]));
+        skinning->normals = malloc(vertices * sizeof(float[4]));
+        skinning->vertex_capacity =
+            skinning->positions == NULL || skinning->normals == NULL
+                ? 0
+                : vertices;
+    }
+    return skinning->palette_capacity >= palettes &&
+           skinning->vertex_capacity >= vertices;
+}
+
+void Ir_SkinningCreate(ir_skinning_t *skinning)
+{
+    *skinning = (ir_skinning_t){0};
+}
+
+void Ir_SkinningDestroy(ir_skinning_t *skinning)
+{
+    free(skinning->palettes);
+    free(skinning->positions);
+    free(skinning->normals);
+    *skinning = (ir_skinning_t){0};
+}
+
+bool Ir_SkinningDispatch(ir_skinning_t *skinning,
+                         ir_skinned_instance_t *instances, uint32_t count,
+                         ir_jobs_t *jobs)
+{
+    uint32_t palettes = 0, vertices = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        instances[i].palette = palettes;
+        instances[i].first = vertices;
+        palettes += instances[i].skin->joint_count;
+        vertices += instances[i].skin->stride;
+    }
+    if (!Reserve(skinning, palettes, vertices))
+    {
+        skinning->palette_count = skinning->vertex_count = 0;
+        IR_LOG_ERROR("Ran out of memory skinning %u vertices.", vertices);
+        return false;
+    }
+    skinning->palette_count = palettes;
+    skinning->vertex_count = vertices;
+
+    IR_PROFILE_BEGIN("Skinning");
+    ir_skinning_batch_t batch = {skinning, instances, count};
+    size_t blocks = vertices / IR_SIMD_WIDTH;
+    if (jobs != NULL)
+    {
+        Ir_JobsParallelFor(jobs, count, IR_SKINNING_PALETTE_GRAIN,
+                           WritePalettes, &batch);
+        Ir_JobsParallelFor(jobs, blocks, IR_SKINNING_GRAIN, SkinBlocks,
+                           &batch);
+    }
+    else
+    {
+        WritePalettes(&batch, 0, count);
+        SkinBlocks(&batch, 0, blocks);
+    }
+    IR_PROFILE_END("Skinning");
+    return true;
+}
+
+uint64_t Ir_SkinBake(ir_scene_writer_t *writer,
+                     const ir_skin_vertex_t *vertices, uint32_t count,
+                     const ir_joint_matrix_t *inverse_binds,
+                     uint32_t joints)
+{
+    if (joints == 0 || joints > UINT16_MAX + 1)
+    {
+        IR_LOG_ERROR("A skin can't have %u joints.", joints);
+        return 0;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float total = 0.0f;
+        for (int j = 0; j < IR_SKIN_INFLUENCES; ++j)
+        {
+            if (vertices[i].weights[j] < 0.0f ||
+                (vertices[i].weights[j] > 0.0f &&
+                 vertices[i].joints[j] >= joints))
+            {
+                IR_LOG_ERROR("Vertex %u follows a joint it can't.", i);
+                return 0;
+            }
+            total += vertices[i].weights[j];
+        }
+        if (total <= 0.0f)
+        {
+            IR_LOG_ERROR("Vertex %u doesn't follow any joint.", i);
+            return 0;
+        }
+    }
+
+    uint32_t stride = (count + IR_SIMD_WIDTH - 1) & ~(IR_SIMD_WIDTH - 1);
+    uint64_t skin = Ir_SceneWriterAllocate(writer, sizeof(ir_skin_t),
+                                           alignof(ir_skin_t));
+    uint64_t positions = Ir_SceneWriterAllocate(
+        writer, 3 * stride * sizeof(float), IR_SCENE_ALIGNMENT);
+    uint64_t normals = Ir_SceneWriterAllocate(
+        writer, 3 * stride * sizeof(float), IR_SCENE_ALIGNMENT);
+    uint64_t influences = Ir_SceneWriterAllocate(
+        writer, (size_t)stride * IR_SKIN_INFLUENCES * sizeof(uint16_t),
+        alignof(uint16_t));
+    uint64_t weights = Ir_SceneWriterAllocate(
+        writer, (size_t)stride * IR_SKIN_INFLUENCES * sizeof(float),
+        IR_SCENE_ALIGNMENT);
+    uint64_t binds = Ir_SceneWriterAllocate(
+        writer, joints * sizeof(ir_joint_matrix_t), IR_SCENE_ALIGNMENT);
+    if (skin == 0 || positions == 0 || normals == 0 || influences == 0 ||
+        weights == 0 || binds == 0)
+        return 0;
+
+    // The padding is left as allocated, zeroed, so it follows nothing.
+    ir_skin_t *header = Ir_SceneWriterGet(writer, skin);
+    header->vertex_count = count;
+    header->stride = stride;
+    header->joint_count = joints;
+    float *position = Ir_SceneWriterGet(writer, positions);
+    float *normal = Ir_SceneWriterGet(writer, normals);
+    uint16_t *influence = Ir_SceneWriterGet(writer, influences);
+    float *weight = Ir_SceneWriterGet(writer, weights);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const ir_skin_vertex_t *vertex = &vertices[i];
+        ir_vec3_t unit =
+            Ir_Vec3Normalize(vertex->normal, Ir_Vec3(0.0f, 1.0f, 0.0f));
+        for (int j = 0; j < 3; ++j)
+        {
+            position[j * stride + i] =
+                Ir_Vec3Component(vertex->position, j);
+            normal[j * stride + i] = Ir_Vec3Component(unit, j);
+        }
+
+        float total = 0.0f;
+        for (int j = 0; j < IR_SKIN_INFLUENCES; ++j)
+            total += vertex->weights[j];
+        for (int j = 0; j < IR_SKIN_INFLUENCES; ++j)
+        {
+            size_t slot = (size_t)i * IR_SKIN_INFLUENCES + j;
+            bool follows = vertex->weights[j] > 0.0f;
+            influence[slot] = follows ? vertex->joints[j] : 0;
+            weight[slot] = vertex->weights[j] / total;
+        }
+    }
+    memcpy(Ir_SceneWriterGet(writer, binds), inverse_binds,
+           joints * sizeof(ir_joint_matrix_t));
+
+    Ir_SceneWriterPointer(writer, skin + offsetof(ir_skin_t, positions),
+                          positions);
+    Ir_SceneWriterPointer(writer, skin + offsetof(ir_skin_t, normals),
+                          normals);
+    Ir_SceneWriterPointer(writer, skin + offsetof(ir_skin_t, joints),
+                          influences);
+    Ir_SceneWriterPointer(writer, skin + offsetof(ir_skin_t, weights),
+                          weights);
+    Ir_SceneWriterPointer(writer,
+                          skin + offsetof(ir_skin_t, inverse_binds),
+                          binds);
+    return writer->failed ? 0 : skin;
+}
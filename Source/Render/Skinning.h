@@ -0,0 +1,216 @@
+/**
+ * @file Skinning.h
+ * @authors Israfiel
+ * @brief Iridium's skinning. Once a frame, every skinned instance's
+ * joint palette, its model-space matrices times its inverse bind
+ * matrices, is written into one shared palette buffer, and every
+ * instance's vertices are skinned into one shared output buffer, where
+ * each instance keeps the same range for the whole frame. Every pass,
+ * shadows included, draws from that range rather than skinning again.
+ *
+ * Both buffers are laid out as a compute shader's storage buffers would
+ * be: a palette is three rows of four floats a joint, and each skinned
+ * vertex is a position and a normal of four floats each. Vertices are
+ * skinned four at a time, the palette rows of each blended and then
+ * transposed so the rest runs across the four, and the work is spread
+ * over jobs by blocks of vertices rather than by instance, so one large
+ * mesh doesn't hold up the frame.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_RENDER_SKINNING_H
+#define IRIDIUM_RENDER_SKINNING_H
+
+#include "Animation/Skeleton.h"
+#include "Core/Jobs.h"
+#include "Math/Vector.h"
+#include "Scene/Scene.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_SKIN_INFLUENCES
+ * @brief The most joints a vertex follows.
+ */
+#define IR_SKIN_INFLUENCES 4
+
+/**
+ * @name IR_SKINNING_GRAIN
+ * @brief The number of four-vertex blocks each job skins.
+ */
+#define IR_SKINNING_GRAIN 64
+
+/**
+ * @name IR_SKINNING_PALETTE_GRAIN
+ * @brief The number of instances' palettes each job writes.
+ */
+#define IR_SKINNING_PALETTE_GRAIN 16
+
+/**
+ * @name ir_skin_vertex_t
+ * @brief A vertex to bake into a skin.
+ */
+typedef struct ir_skin_vertex
+{
+    ir_vec3_t position;
+    ir_vec3_t normal;
+    uint16_t joints[IR_SKIN_INFLUENCES];
+    /**
+     * @name weights
+     * @brief How much the vertex follows each joint. They're scaled to
+     * sum to one when baked.
+     */
+    float weights[IR_SKIN_INFLUENCES];
+} ir_skin_vertex_t;
+
+/**
+ * @name ir_skin_t
+ * @brief A baked mesh's skin, in its bind pose.
+ */
+typedef struct ir_skin
+{
+    uint32_t vertex_count;
+    /**
+     * @name stride
+     * @brief The vertex count rounded up to a whole number of blocks.
+     * The padding vertices follow nothing and are skinned to zero.
+     */
+    uint32_t stride;
+    uint32_t joint_count;
+    /**
+     * @name positions
+     * @brief The vertices' positions, each axis's stride floats after
+     * the last.
+     */
+    float *positions;
+    /**
+     * @name normals
+     * @brief The vertices' normals, laid out as the positions are.
+     */
+    float *normals;
+    /**
+     * @name joints
+     * @brief Each vertex's IR_SKIN_INFLUENCES joints.
+     */
+    uint16_t *joints;
+    /**
+     * @name weights
+     * @brief Each vertex's IR_SKIN_INFLUENCES weights.
+     */
+    float *weights;
+    /**
+     * @name inverse_binds
+     * @brief Each joint's model-space bind matrix, inverted.
+     */
+    ir_joint_matrix_t *inverse_binds;
+} ir_skin_t;
+
+/**
+ * @name ir_skinned_instance_t
+ * @brief A skin to deform this frame.
+ */
+typedef struct ir_skinned_instance
+{
+    const ir_skin_t *skin;
+    /**
+     * @name matrices
+     * @brief Its joints' model-space matrices, such as a character's.
+     * They're read while the frame is skinned, so mustn't change.
+     */
+    const ir_joint_matrix_t *matrices;
+    /**
+     * @name palette
+     * @brief Filled with where its palette starts in the frame's
+     * palette buffer.
+     */
+    uint32_t palette;
+    /**
+     * @name first
+     * @brief Filled with where its vertices start in the frame's output.
+     */
+    uint32_t first;
+} ir_skinned_instance_t;
+
+/**
+ * @name ir_skinning_t
+ * @brief A frame's shared palette and output buffers. The renderer
+ * reads them until the frame's drawn, so keep one for each frame in
+ * flight, as with snapshots.
+ */
+typedef struct ir_skinning
+{
+    ir_joint_matrix_t *palettes;
+    uint32_t palette_count;
+    uint32_t palette_capacity;
+    /**
+     * @name positions
+     * @brief Each skinned vertex's position, with a w of one.
+     */
+    float (*positions)[4];
+    /**
+     * @name normals
+     * @brief Each skinned vertex's unit normal, with a w of zero.
+     */
+    float (*normals)[4];
+    uint32_t vertex_count;
+    uint32_t vertex_capacity;
+} ir_skinning_t;
+
+/**
+ * @name SkinningCreate
+ * @authors Israfiel
+ * @brief Create an empty frame of skinning.
+ *
+ * @param skinning - The skinning.
+ */
+void Ir_SkinningCreate(ir_skinning_t *skinning);
+
+/**
+ * @name SkinningDestroy
+ * @authors Israfiel
+ * @brief Free a frame of skinning.
+ *
+ * @param skinning - The skinning.
+ */
+void Ir_SkinningDestroy(ir_skinning_t *skinning);
+
+/**
+ * @name SkinningDispatch
+ * @authors Israfiel
+ * @brief Write every instance's palette, then skin every instance into
+ * the output, replacing the last frame's.
+ *
+ * @param skinning - The skinning.
+ * @param instances - The instances, each given its ranges.
+ * @param count - The number of instances.
+ * @param jobs - The pool to skin with, or NULL to skin on the calling
+ * thread.
+ * @returns Whether there was memory for the buffers.
+ */
+bool Ir_SkinningDispatch(ir_skinning_t *skinning,
+                         ir_skinned_instance_t *instances, uint32_t count,
+                         ir_jobs_t *jobs);
+
+/**
+ * @name SkinBake
+ * @authors Israfiel
+ * @brief Bake a skin into a scene.
+ *
+ * @param writer - The scene being baked.
+ * @param vertices - The vertices, in the bind pose.
+ * @param count - The number of vertices.
+ * @param inverse_binds - Each joint's inverted bind matrix.
+ * @param joints - The number of joints.
+ * @returns The skin's offset within the scene, or zero if it couldn't be
+ * baked.
+ */
+uint64_t Ir_SkinBake(ir_scene_writer_t *writer,
+                     const ir_skin_vertex_t *vertices, uint32_t count,
+                     const ir_joint_matrix_t *inverse_binds,
+                     uint32_t joints);
+
+#endif // IRIDIUM_RENDER_SKINNING_H
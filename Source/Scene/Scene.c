@@ -0,0 +1,330 @@
+/**
+ * @file Scene.c
+ * @authors Israfiel
+ * @brief The implementation of Iridium's baked scene writer and loader.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Scene.h"
+
+#include "Debug/Logger.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(void *) == sizeof(uint64_t),
+              "Baked scenes store pointers in 64-bit slots.");
+
+/**
+ * @name AlignUp
+ * @authors Israfiel
+ * @brief Round a value up to a power-of-two alignment.
+ *
+ * @param value - The value to round.
+ * @param alignment - The alignment to round to.
+ * @returns The rounded value.
+ */
+static inline uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @name Reserve
+ * @authors Israfiel
+ * @brief Make sure a writer's image can hold the given number of bytes.
+ *
+ * @param writer - The writer to grow.
+ * @param size - The number of bytes required.
+ * @returns Whether the image is large enough.
+ */
+static bool Reserve(ir_scene_writer_t *writer, size_t size)
+{
+    if (size <= writer->capacity) return true;
+
+    size_t capacity = writer->capacity * 2;
+    while (capacity < size) capacity *= 2;
+
+    uint8_t *data = realloc(writer->data, capacity);
+    if (data == NULL)
+    {
+        writer->failed = true;
+        return false;
+    }
+    memset(data + writer->capacity, 0, capacity - writer->capacity);
+
+    writer->data = data;
+    writer->capacity = capacity;
+    return true;
+}
+
+/**
+ * @name CompareOffsets
+ * @authors Israfiel
+ * @brief qsort comparator for relocation offsets.
+ *
+ * @param a - The first offset.
+ * @param b - The second offset.
+ * @returns The ordering of the two offsets.
+ */
+static int CompareOffsets(const void *a, const void *b)
+{
+    uint64_t left = *(const uint64_t *)a, right = *(const uint64_t *)b;
+    return (left > right) - (left < right);
+}
+
+ir_scene_status_t Ir_SceneWriterCreate(ir_scene_writer_t *writer)
+{
+    *writer = (ir_scene_writer_t){0};
+    writer->capacity = 4096;
+    writer->data = calloc(writer->capacity, 1);
+    if (writer->data == NULL) return IR_SCENE_OUT_OF_MEMORY;
+
+    // The header is filled on save; reserve its space up front so the
+    // first object never lands at offset zero, which encodes null.
+    writer->size = AlignUp(sizeof(ir_scene_header_t), IR_SCENE_ALIGNMENT);
+    return IR_SCENE_OK;
+}
+
+void Ir_SceneWriterDestroy(ir_scene_writer_t *writer)
+{
+    free(writer->data);
+    free(writer->relocations);
+    *writer = (ir_scene_writer_t){0};
+}
+
+uint64_t Ir_SceneWriterAllocate(ir_scene_writer_t *writer, size_t size,
+                                size_t alignment)
+{
+    if (writer->failed) return 0;
+    if (alignment == 0 || alignment > IR_SCENE_ALIGNMENT ||
+        (alignment & (alignment - 1)))
+    {
+        IR_LOG_ERROR("Can't align a scene object to %zu bytes.",
+                     alignment);
+        writer->failed = writer->misused = true;
+        return 0;
+    }
+
+    uint64_t offset = AlignUp(writer->size, alignment);
+    if (!Reserve(writer, offset + size)) return 0;
+
+    writer->size = offset + size;
+    return offset;
+}
+
+void Ir_SceneWriterPointer(ir_scene_writer_t *writer, uint64_t slot_offset,
+                           uint64_t target_offset)
+{
+    if (writer->failed) return;
+    if (slot_offset % sizeof(uint64_t) != 0 ||
+        slot_offset + sizeof(uint64_t) > writer->size ||
+        target_offset >= writer->size)
+    {
+        // A bad slot is a baker bug; poison the writer so it is caught
+        // at save time rather than producing a corrupt scene.
+        IR_LOG_ERROR("Can't point scene slot %llu at offset %llu in an "
+                     "image of %zu bytes.",
+                     (unsigned long long)slot_offset,
+                     (unsigned long long)target_offset, writer->size);
+        writer->failed = writer->misused = true;
+        return;
+    }
+
+    memcpy(writer->data + slot_offset, &target_offset, sizeof(uint64_t));
+    if (target_offset == 0) return;
+
+    if (writer->relocation_count == writer->relocation_capacity)
+    {
+        size_t capacity = writer->relocation_capacity
+                              ? writer->relocation_capacity * 2
+                              : 256;
+        uint64_t *relocations =
+            realloc(writer->relocations, capacity * sizeof(uint64_t));
+        if (relocations == NULL)
+        {
+            writer->failed = true;
+            return;
+        }
+        writer->relocations = relocations;
+        writer->relocation_capacity = capacity;
+    }
+    writer->relocations[writer->relocation_count++] = slot_offset;
+}
+
+ir_scene_status_t Ir_SceneWriterSave(ir_scene_writer_t *writer,
+                                     const char *path)
+{
+    if (writer->failed)
+        return writer->misused ? IR_SCENE_MISUSED : IR_SCENE_OUT_OF_MEMORY;
+
+    // Sorting keeps the load-time fixup pass walking memory forwards.
+    qsort(writer->relocations, writer->relocation_count, sizeof(uint64_t),
+          CompareOffsets);
+
+    // A slot pointed more than once is recorded each time, and one last
+    // pointed at nothing holds null; either would be fixed up wrongly on
+    // load, so each slot keeps one relocation, and only if it's set.
+    size_t kept = 0;
+    for (size_t i = 0; i < writer->relocation_count; ++i)
+    {
+        uint64_t slot = writer->relocations[i], target;
+        if (kept > 0 && writer->relocations[kept - 1] == slot) continue;
+        memcpy(&target, writer->data + slot, sizeof(uint64_t));
+        if (target != 0) writer->relocations[kept++] = slot;
+    }
+    writer->relocation_count = kept;
+
+    uint64_t relocation_offset = AlignUp(writer->size, sizeof(uint64_t));
+    uint64_t relocation_size = writer->relocation_count * sizeof(uint64_t);
+    if (!Reserve(writer, relocation_offset)) return IR_SCENE_OUT_OF_MEMORY;
+
+    ir_scene_header_t header = {
+        .magic = IR_SCENE_MAGIC,
+        .version = IR_SCENE_VERSION,
+        .file_size = relocation_offset + relocation_size,
+        .root_offset = writer->root_offset,
+        .relocation_offset = relocation_offset,
+        .relocation_count = writer->relocation_count,
+        .pointer_size = sizeof(void *),
+        .flags = 0,
+    };
+    memcpy(writer->data, &header, sizeof(header));
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return IR_SCENE_OPEN_FAILED;
+
+    bool written =
+        fwrite(writer->data, 1, relocation_offset, file) ==
+            relocation_offset &&
+        fwrite(writer->relocations, 1, relocation_size, file) ==
+            relocation_size;
+    if (fclose(file) != 0) written = false;
+
+    return written ? IR_SCENE_OK : IR_SCENE_WRITE_FAILED;
+}
+
+/**
+ * @name ValidateHeader
+ * @authors Israfiel
+ * @brief Make sure a mapped header describes the mapping it sits in.
+ *
+ * @param header - The mapped header.
+ * @param size - The size of the mapping.
+ * @returns IR_SCENE_OK or the reason the header was rejected.
+ */
+static ir_scene_status_t ValidateHeader(const ir_scene_header_t *header,
+                                        size_t size)
+{
+    if (header->magic != IR_SCENE_MAGIC) return IR_SCENE_BAD_HEADER;
+    if (header->version != IR_SCENE_VERSION ||
+        header->pointer_size != sizeof(void *))
+        return IR_SCENE_BAD_VERSION;
+
+    if (header->file_size != size ||
+        header->relocation_offset % sizeof(uint64_t) != 0 ||
+        header->relocation_offset > size ||
+        header->relocation_count >
+            (size - header->relocation_offset) / sizeof(uint64_t) ||
+        header->root_offset >= header->relocation_offset)
+        return IR_SCENE_BAD_HEADER;
+
+    return IR_SCENE_OK;
+}
+
+ir_scene_status_t Ir_SceneLoad(const char *path, ir_scene_t *scene)
+{
+    *scene = (ir_scene_t){0};
+
+    int descriptor = open(path, O_RDONLY | O_CLOEXEC);
+    if (descriptor == -1) return IR_SCENE_OPEN_FAILED;
+
+    struct stat info;
+    if (fstat(descriptor, &info) == -1 ||
+        (size_t)info.st_size < sizeof(ir_scene_header_t))
+    {
+        close(descriptor);
+        return IR_SCENE_BAD_HEADER;
+    }
+
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    // The fixup pass touches every page holding a pointer anyway, so
+    // fault the whole file in with one call rather than page by page.
+    flags |= MAP_POPULATE;
+#endif
+    size_t size = (size_t)info.st_size;
+    uint8_t *base =
+        mmap(NULL, size, PROT_READ | PROT_WRITE, flags, descriptor, 0);
+    close(descriptor);
+    if (base == MAP_FAILED) return IR_SCENE_MAP_FAILED;
+
+    const ir_scene_header_t *header = (const ir_scene_header_t *)base;
+    ir_scene_status_t status = ValidateHeader(header, size);
+    if (status != IR_SCENE_OK)
+    {
+        munmap(base, size);
+        return status;
+    }
+
+    const uint64_t *relocations =
+        (const uint64_t *)(base + header->relocation_offset);
+    uint64_t payload_end = header->relocation_offset;
+    for (uint64_t i = 0; i < header->relocation_count; ++i)
+    {
+        uint64_t slot = relocations[i], target;
+        if (slot % sizeof(uint64_t) != 0 ||
+            slot + sizeof(uint64_t) > payload_end)
+        {
+            munmap(base, size);
+            return IR_SCENE_BAD_RELOCATION;
+        }
+
+        memcpy(&target, base + slot, sizeof(uint64_t));
+        if (target == 0 || target >= payload_end)
+        {
+            munmap(base, size);
+            return IR_SCENE_BAD_RELOCATION;
+        }
+
+        void *pointer = base + target;
+        memcpy(base + slot, &pointer, sizeof(void *));
+    }
+
+    scene->base = base;
+    scene->size = size;
+    scene->root = header->root_offset ? base + header->root_offset : NULL;
+    return IR_SCENE_OK;
+}
+
+void Ir_SceneUnload(ir_scene_t *scene)
+{
+    if (scene->base != NULL) munmap(scene->base, scene->size);
+    *scene = (ir_scene_t){0};
+}
+
+const char *Ir_SceneStatusString(ir_scene_status_t status)
+{
+    switch (status)
+    {
+        case IR_SCENE_OK:             return "success";
+        case IR_SCENE_OUT_OF_MEMORY:  return "out of memory";
+        case IR_SCENE_OPEN_FAILED:    return "failed to open file";
+        case IR_SCENE_MAP_FAILED:     return "failed to map file";
+        case IR_SCENE_WRITE_FAILED:   return "failed to write file";
+        case IR_SCENE_BAD_HEADER:     return "malformed header";
+        case IR_SCENE_BAD_VERSION:    return "incompatible version";
+        case IR_SCENE_BAD_RELOCATION: return "malformed relocation";
+        case IR_SCENE_MISUSED:        return "writer misused";
+    }
+    return "unknown";
+}
@@ -0,0 +1,315 @@
+/**
+ * @file Scene.h
+ * @authors Israfiel
+ * @brief Iridium's baked binary scene format. A baked scene file is laid
+ * out exactly as it will sit in memory at runtime; the only work done at
+ * load time is a single mmap and a pass over the relocation table that
+ * turns stored offsets back into pointers.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_SCENE_SCENE_H
+#define IRIDIUM_SCENE_SCENE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @name IR_SCENE_MAGIC
+ * @brief The four bytes ("IRSC") that open every baked scene file.
+ */
+#define IR_SCENE_MAGIC 0x43535249u
+
+/**
+ * @name IR_SCENE_VERSION
+ * @brief The version of the baked layout. Any change to the header or to
+ * a struct stored within a scene must bump this.
+ */
+#define IR_SCENE_VERSION 1u
+
+/**
+ * @name IR_SCENE_ALIGNMENT
+ * @brief The alignment of the scene payload within the file. mmap hands
+ * back page-aligned memory, so anything up to a page is preserved.
+ */
+#define IR_SCENE_ALIGNMENT 16u
+
+/**
+ * @name ir_scene_header_t
+ * @brief The header found at offset zero of each baked scene. Every
+ * offset within it is relative to the start of the file.
+ */
+typedef struct ir_scene_header
+{
+    /**
+     * @name magic
+     * @brief Always IR_SCENE_MAGIC.
+     */
+    uint32_t magic;
+    /**
+     * @name version
+     * @brief The IR_SCENE_VERSION the file was baked with.
+     */
+    uint32_t version;
+    /**
+     * @name file_size
+     * @brief The full size of the file in bytes.
+     */
+    uint64_t file_size;
+    /**
+     * @name root_offset
+     * @brief The offset of the scene's root object.
+     */
+    uint64_t root_offset;
+    /**
+     * @name relocation_offset
+     * @brief The offset of the relocation table, an ascending array of
+     * uint64_t offsets of every pointer slot within the payload.
+     */
+    uint64_t relocation_offset;
+    /**
+     * @name relocation_count
+     * @brief The number of entries within the relocation table.
+     */
+    uint64_t relocation_count;
+    /**
+     * @name pointer_size
+     * @brief The size of a pointer on the baking machine. Scenes are
+     * only loadable where this matches.
+     */
+    uint32_t pointer_size;
+    /**
+     * @name flags
+     * @brief Reserved, always zero.
+     */
+    uint32_t flags;
+} ir_scene_header_t;
+
+/**
+ * @name ir_scene_status_t
+ * @brief The result of a scene operation.
+ */
+typedef enum ir_scene_status
+{
+    IR_SCENE_OK,
+    IR_SCENE_OUT_OF_MEMORY,
+    IR_SCENE_OPEN_FAILED,
+    IR_SCENE_MAP_FAILED,
+    IR_SCENE_WRITE_FAILED,
+    IR_SCENE_BAD_HEADER,
+    IR_SCENE_BAD_VERSION,
+    IR_SCENE_BAD_RELOCATION,
+    /**
+     * @name IR_SCENE_MISUSED
+     * @brief A baker asked the writer for something impossible, such as
+     * a pointer slot outside the image. It was logged when it happened.
+     */
+    IR_SCENE_MISUSED
+} ir_scene_status_t;
+
+/**
+ * @name ir_scene_t
+ * @brief A scene that has been mapped into memory and fixed up.
+ */
+typedef struct ir_scene
+{
+    /**
+     * @name base
+     * @brief The start of the mapping, which is also the scene header.
+     */
+    void *base;
+    /**
+     * @name size
+     * @brief The size of the mapping in bytes.
+     */
+    size_t size;
+    /**
+     * @name root
+     * @brief The scene's root object, as placed by the baker.
+     */
+    void *root;
+} ir_scene_t;
+
+/**
+ * @name ir_scene_writer_t
+ * @brief An in-memory image of a scene being baked. Objects are placed
+ * into it by offset, and pointers between them are recorded so the
+ * loader can patch them.
+ */
+typedef struct ir_scene_writer
+{
+    /**
+     * @name data
+     * @brief The image of the file, header included.
+     */
+    uint8_t *data;
+    /**
+     * @name size
+     * @brief The number of bytes of data in use.
+     */
+    size_t size;
+    /**
+     * @name capacity
+     * @brief The number of bytes of data allocated.
+     */
+    size_t capacity;
+    /**
+     * @name relocations
+     * @brief The offsets of every pointer slot written so far.
+     */
+    uint64_t *relocations;
+    /**
+     * @name relocation_count
+     * @brief The number of relocations in use.
+     */
+    size_t relocation_count;
+    /**
+     * @name relocation_capacity
+     * @brief The number of relocations allocated.
+     */
+    size_t relocation_capacity;
+    /**
+     * @name root_offset
+     * @brief The offset of the root object, zero until set.
+     */
+    uint64_t root_offset;
+    /**
+     * @name failed
+     * @brief Set once an allocation fails or the writer is misused,
+     * after which every call is a no-op and saving reports why.
+     */
+    bool failed;
+    /**
+     * @name misused
+     * @brief Whether it was misuse, rather than running out of memory,
+     * that set failed.
+     */
+    bool misused;
+} ir_scene_writer_t;
+
+/**
+ * @name SceneWriterCreate
+ * @authors Israfiel
+ * @brief Prepare a writer for baking a new scene.
+ *
+ * @param writer - The writer to initialize.
+ * @returns IR_SCENE_OK or IR_SCENE_OUT_OF_MEMORY.
+ */
+ir_scene_status_t Ir_SceneWriterCreate(ir_scene_writer_t *writer);
+
+/**
+ * @name SceneWriterDestroy
+ * @authors Israfiel
+ * @brief Free everything held by a writer.
+ *
+ * @param writer - The writer to free.
+ */
+void Ir_SceneWriterDestroy(ir_scene_writer_t *writer);
+
+/**
+ * @name SceneWriterAllocate
+ * @authors Israfiel
+ * @brief Reserve zeroed space for an object within the scene image.
+ *
+ * @param writer - The writer to allocate from.
+ * @param size - The size of the object in bytes.
+ * @param alignment - The object's alignment, a power of two no larger
+ * than IR_SCENE_ALIGNMENT.
+ * @returns The object's offset within the file, or zero on failure.
+ */
+uint64_t Ir_SceneWriterAllocate(ir_scene_writer_t *writer, size_t size,
+                                size_t alignment);
+
+/**
+ * @name SceneWriterGet
+ * @authors Israfiel
+ * @brief Get a pointer to an allocated object so it can be filled. The
+ * pointer is invalidated by the next allocation.
+ *
+ * @param writer - The writer that owns the object.
+ * @param offset - The object's offset.
+ * @returns A pointer into the writer's image.
+ */
+static inline void *Ir_SceneWriterGet(ir_scene_writer_t *writer,
+                                      uint64_t offset)
+{
+    return writer->data + offset;
+}
+
+/**
+ * @name SceneWriterPointer
+ * @authors Israfiel
+ * @brief Store a pointer within the scene image. The slot at
+ * slot_offset will point at target_offset once loaded. A target of zero
+ * stores a null pointer and records no relocation. Pointing a slot again
+ * replaces what it pointed at.
+ *
+ * @param writer - The writer that owns both objects.
+ * @param slot_offset - The offset of the pointer-sized slot to fill.
+ * @param target_offset - The offset the pointer should resolve to.
+ */
+void Ir_SceneWriterPointer(ir_scene_writer_t *writer, uint64_t slot_offset,
+                           uint64_t target_offset);
+
+/**
+ * @name SceneWriterSetRoot
+ * @authors Israfiel
+ * @brief Mark the object the loader should hand back as the scene root.
+ *
+ * @param writer - The writer to modify.
+ * @param root_offset - The root object's offset.
+ */
+static inline void Ir_SceneWriterSetRoot(ir_scene_writer_t *writer,
+                                         uint64_t root_offset)
+{
+    writer->root_offset = root_offset;
+}
+
+/**
+ * @name SceneWriterSave
+ * @authors Israfiel
+ * @brief Write the scene image and its relocation table to disk.
+ *
+ * @param writer - The writer to save.
+ * @param path - The path of the file to create or replace.
+ * @returns IR_SCENE_OK or the reason the write failed.
+ */
+ir_scene_status_t Ir_SceneWriterSave(ir_scene_writer_t *writer,
+                                     const char *path);
+
+/**
+ * @name SceneLoad
+ * @authors Israfiel
+ * @brief Map a baked scene into memory and patch its pointers. The
+ * mapping is private, so the fixups never reach the file on disk.
+ *
+ * @param path - The path of the baked scene.
+ * @param scene - The scene to fill.
+ * @returns IR_SCENE_OK or the reason the load failed.
+ */
+ir_scene_status_t Ir_SceneLoad(const char *path, ir_scene_t *scene);
+
+/**
+ * @name SceneUnload
+ * @authors Israfiel
+ * @brief Unmap a loaded scene. Every pointer into it becomes invalid.
+ *
+ * @param scene - The scene to unload.
+ */
+void Ir_SceneUnload(ir_scene_t *scene);
+
+/**
+ * @name SceneStatusString
+ * @authors Israfiel
+ * @brief Describe a scene status for logging.
+ *
+ * @param status - The status to describe.
+ * @returns A static, human-readable string.
+ */
+const char *Ir_SceneStatusString(ir_scene_status_t status);
+
+#endif // IRIDIUM_SCENE_SCENE_H
@@ -0,0 +1,233 @@
+/**
+ * @file Clipmap.c
+ * @authors Israfiel
+ * @brief Implements Iridium's terrain clipmap.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Clipmap.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * @name MASK
+ * @brief Wraps a level's coordinates onto its texture.
+ */
+#define MASK ((int64_t)IR_CLIPMAP_SIZE - 1)
+
+/**
+ * @name Height
+ * @authors Israfiel
+ * @brief Read a terrain height for a clipmap. Past the terrain's edge
+ * the edge carries on, and a chunk that isn't resident stands in as its
+ * lowest height, which is in the archive's header rather than the
+ * samples still on disk.
+ *
+ * @param terrain - The terrain.
+ * @param x - The height's column.
+ * @param z - The height's row.
+ * @returns The height.
+ */
+static float Height(const ir_terrain_t *terrain, int64_t x, int64_t z)
+{
+    const ir_terrain_archive_t *archive = terrain->archive;
+    int64_t width = (int64_t)archive->width * IR_TERRAIN_CHUNK;
+    int64_t depth = (int64_t)archive->depth * IR_TERRAIN_CHUNK;
+    x = x < 0 ? 0 : x > width ? width : x;
+    z = z < 0 ? 0 : z > depth ? depth : z;
+
+    float height;
+    if (Ir_TerrainSample(terrain, x, z, &height)) return height;
+    int64_t chunk_x = x / IR_TERRAIN_CHUNK, chunk_z = z / IR_TERRAIN_CHUNK;
+    if (chunk_x == archive->width) chunk_x--;
+    if (chunk_z == archive->depth) chunk_z--;
+    return archive->chunks[chunk_z * archive->width + chunk_x].min;
+}
+
+/**
+ * @name Mark
+ * @authors Israfiel
+ * @brief Record a rectangle of a level as changed, split wherever it
+ * wraps around the texture's edges.
+ *
+ * @param level - The level.
+ * @param x0 - The rectangle's first column, in the level's coordinates.
+ * @param z0 - Its first row.
+ * @param x1 - One past its last column.
+ * @param z1 - One past its last row.
+ */
+static void Mark(ir_clipmap_level_t *level, int64_t x0, int64_t z0,
+                 int64_t x1, int64_t z1)
+{
+    ir_clipmap_region_t *regions = level->regions;
+    if (level->region_count == 1 &&
+        regions[0].width == IR_CLIPMAP_SIZE &&
+        regions[0].depth == IR_CLIPMAP_SIZE)
+        return;
+    if (level->region_count + 4 > IR_CLIPMAP_REGIONS)
+    {
+        regions[0] = (ir_clipmap_region_t){0, 0, IR_CLIPMAP_SIZE,
+                                           IR_CLIPMAP_SIZE};
+        level->region_count = 1;
+        return;
+    }
+
+    uint32_t starts[2][2], lengths[2][2], parts[2];
+    int64_t begins[2] = {x0, z0}, ends[2] = {x1, z1};
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        uint32_t start = (uint32_t)(begins[axis] & MASK);
+        uint32_t length = (uint32_t)(ends[axis] - begins[axis]);
+        uint32_t first = IR_CLIPMAP_SIZE - start;
+        if (first > length) first = length;
+        starts[axis][0] = start;
+        lengths[axis][0] = first;
+        starts[axis][1] = 0;
+        lengths[axis][1] = length - first;
+        parts[axis] = length > first ? 2 : 1;
+    }
+    for (uint32_t i = 0; i < parts[1]; ++i)
+        for (uint32_t j = 0; j < parts[0]; ++j)
+            regions[level->region_count++] = (ir_clipmap_region_t){
+                starts[0][j], starts[1][i], lengths[0][j], lengths[1][i]};
+}
+
+/**
+ * @name Fill
+ * @authors Israfiel
+ * @brief Write a rectangle of a level's heights from the terrain, and
+ * record it as changed.
+ *
+ * @param clipmap - The clipmap.
+ * @param index - The level.
+ * @param x0 - The rectangle's first column, in the level's coordinates.
+ * @param z0 - Its first row.
+ * @param x1 - One past its last column.
+ * @param z1 - One past its last row.
+ */
+static void Fill(ir_clipmap_t *clipmap, uint32_t index, int64_t x0,
+                 int64_t z0, int64_t x1, int64_t z1)
+{
+    if (x0 >= x1 || z0 >= z1) return;
+    ir_clipmap_level_t *level = &clipmap->levels[index];
+    int64_t step = (int64_t)1 << index;
+    for (int64_t z = z0; z < z1; ++z)
+    {
+        float *row = &level->heights[(z & MASK) * IR_CLIPMAP_SIZE];
+        for (int64_t x = x0; x < x1; ++x)
+            row[x & MASK] = Height(clipmap->terrain, x * step, z * step);
+    }
+    Mark(level, x0, z0, x1, z1);
+}
+
+/**
+ * @name UpdateLevels
+ * @authors Israfiel
+ * @brief Recentre a range of levels on the clipmap's focus.
+ *
+ * @param user - The clipmap.
+ * @param begin - The first level.
+ * @param end - One past the last.
+ */
+static void UpdateLevels(void *user, size_t begin, size_t end)
+{
+    ir_clipmap_t *clipmap = user;
+    const ir_terrain_t *terrain = clipmap->terrain;
+    for (size_t i = begin; i < end; ++i)
+    {
+        ir_clipmap_level_t *level = &clipmap->levels[i];
+        uint32_t index = (uint32_t)i;
+        int64_t step = (int64_t)1 << index;
+        level->region_count = 0;
+
+        // Windows are snapped to every other height of their own level,
+        // which is every height of the next, so each level's window sits
+        // on the grid of the one around it.
+        float spacing = terrain->archive->spacing * (float)step;
+        int64_t x = (int64_t)floorf(clipmap->focus.x / (2.0f * spacing)) *
+                        2 -
+                    IR_CLIPMAP_SIZE / 2;
+        int64_t z = (int64_t)floorf(clipmap->focus.z / (2.0f * spacing)) *
+                        2 -
+                    IR_CLIPMAP_SIZE / 2;
+        int64_t size = IR_CLIPMAP_SIZE;
+        if (!level->valid || llabs(x - level->x) >= size ||
+            llabs(z - level->z) >= size)
+            Fill(clipmap, index, x, z, x + size, z + size);
+        else
+        {
+            // Only the strips the window slid onto are new. The column
+            // strip spans the new window's every row, so a diagonal
+            // move's corner is written twice, which does no harm.
+            if (x > level->x)
+                Fill(clipmap, index, level->x + size, z, x + size,
+                     z + size);
+            else Fill(clipmap, index, x, z, level->x, z + size);
+            if (z > level->z)
+                Fill(clipmap, index, x, level->z + size, x + size,
+                     z + size);
+            else Fill(clipmap, index, x, z, x + size, level->z);
+        }
+        level->x = x;
+        level->z = z;
+        level->valid = true;
+
+        // Chunks decoded since the last update replace their stand-ins.
+        uint32_t width = terrain->archive->width;
+        for (uint32_t j = 0; j < terrain->loaded_count; ++j)
+        {
+            int64_t chunk = terrain->loaded[j];
+            int64_t first_x = chunk % width * IR_TERRAIN_CHUNK;
+            int64_t first_z = chunk / width * IR_TERRAIN_CHUNK;
+            int64_t x0 = (first_x + step - 1) / step;
+            int64_t z0 = (first_z + step - 1) / step;
+            int64_t x1 = (first_x + IR_TERRAIN_CHUNK) / step + 1;
+            int64_t z1 = (first_z + IR_TERRAIN_CHUNK) / step + 1;
+            Fill(clipmap, index, x0 > x ? x0 : x, z0 > z ? z0 : z,
+                 x1 < x + size ? x1 : x + size,
+                 z1 < z + size ? z1 : z + size);
+        }
+    }
+}
+
+bool Ir_ClipmapCreate(ir_clipmap_t *clipmap, uint32_t levels)
+{
+    *clipmap = (ir_clipmap_t){.level_count = levels};
+    float *heights = malloc((size_t)levels * IR_CLIPMAP_SIZE *
+                            IR_CLIPMAP_SIZE * sizeof(float));
+    if (heights == NULL)
+    {
+        IR_LOG_ERROR("Ran out of memory creating the clipmap.");
+        return false;
+    }
+    for (uint32_t i = 0; i < levels; ++i)
+        clipmap->levels[i].heights =
+            heights + (size_t)i * IR_CLIPMAP_SIZE * IR_CLIPMAP_SIZE;
+    return true;
+}
+
+void Ir_ClipmapDestroy(ir_clipmap_t *clipmap)
+{
+    free(clipmap->levels[0].heights);
+    *clipmap = (ir_clipmap_t){0};
+}
+
+void Ir_ClipmapUpdate(ir_clipmap_t *clipmap, const ir_terrain_t *terrain,
+                      ir_vec3_t focus, ir_jobs_t *jobs)
+{
+    IR_PROFILE_BEGIN("Clipmap");
+    clipmap->terrain = terrain;
+    clipmap->focus = focus;
+    if (jobs != NULL)
+        Ir_JobsParallelFor(jobs, clipmap->level_count, 1, UpdateLevels,
+                           clipmap);
+    else UpdateLevels(clipmap, 0, clipmap->level_count);
+    IR_PROFILE_END("Clipmap");
+}
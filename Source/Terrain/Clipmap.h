@@ -0,0 +1,136 @@
+/**
+ * @file Clipmap.h
+ * @authors Israfiel
+ * @brief Iridium's terrain clipmap. Each level is a square window of
+ * heights centred on the camera, twice as coarse and twice as wide as
+ * the one inside it, so a handful of fixed-size levels cover the whole
+ * view at roughly even detail on screen. Levels are stored toroidally:
+ * a height lives at its coordinates modulo the window's size, so when
+ * the camera moves only the strip it uncovers is written, and only that
+ * strip needs uploading to the level's height texture.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_TERRAIN_CLIPMAP_H
+#define IRIDIUM_TERRAIN_CLIPMAP_H
+
+#include "Core/Jobs.h"
+#include "Math/Vector.h"
+#include "Terrain/Terrain.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_CLIPMAP_SIZE
+ * @brief The number of heights along each side of a level; a power of
+ * two, so wrapping is a mask.
+ */
+#define IR_CLIPMAP_SIZE 128
+
+/**
+ * @name IR_CLIPMAP_LEVELS
+ * @brief The most levels a clipmap has.
+ */
+#define IR_CLIPMAP_LEVELS 10
+
+/**
+ * @name IR_CLIPMAP_REGIONS
+ * @brief The most changed regions a level records in one update before
+ * it gives up and marks the whole level changed.
+ */
+#define IR_CLIPMAP_REGIONS 32
+
+/**
+ * @name ir_clipmap_region_t
+ * @brief A rectangle of a level's heights, in texels.
+ */
+typedef struct ir_clipmap_region
+{
+    uint32_t x;
+    uint32_t z;
+    uint32_t width;
+    uint32_t depth;
+} ir_clipmap_region_t;
+
+/**
+ * @name ir_clipmap_level_t
+ * @brief One level of a clipmap.
+ */
+typedef struct ir_clipmap_level
+{
+    /**
+     * @name heights
+     * @brief The level's height texture: the height at the level's
+     * coordinates x and z lives at texel (x & (IR_CLIPMAP_SIZE - 1),
+     * z & (IR_CLIPMAP_SIZE - 1)), in rows of increasing z.
+     */
+    float *heights;
+    /**
+     * @name x
+     * @brief The window's lower corner, in the level's own coordinates,
+     * whose heights are 2^level terrain heights apart.
+     */
+    int64_t x;
+    int64_t z;
+    bool valid;
+    /**
+     * @name regions
+     * @brief The texels the last update changed, to upload.
+     */
+    ir_clipmap_region_t regions[IR_CLIPMAP_REGIONS];
+    uint32_t region_count;
+} ir_clipmap_level_t;
+
+/**
+ * @name ir_clipmap_t
+ * @brief A terrain clipmap.
+ */
+typedef struct ir_clipmap
+{
+    ir_clipmap_level_t levels[IR_CLIPMAP_LEVELS];
+    uint32_t level_count;
+    const ir_terrain_t *terrain;
+    ir_vec3_t focus;
+} ir_clipmap_t;
+
+/**
+ * @name ClipmapCreate
+ * @authors Israfiel
+ * @brief Create a clipmap with nothing in it yet.
+ *
+ * @param clipmap - The clipmap.
+ * @param levels - The number of levels, at most IR_CLIPMAP_LEVELS.
+ * @returns Whether there was memory for it.
+ */
+bool Ir_ClipmapCreate(ir_clipmap_t *clipmap, uint32_t levels);
+
+/**
+ * @name ClipmapDestroy
+ * @authors Israfiel
+ * @brief Free a clipmap.
+ *
+ * @param clipmap - The clipmap.
+ */
+void Ir_ClipmapDestroy(ir_clipmap_t *clipmap);
+
+/**
+ * @name ClipmapUpdate
+ * @authors Israfiel
+ * @brief Recentre every level on a point, writing the heights it
+ * uncovers and any the terrain's last stream decoded. Heights not yet
+ * resident stand in as their chunk's lowest, until it's decoded.
+ *
+ * @param clipmap - The clipmap.
+ * @param terrain - The terrain, streamed this frame.
+ * @param focus - The point, usually the camera.
+ * @param jobs - The pool to update levels with, or NULL to update them
+ * on the calling thread.
+ */
+void Ir_ClipmapUpdate(ir_clipmap_t *clipmap, const ir_terrain_t *terrain,
+                      ir_vec3_t focus, ir_jobs_t *jobs);
+
+#endif // IRIDIUM_TERRAIN_CLIPMAP_H
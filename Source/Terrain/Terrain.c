@@ -0,0 +1,296 @@
+/**
+ * @file Terrain.c
+ * @authors Israfiel
+ * @brief Implements Iridium's heightfield terrain.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include "Terrain.h"
+
+#include "Debug/Logger.h"
+#include "Debug/Profiler.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/**
+ * @name QUANTA
+ * @brief The largest quantised height.
+ */
+#define QUANTA 65535.0f
+
+/**
+ * @name Decode
+ * @authors Israfiel
+ * @brief Decode a range of the chunks the stream just gave slots to,
+ * and summarise each block's height range.
+ *
+ * @param user - The terrain.
+ * @param begin - The first loaded chunk.
+ * @param end - One past the last.
+ */
+static void Decode(void *user, size_t begin, size_t end)
+{
+    ir_terrain_t *terrain = user;
+    for (size_t i = begin; i < end; ++i)
+    {
+        uint32_t chunk = terrain->loaded[i];
+        ir_terrain_slot_t *slot =
+            &terrain->slots[terrain->resident[chunk]];
+        const ir_terrain_chunk_t *data = &terrain->archive->chunks[chunk];
+        float scale = (data->max - data->min) / QUANTA;
+        for (uint32_t j = 0; j < IR_TERRAIN_SAMPLES * IR_TERRAIN_SAMPLES;
+             ++j)
+            slot->heights[j] = data->min + (float)data->samples[j] * scale;
+
+        // Blocks share their edges, like chunks, so a ray crossing a
+        // block's boundary sees the same heights from either side.
+        for (uint32_t z = 0; z < IR_TERRAIN_BLOCKS; ++z)
+        {
+            for (uint32_t x = 0; x < IR_TERRAIN_BLOCKS; ++x)
+            {
+                float low = FLT_MAX, high = -FLT_MAX;
+                for (uint32_t v = 0; v <= IR_TERRAIN_BLOCK; ++v)
+                {
+                    const float *row =
+                        &slot->heights[(z * IR_TERRAIN_BLOCK + v) *
+                                           IR_TERRAIN_SAMPLES +
+                                       x * IR_TERRAIN_BLOCK];
+                    for (uint32_t u = 0; u <= IR_TERRAIN_BLOCK; ++u)
+                    {
+                        low = fminf(low, row[u]);
+                        high = fmaxf(high, row[u]);
+                    }
+                }
+                slot->block_min[z * IR_TERRAIN_BLOCKS + x] = low;
+                slot->block_max[z * IR_TERRAIN_BLOCKS + x] = high;
+            }
+        }
+    }
+}
+
+uint64_t Ir_TerrainBake(ir_scene_writer_t *writer, const float *heights,
+                        uint32_t width, uint32_t depth, float spacing)
+{
+    size_t row = (size_t)width * IR_TERRAIN_CHUNK + 1;
+    size_t count = (size_t)width * depth;
+    uint64_t archive =
+        Ir_SceneWriterAllocate(writer, sizeof(ir_terrain_archive_t),
+                               alignof(ir_terrain_archive_t));
+    uint64_t chunks =
+        Ir_SceneWriterAllocate(writer, count * sizeof(ir_terrain_chunk_t),
+                               alignof(ir_terrain_chunk_t));
+    if (archive == 0 || chunks == 0) return 0;
+
+    ir_terrain_archive_t *header = Ir_SceneWriterGet(writer, archive);
+    header->spacing = spacing;
+    header->width = width;
+    header->depth = depth;
+    Ir_SceneWriterPointer(writer,
+                          archive + offsetof(ir_terrain_archive_t, chunks),
+                          chunks);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint64_t samples = Ir_SceneWriterAllocate(
+            writer,
+            IR_TERRAIN_SAMPLES * IR_TERRAIN_SAMPLES * sizeof(uint16_t),
+            alignof(uint16_t));
+        if (samples == 0) return 0;
+
+        const float *first = heights +
+                             (i / width) * IR_TERRAIN_CHUNK * row +
+                             (i % width) * IR_TERRAIN_CHUNK;
+        float min = FLT_MAX, max = -FLT_MAX;
+        for (uint32_t z = 0; z < IR_TERRAIN_SAMPLES; ++z)
+        {
+            for (uint32_t x = 0; x < IR_TERRAIN_SAMPLES; ++x)
+            {
+                min = fminf(min, first[z * row + x]);
+                max = fmaxf(max, first[z * row + x]);
+            }
+        }
+
+        // Each chunk is quantised over its own range, so the error is a
+        // 65535th of however much that one chunk rises and falls.
+        uint64_t slot = chunks + i * sizeof(ir_terrain_chunk_t);
+        ir_terrain_chunk_t *chunk = Ir_SceneWriterGet(writer, slot);
+        chunk->min = min;
+        chunk->max = max;
+        uint16_t *quantised = Ir_SceneWriterGet(writer, samples);
+        float scale = max > min ? QUANTA / (max - min) : 0.0f;
+        for (uint32_t z = 0; z < IR_TERRAIN_SAMPLES; ++z)
+        {
+            for (uint32_t x = 0; x < IR_TERRAIN_SAMPLES; ++x)
+                quantised[z * IR_TERRAIN_SAMPLES + x] = (uint16_t)lrintf(
+                    (first[z * row + x] - min) * scale);
+        }
+        Ir_SceneWriterPointer(
+            writer, slot + offsetof(ir_terrain_chunk_t, samples), samples);
+    }
+    return writer->failed ? 0 : archive;
+}
+
+bool Ir_TerrainCreate(ir_terrain_t *terrain,
+                      const ir_terrain_archive_t *archive, float radius)
+{
+    *terrain = (ir_terrain_t){
+        .archive = archive, .radius = radius, .budget = IR_TERRAIN_BUDGET};
+
+    // However the focus sits, the chunks within the radius of it span at
+    // most this many along each axis.
+    float size = archive->spacing * IR_TERRAIN_CHUNK;
+    uint32_t span = (uint32_t)(2.0f * radius / size) + 2;
+    uint32_t chunks = archive->width * archive->depth;
+    uint32_t count = span * span < chunks ? span * span : chunks;
+
+    terrain->slots = malloc(count * sizeof(ir_terrain_slot_t));
+    terrain->resident = malloc(chunks * sizeof(uint32_t));
+    terrain->loaded = malloc(count * sizeof(uint32_t));
+    terrain->missing = malloc(count * sizeof(uint32_t));
+    terrain->distances = malloc(count * sizeof(float));
+    if (terrain->slots == NULL || terrain->resident == NULL ||
+        terrain->loaded == NULL || terrain->missing == NULL ||
+        terrain->distances == NULL)
+    {
+        Ir_TerrainDestroy(terrain);
+        IR_LOG_ERROR("Ran out of memory creating the terrain.");
+        return false;
+    }
+
+    terrain->slot_count = count;
+    for (uint32_t i = 0; i < count; ++i)
+        terrain->slots[i] = (ir_terrain_slot_t){.chunk = IR_TERRAIN_NONE};
+    for (uint32_t i = 0; i < chunks; ++i)
+        terrain->resident[i] = IR_TERRAIN_NONE;
+    return true;
+}
+
+void Ir_TerrainDestroy(ir_terrain_t *terrain)
+{
+    free(terrain->slots);
+    free(terrain->resident);
+    free(terrain->loaded);
+    free(terrain->missing);
+    free(terrain->distances);
+    *terrain = (ir_terrain_t){0};
+}
+
+uint32_t Ir_TerrainStream(ir_terrain_t *terrain, ir_vec3_t focus,
+                          ir_jobs_t *jobs)
+{
+    const ir_terrain_archive_t *archive = terrain->archive;
+    terrain->frame++;
+    terrain->loaded_count = 0;
+
+    IR_PROFILE_BEGIN("Terrain Stream");
+    float size = archive->spacing * IR_TERRAIN_CHUNK;
+    float radius = terrain->radius;
+    int64_t x0 = (int64_t)floorf((focus.x - radius) / size);
+    int64_t x1 = (int64_t)floorf((focus.x + radius) / size);
+    int64_t z0 = (int64_t)floorf((focus.z - radius) / size);
+    int64_t z1 = (int64_t)floorf((focus.z + radius) / size);
+    if (x0 < 0) x0 = 0;
+    if (z0 < 0) z0 = 0;
+    if (x1 >= archive->width) x1 = (int64_t)archive->width - 1;
+    if (z1 >= archive->depth) z1 = (int64_t)archive->depth - 1;
+
+    // Keep every wanted chunk that's already resident, and list the
+    // rest nearest first.
+    uint32_t missing = 0;
+    for (int64_t z = z0; z <= z1; ++z)
+    {
+        for (int64_t x = x0; x <= x1; ++x)
+        {
+            float dx = fmaxf(fmaxf((float)x * size - focus.x,
+                                   focus.x - (float)(x + 1) * size),
+                             0.0f);
+            float dz = fmaxf(fmaxf((float)z * size - focus.z,
+                                   focus.z - (float)(z + 1) * size),
+                             0.0f);
+            float distance = dx * dx + dz * dz;
+            if (distance > radius * radius) continue;
+
+            uint32_t chunk = (uint32_t)(z * archive->width + x);
+            uint32_t slot = terrain->resident[chunk];
+            if (slot != IR_TERRAIN_NONE)
+            {
+                terrain->slots[slot].used = terrain->frame;
+                continue;
+            }
+
+            uint32_t j = missing++;
+            for (; j > 0 && terrain->distances[j - 1] > distance; --j)
+            {
+                terrain->missing[j] = terrain->missing[j - 1];
+                terrain->distances[j] = terrain->distances[j - 1];
+            }
+            terrain->missing[j] = chunk;
+            terrain->distances[j] = distance;
+        }
+    }
+
+    // There's a slot for every chunk the radius can hold, so one that
+    // isn't wanted now is always there to take, the longest unwanted
+    // first.
+    for (uint32_t i = 0; i < missing && terrain->loaded_count <
+                                            terrain->budget; ++i)
+    {
+        uint32_t victim = IR_TERRAIN_NONE;
+        for (uint32_t j = 0; j < terrain->slot_count; ++j)
+        {
+            if (terrain->slots[j].used == terrain->frame) continue;
+            if (victim == IR_TERRAIN_NONE ||
+                terrain->slots[j].used < terrain->slots[victim].used)
+                victim = j;
+        }
+        if (victim == IR_TERRAIN_NONE) break;
+
+        ir_terrain_slot_t *slot = &terrain->slots[victim];
+        if (slot->chunk != IR_TERRAIN_NONE)
+            terrain->resident[slot->chunk] = IR_TERRAIN_NONE;
+        slot->chunk = terrain->missing[i];
+        slot->used = terrain->frame;
+        terrain->resident[slot->chunk] = victim;
+        terrain->loaded[terrain->loaded_count++] = slot->chunk;
+    }
+
+    if (jobs != NULL)
+        Ir_JobsParallelFor(jobs, terrain->loaded_count, 1, Decode,
+                           terrain);
+    else Decode(terrain, 0, terrain->loaded_count);
+    IR_PROFILE_END("Terrain Stream");
+    return terrain->loaded_count;
+}
+
+bool Ir_TerrainHeight(const ir_terrain_t *terrain, float x, float z,
+                      float *height)
+{
+    float u = x / terrain->archive->spacing;
+    float v = z / terrain->archive->spacing;
+    int64_t cell_x = (int64_t)floorf(u), cell_z = (int64_t)floorf(v);
+    // A point on the far edge belongs to the last cell; anything past
+    // it lands in a cell with no far corner, and fails below.
+    int64_t width = (int64_t)terrain->archive->width * IR_TERRAIN_CHUNK;
+    int64_t depth = (int64_t)terrain->archive->depth * IR_TERRAIN_CHUNK;
+    if (u == (float)width) cell_x--;
+    if (v == (float)depth) cell_z--;
+
+    float h00, h10, h01, h11;
+    if (!Ir_TerrainSample(terrain, cell_x, cell_z, &h00) ||
+        !Ir_TerrainSample(terrain, cell_x + 1, cell_z, &h10) ||
+        !Ir_TerrainSample(terrain, cell_x, cell_z + 1, &h01) ||
+        !Ir_TerrainSample(terrain, cell_x + 1, cell_z + 1, &h11))
+        return false;
+
+    float fu = u - (float)cell_x, fv = v - (float)cell_z;
+    *height = fu >= fv ? h00 + fu * (h10 - h00) + fv * (h11 - h10)
+                       : h00 + fv * (h01 - h00) + fu * (h11 - h01);
+    return true;
+}
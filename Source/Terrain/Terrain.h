@@ -0,0 +1,287 @@
+/**
+ * @file Terrain.h
+ * @authors Israfiel
+ * @brief Iridium's heightfield terrain. A terrain is baked into a scene
+ * file as square chunks of 16-bit heights, each quantised over its own
+ * range, and the file is mapped rather than read. At runtime only the
+ * chunks within a radius of the camera are decoded into a fixed pool of
+ * resident slots; the rest of the file stays on disk until the camera
+ * comes near it. Everything that reads heights, from the clipmap to
+ * collision, reads them from the resident slots.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#ifndef IRIDIUM_TERRAIN_TERRAIN_H
+#define IRIDIUM_TERRAIN_TERRAIN_H
+
+#include "Core/Jobs.h"
+#include "Math/Vector.h"
+#include "Scene/Scene.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @name IR_TERRAIN_NONE
+ * @brief An invalid chunk or slot.
+ */
+#define IR_TERRAIN_NONE UINT32_MAX
+
+/**
+ * @name IR_TERRAIN_CHUNK
+ * @brief The number of cells along each side of a chunk.
+ */
+#define IR_TERRAIN_CHUNK 64
+
+/**
+ * @name IR_TERRAIN_SAMPLES
+ * @brief The number of heights along each side of a chunk. Neighbouring
+ * chunks share their edge, so each is self-contained.
+ */
+#define IR_TERRAIN_SAMPLES (IR_TERRAIN_CHUNK + 1)
+
+/**
+ * @name IR_TERRAIN_BLOCK
+ * @brief The number of cells along each side of a block, the unit whose
+ * height range rays test before looking at any cell.
+ */
+#define IR_TERRAIN_BLOCK 8
+
+/**
+ * @name IR_TERRAIN_BLOCKS
+ * @brief The number of blocks along each side of a chunk.
+ */
+#define IR_TERRAIN_BLOCKS (IR_TERRAIN_CHUNK / IR_TERRAIN_BLOCK)
+
+/**
+ * @name IR_TERRAIN_BUDGET
+ * @brief The most chunks a stream decodes by default, which bounds the
+ * hitch when the camera jumps.
+ */
+#define IR_TERRAIN_BUDGET 4
+
+/**
+ * @name ir_terrain_chunk_t
+ * @brief A baked chunk.
+ */
+typedef struct ir_terrain_chunk
+{
+    float min;
+    float max;
+    /**
+     * @name samples
+     * @brief The heights, in rows of increasing z, each quantised from
+     * min to max.
+     */
+    uint16_t *samples;
+} ir_terrain_chunk_t;
+
+/**
+ * @name ir_terrain_archive_t
+ * @brief A baked terrain, the root of its scene file. It starts at the
+ * origin and runs along positive x and z.
+ */
+typedef struct ir_terrain_archive
+{
+    /**
+     * @name spacing
+     * @brief The distance, in metres, between neighbouring heights.
+     */
+    float spacing;
+    /**
+     * @name width
+     * @brief The number of chunks along x.
+     */
+    uint32_t width;
+    /**
+     * @name depth
+     * @brief The number of chunks along z.
+     */
+    uint32_t depth;
+    /**
+     * @name chunks
+     * @brief The chunks, in rows of increasing z.
+     */
+    ir_terrain_chunk_t *chunks;
+} ir_terrain_archive_t;
+
+/**
+ * @name ir_terrain_slot_t
+ * @brief A resident chunk, decoded.
+ */
+typedef struct ir_terrain_slot
+{
+    /**
+     * @name chunk
+     * @brief The chunk held, or IR_TERRAIN_NONE.
+     */
+    uint32_t chunk;
+    /**
+     * @name used
+     * @brief The last stream that wanted the chunk; slots not wanted by
+     * the current one are free to evict.
+     */
+    uint64_t used;
+    float heights[IR_TERRAIN_SAMPLES * IR_TERRAIN_SAMPLES];
+    /**
+     * @name block_min
+     * @brief Each block's lowest height, in rows of increasing z.
+     */
+    float block_min[IR_TERRAIN_BLOCKS * IR_TERRAIN_BLOCKS];
+    float block_max[IR_TERRAIN_BLOCKS * IR_TERRAIN_BLOCKS];
+} ir_terrain_slot_t;
+
+/**
+ * @name ir_terrain_t
+ * @brief A streamed terrain.
+ */
+typedef struct ir_terrain
+{
+    /**
+     * @name archive
+     * @brief The baked terrain, which the terrain doesn't own.
+     */
+    const ir_terrain_archive_t *archive;
+    ir_terrain_slot_t *slots;
+    uint32_t slot_count;
+    /**
+     * @name resident
+     * @brief Each chunk's slot, or IR_TERRAIN_NONE.
+     */
+    uint32_t *resident;
+    /**
+     * @name radius
+     * @brief How far from the focus, in metres, chunks are kept.
+     */
+    float radius;
+    /**
+     * @name budget
+     * @brief The most chunks a stream decodes.
+     */
+    uint32_t budget;
+    /**
+     * @name loaded
+     * @brief The chunks the last stream decoded, nearest first, so the
+     * clipmap can refresh them.
+     */
+    uint32_t *loaded;
+    uint32_t loaded_count;
+    /**
+     * @name missing
+     * @brief The wanted chunks that aren't resident yet.
+     */
+    uint32_t *missing;
+    float *distances;
+    uint64_t frame;
+} ir_terrain_t;
+
+/**
+ * @name TerrainBake
+ * @authors Israfiel
+ * @brief Bake a terrain into a scene. The caller sets the root.
+ *
+ * @param writer - The scene being baked.
+ * @param heights - The heights, in rows of increasing z, with
+ * width * IR_TERRAIN_CHUNK + 1 to a row and
+ * depth * IR_TERRAIN_CHUNK + 1 rows.
+ * @param width - The number of chunks along x.
+ * @param depth - The number of chunks along z.
+ * @param spacing - The distance, in metres, between heights.
+ * @returns The archive's offset, or zero on failure.
+ */
+uint64_t Ir_TerrainBake(ir_scene_writer_t *writer, const float *heights,
+                        uint32_t width, uint32_t depth, float spacing);
+
+/**
+ * @name TerrainCreate
+ * @authors Israfiel
+ * @brief Create a terrain with nothing resident, and enough slots for
+ * every chunk within a radius of any point.
+ *
+ * @param terrain - The terrain.
+ * @param archive - The baked terrain, which must outlive it.
+ * @param radius - How far from the focus, in metres, to keep chunks.
+ * @returns Whether there was memory for it.
+ */
+bool Ir_TerrainCreate(ir_terrain_t *terrain,
+                      const ir_terrain_archive_t *archive, float radius);
+
+/**
+ * @name TerrainDestroy
+ * @authors Israfiel
+ * @brief Free a terrain.
+ *
+ * @param terrain - The terrain.
+ */
+void Ir_TerrainDestroy(ir_terrain_t *terrain);
+
+/**
+ * @name TerrainStream
+ * @authors Israfiel
+ * @brief Decode the nearest missing chunks within the radius of a
+ * point, up to the budget, into slots no longer wanted. Call it once a
+ * frame, before anything reads heights.
+ *
+ * @param terrain - The terrain.
+ * @param focus - The point, usually the camera.
+ * @param jobs - The pool to decode with, or NULL to decode on the
+ * calling thread.
+ * @returns The number of chunks decoded.
+ */
+uint32_t Ir_TerrainStream(ir_terrain_t *terrain, ir_vec3_t focus,
+                          ir_jobs_t *jobs);
+
+/**
+ * @name TerrainSample
+ * @authors Israfiel
+ * @brief Read a resident height.
+ *
+ * @param terrain - The terrain.
+ * @param x - The height's column, counted from the terrain's origin.
+ * @param z - The height's row.
+ * @param height - Filled with the height.
+ * @returns Whether the height is resident.
+ */
+static inline bool Ir_TerrainSample(const ir_terrain_t *terrain,
+                                    int64_t x, int64_t z, float *height)
+{
+    const ir_terrain_archive_t *archive = terrain->archive;
+    if (x < 0 || z < 0 ||
+        x > (int64_t)archive->width * IR_TERRAIN_CHUNK ||
+        z > (int64_t)archive->depth * IR_TERRAIN_CHUNK)
+        return false;
+
+    // The far edge belongs to the last chunk rather than one past it.
+    int64_t chunk_x = x / IR_TERRAIN_CHUNK, chunk_z = z / IR_TERRAIN_CHUNK;
+    if (chunk_x == archive->width) chunk_x--;
+    if (chunk_z == archive->depth) chunk_z--;
+    uint32_t slot =
+        terrain->resident[chunk_z * archive->width + chunk_x];
+    if (slot == IR_TERRAIN_NONE) return false;
+
+    *height = terrain->slots[slot].heights
+                  [(z - chunk_z * IR_TERRAIN_CHUNK) * IR_TERRAIN_SAMPLES +
+                   (x - chunk_x * IR_TERRAIN_CHUNK)];
+    return true;
+}
+
+/**
+ * @name TerrainHeight
+ * @authors Israfiel
+ * @brief Find the height of the terrain's surface under a point, on the
+ * same triangles collision uses: each cell split from its lower corner
+ * to its upper.
+ *
+ * @param terrain - The terrain.
+ * @param x - The point's x, in metres.
+ * @param z - The point's z, in metres.
+ * @param height - Filled with the height.
+ * @returns Whether the cell under the point is resident.
+ */
+bool Ir_TerrainHeight(const ir_terrain_t *terrain, float x, float z,
+                      float *height);
+
+#endif // IRIDIUM_TERRAIN_TERRAIN_H
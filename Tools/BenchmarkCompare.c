@@ -0,0 +1,347 @@
+/**
+ * @file BenchmarkCompare.c
+ * @authors Israfiel
+ * @brief Compare two directories of benchmark results, as written by the
+ * benchmark harness' --json option. A benchmark has regressed when its
+ * mean slowed by more than the threshold and Welch's t-test says the
+ * slowdown is significant; any regression fails the comparison.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include <dirent.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @name MAX_SAMPLES
+ * @brief The most samples read per benchmark.
+ */
+#define MAX_SAMPLES 1000
+
+/**
+ * @name result_t
+ * @brief A benchmark's samples, read back from JSON.
+ */
+typedef struct result
+{
+    char name[128];
+    size_t count;
+    double samples[MAX_SAMPLES];
+} result_t;
+
+/**
+ * @name ReadFile
+ * @authors Israfiel
+ * @brief Read a whole file into a null-terminated buffer.
+ *
+ * @param path - The file to read.
+ * @returns The file's contents, or NULL.
+ */
+static char *ReadFile(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *contents = size >= 0 ? malloc((size_t)size + 1) : NULL;
+    if (contents != NULL)
+    {
+        size_t read = fread(contents, 1, (size_t)size, file);
+        contents[read] = '\0';
+    }
+    fclose(file);
+    return contents;
+}
+
+/**
+ * @name FindResult
+ * @authors Israfiel
+ * @brief Pull a named benchmark's samples out of a suite's JSON. Only
+ * the harness' own output is understood.
+ *
+ * @param json - The suite's JSON.
+ * @param name - The benchmark to find, or NULL for the first after
+ * cursor.
+ * @param cursor - Where to resume searching; advanced past the result.
+ * @param result - Filled with the benchmark's samples.
+ * @returns Whether a benchmark was found.
+ */
+static bool FindResult(const char *json, const char *name,
+                       const char **cursor, result_t *result)
+{
+    const char *entry = *cursor;
+    while ((entry = strstr(entry, "{\"name\":\"")) != NULL)
+    {
+        entry += strlen("{\"name\":\"");
+        const char *end = strchr(entry, '"');
+        if (end == NULL || (size_t)(end - entry) >= sizeof(result->name))
+            return false;
+
+        if (name != NULL && (strlen(name) != (size_t)(end - entry) ||
+                             strncmp(entry, name, end - entry) != 0))
+            continue;
+
+        memcpy(result->name, entry, end - entry);
+        result->name[end - entry] = '\0';
+
+        const char *samples = strstr(end, "\"samples_ns\":[");
+        if (samples == NULL) return false;
+        samples += strlen("\"samples_ns\":[");
+
+        result->count = 0;
+        while (*samples != ']' && *samples != '\0' &&
+               result->count < MAX_SAMPLES)
+        {
+            char *next;
+            result->samples[result->count++] = strtod(samples, &next);
+            if (next == samples) return false;
+            samples = *next == ',' ? next + 1 : next;
+        }
+
+        *cursor = samples;
+        return result->count >= 2;
+    }
+    return false;
+}
+
+/**
+ * @name ContinuedFraction
+ * @authors Israfiel
+ * @brief Evaluate the continued fraction of the incomplete beta
+ * function with the modified Lentz method.
+ *
+ * @param a - The first shape parameter.
+ * @param b - The second shape parameter.
+ * @param x - The point to evaluate at.
+ * @returns The continued fraction's value.
+ */
+static double ContinuedFraction(double a, double b, double x)
+{
+    const double tiny = 1e-300;
+    double c = 1.0, d = 1.0 - (a + b) * x / (a + 1.0);
+    if (fabs(d) < tiny) d = tiny;
+    d = 1.0 / d;
+    double fraction = d;
+
+    for (int m = 1; m <= 300; ++m)
+    {
+        for (int step = 0; step < 2; ++step)
+        {
+            double numerator =
+                step == 0
+                    ? m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m))
+                    : -(a + m) * (a + b + m) * x /
+                          ((a + 2 * m) * (a + 2 * m + 1));
+            d = 1.0 + numerator * d;
+            if (fabs(d) < tiny) d = tiny;
+            c = 1.0 + numerator / c;
+            if (fabs(c) < tiny) c = tiny;
+            d = 1.0 / d;
+            fraction *= d * c;
+            if (step == 1 && fabs(d * c - 1.0) < 1e-12) return fraction;
+        }
+    }
+    return fraction;
+}
+
+/**
+ * @name IncompleteBeta
+ * @authors Israfiel
+ * @brief The regularized incomplete beta function I_x(a, b).
+ *
+ * @param a - The first shape parameter.
+ * @param b - The second shape parameter.
+ * @param x - The point to evaluate at, within [0, 1].
+ * @returns The function's value.
+ */
+static double IncompleteBeta(double a, double b, double x)
+{
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+
+    double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) +
+                       a * log(x) + b * log1p(-x));
+    if (x < (a + 1.0) / (a + b + 2.0))
+        return front * ContinuedFraction(a, b, x) / a;
+    return 1.0 - front * ContinuedFraction(b, a, 1.0 - x) / b;
+}
+
+/**
+ * @name Moments
+ * @authors Israfiel
+ * @brief Compute the mean and sample variance of a result.
+ *
+ * @param result - The result.
+ * @param mean - Filled with the mean.
+ * @param variance - Filled with the sample variance.
+ */
+static void Moments(const result_t *result, double *mean, double *variance)
+{
+    double total = 0.0;
+    for (size_t i = 0; i < result->count; ++i) total += result->samples[i];
+    *mean = total / result->count;
+
+    double squares = 0.0;
+    for (size_t i = 0; i < result->count; ++i)
+        squares += (result->samples[i] - *mean) *
+                   (result->samples[i] - *mean);
+    *variance = squares / (result->count - 1);
+}
+
+/**
+ * @name SlowdownProbability
+ * @authors Israfiel
+ * @brief Run a one-sided Welch's t-test for the current result being
+ * slower than the baseline.
+ *
+ * @param baseline - The baseline result.
+ * @param current - The current result.
+ * @returns The p-value of the slowdown.
+ */
+static double SlowdownProbability(const result_t *baseline,
+                                  const result_t *current)
+{
+    double base_mean, base_variance, mean, variance;
+    Moments(baseline, &base_mean, &base_variance);
+    Moments(current, &mean, &variance);
+
+    double base_error = base_variance / baseline->count;
+    double error = variance / current->count;
+    if (base_error + error == 0.0) return mean > base_mean ? 0.0 : 1.0;
+
+    double t = (mean - base_mean) / sqrt(base_error + error);
+    double freedom =
+        (base_error + error) * (base_error + error) /
+        (base_error * base_error / (baseline->count - 1) +
+         error * error / (current->count - 1));
+
+    double two_sided =
+        IncompleteBeta(freedom / 2.0, 0.5, freedom / (freedom + t * t));
+    return t > 0.0 ? two_sided / 2.0 : 1.0 - two_sided / 2.0;
+}
+
+/**
+ * @name CompareSuite
+ * @authors Israfiel
+ * @brief Compare every benchmark of one suite against its baseline.
+ *
+ * @param baseline_path - The baseline suite's JSON.
+ * @param current_path - The current suite's JSON.
+ * @param threshold - The allowed slowdown, as a percentage.
+ * @param alpha - The significance level.
+ * @returns The number of regressions found.
+ */
+static int CompareSuite(const char *baseline_path,
+                        const char *current_path, double threshold,
+                        double alpha)
+{
+    char *baseline_json = ReadFile(baseline_path);
+    char *current_json = ReadFile(current_path);
+    static result_t baseline, current;
+    int regressions = 0;
+
+    if (current_json == NULL)
+        fprintf(stderr, "Failed to read '%s'.\n", current_path);
+    else if (baseline_json == NULL)
+        printf("  (no baseline for %s)\n", current_path);
+    else
+    {
+        const char *cursor = current_json;
+        while (FindResult(current_json, NULL, &cursor, &current))
+        {
+            const char *base_cursor = baseline_json;
+            if (!FindResult(baseline_json, current.name, &base_cursor,
+                            &baseline))
+            {
+                printf("  %-40s (new)\n", current.name);
+                continue;
+            }
+
+            double base_mean, mean, unused;
+            Moments(&baseline, &base_mean, &unused);
+            Moments(&current, &mean, &unused);
+            double change = (mean - base_mean) / base_mean * 100.0;
+            double p = SlowdownProbability(&baseline, &current);
+
+            bool regressed = change > threshold && p < alpha;
+            regressions += regressed;
+            printf("  %-40s %12.2f -> %12.2f ns %+8.2f%%  p=%.4f%s\n",
+                   current.name, base_mean, mean, change, p,
+                   regressed ? "  REGRESSED" : "");
+        }
+    }
+
+    free(baseline_json);
+    free(current_json);
+    return regressions;
+}
+
+int main(int argc, char **argv)
+{
+    double threshold = 5.0, alpha = 0.01;
+    const char *directories[2] = {NULL, NULL};
+    int directory_count = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strncmp(argv[i], "--threshold=", 12) == 0)
+            threshold = strtod(argv[i] + 12, NULL);
+        else if (strncmp(argv[i], "--alpha=", 8) == 0)
+            alpha = strtod(argv[i] + 8, NULL);
+        else if (directory_count < 2)
+            directories[directory_count++] = argv[i];
+        else directory_count = 3;
+    }
+    if (directory_count != 2)
+    {
+        fprintf(stderr,
+                "Usage: %s [baseline directory] [current directory] "
+                "[--threshold=percent] [--alpha=level]\n",
+                argv[0]);
+        return 2;
+    }
+
+    DIR *directory = opendir(directories[1]);
+    if (directory == NULL)
+    {
+        fprintf(stderr, "Failed to open '%s'.\n", directories[1]);
+        return 2;
+    }
+
+    int regressions = 0;
+    struct dirent *entry;
+    while ((entry = readdir(directory)) != NULL)
+    {
+        size_t length = strlen(entry->d_name);
+        if (length < 5 || strcmp(entry->d_name + length - 5, ".json") != 0)
+            continue;
+
+        char baseline[4096], current[4096];
+        snprintf(baseline, sizeof(baseline), "%s/%s", directories[0],
+                 entry->d_name);
+        snprintf(current, sizeof(current), "%s/%s", directories[1],
+                 entry->d_name);
+
+        printf("%s:\n", entry->d_name);
+        regressions += CompareSuite(baseline, current, threshold, alpha);
+    }
+    closedir(directory);
+
+    if (regressions != 0)
+    {
+        printf("%d benchmark(s) regressed by more than %.1f%%.\n",
+               regressions, threshold);
+        return 1;
+    }
+    printf("No significant regressions beyond %.1f%%.\n", threshold);
+    return 0;
+}
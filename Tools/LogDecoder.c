@@ -0,0 +1,28 @@
+/**
+ * @file LogDecoder.c
+ * @authors Israfiel
+ * @brief Decode a binary Iridium log into text.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include <Iridium.h>
+#include <stdio.h>
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s [binary log]\n", argv[0]);
+        return 1;
+    }
+
+    if (!Ir_LogDecode(argv[1], stdout))
+    {
+        fprintf(stderr, "Failed to decode '%s'.\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
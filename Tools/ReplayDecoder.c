@@ -0,0 +1,27 @@
+/**
+ * @file ReplayDecoder.c
+ * @authors Israfiel
+ * @brief Describe a recorded Iridium replay as text.
+ *
+ * @copyright (c) 2026 the Iridium Development Team
+ * This file is under the AGPLv3. For more information on what that
+ * entails, see the LICENSE file provided with the engine.
+ */
+
+#include <Iridium.h>
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s [replay]\n", argv[0]);
+        return 1;
+    }
+
+    if (!Ir_ReplayDecode(argv[1], stdout))
+    {
+        fprintf(stderr, "Failed to decode '%s'.\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}